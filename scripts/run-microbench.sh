@@ -0,0 +1,51 @@
+#! /usr/bin/env bash
+# Copyright (c) 2022 vesoft inc. All rights reserved.
+#
+# This source code is licensed under Apache 2.0 License.
+#
+# Runs the curated micro-benchmark suite over the codec, expression, value and iterator
+# layers and merges the results into one machine-readable JSON file, so CI can diff the
+# numbers between builds and gate on throughput regressions.
+#
+# Usage: run-microbench.sh <bench-bin-dir> [output-file]
+#
+# The benchmarks use fixed, built-in datasets; each binary is a folly benchmark and is run
+# with --json, whose output maps benchmark name to time per iteration in nanoseconds.
+# Normally invoked through the `microbench' build target, which builds the binaries first.
+
+set -e -o pipefail
+
+BENCH_DIR=${1:?Usage: $0 <bench-bin-dir> [output-file]}
+OUTPUT=${2:-microbench.json}
+
+# The curated suite. Keep this list in sync with the `microbench' target in the top-level
+# CMakeLists.txt
+BENCHMARKS=(
+    row_reader_bm
+    row_writer_bm
+    row_writer_move_bm
+    expression_bm
+    func_call_expression_bm
+    value_bm
+    iterator_bm
+)
+
+first=true
+{
+    echo "{"
+    for bm in "${BENCHMARKS[@]}"; do
+        binary=$BENCH_DIR/$bm
+        if [[ ! -x $binary ]]; then
+            echo "Skipping $bm: $binary not built" >&2
+            continue
+        fi
+        echo "Running $bm ..." >&2
+        result=$("$binary" --json 2>/dev/null)
+        $first || echo ","
+        first=false
+        echo "\"$bm\": $result"
+    done
+    echo "}"
+} > "$OUTPUT"
+
+echo "Benchmark results written to $OUTPUT" >&2
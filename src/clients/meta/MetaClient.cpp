@@ -30,9 +30,23 @@
 
 DEFINE_uint32(expired_time_factor, 5, "The factor of expired time based on heart beat interval");
 DEFINE_int32(heartbeat_interval_secs, 10, "Heartbeat interval in seconds");
+DEFINE_uint32(heartbeat_full_report_rounds,
+              1,
+              "Send the full leader/disk part report every N heartbeats; the rounds in between "
+              "only report when something changed since the last heartbeat. 1 keeps the "
+              "historical behavior of a full leader report on every heartbeat.");
 DEFINE_int32(meta_client_retry_times, 3, "meta client retry times, 0 means no retry");
 DEFINE_int32(meta_client_retry_interval_secs, 1, "meta client sleep interval between retry");
 DEFINE_int32(meta_client_timeout_ms, 60 * 1000, "meta client timeout");
+DEFINE_bool(meta_client_follower_read,
+            false,
+            "Send read-only meta requests (space/host/schema gets and lists) to a random "
+            "meta replica instead of the leader. Requires meta_follower_read to be enabled "
+            "on the metad side, otherwise the replica forwards the client back to the leader.");
+DEFINE_bool(meta_client_incremental_load,
+            false,
+            "if true, only spaces changed on metad since the last load are fetched again, "
+            "unchanged spaces reuse the cached data");
 DEFINE_string(cluster_id_path, "cluster.id", "file path saved clusterId");
 DEFINE_int32(check_plan_killed_frequency, 8, "check plan killed every 1<<n times");
 DEFINE_uint32(failed_login_attempts,
@@ -190,6 +204,8 @@ void MetaClient::heartBeatThreadFunc() {
     auto ret = heartbeat().get();
     if (!ret.ok()) {
       LOG(ERROR) << "Heartbeat failed, status:" << ret.status();
+      // Metad may have missed the last delta report; force a full one next round.
+      heartbeatRound_ = 0;
       return;
     }
   }
@@ -286,11 +302,12 @@ bool MetaClient::loadData() {
     return false;
   }
 
-  auto ret = listSpaces().get();
+  auto ret = listSpacesWithUpdateTimes().get();
   if (!ret.ok()) {
     LOG(ERROR) << "List space failed, status:" << ret.status();
     return false;
   }
+  auto& spaceUpdateTimes = ret.value().second;
 
   decltype(localCache_) cache;
   decltype(spaceIndexByName_) spaceIndexByName;
@@ -302,8 +319,33 @@ bool MetaClient::loadData() {
   decltype(spaceTagIndexById_) spaceTagIndexById;
   decltype(spaceAllEdgeMap_) spaceAllEdgeMap;
 
-  for (auto space : ret.value()) {
+  for (auto space : ret.value().first) {
     auto spaceId = space.first;
+    int64_t updateTime = 0;
+    auto timeIt = spaceUpdateTimes.find(spaceId);
+    if (timeIt != spaceUpdateTimes.end()) {
+      updateTime = timeIt->second;
+    }
+    if (FLAGS_meta_client_incremental_load && updateTime != 0) {
+      auto oldIt = localCache_.find(spaceId);
+      if (oldIt != localCache_.end() && oldIt->second->updateTime_ == updateTime) {
+        // nothing changed in this space since the last load: keep the cached copy and
+        // only rebuild the lookup maps from it, skipping all per-space rpcs
+        addSchemasToMaps(spaceId,
+                         *oldIt->second,
+                         spaceTagIndexByName,
+                         spaceTagIndexById,
+                         spaceEdgeIndexByName,
+                         spaceEdgeIndexByType,
+                         spaceNewestTagVerMap,
+                         spaceNewestEdgeVerMap,
+                         spaceAllEdgeMap);
+        addIndexesToMaps(spaceId, *oldIt->second);
+        cache.emplace(spaceId, oldIt->second);
+        spaceIndexByName.emplace(space.second, spaceId);
+        continue;
+      }
+    }
     MetaClient::PartTerms partTerms;
     auto r = getPartsAlloc(spaceId, &partTerms).get();
     if (!r.ok()) {
@@ -352,6 +394,7 @@ bool MetaClient::loadData() {
     }
     auto properties = resp.value().get_properties();
     spaceCache->spaceDesc_ = std::move(properties);
+    spaceCache->updateTime_ = updateTime;
 
     cache.emplace(spaceId, spaceCache);
     spaceIndexByName.emplace(space.second, spaceId);
@@ -387,14 +430,26 @@ bool MetaClient::loadData() {
   loadLeader(hostItems, spaceIndexByName_);
 
   localDataLastUpdateTime_.store(metadLastUpdateTime_.load());
+  auto oldMetaData = metadata_.load();
   auto newMetaData = new MetaData();
 
   for (auto& spaceInfo : localCache_) {
     GraphSpaceID spaceId = spaceInfo.first;
     std::shared_ptr<SpaceInfoCache> info = spaceInfo.second;
+    auto reusedIt = oldCache.find(spaceId);
+    if (reusedIt != oldCache.end() && reusedIt->second == info) {
+      // the space was reused unchanged, so the read-side deep copy is still valid too
+      auto copyIt = oldMetaData->localCache_.find(spaceId);
+      if (copyIt != oldMetaData->localCache_.end()) {
+        newMetaData->localCache_[spaceId] = copyIt->second;
+        continue;
+      }
+    }
     std::shared_ptr<SpaceInfoCache> infoDeepCopy = std::make_shared<SpaceInfoCache>(*info);
-    infoDeepCopy->tagSchemas_ = buildTagSchemas(infoDeepCopy->tagItemVec_);
-    infoDeepCopy->edgeSchemas_ = buildEdgeSchemas(infoDeepCopy->edgeItemVec_);
+    infoDeepCopy->tagSchemas_ =
+        std::make_shared<const TagSchemas>(buildTagSchemas(infoDeepCopy->tagItemVec_));
+    infoDeepCopy->edgeSchemas_ =
+        std::make_shared<const EdgeSchemas>(buildEdgeSchemas(infoDeepCopy->edgeItemVec_));
     infoDeepCopy->tagIndexes_ = buildIndexes(infoDeepCopy->tagIndexItemVec_);
     infoDeepCopy->edgeIndexes_ = buildIndexes(infoDeepCopy->edgeIndexItemVec_);
     newMetaData->localCache_[spaceId] = infoDeepCopy;
@@ -415,7 +470,6 @@ bool MetaClient::loadData() {
   newMetaData->sessionMap_ = std::move(sessionMap_);
   newMetaData->killedPlans_ = std::move(killedPlans_);
   newMetaData->serviceClientList_ = std::move(serviceClientList_);
-  auto oldMetaData = metadata_.load();
   metadata_.store(newMetaData);
   folly::rcu_retire(oldMetaData);
   diff(oldCache, localCache_);
@@ -512,11 +566,38 @@ bool MetaClient::loadSchemas(GraphSpaceID spaceId,
 
   auto tagItemVec = tagRet.value();
   auto edgeItemVec = edgeRet.value();
+  spaceInfoCache->tagItemVec_ = std::move(tagItemVec);
+  spaceInfoCache->tagSchemas_ =
+      std::make_shared<const TagSchemas>(buildTagSchemas(spaceInfoCache->tagItemVec_));
+  spaceInfoCache->edgeItemVec_ = std::move(edgeItemVec);
+  spaceInfoCache->edgeSchemas_ =
+      std::make_shared<const EdgeSchemas>(buildEdgeSchemas(spaceInfoCache->edgeItemVec_));
+
+  addSchemasToMaps(spaceId,
+                   *spaceInfoCache,
+                   tagNameIdMap,
+                   tagIdNameMap,
+                   edgeNameTypeMap,
+                   edgeTypeNameMap,
+                   newestTagVerMap,
+                   newestEdgeVerMap,
+                   allEdgeMap);
+  return true;
+}
+
+void MetaClient::addSchemasToMaps(GraphSpaceID spaceId,
+                                  const SpaceInfoCache& cache,
+                                  SpaceTagNameIdMap& tagNameIdMap,
+                                  SpaceTagIdNameMap& tagIdNameMap,
+                                  SpaceEdgeNameTypeMap& edgeNameTypeMap,
+                                  SpaceEdgeTypeNameMap& edgeTypeNameMap,
+                                  SpaceNewestTagVerMap& newestTagVerMap,
+                                  SpaceNewestEdgeVerMap& newestEdgeVerMap,
+                                  SpaceAllEdgeMap& allEdgeMap) {
+  memory::MemoryCheckOffGuard g;
+  const auto& tagItemVec = cache.tagItemVec_;
+  const auto& edgeItemVec = cache.edgeItemVec_;
   allEdgeMap[spaceId] = {};
-  spaceInfoCache->tagItemVec_ = tagItemVec;
-  spaceInfoCache->tagSchemas_ = buildTagSchemas(tagItemVec);
-  spaceInfoCache->edgeItemVec_ = edgeItemVec;
-  spaceInfoCache->edgeSchemas_ = buildEdgeSchemas(edgeItemVec);
 
   for (auto& tagIt : tagItemVec) {
     tagNameIdMap.emplace(std::make_pair(spaceId, tagIt.get_tag_name()), tagIt.get_tag_id());
@@ -559,8 +640,6 @@ bool MetaClient::loadSchemas(GraphSpaceID spaceId,
             << ", Name " << edgeIt.get_edge_name() << ", Version " << edgeIt.get_version()
             << " Successfully!";
   }
-
-  return true;
 }
 
 Indexes buildIndexes(std::vector<cpp2::IndexItem> indexItemVec) {
@@ -591,26 +670,24 @@ bool MetaClient::loadIndexes(GraphSpaceID spaceId, std::shared_ptr<SpaceInfoCach
     return false;
   }
 
-  auto tagIndexItemVec = tagIndexesRet.value();
-  cache->tagIndexItemVec_ = tagIndexItemVec;
-  cache->tagIndexes_ = buildIndexes(tagIndexItemVec);
-  for (const auto& tagIndex : tagIndexItemVec) {
-    auto indexName = tagIndex.get_index_name();
-    auto indexID = tagIndex.get_index_id();
-    std::pair<GraphSpaceID, std::string> pair(spaceId, indexName);
-    tagNameIndexMap_[pair] = indexID;
-  }
+  cache->tagIndexItemVec_ = std::move(tagIndexesRet).value();
+  cache->tagIndexes_ = buildIndexes(cache->tagIndexItemVec_);
+  cache->edgeIndexItemVec_ = std::move(edgeIndexesRet).value();
+  cache->edgeIndexes_ = buildIndexes(cache->edgeIndexItemVec_);
+  addIndexesToMaps(spaceId, *cache);
+  return true;
+}
 
-  auto edgeIndexItemVec = edgeIndexesRet.value();
-  cache->edgeIndexItemVec_ = edgeIndexItemVec;
-  cache->edgeIndexes_ = buildIndexes(edgeIndexItemVec);
-  for (auto& edgeIndex : edgeIndexItemVec) {
-    auto indexName = edgeIndex.get_index_name();
-    auto indexID = edgeIndex.get_index_id();
-    std::pair<GraphSpaceID, std::string> pair(spaceId, indexName);
-    edgeNameIndexMap_[pair] = indexID;
+void MetaClient::addIndexesToMaps(GraphSpaceID spaceId, const SpaceInfoCache& cache) {
+  memory::MemoryCheckOffGuard g;
+  for (const auto& tagIndex : cache.tagIndexItemVec_) {
+    std::pair<GraphSpaceID, std::string> pair(spaceId, tagIndex.get_index_name());
+    tagNameIndexMap_[pair] = tagIndex.get_index_id();
+  }
+  for (const auto& edgeIndex : cache.edgeIndexItemVec_) {
+    std::pair<GraphSpaceID, std::string> pair(spaceId, edgeIndex.get_index_name());
+    edgeNameIndexMap_[pair] = edgeIndex.get_index_id();
   }
-  return true;
 }
 
 bool MetaClient::loadListeners(GraphSpaceID spaceId, std::shared_ptr<SpaceInfoCache> cache) {
@@ -792,15 +869,16 @@ void MetaClient::getResponse(Request req,
                               remoteFunc = std::move(remoteFunc),
                               respGen = std::move(respGen),
                               pro = std::move(pro),
-                              toLeader,
                               retry,
                               retryLimit,
                               this]() mutable {
+                               // The peer told us who the leader is; retry against it even
+                               // if the first attempt went to a follower
                                getResponse(std::move(req),
                                            std::move(remoteFunc),
                                            std::move(respGen),
                                            std::move(pro),
-                                           toLeader,
+                                           true,
                                            retry + 1,
                                            retryLimit);
                              },
@@ -1283,6 +1361,30 @@ folly::Future<StatusOr<GraphSpaceID>> MetaClient::createSpaceAs(const std::strin
   return future;
 }
 
+folly::Future<
+    StatusOr<std::pair<std::vector<SpaceIdName>, std::unordered_map<GraphSpaceID, int64_t>>>>
+MetaClient::listSpacesWithUpdateTimes() {
+  memory::MemoryCheckOffGuard g;
+  cpp2::ListSpacesReq req;
+  folly::Promise<
+      StatusOr<std::pair<std::vector<SpaceIdName>, std::unordered_map<GraphSpaceID, int64_t>>>>
+      promise;
+  auto future = promise.getFuture();
+  getResponse(
+      std::move(req),
+      [](auto client, auto request) { return client->future_listSpaces(request); },
+      [this](cpp2::ListSpacesResp&& resp) -> decltype(auto) {
+        std::unordered_map<GraphSpaceID, int64_t> updateTimes;
+        if (resp.update_times_ref().has_value()) {
+          updateTimes = std::move(*resp.update_times_ref());
+        }
+        return std::make_pair(this->toSpaceIdName(resp.get_spaces()), std::move(updateTimes));
+      },
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
+  return future;
+}
+
 folly::Future<StatusOr<std::vector<SpaceIdName>>> MetaClient::listSpaces() {
   memory::MemoryCheckOffGuard g;
   cpp2::ListSpacesReq req;
@@ -1294,7 +1396,8 @@ folly::Future<StatusOr<std::vector<SpaceIdName>>> MetaClient::listSpaces() {
       [this](cpp2::ListSpacesResp&& resp) -> decltype(auto) {
         return this->toSpaceIdName(resp.get_spaces());
       },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1308,7 +1411,8 @@ folly::Future<StatusOr<cpp2::SpaceItem>> MetaClient::getSpace(std::string name)
       std::move(req),
       [](auto client, auto request) { return client->future_getSpace(request); },
       [](cpp2::GetSpaceResp&& resp) -> decltype(auto) { return std::move(resp).get_item(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1357,7 +1461,8 @@ folly::Future<StatusOr<std::vector<cpp2::HostItem>>> MetaClient::listHosts(cpp2:
       std::move(req),
       [](auto client, auto request) { return client->future_listHosts(request); },
       [](cpp2::ListHostsResp&& resp) -> decltype(auto) { return resp.get_hosts(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1656,7 +1761,8 @@ folly::Future<StatusOr<std::vector<cpp2::TagItem>>> MetaClient::listTagSchemas(
       std::move(req),
       [](auto client, auto request) { return client->future_listTags(request); },
       [](cpp2::ListTagsResp&& resp) -> decltype(auto) { return std::move(resp).get_tags(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1694,7 +1800,8 @@ folly::Future<StatusOr<cpp2::Schema>> MetaClient::getTagSchema(GraphSpaceID spac
       std::move(req),
       [](auto client, auto request) { return client->future_getTag(request); },
       [](cpp2::GetTagResp&& resp) -> cpp2::Schema { return std::move(resp).get_schema(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1752,7 +1859,8 @@ folly::Future<StatusOr<std::vector<cpp2::EdgeItem>>> MetaClient::listEdgeSchemas
       std::move(req),
       [](auto client, auto request) { return client->future_listEdges(request); },
       [](cpp2::ListEdgesResp&& resp) -> decltype(auto) { return std::move(resp).get_edges(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -1770,7 +1878,8 @@ folly::Future<StatusOr<cpp2::Schema>> MetaClient::getEdgeSchema(GraphSpaceID spa
       std::move(req),
       [](auto client, auto request) { return client->future_getEdge(request); },
       [](cpp2::GetEdgeResp&& resp) -> cpp2::Schema { return std::move(resp).get_schema(); },
-      std::move(promise));
+      std::move(promise),
+      !FLAGS_meta_client_follower_read);
   return future;
 }
 
@@ -2082,8 +2191,8 @@ StatusOr<std::shared_ptr<const NebulaSchemaProvider>> MetaClient::getTagSchemaFr
   const auto& metadata = *metadata_.load();
   auto spaceIt = metadata.localCache_.find(spaceId);
   if (spaceIt != metadata.localCache_.end()) {
-    auto tagIt = spaceIt->second->tagSchemas_.find(tagID);
-    if (tagIt != spaceIt->second->tagSchemas_.end() && !tagIt->second.empty()) {
+    auto tagIt = spaceIt->second->tagSchemas_->find(tagID);
+    if (tagIt != spaceIt->second->tagSchemas_->end() && !tagIt->second.empty()) {
       size_t vNum = tagIt->second.size();
       if (static_cast<SchemaVer>(vNum) > ver) {
         return ver < 0 ? tagIt->second.back() : tagIt->second[ver];
@@ -2104,8 +2213,8 @@ StatusOr<std::shared_ptr<const NebulaSchemaProvider>> MetaClient::getEdgeSchemaF
   const auto& metadata = *metadata_.load();
   auto spaceIt = metadata.localCache_.find(spaceId);
   if (spaceIt != metadata.localCache_.end()) {
-    auto edgeIt = spaceIt->second->edgeSchemas_.find(edgeType);
-    if (edgeIt != spaceIt->second->edgeSchemas_.end() && !edgeIt->second.empty()) {
+    auto edgeIt = spaceIt->second->edgeSchemas_->find(edgeType);
+    if (edgeIt != spaceIt->second->edgeSchemas_->end() && !edgeIt->second.empty()) {
       size_t vNum = edgeIt->second.size();
       if (static_cast<SchemaVer>(vNum) > ver) {
         return ver < 0 ? edgeIt->second.back() : edgeIt->second[ver];
@@ -2116,7 +2225,7 @@ StatusOr<std::shared_ptr<const NebulaSchemaProvider>> MetaClient::getEdgeSchemaF
   return std::shared_ptr<const NebulaSchemaProvider>();
 }
 
-StatusOr<TagSchemas> MetaClient::getAllVerTagSchema(GraphSpaceID spaceId) {
+StatusOr<std::shared_ptr<const TagSchemas>> MetaClient::getAllVerTagSchema(GraphSpaceID spaceId) {
   memory::MemoryCheckOffGuard g;
   if (!ready_) {
     return Status::Error("Not ready!");
@@ -2142,15 +2251,16 @@ StatusOr<TagSchema> MetaClient::getAllLatestVerTagSchema(const GraphSpaceID& spa
     return Status::SpaceNotFound(fmt::format("SpaceId `{}`", spaceId));
   }
   TagSchema tagsSchema;
-  tagsSchema.reserve(iter->second->tagSchemas_.size());
+  tagsSchema.reserve(iter->second->tagSchemas_->size());
   // fetch all tagIds
-  for (const auto& tagSchema : iter->second->tagSchemas_) {
+  for (const auto& tagSchema : *iter->second->tagSchemas_) {
     tagsSchema.emplace(tagSchema.first, tagSchema.second.back());
   }
   return tagsSchema;
 }
 
-StatusOr<EdgeSchemas> MetaClient::getAllVerEdgeSchema(GraphSpaceID spaceId) {
+StatusOr<std::shared_ptr<const EdgeSchemas>> MetaClient::getAllVerEdgeSchema(
+    GraphSpaceID spaceId) {
   memory::MemoryCheckOffGuard g;
   if (!ready_) {
     return Status::Error("Not ready!");
@@ -2176,9 +2286,9 @@ StatusOr<EdgeSchema> MetaClient::getAllLatestVerEdgeSchemaFromCache(const GraphS
     return Status::SpaceNotFound(fmt::format("SpaceId `{}`", spaceId));
   }
   EdgeSchema edgesSchema;
-  edgesSchema.reserve(iter->second->edgeSchemas_.size());
+  edgesSchema.reserve(iter->second->edgeSchemas_->size());
   // fetch all edgeTypes
-  for (const auto& edgeSchema : iter->second->edgeSchemas_) {
+  for (const auto& edgeSchema : *iter->second->edgeSchemas_) {
     edgesSchema.emplace(edgeSchema.first, edgeSchema.second.back());
   }
   return edgesSchema;
@@ -2614,33 +2724,45 @@ folly::Future<StatusOr<bool>> MetaClient::heartbeat() {
       options_.clusterId_ = FileBasedClusterIdMan::getClusterIdFromFile(FLAGS_cluster_id_path);
     }
     req.cluster_id_ref() = options_.clusterId_.load();
+    // Metad keeps the last reported state when the optional fields are absent, so with
+    // heartbeat_full_report_rounds > 1 unchanged reports are suppressed and a full one is
+    // forced every N rounds as anti-entropy (and right after a failed heartbeat).
+    const bool deltaMode = FLAGS_heartbeat_full_report_rounds > 1;
+    const bool antiEntropy =
+        deltaMode && (heartbeatRound_++ % FLAGS_heartbeat_full_report_rounds == 0);
     std::unordered_map<GraphSpaceID, std::vector<cpp2::LeaderInfo>> leaderIds;
     if (listener_ != nullptr) {
       listener_->fetchLeaderInfo(leaderIds);
-      if (leaderIds_ != leaderIds) {
+      bool changed = leaderIds_ != leaderIds;
+      if (changed) {
         {
           folly::SharedMutex::WriteHolder holder(leaderIdsLock_);
           leaderIds_.clear();
           leaderIds_ = leaderIds;
         }
       }
-      req.leader_partIds_ref() = std::move(leaderIds);
-    } else {
+      if (!deltaMode || changed || antiEntropy) {
+        req.leader_partIds_ref() = std::move(leaderIds);
+      }
+    } else if (!deltaMode || antiEntropy) {
       req.leader_partIds_ref() = std::move(leaderIds);
     }
 
     kvstore::SpaceDiskPartsMap diskParts;
     if (listener_ != nullptr) {
       listener_->fetchDiskParts(diskParts);
-      if (diskParts_ != diskParts) {
+      bool changed = diskParts_ != diskParts;
+      if (changed) {
         {
           folly::SharedMutex::WriteHolder holder(&diskPartsLock_);
           diskParts_.clear();
           diskParts_ = diskParts;
         }
+      }
+      if (changed || antiEntropy) {
         req.disk_parts_ref() = diskParts;
       }
-    } else {
+    } else if (!deltaMode || antiEntropy) {
       req.disk_parts_ref() = diskParts;
     }
   }
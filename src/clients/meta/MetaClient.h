@@ -82,15 +82,17 @@ struct SpaceInfoCache {
   PartsAlloc partsAlloc_;
   std::unordered_map<HostAddr, std::vector<PartitionID>> partsOnHost_;
   std::vector<cpp2::TagItem> tagItemVec_;
-  TagSchemas tagSchemas_;
+  std::shared_ptr<const TagSchemas> tagSchemas_ = std::make_shared<const TagSchemas>();
   std::vector<cpp2::EdgeItem> edgeItemVec_;
-  EdgeSchemas edgeSchemas_;
+  std::shared_ptr<const EdgeSchemas> edgeSchemas_ = std::make_shared<const EdgeSchemas>();
   std::vector<cpp2::IndexItem> tagIndexItemVec_;
   Indexes tagIndexes_;
   std::vector<cpp2::IndexItem> edgeIndexItemVec_;
   Indexes edgeIndexes_;
   Listeners listeners_;
   std::unordered_map<PartitionID, TermID> termOfPartition_;
+  // when this space was last changed on metad, 0 means unknown
+  int64_t updateTime_{0};
 
   SpaceInfoCache() = default;
   SpaceInfoCache(const SpaceInfoCache& info)
@@ -106,7 +108,8 @@ struct SpaceInfoCache {
         edgeIndexItemVec_(info.edgeIndexItemVec_),
         edgeIndexes_(info.edgeIndexes_),
         listeners_(info.listeners_),
-        termOfPartition_(info.termOfPartition_) {}
+        termOfPartition_(info.termOfPartition_),
+        updateTime_(info.updateTime_) {}
 
   ~SpaceInfoCache() = default;
 };
@@ -558,11 +561,11 @@ class MetaClient : public BaseMetaClient {
                                                                                EdgeType edgeType,
                                                                                SchemaVer ver = -1);
 
-  StatusOr<TagSchemas> getAllVerTagSchema(GraphSpaceID spaceId);
+  StatusOr<std::shared_ptr<const TagSchemas>> getAllVerTagSchema(GraphSpaceID spaceId);
 
   StatusOr<TagSchema> getAllLatestVerTagSchema(const GraphSpaceID& spaceId);
 
-  StatusOr<EdgeSchemas> getAllVerEdgeSchema(GraphSpaceID spaceId);
+  StatusOr<std::shared_ptr<const EdgeSchemas>> getAllVerEdgeSchema(GraphSpaceID spaceId);
 
   StatusOr<EdgeSchema> getAllLatestVerEdgeSchemaFromCache(const GraphSpaceID& spaceId);
 
@@ -686,6 +689,25 @@ class MetaClient : public BaseMetaClient {
                    SpaceNewestEdgeVerMap& newestEdgeVerMap,
                    SpaceAllEdgeMap& allEdgemap);
 
+  // fill the per-space lookup maps from an already fetched (or cached) space, so an
+  // unchanged space can be reused without fetching it from metad again
+  void addSchemasToMaps(GraphSpaceID spaceId,
+                        const SpaceInfoCache& cache,
+                        SpaceTagNameIdMap& tagNameIdMap,
+                        SpaceTagIdNameMap& tagIdNameMap,
+                        SpaceEdgeNameTypeMap& edgeNameTypeMap,
+                        SpaceEdgeTypeNameMap& edgeTypeNamemap,
+                        SpaceNewestTagVerMap& newestTagVerMap,
+                        SpaceNewestEdgeVerMap& newestEdgeVerMap,
+                        SpaceAllEdgeMap& allEdgemap);
+
+  void addIndexesToMaps(GraphSpaceID spaceId, const SpaceInfoCache& cache);
+
+  // like listSpaces, but also returns when each space was last changed on metad
+  folly::Future<
+      StatusOr<std::pair<std::vector<SpaceIdName>, std::unordered_map<GraphSpaceID, int64_t>>>>
+  listSpacesWithUpdateTimes();
+
   bool loadUsersAndRoles();
 
   bool loadIndexes(GraphSpaceID spaceId, std::shared_ptr<SpaceInfoCache> cache);
@@ -769,6 +791,10 @@ class MetaClient : public BaseMetaClient {
   // diskPartsLock_ is used to protect diskParts_;
   kvstore::SpaceDiskPartsMap diskParts_;
   folly::SharedMutex diskPartsLock_;
+  // Counts heartbeats so a full leader/disk report can be forced periodically when
+  // FLAGS_heartbeat_full_report_rounds enables delta reporting. Only touched from the
+  // heartbeat thread; reset after a failed heartbeat to resync metad on the next round.
+  uint32_t heartbeatRound_{0};
 
   std::atomic<int64_t> localDataLastUpdateTime_{-1};
   std::atomic<int64_t> localCfgLastUpdateTime_{-1};
@@ -6,6 +6,12 @@
 #include "clients/storage/StorageClient.h"
 
 #include "common/base/Base.h"
+#include "common/time/WallClock.h"
+
+DEFINE_int64(storage_client_max_scanned_keys,
+             0,
+             "Hard budget of key-values one storage request may examine before it stops and "
+             "returns a partial result, 0 means unlimited");
 
 using nebula::cpp2::PropertyType;
 using nebula::storage::cpp2::ExecResponse;
@@ -34,6 +40,16 @@ cpp2::RequestCommon StorageClient::CommonRequestParam::toReqCommon() const {
   common.session_id_ref() = session;
   common.plan_id_ref() = plan;
   common.profile_detail_ref() = profile;
+  if (deadlineUs > 0) {
+    // Ship the remaining budget instead of the absolute deadline so clock skew between
+    // graphd and storaged does not matter. An already-expired deadline still sends 1ms so
+    // storaged aborts promptly on arrival.
+    auto remainingUs = deadlineUs - time::WallClock::fastNowInMicroSec();
+    common.timeout_ms_ref() = std::max<int64_t>(remainingUs / 1000, 1);
+  }
+  if (FLAGS_storage_client_max_scanned_keys > 0) {
+    common.max_scanned_keys_ref() = FLAGS_storage_client_max_scanned_keys;
+  }
   return common;
 }
 
@@ -52,7 +68,8 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::getNeighbors(
     const std::vector<cpp2::OrderBy>& orderBy,
     int64_t limit,
     const Expression* filter,
-    const Expression* tagFilter) {
+    const Expression* tagFilter,
+    std::function<void(cpp2::GetNeighborsResponse&)> onEachResponse) {
   auto cbStatus = getIdFromValue(param.space);
   if (!cbStatus.ok()) {
     return folly::makeFuture<StorageRpcResponse<cpp2::GetNeighborsResponse>>(
@@ -104,17 +121,20 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::getNeighbors(
     req.traverse_spec_ref() = std::move(spec);
   }
 
-  return collectResponse(param.evb,
-                         std::move(requests),
-                         [](ThriftClientType* client, const cpp2::GetNeighborsRequest& r) {
-                           return client->future_getNeighbors(r);
-                         });
+  return collectResponse(
+      param.evb,
+      std::move(requests),
+      [](ThriftClientType* client, cpp2::GetNeighborsRequest&& r) {
+        return client->future_getNeighbors(std::move(r));
+      },
+      std::move(onEachResponse));
 }
 
 StorageRpcRespFuture<cpp2::GetDstBySrcResponse> StorageClient::getDstBySrc(
     const CommonRequestParam& param,
     const std::vector<Value>& vertices,
-    const std::vector<EdgeType>& edgeTypes) {
+    const std::vector<EdgeType>& edgeTypes,
+    int32_t maxHops) {
   auto cbStatus = getIdFromValue(param.space);
   if (!cbStatus.ok()) {
     return folly::makeFuture<StorageRpcResponse<cpp2::GetDstBySrcResponse>>(
@@ -137,12 +157,13 @@ StorageRpcRespFuture<cpp2::GetDstBySrcResponse> StorageClient::getDstBySrc(
     req.parts_ref() = std::move(c.second);
     req.edge_types_ref() = edgeTypes;
     req.common_ref() = common;
+    req.max_hops_ref() = maxHops;
   }
 
   return collectResponse(param.evb,
                          std::move(requests),
-                         [](ThriftClientType* client, const cpp2::GetDstBySrcRequest& r) {
-                           return client->future_getDstBySrc(r);
+                         [](ThriftClientType* client, cpp2::GetDstBySrcRequest&& r) {
+                           return client->future_getDstBySrc(std::move(r));
                          });
 }
 
@@ -180,8 +201,8 @@ StorageRpcRespFuture<cpp2::ExecResponse> StorageClient::addVertices(
 
   return collectResponse(param.evb,
                          std::move(requests),
-                         [](ThriftClientType* client, const cpp2::AddVerticesRequest& r) {
-                           return client->future_addVertices(r);
+                         [](ThriftClientType* client, cpp2::AddVerticesRequest&& r) {
+                           return client->future_addVertices(std::move(r));
                          });
 }
 
@@ -218,9 +239,9 @@ StorageRpcRespFuture<cpp2::ExecResponse> StorageClient::addEdges(const CommonReq
   return collectResponse(param.evb,
                          std::move(requests),
                          [useToss = param.useExperimentalFeature](ThriftClientType* client,
-                                                                  const cpp2::AddEdgesRequest& r) {
-                           return useToss ? client->future_chainAddEdges(r)
-                                          : client->future_addEdges(r);
+                                                                  cpp2::AddEdgesRequest&& r) {
+                           return useToss ? client->future_chainAddEdges(std::move(r))
+                                          : client->future_addEdges(std::move(r));
                          });
 }
 
@@ -233,7 +254,9 @@ StorageRpcRespFuture<cpp2::GetPropResponse> StorageClient::getProps(
     bool dedup,
     const std::vector<cpp2::OrderBy>& orderBy,
     int64_t limit,
-    const Expression* filter) {
+    const Expression* filter,
+    std::function<void(cpp2::GetPropResponse&)> onEachResponse,
+    bool existsOnly) {
   auto cbStatus = getIdFromRow(param.space, edgeProps != nullptr);
   if (!cbStatus.ok()) {
     return folly::makeFuture<StorageRpcResponse<cpp2::GetPropResponse>>(
@@ -271,13 +294,19 @@ StorageRpcRespFuture<cpp2::GetPropResponse> StorageClient::getProps(
     if (filter != nullptr) {
       req.filter_ref() = filter->encode();
     }
+    if (existsOnly) {
+      req.exists_only_ref() = true;
+    }
     req.common_ref() = common;
   }
 
   return collectResponse(
-      param.evb, std::move(requests), [](ThriftClientType* client, const cpp2::GetPropRequest& r) {
-        return client->future_getProps(r);
-      });
+      param.evb,
+      std::move(requests),
+      [](ThriftClientType* client, cpp2::GetPropRequest&& r) {
+        return client->future_getProps(std::move(r));
+      },
+      std::move(onEachResponse));
 }
 
 StorageRpcRespFuture<cpp2::ExecResponse> StorageClient::deleteEdges(
@@ -308,9 +337,9 @@ StorageRpcRespFuture<cpp2::ExecResponse> StorageClient::deleteEdges(
   return collectResponse(param.evb,
                          std::move(requests),
                          [useToss = param.useExperimentalFeature](
-                             ThriftClientType* client, const cpp2::DeleteEdgesRequest& r) {
-                           return useToss ? client->future_chainDeleteEdges(r)
-                                          : client->future_deleteEdges(r);
+                             ThriftClientType* client, cpp2::DeleteEdgesRequest&& r) {
+                           return useToss ? client->future_chainDeleteEdges(std::move(r))
+                                          : client->future_deleteEdges(std::move(r));
                          });
 }
 
@@ -341,8 +370,8 @@ StorageRpcRespFuture<cpp2::ExecResponse> StorageClient::deleteVertices(
 
   return collectResponse(param.evb,
                          std::move(requests),
-                         [](ThriftClientType* client, const cpp2::DeleteVerticesRequest& r) {
-                           return client->future_deleteVertices(r);
+                         [](ThriftClientType* client, cpp2::DeleteVerticesRequest&& r) {
+                           return client->future_deleteVertices(std::move(r));
                          });
 }
 
@@ -373,8 +402,8 @@ StorageRpcRespFuture<cpp2::ExecResponse> StorageClient::deleteTags(
 
   return collectResponse(param.evb,
                          std::move(requests),
-                         [](ThriftClientType* client, const cpp2::DeleteTagsRequest& r) {
-                           return client->future_deleteTags(r);
+                         [](ThriftClientType* client, cpp2::DeleteTagsRequest&& r) {
+                           return client->future_deleteTags(std::move(r));
                          });
 }
 
@@ -423,11 +452,92 @@ folly::Future<StatusOr<storage::cpp2::UpdateResponse>> StorageClient::updateVert
   return getResponse(param.evb,
                      host.value(),
                      req,
-                     [](ThriftClientType* client, const cpp2::UpdateVertexRequest& r) {
-                       return client->future_updateVertex(r);
+                     [](ThriftClientType* client, cpp2::UpdateVertexRequest&& r) {
+                       return client->future_updateVertex(std::move(r));
                      });
 }
 
+folly::Future<StatusOr<std::vector<storage::cpp2::UpdateResponse>>>
+StorageClient::batchUpdateVertex(const CommonRequestParam& param,
+                                 std::vector<Value> vertexIds,
+                                 TagID tagId,
+                                 std::vector<cpp2::UpdatedProp> updatedProps,
+                                 bool insertable,
+                                 std::vector<std::string> returnProps,
+                                 std::string condition) {
+  using RespType = StatusOr<std::vector<storage::cpp2::UpdateResponse>>;
+  auto cbStatus = getIdFromValue(param.space);
+  if (!cbStatus.ok()) {
+    return folly::makeFuture<RespType>(cbStatus.status());
+  }
+  auto cb = std::move(cbStatus).value();
+
+  DCHECK(!!metaClient_);
+  auto status = metaClient_->partsNum(param.space);
+  if (!status.ok()) {
+    return Status::Error("Space not found, spaceid: %d", param.space);
+  }
+  auto numParts = status.value();
+
+  // One request per part carrying every id of that part, so a feed-ingestion batch
+  // costs one RPC and one raft group entry stream per part instead of one per row
+  std::unordered_map<PartitionID, std::vector<Value>> partVids;
+  for (auto& vid : vertexIds) {
+    auto partStatus = metaClient_->partId(numParts, cb(vid));
+    if (!partStatus.ok()) {
+      return folly::makeFuture<RespType>(partStatus.status());
+    }
+    partVids[partStatus.value()].emplace_back(std::move(vid));
+  }
+
+  std::vector<folly::Future<StatusOr<storage::cpp2::UpdateResponse>>> futures;
+  futures.reserve(partVids.size());
+  for (auto& partEntry : partVids) {
+    auto host = this->getLeader(param.space, partEntry.first);
+    if (!host.ok()) {
+      return folly::makeFuture<RespType>(host.status());
+    }
+    cpp2::UpdateVertexRequest req;
+    req.space_id_ref() = param.space;
+    req.part_id_ref() = partEntry.first;
+    req.vertex_id_ref() = partEntry.second.front();
+    req.vertex_ids_ref() = std::move(partEntry.second);
+    req.tag_id_ref() = tagId;
+    req.updated_props_ref() = updatedProps;
+    req.return_props_ref() = returnProps;
+    req.insertable_ref() = insertable;
+    req.common_ref() = param.toReqCommon();
+    if (condition.size() > 0) {
+      req.condition_ref() = condition;
+    }
+    futures.emplace_back(
+        getResponse(param.evb,
+                    host.value(),
+                    std::move(req),
+                    [](ThriftClientType* client, cpp2::UpdateVertexRequest&& r) {
+                      return client->future_updateVertex(std::move(r));
+                    }));
+  }
+
+  return folly::collectAll(std::move(futures))
+      .deferValue([](std::vector<folly::Try<StatusOr<storage::cpp2::UpdateResponse>>>&& tries)
+                      -> RespType {
+        std::vector<storage::cpp2::UpdateResponse> resps;
+        resps.reserve(tries.size());
+        for (auto& t : tries) {
+          if (t.hasException()) {
+            return Status::Error("RPC failure in StorageClient: %s",
+                                 t.exception().what().c_str());
+          }
+          if (!t.value().ok()) {
+            return t.value().status();
+          }
+          resps.emplace_back(std::move(t.value()).value());
+        }
+        return resps;
+      });
+}
+
 folly::Future<StatusOr<storage::cpp2::UpdateResponse>> StorageClient::updateEdge(
     const CommonRequestParam& param,
     storage::cpp2::EdgeKey edgeKey,
@@ -473,9 +583,9 @@ folly::Future<StatusOr<storage::cpp2::UpdateResponse>> StorageClient::updateEdge
                      host.value(),
                      req,
                      [useExperimentalFeature = param.useExperimentalFeature](
-                         ThriftClientType* client, const cpp2::UpdateEdgeRequest& r) {
-                       return useExperimentalFeature ? client->future_chainUpdateEdge(r)
-                                                     : client->future_updateEdge(r);
+                         ThriftClientType* client, cpp2::UpdateEdgeRequest&& r) {
+                       return useExperimentalFeature ? client->future_chainUpdateEdge(std::move(r))
+                                                     : client->future_updateEdge(std::move(r));
                      });
 }
 
@@ -504,8 +614,8 @@ folly::Future<StatusOr<cpp2::GetUUIDResp>> StorageClient::getUUID(GraphSpaceID s
   req.name_ref() = name;
 
   return getResponse(
-      evb, host.value(), req, [](ThriftClientType* client, const cpp2::GetUUIDReq& r) {
-        return client->future_getUUID(r);
+      evb, host.value(), req, [](ThriftClientType* client, cpp2::GetUUIDReq&& r) {
+        return client->future_getUUID(std::move(r));
       });
 }
 
@@ -516,7 +626,8 @@ StorageRpcRespFuture<cpp2::LookupIndexResp> StorageClient::lookupIndex(
     int32_t tagOrEdge,
     const std::vector<std::string>& returnCols,
     std::vector<storage::cpp2::OrderBy> orderBy,
-    int64_t limit) {
+    int64_t limit,
+    std::vector<storage::cpp2::StatProp> statColumns) {
   // TODO(sky) : instead of isEdge and tagOrEdge to nebula::cpp2::SchemaID for graph layer.
   auto space = param.space;
   auto status = getHostParts(space);
@@ -548,12 +659,15 @@ StorageRpcRespFuture<cpp2::LookupIndexResp> StorageClient::lookupIndex(
     req.common_ref() = common;
     req.limit_ref() = limit;
     req.order_by_ref() = orderBy;
+    if (!statColumns.empty()) {
+      req.stat_columns_ref() = statColumns;
+    }
   }
 
   return collectResponse(param.evb,
                          std::move(requests),
-                         [](ThriftClientType* client, const cpp2::LookupIndexRequest& r) {
-                           return client->future_lookupIndex(r);
+                         [](ThriftClientType* client, cpp2::LookupIndexRequest&& r) {
+                           return client->future_lookupIndex(std::move(r));
                          });
 }
 
@@ -581,8 +695,8 @@ StorageRpcRespFuture<cpp2::GetNeighborsResponse> StorageClient::lookupAndTravers
 
   return collectResponse(param.evb,
                          std::move(requests),
-                         [](ThriftClientType* client, const cpp2::LookupAndTraverseRequest& r) {
-                           return client->future_lookupAndTraverse(r);
+                         [](ThriftClientType* client, cpp2::LookupAndTraverseRequest&& r) {
+                           return client->future_lookupAndTraverse(std::move(r));
                          });
 }
 
@@ -612,8 +726,8 @@ StorageRpcRespFuture<cpp2::ScanResponse> StorageClient::scanEdge(
   }
 
   return collectResponse(
-      param.evb, std::move(requests), [](ThriftClientType* client, const cpp2::ScanEdgeRequest& r) {
-        return client->future_scanEdge(r);
+      param.evb, std::move(requests), [](ThriftClientType* client, cpp2::ScanEdgeRequest&& r) {
+        return client->future_scanEdge(std::move(r));
       });
 }
 
@@ -644,8 +758,8 @@ StorageRpcRespFuture<cpp2::ScanResponse> StorageClient::scanVertex(
 
   return collectResponse(param.evb,
                          std::move(requests),
-                         [](ThriftClientType* client, const cpp2::ScanVertexRequest& r) {
-                           return client->future_scanVertex(r);
+                         [](ThriftClientType* client, cpp2::ScanVertexRequest&& r) {
+                           return client->future_scanVertex(std::move(r));
                          });
 }
 
@@ -670,8 +784,8 @@ folly::SemiFuture<StorageRpcResponse<cpp2::KVGetResponse>> StorageClient::get(
   }
 
   return collectResponse(
-      evb, std::move(requests), [](ThriftClientType* client, const cpp2::KVGetRequest& r) {
-        return client->future_get(r);
+      evb, std::move(requests), [](ThriftClientType* client, cpp2::KVGetRequest&& r) {
+        return client->future_get(std::move(r));
       });
 }
 
@@ -695,8 +809,8 @@ folly::SemiFuture<StorageRpcResponse<cpp2::ExecResponse>> StorageClient::put(
   }
 
   return collectResponse(
-      evb, std::move(requests), [](ThriftClientType* client, const cpp2::KVPutRequest& r) {
-        return client->future_put(r);
+      evb, std::move(requests), [](ThriftClientType* client, cpp2::KVPutRequest&& r) {
+        return client->future_put(std::move(r));
       });
 }
 
@@ -720,8 +834,8 @@ folly::SemiFuture<StorageRpcResponse<cpp2::ExecResponse>> StorageClient::remove(
   }
 
   return collectResponse(
-      evb, std::move(requests), [](ThriftClientType* client, const cpp2::KVRemoveRequest& r) {
-        return client->future_remove(r);
+      evb, std::move(requests), [](ThriftClientType* client, cpp2::KVRemoveRequest&& r) {
+        return client->future_remove(std::move(r));
       });
 }
 
@@ -46,6 +46,9 @@ class StorageClient
     bool profile{false};
     bool useExperimentalFeature{false};
     folly::EventBase* evb{nullptr};
+    // Wall clock time in us the query must finish by, 0 if it has no deadline. Sent to
+    // storaged as the remaining budget so it stops scanning for abandoned queries.
+    int64_t deadlineUs{0};
 
     CommonRequestParam(GraphSpaceID space_,
                        SessionID sess,
@@ -79,12 +82,14 @@ class StorageClient
       const std::vector<cpp2::OrderBy>& orderBy = std::vector<cpp2::OrderBy>(),
       int64_t limit = std::numeric_limits<int64_t>::max(),
       const Expression* filter = nullptr,
-      const Expression* tagFilter = nullptr);
+      const Expression* tagFilter = nullptr,
+      std::function<void(cpp2::GetNeighborsResponse&)> onEachResponse = nullptr);
 
   StorageRpcRespFuture<cpp2::GetDstBySrcResponse> getDstBySrc(
       const CommonRequestParam& param,
       const std::vector<Value>& vertices,
-      const std::vector<EdgeType>& edgeTypes);
+      const std::vector<EdgeType>& edgeTypes,
+      int32_t maxHops = 1);
 
   StorageRpcRespFuture<cpp2::GetPropResponse> getProps(
       const CommonRequestParam& param,
@@ -95,7 +100,10 @@ class StorageClient
       bool dedup = false,
       const std::vector<cpp2::OrderBy>& orderBy = std::vector<cpp2::OrderBy>(),
       int64_t limit = std::numeric_limits<int64_t>::max(),
-      const Expression* filter = nullptr);
+      const Expression* filter = nullptr,
+      std::function<void(cpp2::GetPropResponse&)> onEachResponse = nullptr,
+      // Only check vertex existence, one (_vid, _exists) row per input instead of props
+      bool existsOnly = false);
 
   StorageRpcRespFuture<cpp2::ExecResponse> addVertices(
       const CommonRequestParam& param,
@@ -128,6 +136,17 @@ class StorageClient
       std::vector<std::string> returnProps,
       std::string condition);
 
+  // Batch form of updateVertex: groups the ids by part and sends one request per part,
+  // one response entry per request
+  folly::Future<StatusOr<std::vector<storage::cpp2::UpdateResponse>>> batchUpdateVertex(
+      const CommonRequestParam& param,
+      std::vector<Value> vertexIds,
+      TagID tagId,
+      std::vector<cpp2::UpdatedProp> updatedProps,
+      bool insertable,
+      std::vector<std::string> returnProps,
+      std::string condition);
+
   folly::Future<StatusOr<storage::cpp2::UpdateResponse>> updateEdge(
       const CommonRequestParam& param,
       storage::cpp2::EdgeKey edgeKey,
@@ -147,7 +166,9 @@ class StorageClient
       int32_t tagOrEdge,
       const std::vector<std::string>& returnCols,
       std::vector<storage::cpp2::OrderBy> orderBy,
-      int64_t limit);
+      int64_t limit,
+      // Per-part aggregates to compute in storage, returned in LookupIndexResp.stat_data
+      std::vector<storage::cpp2::StatProp> statColumns = {});
 
   StorageRpcRespFuture<cpp2::GetNeighborsResponse> lookupAndTraverse(
       const CommonRequestParam& param, cpp2::IndexSpec indexSpec, cpp2::TraverseSpec traverseSpec);
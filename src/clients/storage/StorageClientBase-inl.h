@@ -75,7 +75,8 @@ folly::SemiFuture<StorageRpcResponse<Response>>
 StorageClientBase<ClientType, ClientManagerType>::collectResponse(
     folly::EventBase* evb,
     std::unordered_map<HostAddr, Request> requests,
-    RemoteFunc&& remoteFunc) {
+    RemoteFunc&& remoteFunc,
+    std::function<void(Response&)> onEachResponse) {
   memory::MemoryCheckOffGuard offGuard;
   std::vector<folly::Future<StatusOr<Response>>> respFutures;
   respFutures.reserve(requests.size());
@@ -95,6 +96,15 @@ StorageClientBase<ClientType, ClientManagerType>::collectResponse(
                    .ensure([totalLatencies, i, start]() {
                      (*totalLatencies)[i] = time::WallClock::fastNowInMicroSec() - start;
                    });
+    if (onEachResponse) {
+      // since all requests share the same eventbase, the hooks never run concurrently
+      fut = std::move(fut).thenValue([onEachResponse](StatusOr<Response>&& status) {
+        if (status.ok()) {
+          onEachResponse(status.value());
+        }
+        return std::move(status);
+      });
+    }
 
     respFutures.emplace_back(std::move(fut));
   }
@@ -157,7 +167,7 @@ template <class Request, class RemoteFunc, class Response>
 folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerType>::getResponse(
     folly::EventBase* evb, const HostAddr& host, const Request& request, RemoteFunc&& remoteFunc) {
   static_assert(
-      folly::isFuture<std::invoke_result_t<RemoteFunc, ClientType*, const Request&>>::value);
+      folly::isFuture<std::invoke_result_t<RemoteFunc, ClientType*, Request&&>>::value);
 
   stats::StatsManager::addValue(kNumRpcSentToStoraged);
   if (evb == nullptr) {
@@ -165,15 +175,36 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
   }
 
   auto spaceId = request.get_space_id();
-  return folly::via(evb)
-      .thenValue([remoteFunc = std::move(remoteFunc), request, evb, host, this](auto&&) {
+  HostConcurrencyLimiter* limiter = nullptr;
+  folly::SemiFuture<folly::Unit> slot = folly::makeSemiFuture(folly::Unit());
+  if (FLAGS_storage_client_adaptive_concurrency) {
+    limiter = limiterOf(host);
+    slot = limiter->acquire();
+  }
+  // send time is recorded once the limiter grants a slot, so queueing does not count as
+  // host latency and cannot spiral the window down
+  auto sendTime = std::make_shared<int64_t>(0);
+  return std::move(slot)
+      .via(evb)
+      .thenValue([remoteFunc = std::move(remoteFunc), request, evb, host, sendTime, this](
+                     auto&&) mutable {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
+        *sendTime = time::WallClock::fastNowInMicroSec();
         // NOTE: Create new channel on each thread to avoid TIMEOUT RPC error
         auto client = clientsMan_->client(host, evb, false, FLAGS_storage_client_timeout_ms);
         // Encoding invoke Cpp2Ops::write the request to protocol is in current thread,
         // do not need to turn on in Cpp2Ops::write
-        return remoteFunc(client.get(), request);
+        // The request is handed over as an rvalue: the local in-process server moves it,
+        // the remote thrift client just serializes from it
+        return remoteFunc(client.get(), std::move(request));
+      })
+      .ensure([limiter, sendTime]() {
+        if (limiter != nullptr) {
+          auto latency =
+              *sendTime > 0 ? time::WallClock::fastNowInMicroSec() - *sendTime : int64_t(0);
+          limiter->release(latency);
+        }
       })
       .thenValue([spaceId, this](Response&& resp) mutable -> StatusOr<Response> {
         // MemoryTrackerVerified
@@ -236,6 +267,17 @@ folly::Future<StatusOr<Response>> StorageClientBase<ClientType, ClientManagerTyp
       });
 }
 
+template <typename ClientType, typename ClientManagerType>
+HostConcurrencyLimiter* StorageClientBase<ClientType, ClientManagerType>::limiterOf(
+    const HostAddr& host) {
+  std::lock_guard<std::mutex> guard(limitersLock_);
+  auto& limiter = limiters_[host];
+  if (limiter == nullptr) {
+    limiter = std::make_unique<HostConcurrencyLimiter>();
+  }
+  return limiter.get();
+}
+
 template <typename ClientType, typename ClientManagerType>
 template <class Container, class GetIdFunc>
 StatusOr<std::unordered_map<
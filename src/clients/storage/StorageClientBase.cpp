@@ -9,7 +9,63 @@ DEFINE_int32(storage_client_timeout_ms, 60 * 1000, "storage client timeout");
 DEFINE_uint32(storage_client_retry_interval_ms,
               1000,
               "storage client sleep interval milliseconds between retry");
+DEFINE_bool(storage_client_adaptive_concurrency,
+            false,
+            "if true, bound the in-flight rpc per storaged with a latency gradient window");
+DEFINE_uint32(storage_client_max_inflight_per_host,
+              256,
+              "upper bound of the adaptive in-flight rpc window per storaged");
 
 namespace nebula {
-namespace storage {}  // namespace storage
+namespace storage {
+
+folly::SemiFuture<folly::Unit> HostConcurrencyLimiter::acquire() {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (inflight_ < limit_) {
+    inflight_++;
+    return folly::makeSemiFuture(folly::Unit());
+  }
+  waiters_.emplace_back();
+  return waiters_.back().getSemiFuture();
+}
+
+void HostConcurrencyLimiter::release(int64_t latencyUs) {
+  std::vector<folly::Promise<folly::Unit>> ready;
+  {
+    std::lock_guard<std::mutex> guard(lock_);
+    inflight_--;
+    updateLimit(latencyUs);
+    while (!waiters_.empty() && inflight_ < limit_) {
+      ready.emplace_back(std::move(waiters_.front()));
+      waiters_.pop_front();
+      inflight_++;
+    }
+  }
+  for (auto& promise : ready) {
+    promise.setValue(folly::Unit());
+  }
+}
+
+void HostConcurrencyLimiter::updateLimit(int64_t latencyUs) {
+  if (latencyUs <= 0) {
+    return;
+  }
+  if (minLatencyUs_ == 0.0 || latencyUs < minLatencyUs_) {
+    minLatencyUs_ = latencyUs;
+  } else {
+    // let the floor drift up slowly so it can follow a genuine load change
+    minLatencyUs_ *= 1.001;
+  }
+  ewmaLatencyUs_ = ewmaLatencyUs_ == 0.0 ? latencyUs : ewmaLatencyUs_ * 0.8 + latencyUs * 0.2;
+  auto gradient = minLatencyUs_ / ewmaLatencyUs_;
+  if (gradient > 0.67) {
+    if (limit_ < FLAGS_storage_client_max_inflight_per_host) {
+      limit_++;
+    }
+  } else {
+    limit_ = std::max<size_t>(static_cast<size_t>(limit_ * gradient), 1);
+  }
+}
+
+}  // namespace storage
 }  // namespace nebula
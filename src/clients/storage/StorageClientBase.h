@@ -9,6 +9,9 @@
 #include <folly/executors/IOThreadPoolExecutor.h>
 #include <folly/futures/Future.h>
 
+#include <deque>
+#include <mutex>
+
 #include "clients/meta/MetaClient.h"
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
@@ -19,10 +22,37 @@
 
 DECLARE_int32(storage_client_timeout_ms);
 DECLARE_uint32(storage_client_retry_interval_ms);
+DECLARE_bool(storage_client_adaptive_concurrency);
+DECLARE_uint32(storage_client_max_inflight_per_host);
 
 namespace nebula {
 namespace storage {
 
+/**
+ * Per-host adaptive concurrency limit. Requests beyond the window wait in a queue instead
+ * of being sent, and the window follows the latency gradient: it grows while the host
+ * keeps its latency near the observed floor and shrinks as latency drifts up, so a
+ * recovering storaged sees a trickle of requests instead of a thundering herd.
+ */
+class HostConcurrencyLimiter final {
+ public:
+  // resolves once an rpc slot is free, the caller must release() when the rpc finishes
+  folly::SemiFuture<folly::Unit> acquire();
+
+  // latencyUs <= 0 (the rpc never went out) releases the slot without moving the window
+  void release(int64_t latencyUs);
+
+ private:
+  void updateLimit(int64_t latencyUs);
+
+  std::mutex lock_;
+  std::deque<folly::Promise<folly::Unit>> waiters_;
+  size_t inflight_{0};
+  size_t limit_{8};
+  double minLatencyUs_{0.0};
+  double ewmaLatencyUs_{0.0};
+};
+
 template <class Response>
 class StorageRpcResponse final {
  public:
@@ -128,7 +158,10 @@ class StorageClientBase {
   folly::SemiFuture<StorageRpcResponse<Response>> collectResponse(
       folly::EventBase* evb,
       std::unordered_map<HostAddr, Request> requests,
-      RemoteFunc&& remoteFunc);
+      RemoteFunc&& remoteFunc,
+      // invoked on the IO thread for each successful response as it arrives, so the caller can
+      // consume the payload while other hosts are still responding
+      std::function<void(Response&)> onEachResponse = nullptr);
 
   template <class Request,
             class RemoteFunc,
@@ -202,8 +235,12 @@ class StorageClientBase {
   meta::MetaClient* metaClient_{nullptr};
 
  private:
+  HostConcurrencyLimiter* limiterOf(const HostAddr& host);
+
   std::shared_ptr<folly::IOThreadPoolExecutor> ioThreadPool_;
   std::unique_ptr<ClientManagerType> clientsMan_;
+  std::mutex limitersLock_;
+  std::unordered_map<HostAddr, std::unique_ptr<HostConcurrencyLimiter>> limiters_;
 };
 
 }  // namespace storage
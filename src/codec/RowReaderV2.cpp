@@ -5,18 +5,32 @@
 
 #include "codec/RowReaderV2.h"
 
+#include "common/base/SampledCheck.h"
+
 namespace nebula {
 
 using nebula::cpp2::PropertyType;
 
 bool RowReaderV2::resetImpl(meta::NebulaSchemaProvider const* schema, folly::StringPiece row) {
+  NG_SAMPLED_DCHECK(!!schema);
+
+  // Same schema and same header byte as the previous row: the version byte count and the
+  // null-flag layout cannot differ, so skip the header re-parse. The previous row's
+  // backing buffer may be gone already (a kvstore iterator's value slice dies on next()),
+  // so the comparison goes against the cached header byte, never through data_.
+  if (schema == schema_ && headerValid_ && !row.empty() &&
+      static_cast<uint8_t>(row[0]) == lastHeaderByte_) {
+    data_ = row;
+    return true;
+  }
+
   schema_ = schema;
   data_ = row;
 
-  DCHECK(!!schema_);
-
   size_t numVerBytes = data_[0] & 0x07;
   headerLen_ = numVerBytes + 1;
+  lastHeaderByte_ = static_cast<uint8_t>(data_[0]);
+  headerValid_ = true;
 
 #ifndef NDEBUG
   // Get the schema version
@@ -56,7 +70,11 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const {
     return Value(NullType::UNKNOWN_PROP);
   }
 
-  auto field = schema_->field(index);
+  return getValueByField(schema_->field(index));
+}
+
+Value RowReaderV2::getValueByField(const meta::NebulaSchemaProvider::SchemaField* field) const {
+  NG_SAMPLED_DCHECK(field != nullptr);
   size_t offset = headerLen_ + numNullBytes_ + field->offset();
 
   if (field->nullable() && isNull(field->nullFlagPos())) {
@@ -112,7 +130,7 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const {
       if (static_cast<size_t>(strOffset) == data_.size() && strLen == 0) {
         return std::string();
       }
-      CHECK_LT(strOffset, data_.size());
+      NG_SAMPLED_CHECK_LT(strOffset, data_.size());
       return std::string(&data_[strOffset], strLen);
     }
     case PropertyType::FIXED_STRING: {
@@ -196,7 +214,7 @@ Value RowReaderV2::getValueByIndex(const int64_t index) const {
       if (static_cast<size_t>(strOffset) == data_.size() && strLen == 0) {
         return Value::kEmpty;  // Is it ok to return Value::kEmpty?
       }
-      CHECK_LT(strOffset, data_.size());
+      NG_SAMPLED_CHECK_LT(strOffset, data_.size());
       auto wkb = std::string(&data_[strOffset], strLen);
       // Parse a geography from the wkb, normalize it and then verify its validity.
       auto geogRet = Geography::fromWKB(wkb, true, true);
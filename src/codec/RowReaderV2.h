@@ -28,12 +28,30 @@ class RowReaderV2 {
 
   Value getValueByName(const std::string& prop) const;
   Value getValueByIndex(const int64_t index) const;
+  /**
+   * Decode a single field from a pre-resolved field descriptor, skipping the per-row
+   * name/index resolution. The caller must make sure the field belongs to the very schema
+   * this reader was reset with, otherwise the decoded offsets would be meaningless.
+   */
+  Value getValueByField(const meta::NebulaSchemaProvider::SchemaField* field) const;
   int64_t getTimestamp() const noexcept;
 
   size_t headerLen() const noexcept {
     return headerLen_;
   }
 
+  size_t numNullBytes() const noexcept {
+    return numNullBytes_;
+  }
+
+  /**
+   * The raw encoded row this reader was reset with, for evaluators working directly over the
+   * encoded bytes.
+   */
+  folly::StringPiece rawData() const noexcept {
+    return data_;
+  }
+
   const meta::NebulaSchemaProvider* getSchema() const {
     return schema_;
   }
@@ -51,13 +69,22 @@ class RowReaderV2 {
   }
 
  private:
+  /**
+   * Point the reader at a new encoded row. When the schema and the header byte match the
+   * previous row, the header layout is identical and only the data pointer is swapped, so
+   * readers held across a scan loop re-parse the header only on schema version changes.
+   */
   bool resetImpl(meta::NebulaSchemaProvider const* schema, folly::StringPiece row);
 
  private:
-  meta::NebulaSchemaProvider const* schema_;
+  meta::NebulaSchemaProvider const* schema_{nullptr};
   folly::StringPiece data_;
-  size_t headerLen_;
-  size_t numNullBytes_;
+  size_t headerLen_{0};
+  size_t numNullBytes_{0};
+  // Header byte of the last fully parsed row, compared instead of data_[0] in the reset
+  // fast path since data_ may point at an already released buffer by then
+  uint8_t lastHeaderByte_{0};
+  bool headerValid_{false};
 
   RowReaderV2() = default;
 
@@ -153,6 +153,11 @@ class RowReaderWrapper {
     return currReader_->getValueByIndex(index);
   }
 
+  Value getValueByField(const meta::NebulaSchemaProvider::SchemaField* field) const {
+    DCHECK(!!currReader_);
+    return currReader_->getValueByField(field);
+  }
+
   int64_t getTimestamp() const noexcept {
     DCHECK(!!currReader_);
     return currReader_->getTimestamp();
@@ -164,6 +169,16 @@ class RowReaderWrapper {
     return currReader_->headerLen();
   }
 
+  size_t numNullBytes() const noexcept {
+    DCHECK(!!currReader_);
+    return currReader_->numNullBytes();
+  }
+
+  folly::StringPiece rawData() const noexcept {
+    DCHECK(!!currReader_);
+    return currReader_->rawData();
+  }
+
   SchemaVer schemaVer() const noexcept {
     DCHECK(!!currReader_);
     return currReader_->schemaVer();
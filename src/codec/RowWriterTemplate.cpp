@@ -0,0 +1,300 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "codec/RowWriterTemplate.h"
+
+#include <cmath>
+
+#include "common/time/TimeUtils.h"
+#include "common/time/WallClock.h"
+
+namespace nebula {
+
+using nebula::cpp2::PropertyType;
+
+// static
+std::unique_ptr<RowWriterTemplate> RowWriterTemplate::make(
+    const meta::NebulaSchemaProvider* schema) {
+  CHECK(!!schema);
+  for (size_t i = 0; i < schema->getNumFields(); i++) {
+    switch (schema->field(i)->type()) {
+      case PropertyType::BOOL:
+      case PropertyType::INT8:
+      case PropertyType::INT16:
+      case PropertyType::INT32:
+      case PropertyType::INT64:
+      case PropertyType::TIMESTAMP:
+      case PropertyType::FLOAT:
+      case PropertyType::DOUBLE:
+        break;
+      default:
+        // Variant length or compound typed fields need the generic writer
+        return nullptr;
+    }
+  }
+
+  std::unique_ptr<RowWriterTemplate> tmpl(new RowWriterTemplate());
+  tmpl->schema_ = schema;
+
+  // The header byte and the schema version bytes, same encoding as the RowWriterV2
+  // constructor
+  char header;
+  size_t headerLen;
+  int64_t ver = schema->getVersion();
+  if (ver > 0) {
+    if (ver <= 0x00FF) {
+      header = 0x09;
+      headerLen = 2;
+    } else if (ver < 0x00FFFF) {
+      header = 0x0A;
+      headerLen = 3;
+    } else if (ver < 0x00FFFFFF) {
+      header = 0x0B;
+      headerLen = 4;
+    } else if (ver < 0x00FFFFFFFF) {
+      header = 0x0C;
+      headerLen = 5;
+    } else if (ver < 0x00FFFFFFFFFF) {
+      header = 0x0D;
+      headerLen = 6;
+    } else if (ver < 0x00FFFFFFFFFFFF) {
+      header = 0x0E;
+      headerLen = 7;
+    } else if (ver < 0x00FFFFFFFFFFFFFF) {
+      header = 0x0F;
+      headerLen = 8;
+    } else {
+      LOG(FATAL) << "Schema version too big";
+      header = 0x0F;
+      headerLen = 8;
+    }
+    tmpl->prototype_.append(&header, 1);
+    tmpl->prototype_.append(reinterpret_cast<char*>(&ver), headerLen - 1);
+  } else {
+    header = 0x08;
+    headerLen = 1;
+    tmpl->prototype_.append(&header, 1);
+  }
+
+  size_t numNullBytes = 0;
+  size_t numNullables = schema->getNumNullableFields();
+  if (numNullables > 0) {
+    numNullBytes = ((numNullables - 1) >> 3) + 1;
+  }
+  tmpl->prototype_.resize(headerLen + numNullBytes + schema->size(), '\0');
+
+  tmpl->slots_.reserve(schema->getNumFields());
+  for (size_t i = 0; i < schema->getNumFields(); i++) {
+    auto field = schema->field(i);
+    tmpl->slots_.emplace_back(
+        FieldSlot{headerLen + numNullBytes + field->offset(), field->type()});
+  }
+  return tmpl;
+}
+
+bool RowWriterTemplate::makeFieldMapping(const std::vector<std::string>& propNames,
+                                         std::vector<size_t>* mapping) const {
+  if (propNames.size() != slots_.size()) {
+    return false;
+  }
+  mapping->clear();
+  mapping->reserve(propNames.size());
+  std::vector<bool> covered(slots_.size(), false);
+  for (const auto& name : propNames) {
+    int64_t index = schema_->getFieldIndex(name);
+    if (index < 0 || covered[index]) {
+      return false;
+    }
+    covered[index] = true;
+    mapping->emplace_back(index);
+  }
+  return true;
+}
+
+WriteResult RowWriterTemplate::encode(const std::vector<Value>& values,
+                                      std::string* encoded) const {
+  if (values.size() != slots_.size()) {
+    return WriteResult::FIELD_UNSET;
+  }
+  encoded->reserve(prototype_.size() + sizeof(int64_t));
+  encoded->assign(prototype_);
+  for (size_t i = 0; i < slots_.size(); i++) {
+    auto res = writeSlot(slots_[i], values[i], encoded);
+    if (res != WriteResult::SUCCEEDED) {
+      return res;
+    }
+  }
+  // The insert timestamp at the tail, same as RowWriterV2::finish()
+  auto ts = time::WallClock::fastNowInMicroSec();
+  encoded->append(reinterpret_cast<char*>(&ts), sizeof(int64_t));
+  return WriteResult::SUCCEEDED;
+}
+
+WriteResult RowWriterTemplate::encode(const std::vector<size_t>& mapping,
+                                      const std::vector<Value>& values,
+                                      std::string* encoded) const {
+  if (values.size() != mapping.size() || mapping.size() != slots_.size()) {
+    return WriteResult::FIELD_UNSET;
+  }
+  encoded->reserve(prototype_.size() + sizeof(int64_t));
+  encoded->assign(prototype_);
+  for (size_t i = 0; i < mapping.size(); i++) {
+    auto res = writeSlot(slots_[mapping[i]], values[i], encoded);
+    if (res != WriteResult::SUCCEEDED) {
+      return res;
+    }
+  }
+  auto ts = time::WallClock::fastNowInMicroSec();
+  encoded->append(reinterpret_cast<char*>(&ts), sizeof(int64_t));
+  return WriteResult::SUCCEEDED;
+}
+
+WriteResult RowWriterTemplate::writeSlot(const FieldSlot& slot,
+                                         const Value& value,
+                                         std::string* buf) const {
+  char* dst = &(*buf)[slot.offset];
+  switch (value.type()) {
+    case Value::Type::BOOL: {
+      bool v = value.getBool();
+      switch (slot.type) {
+        case PropertyType::BOOL:
+        case PropertyType::INT8:
+          *dst = v ? 0x01 : 0x00;
+          return WriteResult::SUCCEEDED;
+        case PropertyType::INT16: {
+          int16_t iv = v ? 1 : 0;
+          memcpy(dst, &iv, sizeof(int16_t));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::INT32: {
+          int32_t iv = v ? 1 : 0;
+          memcpy(dst, &iv, sizeof(int32_t));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::INT64: {
+          int64_t iv = v ? 1 : 0;
+          memcpy(dst, &iv, sizeof(int64_t));
+          return WriteResult::SUCCEEDED;
+        }
+        default:
+          return WriteResult::TYPE_MISMATCH;
+      }
+    }
+    case Value::Type::INT: {
+      int64_t v = value.getInt();
+      switch (slot.type) {
+        case PropertyType::BOOL:
+          *dst = v == 0 ? 0x00 : 0x01;
+          return WriteResult::SUCCEEDED;
+        case PropertyType::INT8: {
+          if (v > std::numeric_limits<int8_t>::max() || v < std::numeric_limits<int8_t>::min()) {
+            return WriteResult::OUT_OF_RANGE;
+          }
+          *dst = static_cast<int8_t>(v);
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::INT16: {
+          if (v > std::numeric_limits<int16_t>::max() || v < std::numeric_limits<int16_t>::min()) {
+            return WriteResult::OUT_OF_RANGE;
+          }
+          int16_t iv = v;
+          memcpy(dst, &iv, sizeof(int16_t));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::INT32: {
+          if (v > std::numeric_limits<int32_t>::max() || v < std::numeric_limits<int32_t>::min()) {
+            return WriteResult::OUT_OF_RANGE;
+          }
+          int32_t iv = v;
+          memcpy(dst, &iv, sizeof(int32_t));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::TIMESTAMP: {
+          auto ret = time::TimeUtils::toTimestamp(v);
+          if (!ret.ok()) {
+            return WriteResult::OUT_OF_RANGE;
+          }
+          auto ts = ret.value().getInt();
+          memcpy(dst, &ts, sizeof(int64_t));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::INT64: {
+          memcpy(dst, &v, sizeof(int64_t));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::FLOAT: {
+          float fv = v;
+          memcpy(dst, &fv, sizeof(float));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::DOUBLE: {
+          double dv = v;
+          memcpy(dst, &dv, sizeof(double));
+          return WriteResult::SUCCEEDED;
+        }
+        default:
+          return WriteResult::TYPE_MISMATCH;
+      }
+    }
+    case Value::Type::FLOAT: {
+      double v = value.getFloat();
+      switch (slot.type) {
+        case PropertyType::INT8: {
+          if (v > std::numeric_limits<int8_t>::max() || v < std::numeric_limits<int8_t>::min()) {
+            return WriteResult::OUT_OF_RANGE;
+          }
+          *dst = static_cast<int8_t>(std::round(v));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::INT16: {
+          if (v > std::numeric_limits<int16_t>::max() || v < std::numeric_limits<int16_t>::min()) {
+            return WriteResult::OUT_OF_RANGE;
+          }
+          int16_t iv = std::round(v);
+          memcpy(dst, &iv, sizeof(int16_t));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::INT32: {
+          if (v > std::numeric_limits<int32_t>::max() || v < std::numeric_limits<int32_t>::min()) {
+            return WriteResult::OUT_OF_RANGE;
+          }
+          int32_t iv = std::round(v);
+          memcpy(dst, &iv, sizeof(int32_t));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::INT64: {
+          if (v > static_cast<double>(std::numeric_limits<int64_t>::max()) ||
+              v < static_cast<double>(std::numeric_limits<int64_t>::min())) {
+            return WriteResult::OUT_OF_RANGE;
+          }
+          int64_t iv = std::round(v);
+          memcpy(dst, &iv, sizeof(int64_t));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::FLOAT: {
+          if (v > std::numeric_limits<float>::max() || v < std::numeric_limits<float>::lowest()) {
+            return WriteResult::OUT_OF_RANGE;
+          }
+          float fv = v;
+          memcpy(dst, &fv, sizeof(float));
+          return WriteResult::SUCCEEDED;
+        }
+        case PropertyType::DOUBLE: {
+          memcpy(dst, &v, sizeof(double));
+          return WriteResult::SUCCEEDED;
+        }
+        default:
+          return WriteResult::TYPE_MISMATCH;
+      }
+    }
+    default:
+      // NULL and everything else takes the generic writer, nullable fields included:
+      // a zeroed null byte in the prototype means "not null", which is only correct
+      // when every field got a concrete value
+      return WriteResult::TYPE_MISMATCH;
+  }
+}
+
+}  // namespace nebula
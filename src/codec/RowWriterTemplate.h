@@ -0,0 +1,88 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef CODEC_ROWWRITERTEMPLATE_H_
+#define CODEC_ROWWRITERTEMPLATE_H_
+
+#include "codec/RowWriterV2.h"
+#include "common/base/Base.h"
+#include "common/meta/NebulaSchemaProvider.h"
+
+namespace nebula {
+
+/**
+ * @brief Compiled encode path for schemas whose fields are all fixed-width scalars.
+ *
+ * The per-schema work of RowWriterV2 -- header encoding, per-field offset resolution and
+ * the unset-field/default-value pass in finish() -- is done once in make(). encode() then
+ * copies the precomputed prototype (header, schema version and zeroed data area, the exact
+ * buffer size is known up front) and writes every field with a memcpy at its precompiled
+ * offset. Any value the template cannot take (wrong type, out of range) is reported through
+ * WriteResult so the caller can fall back to the generic writer, which keeps the error
+ * semantics identical to RowWriterV2.
+ */
+class RowWriterTemplate final {
+ public:
+  /**
+   * @brief Compile a template for the schema, or return nullptr when the schema does not
+   *        qualify (any variant length or compound typed field)
+   *
+   * @param schema Must outlive the returned template
+   * @return std::unique_ptr<RowWriterTemplate>
+   */
+  static std::unique_ptr<RowWriterTemplate> make(const meta::NebulaSchemaProvider* schema);
+
+  /**
+   * @brief Resolve property names to field indices, meant to be done once per
+   *        (schema, names) pair and reused across rows
+   *
+   * @param propNames
+   * @param mapping Field index for each name
+   * @return Whether the names cover every field exactly once; the template has no
+   *         default-value pass, so partial rows have to take the generic writer
+   */
+  bool makeFieldMapping(const std::vector<std::string>& propNames,
+                        std::vector<size_t>* mapping) const;
+
+  /**
+   * @brief Encode one row from values given in schema field order
+   *
+   * @param values One value per field
+   * @param encoded The encoded row on success
+   * @return WriteResult
+   */
+  WriteResult encode(const std::vector<Value>& values, std::string* encoded) const;
+
+  /**
+   * @brief Encode one row with values[i] written to field mapping[i]
+   *
+   * @param mapping Built by makeFieldMapping
+   * @param values
+   * @param encoded The encoded row on success
+   * @return WriteResult
+   */
+  WriteResult encode(const std::vector<size_t>& mapping,
+                     const std::vector<Value>& values,
+                     std::string* encoded) const;
+
+ private:
+  RowWriterTemplate() = default;
+
+  struct FieldSlot {
+    size_t offset;
+    nebula::cpp2::PropertyType type;
+  };
+
+  WriteResult writeSlot(const FieldSlot& slot, const Value& value, std::string* buf) const;
+
+  const meta::NebulaSchemaProvider* schema_{nullptr};
+  // Header, schema version, zeroed null flags and zeroed data area; every encoded row
+  // starts as a copy of it
+  std::string prototype_;
+  std::vector<FieldSlot> slots_;
+};
+
+}  // namespace nebula
+#endif  // CODEC_ROWWRITERTEMPLATE_H_
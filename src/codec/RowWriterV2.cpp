@@ -231,12 +231,31 @@ WriteResult RowWriterV2::setValue(ssize_t index, const Value& val) {
   }
 }
 
+WriteResult RowWriterV2::setValue(ssize_t index, Value&& val) {
+  CHECK(!finished_) << "You have called finish()";
+  if (index < 0 || static_cast<size_t>(index) >= schema_->getNumFields()) {
+    return WriteResult::UNKNOWN_FIELD;
+  }
+  // Only variant length strings can take the payload over, everything else is
+  // copied into the fixed layout anyway
+  if (val.type() == Value::Type::STRING) {
+    return write(index, val.moveStr());
+  }
+  return setValue(index, static_cast<const Value&>(val));
+}
+
 WriteResult RowWriterV2::setValue(const std::string& name, const Value& val) {
   CHECK(!finished_) << "You have called finish()";
   int64_t index = schema_->getFieldIndex(name);
   return setValue(index, val);
 }
 
+WriteResult RowWriterV2::setValue(const std::string& name, Value&& val) {
+  CHECK(!finished_) << "You have called finish()";
+  int64_t index = schema_->getFieldIndex(name);
+  return setValue(index, std::move(val));
+}
+
 WriteResult RowWriterV2::setNull(ssize_t index) {
   CHECK(!finished_) << "You have called finish()";
   if (index < 0 || static_cast<size_t>(index) >= schema_->getNumFields()) {
@@ -656,6 +675,43 @@ WriteResult RowWriterV2::write(ssize_t index, const char* v) {
   return write(index, folly::StringPiece(v));
 }
 
+WriteResult RowWriterV2::write(ssize_t index, std::string&& v) {
+  auto field = schema_->field(index);
+  if (field->type() != PropertyType::STRING) {
+    // In-place types copy into the fixed layout regardless, share the code
+    return write(index, folly::StringPiece(v));
+  }
+  auto offset = headerLen_ + numNullBytes_ + field->offset();
+  if (isSet_[index]) {
+    // The string value has already been set, we need to turn it
+    // into out-of-space strings then
+    outOfSpaceStr_ = true;
+  }
+
+  int32_t strOffset;
+  int32_t strLen;
+  approxStrLen_ += v.size();
+  if (outOfSpaceStr_) {
+    strOffset = 0;
+    // Length field is the index to the out-of-space string list
+    strLen = strList_.size();
+    // The out-of-space list owns the payload, no copy
+    strList_.emplace_back(std::move(v));
+  } else {
+    // Append to the end
+    strOffset = buf_.size();
+    strLen = v.size();
+    buf_.append(v.data(), strLen);
+  }
+  memcpy(&buf_[offset], reinterpret_cast<void*>(&strOffset), sizeof(int32_t));
+  memcpy(&buf_[offset + sizeof(int32_t)], reinterpret_cast<void*>(&strLen), sizeof(int32_t));
+  if (field->nullable()) {
+    clearNullBit(field->nullFlagPos());
+  }
+  isSet_[index] = true;
+  return WriteResult::SUCCEEDED;
+}
+
 WriteResult RowWriterV2::write(ssize_t index, folly::StringPiece v, bool isWKB) {
   auto field = schema_->field(index);
   auto offset = headerLen_ + numNullBytes_ + field->offset();
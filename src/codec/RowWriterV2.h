@@ -187,6 +187,16 @@ class RowWriterV2 {
    */
   WriteResult setValue(ssize_t index, const Value& val);
 
+  /**
+   * @brief Set the value by index, taking over the payload of variant length
+   *        strings instead of copying it
+   *
+   * @param index
+   * @param val
+   * @return WriteResult
+   */
+  WriteResult setValue(ssize_t index, Value&& val);
+
   /**
    * @brief Set the value by index
    *
@@ -196,6 +206,16 @@ class RowWriterV2 {
    */
   WriteResult setValue(const std::string& name, const Value& val);
 
+  /**
+   * @brief Set the value by property name, taking over the payload of variant
+   *        length strings instead of copying it
+   *
+   * @param name
+   * @param val
+   * @return WriteResult
+   */
+  WriteResult setValue(const std::string& name, Value&& val);
+
   /**
    * @brief Set null by index
    *
@@ -254,6 +274,7 @@ class RowWriterV2 {
   WriteResult write(ssize_t index, uint64_t v);
 
   WriteResult write(ssize_t index, const std::string& v);
+  WriteResult write(ssize_t index, std::string&& v);
   WriteResult write(ssize_t index, folly::StringPiece v, bool isWKB = false);
   WriteResult write(ssize_t index, const char* v);
 
@@ -0,0 +1,90 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+
+#include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterV2.h"
+#include "common/base/Base.h"
+
+using nebula::RowReaderWrapper;
+using nebula::RowWriterV2;
+using nebula::cpp2::PropertyType;
+using nebula::meta::NebulaSchemaProvider;
+
+NebulaSchemaProvider schemaShort;
+NebulaSchemaProvider schemaLong;
+
+std::string encodedShort;  // NOLINT
+std::string encodedLong;   // NOLINT
+
+const double e = 2.71828182845904523536028747135266249775724709369995;
+const float pi = 3.14159265358979;
+const std::string str = "Hello world!";  // NOLINT
+
+void prepareSchema(NebulaSchemaProvider* schema, size_t numRepeats) {
+  int32_t index = 1;
+  for (size_t i = 0; i < numRepeats; i++) {
+    schema->addField(folly::stringPrintf("col%02d", index++), PropertyType::BOOL);
+    schema->addField(folly::stringPrintf("col%02d", index++), PropertyType::INT64);
+    schema->addField(folly::stringPrintf("col%02d", index++), PropertyType::TIMESTAMP);
+    schema->addField(folly::stringPrintf("col%02d", index++), PropertyType::FLOAT);
+    schema->addField(folly::stringPrintf("col%02d", index++), PropertyType::DOUBLE);
+    schema->addField(folly::stringPrintf("col%02d", index++), PropertyType::STRING);
+  }
+}
+
+std::string encodeRow(NebulaSchemaProvider* schema) {
+  RowWriterV2 writer(schema);
+  size_t idx = 0;
+  for (size_t j = 0; j < schema->getNumFields() / 6; j++) {
+    writer.set(idx++, true);
+    writer.set(idx++, j);
+    writer.set(idx++, 1551331827);
+    writer.set(idx++, pi);
+    writer.set(idx++, e);
+    writer.set(idx++, str);
+  }
+  writer.finish();
+  return writer.moveEncodedStr();
+}
+
+void readDataV2(NebulaSchemaProvider* schema, const std::string& encoded, int32_t iters) {
+  for (int32_t i = 0; i < iters; i++) {
+    auto reader = RowReaderWrapper::getRowReader(schema, encoded);
+    for (size_t j = 0; j < schema->getNumFields(); j++) {
+      auto value = reader->getValueByIndex(j);
+      folly::doNotOptimizeAway(value);
+    }
+  }
+}
+
+/*************************
+ * Beginning of benchmarks
+ ************************/
+BENCHMARK(ReadShortRowV2, iters) {
+  readDataV2(&schemaShort, encodedShort, iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(ReadLongRowV2, iters) {
+  readDataV2(&schemaLong, encodedLong, iters);
+}
+/*************************
+ * End of benchmarks
+ ************************/
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+
+  prepareSchema(&schemaShort, 2);
+  prepareSchema(&schemaLong, 24);
+  encodedShort = encodeRow(&schemaShort);
+  encodedLong = encodeRow(&schemaLong);
+
+  folly::runBenchmarks();
+  return 0;
+}
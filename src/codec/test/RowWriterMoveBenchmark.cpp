@@ -0,0 +1,147 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/Benchmark.h>
+
+#include "codec/RowWriterV2.h"
+#include "common/base/Base.h"
+
+using nebula::RowWriterV2;
+using nebula::Value;
+using nebula::WriteResult;
+using nebula::cpp2::PropertyType;
+using nebula::meta::NebulaSchemaProvider;
+
+NebulaSchemaProvider schema;
+
+constexpr size_t kNumStrFields = 4;
+constexpr size_t kStrLen = 1024;
+
+std::string baseEncoded;  // NOLINT
+
+void prepareSchema() {
+  for (size_t i = 0; i < kNumStrFields; i++) {
+    schema.addField(folly::stringPrintf("col%02zu", i), PropertyType::STRING);
+  }
+}
+
+std::vector<Value> makeProps() {
+  std::vector<Value> props;
+  props.reserve(kNumStrFields);
+  for (size_t i = 0; i < kNumStrFields; i++) {
+    props.emplace_back(std::string(kStrLen, 'a' + i));
+  }
+  return props;
+}
+
+// Fresh rows: the payload has to be appended to the encode buffer either way
+void freshRowCopy(int32_t iters) {
+  for (int32_t i = 0; i < iters; i++) {
+    std::vector<Value> props;
+    BENCHMARK_SUSPEND {
+      props = makeProps();
+    }
+    RowWriterV2 writer(&schema);
+    for (size_t j = 0; j < props.size(); j++) {
+      CHECK(writer.setValue(j, props[j]) == WriteResult::SUCCEEDED);
+    }
+    CHECK(writer.finish() == WriteResult::SUCCEEDED);
+    std::string encoded = writer.moveEncodedStr();
+    folly::doNotOptimizeAway(encoded);
+  }
+}
+
+void freshRowMove(int32_t iters) {
+  for (int32_t i = 0; i < iters; i++) {
+    std::vector<Value> props;
+    BENCHMARK_SUSPEND {
+      props = makeProps();
+    }
+    RowWriterV2 writer(&schema);
+    for (size_t j = 0; j < props.size(); j++) {
+      CHECK(writer.setValue(j, std::move(props[j])) == WriteResult::SUCCEEDED);
+    }
+    CHECK(writer.finish() == WriteResult::SUCCEEDED);
+    std::string encoded = writer.moveEncodedStr();
+    folly::doNotOptimizeAway(encoded);
+  }
+}
+
+// Updated rows: overwritten strings go to the out-of-space list, which can take
+// the payload over without copying
+void updateRowCopy(int32_t iters) {
+  for (int32_t i = 0; i < iters; i++) {
+    std::vector<Value> props;
+    BENCHMARK_SUSPEND {
+      props = makeProps();
+    }
+    RowWriterV2 writer(&schema, baseEncoded);
+    for (size_t j = 0; j < props.size(); j++) {
+      CHECK(writer.setValue(j, props[j]) == WriteResult::SUCCEEDED);
+    }
+    CHECK(writer.finish() == WriteResult::SUCCEEDED);
+    std::string encoded = writer.moveEncodedStr();
+    folly::doNotOptimizeAway(encoded);
+  }
+}
+
+void updateRowMove(int32_t iters) {
+  for (int32_t i = 0; i < iters; i++) {
+    std::vector<Value> props;
+    BENCHMARK_SUSPEND {
+      props = makeProps();
+    }
+    RowWriterV2 writer(&schema, baseEncoded);
+    for (size_t j = 0; j < props.size(); j++) {
+      CHECK(writer.setValue(j, std::move(props[j])) == WriteResult::SUCCEEDED);
+    }
+    CHECK(writer.finish() == WriteResult::SUCCEEDED);
+    std::string encoded = writer.moveEncodedStr();
+    folly::doNotOptimizeAway(encoded);
+  }
+}
+
+/*************************
+ * Beginning of benchmarks
+ ************************/
+BENCHMARK(FreshRow1KStringsCopy, iters) {
+  freshRowCopy(iters);
+}
+
+BENCHMARK_RELATIVE(FreshRow1KStringsMove, iters) {
+  freshRowMove(iters);
+}
+
+BENCHMARK_DRAW_LINE();
+
+BENCHMARK(UpdateRow1KStringsCopy, iters) {
+  updateRowCopy(iters);
+}
+
+BENCHMARK_RELATIVE(UpdateRow1KStringsMove, iters) {
+  updateRowMove(iters);
+}
+/*************************
+ * End of benchmarks
+ ************************/
+
+int main(int argc, char** argv) {
+  folly::init(&argc, &argv, true);
+
+  prepareSchema();
+  {
+    // Encode the row every update benchmark starts from
+    RowWriterV2 writer(&schema);
+    auto props = makeProps();
+    for (size_t j = 0; j < props.size(); j++) {
+      CHECK(writer.setValue(j, props[j]) == WriteResult::SUCCEEDED);
+    }
+    CHECK(writer.finish() == WriteResult::SUCCEEDED);
+    baseEncoded = writer.moveEncodedStr();
+  }
+
+  folly::runBenchmarks();
+  return 0;
+}
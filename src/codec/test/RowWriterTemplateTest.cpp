@@ -0,0 +1,102 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterTemplate.h"
+#include "codec/RowWriterV2.h"
+#include "common/base/Base.h"
+
+namespace nebula {
+
+using nebula::cpp2::PropertyType;
+
+TEST(RowWriterTemplate, SameBytesAsGenericWriter) {
+  meta::NebulaSchemaProvider schema(7 /*Schema version*/);
+  schema.addField("Col01", PropertyType::BOOL);
+  schema.addField("Col02", PropertyType::INT8);
+  schema.addField("Col03", PropertyType::INT16);
+  schema.addField("Col04", PropertyType::INT32);
+  schema.addField("Col05", PropertyType::INT64);
+  schema.addField("Col06", PropertyType::DOUBLE);
+
+  auto tmpl = RowWriterTemplate::make(&schema);
+  ASSERT_NE(nullptr, tmpl);
+
+  std::vector<Value> values = {true, 8, 16, 32, 64, 2.718};
+  std::string fast;
+  ASSERT_EQ(WriteResult::SUCCEEDED, tmpl->encode(values, &fast));
+
+  RowWriterV2 writer(&schema);
+  for (size_t i = 0; i < values.size(); i++) {
+    EXPECT_EQ(WriteResult::SUCCEEDED, writer.setValue(i, values[i]));
+  }
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+  const std::string& generic = writer.getEncodedStr();
+
+  // Identical bytes except the insert timestamp at the tail
+  ASSERT_EQ(generic.size(), fast.size());
+  EXPECT_EQ(generic.substr(0, generic.size() - sizeof(int64_t)),
+            fast.substr(0, fast.size() - sizeof(int64_t)));
+
+  // And the regular reader decodes it
+  auto reader = RowReaderWrapper::getRowReader(&schema, folly::StringPiece(fast));
+  ASSERT_TRUE(static_cast<bool>(reader));
+  EXPECT_EQ(Value(true), reader.getValueByIndex(0));
+  EXPECT_EQ(Value(16), reader.getValueByIndex(2));
+  EXPECT_EQ(Value(64), reader.getValueByIndex(4));
+  EXPECT_EQ(Value(2.718), reader.getValueByIndex(5));
+}
+
+TEST(RowWriterTemplate, FieldMapping) {
+  meta::NebulaSchemaProvider schema(0 /*Schema version*/);
+  schema.addField("Col01", PropertyType::INT64);
+  schema.addField("Col02", PropertyType::INT64);
+  schema.addField("Col03", PropertyType::DOUBLE);
+
+  auto tmpl = RowWriterTemplate::make(&schema);
+  ASSERT_NE(nullptr, tmpl);
+
+  std::vector<size_t> mapping;
+  // Shuffled order is fine as long as every field is covered exactly once
+  ASSERT_TRUE(tmpl->makeFieldMapping({"Col03", "Col01", "Col02"}, &mapping));
+  std::string encoded;
+  std::vector<Value> values = {3.14, 1, 2};
+  ASSERT_EQ(WriteResult::SUCCEEDED, tmpl->encode(mapping, values, &encoded));
+
+  auto reader = RowReaderWrapper::getRowReader(&schema, folly::StringPiece(encoded));
+  ASSERT_TRUE(static_cast<bool>(reader));
+  EXPECT_EQ(Value(1), reader.getValueByName("Col01"));
+  EXPECT_EQ(Value(2), reader.getValueByName("Col02"));
+  EXPECT_EQ(Value(3.14), reader.getValueByName("Col03"));
+
+  // Unknown names, duplicates and partial rows are all rejected
+  EXPECT_FALSE(tmpl->makeFieldMapping({"Col01", "Col02", "ColXX"}, &mapping));
+  EXPECT_FALSE(tmpl->makeFieldMapping({"Col01", "Col01", "Col02"}, &mapping));
+  EXPECT_FALSE(tmpl->makeFieldMapping({"Col01", "Col02"}, &mapping));
+}
+
+TEST(RowWriterTemplate, NotApplicable) {
+  meta::NebulaSchemaProvider schema(0 /*Schema version*/);
+  schema.addField("Col01", PropertyType::INT64);
+  schema.addField("Col02", PropertyType::STRING);
+  EXPECT_EQ(nullptr, RowWriterTemplate::make(&schema));
+}
+
+TEST(RowWriterTemplate, BadValues) {
+  meta::NebulaSchemaProvider schema(0 /*Schema version*/);
+  schema.addField("Col01", PropertyType::INT8);
+
+  auto tmpl = RowWriterTemplate::make(&schema);
+  ASSERT_NE(nullptr, tmpl);
+
+  std::string encoded;
+  EXPECT_EQ(WriteResult::OUT_OF_RANGE, tmpl->encode({Value(1000)}, &encoded));
+  EXPECT_EQ(WriteResult::TYPE_MISMATCH, tmpl->encode({Value("str")}, &encoded));
+  EXPECT_EQ(WriteResult::FIELD_UNSET, tmpl->encode(std::vector<Value>(), &encoded));
+}
+
+}  // namespace nebula
@@ -372,6 +372,51 @@ TEST(RowWriterV2, DoubleSet) {
   EXPECT_EQ(v1, v2);
 }
 
+TEST(RowWriterV2, MoveSetValue) {
+  meta::NebulaSchemaProvider schema(3 /*Schema version*/);
+  schema.addField("Col01", PropertyType::INT64);
+  schema.addField("Col02", PropertyType::STRING);
+  schema.addField("Col03", PropertyType::STRING, 0, true);
+  schema.addField("Col04", PropertyType::FIXED_STRING, 12);
+
+  RowWriterV2 writer(&schema);
+  Value vInt(1234567);
+  Value vStr(str);
+  Value vFixed(fixed);
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.setValue("Col01", std::move(vInt)));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.setValue("Col02", std::move(vStr)));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.setValue(2, Value(str)));
+  EXPECT_EQ(WriteResult::SUCCEEDED, writer.setValue("Col04", std::move(vFixed)));
+  ASSERT_EQ(WriteResult::SUCCEEDED, writer.finish());
+
+  std::string encoded = std::move(writer).moveEncodedStr();
+
+  // Overwrite the strings, the second write moves through the out-of-space list
+  RowWriterV2 updater(&schema, std::move(encoded));
+  EXPECT_EQ(WriteResult::SUCCEEDED, updater.setValue("Col02", Value(fixed)));
+  EXPECT_EQ(WriteResult::SUCCEEDED, updater.setValue("Col03", Value(fixed)));
+  ASSERT_EQ(WriteResult::SUCCEEDED, updater.finish());
+
+  std::string updated = std::move(updater).moveEncodedStr();
+  auto reader = RowReaderWrapper::getRowReader(&schema, updated);
+
+  Value v1 = reader->getValueByName("Col01");
+  EXPECT_EQ(Value::Type::INT, v1.type());
+  EXPECT_EQ(1234567, v1.getInt());
+
+  v1 = reader->getValueByName("Col02");
+  EXPECT_EQ(Value::Type::STRING, v1.type());
+  EXPECT_EQ(fixed, v1.getStr());
+
+  v1 = reader->getValueByName("Col03");
+  EXPECT_EQ(Value::Type::STRING, v1.type());
+  EXPECT_EQ(fixed, v1.getStr());
+
+  v1 = reader->getValueByName("Col04");
+  EXPECT_EQ(Value::Type::STRING, v1.type());
+  EXPECT_EQ(fixed, v1.getStr());
+}
+
 TEST(RowWriterV2, Update) {
   meta::NebulaSchemaProvider schema(2 /*Schema version*/);
   schema.addField("Col01", PropertyType::BOOL, 0, true);
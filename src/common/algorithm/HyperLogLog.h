@@ -0,0 +1,116 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_ALGORITHM_HYPERLOGLOG_H_
+#define COMMON_ALGORITHM_HYPERLOGLOG_H_
+
+#include <folly/Range.h>
+#include <folly/hash/Hash.h>
+
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace nebula {
+namespace algorithm {
+
+/**
+ * Classic HyperLogLog cardinality sketch. With kRegisterCount = 1024 registers of one
+ * byte each, the standard error is roughly 1.04 / sqrt(1024) ~= 3.3%, which is plenty
+ * for optimizer statistics. Sketches of disjoint data sets merge losslessly by taking
+ * the register-wise maximum, so per-part sketches can be combined into a space-wide
+ * estimate. Not thread safe, callers synchronize.
+ */
+class HyperLogLog final {
+ public:
+  static constexpr size_t kRegisterBits = 10;
+  static constexpr size_t kRegisterCount = 1UL << kRegisterBits;
+
+  HyperLogLog() : registers_(kRegisterCount, 0) {}
+
+  void add(folly::StringPiece value) {
+    uint64_t hash = folly::hash::fnv64_buf(value.data(), value.size());
+    size_t index = hash & (kRegisterCount - 1);
+    // rank of the first set bit in the remaining hash bits, in [1, 64 - kRegisterBits + 1]
+    uint64_t rest = hash >> kRegisterBits;
+    uint8_t rank = rest == 0 ? (64 - kRegisterBits + 1) : (__builtin_ctzll(rest) + 1);
+    if (rank > registers_[index]) {
+      registers_[index] = rank;
+    }
+  }
+
+  /**
+   * @brief Estimated number of distinct values added, with the usual small-range
+   * correction via linear counting.
+   */
+  int64_t estimate() const {
+    constexpr double alpha = 0.7213 / (1.0 + 1.079 / kRegisterCount);
+    double sum = 0.0;
+    size_t zeros = 0;
+    for (auto reg : registers_) {
+      sum += std::ldexp(1.0, -reg);
+      if (reg == 0) {
+        zeros++;
+      }
+    }
+    double raw = alpha * kRegisterCount * kRegisterCount / sum;
+    if (raw <= 2.5 * kRegisterCount && zeros != 0) {
+      return static_cast<int64_t>(kRegisterCount *
+                                  std::log(static_cast<double>(kRegisterCount) / zeros));
+    }
+    return static_cast<int64_t>(raw);
+  }
+
+  void merge(const HyperLogLog& other) {
+    for (size_t i = 0; i < kRegisterCount; i++) {
+      if (other.registers_[i] > registers_[i]) {
+        registers_[i] = other.registers_[i];
+      }
+    }
+  }
+
+  /**
+   * @brief Merge a serialized sketch into another one in place, a no-op when either
+   * payload is malformed. Convenience for callers shuffling sketches around in thrift
+   * fields.
+   */
+  static void mergeSerialized(std::string& lhs, folly::StringPiece rhs) {
+    HyperLogLog l;
+    HyperLogLog r;
+    if (!l.deserialize(lhs) || !r.deserialize(rhs)) {
+      return;
+    }
+    l.merge(r);
+    lhs = l.serialize();
+  }
+
+  void clear() {
+    std::fill(registers_.begin(), registers_.end(), 0);
+  }
+
+  std::string serialize() const {
+    return std::string(reinterpret_cast<const char*>(registers_.data()), registers_.size());
+  }
+
+  /**
+   * @brief Restore a sketch from serialize() output, false when the payload does not
+   * look like one.
+   */
+  bool deserialize(folly::StringPiece data) {
+    if (data.size() != kRegisterCount) {
+      return false;
+    }
+    std::copy(data.begin(), data.end(), registers_.begin());
+    return true;
+  }
+
+ private:
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace algorithm
+}  // namespace nebula
+
+#endif  // COMMON_ALGORITHM_HYPERLOGLOG_H_
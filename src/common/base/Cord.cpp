@@ -9,23 +9,27 @@
 
 namespace nebula {
 
-Cord::Cord(int32_t blockSize)
-    : blockSize_(blockSize),
-      blockContentSize_(blockSize_ - sizeof(char*)),
-      blockPt_(blockContentSize_) {}
+Cord::Cord(int32_t blockSize, int32_t maxBlockSize)
+    : initialBlockSize_(blockSize),
+      maxBlockSize_(std::max(blockSize, maxBlockSize)),
+      nextBlockSize_(blockSize) {
+  DCHECK_GT(blockSize, static_cast<int32_t>(sizeof(BlockHeader)));
+}
 
 Cord::~Cord() {
   clear();
 }
 
 void Cord::allocateBlock() {
-  DCHECK_EQ(blockPt_, blockContentSize_);
-  char* blk = reinterpret_cast<char*>(malloc(blockSize_ * sizeof(char)));
+  DCHECK(tail_ == nullptr || blockPt_ == tail_->contentSize);
+  auto* blk = reinterpret_cast<BlockHeader*>(malloc(nextBlockSize_ * sizeof(char)));
   CHECK(blk) << "Out of memory";
+  blk->next = nullptr;
+  blk->contentSize = nextBlockSize_ - static_cast<int32_t>(sizeof(BlockHeader));
 
   if (tail_) {
     // Link the tail to the new block
-    memcpy(tail_ + blockPt_, reinterpret_cast<char*>(&blk), sizeof(char*));
+    tail_->next = blk;
   }
   tail_ = blk;
   blockPt_ = 0;
@@ -33,6 +37,12 @@ void Cord::allocateBlock() {
   if (!head_) {
     head_ = blk;
   }
+
+  // Double the next allocation until it reaches the cap, so a cord holding N
+  // bytes only pays O(log N) mallocs
+  if (nextBlockSize_ < maxBlockSize_) {
+    nextBlockSize_ = std::min(nextBlockSize_ * 2, maxBlockSize_);
+  }
 }
 
 size_t Cord::size() const noexcept {
@@ -48,18 +58,16 @@ void Cord::clear() {
     DCHECK(tail_);
 
     // Need to release all blocks
-    char* p = head_;
-    while (p != tail_) {
-      char* next;
-      memcpy(reinterpret_cast<char*>(&next), p + blockContentSize_, sizeof(char*));
+    BlockHeader* p = head_;
+    while (p != nullptr) {
+      BlockHeader* next = p->next;
       free(p);
       p = next;
     }
-    // Free the last block
-    free(p);
   }
 
-  blockPt_ = blockContentSize_;
+  nextBlockSize_ = initialBlockSize_;
+  blockPt_ = 0;
   len_ = 0;
 
   head_ = nullptr;
@@ -71,18 +79,17 @@ bool Cord::applyTo(std::function<bool(const char*, int32_t)> visitor) const {
     return true;
   }
 
-  char* next = head_;
-  while (next != tail_) {
-    if (!visitor(next, blockContentSize_)) {
+  const BlockHeader* blk = head_;
+  while (blk != tail_) {
+    if (!visitor(content(blk), blk->contentSize)) {
       // stop visiting further
       return false;
     }
-    // Get the pointer to the next block
-    memcpy(reinterpret_cast<char*>(&next), next + blockContentSize_, sizeof(char*));
+    blk = blk->next;
   }
 
   // Last block
-  return visitor(tail_, blockPt_);
+  return visitor(content(tail_), blockPt_);
 }
 
 size_t Cord::appendTo(std::string& str) const {
@@ -90,15 +97,14 @@ size_t Cord::appendTo(std::string& str) const {
     return 0;
   }
 
-  char* next = head_;
-  while (next != tail_) {
-    str.append(next, blockContentSize_);
-    // Get the pointer to the next block
-    memcpy(reinterpret_cast<char*>(&next), next + blockContentSize_, sizeof(char*));
+  const BlockHeader* blk = head_;
+  while (blk != tail_) {
+    str.append(content(blk), blk->contentSize);
+    blk = blk->next;
   }
 
   // Last block
-  str.append(tail_, blockPt_);
+  str.append(content(tail_), blockPt_);
 
   return len_;
 }
@@ -111,17 +117,35 @@ std::string Cord::str() const {
   return buf;
 }
 
+std::unique_ptr<folly::IOBuf> Cord::toIOBuf() const {
+  if (empty()) {
+    return folly::IOBuf::create(0);
+  }
+
+  std::unique_ptr<folly::IOBuf> chain;
+  applyTo([&chain](const char* data, int32_t size) -> bool {
+    auto buf = folly::IOBuf::wrapBuffer(data, size);
+    if (chain == nullptr) {
+      chain = std::move(buf);
+    } else {
+      // Inserting before the head of the circular list appends to the chain
+      chain->prependChain(std::move(buf));
+    }
+    return true;
+  });
+  return chain;
+}
+
 Cord& Cord::write(const char* value, size_t len) {
   if (len == 0) {
     return *this;
   }
 
-  size_t bytesToWrite = std::min(len, static_cast<size_t>(blockContentSize_ - blockPt_));
-  if (bytesToWrite == 0) {
+  if (tail_ == nullptr || blockPt_ == tail_->contentSize) {
     allocateBlock();
-    bytesToWrite = std::min(len, static_cast<size_t>(blockContentSize_));
   }
-  memcpy(tail_ + blockPt_, value, bytesToWrite);
+  size_t bytesToWrite = std::min(len, static_cast<size_t>(tail_->contentSize - blockPt_));
+  memcpy(content(tail_) + blockPt_, value, bytesToWrite);
   blockPt_ += bytesToWrite;
   len_ += bytesToWrite;
 
@@ -194,15 +218,10 @@ Cord& Cord::operator<<(const char* value) {
 }
 
 Cord& Cord::operator<<(const Cord& rhs) {
-  char* next = rhs.head_;
-  while (next != rhs.tail_) {
-    write(next, blockContentSize_);
-    // Get the pointer to the next block
-    memcpy(reinterpret_cast<char*>(&next), next + blockContentSize_, sizeof(char*));
-  }
-
-  // Last block
-  write(rhs.tail_, rhs.blockPt_);
+  rhs.applyTo([this](const char* data, int32_t size) -> bool {
+    write(data, size);
+    return true;
+  });
 
   return *this;
 }
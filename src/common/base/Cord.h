@@ -6,17 +6,23 @@
 #ifndef COMMON_BASE_CORD_H_
 #define COMMON_BASE_CORD_H_
 
+#include <folly/io/IOBuf.h>
 #include <stdlib.h>
 
 #include <functional>
+#include <memory>
 #include <string>
 
 namespace nebula {
 
+// An append-only byte buffer made of linked blocks. Blocks grow geometrically
+// from the initial block size up to maxBlockSize, so small cords stay cheap
+// while large ones amortize the allocation count instead of paying one malloc
+// per kilobyte written.
 class Cord {
  public:
   Cord() = default;
-  explicit Cord(int32_t blockSize);
+  explicit Cord(int32_t blockSize, int32_t maxBlockSize = kDefaultMaxBlockSize);
   virtual ~Cord();
 
   size_t size() const noexcept;
@@ -31,6 +37,12 @@ class Cord {
   // Convert the cord content to a new string
   std::string str() const;
 
+  // Export the content as a chain of IOBufs, one per block, without copying or
+  // flattening. The chain only points into the cord's blocks, so the cord must
+  // stay alive and unmodified while the chain is in use, e.g. for the duration
+  // of a vectored write. Returns an empty buffer for an empty cord.
+  std::unique_ptr<folly::IOBuf> toIOBuf() const;
+
   void clear();
 
   Cord& write(const char* value, size_t len);
@@ -59,13 +71,32 @@ class Cord {
   Cord& operator<<(const Cord& rhs);
 
  private:
-  const int32_t blockSize_ = 1024;
-  const int32_t blockContentSize_ = 1024 - sizeof(char*);
-  int32_t blockPt_ = blockContentSize_;
+  // Each block starts with a header, the payload follows right after it
+  struct BlockHeader {
+    BlockHeader* next;
+    int32_t contentSize;
+  };
+
+  static constexpr int32_t kDefaultBlockSize = 1024;
+  static constexpr int32_t kDefaultMaxBlockSize = 64 * 1024;
+
+  static const char* content(const BlockHeader* blk) {
+    return reinterpret_cast<const char*>(blk) + sizeof(BlockHeader);
+  }
+  static char* content(BlockHeader* blk) {
+    return reinterpret_cast<char*>(blk) + sizeof(BlockHeader);
+  }
+
+  const int32_t initialBlockSize_ = kDefaultBlockSize;
+  const int32_t maxBlockSize_ = kDefaultMaxBlockSize;
+  // Allocation size of the next block, doubling until it reaches maxBlockSize_
+  int32_t nextBlockSize_ = kDefaultBlockSize;
+  // Number of bytes used in the tail block
+  int32_t blockPt_ = 0;
   size_t len_ = 0;
 
-  char* head_ = nullptr;
-  char* tail_ = nullptr;
+  BlockHeader* head_ = nullptr;
+  BlockHeader* tail_ = nullptr;
 
   void allocateBlock();
 };
@@ -6,6 +6,8 @@
 #ifndef COMMON_BASE_ICORD_H
 #define COMMON_BASE_ICORD_H
 
+#include <folly/io/IOBuf.h>
+
 #include "common/base/Base.h"
 
 namespace nebula {
@@ -101,6 +103,36 @@ class ICord {
     return buf;
   }
 
+  // Export the content as a chain of IOBufs, one per block, without copying or
+  // flattening. The chain only points into the cord's blocks (including the
+  // inline one), so the cord must stay alive and unmodified while the chain is
+  // in use. Returns an empty buffer for an empty cord.
+  std::unique_ptr<folly::IOBuf> toIOBuf() const {
+    if (empty()) {
+      return folly::IOBuf::create(0);
+    }
+
+    std::unique_ptr<folly::IOBuf> chain;
+    auto append = [&chain](const char* data, std::size_t size) {
+      auto buf = folly::IOBuf::wrapBuffer(data, size);
+      if (chain == nullptr) {
+        chain = std::move(buf);
+      } else {
+        // Inserting before the head of the circular list appends to the chain
+        chain->prependChain(std::move(buf));
+      }
+    };
+    char* n = head_;
+    while (n != tail_) {
+      append(n, kBlockContentSize);
+      n = next(n);
+    }
+    // Last block
+    std::size_t lengthModSize = lengthMod();
+    append(tail_, lengthModSize == 0 ? kBlockContentSize : lengthModSize);
+    return chain;
+  }
+
   ICord<kBlockContentSize>& write(const char* value, size_t len) {
     if (len == 0) {
       return *this;
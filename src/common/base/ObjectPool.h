@@ -9,8 +9,6 @@
 #include <folly/SpinLock.h>
 
 #include <boost/core/noncopyable.hpp>
-#include <functional>
-#include <list>
 #include <type_traits>
 
 #include "common/base/Arena.h"
@@ -33,49 +31,57 @@ class ObjectPool final : private boost::noncopyable, private cpp::NonMovable {
 
   void clear() {
     SLGuard g(lock_);
-    objects_.clear();
+    // Destroy in reverse construction order, the arena convention: a newer object may
+    // reference an older one but never the other way around
+    while (dtors_ != nullptr) {
+      dtors_->destroy(dtors_->obj);
+      dtors_ = dtors_->prev;
+    }
+    count_ = 0;
   }
 
   template <typename T, typename... Args>
   T *makeAndAdd(Args &&... args) {
     void *ptr;
+    DtorNode *node = nullptr;
     {
       // alloc happens here(may throw bad_alloc), use guard to guarantee unlock
       SLGuard g(lock_);
       ptr = arena_.allocateAligned(sizeof(T));
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        // The destructor bookkeeping lives in the arena as well, so a query does not
+        // pay one real heap allocation per AST node just to remember how to free it
+        node = static_cast<DtorNode *>(arena_.allocateAligned(sizeof(DtorNode)));
+      }
+      count_++;
+    }
+    T *obj = new (ptr) T(std::forward<Args>(args)...);
+    if constexpr (!std::is_trivially_destructible_v<T>) {
+      // Linked only after the constructor succeeded, an exception above must not
+      // register a destructor for an unconstructed object
+      node->obj = obj;
+      node->destroy = [](void *p) { static_cast<T *>(p)->~T(); };
+      SLGuard g(lock_);
+      node->prev = dtors_;
+      dtors_ = node;
     }
-    return add(new (ptr) T(std::forward<Args>(args)...));
+    return obj;
   }
 
   bool empty() const {
-    return objects_.empty();
+    return count_ == 0;
   }
 
  private:
-  // Holder the ownership of the any object
-  class OwnershipHolder {
-   public:
-    template <typename T>
-    explicit OwnershipHolder(T *obj)
-        : obj_(obj), deleteFn_([](void *p) { reinterpret_cast<T *>(p)->~T(); }) {}
-
-    ~OwnershipHolder() {
-      deleteFn_(obj_);
-    }
-
-   private:
-    void *obj_;
-    std::function<void(void *)> deleteFn_;
+  // One per non-trivially-destructible object, carved from the arena right behind it
+  struct DtorNode {
+    void *obj;
+    void (*destroy)(void *);
+    DtorNode *prev;
   };
 
-  template <typename T>
-  T *add(T *obj) {
-    SLGuard g(lock_);
-    objects_.emplace_back(obj);
-    return obj;
-  }
-
-  std::list<OwnershipHolder> objects_;
+  DtorNode *dtors_{nullptr};
+  size_t count_{0};
   Arena arena_;
 
   folly::SpinLock lock_;
@@ -0,0 +1,18 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/base/SampledCheck.h"
+
+DEFINE_uint64(sampled_check_interval,
+              1000,
+              "One request out of this many runs the full hot-path validation checks when the "
+              "binary is built with ENABLE_SAMPLED_HOT_PATH_CHECKS, the rest skip them");
+
+namespace nebula {
+
+thread_local bool SampledCheck::armed_ = false;
+std::atomic<uint64_t> SampledCheck::counter_{0};
+
+}  // namespace nebula
@@ -0,0 +1,103 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_BASE_SAMPLEDCHECK_H_
+#define COMMON_BASE_SAMPLEDCHECK_H_
+
+#include <gflags/gflags.h>
+
+#include <atomic>
+
+#include "common/base/Logging.h"
+
+DECLARE_uint64(sampled_check_interval);
+
+namespace nebula {
+
+/**
+ * Sampling replacement for hot-path CHECK/DCHECK. By default (build option
+ * ENABLE_SAMPLED_HOT_PATH_CHECKS off) the NG_SAMPLED_* macros below are plain CHECK/DCHECK.
+ * With the option on, one request out of every sampled_check_interval is picked as a verify
+ * request and runs the full checks (DCHECKs promoted to CHECKs, so release builds keep a
+ * safety signal); all other requests skip them, removing the steady-state branch and
+ * comparison overhead from per-value loops.
+ *
+ * The request-level decision is made once at request entry (sampleRequest) and armed on the
+ * worker thread for the duration of each task via Scope, so it only covers work running
+ * under an armed scope; tasks forked onto other executors run unchecked.
+ */
+class SampledCheck final {
+ public:
+  SampledCheck() = delete;
+
+  /**
+   * @brief Draw the verify decision for one request, true on one request out of every
+   * sampled_check_interval
+   */
+  static bool sampleRequest() {
+#ifdef NEBULA_SAMPLED_HOT_PATH_CHECKS
+    return counter_.fetch_add(1, std::memory_order_relaxed) % FLAGS_sampled_check_interval == 0;
+#else
+    return true;
+#endif
+  }
+
+  static bool armed() {
+    return armed_;
+  }
+
+  /**
+   * @brief Arms the calling thread with the verify decision of the current request for the
+   * lifetime of the scope
+   */
+  class Scope final {
+   public:
+    explicit Scope(bool armed) : prev_(armed_) {
+      armed_ = armed;
+    }
+    ~Scope() {
+      armed_ = prev_;
+    }
+
+   private:
+    bool prev_;
+  };
+
+ private:
+  static thread_local bool armed_;
+  static std::atomic<uint64_t> counter_;
+};
+
+}  // namespace nebula
+
+#ifdef NEBULA_SAMPLED_HOT_PATH_CHECKS
+
+// The empty-then-else shape keeps the macros usable as single statements with streaming,
+// like the glog originals
+#define NG_SAMPLED_IF_ARMED_ \
+  if (!::nebula::SampledCheck::armed()) {} else  // NOLINT(readability/braces)
+
+#define NG_SAMPLED_CHECK(cond) NG_SAMPLED_IF_ARMED_ CHECK(cond)
+#define NG_SAMPLED_CHECK_LT(a, b) NG_SAMPLED_IF_ARMED_ CHECK_LT(a, b)
+// Sampled verify requests promote DCHECKs to full CHECKs, so release builds keep the signal
+#define NG_SAMPLED_DCHECK(cond) NG_SAMPLED_IF_ARMED_ CHECK(cond)
+#define NG_SAMPLED_DCHECK_EQ(a, b) NG_SAMPLED_IF_ARMED_ CHECK_EQ(a, b)
+#define NG_SAMPLED_DCHECK_GE(a, b) NG_SAMPLED_IF_ARMED_ CHECK_GE(a, b)
+#define NG_SAMPLED_DCHECK_GT(a, b) NG_SAMPLED_IF_ARMED_ CHECK_GT(a, b)
+#define NG_SAMPLED_DCHECK_LT(a, b) NG_SAMPLED_IF_ARMED_ CHECK_LT(a, b)
+
+#else
+
+#define NG_SAMPLED_CHECK(cond) CHECK(cond)
+#define NG_SAMPLED_CHECK_LT(a, b) CHECK_LT(a, b)
+#define NG_SAMPLED_DCHECK(cond) DCHECK(cond)
+#define NG_SAMPLED_DCHECK_EQ(a, b) DCHECK_EQ(a, b)
+#define NG_SAMPLED_DCHECK_GE(a, b) DCHECK_GE(a, b)
+#define NG_SAMPLED_DCHECK_GT(a, b) DCHECK_GT(a, b)
+#define NG_SAMPLED_DCHECK_LT(a, b) DCHECK_LT(a, b)
+
+#endif  // NEBULA_SAMPLED_HOT_PATH_CHECKS
+
+#endif  // COMMON_BASE_SAMPLEDCHECK_H_
@@ -25,6 +25,27 @@ TEST(CordTest, multipleBlocks) {
   EXPECT_EQ(buf, cord.str());
 }
 
+TEST(CordTest, geometricGrowth) {
+  // Small initial blocks capped at 512 bytes, the content must survive the
+  // doubling block sizes intact
+  Cord cord(64, 512);
+
+  std::string buf;
+  for (int i = 0; i < 1000; i++) {
+    buf.append("0123456789abcdef");
+  }
+  cord.write(buf.data(), buf.size());
+
+  EXPECT_EQ(buf.size(), cord.size());
+  EXPECT_EQ(buf, cord.str());
+
+  // Growth restarts from the initial block size after clear
+  cord.clear();
+  EXPECT_TRUE(cord.empty());
+  cord.write(buf.data(), buf.size());
+  EXPECT_EQ(buf, cord.str());
+}
+
 }  // namespace nebula
 
 #include "common/base/test/CordTestT.cpp"
@@ -165,6 +165,34 @@ TEST(CordTest, stringStream) {
   EXPECT_EQ(str1 + str2 + str3, cord.str());
 }
 
+TEST(CordTest, toIOBuf) {
+  Cord cord;
+
+  std::string buf;
+  for (int i = 0; i < 1000; i++) {
+    buf.append("Hello World!");
+  }
+  cord.write(buf.data(), buf.size());
+
+  auto chain = cord.toIOBuf();
+  ASSERT_NE(nullptr, chain);
+  EXPECT_EQ(buf.size(), chain->computeChainDataLength());
+
+  // The chain views the cord's blocks in order without flattening them
+  std::string assembled;
+  const folly::IOBuf* cur = chain.get();
+  do {
+    assembled.append(reinterpret_cast<const char*>(cur->data()), cur->length());
+    cur = cur->next();
+  } while (cur != chain.get());
+  EXPECT_EQ(buf, assembled);
+
+  Cord emptyCord;
+  auto emptyChain = emptyCord.toIOBuf();
+  ASSERT_NE(nullptr, emptyChain);
+  EXPECT_EQ(0, emptyChain->computeChainDataLength());
+}
+
 TEST(CordTest, cordStream) {
   Cord c1;
   Cord c2;
@@ -33,4 +33,20 @@ TEST(ObjectPoolTest, TestPooling) {
   ASSERT_EQ(instances, 0);
 }
 
+TEST(ObjectPoolTest, TestTriviallyDestructible) {
+  // Trivial types get no destructor bookkeeping at all, but still count as pooled
+  ObjectPool pool;
+  ASSERT_TRUE(pool.empty());
+  auto *i = pool.makeAndAdd<int>(42);
+  ASSERT_EQ(*i, 42);
+  ASSERT_FALSE(pool.empty());
+
+  ASSERT_NE(pool.makeAndAdd<MyClass>(), nullptr);
+  ASSERT_EQ(instances, 1);
+
+  pool.clear();
+  ASSERT_EQ(instances, 0);
+  ASSERT_TRUE(pool.empty());
+}
+
 }  // namespace nebula
@@ -46,15 +46,17 @@ class ExpressionContext {
   virtual StatusOr<std::size_t> getVarPropIndex(const std::string& var,
                                                 const std::string& prop) const = 0;
 
-  // Get the specified property from the edge, such as edge_type.prop_name
-  virtual Value getEdgeProp(const std::string& edgeType, const std::string& prop) const = 0;
+  // Get the specified property from the edge, such as edge_type.prop_name.
+  // The returned reference is only valid until the next property access on the same
+  // context, so callers who keep the value must copy it
+  virtual const Value& getEdgeProp(const std::string& edgeType, const std::string& prop) const = 0;
 
   // Get the specified property from the tag, such as tag.prop_name
-  virtual Value getTagProp(const std::string& tag, const std::string& prop) const = 0;
+  virtual const Value& getTagProp(const std::string& tag, const std::string& prop) const = 0;
 
   // Get the specified property from the source vertex, such as
   // $^.tag_name.prop_name
-  virtual Value getSrcProp(const std::string& tag, const std::string& prop) const = 0;
+  virtual const Value& getSrcProp(const std::string& tag, const std::string& prop) const = 0;
 
   // Get the specified property from the destination vertex, such as
   // $$.tag_name.prop_name
@@ -174,6 +174,15 @@ uint32_t Cpp2Ops<nebula::DataSet>::serializedSize(Protocol const* proto,
 template <class Protocol>
 uint32_t Cpp2Ops<nebula::DataSet>::serializedSizeZC(Protocol const* proto,
                                                     nebula::DataSet const* obj) {
+  // The result of this method is only a preallocation hint for the output buffer. Walking
+  // every row of a big result to make it exact costs a full second pass over the data and
+  // asks thrift for one contiguous buffer of the whole serialized size. Instead, sample
+  // the first rows, extrapolate, and cap the hint: the writer then appends further chained
+  // IOBufs on demand while it serializes, so large responses are written chunk by chunk
+  // instead of into a single full-size copy.
+  constexpr size_t kSampleRows = 64;
+  constexpr uint64_t kMaxSizeHint = 1UL << 20;
+
   uint32_t xfer = 0;
   xfer += proto->serializedStructSize("DataSet");
 
@@ -184,9 +193,19 @@ uint32_t Cpp2Ops<nebula::DataSet>::serializedSizeZC(Protocol const* proto,
                                                                                     obj->colNames);
 
   xfer += proto->serializedFieldSize("rows", protocol::T_LIST, 2);
-  xfer += detail::pm::protocol_methods<type_class::list<type_class::structure>,
-                                       std::vector<nebula::Row>>::serializedSize<false>(*proto,
-                                                                                        obj->rows);
+  if (obj->rows.size() <= kSampleRows) {
+    xfer += detail::pm::protocol_methods<type_class::list<type_class::structure>,
+                                         std::vector<nebula::Row>>::serializedSize<false>(
+        *proto, obj->rows);
+  } else {
+    uint64_t sampled = 0;
+    for (size_t i = 0; i < kSampleRows; i++) {
+      sampled += detail::pm::protocol_methods<type_class::structure, nebula::Row>::serializedSize<
+          false>(*proto, obj->rows[i]);
+    }
+    auto estimate = sampled / kSampleRows * obj->rows.size();
+    xfer += static_cast<uint32_t>(std::min(estimate, kMaxSizeHint));
+  }
 
   xfer += proto->serializedSizeStop();
   return xfer;
@@ -0,0 +1,128 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/datatypes/RowBatch.h"
+
+#include <cstring>
+
+namespace nebula {
+
+RowBatch::~RowBatch() {
+  for (auto* v : boxed_) {
+    v->~Value();
+  }
+}
+
+std::shared_ptr<RowBatch> RowBatch::fromDataSet(const DataSet& ds) {
+  auto batch = std::make_shared<RowBatch>(ds.colNames);
+  batch->rows_.reserve(ds.rows.size());
+  for (const auto& row : ds.rows) {
+    batch->append(row);
+  }
+  return batch;
+}
+
+void RowBatch::append(const Row& row) {
+  DCHECK_EQ(row.values.size(), colSize());
+  auto* cells = static_cast<Cell*>(arena_.allocateAligned(sizeof(Cell) * colSize()));
+  for (std::size_t i = 0; i < colSize(); ++i) {
+    encode(row.values[i], cells[i]);
+  }
+  rows_.emplace_back(cells);
+}
+
+void RowBatch::encode(const Value& v, Cell& cell) {
+  switch (v.type()) {
+    case Value::Type::__EMPTY__:
+      cell.type = CellType::kEmpty;
+      break;
+    case Value::Type::NULLVALUE:
+      cell.type = CellType::kNull;
+      cell.i = static_cast<int64_t>(v.getNull());
+      break;
+    case Value::Type::BOOL:
+      cell.type = CellType::kBool;
+      cell.b = v.getBool();
+      break;
+    case Value::Type::INT:
+      cell.type = CellType::kInt;
+      cell.i = v.getInt();
+      break;
+    case Value::Type::FLOAT:
+      cell.type = CellType::kFloat;
+      cell.f = v.getFloat();
+      break;
+    case Value::Type::STRING: {
+      const auto& str = v.getStr();
+      if (UNLIKELY(str.size() > kMaxInlineStrSize)) {
+        box(v, cell);
+        break;
+      }
+      cell.type = CellType::kString;
+      cell.s.len = static_cast<uint32_t>(str.size());
+      if (str.empty()) {
+        cell.s.ptr = nullptr;
+      } else {
+        auto* buf = static_cast<char*>(arena_.allocateAligned(str.size()));
+        ::memcpy(buf, str.data(), str.size());
+        cell.s.ptr = buf;
+      }
+      break;
+    }
+    default:
+      box(v, cell);
+      break;
+  }
+}
+
+void RowBatch::box(const Value& v, Cell& cell) {
+  auto* bv = new (arena_.allocateAligned(sizeof(Value))) Value(v);
+  boxed_.emplace_back(bv);
+  cell.type = CellType::kBoxed;
+  cell.boxed = bv;
+}
+
+Value RowBatch::valueAt(std::size_t row, std::size_t col) const {
+  DCHECK_LT(row, rows_.size());
+  DCHECK_LT(col, colSize());
+  const auto& cell = rows_[row][col];
+  switch (cell.type) {
+    case CellType::kEmpty:
+      return Value();
+    case CellType::kNull:
+      return Value(static_cast<NullType>(cell.i));
+    case CellType::kBool:
+      return Value(cell.b);
+    case CellType::kInt:
+      return Value(cell.i);
+    case CellType::kFloat:
+      return Value(cell.f);
+    case CellType::kString:
+      return cell.s.len == 0 ? Value(std::string()) : Value(std::string(cell.s.ptr, cell.s.len));
+    case CellType::kBoxed:
+      return *cell.boxed;
+  }
+  LOG(FATAL) << "Unknown cell type " << static_cast<int>(cell.type);
+}
+
+Row RowBatch::rowAt(std::size_t row) const {
+  Row r;
+  r.values.reserve(colSize());
+  for (std::size_t i = 0; i < colSize(); ++i) {
+    r.values.emplace_back(valueAt(row, i));
+  }
+  return r;
+}
+
+DataSet RowBatch::toDataSet() const {
+  DataSet ds(colNames_);
+  ds.rows.reserve(rowSize());
+  for (std::size_t i = 0; i < rowSize(); ++i) {
+    ds.rows.emplace_back(rowAt(i));
+  }
+  return ds;
+}
+
+}  // namespace nebula
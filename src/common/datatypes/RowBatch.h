@@ -0,0 +1,107 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_DATATYPES_ROWBATCH_H_
+#define COMMON_DATATYPES_ROWBATCH_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "common/base/Arena.h"
+#include "common/datatypes/DataSet.h"
+
+namespace nebula {
+
+// Compact, arena-backed storage for a batch of rows.
+//
+// DataSet keeps every cell as a full Value, so each string or container cell costs at least one
+// individual heap allocation, and for large intermediate results the per-cell malloc/free
+// dominates even when most cells are only ever read once. RowBatch instead encodes every cell
+// into a fixed-size slot allocated from an Arena: bools, ints, floats and nulls are stored
+// inline, strings are copied into the arena, and any other type falls back to a Value
+// constructed in arena memory. A Value is materialized only when a cell is actually read
+// through valueAt()/rowAt().
+//
+// Like the underlying Arena, a RowBatch is MT-unsafe and neither copyable nor movable; share it
+// via shared_ptr. Rows are immutable once appended.
+class RowBatch : public boost::noncopyable, cpp::NonMovable {
+ public:
+  explicit RowBatch(std::vector<std::string> columns) : colNames_(std::move(columns)) {
+    DCHECK(!colNames_.empty());
+  }
+
+  ~RowBatch();
+
+  static std::shared_ptr<RowBatch> fromDataSet(const DataSet& ds);
+
+  // Encode one row into the arena. The row must have exactly colSize() cells.
+  void append(const Row& row);
+
+  const std::vector<std::string>& colNames() const {
+    return colNames_;
+  }
+
+  std::size_t rowSize() const {
+    return rows_.size();
+  }
+
+  std::size_t colSize() const {
+    return colNames_.size();
+  }
+
+  // Materialize the single cell at (row, col)
+  Value valueAt(std::size_t row, std::size_t col) const;
+
+  // Materialize the whole row
+  Row rowAt(std::size_t row) const;
+
+  DataSet toDataSet() const;
+
+ private:
+  enum class CellType : uint8_t {
+    kEmpty,
+    kNull,
+    kBool,
+    kInt,
+    kFloat,
+    kString,
+    kBoxed,
+  };
+
+  struct StrRef {
+    const char* ptr;
+    uint32_t len;
+  };
+
+  struct Cell {
+    CellType type;
+    union {
+      bool b;
+      int64_t i;
+      double f;
+      StrRef s;
+      const Value* boxed;
+    };
+  };
+
+  // The arena can't serve one very large allocation, box strings longer than this
+  static constexpr std::size_t kMaxInlineStrSize = 8192;
+
+  void encode(const Value& v, Cell& cell);
+
+  // Keep the whole Value in arena memory, for types without an inline encoding
+  void box(const Value& v, Cell& cell);
+
+  Arena arena_;
+  std::vector<std::string> colNames_;
+  // every entry points to a colSize() sized cell array inside the arena
+  std::vector<const Cell*> rows_;
+  // arena-constructed Values which need their destructor run
+  std::vector<Value*> boxed_;
+};
+
+}  // namespace nebula
+#endif  // COMMON_DATATYPES_ROWBATCH_H_
@@ -419,16 +419,29 @@ void Value::setFloat(double&& v) {
 }
 
 void Value::setStr(const std::string& v) {
+  // Assigning into the held string reuses its buffer instead of reallocating the node
+  if (type_ == Type::STRING) {
+    *value_.sVal = v;
+    return;
+  }
   clear();
   setS(v);
 }
 
 void Value::setStr(std::string&& v) {
+  if (type_ == Type::STRING) {
+    *value_.sVal = std::move(v);
+    return;
+  }
   clear();
   setS(std::move(v));
 }
 
 void Value::setStr(const char* v) {
+  if (type_ == Type::STRING) {
+    *value_.sVal = v;
+    return;
+  }
   clear();
   setS(v);
 }
@@ -1102,6 +1115,11 @@ Value& Value::operator=(const Value& rhs) {
   if (this == &rhs) {
     return *this;
   }
+  // String over string assigns into the held buffer, skipping the node reallocation
+  if (type_ == Type::STRING && rhs.type_ == Type::STRING) {
+    *value_.sVal = *rhs.value_.sVal;
+    return *this;
+  }
   clear();
   if (rhs.type_ == Type::__EMPTY__) {
     return *this;
@@ -0,0 +1,105 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_DATATYPES_VALUECOMPARATOR_H_
+#define COMMON_DATATYPES_VALUECOMPARATOR_H_
+
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+
+/**
+ * Typed three-way comparators over Value. Value::operator< runs a type switch per
+ * comparison, which sort/merge/top-n paths pay millions of times over same-typed
+ * columns. A caller which knows (or has observed) a column's type can fetch the typed
+ * comparator once and skip the dispatch in its hot loop.
+ *
+ * Each typed comparator assumes both operands actually hold the selected type; callers
+ * must verify the types per row (nulls and mixed columns happen) and fall back to
+ * compareGeneric otherwise, which reproduces Value's ordering exactly.
+ */
+class ValueComparator final {
+ public:
+  using Fn = int (*)(const Value&, const Value&);
+
+  /**
+   * @brief Generic fallback, ordering identically to Value's operator</operator==.
+   */
+  static int compareGeneric(const Value& lhs, const Value& rhs) {
+    if (lhs == rhs) {
+      return 0;
+    }
+    return lhs < rhs ? -1 : 1;
+  }
+
+  /**
+   * @brief Return the typed comparator for the given type, or compareGeneric when the
+   * type has no fast path. The returned function is only valid for operands of exactly
+   * that type.
+   */
+  static Fn forType(Value::Type type) {
+    switch (type) {
+      case Value::Type::BOOL:
+        return &compareBool;
+      case Value::Type::INT:
+        return &compareInt;
+      case Value::Type::FLOAT:
+        return &compareFloat;
+      case Value::Type::STRING:
+        return &compareString;
+      case Value::Type::DATE:
+        return &compareDate;
+      case Value::Type::TIME:
+        return &compareTime;
+      case Value::Type::DATETIME:
+        return &compareDateTime;
+      default:
+        return &compareGeneric;
+    }
+  }
+
+ private:
+  static int compareBool(const Value& lhs, const Value& rhs) {
+    return threeWay(lhs.getBool(), rhs.getBool());
+  }
+
+  static int compareInt(const Value& lhs, const Value& rhs) {
+    return threeWay(lhs.getInt(), rhs.getInt());
+  }
+
+  static int compareFloat(const Value& lhs, const Value& rhs) {
+    return threeWay(lhs.getFloat(), rhs.getFloat());
+  }
+
+  static int compareString(const Value& lhs, const Value& rhs) {
+    return lhs.getStr().compare(rhs.getStr());
+  }
+
+  static int compareDate(const Value& lhs, const Value& rhs) {
+    return threeWay(lhs.getDate(), rhs.getDate());
+  }
+
+  static int compareTime(const Value& lhs, const Value& rhs) {
+    return threeWay(lhs.getTime(), rhs.getTime());
+  }
+
+  static int compareDateTime(const Value& lhs, const Value& rhs) {
+    return threeWay(lhs.getDateTime(), rhs.getDateTime());
+  }
+
+  template <typename T>
+  static int threeWay(const T& lhs, const T& rhs) {
+    if (lhs < rhs) {
+      return -1;
+    }
+    if (rhs < lhs) {
+      return 1;
+    }
+    return 0;
+  }
+};
+
+}  // namespace nebula
+#endif  // COMMON_DATATYPES_VALUECOMPARATOR_H_
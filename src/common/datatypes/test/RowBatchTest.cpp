@@ -0,0 +1,71 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/datatypes/List.h"
+#include "common/datatypes/RowBatch.h"
+
+namespace nebula {
+
+TEST(RowBatchTest, InlineTypes) {
+  RowBatch batch({"b", "i", "f", "s", "n", "e"});
+  Row row({true, 42, 3.14, "hello", Value::kNullValue, Value()});
+  batch.append(row);
+  EXPECT_EQ(batch.rowSize(), 1);
+  EXPECT_EQ(batch.colSize(), 6);
+
+  EXPECT_EQ(batch.valueAt(0, 0), Value(true));
+  EXPECT_EQ(batch.valueAt(0, 1), Value(42));
+  EXPECT_EQ(batch.valueAt(0, 2), Value(3.14));
+  EXPECT_EQ(batch.valueAt(0, 3), Value("hello"));
+  EXPECT_EQ(batch.valueAt(0, 4), Value::kNullValue);
+  EXPECT_EQ(batch.valueAt(0, 5), Value::kEmpty);
+  EXPECT_EQ(batch.rowAt(0), row);
+}
+
+TEST(RowBatchTest, NullTypes) {
+  RowBatch batch({"n1", "n2", "n3"});
+  Row row({Value::kNullNaN, Value::kNullBadType, Value::kNullDivByZero});
+  batch.append(row);
+  EXPECT_EQ(batch.valueAt(0, 0), Value::kNullNaN);
+  EXPECT_EQ(batch.valueAt(0, 1), Value::kNullBadType);
+  EXPECT_EQ(batch.valueAt(0, 2), Value::kNullDivByZero);
+}
+
+TEST(RowBatchTest, BoxedTypes) {
+  RowBatch batch({"list", "str"});
+  List nested({1, 2, 3});
+  std::string longStr(64 * 1024, 'x');
+  Row row({Value(nested), Value(longStr)});
+  batch.append(row);
+  EXPECT_EQ(batch.valueAt(0, 0), Value(nested));
+  EXPECT_EQ(batch.valueAt(0, 1), Value(longStr));
+}
+
+TEST(RowBatchTest, RoundTrip) {
+  DataSet ds({"col1", "col2", "col3"});
+  for (auto i = 0; i < 1000; ++i) {
+    ds.emplace_back(Row({i, folly::to<std::string>(i), i % 2 == 0}));
+  }
+  auto batch = RowBatch::fromDataSet(ds);
+  EXPECT_EQ(batch->rowSize(), 1000);
+  EXPECT_EQ(batch->colNames(), ds.colNames);
+  for (std::size_t i = 0; i < batch->rowSize(); ++i) {
+    EXPECT_EQ(batch->rowAt(i), ds.rows[i]);
+  }
+  EXPECT_EQ(batch->toDataSet(), ds);
+}
+
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -1734,6 +1734,30 @@ TEST(Value, Ctor) {
   // Value v2(&tmp);
 }
 
+TEST(Value, StringReassign) {
+  // Reassigning a string over a string reuses the held node instead of reallocating it
+  Value v("short");
+  v.setStr(std::string(100, 'x'));
+  EXPECT_EQ(std::string(100, 'x'), v.getStr());
+  v.setStr("short again");
+  EXPECT_EQ("short again", v.getStr());
+
+  Value w("other");
+  v = w;
+  EXPECT_EQ("other", v.getStr());
+  EXPECT_EQ("other", w.getStr());
+
+  // Type transitions still go through the regular destruct-and-set path
+  v.setInt(42);
+  EXPECT_TRUE(v.isInt());
+  v.setStr("back to string");
+  EXPECT_EQ("back to string", v.getStr());
+
+  Value& vRef = v;
+  v = vRef;
+  EXPECT_EQ("back to string", v.getStr());
+}
+
 TEST(Value, ToString) {
   {
     Duration d;
@@ -0,0 +1,524 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/expression/ExprBytecode.h"
+
+#include <cmath>
+#include <limits>
+
+#include "common/context/ExpressionContext.h"
+#include "common/expression/BinaryExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/FunctionCallExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/UnaryExpression.h"
+
+namespace nebula {
+
+namespace {
+constexpr int32_t kTooManyRegs = -1;
+constexpr size_t kMaxRegs = std::numeric_limits<uint16_t>::max();
+}  // namespace
+
+std::unique_ptr<ExprBytecode> ExprBytecode::compile(const Expression* expr) {
+  std::unique_ptr<ExprBytecode> program(new ExprBytecode());
+  auto reg = program->compileNode(expr);
+  if (reg < 0) {
+    return nullptr;
+  }
+  program->resultReg_ = static_cast<uint16_t>(reg);
+  program->regs_.resize(program->numRegs_);
+  return program;
+}
+
+int32_t ExprBytecode::newReg() {
+  if (numRegs_ >= kMaxRegs) {
+    return kTooManyRegs;
+  }
+  return numRegs_++;
+}
+
+uint16_t ExprBytecode::addName(const std::string& name) {
+  for (size_t i = 0; i < names_.size(); ++i) {
+    if (names_[i] == name) {
+      return static_cast<uint16_t>(i);
+    }
+  }
+  names_.emplace_back(name);
+  return static_cast<uint16_t>(names_.size() - 1);
+}
+
+int32_t ExprBytecode::compileNode(const Expression* expr) {
+  switch (expr->kind()) {
+    case Expression::Kind::kConstant: {
+      auto dst = newReg();
+      if (dst < 0) {
+        return -1;
+      }
+      consts_.emplace_back(static_cast<const ConstantExpression*>(expr)->value());
+      code_.push_back({OpCode::kLoadConst,
+                       static_cast<uint16_t>(dst),
+                       static_cast<uint16_t>(consts_.size() - 1),
+                       0});
+      return dst;
+    }
+    case Expression::Kind::kInputProperty: {
+      const auto& prop = static_cast<const PropertyExpression*>(expr)->prop();
+      if (prop == "*") {
+        return -1;
+      }
+      auto dst = newReg();
+      if (dst < 0) {
+        return -1;
+      }
+      code_.push_back({OpCode::kInputProp, static_cast<uint16_t>(dst), addName(prop), 0});
+      return dst;
+    }
+    case Expression::Kind::kVarProperty: {
+      const auto* propExpr = static_cast<const PropertyExpression*>(expr);
+      if (propExpr->prop() == "*") {
+        return -1;
+      }
+      auto dst = newReg();
+      if (dst < 0) {
+        return -1;
+      }
+      code_.push_back({OpCode::kVarProp,
+                       static_cast<uint16_t>(dst),
+                       addName(propExpr->sym()),
+                       addName(propExpr->prop())});
+      return dst;
+    }
+    case Expression::Kind::kAdd:
+    case Expression::Kind::kMinus:
+    case Expression::Kind::kMultiply:
+    case Expression::Kind::kDivision:
+    case Expression::Kind::kMod:
+    case Expression::Kind::kRelEQ:
+    case Expression::Kind::kRelNE:
+    case Expression::Kind::kRelLT:
+    case Expression::Kind::kRelLE:
+    case Expression::Kind::kRelGT:
+    case Expression::Kind::kRelGE: {
+      const auto* binExpr = static_cast<const BinaryExpression*>(expr);
+      auto lhs = compileNode(binExpr->left());
+      if (lhs < 0) {
+        return -1;
+      }
+      auto rhs = compileNode(binExpr->right());
+      if (rhs < 0) {
+        return -1;
+      }
+      auto dst = newReg();
+      if (dst < 0) {
+        return -1;
+      }
+      OpCode op;
+      switch (expr->kind()) {
+        case Expression::Kind::kAdd:
+          op = OpCode::kAdd;
+          break;
+        case Expression::Kind::kMinus:
+          op = OpCode::kMinus;
+          break;
+        case Expression::Kind::kMultiply:
+          op = OpCode::kMultiply;
+          break;
+        case Expression::Kind::kDivision:
+          op = OpCode::kDivision;
+          break;
+        case Expression::Kind::kMod:
+          op = OpCode::kMod;
+          break;
+        case Expression::Kind::kRelEQ:
+          op = OpCode::kEq;
+          break;
+        case Expression::Kind::kRelNE:
+          op = OpCode::kNe;
+          break;
+        case Expression::Kind::kRelLT:
+          op = OpCode::kLt;
+          break;
+        case Expression::Kind::kRelLE:
+          op = OpCode::kLe;
+          break;
+        case Expression::Kind::kRelGT:
+          op = OpCode::kGt;
+          break;
+        default:
+          op = OpCode::kGe;
+          break;
+      }
+      code_.push_back({op,
+                       static_cast<uint16_t>(dst),
+                       static_cast<uint16_t>(lhs),
+                       static_cast<uint16_t>(rhs)});
+      return dst;
+    }
+    case Expression::Kind::kUnaryPlus:
+    case Expression::Kind::kUnaryNegate:
+    case Expression::Kind::kUnaryNot:
+    case Expression::Kind::kIsNull:
+    case Expression::Kind::kIsNotNull:
+    case Expression::Kind::kIsEmpty:
+    case Expression::Kind::kIsNotEmpty: {
+      auto operand = compileNode(static_cast<const UnaryExpression*>(expr)->operand());
+      if (operand < 0) {
+        return -1;
+      }
+      auto dst = newReg();
+      if (dst < 0) {
+        return -1;
+      }
+      OpCode op;
+      switch (expr->kind()) {
+        case Expression::Kind::kUnaryPlus:
+          op = OpCode::kPlus;
+          break;
+        case Expression::Kind::kUnaryNegate:
+          op = OpCode::kNegate;
+          break;
+        case Expression::Kind::kUnaryNot:
+          op = OpCode::kNot;
+          break;
+        case Expression::Kind::kIsNull:
+          op = OpCode::kIsNull;
+          break;
+        case Expression::Kind::kIsNotNull:
+          op = OpCode::kIsNotNull;
+          break;
+        case Expression::Kind::kIsEmpty:
+          op = OpCode::kIsEmpty;
+          break;
+        default:
+          op = OpCode::kIsNotEmpty;
+          break;
+      }
+      code_.push_back({op, static_cast<uint16_t>(dst), static_cast<uint16_t>(operand), 0});
+      return dst;
+    }
+    case Expression::Kind::kLogicalAnd:
+    case Expression::Kind::kLogicalOr: {
+      bool isAnd = expr->kind() == Expression::Kind::kLogicalAnd;
+      auto dst = newReg();
+      if (dst < 0) {
+        return -1;
+      }
+      consts_.emplace_back(isAnd);
+      code_.push_back({OpCode::kLoadConst,
+                       static_cast<uint16_t>(dst),
+                       static_cast<uint16_t>(consts_.size() - 1),
+                       0});
+      std::vector<size_t> stepsToPatch;
+      for (const auto& operand : static_cast<const LogicalExpression*>(expr)->operands()) {
+        auto reg = compileNode(operand);
+        if (reg < 0) {
+          return -1;
+        }
+        stepsToPatch.push_back(code_.size());
+        code_.push_back({isAnd ? OpCode::kAndStep : OpCode::kOrStep,
+                         static_cast<uint16_t>(dst),
+                         static_cast<uint16_t>(reg),
+                         0});
+      }
+      if (code_.size() > kMaxRegs) {
+        // Jump targets are encoded in an uint16_t too
+        return -1;
+      }
+      for (auto i : stepsToPatch) {
+        code_[i].b = static_cast<uint16_t>(code_.size());
+      }
+      return dst;
+    }
+    case Expression::Kind::kFunctionCall: {
+      const auto* funcExpr = static_cast<const FunctionCallExpression*>(expr);
+      const auto& args = DCHECK_NOTNULL(funcExpr->args())->args();
+      if (funcExpr->isFunc("coalesce") && !args.empty()) {
+        // Folds like OR: the accumulator starts out null and the first non null operand wins,
+        // so the remaining (pure) operands do not even have to be evaluated
+        auto dst = newReg();
+        if (dst < 0) {
+          return -1;
+        }
+        consts_.emplace_back(Value::kNullValue);
+        code_.push_back({OpCode::kLoadConst,
+                         static_cast<uint16_t>(dst),
+                         static_cast<uint16_t>(consts_.size() - 1),
+                         0});
+        std::vector<size_t> stepsToPatch;
+        for (const auto& arg : args) {
+          auto reg = compileNode(arg);
+          if (reg < 0) {
+            return -1;
+          }
+          stepsToPatch.push_back(code_.size());
+          code_.push_back({OpCode::kCoalesceStep,
+                           static_cast<uint16_t>(dst),
+                           static_cast<uint16_t>(reg),
+                           0});
+        }
+        if (code_.size() > kMaxRegs) {
+          return -1;
+        }
+        for (auto i : stepsToPatch) {
+          code_[i].b = static_cast<uint16_t>(code_.size());
+        }
+        return dst;
+      }
+      if (args.size() != 1) {
+        return -1;
+      }
+      OpCode op;
+      if (funcExpr->isFunc("abs")) {
+        op = OpCode::kAbs;
+      } else if (funcExpr->isFunc("floor")) {
+        op = OpCode::kFloor;
+      } else if (funcExpr->isFunc("ceil")) {
+        op = OpCode::kCeil;
+      } else if (funcExpr->isFunc("round")) {
+        op = OpCode::kRound;
+      } else if (funcExpr->isFunc("sqrt")) {
+        op = OpCode::kSqrt;
+      } else {
+        return -1;
+      }
+      auto operand = compileNode(args[0]);
+      if (operand < 0) {
+        return -1;
+      }
+      auto dst = newReg();
+      if (dst < 0) {
+        return -1;
+      }
+      code_.push_back({op, static_cast<uint16_t>(dst), static_cast<uint16_t>(operand), 0});
+      return dst;
+    }
+    default:
+      return -1;
+  }
+}
+
+const Value& ExprBytecode::eval(ExpressionContext& ctx) {
+  size_t pc = 0;
+  const size_t size = code_.size();
+  while (pc < size) {
+    const auto& ins = code_[pc];
+    auto& dst = regs_[ins.dst];
+    switch (ins.op) {
+      case OpCode::kLoadConst:
+        dst = consts_[ins.a];
+        break;
+      case OpCode::kInputProp:
+        dst = ctx.getInputProp(names_[ins.a]);
+        break;
+      case OpCode::kVarProp:
+        dst = ctx.getVarProp(names_[ins.a], names_[ins.b]);
+        break;
+      case OpCode::kAdd:
+        dst = regs_[ins.a] + regs_[ins.b];
+        break;
+      case OpCode::kMinus:
+        dst = regs_[ins.a] - regs_[ins.b];
+        break;
+      case OpCode::kMultiply:
+        dst = regs_[ins.a] * regs_[ins.b];
+        break;
+      case OpCode::kDivision:
+        dst = regs_[ins.a] / regs_[ins.b];
+        break;
+      case OpCode::kMod:
+        dst = regs_[ins.a] % regs_[ins.b];
+        break;
+      case OpCode::kEq:
+        dst = regs_[ins.a].equal(regs_[ins.b]);
+        break;
+      case OpCode::kNe:
+        dst = !regs_[ins.a].equal(regs_[ins.b]);
+        break;
+      case OpCode::kLt:
+        dst = regs_[ins.a].lessThan(regs_[ins.b]);
+        break;
+      case OpCode::kLe:
+        dst = regs_[ins.a].lessThan(regs_[ins.b]) || regs_[ins.a].equal(regs_[ins.b]);
+        break;
+      case OpCode::kGt:
+        dst = regs_[ins.b].lessThan(regs_[ins.a]);
+        break;
+      case OpCode::kGe:
+        dst = regs_[ins.b].lessThan(regs_[ins.a]) || regs_[ins.a].equal(regs_[ins.b]);
+        break;
+      case OpCode::kPlus:
+        dst = regs_[ins.a];
+        break;
+      case OpCode::kNegate:
+        dst = -regs_[ins.a];
+        break;
+      case OpCode::kNot:
+        dst = !regs_[ins.a];
+        break;
+      case OpCode::kIsNull:
+        dst = regs_[ins.a].isNull();
+        break;
+      case OpCode::kIsNotNull:
+        dst = !regs_[ins.a].isNull();
+        break;
+      case OpCode::kIsEmpty:
+        dst = regs_[ins.a].empty();
+        break;
+      case OpCode::kIsNotEmpty:
+        dst = !regs_[ins.a].empty();
+        break;
+      // The two fold steps replicate one iteration of LogicalExpression::evalAnd/evalOr:
+      // the accumulator keeps the strongest verdict seen so far and jumps out of the fold
+      // once the result can not change anymore
+      case OpCode::kAndStep: {
+        const auto& value = regs_[ins.a];
+        if (value.isBadNull() || (value.isImplicitBool() && !value.implicitBool())) {
+          dst = value;
+          pc = ins.b;
+          continue;
+        }
+        if (!value.isImplicitBool()) {
+          if (value.isNull()) {
+            dst = value;
+          } else if (value.empty() && !dst.isNull()) {
+            dst = value;
+          } else {
+            dst = Value::kNullBadType;
+            pc = ins.b;
+            continue;
+          }
+        }
+        break;
+      }
+      case OpCode::kOrStep: {
+        const auto& value = regs_[ins.a];
+        if (value.isBadNull() || (value.isImplicitBool() && value.implicitBool())) {
+          dst = value;
+          pc = ins.b;
+          continue;
+        }
+        if (!value.isImplicitBool()) {
+          if (value.isNull()) {
+            dst = value;
+          } else if (value.empty() && !dst.isNull()) {
+            dst = value;
+          } else {
+            dst = Value::kNullBadType;
+            pc = ins.b;
+            continue;
+          }
+        }
+        break;
+      }
+      // The math opcodes mirror the type dispatch of the corresponding FunctionManager
+      // builtins, minus the std::function call and the argument vector per row
+      case OpCode::kAbs: {
+        const auto& value = regs_[ins.a];
+        switch (value.type()) {
+          case Value::Type::NULLVALUE:
+            dst = Value::kNullValue;
+            break;
+          case Value::Type::INT:
+            dst = std::abs(value.getInt());
+            break;
+          case Value::Type::FLOAT:
+            dst = std::abs(value.getFloat());
+            break;
+          default:
+            dst = Value::kNullBadType;
+            break;
+        }
+        break;
+      }
+      case OpCode::kFloor: {
+        const auto& value = regs_[ins.a];
+        switch (value.type()) {
+          case Value::Type::NULLVALUE:
+            dst = Value::kNullValue;
+            break;
+          case Value::Type::INT:
+            dst = std::floor(value.getInt());
+            break;
+          case Value::Type::FLOAT:
+            dst = std::floor(value.getFloat());
+            break;
+          default:
+            dst = Value::kNullBadType;
+            break;
+        }
+        break;
+      }
+      case OpCode::kCeil: {
+        const auto& value = regs_[ins.a];
+        switch (value.type()) {
+          case Value::Type::NULLVALUE:
+            dst = Value::kNullValue;
+            break;
+          case Value::Type::INT:
+            dst = std::ceil(value.getInt());
+            break;
+          case Value::Type::FLOAT:
+            dst = std::ceil(value.getFloat());
+            break;
+          default:
+            dst = Value::kNullBadType;
+            break;
+        }
+        break;
+      }
+      case OpCode::kRound: {
+        const auto& value = regs_[ins.a];
+        switch (value.type()) {
+          case Value::Type::NULLVALUE:
+            dst = Value::kNullValue;
+            break;
+          case Value::Type::INT:
+            dst = std::round(static_cast<double>(value.getInt()));
+            break;
+          case Value::Type::FLOAT:
+            dst = std::round(value.getFloat());
+            break;
+          default:
+            dst = Value::kNullBadType;
+            break;
+        }
+        break;
+      }
+      case OpCode::kSqrt: {
+        const auto& value = regs_[ins.a];
+        switch (value.type()) {
+          case Value::Type::NULLVALUE:
+            dst = Value::kNullValue;
+            break;
+          case Value::Type::INT:
+            dst = std::sqrt(value.getInt());
+            break;
+          case Value::Type::FLOAT:
+            dst = std::sqrt(value.getFloat());
+            break;
+          default:
+            dst = Value::kNullBadType;
+            break;
+        }
+        break;
+      }
+      case OpCode::kCoalesceStep: {
+        const auto& value = regs_[ins.a];
+        if (value.type() != Value::Type::NULLVALUE) {
+          dst = value;
+          pc = ins.b;
+          continue;
+        }
+        break;
+      }
+    }
+    ++pc;
+  }
+  return regs_[resultReg_];
+}
+
+}  // namespace nebula
@@ -0,0 +1,98 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_EXPRESSION_EXPRBYTECODE_H_
+#define COMMON_EXPRESSION_EXPRBYTECODE_H_
+
+#include <memory>
+#include <vector>
+
+#include "common/expression/Expression.h"
+
+namespace nebula {
+
+// A flat register based program compiled from an Expression tree. The program is executed by
+// a tight switch loop over preallocated Value registers, so a hot predicate or projection
+// evaluated once per row skips the virtual eval() walk and the temporary allocations of the
+// AST interpreter.
+//
+// Only side effect free constructs are compiled: constants, input/variable properties,
+// arithmetic, the comparison operators, unary plus/negate/not, IS (NOT) NULL/EMPTY,
+// logical AND/OR (with the same fold-and-short-circuit semantics as LogicalExpression)
+// and calls to a handful of hot pure builtins (abs/floor/ceil/round/sqrt/coalesce), which
+// become dedicated opcodes instead of going through FunctionManager per row.
+// compile() returns nullptr for anything else and the caller falls back to the interpreter.
+//
+// An ExprBytecode instance owns its registers and is as thread-unsafe as the Expression it
+// was compiled from: use one instance per concurrent job.
+class ExprBytecode final {
+ public:
+  // Returns nullptr when the expression contains constructs the bytecode does not support
+  static std::unique_ptr<ExprBytecode> compile(const Expression* expr);
+
+  // Evaluates the program against the current row of `ctx`, equivalent to expr->eval(ctx)
+  const Value& eval(ExpressionContext& ctx);
+
+ private:
+  enum class OpCode : uint8_t {
+    kLoadConst,   // regs[dst] = consts[a]
+    kInputProp,   // regs[dst] = ctx.getInputProp(names[a])
+    kVarProp,     // regs[dst] = ctx.getVarProp(names[a], names[b])
+    kAdd,         // regs[dst] = regs[a] + regs[b]
+    kMinus,       // regs[dst] = regs[a] - regs[b]
+    kMultiply,    // regs[dst] = regs[a] * regs[b]
+    kDivision,    // regs[dst] = regs[a] / regs[b]
+    kMod,         // regs[dst] = regs[a] % regs[b]
+    kEq,          // regs[dst] = regs[a].equal(regs[b])
+    kNe,          // regs[dst] = !regs[a].equal(regs[b])
+    kLt,          // regs[dst] = regs[a].lessThan(regs[b])
+    kLe,          // regs[dst] = lessThan || equal
+    kGt,          // regs[dst] = regs[b].lessThan(regs[a])
+    kGe,          // regs[dst] = regs[b].lessThan(regs[a]) || equal
+    kPlus,        // regs[dst] = regs[a]
+    kNegate,      // regs[dst] = -regs[a]
+    kNot,         // regs[dst] = !regs[a]
+    kIsNull,      // regs[dst] = regs[a].isNull()
+    kIsNotNull,   // regs[dst] = !regs[a].isNull()
+    kIsEmpty,     // regs[dst] = regs[a].empty()
+    kIsNotEmpty,  // regs[dst] = !regs[a].empty()
+    kAndStep,     // fold regs[a] into the AND accumulator regs[dst], jump to b on short
+                  // circuit
+    kOrStep,      // fold regs[a] into the OR accumulator regs[dst], jump to b on short
+                  // circuit
+    kAbs,           // regs[dst] = abs(regs[a]), same semantics as the abs() builtin
+    kFloor,         // regs[dst] = floor(regs[a])
+    kCeil,          // regs[dst] = ceil(regs[a])
+    kRound,         // regs[dst] = round(regs[a]), the single argument form only
+    kSqrt,          // regs[dst] = sqrt(regs[a])
+    kCoalesceStep,  // if regs[a] is not null, regs[dst] = regs[a] and jump to b
+  };
+
+  struct Instr {
+    OpCode op;
+    uint16_t dst;
+    uint16_t a;
+    uint16_t b;
+  };
+
+  ExprBytecode() = default;
+
+  // Returns the register holding the node result, or -1 when the node is not supported
+  int32_t compileNode(const Expression* expr);
+
+  int32_t newReg();
+  uint16_t addName(const std::string& name);
+
+  std::vector<Instr> code_;
+  std::vector<Value> consts_;
+  std::vector<std::string> names_;
+  std::vector<Value> regs_;
+  uint16_t numRegs_{0};
+  uint16_t resultReg_{0};
+};
+
+}  // namespace nebula
+
+#endif  // COMMON_EXPRESSION_EXPRBYTECODE_H_
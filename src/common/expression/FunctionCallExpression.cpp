@@ -70,11 +70,13 @@ void FunctionCallExpression::resetFrom(Decoder& decoder) {
 }
 
 const Value& FunctionCallExpression::eval(ExpressionContext& ctx) {
-  std::vector<std::reference_wrapper<const Value>> parameter;
+  // The arity never changes, so clearing keeps the capacity and the argument
+  // vector is allocated only on the first evaluation
+  argValues_.clear();
   for (const auto& arg : DCHECK_NOTNULL(args_)->args()) {
-    parameter.emplace_back(arg->eval(ctx));
+    argValues_.emplace_back(arg->eval(ctx));
   }
-  result_ = DCHECK_NOTNULL(func_)(parameter);
+  result_ = DCHECK_NOTNULL(func_)(argValues_);
   return result_;
 }
 
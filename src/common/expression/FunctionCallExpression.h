@@ -137,6 +137,7 @@ class FunctionCallExpression final : public Expression {
   // runtime cache
   Value result_;
   FunctionManager::Function func_;
+  std::vector<FunctionManager::ArgType> argValues_;
 };
 
 }  // namespace nebula
@@ -0,0 +1,162 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+#include "common/expression/ExprBytecode.h"
+#include "common/expression/test/TestBase.h"
+
+namespace nebula {
+
+class ExprBytecodeTest : public ExpressionTest {
+ protected:
+  // The compiled program must yield exactly what the interpreter yields
+  static void checkParity(Expression *expr) {
+    auto program = ExprBytecode::compile(expr);
+    ASSERT_NE(program, nullptr) << expr->toString();
+    EXPECT_EQ(program->eval(gExpCtxt), Expression::eval(expr, gExpCtxt)) << expr->toString();
+  }
+};
+
+TEST_F(ExprBytecodeTest, Arithmetic) {
+  checkParity(ArithmeticExpression::makeAdd(
+      &pool, ConstantExpression::make(&pool, 1), ConstantExpression::make(&pool, 2)));
+  checkParity(ArithmeticExpression::makeMinus(
+      &pool, InputPropertyExpression::make(&pool, "int"), ConstantExpression::make(&pool, 3)));
+  checkParity(ArithmeticExpression::makeMultiply(
+      &pool,
+      VariablePropertyExpression::make(&pool, "var", "float"),
+      ConstantExpression::make(&pool, 2)));
+  checkParity(ArithmeticExpression::makeDivision(
+      &pool, ConstantExpression::make(&pool, 10), ConstantExpression::make(&pool, 0)));
+  checkParity(ArithmeticExpression::makeMod(
+      &pool, ConstantExpression::make(&pool, 10), ConstantExpression::make(&pool, 3)));
+  // Nested expressions share registers in compilation order
+  checkParity(ArithmeticExpression::makeAdd(
+      &pool,
+      ArithmeticExpression::makeMultiply(&pool,
+                                         InputPropertyExpression::make(&pool, "int"),
+                                         ConstantExpression::make(&pool, 4)),
+      ArithmeticExpression::makeMinus(&pool,
+                                      ConstantExpression::make(&pool, 7),
+                                      InputPropertyExpression::make(&pool, "float"))));
+}
+
+TEST_F(ExprBytecodeTest, Relational) {
+  checkParity(RelationalExpression::makeEQ(
+      &pool, InputPropertyExpression::make(&pool, "int"), ConstantExpression::make(&pool, 1)));
+  checkParity(RelationalExpression::makeNE(
+      &pool, InputPropertyExpression::make(&pool, "int"), ConstantExpression::make(&pool, 1)));
+  checkParity(RelationalExpression::makeLT(
+      &pool, ConstantExpression::make(&pool, 1), InputPropertyExpression::make(&pool, "float")));
+  checkParity(RelationalExpression::makeLE(
+      &pool, ConstantExpression::make(&pool, 1.1), InputPropertyExpression::make(&pool, "float")));
+  checkParity(RelationalExpression::makeGT(&pool,
+                                           InputPropertyExpression::make(&pool, "string16"),
+                                           ConstantExpression::make(&pool, "a")));
+  checkParity(RelationalExpression::makeGE(
+      &pool, InputPropertyExpression::make(&pool, "int"), ConstantExpression::make(&pool, 1)));
+  // Comparing a null keeps the interpreter's null verdict
+  checkParity(RelationalExpression::makeLT(
+      &pool, InputPropertyExpression::make(&pool, "null"), ConstantExpression::make(&pool, 1)));
+}
+
+TEST_F(ExprBytecodeTest, Unary) {
+  checkParity(UnaryExpression::makePlus(&pool, ConstantExpression::make(&pool, 1)));
+  checkParity(UnaryExpression::makeNegate(&pool, InputPropertyExpression::make(&pool, "int")));
+  checkParity(UnaryExpression::makeNot(&pool, InputPropertyExpression::make(&pool, "bool_true")));
+  checkParity(UnaryExpression::makeIsNull(&pool, InputPropertyExpression::make(&pool, "null")));
+  checkParity(UnaryExpression::makeIsNotNull(&pool, InputPropertyExpression::make(&pool, "int")));
+  checkParity(UnaryExpression::makeIsEmpty(&pool, InputPropertyExpression::make(&pool, "empty")));
+  checkParity(
+      UnaryExpression::makeIsNotEmpty(&pool, InputPropertyExpression::make(&pool, "empty")));
+}
+
+TEST_F(ExprBytecodeTest, Logical) {
+  for (const char *lhs : {"bool_true", "bool_false", "null", "empty"}) {
+    for (const char *rhs : {"bool_true", "bool_false", "null", "empty"}) {
+      checkParity(LogicalExpression::makeAnd(&pool,
+                                             InputPropertyExpression::make(&pool, lhs),
+                                             InputPropertyExpression::make(&pool, rhs)));
+      checkParity(LogicalExpression::makeOr(&pool,
+                                            InputPropertyExpression::make(&pool, lhs),
+                                            InputPropertyExpression::make(&pool, rhs)));
+    }
+  }
+  // Multi-operand fold with a short circuit in the middle
+  auto *multiAnd = LogicalExpression::makeAnd(&pool,
+                                              InputPropertyExpression::make(&pool, "bool_true"),
+                                              InputPropertyExpression::make(&pool, "bool_false"));
+  multiAnd->addOperand(InputPropertyExpression::make(&pool, "null"));
+  checkParity(multiAnd);
+  auto *multiOr = LogicalExpression::makeOr(&pool,
+                                            InputPropertyExpression::make(&pool, "bool_false"),
+                                            InputPropertyExpression::make(&pool, "bool_true"));
+  multiOr->addOperand(InputPropertyExpression::make(&pool, "null"));
+  checkParity(multiOr);
+  // Non-boolean operand yields BAD_TYPE like the interpreter
+  checkParity(LogicalExpression::makeAnd(&pool,
+                                         InputPropertyExpression::make(&pool, "int"),
+                                         InputPropertyExpression::make(&pool, "bool_true")));
+}
+
+TEST_F(ExprBytecodeTest, FunctionCalls) {
+  for (const char *func : {"abs", "floor", "ceil", "sqrt"}) {
+    for (const char *arg : {"int", "float", "null", "string16"}) {
+      auto *argList = ArgumentList::make(&pool);
+      argList->addArgument(InputPropertyExpression::make(&pool, arg));
+      checkParity(FunctionCallExpression::make(&pool, func, argList));
+    }
+  }
+  // The single argument round only, the multi argument forms keep the interpreter
+  for (const char *arg : {"float", "null", "string16"}) {
+    auto *argList = ArgumentList::make(&pool);
+    argList->addArgument(InputPropertyExpression::make(&pool, arg));
+    checkParity(FunctionCallExpression::make(&pool, "round", argList));
+  }
+  {
+    auto *argList = ArgumentList::make(&pool);
+    argList->addArgument(InputPropertyExpression::make(&pool, "float"));
+    argList->addArgument(ConstantExpression::make(&pool, 2));
+    EXPECT_EQ(ExprBytecode::compile(FunctionCallExpression::make(&pool, "round", argList)),
+              nullptr);
+  }
+  // coalesce takes the first non null operand and leaves null when there is none
+  {
+    auto *argList = ArgumentList::make(&pool);
+    argList->addArgument(InputPropertyExpression::make(&pool, "null"));
+    argList->addArgument(InputPropertyExpression::make(&pool, "int"));
+    argList->addArgument(InputPropertyExpression::make(&pool, "float"));
+    checkParity(FunctionCallExpression::make(&pool, "coalesce", argList));
+  }
+  {
+    auto *argList = ArgumentList::make(&pool);
+    argList->addArgument(InputPropertyExpression::make(&pool, "null"));
+    argList->addArgument(InputPropertyExpression::make(&pool, "null"));
+    checkParity(FunctionCallExpression::make(&pool, "coalesce", argList));
+  }
+}
+
+TEST_F(ExprBytecodeTest, UnsupportedFallsBack) {
+  // Anything outside the compiled subset must return nullptr so the caller keeps the
+  // interpreter
+  auto argList = ArgumentList::make(&pool);
+  argList->addArgument(ConstantExpression::make(&pool, 123));
+  EXPECT_EQ(ExprBytecode::compile(FunctionCallExpression::make(&pool, "rand32", argList)),
+            nullptr);
+  EXPECT_EQ(ExprBytecode::compile(
+                LogicalExpression::makeXor(&pool,
+                                           ConstantExpression::make(&pool, true),
+                                           ConstantExpression::make(&pool, false))),
+            nullptr);
+  EXPECT_EQ(ExprBytecode::compile(VariableExpression::make(&pool, "var_int")), nullptr);
+  EXPECT_EQ(ExprBytecode::compile(InputPropertyExpression::make(&pool, "*")), nullptr);
+  // An unsupported node anywhere in the tree poisons the whole program
+  EXPECT_EQ(ExprBytecode::compile(UnaryExpression::makeNot(
+                &pool,
+                LogicalExpression::makeXor(&pool,
+                                           ConstantExpression::make(&pool, true),
+                                           ConstantExpression::make(&pool, false)))),
+            nullptr);
+}
+
+}  // namespace nebula
@@ -73,7 +73,7 @@ class ExpressionContextMock final : public ExpressionContext {
     return found->second;
   }
 
-  Value getEdgeProp(const std::string& edgeType, const std::string& prop) const override {
+  const Value& getEdgeProp(const std::string& edgeType, const std::string& prop) const override {
     UNUSED(edgeType);
     auto found = indices_.find(prop);
     if (found == indices_.end()) {
@@ -83,7 +83,7 @@ class ExpressionContextMock final : public ExpressionContext {
     }
   }
 
-  Value getTagProp(const std::string& tag, const std::string& prop) const override {
+  const Value& getTagProp(const std::string& tag, const std::string& prop) const override {
     UNUSED(tag);
     auto found = indices_.find(prop);
     if (found == indices_.end()) {
@@ -93,7 +93,7 @@ class ExpressionContextMock final : public ExpressionContext {
     }
   }
 
-  Value getSrcProp(const std::string& tag, const std::string& prop) const override {
+  const Value& getSrcProp(const std::string& tag, const std::string& prop) const override {
     UNUSED(tag);
     auto found = indices_.find(prop);
     if (found == indices_.end()) {
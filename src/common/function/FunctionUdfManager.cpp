@@ -7,10 +7,13 @@
 
 #include <dirent.h>
 #include <dlfcn.h>
+#include <sys/stat.h>
 
 #include <cstring>
 #include <iostream>
 
+#include "common/stats/StatsManager.h"
+#include "common/time/Duration.h"
 #include "graph/service/GraphFlags.h"
 
 DEFINE_string(udf_path, "lib/udf", "path to hold the udf");
@@ -23,6 +26,17 @@ static std::unordered_map<std::string, std::vector<std::vector<nebula::Value::Ty
     udfFunInputType_;
 std::unordered_map<std::string, FunctionManager::FunctionAttributes> udfFunctions_;
 
+// Guards the loaded-so and counter maps below; taken briefly to look a UDF up, never
+// held across a UDF call
+static std::mutex udfLock_;
+// so path -> loaded library, so one .so defining several functions is dlopened once
+static std::unordered_map<std::string, std::shared_ptr<FunctionUdfManager::LoadedUdf>> loadedSos_;
+// function name -> the library currently serving it; replaced atomically on reload
+static std::unordered_map<std::string, std::shared_ptr<FunctionUdfManager::LoadedUdf>> udfByName_;
+// function name -> (rows counter, call latency histogram)
+static std::unordered_map<std::string, std::pair<stats::CounterId, stats::HdrHistogram *>>
+    udfCounters_;
+
 std::atomic<bool> expired_{};
 std::atomic<bool> try_to_expire_{};
 std::mutex mutex_;
@@ -52,6 +66,19 @@ std::vector<std::string> getFilesList(const std::string &path, const char *ftype
   return filenames;
 }
 
+FunctionUdfManager::LoadedUdf::~LoadedUdf() {
+  if (handle != nullptr) {
+    dlclose(handle);
+  }
+}
+
+std::shared_ptr<FunctionUdfManager::LoadedUdf> FunctionUdfManager::findLoadedUdf(
+    const std::string &funcName) {
+  std::lock_guard<std::mutex> guard(udfLock_);
+  auto iter = udfByName_.find(funcName);
+  return iter == udfByName_.end() ? nullptr : iter->second;
+}
+
 FunctionUdfManager::create_f *FunctionUdfManager::getGraphFunctionClass(void *func_handle) {
   auto *create_func = reinterpret_cast<create_f *>(dlsym(func_handle, "create"));
   dlsym_error = dlerror();
@@ -98,9 +125,26 @@ void FunctionUdfManager::initAndLoadSoFunction() {
     std::string so_path_string = path + file;
     const char *soPath = so_path_string.c_str();
     try {
+      struct stat soStat;
+      if (stat(soPath, &soStat) != 0) {
+        LOG(ERROR) << "Cannot stat udf library: " << soPath;
+        continue;
+      }
+      {
+        // Unchanged since the last scan, the cached handle keeps serving it. A changed
+        // mtime means the file was replaced, so the dlopen below maps the new code while
+        // in-flight calls keep the old library alive through their shared_ptr
+        std::lock_guard<std::mutex> guard(udfLock_);
+        auto iter = loadedSos_.find(so_path_string);
+        if (iter != loadedSos_.end() && iter->second->mtime == soStat.st_mtime) {
+          continue;
+        }
+      }
+
       void *func_handle = dlopen(soPath, RTLD_LAZY);
       if (!func_handle) {
         LOG(ERROR) << "Cannot load udf library: " << dlerror();
+        continue;
       }
       dlerror();
 
@@ -108,17 +152,28 @@ void FunctionUdfManager::initAndLoadSoFunction() {
       destroy_f *destroy_func = deleteGraphFunctionClass(func_handle);
       if (create_func == nullptr || destroy_func == nullptr) {
         LOG(ERROR) << "GraphFunction Create Or Destroy Error: " << soPath;
-        break;
+        dlclose(func_handle);
+        continue;
       }
 
+      auto loaded = std::make_shared<LoadedUdf>();
+      loaded->handle = func_handle;
+      loaded->create = create_func;
+      loaded->destroy = destroy_func;
+      loaded->mtime = soStat.st_mtime;
+
       GraphFunction *gf = create_func();
       char *funName = gf->name();
-      udfFunInputType_.emplace(funName, gf->inputType());
-      udfFunReturnType_.emplace(funName, gf->returnType());
+      udfFunInputType_[funName] = gf->inputType();
+      udfFunReturnType_[funName] = gf->returnType();
+      {
+        std::lock_guard<std::mutex> guard(udfLock_);
+        loadedSos_[so_path_string] = loaded;
+        udfByName_[funName] = loaded;
+      }
       addSoUdfFunction(funName, soPath, gf->minArity(), gf->maxArity(), gf->isPure());
 
       destroy_func(gf);
-      dlclose(func_handle);
     } catch (...) {
       LOG(ERROR) << "load So library Error: " << soPath;
     }
@@ -173,27 +228,38 @@ StatusOr<const FunctionManager::FunctionAttributes> nebula::FunctionUdfManager::
 
 void FunctionUdfManager::addSoUdfFunction(
     char *funName, const char *soPath, size_t minArity, size_t maxArity, bool isPure) {
+  UNUSED(soPath);
+  std::string name = funName;
+  stats::CounterId rowsId;
+  stats::HdrHistogram *latency = nullptr;
+  {
+    std::lock_guard<std::mutex> guard(udfLock_);
+    auto iter = udfCounters_.find(name);
+    if (iter == udfCounters_.end()) {
+      rowsId = stats::StatsManager::registerStats("udf_" + name + "_rows", "rate, sum");
+      latency = stats::StatsManager::registerHdrHisto("udf_" + name + "_latency_us", 32, 10000000);
+      udfCounters_.emplace(name, std::make_pair(rowsId, latency));
+    } else {
+      rowsId = iter->second.first;
+      latency = iter->second.second;
+    }
+  }
   auto &attr = udfFunctions_[funName];
   attr.minArity_ = minArity;
   attr.maxArity_ = maxArity;
   attr.isAlwaysPure_ = isPure;
-  std::string path = soPath;
-  attr.body_ = [path](const auto &args) -> Value {
+  attr.body_ = [name, rowsId, latency](const auto &args) -> Value {
+    auto loaded = findLoadedUdf(name);
+    if (loaded == nullptr) {
+      return Value::kNullBadData;
+    }
     try {
-      char *soPath2 = const_cast<char *>(path.c_str());
-      void *func_handle = dlopen(soPath2, RTLD_LAZY);
-      if (!func_handle) {
-        LOG(ERROR) << "Cannot load udf library: " << dlerror();
-      }
-      dlerror();
-
-      create_f *create_func = getGraphFunctionClass(func_handle);
-      destroy_f *destroy_func = deleteGraphFunctionClass(func_handle);
-
-      GraphFunction *gf = create_func();
+      time::Duration timer;
+      GraphFunction *gf = loaded->create();
       Value res = gf->body(args);
-      destroy_func(gf);
-      dlclose(func_handle);
+      loaded->destroy(gf);
+      stats::StatsManager::addValue(rowsId);
+      latency->record(static_cast<int64_t>(timer.elapsedInUSec()));
       return res;
     } catch (...) {
       return Value::kNullBadData;
@@ -201,4 +267,34 @@ void FunctionUdfManager::addSoUdfFunction(
   };
 }
 
+StatusOr<std::vector<Value>> FunctionUdfManager::evalUdfBatch(
+    const std::string &functionName, const std::vector<const std::vector<Value> *> &columns) {
+  auto loaded = findLoadedUdf(functionName);
+  if (loaded == nullptr) {
+    return Status::Error("Function `%s' not defined", functionName.c_str());
+  }
+  size_t numRows = columns.empty() ? 0 : columns[0]->size();
+  for (const auto *column : columns) {
+    if (column->size() != numRows) {
+      return Status::Error("Function `%s': argument columns differ in length",
+                           functionName.c_str());
+    }
+  }
+  try {
+    time::Duration timer;
+    GraphFunction *gf = loaded->create();
+    std::vector<Value> results = gf->batchBody(columns);
+    loaded->destroy(gf);
+    std::lock_guard<std::mutex> guard(udfLock_);
+    auto iter = udfCounters_.find(functionName);
+    if (iter != udfCounters_.end()) {
+      stats::StatsManager::addValue(iter->second.first, static_cast<int64_t>(results.size()));
+      iter->second.second->record(static_cast<int64_t>(timer.elapsedInUSec()));
+    }
+    return results;
+  } catch (...) {
+    return Status::Error("Function `%s' threw during batch evaluation", functionName.c_str());
+  }
+}
+
 }  // namespace nebula
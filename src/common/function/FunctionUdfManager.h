@@ -24,14 +24,34 @@ class FunctionUdfManager {
   static StatusOr<const FunctionManager::FunctionAttributes> loadUdfFunction(
       std::string functionName, size_t arity);
 
+  /**
+   * Batch-evaluate a UDF over whole argument columns, one result per row. Goes through
+   * GraphFunction::batchBody, so UDFs that override it pay the dispatch cost once per
+   * batch instead of once per row.
+   */
+  static StatusOr<std::vector<Value>> evalUdfBatch(
+      const std::string &functionName, const std::vector<const std::vector<Value> *> &columns);
+
   static FunctionUdfManager &instance();
 
   FunctionUdfManager();
 
+  // One dlopened .so shared by every in-flight call; the destructor closes the handle
+  // when the last caller drops its reference, so a reload never unmaps running code
+  struct LoadedUdf {
+    void *handle{nullptr};
+    create_f *create{nullptr};
+    destroy_f *destroy{nullptr};
+    time_t mtime{0};
+    ~LoadedUdf();
+  };
+
  private:
   static create_f *getGraphFunctionClass(void *func_handle);
   static destroy_f *deleteGraphFunctionClass(void *func_handle);
 
+  static std::shared_ptr<LoadedUdf> findLoadedUdf(const std::string &funcName);
+
   void addSoUdfFunction(char *funName, const char *soPath, size_t i, size_t i1, bool b);
   void initAndLoadSoFunction();
 };
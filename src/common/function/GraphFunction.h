@@ -6,6 +6,7 @@
 #ifndef COMMON_FUNCTION_GRAPHFUNCTION_H
 #define COMMON_FUNCTION_GRAPHFUNCTION_H
 
+#include <functional>
 #include <vector>
 
 #include "common/datatypes/Value.h"
@@ -33,6 +34,31 @@ class GraphFunction {
 
   virtual nebula::Value body(
       const std::vector<std::reference_wrapper<const nebula::Value>> &args) = 0;
+
+  // Optional batch entry point: columns[c] points at the c-th argument column and every
+  // column holds one value per row. The default runs body() row by row; functions called
+  // over very large results can override it to amortize per-call setup across the batch.
+  // Note this extends the UDF ABI, .so files built against the older header have to be
+  // rebuilt to stay loadable.
+  virtual std::vector<nebula::Value> batchBody(
+      const std::vector<const std::vector<nebula::Value> *> &columns) {
+    std::vector<nebula::Value> results;
+    if (columns.empty() || columns[0]->empty()) {
+      return results;
+    }
+    size_t numRows = columns[0]->size();
+    results.reserve(numRows);
+    std::vector<std::reference_wrapper<const nebula::Value>> args;
+    args.reserve(columns.size());
+    for (size_t row = 0; row < numRows; ++row) {
+      args.clear();
+      for (const auto *column : columns) {
+        args.emplace_back(std::cref((*column)[row]));
+      }
+      results.emplace_back(body(args));
+    }
+    return results;
+  }
 };
 
 #endif  // COMMON_FUNCTION_GRAPHFUNCTION_H
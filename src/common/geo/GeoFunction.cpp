@@ -179,6 +179,85 @@ bool GeoFunction::coveredBy(const Geography& a, const Geography& b) {
   return covers(b, a);
 }
 
+std::vector<bool> GeoFunction::batchIntersects(const Geography& a,
+                                               const std::vector<Geography>& bs) {
+  std::vector<bool> result(bs.size(), false);
+  auto aRegion = a.asS2();
+  if (UNLIKELY(!aRegion)) {
+    return result;
+  }
+
+  for (size_t i = 0; i < bs.size(); ++i) {
+    const auto& b = bs[i];
+    if (b.shape() != GeoShape::POINT) {
+      result[i] = intersects(a, b);
+      continue;
+    }
+    auto bRegion = b.asS2();
+    if (UNLIKELY(!bRegion)) {
+      continue;
+    }
+    S2Cell bCell(static_cast<S2PointRegion*>(bRegion.get())->point());
+    switch (a.shape()) {
+      case GeoShape::POINT:
+        result[i] = static_cast<S2PointRegion*>(aRegion.get())->MayIntersect(bCell);
+        break;
+      case GeoShape::LINESTRING:
+        result[i] = static_cast<S2Polyline*>(aRegion.get())->MayIntersect(bCell);
+        break;
+      case GeoShape::POLYGON:
+        result[i] = static_cast<S2Polygon*>(aRegion.get())->MayIntersect(bCell);
+        break;
+      case GeoShape::UNKNOWN:
+      default: {
+        LOG(ERROR)
+            << "Geography shapes other than Point/LineString/Polygon are not currently supported";
+        break;
+      }
+    }
+  }
+  return result;
+}
+
+std::vector<bool> GeoFunction::batchCovers(const Geography& a, const std::vector<Geography>& bs) {
+  std::vector<bool> result(bs.size(), false);
+  auto aRegion = a.asS2();
+  if (UNLIKELY(!aRegion)) {
+    return result;
+  }
+
+  for (size_t i = 0; i < bs.size(); ++i) {
+    const auto& b = bs[i];
+    if (b.shape() != GeoShape::POINT) {
+      result[i] = covers(a, b);
+      continue;
+    }
+    auto bRegion = b.asS2();
+    if (UNLIKELY(!bRegion)) {
+      continue;
+    }
+    const S2Point& bPoint = static_cast<S2PointRegion*>(bRegion.get())->point();
+    switch (a.shape()) {
+      case GeoShape::POINT:
+        result[i] = static_cast<S2PointRegion*>(aRegion.get())->Contains(bPoint);
+        break;
+      case GeoShape::LINESTRING:
+        result[i] = static_cast<S2Polyline*>(aRegion.get())->MayIntersect(S2Cell(bPoint));
+        break;
+      case GeoShape::POLYGON:
+        result[i] = static_cast<S2Polygon*>(aRegion.get())->Contains(bPoint);
+        break;
+      case GeoShape::UNKNOWN:
+      default: {
+        LOG(ERROR)
+            << "Geography shapes other than Point/LineString/Polygon are not currently supported";
+        break;
+      }
+    }
+  }
+  return result;
+}
+
 bool GeoFunction::dWithin(const Geography& a, const Geography& b, double distance, bool exclusive) {
   auto aRegion = a.asS2();
   auto bRegion = b.asS2();
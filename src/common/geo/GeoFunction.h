@@ -26,6 +26,13 @@ class GeoFunction {
   static bool covers(const Geography& a, const Geography& b);
   static bool coveredBy(const Geography& a, const Geography& b);
 
+  // Batch variants of intersects/covers. The S2 region of a is built once per call and every
+  // geography in bs is tested against it, instead of re-decoding a from its serialized form for
+  // each pair. Geographies in bs other than Point fall back to the pairwise check. The returned
+  // vector is aligned with bs.
+  static std::vector<bool> batchIntersects(const Geography& a, const std::vector<Geography>& bs);
+  static std::vector<bool> batchCovers(const Geography& a, const std::vector<Geography>& bs);
+
   // Returns true if any of a is within distance meters of b.
   // We don't need to find the closest points. We just need to find the first point pair whose
   // distance is less than or less equal than the given distance. (Early quit)
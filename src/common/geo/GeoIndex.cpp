@@ -23,13 +23,52 @@
 
 #include <cstdint>
 
+#include "common/base/ConcurrentLRUCache.h"
 #include "common/datatypes/Geography.h"
 #include "common/utils/IndexKeyUtils.h"
 #include "interface/gen-cpp2/storage_types.h"
 
+DEFINE_uint64(geo_scan_range_cache_capacity,
+              1024,
+              "Max number of cached scan range sets for geo index queries, keyed by the query "
+              "geography and the cover params. 0 disables the cache. Workloads probing the same "
+              "polygons continuously skip the S2 cell cover computation on a hit");
+
 namespace nebula {
 namespace geo {
 
+namespace {
+
+using ScanRangeCache = ConcurrentLRUCache<std::string, std::vector<ScanRange>>;
+
+ScanRangeCache* scanRangeCache() {
+  static std::unique_ptr<ScanRangeCache> cache =
+      FLAGS_geo_scan_range_cache_capacity > 0
+          ? std::make_unique<ScanRangeCache>(FLAGS_geo_scan_range_cache_capacity)
+          : nullptr;
+  return cache.get();
+}
+
+// The covering is a pure function of the geography bytes, the cover params and the predicate,
+// so the key carries all of them and a hit can never be stale
+std::string scanRangeCacheKey(char predicate,
+                              const RegionCoverParams& params,
+                              bool pointsOnly,
+                              const Geography& g,
+                              double distance = 0.0) {
+  auto key = folly::stringPrintf("%c:%d:%d:%d:%d:%.17g:",
+                                 predicate,
+                                 params.minCellLevel_,
+                                 params.maxCellLevel_,
+                                 params.maxCellNum_,
+                                 pointsOnly,
+                                 distance);
+  key += g.asWKB();
+  return key;
+}
+
+}  // namespace
+
 bool ScanRange::operator==(const ScanRange& rhs) const {
   if (isRangeScan != rhs.isRangeScan) {
     return false;
@@ -73,12 +112,26 @@ std::vector<uint64_t> GeoIndex::indexCells(const Geography& g) const {
 }
 
 std::vector<ScanRange> GeoIndex::intersects(const Geography& g) const {
+  auto* cache = scanRangeCache();
+  std::string key;
+  if (cache != nullptr) {
+    key = scanRangeCacheKey('i', rcParams_, pointsOnly_, g);
+    auto cached = cache->get(key);
+    if (cached.ok()) {
+      return std::move(cached).value();
+    }
+  }
+
   auto r = g.asS2();
   if (UNLIKELY(!r)) {
     return {};
   }
 
-  return intersects(*r, g.shape() == GeoShape::POINT);
+  auto ranges = intersects(*r, g.shape() == GeoShape::POINT);
+  if (cache != nullptr) {
+    cache->insert(std::move(key), ranges);
+  }
+  return ranges;
 }
 
 // covers degenerates to intersects currently
@@ -92,30 +145,47 @@ std::vector<ScanRange> GeoIndex::coveredBy(const Geography& g) const {
 }
 
 std::vector<ScanRange> GeoIndex::dWithin(const Geography& g, double distance) const {
+  auto* cache = scanRangeCache();
+  std::string key;
+  if (cache != nullptr) {
+    key = scanRangeCacheKey('d', rcParams_, pointsOnly_, g, distance);
+    auto cached = cache->get(key);
+    if (cached.ok()) {
+      return std::move(cached).value();
+    }
+  }
+
   auto r = g.asS2();
   if (UNLIKELY(!r)) {
     return {};
   }
 
+  auto finish = [&](std::vector<ScanRange> ranges) {
+    if (cache != nullptr) {
+      cache->insert(std::move(key), ranges);
+    }
+    return ranges;
+  };
+
   S1Angle radius = S2Earth::ToAngle(util::units::Meters(distance));
   // First expand the region, then build the covering
   switch (g.shape()) {
     case GeoShape::POINT: {
       const S2Point& gPoint = static_cast<S2PointRegion*>(r.get())->point();
       S2Cap gCap(gPoint, radius);
-      return intersects(gCap);
+      return finish(intersects(gCap));
     }
     case GeoShape::LINESTRING: {
       S2Polyline* gLine = static_cast<S2Polyline*>(r.get());
       MutableS2ShapeIndex index;
       index.Add(std::make_unique<S2Polyline::Shape>(gLine));
       S2ShapeIndexBufferedRegion gBuffer(&index, radius);
-      return intersects(gBuffer);
+      return finish(intersects(gBuffer));
     }
     case GeoShape::POLYGON: {
       S2Polygon* gPolygon = static_cast<S2Polygon*>(r.get());
       S2ShapeIndexBufferedRegion gBuffer(&gPolygon->index(), radius);
-      return intersects(gBuffer);
+      return finish(intersects(gBuffer));
     }
     default:
       DLOG(FATAL)
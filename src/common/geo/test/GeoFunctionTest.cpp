@@ -541,6 +541,70 @@ TEST(CoveredBy, basic) {
   }
 }
 
+TEST(BatchIntersects, polygon2Points) {
+  auto polygon1 =
+      Geography::fromWKT("POLYGON((0.0 0.0, 1.0 0.0, 1.0 1.0, 0.0 1.0, 0.0 0.0))").value();
+  std::vector<Geography> points;
+  points.emplace_back(Geography::fromWKT("POINT(0.5 0.5)").value());
+  points.emplace_back(Geography::fromWKT("POINT(0.5 7.7)").value());
+  points.emplace_back(Geography::fromWKT("POINT(1.0 1.0)").value());
+  auto result = GeoFunction::batchIntersects(polygon1, points);
+  ASSERT_EQ(3, result.size());
+  EXPECT_EQ(true, result[0]);
+  EXPECT_EQ(false, result[1]);
+  EXPECT_EQ(true, result[2]);
+  // The batch results should agree with the pairwise results
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(GeoFunction::intersects(polygon1, points[i]), result[i]);
+  }
+}
+
+TEST(BatchIntersects, mixedShapes) {
+  auto line1 = Geography::fromWKT("LINESTRING(1.0 1.0, 2.0 2.0)").value();
+  std::vector<Geography> bs;
+  bs.emplace_back(Geography::fromWKT("POINT(1.0 1.0)").value());
+  bs.emplace_back(Geography::fromWKT("POINT(3.0 3.0)").value());
+  // Non-point elements take the pairwise path
+  bs.emplace_back(Geography::fromWKT("LINESTRING(1.5 1.5, 1.6 1.6)").value());
+  auto result = GeoFunction::batchIntersects(line1, bs);
+  ASSERT_EQ(3, result.size());
+  EXPECT_EQ(true, result[0]);
+  EXPECT_EQ(false, result[1]);
+  EXPECT_EQ(true, result[2]);
+}
+
+TEST(BatchCovers, polygon2Points) {
+  auto polygon1 = Geography::fromWKT(
+                      "POLYGON((0.0 0.0, 1.0 0.0, 1.0 1.0, 0.0 1.0, 0.0 0.0), (0.2 0.2, 0.2 0.4, "
+                      "0.4 0.4, 0.4 0.2, 0.2 0.2))")
+                      .value();
+  std::vector<Geography> points;
+  points.emplace_back(Geography::fromWKT("POINT(0.5 0.5)").value());
+  points.emplace_back(Geography::fromWKT("POINT(0.3 0.3)").value());  // inside the hole
+  points.emplace_back(Geography::fromWKT("POINT(1.0 0.0)").value());
+  points.emplace_back(Geography::fromWKT("POINT(0.5 7.7)").value());
+  auto result = GeoFunction::batchCovers(polygon1, points);
+  ASSERT_EQ(4, result.size());
+  EXPECT_EQ(true, result[0]);
+  EXPECT_EQ(false, result[1]);
+  EXPECT_EQ(true, result[2]);
+  EXPECT_EQ(false, result[3]);
+  for (size_t i = 0; i < points.size(); ++i) {
+    EXPECT_EQ(GeoFunction::covers(polygon1, points[i]), result[i]);
+  }
+}
+
+TEST(BatchCovers, point2Points) {
+  auto point1 = Geography::fromWKT("POINT(1.0 1.0)").value();
+  std::vector<Geography> points;
+  points.emplace_back(Geography::fromWKT("POINT(1.0 1.0)").value());
+  points.emplace_back(Geography::fromWKT("POINT(1.0 1.2)").value());
+  auto result = GeoFunction::batchCovers(point1, points);
+  ASSERT_EQ(2, result.size());
+  EXPECT_EQ(true, result[0]);
+  EXPECT_EQ(false, result[1]);
+}
+
 TEST(DWithin, point2Point) {
   {
     auto point1 = Geography::fromWKT("POINT(1.0 1.0)").value();
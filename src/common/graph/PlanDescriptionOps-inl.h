@@ -42,6 +42,9 @@ struct TccStructTraits<::nebula::PlanDescription> {
     } else if (_fname == "optimize_time_in_us") {
       fid = 4;
       _ftype = apache::thrift::protocol::T_I32;
+    } else if (_fname == "validate_time_in_us") {
+      fid = 5;
+      _ftype = apache::thrift::protocol::T_I32;
     }
   }
 };
@@ -76,6 +79,11 @@ uint32_t Cpp2Ops<::nebula::PlanDescription>::write(Protocol* proto,
                                                          int32_t>::write(*proto,
                                                                          obj->optimize_time_in_us);
   xfer += proto->writeFieldEnd();
+  xfer += proto->writeFieldBegin("validate_time_in_us", apache::thrift::protocol::T_I32, 5);
+  xfer += ::apache::thrift::detail::pm::protocol_methods<::apache::thrift::type_class::integral,
+                                                         int32_t>::write(*proto,
+                                                                         obj->validate_time_in_us);
+  xfer += proto->writeFieldEnd();
   xfer += proto->writeFieldStop();
   xfer += proto->writeStructEnd();
   return xfer;
@@ -134,7 +142,15 @@ _readField_optimize_in_us : {
   isset_optimize_time_in_us = true;
 }
 
-  if (UNLIKELY(!_readState.advanceToNextField(proto, 4, 0, apache::thrift::protocol::T_STOP))) {
+  if (UNLIKELY(!_readState.advanceToNextField(proto, 4, 5, apache::thrift::protocol::T_I32))) {
+    goto _loop;
+  }
+_readField_validate_time_in_us : {
+  ::apache::thrift::detail::pm::protocol_methods<::apache::thrift::type_class::integral,
+                                                 int32_t>::read(*proto, obj->validate_time_in_us);
+}
+
+  if (UNLIKELY(!_readState.advanceToNextField(proto, 5, 0, apache::thrift::protocol::T_STOP))) {
     goto _loop;
   }
 
@@ -193,6 +209,13 @@ _loop:
         goto _skip;
       }
     }
+    case 5: {
+      if (LIKELY(_readState.fieldType == apache::thrift::protocol::T_I32)) {
+        goto _readField_validate_time_in_us;
+      } else {
+        goto _skip;
+      }
+    }
     default: {
 _skip:
       proto->skip(_readState.fieldType);
@@ -224,6 +247,10 @@ uint32_t Cpp2Ops<::nebula::PlanDescription>::serializedSize(Protocol const* prot
   xfer += ::apache::thrift::detail::pm::
       protocol_methods<::apache::thrift::type_class::integral, int32_t>::serializedSize<false>(
           *proto, obj->optimize_time_in_us);
+  xfer += proto->serializedFieldSize("validate_time_in_us", apache::thrift::protocol::T_I32, 5);
+  xfer += ::apache::thrift::detail::pm::
+      protocol_methods<::apache::thrift::type_class::integral, int32_t>::serializedSize<false>(
+          *proto, obj->validate_time_in_us);
   xfer += proto->serializedSizeStop();
   return xfer;
 }
@@ -249,6 +276,10 @@ uint32_t Cpp2Ops<::nebula::PlanDescription>::serializedSizeZC(
   xfer += ::apache::thrift::detail::pm::
       protocol_methods<::apache::thrift::type_class::integral, int32_t>::serializedSize<false>(
           *proto, obj->optimize_time_in_us);
+  xfer += proto->serializedFieldSize("validate_time_in_us", apache::thrift::protocol::T_I32, 5);
+  xfer += ::apache::thrift::detail::pm::
+      protocol_methods<::apache::thrift::type_class::integral, int32_t>::serializedSize<false>(
+          *proto, obj->validate_time_in_us);
   xfer += proto->serializedSizeStop();
   return xfer;
 }
@@ -431,6 +431,7 @@ struct PlanDescription {
     nodeIndexMap.clear();
     format.clear();
     optimize_time_in_us = 0;
+    validate_time_in_us = 0;
   }
 
   void clear() {
@@ -449,6 +450,8 @@ struct PlanDescription {
   std::string format;
   // the optimization spent time
   int32_t optimize_time_in_us{0};
+  // the validation spent time
+  int32_t validate_time_in_us{0};
 
   folly::dynamic toJson() const {
     folly::dynamic PlanDescObj = folly::dynamic::object();
@@ -469,6 +472,7 @@ struct PlanDescription {
     PlanDescObj.insert("nodeIndexMap", nodeIndexMapObj);
     PlanDescObj.insert("format", format);
     PlanDescObj.insert("optimize_time_in_us", optimize_time_in_us);
+    PlanDescObj.insert("validate_time_in_us", validate_time_in_us);
 
     return PlanDescObj;
   }
@@ -483,6 +487,7 @@ struct ExecutionResponse {
     errorMsg.reset();
     planDesc.reset();
     comment.reset();
+    cursor.reset();
   }
 
   void clear() {
@@ -511,6 +516,9 @@ struct ExecutionResponse {
     if (!checkPointer(comment.get(), rhs.comment.get())) {
       return false;
     }
+    if (!checkPointer(cursor.get(), rhs.cursor.get())) {
+      return false;
+    }
     return true;
   }
 
@@ -521,6 +529,9 @@ struct ExecutionResponse {
   std::unique_ptr<std::string> errorMsg{nullptr};
   std::unique_ptr<PlanDescription> planDesc{nullptr};
   std::unique_ptr<std::string> comment{nullptr};
+  // Id of the server-side cursor holding the rest of a paged result, unset when the
+  // response carries the whole result
+  std::unique_ptr<int64_t> cursor{nullptr};
 
   // Returns the response as a JSON string
   // only errorCode and latencyInUs are required fields, the rest are optional
@@ -610,6 +621,9 @@ struct ExecutionResponse {
     if (comment) {
       resultBody.insert("comment", *comment);
     }
+    if (cursor) {
+      resultBody.insert("cursor", *cursor);
+    }
 
     auto resultArray = folly::dynamic::array();
     resultArray.push_back(resultBody);
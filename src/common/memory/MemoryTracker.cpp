@@ -9,7 +9,14 @@ namespace memory {
 
 thread_local ThreadMemoryStats MemoryStats::threadMemoryStats_;
 
-ThreadMemoryStats::ThreadMemoryStats() : reserved(0) {}
+namespace {
+std::atomic<size_t> nextStripe{0};
+}  // namespace
+
+ThreadMemoryStats::ThreadMemoryStats()
+    : reserved(0),
+      stripeIdx(nextStripe.fetch_add(1, std::memory_order_relaxed) %
+                MemoryStats::kNumUsedStripes_) {}
 
 ThreadMemoryStats::~ThreadMemoryStats() {
   // Return to global any reserved bytes on destruction
@@ -33,6 +40,10 @@ void MemoryTracker::realloc(int64_t old_size, int64_t new_size) {
   addition > 0 ? alloc(addition) : free(-addition);
 }
 
+void MemoryTracker::reserve(int64_t size) {
+  MemoryStats::instance().reserve(size);
+}
+
 void MemoryTracker::free(int64_t size) {
   MemoryStats::instance().free(size);
 }
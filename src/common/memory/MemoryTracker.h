@@ -35,6 +35,16 @@ constexpr size_t
     CACHE_LINE_SIZE = 64;
 #endif
 
+// A quota scope memory refills of the current thread are charged against, e.g. one query or
+// one session. Accounting happens on the slow path only, so the counter moves in
+// kLocalReservedLimit_ sized steps and a scope may be over-charged by one reserve per thread.
+struct MemoryScope {
+  // counter shared by all threads working for the same scope, must outlive the scope
+  std::atomic<int64_t>* used{nullptr};
+  // maximum bytes the scope may hold, 0 means counting only
+  int64_t limit{0};
+};
+
 // Memory stats for each thread.
 struct ThreadMemoryStats {
   ThreadMemoryStats();
@@ -42,7 +52,14 @@ struct ThreadMemoryStats {
 
   // reserved bytes size in current thread
   int64_t reserved;
+  // monotonic sum of bytes this thread informed through alloc(), for profiling
+  int64_t allocatedBytes{0};
+  // which global counter stripe this thread charges, assigned round-robin at thread start
+  size_t stripeIdx;
   bool throwOnMemoryExceeded{false};
+  // scopes of the work currently running on this thread, installed by MemoryScopeGuard
+  MemoryScope queryScope;
+  MemoryScope sessionScope;
 };
 
 /**
@@ -65,6 +82,7 @@ class MemoryStats {
 
   /// Inform size of memory allocation
   inline ALWAYS_INLINE void alloc(int64_t size, bool throw_if_memory_exceeded) {
+    threadMemoryStats_.allocatedBytes += size;
     int64_t willBe = threadMemoryStats_.reserved - size;
 
     if (UNLIKELY(willBe < 0)) {
@@ -94,11 +112,24 @@ class MemoryStats {
     }
   }
 
+  /// Reserve `size' bytes into the current thread's local quota in one global trip, so a batch
+  /// of allocations of known total size charges the global counter once instead of every
+  /// kLocalReservedLimit_ bytes. Excess reservation drains back through free().
+  inline ALWAYS_INLINE void reserve(int64_t size) {
+    int64_t need = size - threadMemoryStats_.reserved;
+    if (need > 0) {
+      allocGlobal(need, true);
+      threadMemoryStats_.reserved += need;
+    }
+  }
+
   /// Free global memory, two user case may call this function:
   /// 1. free()
   /// 2. destruction of ThreadMemoryStats return reserved memory
   inline ALWAYS_INLINE void freeGlobal(int64_t bytes) {
-    used_.fetch_sub(bytes, std::memory_order_relaxed);
+    used_[threadMemoryStats_.stripeIdx].value.fetch_sub(bytes, std::memory_order_relaxed);
+    creditScope(threadMemoryStats_.queryScope, bytes);
+    creditScope(threadMemoryStats_.sessionScope, bytes);
   }
 
   /// Set limit (maximum usable bytes) of memory
@@ -113,7 +144,7 @@ class MemoryStats {
   /// update limit (maximum usable bytes) of memory
   /// limit will be set to "used memory + available"
   void updateLimit(int64_t available) {
-    int64_t newLimit = used_ + available;
+    int64_t newLimit = used() + available;
     setLimit(newLimit);
   }
 
@@ -122,18 +153,23 @@ class MemoryStats {
     return this->limit_;
   }
 
-  /// Get current used bytes of memory
+  /// Get current used bytes of memory, sums all counter stripes. A stripe may be transiently
+  /// negative when one thread frees what another allocated, the sum stays correct.
   int64_t used() {
-    return used_;
+    int64_t total = 0;
+    for (auto& stripe : used_) {
+      total += stripe.value.load(std::memory_order_relaxed);
+    }
+    return total;
   }
 
   /// Calculate used ratio of memory
   double usedRatio() {
-    return used_ / static_cast<double>(limit_);
+    return used() / static_cast<double>(limit_);
   }
 
   std::string toString() {
-    return fmt::format("MemoryStats: {}/{}", ReadableSize(limit_), ReadableSize(used_));
+    return fmt::format("MemoryStats: {}/{}", ReadableSize(limit_), ReadableSize(used()));
   }
 
   // turn on current thread's throwOnMemoryExceeded
@@ -155,21 +191,72 @@ class MemoryStats {
     return threadMemoryStats_.throwOnMemoryExceeded = value;
   }
 
+  // monotonic sum of bytes the current thread has allocated, deltas of it give the
+  // allocation volume of a code section on this thread
+  static int64_t threadAllocatedBytes() {
+    return threadMemoryStats_.allocatedBytes;
+  }
+
+  // swap current thread's query scope, returns the previous one
+  static MemoryScope swapQueryScope(MemoryScope scope) {
+    std::swap(threadMemoryStats_.queryScope, scope);
+    return scope;
+  }
+
+  // swap current thread's session scope, returns the previous one
+  static MemoryScope swapSessionScope(MemoryScope scope) {
+    std::swap(threadMemoryStats_.sessionScope, scope);
+    return scope;
+  }
+
+  // Number of stripes the global used counter is split into, threads are spread over the
+  // stripes round-robin so concurrent refills of the thread reserve don't contend on one line
+  static constexpr size_t kNumUsedStripes_ = 64;
+
  private:
   inline ALWAYS_INLINE void allocGlobal(int64_t size, bool throw_if_memory_exceeded) {
-    int64_t willBe = size + used_.fetch_add(size, std::memory_order_relaxed);
-    if (threadMemoryStats_.throwOnMemoryExceeded && throw_if_memory_exceeded && willBe > limit_) {
+    auto& stripe = used_[threadMemoryStats_.stripeIdx].value;
+    stripe.fetch_add(size, std::memory_order_relaxed);
+    chargeScope(threadMemoryStats_.queryScope, size);
+    chargeScope(threadMemoryStats_.sessionScope, size);
+    if (threadMemoryStats_.throwOnMemoryExceeded && throw_if_memory_exceeded &&
+        (used() > limit_ || scopeExceeded(threadMemoryStats_.queryScope) ||
+         scopeExceeded(threadMemoryStats_.sessionScope))) {
       // revert
-      used_.fetch_sub(size, std::memory_order_relaxed);
+      stripe.fetch_sub(size, std::memory_order_relaxed);
+      creditScope(threadMemoryStats_.queryScope, size);
+      creditScope(threadMemoryStats_.sessionScope, size);
       threadMemoryStats_.throwOnMemoryExceeded = false;
       throw std::bad_alloc();
     }
   }
 
+  static inline ALWAYS_INLINE void chargeScope(const MemoryScope& scope, int64_t bytes) {
+    if (scope.used != nullptr) {
+      scope.used->fetch_add(bytes, std::memory_order_relaxed);
+    }
+  }
+
+  static inline ALWAYS_INLINE void creditScope(const MemoryScope& scope, int64_t bytes) {
+    if (scope.used != nullptr) {
+      scope.used->fetch_sub(bytes, std::memory_order_relaxed);
+    }
+  }
+
+  static inline ALWAYS_INLINE bool scopeExceeded(const MemoryScope& scope) {
+    return scope.used != nullptr && scope.limit > 0 &&
+           scope.used->load(std::memory_order_relaxed) > scope.limit;
+  }
+
  private:
+  // One slot of the striped used counter, padded to a cache line of its own
+  struct alignas(CACHE_LINE_SIZE) UsedStripe {
+    std::atomic<int64_t> value{0};
+  };
+
   // Global
   alignas(CACHE_LINE_SIZE) int64_t limit_{std::numeric_limits<int64_t>::max()};
-  std::atomic<int64_t> used_{0};
+  UsedStripe used_[kNumUsedStripes_];
   // Thread Local
   static thread_local ThreadMemoryStats threadMemoryStats_;
   // Each thread reserves this amount of memory
@@ -189,6 +276,24 @@ struct MemoryCheckGuard {
   }
 };
 
+// A guard to charge the current thread's tracker refills against a query and a session scope
+// during its lifetime. When a scope with a limit runs over, the next tracked allocation under
+// a MemoryCheckGuard throws std::bad_alloc, just like hitting the process-wide limit. Only
+// covers allocations on the installing thread, async continuations run unscoped.
+struct MemoryScopeGuard {
+  MemoryScope prevQuery;
+  MemoryScope prevSession;
+  MemoryScopeGuard(MemoryScope query, MemoryScope session) {
+    prevQuery = MemoryStats::swapQueryScope(query);
+    prevSession = MemoryStats::swapSessionScope(session);
+  }
+
+  ~MemoryScopeGuard() {
+    MemoryStats::swapQueryScope(prevQuery);
+    MemoryStats::swapSessionScope(prevSession);
+  }
+};
+
 struct MemoryCheckOffGuard {
   bool previous;
   MemoryCheckOffGuard() {
@@ -211,6 +316,10 @@ struct MemoryTracker {
   static void allocNoThrow(int64_t size);
   static void realloc(int64_t old_size, int64_t new_size);
 
+  /// Top up the current thread's reserve to `size' bytes in one global trip, for callers that
+  /// know the total size of an upcoming batch of allocations.
+  static void reserve(int64_t size);
+
   /// This function should be called after memory deallocation.
   static void free(int64_t size);
 
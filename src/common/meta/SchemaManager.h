@@ -90,14 +90,16 @@ class SchemaManager {
 
   StatusOr<std::unordered_map<TagID, std::string>> getAllTags(GraphSpaceID space);
 
-  // get all version of all tag schema
-  virtual StatusOr<TagSchemas> getAllVerTagSchema(GraphSpaceID space) = 0;
+  // get all version of all tag schema, the returned snapshot is immutable and shared
+  // across requests, so callers must not modify it
+  virtual StatusOr<std::shared_ptr<const TagSchemas>> getAllVerTagSchema(GraphSpaceID space) = 0;
 
   // get all latest version of all tag schema
   virtual StatusOr<TagSchema> getAllLatestVerTagSchema(GraphSpaceID space) = 0;
 
-  // get all version of all edge schema
-  virtual StatusOr<EdgeSchemas> getAllVerEdgeSchema(GraphSpaceID space) = 0;
+  // get all version of all edge schema, the returned snapshot is immutable and shared
+  // across requests, so callers must not modify it
+  virtual StatusOr<std::shared_ptr<const EdgeSchemas>> getAllVerEdgeSchema(GraphSpaceID space) = 0;
 
   // get all latest version of all edge schema
   virtual StatusOr<EdgeSchema> getAllLatestVerEdgeSchema(GraphSpaceID space) = 0;
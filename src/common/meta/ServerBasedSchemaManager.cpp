@@ -127,7 +127,8 @@ StatusOr<std::vector<std::string>> ServerBasedSchemaManager::getAllEdge(GraphSpa
   return metaClient_->getAllEdgeFromCache(space);
 }
 
-StatusOr<TagSchemas> ServerBasedSchemaManager::getAllVerTagSchema(GraphSpaceID space) {
+StatusOr<std::shared_ptr<const TagSchemas>> ServerBasedSchemaManager::getAllVerTagSchema(
+    GraphSpaceID space) {
   CHECK(metaClient_);
   return metaClient_->getAllVerTagSchema(space);
 }
@@ -137,7 +138,8 @@ StatusOr<TagSchema> ServerBasedSchemaManager::getAllLatestVerTagSchema(GraphSpac
   return metaClient_->getAllLatestVerTagSchema(space);
 }
 
-StatusOr<EdgeSchemas> ServerBasedSchemaManager::getAllVerEdgeSchema(GraphSpaceID space) {
+StatusOr<std::shared_ptr<const EdgeSchemas>> ServerBasedSchemaManager::getAllVerEdgeSchema(
+    GraphSpaceID space) {
   CHECK(metaClient_);
   return metaClient_->getAllVerEdgeSchema(space);
 }
@@ -57,13 +57,13 @@ class ServerBasedSchemaManager : public SchemaManager {
   StatusOr<std::vector<std::string>> getAllEdge(GraphSpaceID space) override;
 
   // get all version of all tags
-  StatusOr<TagSchemas> getAllVerTagSchema(GraphSpaceID space) override;
+  StatusOr<std::shared_ptr<const TagSchemas>> getAllVerTagSchema(GraphSpaceID space) override;
 
   // get latest version of all tags
   StatusOr<TagSchema> getAllLatestVerTagSchema(GraphSpaceID space) override;
 
   // get all version of all edges
-  StatusOr<EdgeSchemas> getAllVerEdgeSchema(GraphSpaceID space) override;
+  StatusOr<std::shared_ptr<const EdgeSchemas>> getAllVerEdgeSchema(GraphSpaceID space) override;
 
   // get all latest version of all edges
   StatusOr<EdgeSchema> getAllLatestVerEdgeSchema(GraphSpaceID space) override;
@@ -0,0 +1,88 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/stats/HdrHistogram.h"
+
+#include <folly/Likely.h>
+
+namespace nebula {
+namespace stats {
+
+namespace {
+
+int32_t roundUpToPowerOfTwo(int32_t v) {
+  int32_t p = 2;
+  while (p < v) {
+    p <<= 1;
+  }
+  return p;
+}
+
+int32_t log2Floor(int64_t v) {
+  DCHECK_GT(v, 0);
+  return 63 - __builtin_clzll(static_cast<uint64_t>(v));
+}
+
+}  // namespace
+
+HdrHistogram::HdrHistogram(int32_t bucketsPerOctave, int64_t max) {
+  subBucketCount_ = roundUpToPowerOfTwo(std::max(bucketsPerOctave, 2));
+  subBucketBits_ = log2Floor(subBucketCount_);
+  max_ = std::max(max, static_cast<int64_t>(subBucketCount_));
+  counts_ = std::vector<std::atomic<uint64_t>>(bucketIndex(max_) + 1);
+}
+
+size_t HdrHistogram::bucketIndex(int64_t value) const {
+  if (value < subBucketCount_) {
+    // Exact resolution for small values, one bucket per integer
+    return static_cast<size_t>(value);
+  }
+  // Each power of two above that is split into subBucketCount_ / 2 equal sub-buckets
+  auto pos = log2Floor(value);
+  auto octave = pos - subBucketBits_ + 1;
+  auto within = (value >> (pos - (subBucketBits_ - 1))) - subBucketCount_ / 2;
+  return static_cast<size_t>(subBucketCount_ + (octave - 1) * (subBucketCount_ / 2) + within);
+}
+
+int64_t HdrHistogram::bucketUpperBound(size_t index) const {
+  if (index < static_cast<size_t>(subBucketCount_)) {
+    return static_cast<int64_t>(index);
+  }
+  auto half = subBucketCount_ / 2;
+  auto k = static_cast<int64_t>(index) - subBucketCount_;
+  auto shift = k / half + 1;
+  auto within = k % half;
+  return ((half + within + 1) << shift) - 1;
+}
+
+void HdrHistogram::record(int64_t value) {
+  if (UNLIKELY(value < 0)) {
+    value = 0;
+  } else if (UNLIKELY(value > max_)) {
+    value = max_;
+  }
+  counts_[bucketIndex(value)].fetch_add(1, std::memory_order_relaxed);
+  count_.fetch_add(1, std::memory_order_relaxed);
+  sum_.fetch_add(value, std::memory_order_relaxed);
+}
+
+folly::dynamic HdrHistogram::toJson() const {
+  auto buckets = folly::dynamic::array();
+  uint64_t cumulative = 0;
+  for (size_t i = 0; i < counts_.size(); i++) {
+    auto c = counts_[i].load(std::memory_order_relaxed);
+    if (c == 0) {
+      continue;
+    }
+    cumulative += c;
+    buckets.push_back(
+        folly::dynamic::object("le", bucketUpperBound(i))("count", cumulative));
+  }
+  return folly::dynamic::object("count", count_.load(std::memory_order_relaxed))(
+      "sum", sum_.load(std::memory_order_relaxed))("buckets", std::move(buckets));
+}
+
+}  // namespace stats
+}  // namespace nebula
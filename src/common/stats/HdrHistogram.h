@@ -0,0 +1,71 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_STATS_HDRHISTOGRAM_H_
+#define COMMON_STATS_HDRHISTOGRAM_H_
+
+#include <folly/dynamic.h>
+
+#include <atomic>
+#include <vector>
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace stats {
+
+/**
+ * A fixed-layout histogram with HDR-style buckets: full integer resolution below
+ * `bucketsPerOctave', and `bucketsPerOctave / 2' sub-buckets per power of two above it, so the
+ * relative error of any recorded value is bounded by 2 / bucketsPerOctave regardless of its
+ * magnitude. This keeps sub-millisecond latencies sharp where the timeseries histograms of
+ * StatsManager, with their fixed absolute bucket size, blur everything below one bucket.
+ *
+ * Recording is a handful of relaxed atomic increments, no locks, no allocation after
+ * construction. Values are clamped into [0, max]. Readers get a best-effort snapshot: counts
+ * of concurrent writers may be partially visible, which is fine for monitoring.
+ */
+class HdrHistogram final {
+ public:
+  // bucketsPerOctave is rounded up to a power of two, at least 2; max is the largest value
+  // recorded with bounded error, larger values are clamped into the last bucket
+  HdrHistogram(int32_t bucketsPerOctave, int64_t max);
+
+  HdrHistogram(const HdrHistogram&) = delete;
+  HdrHistogram& operator=(const HdrHistogram&) = delete;
+
+  void record(int64_t value);
+
+  uint64_t count() const {
+    return count_.load(std::memory_order_relaxed);
+  }
+
+  int64_t sum() const {
+    return sum_.load(std::memory_order_relaxed);
+  }
+
+  // {"count": N, "sum": S, "buckets": [{"le": upperBound, "count": cumulative}, ...]},
+  // cumulative counts with empty buckets skipped, ready for scrape
+  folly::dynamic toJson() const;
+
+ private:
+  size_t bucketIndex(int64_t value) const;
+
+  // Largest value the bucket at `index' covers
+  int64_t bucketUpperBound(size_t index) const;
+
+  int32_t subBucketBits_;
+  int32_t subBucketCount_;
+  int64_t max_;
+
+  std::vector<std::atomic<uint64_t>> counts_;
+  std::atomic<uint64_t> count_{0};
+  std::atomic<int64_t> sum_{0};
+};
+
+}  // namespace stats
+}  // namespace nebula
+
+#endif  // COMMON_STATS_HDRHISTOGRAM_H_
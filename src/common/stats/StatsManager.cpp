@@ -161,6 +161,25 @@ CounterId StatsManager::registerHisto(folly::StringPiece counterName,
   return it2.first->second.id_;
 }
 
+// static
+HdrHistogram* StatsManager::registerHdrHisto(folly::StringPiece counterName,
+                                             int32_t bucketsPerOctave,
+                                             StatsManager::VT max) {
+  auto& sm = get();
+  std::string name = counterName.toString();
+  folly::RWSpinLock::WriteHolder wh(sm.nameMapLock_);
+  auto it = sm.hdrHistograms_.find(name);
+  if (it != sm.hdrHistograms_.end()) {
+    VLOG(2) << "The HDR histogram \"" << name << "\" already exists";
+    return it->second.get();
+  }
+  auto res = sm.hdrHistograms_.emplace(std::move(name),
+                                       std::make_unique<HdrHistogram>(bucketsPerOctave, max));
+  VLOG(1) << "Registered HDR histogram " << counterName.toString()
+          << " [bucketsPerOctave: " << bucketsPerOctave << ", max value: " << max << "]";
+  return res.first->second.get();
+}
+
 // static
 CounterId StatsManager::counterWithLabels(const CounterId& id,
                                           const std::vector<LabelPair>& labels) {
@@ -454,6 +473,30 @@ void StatsManager::readAllValue(folly::dynamic& vals) {
   }
 }
 
+// static
+void StatsManager::readAllHdrValue(folly::dynamic& vals) {
+  auto& sm = get();
+  folly::RWSpinLock::ReadHolder rh(sm.nameMapLock_);
+  for (auto const& histo : sm.hdrHistograms_) {
+    vals.push_back(folly::dynamic::object(histo.first, histo.second->toJson()));
+  }
+}
+
+// static
+void StatsManager::refreshSnapshot() {
+  auto vals = folly::dynamic::array();
+  readAllValue(vals);
+  readAllHdrValue(vals);
+  std::shared_ptr<const folly::dynamic> snapshot =
+      std::make_shared<const folly::dynamic>(std::move(vals));
+  std::atomic_store(&get().snapshot_, std::move(snapshot));
+}
+
+// static
+std::shared_ptr<const folly::dynamic> StatsManager::readSnapshot() {
+  return std::atomic_load(&get().snapshot_);
+}
+
 // static
 StatusOr<StatsManager::VT> StatsManager::readStats(const CounterId& id,
                                                    StatsManager::TimeRange range,
@@ -14,6 +14,7 @@
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
 #include "common/datatypes/HostAddr.h"
+#include "common/stats/HdrHistogram.h"
 #include "common/time/WallClock.h"
 
 namespace nebula {
@@ -126,6 +127,16 @@ class StatsManager final {
                                  std::vector<StatsMethod> methods,
                                  std::vector<std::pair<std::string, double>> percentiles);
 
+  // Registers an HDR-style histogram and returns a pointer owned by the StatsManager, valid
+  // for the life of the process. Unlike the timeseries histograms above there is no fixed
+  // absolute bucket size: the layout keeps a bounded relative error at any magnitude, so
+  // sub-millisecond latencies stay sharp. Record through the returned pointer directly --
+  // that path is lock-free and does no name lookup. Registering the same name again returns
+  // the existing histogram. The full distributions are exposed by the /stats endpoint.
+  static HdrHistogram* registerHdrHisto(folly::StringPiece counterName,
+                                        int32_t bucketsPerOctave,
+                                        VT max);
+
   // Dynamically register some stats with label values
   static CounterId counterWithLabels(const CounterId& id, const std::vector<LabelPair>& labels);
   static CounterId histoWithLabels(const CounterId& id, const std::vector<LabelPair>& labels);
@@ -152,6 +163,16 @@ class StatsManager final {
   static StatusOr<VT> readHisto(const CounterId& id, TimeRange range, double pct);
   static StatusOr<VT> readHisto(const std::string& counterName, TimeRange range, double pct);
   static void readAllValue(folly::dynamic& vals);
+  // Append the full distribution of every registered HDR histogram to vals
+  static void readAllHdrValue(folly::dynamic& vals);
+
+  // Aggregate all counters into an immutable snapshot and publish it atomically. Meant to be
+  // called from a single background thread, so scrapes served from the snapshot never touch
+  // the counter locks.
+  static void refreshSnapshot();
+  // The last published snapshot, or nullptr when refreshSnapshot was never called. The
+  // returned snapshot is immutable and safe to read without any locking.
+  static std::shared_ptr<const folly::dynamic> readSnapshot();
 
  private:
   static StatsManager& get();
@@ -210,6 +231,14 @@ class StatsManager final {
   std::unordered_map<std::string,
                      std::pair<std::unique_ptr<std::mutex>, std::unique_ptr<HistogramType>>>
       histograms_;
+
+  // All HDR histograms, registration guarded by nameMapLock_, recording lock-free through
+  // the pointers handed out by registerHdrHisto
+  std::unordered_map<std::string, std::unique_ptr<HdrHistogram>> hdrHistograms_;
+
+  // Pre-aggregated snapshot of all counters, published by refreshSnapshot and read via
+  // std::atomic_load so scrapes don't contend with the writers
+  std::shared_ptr<const folly::dynamic> snapshot_;
 };
 
 }  // namespace stats
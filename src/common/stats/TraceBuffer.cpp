@@ -0,0 +1,76 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "common/stats/TraceBuffer.h"
+
+#include <cstring>
+
+DEFINE_int32(trace_span_buffer_size,
+             0,
+             "Number of spans kept in the in-memory trace ring exported via /traces, rounded "
+             "down per process start. 0 disables span tracing");
+
+namespace nebula {
+namespace stats {
+
+TraceBuffer& TraceBuffer::instance() {
+  static TraceBuffer buffer;
+  return buffer;
+}
+
+TraceBuffer::TraceBuffer() {
+  if (FLAGS_trace_span_buffer_size > 0) {
+    ring_ = std::vector<Span>(FLAGS_trace_span_buffer_size);
+  }
+}
+
+void TraceBuffer::record(int64_t sessionId,
+                         int64_t planId,
+                         const char* name,
+                         int64_t tag,
+                         int64_t startNs,
+                         int64_t durNs) {
+  if (ring_.empty()) {
+    return;
+  }
+  auto& span = ring_[head_.fetch_add(1, std::memory_order_relaxed) % ring_.size()];
+  span.seq.fetch_add(1, std::memory_order_acquire);
+  span.sessionId = sessionId;
+  span.planId = planId;
+  span.tag = tag;
+  span.startNs = startNs;
+  span.durNs = durNs;
+  ::strncpy(span.name, name, sizeof(span.name) - 1);
+  span.name[sizeof(span.name) - 1] = '\0';
+  span.seq.fetch_add(1, std::memory_order_release);
+}
+
+folly::dynamic TraceBuffer::toJson(size_t limit) const {
+  auto spans = folly::dynamic::array();
+  if (ring_.empty()) {
+    return spans;
+  }
+  auto head = head_.load(std::memory_order_acquire);
+  auto count = std::min({limit, ring_.size(), static_cast<size_t>(head)});
+  for (size_t i = 0; i < count; i++) {
+    const auto& span = ring_[(head - 1 - i) % ring_.size()];
+    auto seqBefore = span.seq.load(std::memory_order_acquire);
+    if (seqBefore % 2 != 0) {
+      // being written right now
+      continue;
+    }
+    folly::dynamic item = folly::dynamic::object("session", span.sessionId)("plan", span.planId)(
+        "name", span.name)("tag", span.tag)("startNs", span.startNs)("durNs", span.durNs);
+    if (span.seq.load(std::memory_order_acquire) != seqBefore) {
+      // overwritten while we copied it
+      continue;
+    }
+    spans.push_back(std::move(item));
+  }
+  return spans;
+}
+
+}  // namespace stats
+}  // namespace nebula
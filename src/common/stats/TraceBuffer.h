@@ -0,0 +1,73 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef COMMON_STATS_TRACEBUFFER_H_
+#define COMMON_STATS_TRACEBUFFER_H_
+
+#include <folly/dynamic.h>
+
+#include <atomic>
+#include <vector>
+
+#include "common/base/Base.h"
+
+namespace nebula {
+namespace stats {
+
+/**
+ * A fixed-size ring of recently finished spans, cheap enough to leave on in production.
+ *
+ * Both graphd executors and storaged processors push spans keyed by (sessionId, planId), the
+ * pair every storage request already carries in its RequestCommon, so the spans of one query
+ * can be correlated across processes without log grepping. The ring is exported as JSON by
+ * the webservice under /traces.
+ *
+ * Recording is one relaxed fetch_add plus a plain struct write guarded by a per-slot seqlock,
+ * no locks and no allocation. Spans are best effort: the exporter skips slots that are being
+ * overwritten, and two writers landing on the same slot under heavy wrap-around may drop one
+ * span. Sized by --trace_span_buffer_size, 0 (the default) disables tracing entirely.
+ */
+class TraceBuffer final {
+ public:
+  static TraceBuffer& instance();
+
+  bool enabled() const {
+    return !ring_.empty();
+  }
+
+  // Record one finished span; `tag' is a site-specific detail such as the part id or the
+  // plan node id. No-op when tracing is disabled.
+  void record(int64_t sessionId,
+              int64_t planId,
+              const char* name,
+              int64_t tag,
+              int64_t startNs,
+              int64_t durNs);
+
+  // Snapshot up to `limit' most recent spans, newest first
+  folly::dynamic toJson(size_t limit) const;
+
+ private:
+  TraceBuffer();
+
+  struct Span {
+    // seqlock: odd while the slot is being written, bumped twice per record
+    std::atomic<uint64_t> seq{0};
+    int64_t sessionId{0};
+    int64_t planId{0};
+    int64_t tag{0};
+    int64_t startNs{0};
+    int64_t durNs{0};
+    char name[32]{};
+  };
+
+  std::vector<Span> ring_;
+  std::atomic<uint64_t> head_{0};
+};
+
+}  // namespace stats
+}  // namespace nebula
+
+#endif  // COMMON_STATS_TRACEBUFFER_H_
@@ -0,0 +1,107 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include "common/base/Base.h"
+#include "common/stats/HdrHistogram.h"
+#include "common/stats/StatsManager.h"
+
+namespace nebula {
+namespace stats {
+
+TEST(HdrHistogram, SmallValuesExact) {
+  HdrHistogram histo(32, 1000000);
+  for (int64_t v = 0; v < 32; v++) {
+    histo.record(v);
+  }
+  EXPECT_EQ(32, histo.count());
+  EXPECT_EQ(31 * 32 / 2, histo.sum());
+
+  // Below bucketsPerOctave every integer has its own bucket
+  auto json = histo.toJson();
+  EXPECT_EQ(32, json["buckets"].size());
+  for (size_t i = 0; i < 32; i++) {
+    EXPECT_EQ(static_cast<int64_t>(i), json["buckets"][i]["le"].asInt());
+    EXPECT_EQ(static_cast<int64_t>(i + 1), json["buckets"][i]["count"].asInt());
+  }
+}
+
+TEST(HdrHistogram, BoundedRelativeError) {
+  HdrHistogram histo(32, 60000000);
+  std::vector<int64_t> values = {100, 499, 500, 501, 999, 1000, 5000, 123456, 59999999};
+  for (auto v : values) {
+    histo.record(v);
+  }
+  EXPECT_EQ(values.size(), histo.count());
+
+  // The upper bound of every non-empty bucket is within 1/16 of some recorded value
+  auto json = histo.toJson();
+  for (auto& bucket : json["buckets"]) {
+    auto le = bucket["le"].asInt();
+    bool close = false;
+    for (auto v : values) {
+      if (le >= v && le <= v + v / 16 + 1) {
+        close = true;
+        break;
+      }
+    }
+    EXPECT_TRUE(close) << "bucket upper bound " << le << " too far from any recorded value";
+  }
+}
+
+TEST(HdrHistogram, Clamping) {
+  HdrHistogram histo(32, 1000);
+  histo.record(-5);
+  histo.record(123456789);
+  EXPECT_EQ(2, histo.count());
+  EXPECT_EQ(1000, histo.sum());
+}
+
+TEST(HdrHistogram, ConcurrentRecord) {
+  auto* histo = StatsManager::registerHdrHisto("hdr_test", 32, 1000000);
+  ASSERT_NE(nullptr, histo);
+  // Registering the same name again returns the same histogram
+  EXPECT_EQ(histo, StatsManager::registerHdrHisto("hdr_test", 32, 1000000));
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 8; i++) {
+    threads.emplace_back([histo]() {
+      for (int64_t k = 0; k < 10000; k++) {
+        histo->record(k % 2000);
+      }
+    });
+  }
+  for (auto& t : threads) {
+    t.join();
+  }
+  EXPECT_EQ(80000, histo->count());
+
+  auto vals = folly::dynamic::array();
+  StatsManager::readAllHdrValue(vals);
+  bool found = false;
+  for (auto& val : vals) {
+    for (auto& item : val.items()) {
+      if (item.first.asString() == "hdr_test") {
+        found = true;
+        EXPECT_EQ(80000, item.second["count"].asInt());
+      }
+    }
+  }
+  EXPECT_TRUE(found);
+}
+
+}  // namespace stats
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
@@ -10,12 +10,15 @@
 #include <folly/io/async/AsyncSocket.h>
 #include <folly/system/ThreadName.h>
 #include <thrift/lib/cpp2/async/RocketClientChannel.h>
+#include <thrift/lib/thrift/gen-cpp2/RpcMetadata_types.h>
 
 #include "common/base/Base.h"
 #include "common/network/NetworkUtils.h"
 #include "common/ssl/SSLConfig.h"
 
 DECLARE_int32(conn_timeout_ms);
+DECLARE_string(rpc_compression_codec);
+DECLARE_int32(rpc_compression_min_size);
 
 namespace nebula {
 namespace thrift {
@@ -85,6 +88,28 @@ std::shared_ptr<ClientType> ThriftClientManager<ClientType>::client(const HostAd
   });
   auto clientChannel = apache::thrift::RocketClientChannel::newChannel(std::move(socket));
   clientChannel->setTimeout(timeout);
+  if (!FLAGS_rpc_compression_codec.empty()) {
+    // The config rides on each request's metadata: the peer compresses its response with the
+    // same codec, and payloads under the size limit stay uncompressed in both directions.
+    // Decompression happens in the transport, the deserializer consumes the inflated IOBufs.
+    apache::thrift::CodecConfig codec;
+    bool known = true;
+    if (FLAGS_rpc_compression_codec == "zstd") {
+      codec.zstdConfig_ref().emplace();
+    } else if (FLAGS_rpc_compression_codec == "zlib") {
+      codec.zlibConfig_ref().emplace();
+    } else {
+      LOG(WARNING) << "Unknown rpc compression codec: " << FLAGS_rpc_compression_codec
+                   << ", sending uncompressed";
+      known = false;
+    }
+    if (known) {
+      apache::thrift::CompressionConfig compressionConfig;
+      compressionConfig.codecConfig_ref() = std::move(codec);
+      compressionConfig.compressionSizeLimit_ref() = FLAGS_rpc_compression_min_size;
+      clientChannel->setDesiredCompressionConfig(std::move(compressionConfig));
+    }
+  }
   if (compatibility) {
     clientChannel->setProtocolId(apache::thrift::protocol::T_BINARY_PROTOCOL);
     //    clientChannel->setClientType(THRIFT_UNFRAMED_DEPRECATED);
@@ -8,3 +8,10 @@
 #include "common/base/Base.h"
 
 DEFINE_int32(conn_timeout_ms, 1000, "Connection timeout in milliseconds");
+DEFINE_string(rpc_compression_codec,
+              "",
+              "Codec for rpc payloads, \"zstd\" or \"zlib\", empty disables compression. "
+              "Applies to storage, meta and raft traffic alike");
+DEFINE_int32(rpc_compression_min_size,
+             4096,
+             "Payloads smaller than this many bytes are sent uncompressed");
@@ -42,17 +42,17 @@ class DefaultValueContext final : public ExpressionContext {
     return Status::Error("Unimplemented");
   }
 
-  Value getEdgeProp(const std::string&, const std::string&) const override {
+  const Value& getEdgeProp(const std::string&, const std::string&) const override {
     DLOG(FATAL) << "Not allowed to call";
     return Value::kEmpty;
   }
 
-  Value getTagProp(const std::string&, const std::string&) const override {
+  const Value& getTagProp(const std::string&, const std::string&) const override {
     DLOG(FATAL) << "Not allowed to call";
     return Value::kEmpty;
   }
 
-  Value getSrcProp(const std::string&, const std::string&) const override {
+  const Value& getSrcProp(const std::string&, const std::string&) const override {
     DLOG(FATAL) << "Not allowed to call";
     return Value::kEmpty;
   }
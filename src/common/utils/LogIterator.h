@@ -6,6 +6,8 @@
 #ifndef COMMON_UTILS_LOGITERATOR_H_
 #define COMMON_UTILS_LOGITERATOR_H_
 
+#include <folly/io/IOBuf.h>
+
 #include "common/base/Base.h"
 #include "common/thrift/ThriftTypes.h"
 
@@ -26,6 +28,15 @@ class LogIterator {
   virtual TermID logTerm() const = 0;
   virtual ClusterID logSource() const = 0;
   virtual folly::StringPiece logMsg() const = 0;
+
+  /**
+   * @brief Return the log message as an IOBuf. The default implementation copies the message,
+   * iterators whose records outlive the iterator may override it with an aliasing buffer
+   */
+  virtual std::unique_ptr<folly::IOBuf> logMsgBuf() const {
+    auto msg = logMsg();
+    return folly::IOBuf::copyBuffer(msg.data(), msg.size());
+  }
 };
 
 }  // namespace nebula
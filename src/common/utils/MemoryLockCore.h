@@ -8,6 +8,8 @@
 
 #include <folly/concurrency/ConcurrentHashMap.h>
 
+#include <array>
+
 #include "common/base/Base.h"
 
 namespace nebula {
@@ -28,11 +30,11 @@ class MemoryLockCore {
   }
 
   bool try_lock(const Key& key) {
-    return hashMap_.insert(std::make_pair(key, 0)).second;
+    return shard(key).insert(std::make_pair(key, 0)).second;
   }
 
   void unlock(const Key& key) {
-    hashMap_.erase(key);
+    shard(key).erase(key);
   }
 
   template <class Iter>
@@ -40,7 +42,7 @@ class MemoryLockCore {
     Iter curr = begin;
     bool inserted = false;
     while (curr != end) {
-      std::tie(std::ignore, inserted) = hashMap_.insert(std::make_pair(*curr, 0));
+      std::tie(std::ignore, inserted) = shard(*curr).insert(std::make_pair(*curr, 0));
       if (!inserted) {
         unlockBatch(begin, curr);
         return std::make_pair(curr, false);
@@ -58,7 +60,7 @@ class MemoryLockCore {
   template <class Iter>
   void unlockBatch(Iter begin, Iter end) {
     for (; begin != end; ++begin) {
-      hashMap_.erase(*begin);
+      shard(*begin).erase(*begin);
     }
   }
 
@@ -68,19 +70,34 @@ class MemoryLockCore {
   }
 
   void clear() {
-    hashMap_.clear();
+    for (auto& s : shards_) {
+      s.clear();
+    }
   }
 
   size_t size() {
-    return hashMap_.size();
+    size_t total = 0;
+    for (auto& s : shards_) {
+      total += s.size();
+    }
+    return total;
   }
 
   bool contains(const Key& key) {
-    return hashMap_.find(key) == hashMap_.end();
+    return shard(key).find(key) == shard(key).end();
   }
 
  protected:
-  folly::ConcurrentHashMap<Key, int> hashMap_;
+  // All locks of a storaged used to funnel through one map, so unrelated keys still
+  // collided on its segment mutexes under heavy update traffic. The table is sharded by
+  // key hash, every key maps to exactly one shard so the per-key semantics are unchanged.
+  static constexpr size_t kNumShards = 16;
+
+  folly::ConcurrentHashMap<Key, int>& shard(const Key& key) {
+    return shards_[std::hash<Key>()(key) & (kNumShards - 1)];
+  }
+
+  std::array<folly::ConcurrentHashMap<Key, int>, kNumShards> shards_;
 };
 
 }  // namespace nebula
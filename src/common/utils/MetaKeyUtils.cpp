@@ -137,6 +137,14 @@ std::string MetaKeyUtils::lastUpdateTimeKey() {
   return key;
 }
 
+std::string MetaKeyUtils::spaceLastUpdateTimeKey(GraphSpaceID spaceId) {
+  std::string key;
+  key.reserve(kLastUpdateTimeTable.size() + sizeof(GraphSpaceID));
+  key.append(kLastUpdateTimeTable.data(), kLastUpdateTimeTable.size())
+      .append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID));
+  return key;
+}
+
 std::string MetaKeyUtils::lastUpdateTimeVal(const int64_t timeInMilliSec) {
   std::string val;
   val.reserve(sizeof(int64_t));
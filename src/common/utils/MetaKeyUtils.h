@@ -70,6 +70,8 @@ class MetaKeyUtils final {
 
   static std::string lastUpdateTimeKey();
 
+  static std::string spaceLastUpdateTimeKey(GraphSpaceID spaceId);
+
   static std::string lastUpdateTimeVal(const int64_t timeInMilliSec);
 
   static std::string spaceKey(GraphSpaceID spaceId);
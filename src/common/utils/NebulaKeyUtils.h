@@ -242,6 +242,48 @@ class NebulaKeyUtils final {
     return NebulaKeyUtils::decodeRank(rawKey.data() + offset);
   }
 
+  // Column arrays of the in-key edge fields, one entry per decoded key. The id slices point
+  // into the caller's key buffers and stay valid only as long as those do
+  struct EdgeKeyColumns {
+    std::vector<VertexIDSlice> srcs;
+    std::vector<EdgeType> types;
+    std::vector<EdgeRanking> ranks;
+    std::vector<VertexIDSlice> dsts;
+  };
+
+  /**
+   * @brief Decode the in-key fields of a batch of edge keys in one pass. The field offsets
+   * are derived once for the whole batch and every key is bounds checked a single time, so
+   * scan paths materializing key columns avoid calling
+   * getSrcId/getEdgeType/getRank/getDstId per field per key
+   *
+   * @param vIdLen Vertex id length of the space
+   * @param keys Edge keys to decode
+   * @param columns Output columns, appended in key order
+   */
+  static void decodeEdgeKeys(size_t vIdLen,
+                             const std::vector<folly::StringPiece>& keys,
+                             EdgeKeyColumns* columns) {
+    const size_t srcOffset = sizeof(PartitionID);
+    const size_t typeOffset = srcOffset + vIdLen;
+    const size_t rankOffset = typeOffset + sizeof(EdgeType);
+    const size_t dstOffset = rankOffset + sizeof(EdgeRanking);
+    const size_t minSize = kEdgeLen + (vIdLen << 1);
+    columns->srcs.reserve(columns->srcs.size() + keys.size());
+    columns->types.reserve(columns->types.size() + keys.size());
+    columns->ranks.reserve(columns->ranks.size() + keys.size());
+    columns->dsts.reserve(columns->dsts.size() + keys.size());
+    for (const auto& key : keys) {
+      if (UNLIKELY(key.size() < minSize)) {
+        dumpBadKey(key, minSize, vIdLen);
+      }
+      columns->srcs.emplace_back(key.subpiece(srcOffset, vIdLen));
+      columns->types.emplace_back(readInt<EdgeType>(key.data() + typeOffset, sizeof(EdgeType)));
+      columns->ranks.emplace_back(decodeRank(key.subpiece(rankOffset, sizeof(EdgeRanking))));
+      columns->dsts.emplace_back(key.subpiece(dstOffset, vIdLen));
+    }
+  }
+
   static std::string encodeRank(EdgeRanking rank) {
     rank ^= folly::to<int64_t>(1) << 63;
     auto val = folly::Endian::big(rank);
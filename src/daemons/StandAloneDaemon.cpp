@@ -75,7 +75,8 @@ DEFINE_string(data_path,
 DEFINE_string(wal_path,
               "",
               "Nebula wal path. By default, wal will be stored as a sibling of "
-              "rocksdb data.");
+              "rocksdb data. Either a single shared path, or one path per data_path "
+              "entry (split by comma) to keep each disk's wal on a dedicated device.");
 DEFINE_string(listener_path,
               "",
               "Path for listener, only wal will be saved."
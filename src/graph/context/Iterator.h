@@ -11,6 +11,7 @@
 #include "graph/context/iterator/GetNeighborsIter.h"
 #include "graph/context/iterator/Iterator.h"
 #include "graph/context/iterator/PropIter.h"
+#include "graph/context/iterator/RowBatchIter.h"
 #include "graph/context/iterator/SequentialIter.h"
 
 #endif  // GRAPH_CONTEXT_ITERATOR_H_
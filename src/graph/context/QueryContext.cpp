@@ -5,6 +5,8 @@
 
 #include "graph/context/QueryContext.h"
 
+#include "graph/service/GraphFlags.h"
+
 namespace nebula {
 namespace graph {
 
@@ -37,10 +39,39 @@ void QueryContext::init() {
       ectx_->setValue(std::move(item.first), std::move(item.second));
     }
   }
+  if (FLAGS_query_deadline_ms > 0) {
+    deadlineUs_ = time::WallClock::fastNowInMicroSec() + FLAGS_query_deadline_ms * 1000;
+  }
   idGen_ = std::make_unique<IdGenerator>(0);
   symTable_ = std::make_unique<SymbolTable>(objPool_.get(), ectx_.get());
   vctx_ = std::make_unique<ValidateContext>(std::make_unique<AnonVarGenerator>(symTable_.get()));
 }
 
+StatusOr<TagID> QueryContext::toTagID(GraphSpaceID space, const std::string& label) {
+  auto key = folly::to<std::string>(space) + ":" + label;
+  auto iter = tagIdMemo_.find(key);
+  if (iter != tagIdMemo_.end()) {
+    return iter->second;
+  }
+  auto ret = sm_->toTagID(space, label);
+  if (ret.ok()) {
+    tagIdMemo_.emplace(std::move(key), ret.value());
+  }
+  return ret;
+}
+
+StatusOr<EdgeType> QueryContext::toEdgeType(GraphSpaceID space, const std::string& name) {
+  auto key = folly::to<std::string>(space) + ":" + name;
+  auto iter = edgeTypeMemo_.find(key);
+  if (iter != edgeTypeMemo_.end()) {
+    return iter->second;
+  }
+  auto ret = sm_->toEdgeType(space, name);
+  if (ret.ok()) {
+    edgeTypeMemo_.emplace(std::move(key), ret.value());
+  }
+  return ret;
+}
+
 }  // namespace graph
 }  // namespace nebula
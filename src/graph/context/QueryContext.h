@@ -14,6 +14,7 @@
 #include "common/datatypes/Value.h"
 #include "common/meta/IndexManager.h"
 #include "common/meta/SchemaManager.h"
+#include "common/time/WallClock.h"
 #include "graph/context/ExecutionContext.h"
 #include "graph/context/Symbols.h"
 #include "graph/context/ValidateContext.h"
@@ -71,6 +72,22 @@ class QueryContext {
     metaClient_ = metaClient;
   }
 
+  // Workload class runner pools, both null unless workload isolation is enabled. The
+  // request runner starts as one of them (chosen at plan time) and may be switched to the
+  // heavy pool mid-query when the actual row counts diverge from the estimate
+  void setWorkloadRunners(folly::Executor* lightRunner, folly::Executor* heavyRunner) {
+    lightRunner_ = lightRunner;
+    heavyRunner_ = heavyRunner;
+  }
+
+  folly::Executor* lightRunner() const {
+    return lightRunner_;
+  }
+
+  folly::Executor* heavyRunner() const {
+    return heavyRunner_;
+  }
+
   void setCharsetInfo(CharsetInfo* charsetInfo) {
     charsetInfo_ = charsetInfo;
   }
@@ -95,6 +112,13 @@ class QueryContext {
     return sm_;
   }
 
+  // Memoized (space, name) -> id resolution for the validators. A many-element MATCH
+  // pattern resolves the same handful of labels dozens of times; repeats are served from
+  // the per-query memo instead of re-taking the SchemaManager's shared locks. The memo
+  // lives and dies with the query, so it cannot go stale mid-validation.
+  StatusOr<TagID> toTagID(GraphSpaceID space, const std::string& label);
+  StatusOr<EdgeType> toEdgeType(GraphSpaceID space, const std::string& name);
+
   meta::IndexManager* indexMng() const {
     return im_;
   }
@@ -133,7 +157,33 @@ class QueryContext {
   }
 
   bool isKilled() const {
-    return killed_.load();
+    if (killed_.load()) {
+      return true;
+    }
+    // The deadline piggybacks on the kill flag so every per-batch killed() check in the
+    // executors also enforces it, see FLAGS_query_deadline_ms
+    return deadlineUs_ > 0 && time::WallClock::fastNowInMicroSec() > deadlineUs_;
+  }
+
+  // Wall clock time in us the query must finish by, 0 if no deadline is set
+  int64_t deadlineUs() const {
+    return deadlineUs_;
+  }
+
+  // Tracked bytes the query holds, charged by the memory tracker while an executor of this
+  // query runs under a MemoryScopeGuard
+  std::atomic<int64_t>* memoryUsed() {
+    return &memoryUsed_;
+  }
+
+  // Whether this query was drawn as a verify request, its executors run the sampled
+  // hot-path checks. See common/base/SampledCheck.h
+  bool verifyChecks() const {
+    return verifyChecks_;
+  }
+
+  void setVerifyChecks(bool verify) {
+    verifyChecks_ = verify;
   }
 
   // This is only valid in building stage!
@@ -154,6 +204,8 @@ class QueryContext {
   storage::StorageClient* storageClient_{nullptr};
   meta::MetaClient* metaClient_{nullptr};
   CharsetInfo* charsetInfo_{nullptr};
+  folly::Executor* lightRunner_{nullptr};
+  folly::Executor* heavyRunner_{nullptr};
 
   // The Object Pool holds all internal generated objects.
   // e.g. expressions, plan nodes, executors
@@ -162,6 +214,13 @@ class QueryContext {
   std::unique_ptr<SymbolTable> symTable_;
 
   std::atomic<bool> killed_{false};
+  std::atomic<int64_t> memoryUsed_{0};
+  int64_t deadlineUs_{0};
+  bool verifyChecks_{false};
+
+  // Keyed by "<space>:<name>", only successful resolutions are memoized
+  std::unordered_map<std::string, TagID> tagIdMemo_;
+  std::unordered_map<std::string, EdgeType> edgeTypeMemo_;
 };
 
 }  // namespace graph
@@ -47,21 +47,24 @@ StatusOr<std::size_t> QueryExpressionContext::getVarPropIndex(const std::string&
   return DCHECK_NOTNULL(iter_)->getColumnIndex(prop);
 }
 
-Value QueryExpressionContext::getTagProp(const std::string& tag, const std::string& prop) const {
+const Value& QueryExpressionContext::getTagProp(const std::string& tag,
+                                                const std::string& prop) const {
   if (iter_ == nullptr) {
     return Value::kEmpty;
   }
   return iter_->getTagProp(tag, prop);
 }
 
-Value QueryExpressionContext::getEdgeProp(const std::string& edge, const std::string& prop) const {
+const Value& QueryExpressionContext::getEdgeProp(const std::string& edge,
+                                                 const std::string& prop) const {
   if (iter_ == nullptr) {
     return Value::kEmpty;
   }
   return iter_->getEdgeProp(edge, prop);
 }
 
-Value QueryExpressionContext::getSrcProp(const std::string& tag, const std::string& prop) const {
+const Value& QueryExpressionContext::getSrcProp(const std::string& tag,
+                                                const std::string& prop) const {
   if (iter_ == nullptr) {
     return Value::kEmpty;
   }
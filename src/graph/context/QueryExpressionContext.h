@@ -41,14 +41,15 @@ class QueryExpressionContext final : public ExpressionContext {
   StatusOr<std::size_t> getVarPropIndex(const std::string& var,
                                         const std::string& prop) const override;
 
-  // Get the specified property from the tag, such as tag.prop_name
-  Value getTagProp(const std::string& tag, const std::string& prop) const override;
+  // Get the specified property from the tag, such as tag.prop_name.
+  // Returns a reference into the iterator's current row, no copy is made
+  const Value& getTagProp(const std::string& tag, const std::string& prop) const override;
 
   // Get the specified property from the edge, such as edge_type.prop_name
-  Value getEdgeProp(const std::string& edge, const std::string& prop) const override;
+  const Value& getEdgeProp(const std::string& edge, const std::string& prop) const override;
 
   // Get the specified property from the source vertex, such as $^.prop_name
-  Value getSrcProp(const std::string& tag, const std::string& prop) const override;
+  const Value& getSrcProp(const std::string& tag, const std::string& prop) const override;
 
   // Get the specified property from the destination vertex, such as
   // $$.prop_name
@@ -19,6 +19,32 @@ const std::vector<Result>& Result::EmptyResultList() {
   return kEmptyResultList;
 }
 
+void Result::detach() {
+  DCHECK(core_.iter);
+  if (core_.iter->isRowBatchIter()) {
+    // A RowBatchIter never mutates the shared batch: erasing only drops this iterator's own
+    // row handles and moved rows are materialized copies, so nothing has to be detached
+    return;
+  }
+  core_.value = std::make_shared<Value>(*core_.value);
+  switch (core_.iter->kind()) {
+    case Iterator::Kind::kDefault:
+      core_.iter = std::make_unique<DefaultIter>(core_.value, core_.checkMemory);
+      break;
+    case Iterator::Kind::kSequential:
+      core_.iter = std::make_unique<SequentialIter>(core_.value, core_.checkMemory);
+      break;
+    case Iterator::Kind::kGetNeighbors:
+      core_.iter = std::make_unique<GetNeighborsIter>(core_.value, core_.checkMemory);
+      break;
+    case Iterator::Kind::kProp:
+      core_.iter = std::make_unique<PropIter>(core_.value, core_.checkMemory);
+      break;
+    default:
+      LOG(FATAL) << "Invalid Iterator kind" << static_cast<uint8_t>(core_.iter->kind());
+  }
+}
+
 ResultBuilder& ResultBuilder::iter(Iterator::Kind kind) {
   DCHECK(kind == Iterator::Kind::kDefault || core_.value)
       << "Must set value when creating non-default iterator";
@@ -63,6 +63,12 @@ class Result final {
     }
   }
 
+  // Copy-on-write support: replace the shared value with a private copy and rebuild the
+  // iterator on it, so erasing or moving rows through the iterator can not be observed by
+  // other readers of the same value. Callers only need to detach when the variable still
+  // has other readers left.
+  void detach();
+
   std::vector<std::string> getColNames() const {
     auto& ds = value();
     if (ds.isDataSet()) {
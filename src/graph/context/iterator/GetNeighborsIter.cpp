@@ -6,6 +6,7 @@
 #include "graph/context/iterator/GetNeighborsIter.h"
 
 #include "common/algorithm/ReservoirSampling.h"
+#include "common/base/SampledCheck.h"
 #include "common/datatypes/Edge.h"
 #include "common/datatypes/Vertex.h"
 #include "graph/util/SchemaUtil.h"
@@ -25,61 +26,74 @@ GetNeighborsIter::GetNeighborsIter(std::shared_ptr<Value> value, bool checkMemor
     return;
   }
 
+  buildEdgeBlock();
   goToFirstEdge();
 }
 
-void GetNeighborsIter::goToFirstEdge() {
-  // Go to first edge
-  for (currentDs_ = dsIndices_.begin(); currentDs_ < dsIndices_.end(); ++currentDs_) {
-    if (noEdge_) {
-      currentRow_ = currentDs_->ds->rows.begin();
-      valid_ = true;
-      break;
-    }
-    for (currentRow_ = currentDs_->ds->rows.begin(); currentRow_ < currentDs_->ds->rows.end();
-         ++currentRow_) {
-      colIdx_ = currentDs_->colLowerBound + 1;
-      while (colIdx_ < currentDs_->colUpperBound && !valid_) {
-        const auto& currentCol = (*currentRow_)[colIdx_];
-        if (!currentCol.isList() || currentCol.getList().empty()) {
-          ++colIdx_;
+void GetNeighborsIter::buildEdgeBlock() {
+  edgeSlots_.clear();
+  if (noEdge_) {
+    return;
+  }
+  // Same traversal order as the old nested iteration: dataset, row, edge column, edge.
+  // The filter bitset is indexed by slot position, so this order is part of the contract.
+  for (size_t d = 0; d < dsIndices_.size(); ++d) {
+    const auto& dsIndex = dsIndices_[d];
+    const auto& rows = dsIndex.ds->rows;
+    for (size_t r = 0; r < rows.size(); ++r) {
+      const auto& row = rows[r];
+      for (auto c = dsIndex.colLowerBound + 1; c < dsIndex.colUpperBound; ++c) {
+        const auto& cell = row[c];
+        if (!cell.isList() || cell.getList().empty()) {
           continue;
         }
-
-        currentCol_ = &currentCol.getList();
-        edgeIdxUpperBound_ = currentCol_->size();
-        edgeIdx_ = 0;
-        while (edgeIdx_ < edgeIdxUpperBound_ && !valid_) {
-          const auto& currentEdge = currentCol_->operator[](edgeIdx_);
-          if (!currentEdge.isList()) {
-            ++edgeIdx_;
+        for (const auto& edgeVal : cell.getList().values) {
+          if (!edgeVal.isList()) {
             continue;
           }
-          currentEdge_ = &currentEdge.getList();
-          valid_ = true;
-        }  // `edgeIdx_'
-        if (!valid_) {
-          ++colIdx_;
+          edgeSlots_.push_back(EdgeSlot{static_cast<uint32_t>(d),
+                                        static_cast<uint32_t>(r),
+                                        static_cast<uint32_t>(c),
+                                        &edgeVal.getList()});
         }
-      }  // `colIdx_'
-      if (valid_) {
-        break;
       }
-    }  // `currentRow_'
-    if (valid_) {
-      break;
     }
-  }  // `currentDs_'
+  }
+  bitset_.clear();
+  bitset_.resize(edgeSlots_.size(), true);
+}
 
-  if (valid_) {
+void GetNeighborsIter::advanceSlot() {
+  while (++slotIdx_ < static_cast<int64_t>(edgeSlots_.size())) {
+    if (!bitset_[slotIdx_]) {
+      continue;
+    }
+    const auto& slot = edgeSlots_[slotIdx_];
+    currentDs_ = dsIndices_.begin() + slot.dsIdx;
+    currentRow_ = currentDs_->ds->rows.begin() + slot.rowIdx;
     rowsUpperBound_ = currentDs_->ds->rows.end();
-    bitIdx_ = 0;
-    if (bitset_.empty()) {
-      bitset_.push_back(true);
-    } else if (!bitset_[bitIdx_]) {
-      next();
+    colIdx_ = slot.colIdx;
+    currentCol_ = &(*currentRow_)[slot.colIdx].getList();
+    currentEdge_ = slot.edge;
+    valid_ = true;
+    return;
+  }
+  valid_ = false;
+  currentDs_ = dsIndices_.end();
+}
+
+void GetNeighborsIter::goToFirstEdge() {
+  if (noEdge_) {
+    if (!dsIndices_.empty()) {
+      currentDs_ = dsIndices_.begin();
+      currentRow_ = currentDs_->ds->rows.begin();
+      rowsUpperBound_ = currentDs_->ds->rows.end();
+      valid_ = true;
     }
+    return;
   }
+  slotIdx_ = -1;
+  advanceSlot();
 }
 
 Status GetNeighborsIter::processList(std::shared_ptr<Value> value) {
@@ -147,39 +161,56 @@ Status GetNeighborsIter::buildPropIndex(const std::string& props,
                                         size_t columnId,
                                         bool isEdge,
                                         DataSetIndex* dsIndex) {
-  std::vector<std::string> pieces;
-  folly::split(":", props, pieces);
-  if (UNLIKELY(pieces.size() < 2)) {
+  auto nameStart = props.find(':');
+  if (UNLIKELY(nameStart == std::string::npos)) {
     return Status::Error("Bad column name format: %s", props.c_str());
   }
+  ++nameStart;
+  auto nameEnd = props.find(':', nameStart);
+  auto name = nameEnd == std::string::npos ? props.substr(nameStart)
+                                           : props.substr(nameStart, nameEnd - nameStart);
 
   PropIndex propIdx;
-  // if size == 2, it is the tag defined without props.
-  if (pieces.size() > 2) {
-    for (size_t i = 2; i < pieces.size(); ++i) {
-      propIdx.propIndices.emplace(pieces[i], i - 2);
-    }
-  }
-
   propIdx.colIdx = columnId;
-  propIdx.propList.resize(pieces.size() - 2);
-  std::move(pieces.begin() + 2, pieces.end(), propIdx.propList.begin());
-  std::string name = pieces[1];
+  // Splitting out the prop names is deferred to ensurePropIndex(), only the tag/edge name is
+  // decoded here.
+  propIdx.header = props;
   if (isEdge) {
     // The first character of the edge name is +/-.
     if (UNLIKELY(name.empty() || (name[0] != '+' && name[0] != '-'))) {
       return Status::Error("Bad edge name: %s", name.c_str());
     }
     dsIndex->tagEdgeNameIndices.emplace(columnId, name);
-    dsIndex->edgePropsMap.emplace(name, std::move(propIdx));
+    dsIndex->edgePropsMap.emplace(std::move(name), std::move(propIdx));
   } else {
     dsIndex->tagEdgeNameIndices.emplace(columnId, name);
-    dsIndex->tagPropsMap.emplace(name, std::move(propIdx));
+    dsIndex->tagPropsMap.emplace(std::move(name), std::move(propIdx));
   }
 
   return Status::OK();
 }
 
+void GetNeighborsIter::ensurePropIndex(PropIndex* propIdx) const {
+  if (propIdx->parsed) {
+    return;
+  }
+  std::vector<std::string> pieces;
+  folly::split(":", propIdx->header, pieces);
+  DCHECK_GE(pieces.size(), 2);
+  // if size == 2, it is the tag defined without props.
+  if (pieces.size() > 2) {
+    propIdx->propList.reserve(pieces.size() - 2);
+    for (size_t i = 2; i < pieces.size(); ++i) {
+      if (pieces[i] == kDst) {
+        propIdx->dstIdx = i - 2;
+      }
+      propIdx->propIndices.emplace(pieces[i], i - 2);
+      propIdx->propList.emplace_back(std::move(pieces[i]));
+    }
+  }
+  propIdx->parsed = true;
+}
+
 bool GetNeighborsIter::valid() const {
   return Iterator::valid() && valid_ && currentDs_ < dsIndices_.end() &&
          currentRow_ < rowsUpperBound_ && colIdx_ < currentDs_->colUpperBound;
@@ -205,57 +236,7 @@ void GetNeighborsIter::next() {
     return;
   }
 
-  while (++edgeIdx_ > -1) {
-    if (edgeIdx_ < edgeIdxUpperBound_) {
-      const auto& currentEdge = (*currentCol_)[edgeIdx_];
-      if (!currentEdge.isList()) {
-        continue;
-      }
-      ++bitIdx_;
-      DCHECK_GT(bitIdx_, -1);
-      if (static_cast<size_t>(bitIdx_) >= bitset_.size()) {
-        bitset_.push_back(true);
-      } else if (!bitset_[bitIdx_]) {
-        VLOG(1) << "Filtered: " << currentEdge << " bitidx: " << bitIdx_;
-        // current edge had been filtered.
-        continue;
-      }
-      currentEdge_ = &currentEdge.getList();
-      break;
-    }
-
-    // go to next column
-    while (++colIdx_) {
-      if (colIdx_ < currentDs_->colUpperBound) {
-        const auto& currentCol = currentRow_->operator[](colIdx_);
-        if (!currentCol.isList() || currentCol.getList().empty()) {
-          continue;
-        }
-
-        currentCol_ = &currentCol.getList();
-        edgeIdxUpperBound_ = currentCol_->size();
-        edgeIdx_ = -1;
-        break;
-      }
-      // go to next row
-      if (++currentRow_ < rowsUpperBound_) {
-        colIdx_ = currentDs_->colLowerBound;
-        continue;
-      }
-
-      // go to next dataset
-      if (++currentDs_ < dsIndices_.end()) {
-        colIdx_ = currentDs_->colLowerBound;
-        currentRow_ = currentDs_->ds->begin();
-        rowsUpperBound_ = currentDs_->ds->end();
-        continue;
-      }
-      break;
-    }
-    if (currentDs_ == dsIndices_.end()) {
-      break;
-    }
-  }
+  advanceSlot();
 }
 
 size_t GetNeighborsIter::size() const {
@@ -282,9 +263,9 @@ size_t GetNeighborsIter::numRows() const {
 }
 
 void GetNeighborsIter::erase() {
-  DCHECK_GE(bitIdx_, 0);
-  DCHECK_LT(bitIdx_, bitset_.size());
-  bitset_[bitIdx_] = false;
+  NG_SAMPLED_DCHECK_GE(slotIdx_, 0);
+  NG_SAMPLED_DCHECK_LT(slotIdx_, bitset_.size());
+  bitset_[slotIdx_] = false;
   next();
 }
 
@@ -304,6 +285,9 @@ void GetNeighborsIter::sample(const int64_t count) {
     auto* col = std::get<0>(sample);
     col->emplace_back(std::move(std::get<1>(sample)));
   }
+  // The underlying lists changed, the slot pointers are stale; rebuild the edge block
+  // (and the bitset, since the sample already consumed the previous filter state)
+  buildEdgeBlock();
   doReset(0);
 }
 
@@ -321,7 +305,7 @@ const Value& GetNeighborsIter::getColumn(const std::string& col) const {
 }
 
 const Value& GetNeighborsIter::getColumn(int32_t index) const {
-  DCHECK_LT(index, currentRow_->values.size());
+  NG_SAMPLED_DCHECK_LT(index, currentRow_->values.size());
   return currentRow_->values[index];
 }
 
@@ -344,11 +328,12 @@ const Value& GetNeighborsIter::getTagProp(const std::string& tag, const std::str
   auto& row = *currentRow_;
   if (tag == "*") {
     for (auto& index : currentDs_->tagPropsMap) {
+      ensurePropIndex(&index.second);
       auto propIndexIter = index.second.propIndices.find(prop);
       if (propIndexIter != index.second.propIndices.end()) {
         colId = index.second.colIdx;
         propId = propIndexIter->second;
-        DCHECK_GT(row.size(), colId);
+        NG_SAMPLED_DCHECK_GT(row.size(), colId);
         if (row[colId].empty()) {
           continue;
         }
@@ -371,13 +356,14 @@ const Value& GetNeighborsIter::getTagProp(const std::string& tag, const std::str
     if (index == tagPropIndices.end()) {
       return Value::kEmpty;
     }
+    ensurePropIndex(&index->second);
     auto propIndexIter = index->second.propIndices.find(prop);
     if (propIndexIter == index->second.propIndices.end()) {
       return Value::kEmpty;
     }
     colId = index->second.colIdx;
     propId = propIndexIter->second;
-    DCHECK_GT(row.size(), colId);
+    NG_SAMPLED_DCHECK_GT(row.size(), colId);
     if (row[colId].empty()) {
       return Value::kEmpty;
     }
@@ -408,6 +394,17 @@ const Value& GetNeighborsIter::getEdgeProp(const std::string& edge, const std::s
     DLOG(INFO) << "No edge found: " << edge << " Current edge: " << currentEdge;
     return Value::kEmpty;
   }
+  ensurePropIndex(&index->second);
+  if (prop == kDst) {
+    // Fast path for dst-only reads, e.g. `GO ... YIELD dst(edge)': the dst offset is cached in
+    // the PropIndex, no per-row prop-name lookup
+    auto dstIdx = index->second.dstIdx;
+    if (dstIdx < 0) {
+      VLOG(1) << "No edge prop found: " << prop;
+      return Value::kEmpty;
+    }
+    return currentEdge_->values[dstIdx];
+  }
   auto propIndex = index->second.propIndices.find(prop);
   if (propIndex == index->second.propIndices.end()) {
     VLOG(1) << "No edge prop found: " << prop;
@@ -430,6 +427,7 @@ Value GetNeighborsIter::getVertex(const std::string& name) {
   vertex.vid = vidVal;
   auto& tagPropMap = currentDs_->tagPropsMap;
   for (auto& tagProp : tagPropMap) {
+    ensurePropIndex(&tagProp.second);
     auto& row = *currentRow_;
     auto& tagPropNameList = tagProp.second.propList;
     auto tagColId = tagProp.second.colIdx;
@@ -437,9 +435,9 @@ Value GetNeighborsIter::getVertex(const std::string& name) {
       // Ignore the bad value.
       continue;
     }
-    DCHECK_GE(row.size(), tagColId);
+    NG_SAMPLED_DCHECK_GE(row.size(), tagColId);
     auto& propList = row[tagColId].getList();
-    DCHECK_EQ(tagPropNameList.size(), propList.values.size());
+    NG_SAMPLED_DCHECK_EQ(tagPropNameList.size(), propList.values.size());
     Tag tag;
     tag.name = tagProp.first;
     for (size_t i = 0; i < propList.size(); ++i) {
@@ -529,9 +527,10 @@ Value GetNeighborsIter::getEdge() const {
   if (edgeProp == edgePropMap.end()) {
     return Value::kNullValue;
   }
+  ensurePropIndex(&edgeProp->second);
   auto& edgeNamePropList = edgeProp->second.propList;
   auto& propList = currentEdge_->values;
-  DCHECK_EQ(edgeNamePropList.size(), propList.size());
+  NG_SAMPLED_DCHECK_EQ(edgeNamePropList.size(), propList.size());
   for (size_t i = 0; i < propList.size(); ++i) {
     auto propName = edgeNamePropList[i];
     if (propName == kDst || propName == kRank || propName == kType || propName == kSrc) {
@@ -560,7 +559,7 @@ void GetNeighborsIter::nextCol() {
   if (!valid()) {
     return;
   }
-  DCHECK(!noEdge_);
+  NG_SAMPLED_DCHECK(!noEdge_);
 
   // go to next column
   while (++colIdx_) {
@@ -571,8 +570,6 @@ void GetNeighborsIter::nextCol() {
       }
 
       currentCol_ = &currentCol.getList();
-      // edgeIdxUpperBound_ = currentCol_->size();
-      // edgeIdx_ = -1;
       break;
     }
     // go to next row
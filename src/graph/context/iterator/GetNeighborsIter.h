@@ -109,7 +109,7 @@ class GetNeighborsIter final : public Iterator {
   void doReset(size_t pos) override {
     UNUSED(pos);
     valid_ = false;
-    bitIdx_ = -1;
+    slotIdx_ = -1;
     goToFirstEdge();
   }
 
@@ -130,10 +130,29 @@ class GetNeighborsIter final : public Iterator {
 
   struct PropIndex {
     size_t colIdx;
+    // raw column header, e.g. "_edge:+e1:p1:p2:_dst"; propList/propIndices are split out of it
+    // on first access, queries which never read the props of this tag/edge skip the decode
+    std::string header;
+    bool parsed{false};
+    // offset of kDst in propList, -1 if absent; lets dst-only reads skip the prop-name lookup
+    int64_t dstIdx{-1};
     std::vector<std::string> propList;
     std::unordered_map<std::string, size_t> propIndices;
   };
 
+  // Flat struct-of-arrays view over the nested response: one slot per edge prop List,
+  // laid out contiguously in iteration order. The slot carries everything next() needs
+  // to reposition the cursor, so advancing the iterator is a single index bump plus a
+  // bitset check instead of re-walking the dataset/row/column/edge nesting with a type
+  // test at every level. Slots index into `bitset_' one-to-one, which is what erase()
+  // flips. Borrowed pointers: rebuilt whenever the underlying lists mutate (sample()).
+  struct EdgeSlot {
+    uint32_t dsIdx;
+    uint32_t rowIdx;
+    uint32_t colIdx;
+    const List* edge;
+  };
+
   struct DataSetIndex {
     const DataSet* ds;
     // | _vid | _stats | _tag:t1:p1:p2 | _edge:e1:p1:p2 |
@@ -153,6 +172,12 @@ class GetNeighborsIter final : public Iterator {
 
   Status processList(std::shared_ptr<Value> value);
 
+  // Walk the nested layout once and materialize the flat edge slot table
+  void buildEdgeBlock();
+
+  // Move slotIdx_ to the next unfiltered slot and load it into the cursor members
+  void advanceSlot();
+
   void goToFirstEdge();
 
   StatusOr<int64_t> buildIndex(DataSetIndex* dsIndex);
@@ -162,6 +187,9 @@ class GetNeighborsIter final : public Iterator {
                         bool isEdge,
                         DataSetIndex* dsIndex);
 
+  // Split the prop names out of the column header on first access
+  void ensurePropIndex(PropIndex* propIdx) const;
+
   StatusOr<DataSetIndex> makeDataSetIndex(const DataSet& ds);
 
   FRIEND_TEST(IteratorTest, TestHead);
@@ -178,12 +206,12 @@ class GetNeighborsIter final : public Iterator {
   const List* currentCol_{nullptr};
 
   bool noEdge_{false};
-  int64_t edgeIdx_{-1};
-  int64_t edgeIdxUpperBound_{-1};
   const List* currentEdge_{nullptr};
 
+  std::vector<EdgeSlot> edgeSlots_;
+  int64_t slotIdx_{-1};
+
   boost::dynamic_bitset<> bitset_;
-  int64_t bitIdx_{-1};
   Value prevVertex_;
 };
 
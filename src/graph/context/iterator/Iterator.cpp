@@ -43,6 +43,9 @@ std::ostream& operator<<(std::ostream& os, Iterator::Kind kind) {
     case Iterator::Kind::kProp:
       os << "Prop";
       break;
+    case Iterator::Kind::kRowBatch:
+      os << "row batch";
+      break;
   }
   os << " iterator";
   return os;
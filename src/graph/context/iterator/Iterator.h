@@ -34,6 +34,7 @@ class Iterator {
     kGetNeighbors,
     kSequential,
     kProp,
+    kRowBatch,
   };
 
   Iterator(std::shared_ptr<Value> value, Kind kind, bool checkMemory = false)
@@ -112,6 +113,10 @@ class Iterator {
     return kind_ == Kind::kProp;
   }
 
+  bool isRowBatchIter() const {
+    return kind_ == Kind::kRowBatch;
+  }
+
   // The derived class should rewrite get prop if the Value is kind of dataset.
   virtual const Value& getColumn(const std::string& col) const = 0;
 
@@ -0,0 +1,163 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/context/iterator/RowBatchIter.h"
+
+#include <numeric>
+
+#include "common/algorithm/ReservoirSampling.h"
+
+namespace nebula {
+namespace graph {
+
+RowBatchIter::RowBatchIter(std::shared_ptr<RowBatch> batch, bool checkMemory)
+    : Iterator(std::make_shared<Value>(), Kind::kRowBatch, checkMemory),
+      batch_(std::move(batch)) {
+  DCHECK(batch_ != nullptr);
+  seq_.resize(batch_->rowSize());
+  std::iota(seq_.begin(), seq_.end(), 0);
+  const auto& colNames = batch_->colNames();
+  for (size_t i = 0; i < colNames.size(); ++i) {
+    colIndices_.emplace(colNames[i], i);
+  }
+  colCache_.resize(batch_->colSize());
+  colCached_.resize(batch_->colSize(), false);
+}
+
+RowBatchIter::RowBatchIter(const RowBatchIter& iter)
+    : Iterator(iter.valuePtr(), Kind::kRowBatch, iter.checkMemory()),
+      batch_(iter.batch_),
+      seq_(iter.seq_),
+      colIndices_(iter.colIndices_) {
+  colCache_.resize(batch_->colSize());
+  colCached_.resize(batch_->colSize(), false);
+}
+
+bool RowBatchIter::valid() const {
+  return Iterator::valid() && idx_ < seq_.size();
+}
+
+void RowBatchIter::next() {
+  if (valid()) {
+    ++numRowsModN_;
+    ++idx_;
+    invalidateCaches();
+  }
+}
+
+void RowBatchIter::erase() {
+  seq_.erase(seq_.begin() + idx_);
+  invalidateCaches();
+}
+
+void RowBatchIter::unstableErase() {
+  std::swap(seq_.back(), seq_[idx_]);
+  seq_.pop_back();
+  invalidateCaches();
+}
+
+void RowBatchIter::eraseRange(size_t first, size_t last) {
+  if (first >= last || first >= size()) {
+    return;
+  }
+  if (last > size()) {
+    seq_.erase(seq_.begin() + first, seq_.end());
+  } else {
+    seq_.erase(seq_.begin() + first, seq_.begin() + last);
+  }
+  reset();
+}
+
+void RowBatchIter::select(std::size_t offset, std::size_t count) {
+  auto sz = size();
+  if (sz <= offset) {
+    clear();
+  } else if (sz > offset + count) {
+    eraseRange(0, offset);
+    eraseRange(count, sz - offset);
+  } else {
+    eraseRange(0, offset);
+  }
+}
+
+void RowBatchIter::sample(int64_t count) {
+  DCHECK_GE(count, 0);
+  algorithm::ReservoirSampling<std::size_t> sampler(count);
+  for (auto handle : seq_) {
+    sampler.sampling(std::move(handle));
+  }
+  seq_ = std::move(sampler).samples();
+  reset();
+}
+
+void RowBatchIter::doReset(size_t pos) {
+  DCHECK((pos == 0 && size() == 0) || (pos < size()));
+  idx_ = pos;
+  invalidateCaches();
+}
+
+const Value& RowBatchIter::getColumn(const std::string& col) const {
+  if (!valid()) {
+    return Value::kNullValue;
+  }
+  auto index = colIndices_.find(col);
+  if (index == colIndices_.end()) {
+    return Value::kNullValue;
+  }
+  return columnAt(index->second);
+}
+
+const Value& RowBatchIter::getColumn(int32_t index) const {
+  if (!valid()) {
+    return Value::kNullValue;
+  }
+  int32_t sz = static_cast<int32_t>(batch_->colSize());
+  if ((index > 0 && index >= sz) || (index < 0 && -index > sz)) {
+    return Value::kNullBadType;
+  }
+  return columnAt((sz + index) % sz);
+}
+
+StatusOr<std::size_t> RowBatchIter::getColumnIndex(const std::string& col) const {
+  auto index = colIndices_.find(col);
+  if (index == colIndices_.end()) {
+    return Status::Error("Don't exist column `%s'.", col.c_str());
+  }
+  return index->second;
+}
+
+const Row* RowBatchIter::row() const {
+  DCHECK(valid());
+  if (!rowCached_) {
+    rowCache_ = batch_->rowAt(seq_[idx_]);
+    rowCached_ = true;
+  }
+  return &rowCache_;
+}
+
+Row RowBatchIter::moveRow() {
+  DCHECK(valid());
+  if (!rowCached_) {
+    rowCache_ = batch_->rowAt(seq_[idx_]);
+  }
+  rowCached_ = false;
+  return std::move(rowCache_);
+}
+
+const Value& RowBatchIter::columnAt(std::size_t col) const {
+  if (!colCached_[col]) {
+    colCache_[col] = batch_->valueAt(seq_[idx_], col);
+    colCached_[col] = true;
+  }
+  return colCache_[col];
+}
+
+void RowBatchIter::invalidateCaches() const {
+  std::fill(colCached_.begin(), colCached_.end(), false);
+  rowCached_ = false;
+}
+
+}  // namespace graph
+}  // namespace nebula
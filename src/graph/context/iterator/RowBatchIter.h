@@ -0,0 +1,94 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_CONTEXT_ITERATOR_ROWBATCHITER_H_
+#define GRAPH_CONTEXT_ITERATOR_ROWBATCHITER_H_
+
+#include "common/datatypes/RowBatch.h"
+#include "graph/context/iterator/Iterator.h"
+
+namespace nebula {
+namespace graph {
+
+// Sequential iterator over an arena-backed RowBatch.
+//
+// Unlike SequentialIter it keeps no vector<Row>: cells stay encoded in the batch and a Value is
+// materialized only when a column is actually read. getColumn() caches the materialized Value
+// per row, so repeated reads of the same cell decode once, and row()/moveRow() materialize the
+// full current row on demand. Executors that only touch a few columns of wide rows never pay
+// for the rest.
+//
+// The batch itself is immutable; erase()/sample()/select() only drop row handles from the
+// iterator. The iterator holds no ExecutionContext value (valuePtr() is an empty Value), it is
+// meant for executor-internal staging of large intermediate results.
+class RowBatchIter final : public Iterator {
+ public:
+  explicit RowBatchIter(std::shared_ptr<RowBatch> batch, bool checkMemory = false);
+  explicit RowBatchIter(const RowBatchIter& iter);
+
+  std::unique_ptr<Iterator> copy() const override {
+    auto copy = std::make_unique<RowBatchIter>(*this);
+    copy->reset();
+    return copy;
+  }
+
+  bool valid() const override;
+
+  void next() override;
+
+  void erase() override;
+
+  void unstableErase() override;
+
+  void eraseRange(size_t first, size_t last) override;
+
+  void select(std::size_t offset, std::size_t count) override;
+
+  void sample(int64_t count) override;
+
+  void clear() override {
+    seq_.clear();
+    reset();
+  }
+
+  size_t size() const override {
+    return seq_.size();
+  }
+
+  const Value& getColumn(const std::string& col) const override;
+
+  const Value& getColumn(int32_t index) const override;
+
+  StatusOr<std::size_t> getColumnIndex(const std::string& col) const override;
+
+  const Row* row() const override;
+
+  Row moveRow() override;
+
+ protected:
+  void doReset(size_t pos) override;
+
+ private:
+  const Value& columnAt(std::size_t col) const;
+
+  void invalidateCaches() const;
+
+  std::shared_ptr<RowBatch> batch_;
+  // handles into the batch; erase operations only drop handles, the rows stay in the arena
+  std::vector<std::size_t> seq_;
+  std::size_t idx_{0};
+  std::unordered_map<std::string, std::size_t> colIndices_;
+
+  // per-row materialization caches, invalidated when the iterator moves
+  mutable std::vector<Value> colCache_;
+  mutable std::vector<bool> colCached_;
+  mutable Row rowCache_;
+  mutable bool rowCached_{false};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_CONTEXT_ITERATOR_ROWBATCHITER_H_
@@ -836,6 +836,61 @@ TEST(IteratorTest, EraseBySwap) {
   }
   EXPECT_EQ(result, expected);
 }
+
+TEST(IteratorTest, RowBatch) {
+  DataSet ds;
+  ds.colNames = {"col1", "col2"};
+  for (auto i = 0; i < 10; ++i) {
+    Row row;
+    row.values.emplace_back(i);
+    row.values.emplace_back(folly::to<std::string>(i));
+    ds.rows.emplace_back(std::move(row));
+  }
+  auto batch = RowBatch::fromDataSet(ds);
+  {
+    RowBatchIter iter(batch);
+    EXPECT_EQ(iter.size(), 10);
+    auto i = 0;
+    for (; iter.valid(); iter.next()) {
+      EXPECT_EQ(iter.getColumn("col1"), i);
+      EXPECT_EQ(iter.getColumn("col2"), folly::to<std::string>(i));
+      EXPECT_EQ(iter.getColumn(0), i);
+      EXPECT_EQ(iter.getColumn(-1), folly::to<std::string>(i));
+      EXPECT_EQ(*iter.row(), ds.rows[i]);
+      ++i;
+    }
+    EXPECT_EQ(i, 10);
+  }
+  {
+    // erase only drops handles, the batch itself stays intact
+    RowBatchIter iter(batch);
+    while (iter.valid()) {
+      if (iter.getColumn("col1").getInt() % 2 == 0) {
+        iter.erase();
+      } else {
+        iter.next();
+      }
+    }
+    iter.reset();
+    EXPECT_EQ(iter.size(), 5);
+    auto i = 1;
+    for (; iter.valid(); iter.next()) {
+      EXPECT_EQ(iter.getColumn("col1"), i);
+      i += 2;
+    }
+    EXPECT_EQ(batch->rowSize(), 10);
+  }
+  {
+    RowBatchIter iter(batch);
+    iter.select(2, 3);
+    EXPECT_EQ(iter.size(), 3);
+    auto i = 2;
+    for (; iter.valid(); iter.next()) {
+      EXPECT_EQ(iter.moveRow(), ds.rows[i]);
+      ++i;
+    }
+  }
+}
 }  // namespace graph
 }  // namespace nebula
 
@@ -9,10 +9,12 @@
 
 #include <algorithm>
 #include <atomic>
+#include <chrono>
 
 #include "common/base/ObjectPool.h"
 #include "common/memory/MemoryUtils.h"
 #include "common/stats/StatsManager.h"
+#include "common/stats/TraceBuffer.h"
 #include "graph/context/ExecutionContext.h"
 #include "graph/executor/ExecutionError.h"
 #include "graph/executor/admin/AddHostsExecutor.h"
@@ -67,6 +69,7 @@
 #include "graph/executor/query/AggregateExecutor.h"
 #include "graph/executor/query/AppendVerticesExecutor.h"
 #include "graph/executor/query/AssignExecutor.h"
+#include "graph/executor/query/CountFromStatsExecutor.h"
 #include "graph/executor/query/DataCollectExecutor.h"
 #include "graph/executor/query/DedupExecutor.h"
 #include "graph/executor/query/ExpandAllExecutor.h"
@@ -109,6 +112,7 @@ using folly::stringPrintf;
 
 DEFINE_bool(enable_lifetime_optimize, true, "Does enable the lifetime optimize.");
 DECLARE_double(system_memory_high_watermark_ratio);
+DECLARE_uint64(heavy_query_rows_threshold);
 
 namespace nebula {
 namespace graph {
@@ -261,6 +265,9 @@ Executor *Executor::makeExecutor(QueryContext *qctx, const PlanNode *node) {
     case PlanNode::Kind::kValue: {
       return pool->makeAndAdd<ValueExecutor>(node, qctx);
     }
+    case PlanNode::Kind::kCountFromStats: {
+      return pool->makeAndAdd<CountFromStatsExecutor>(node, qctx);
+    }
     case PlanNode::Kind::kAssign: {
       return pool->makeAndAdd<AssignExecutor>(node, qctx);
     }
@@ -604,6 +611,12 @@ Status Executor::open() {
   numRows_ = 0;
   execTime_ = 0;
   totalDuration_.reset();
+  if (stats::TraceBuffer::instance().enabled()) {
+    traceStartNs_ =
+        std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch())
+            .count();
+  }
   return Status::OK();
 }
 
@@ -614,11 +627,26 @@ Status Executor::close() {
   stats.totalDurationInUs = totalDuration_.elapsedInUSec();
   stats.rows = numRows_;
   stats.execDurationInUs = execTime_;
+  // Runtime feedback for the cost model: put the optimizer's cardinality estimate next to
+  // the actual row count, so mis-estimates show up directly in the PROFILE output
+  if (node_->cost() > 0.0) {
+    addState("estimatedRows", folly::dynamic(node_->cost()));
+  }
   if (!otherStats_.empty()) {
     stats.otherStats =
         std::make_unique<std::unordered_map<std::string, std::string>>(std::move(otherStats_));
   }
   qctx()->plan()->addProfileStats(node_->id(), std::move(stats));
+  auto &traceBuffer = stats::TraceBuffer::instance();
+  if (traceBuffer.enabled() && traceStartNs_ > 0) {
+    auto sessionId = qctx()->rctx() ? qctx()->rctx()->session()->id() : 0;
+    traceBuffer.record(sessionId,
+                       qctx()->plan()->id(),
+                       name_.c_str(),
+                       node_->id(),
+                       traceStartNs_,
+                       totalDuration_.elapsedInUSec() * 1000);
+  }
   return Status::OK();
 }
 
@@ -636,6 +664,16 @@ Status Executor::checkMemoryWatermark() {
   return Status::OK();
 }
 
+void Executor::addPerfStats(int64_t cycles, int64_t cacheMisses, int64_t allocatedBytes) {
+  if (cycles >= 0) {
+    addState("cpuCycles", folly::dynamic(cycles));
+  }
+  if (cacheMisses >= 0) {
+    addState("cacheMisses", folly::dynamic(cacheMisses));
+  }
+  addState("allocatedBytes", folly::dynamic(allocatedBytes));
+}
+
 folly::Future<Status> Executor::start(Status status) const {
   return folly::makeFuture(std::move(status)).via(runner());
 }
@@ -744,6 +782,16 @@ Status Executor::finish(Result &&result) {
   if (FLAGS_enable_lifetime_optimize) {
     drop();
   }
+  // The plan time workload classification underestimated this query, move the rest of it to
+  // the heavy pool so it stops competing with point lookups. The runner pointer swap is
+  // best-effort: executors already scheduled finish where they are, later ones follow it
+  auto *heavyRunner = qctx()->heavyRunner();
+  if (heavyRunner != nullptr && numRows_ > FLAGS_heavy_query_rows_threshold &&
+      qctx()->rctx() != nullptr && qctx()->rctx()->runner() != heavyRunner) {
+    VLOG(1) << "Executor " << name_ << " produced " << numRows_
+            << " rows, demoting the query to the heavy pool";
+    qctx()->rctx()->setRunner(heavyRunner);
+  }
   return Status::OK();
 }
 
@@ -762,6 +810,11 @@ folly::Executor *Executor::runner() const {
 size_t Executor::getBatchSize(size_t totalSize) const {
   // batch size should be the greater one of FLAGS_min_batch_size and (totalSize/FLAGS_max_job_size)
   size_t jobSize = FLAGS_max_job_size;
+  // Respect the per-branch budget assigned by Scheduler::analyzeParallelism, if any
+  size_t jobLimit = node_->jobLimit();
+  if (jobLimit > 0 && jobLimit < jobSize) {
+    jobSize = jobLimit;
+  }
   size_t minBatchSize = FLAGS_min_batch_size;
   size_t batchSizeTmp = std::ceil(static_cast<float>(totalSize) / jobSize);
   size_t batchSize = batchSizeTmp > minBatchSize ? batchSizeTmp : minBatchSize;
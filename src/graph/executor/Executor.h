@@ -77,6 +77,11 @@ class Executor : private boost::noncopyable, private cpp::NonMovable {
   // Throw runtime error to stop whole execution early
   folly::Future<Status> error(Status status) const;
 
+  // Attach one hardware counter sample to the profiling stats of this executor, called by
+  // PerfCounterScope when --enable_profile_hardware_counters is on. Negative counter values
+  // mean the counter could not be read and are skipped.
+  void addPerfStats(int64_t cycles, int64_t cacheMisses, int64_t allocatedBytes);
+
   static Status memoryExceededStatus() {
     return Status::GraphMemoryExceeded(
         "(%d)", static_cast<int32_t>(nebula::cpp2::ErrorCode::E_GRAPH_MEMORY_EXCEEDED));
@@ -161,6 +166,8 @@ class Executor : private boost::noncopyable, private cpp::NonMovable {
   uint64_t numRows_{0};
   uint64_t execTime_{0};
   time::Duration totalDuration_;
+  // Span start, only taken when --trace_span_buffer_size enables tracing
+  int64_t traceStartNs_{0};
 
  private:
   std::mutex statsLock_;
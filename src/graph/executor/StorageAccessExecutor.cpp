@@ -173,6 +173,7 @@ folly::Future<std::vector<Value>> StorageAccessExecutor::getProps(
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx_->deadlineUs();
   return DCHECK_NOTNULL(storageClient)
       ->getProps(
           param, std::move(vertices), vertexPropPtr, nullptr, nullptr, false, {}, -1, nullptr)
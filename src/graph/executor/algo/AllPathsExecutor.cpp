@@ -133,6 +133,7 @@ folly::Future<Status> AllPathsExecutor::getNeighbors(bool reverse) {
                                                    qctx_->rctx()->session()->id(),
                                                    qctx_->plan()->id(),
                                                    qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx_->deadlineUs();
   auto& vids = reverse ? rightNextStepVids_ : leftNextStepVids_;
   auto filter = pathNode_->filter() ? pathNode_->filter()->clone() : nullptr;
   return storageClient
@@ -236,7 +237,26 @@ folly::Future<Status> AllPathsExecutor::buildResult() {
       });
 }
 
+void AllPathsExecutor::buildEdgeTable(bool reverse) {
+  auto& adjList = reverse ? rightAdjList_ : leftAdjList_;
+  auto& table = reverse ? rightEdgeTable_ : leftEdgeTable_;
+  auto& adjIndex = reverse ? rightAdjIndex_ : leftAdjIndex_;
+  adjIndex.reserve(adjList.size());
+  for (auto& entry : adjList) {
+    auto first = static_cast<uint32_t>(table.size());
+    for (auto& edge : entry.second) {
+      table.emplace_back(&edge, &entry.first);
+    }
+    adjIndex.emplace(entry.first,
+                     std::make_pair(first, static_cast<uint32_t>(entry.second.size())));
+  }
+}
+
 folly::Future<Status> AllPathsExecutor::buildPathMultiJobs() {
+  // Expansion is done, the adjacency lists are stable from here on; index them so partial
+  // paths can refer to edges by dense id instead of holding values
+  buildEdgeTable(false);
+  buildEdgeTable(true);
   std::vector<folly::Future<std::vector<NPath*>>> futures;
   auto leftFuture = folly::via(runner(), [this]() { return doBuildPath(1, 0, 0, nullptr, false); })
                         .thenError(folly::tag_t<std::bad_alloc>{},
@@ -312,7 +332,7 @@ folly::Future<std::vector<AllPathsExecutor::NPath*>> AllPathsExecutor::doBuildPa
   if (threadLocalPtr_.get() == nullptr) {
     threadLocalPtr_.reset(new std::deque<NPath>());
   }
-  auto& adjList = reverse ? rightAdjList_ : leftAdjList_;
+  auto& adjIndex = reverse ? rightAdjIndex_ : leftAdjIndex_;
   auto newPathsPtr = std::make_shared<std::vector<NPath*>>();
 
   if (step == 1) {
@@ -321,22 +341,20 @@ folly::Future<std::vector<AllPathsExecutor::NPath*>> AllPathsExecutor::doBuildPa
       if (memoryExceeded_.load(std::memory_order_acquire) == true) {
         return folly::makeFuture<std::vector<NPath*>>(std::vector<NPath*>());
       }
-      auto vidIter = adjList.find(vid);
-      if (vidIter == adjList.end()) {
-        continue;
-      }
-      auto& src = vidIter->first;
-      auto& adjEdges = vidIter->second;
-      if (adjEdges.empty()) {
+      auto vidIter = adjIndex.find(vid);
+      if (vidIter == adjIndex.end()) {
         continue;
       }
-      for (auto& edge : adjEdges) {
+      auto first = vidIter->second.first;
+      auto last = first + vidIter->second.second;
+      for (auto eid = first; eid < last; ++eid) {
         if (noLoop_) {
-          if (edge.getEdge().dst == edge.getEdge().src) {
+          const auto& edge = edgeValue(reverse, eid).getEdge();
+          if (edge.dst == edge.src) {
             continue;
           }
         }
-        threadLocalPtr_->emplace_back(NPath(src, edge));
+        threadLocalPtr_->emplace_back(eid);
         newPathsPtr->emplace_back(&threadLocalPtr_->back());
       }
     }
@@ -346,25 +364,26 @@ folly::Future<std::vector<AllPathsExecutor::NPath*>> AllPathsExecutor::doBuildPa
         return folly::makeFuture<std::vector<NPath*>>(std::vector<NPath*>());
       }
       auto path = (*pathsPtr)[i];
-      auto& edgeValue = path->edge;
-      DCHECK(edgeValue.isEdge());
-      auto& dst = edgeValue.getEdge().dst;
-      auto adjIter = adjList.find(dst);
-      if (adjIter == adjList.end()) {
+      const auto& lastEdge = edgeValue(reverse, path->edgeId);
+      DCHECK(lastEdge.isEdge());
+      auto& dst = lastEdge.getEdge().dst;
+      auto adjIter = adjIndex.find(dst);
+      if (adjIter == adjIndex.end()) {
         continue;
       }
-      auto& adjEdges = adjIter->second;
-      for (auto& edge : adjEdges) {
+      auto first = adjIter->second.first;
+      auto last = first + adjIter->second.second;
+      for (auto eid = first; eid < last; ++eid) {
         if (noLoop_) {
-          if (hasSameVertices(path, edge.getEdge())) {
+          if (hasSameVertices(path, edgeValue(reverse, eid).getEdge(), reverse)) {
             continue;
           }
         } else {
-          if (hasSameEdge(path, edge.getEdge())) {
+          if (hasSameEdge(path, eid)) {
             continue;
           }
         }
-        threadLocalPtr_->emplace_back(NPath(path, adjIter->first, edge));
+        threadLocalPtr_->emplace_back(path, eid);
         newPathsPtr->emplace_back(&threadLocalPtr_->back());
       }
     }
@@ -426,8 +445,8 @@ std::vector<Value> AllPathsExecutor::convertNPath2List(NPath* path, bool reverse
   std::vector<Value> list;
   NPath* head = path;
   while (head != nullptr) {
-    list.emplace_back(head->edge);
-    list.emplace_back(head->vertex);
+    list.emplace_back(edgeValue(reverse, head->edgeId));
+    list.emplace_back(srcVertexValue(reverse, head->edgeId));
     head = head->p;
   }
   if (!reverse) {
@@ -439,7 +458,8 @@ std::vector<Value> AllPathsExecutor::convertNPath2List(NPath* path, bool reverse
 void AllPathsExecutor::buildOneWayPath(std::vector<NPath*>& paths, bool reverse) {
   auto& initVids = reverse ? rightInitVids_ : leftInitVids_;
   for (auto& path : paths) {
-    auto& edgeVal = path->edge;
+    // The paths here come from the opposite direction, hence !reverse
+    const auto& edgeVal = edgeValue(!reverse, path->edgeId);
     auto& dst = edgeVal.getEdge().dst;
     auto findDst = initVids.find(dst);
     if (findDst == initVids.end()) {
@@ -606,7 +626,7 @@ folly::Future<Status> AllPathsExecutor::conjunctPath(std::vector<NPath*>& leftPa
 
 void AllPathsExecutor::buildHashTable(std::vector<NPath*>& paths, bool reverse) {
   for (auto& path : paths) {
-    auto& edgeVal = path->edge;
+    const auto& edgeVal = edgeValue(reverse, path->edgeId);
     const auto& edge = edgeVal.getEdge();
     auto findDst = hashTable_.find(edge.dst);
     if (findDst == hashTable_.end()) {
@@ -641,7 +661,8 @@ std::vector<Row> AllPathsExecutor::probe(size_t start, size_t end, bool reverse)
       break;
     }
     auto& probePath = probePaths_[i];
-    auto& edgeVal = probePath->edge;
+    // The probe paths come from the direction opposite to the hashed one
+    const auto& edgeVal = edgeValue(!reverse, probePath->edgeId);
     const auto& intersectVid = edgeVal.getEdge().dst;
     Value intersectVertex(Vertex(intersectVid, {}));
     auto findDst = hashTable_.find(intersectVid);
@@ -696,10 +717,12 @@ folly::Future<Status> AllPathsExecutor::getPathProps() {
   });
 }
 
-bool AllPathsExecutor::hasSameEdge(NPath* path, const Edge& edge) {
+bool AllPathsExecutor::hasSameEdge(NPath* path, uint32_t edgeId) {
+  // Every edge appears exactly once in the per-direction edge table, so comparing the dense
+  // ids is equivalent to comparing the edge values
   NPath* head = path;
   while (head != nullptr) {
-    if (edge == head->edge) {
+    if (head->edgeId == edgeId) {
       return true;
     }
     head = head->p;
@@ -707,14 +730,14 @@ bool AllPathsExecutor::hasSameEdge(NPath* path, const Edge& edge) {
   return false;
 }
 
-bool AllPathsExecutor::hasSameVertices(NPath* path, const Edge& edge) {
+bool AllPathsExecutor::hasSameVertices(NPath* path, const Edge& edge, bool reverse) {
   if (edge.src == edge.dst) {
     return true;
   }
   auto& vid = edge.dst;
   NPath* head = path;
   while (head != nullptr) {
-    auto& vertex = head->vertex;
+    auto& vertex = srcVertexValue(reverse, head->edgeId);
     if (vertex.getVertex().vid == vid) {
       return true;
     }
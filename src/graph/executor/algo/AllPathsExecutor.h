@@ -47,22 +47,39 @@ class AllPathsExecutor final : public StorageAccessExecutor {
   template <typename T = Value>
   using VertexMap = std::unordered_map<Value, std::vector<T>, VertexHash, VertexEqual>;
 
+  // A packed step of a partial path: `edgeId' dense-indexes the per-direction edge table and
+  // `p' links to the previous step, so one step costs 16 bytes no matter how wide the vertex
+  // and edge values are. The edge and its source vertex are resolved through the table, and
+  // full Paths are materialized only for final matches.
   struct NPath {
     NPath* p{nullptr};
-    const Value& vertex;
-    const Value& edge;
-    NPath(const Value& v, const Value& e) : vertex(v), edge(e) {}
-    NPath(NPath* path, const Value& v, const Value& e) : p(path), vertex(v), edge(e) {}
-    NPath(NPath&& v) noexcept : p(v.p), vertex(std::move(v.vertex)), edge(std::move(v.edge)) {}
-    NPath(const NPath& v) : p(v.p), vertex(v.vertex), edge(v.edge) {}
-    ~NPath() {}
+    uint32_t edgeId{0};
+    explicit NPath(uint32_t e) : edgeId(e) {}
+    NPath(NPath* path, uint32_t e) : p(path), edgeId(e) {}
   };
 
+  // Dense int-mapped view of one adjacency list, built once when expansion finishes: entry
+  // i of the edge table points at the i-th edge value and its source vertex value inside the
+  // adjacency list, and the index maps a vertex to its contiguous range of edge ids
+  using EdgeTable = std::vector<std::pair<const Value*, const Value*>>;
+  using AdjIndex =
+      std::unordered_map<Value, std::pair<uint32_t, uint32_t>, VertexHash, VertexEqual>;
+
  private:
   void buildRequestVids(bool reverse);
 
   Direction direction();
 
+  void buildEdgeTable(bool reverse);
+
+  const Value& edgeValue(bool reverse, uint32_t edgeId) const {
+    return *(reverse ? rightEdgeTable_ : leftEdgeTable_)[edgeId].first;
+  }
+
+  const Value& srcVertexValue(bool reverse, uint32_t edgeId) const {
+    return *(reverse ? rightEdgeTable_ : leftEdgeTable_)[edgeId].second;
+  }
+
   folly::Future<Status> doAllPaths();
 
   folly::Future<Status> getNeighbors(bool reverse);
@@ -90,9 +107,9 @@ class AllPathsExecutor final : public StorageAccessExecutor {
   folly::Future<Status> conjunctPath(std::vector<NPath*>& leftPaths,
                                      std::vector<NPath*>& rightPaths);
 
-  bool hasSameEdge(NPath* path, const Edge& edge);
+  bool hasSameEdge(NPath* path, uint32_t edgeId);
 
-  bool hasSameVertices(NPath* path, const Edge& edge);
+  bool hasSameVertices(NPath* path, const Edge& edge, bool reverse);
 
   bool hasSameEdge(std::vector<Value>& leftPaths, std::vector<Value>& rightPaths);
 
@@ -125,6 +142,11 @@ class AllPathsExecutor final : public StorageAccessExecutor {
   VertexMap<Value> leftAdjList_;
   VertexMap<Value> rightAdjList_;
 
+  EdgeTable leftEdgeTable_;
+  EdgeTable rightEdgeTable_;
+  AdjIndex leftAdjIndex_;
+  AdjIndex rightAdjIndex_;
+
   DataSet result_;
   std::vector<Value> emptyPropVids_;
   std::unordered_multiset<Value, VertexHash, VertexEqual> emptyPropVertices_;
@@ -151,6 +151,7 @@ folly::Future<Status> BatchShortestPath::getNeighbors(size_t rowNum, size_t step
                                                    qctx_->rctx()->session()->id(),
                                                    qctx_->plan()->id(),
                                                    qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx_->deadlineUs();
   auto& inputVids = reverse ? rightVids_[rowNum] : leftVids_[rowNum];
   std::vector<Value> vids(inputVids.begin(), inputVids.end());
   inputVids.clear();
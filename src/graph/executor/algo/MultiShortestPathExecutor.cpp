@@ -96,7 +96,7 @@ void MultiShortestPathExecutor::init() {
   for (; rIter->valid(); rIter->next()) {
     auto& vid = rIter->getColumn(0);
     if (rightVids.emplace(vid).second) {
-      std::vector<Path> tmp({Path(Vertex(vid, {}), {})});
+      PathList tmp({internRoot(vid, true)});
       historyRightPaths_[vid].emplace(vid, tmp);
       preRightPaths_[vid].emplace(vid, std::move(tmp));
     }
@@ -105,8 +105,7 @@ void MultiShortestPathExecutor::init() {
   std::set<Value> leftVids;
   for (; lIter->valid(); lIter->next()) {
     auto& vid = lIter->getColumn(0);
-    std::vector<Path> tmp({Path(Vertex(vid, {}), {})});
-    historyLeftPaths_[vid].emplace(vid, std::move(tmp));
+    historyLeftPaths_[vid].emplace(vid, PathList({internRoot(vid, false)}));
     leftVids.emplace(vid);
   }
   for (const auto& leftVid : leftVids) {
@@ -116,14 +115,51 @@ void MultiShortestPathExecutor::init() {
   }
 }
 
-std::vector<Path> MultiShortestPathExecutor::createPaths(const std::vector<Path>& paths,
-                                                         const Edge& edge) {
-  std::vector<Path> newPaths;
+const MultiShortestPathExecutor::PathStep* MultiShortestPathExecutor::internRoot(const Value& vid,
+                                                                                bool reverse) {
+  auto& roots = reverse ? rightRoots_ : leftRoots_;
+  auto found = roots.find(vid);
+  if (found != roots.end()) {
+    return found->second;
+  }
+  auto& root = (reverse ? rightStepPool_ : leftStepPool_).emplace_back();
+  root.vid = vid;
+  return roots.emplace(vid, &root).first->second;
+}
+
+const MultiShortestPathExecutor::PathStep* MultiShortestPathExecutor::newStep(
+    const PathStep* parent, const Edge& edge, bool reverse) {
+  auto& step = (reverse ? rightStepPool_ : leftStepPool_).emplace_back();
+  step.parent = parent;
+  step.vid = edge.dst;
+  step.type = edge.type;
+  step.ranking = edge.ranking;
+  step.name = edge.name;
+  return &step;
+}
+
+Path MultiShortestPathExecutor::materialize(const PathStep* leaf) const {
+  std::vector<const PathStep*> chain;
+  for (const auto* node = leaf; node != nullptr; node = node->parent) {
+    chain.emplace_back(node);
+  }
+  Path path;
+  path.src = Vertex(chain.back()->vid, {});
+  path.steps.reserve(chain.size() - 1);
+  for (auto i = chain.size() - 1; i-- > 0;) {
+    const auto* node = chain[i];
+    path.steps.emplace_back(Step(Vertex(node->vid, {}), node->type, node->name, node->ranking, {}));
+  }
+  return path;
+}
+
+MultiShortestPathExecutor::PathList MultiShortestPathExecutor::createPaths(const PathList& paths,
+                                                                           const Edge& edge,
+                                                                           bool reverse) {
+  PathList newPaths;
   newPaths.reserve(paths.size());
-  for (const auto& p : paths) {
-    Path path = p;
-    path.steps.emplace_back(Step(Vertex(edge.dst, {}), edge.type, edge.name, edge.ranking, {}));
-    newPaths.emplace_back(std::move(path));
+  for (const auto* p : paths) {
+    newPaths.emplace_back(newStep(p, edge, reverse));
   }
   return newPaths;
 }
@@ -145,22 +181,18 @@ Status MultiShortestPathExecutor::buildPath(bool reverse) {
       if (src == dst) {
         continue;
       }
-      Path path;
-      path.src = Vertex(src, {});
-      path.steps.emplace_back(Step(Vertex(dst, {}), edge.type, edge.name, edge.ranking, {}));
+      const auto* step = newStep(internRoot(src, reverse), edge, reverse);
       auto foundDst = currentPaths.find(dst);
       if (foundDst != currentPaths.end()) {
         auto foundSrc = foundDst->second.find(src);
         if (foundSrc != foundDst->second.end()) {
           // same <src, dst>, different edge type or rank
-          foundSrc->second.emplace_back(std::move(path));
+          foundSrc->second.emplace_back(step);
         } else {
-          std::vector<Path> tmp({std::move(path)});
-          foundDst->second.emplace(src, std::move(tmp));
+          foundDst->second.emplace(src, PathList({step}));
         }
       } else {
-        std::vector<Path> tmp({std::move(path)});
-        currentPaths[dst].emplace(src, std::move(tmp));
+        currentPaths[dst].emplace(src, PathList({step}));
       }
     }
   } else {
@@ -182,12 +214,12 @@ Status MultiShortestPathExecutor::buildPath(bool reverse) {
         if (foundDst == currentPaths.end()) {
           // dst not in current, new edge
           for (const auto& prePath : prePaths) {
-            currentPaths[dst].emplace(prePath.first, createPaths(prePath.second, edge));
+            currentPaths[dst].emplace(prePath.first, createPaths(prePath.second, edge, reverse));
           }
         } else {
           // dst in current
           for (const auto& prePath : prePaths) {
-            auto newPaths = createPaths(prePath.second, edge);
+            auto newPaths = createPaths(prePath.second, edge, reverse);
             auto foundSrc = foundDst->second.find(prePath.first);
             if (foundSrc == foundDst->second.end()) {
               foundDst->second.emplace(prePath.first, std::move(newPaths));
@@ -209,9 +241,9 @@ Status MultiShortestPathExecutor::buildPath(bool reverse) {
           }
           auto foundDst = currentPaths.find(dst);
           if (foundDst == currentPaths.end()) {
-            currentPaths[dst].emplace(prePath.first, createPaths(prePath.second, edge));
+            currentPaths[dst].emplace(prePath.first, createPaths(prePath.second, edge, reverse));
           } else {
-            auto newPaths = createPaths(prePath.second, edge);
+            auto newPaths = createPaths(prePath.second, edge, reverse);
             auto foundSrc = foundDst->second.find(prePath.first);
             if (foundSrc == foundDst->second.end()) {
               foundDst->second.emplace(prePath.first, std::move(newPaths));
@@ -235,11 +267,11 @@ Status MultiShortestPathExecutor::buildPath(bool reverse) {
 DataSet MultiShortestPathExecutor::doConjunct(
     const std::vector<std::pair<Interims::iterator, Interims::iterator>>& iters) {
   auto buildPaths =
-      [this](const std::vector<Path>& leftPaths, const std::vector<Path>& rightPaths, DataSet& ds) {
-        for (const auto& leftPath : leftPaths) {
-          for (const auto& rightPath : rightPaths) {
-            auto forwardPath = leftPath;
-            auto backwardPath = rightPath;
+      [this](const PathList& leftPaths, const PathList& rightPaths, DataSet& ds) {
+        for (const auto* leftLeaf : leftPaths) {
+          for (const auto* rightLeaf : rightPaths) {
+            auto forwardPath = materialize(leftLeaf);
+            auto backwardPath = materialize(rightLeaf);
             backwardPath.reverse();
             forwardPath.append(std::move(backwardPath));
             if (forwardPath.hasDuplicateEdges()) {
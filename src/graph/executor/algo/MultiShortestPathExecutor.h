@@ -7,6 +7,8 @@
 
 #include <robin_hood.h>
 
+#include <deque>
+
 #include "graph/executor/Executor.h"
 
 // MultiShortestPath has two inputs.  GetNeighbors(From) & GetNeighbors(To)
@@ -60,14 +62,29 @@ class MultiShortestPathExecutor final : public Executor {
   folly::Future<Status> execute() override;
 
  private:
-  // key: dst, value: {key : src, value: paths}
+  // One interned step of a partial path. Paths share their prefix through the parent pointer,
+  // so k paths over a common prefix store that prefix once instead of k full Path copies; a
+  // real Path is materialized only when the two halves meet at conjunct time, and steps are
+  // deduped by pointer identity since every node is allocated exactly once.
+  struct PathStep {
+    const PathStep* parent{nullptr};
+    Value vid;  // dst vid of this step, or the start vid for a root
+    EdgeType type{0};
+    EdgeRanking ranking{0};
+    std::string name;
+  };
+  using PathList = std::vector<const PathStep*>;
+  // key: dst, value: {key : src, value: interned path leaves}
   using Interims = robin_hood::unordered_flat_map<
       Value,
-      robin_hood::unordered_flat_map<Value, std::vector<Path>, std::hash<Value>>,
+      robin_hood::unordered_flat_map<Value, PathList, std::hash<Value>>,
       std::hash<Value>>;
 
   void init();
-  std::vector<Path> createPaths(const std::vector<Path>& paths, const Edge& edge);
+  const PathStep* internRoot(const Value& vid, bool reverse);
+  const PathStep* newStep(const PathStep* parent, const Edge& edge, bool reverse);
+  Path materialize(const PathStep* leaf) const;
+  PathList createPaths(const PathList& paths, const Edge& edge, bool reverse);
   Status buildPath(bool reverse);
   folly::Future<bool> conjunctPath(bool oddStep);
   DataSet doConjunct(const std::vector<std::pair<Interims::iterator, Interims::iterator>>& iters);
@@ -85,6 +102,11 @@ class MultiShortestPathExecutor final : public Executor {
   Interims preRightPaths_;
   Interims historyLeftPaths_;
   Interims historyRightPaths_;
+  // parent-pointer step pools, one per expansion side since the two sides build in parallel
+  std::deque<PathStep> leftStepPool_;
+  std::deque<PathStep> rightStepPool_;
+  robin_hood::unordered_flat_map<Value, const PathStep*, std::hash<Value>> leftRoots_;
+  robin_hood::unordered_flat_map<Value, const PathStep*, std::hash<Value>> rightRoots_;
   DataSet currentDs_;
   size_t limit_{std::numeric_limits<size_t>::max()};
   std::atomic<size_t> cnt_{0};
@@ -27,6 +27,7 @@ folly::Future<std::vector<Value>> ShortestPathBase::getMeetVidsProps(
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx_->deadlineUs();
   return DCHECK_NOTNULL(storageClient)
       ->getProps(param,
                  std::move(vertices),
@@ -6,6 +6,7 @@
 #include "common/memory/MemoryTracker.h"
 #include "graph/executor/algo/BatchShortestPath.h"
 #include "graph/executor/algo/SingleShortestPath.h"
+#include "graph/executor/algo/WeightedShortestPath.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/util/SchemaUtil.h"
 #include "sys/sysinfo.h"
@@ -29,7 +30,9 @@ folly::Future<Status> ShortestPathExecutor::execute() {
   size_t rowSize = checkInput(startVids, endVids);
   std::unique_ptr<ShortestPathBase> pathPtr = nullptr;
   std::unordered_map<std::string, std::string> stats;
-  if (rowSize <= FLAGS_num_path_thread) {
+  if (!FLAGS_weighted_shortest_path_prop.empty()) {
+    pathPtr = std::make_unique<WeightedShortestPath>(pathNode_, qctx_, &stats);
+  } else if (rowSize <= FLAGS_num_path_thread) {
     pathPtr = std::make_unique<SingleShortestPath>(pathNode_, qctx_, &stats);
   } else {
     pathPtr = std::make_unique<BatchShortestPath>(pathNode_, qctx_, &stats);
@@ -117,6 +117,7 @@ folly::Future<Status> SingleShortestPath::getNeighbors(size_t rowNum,
                                                    qctx_->rctx()->session()->id(),
                                                    qctx_->plan()->id(),
                                                    qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx_->deadlineUs();
   auto& inputVids = reverse ? rightVids_[rowNum] : leftVids_[rowNum];
   std::vector<Value> vids(inputVids.begin(), inputVids.end());
   inputVids.clear();
@@ -33,6 +33,7 @@ folly::Future<Status> SubgraphExecutor::getNeighbors() {
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx_->deadlineUs();
 
   storage::cpp2::EdgeDirection edgeDirection{Direction::OUT_EDGE};
   return storageClient
@@ -105,7 +106,7 @@ void SubgraphExecutor::filterEdges(int version) {
     auto* gnIter = static_cast<GetNeighborsIter*>(iterPtr);
     while (gnIter->valid()) {
       const auto& dst = gnIter->getEdgeProp("*", nebula::kDst);
-      if (validVids_.find(dst) == validVids_.end()) {
+      if (!validVids_.contains(vidDict_.lookup(dst))) {
         auto edge = gnIter->getEdge();
         gnIter->erase();
       } else {
@@ -128,17 +129,20 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
   ResultBuilder builder;
   builder.value(iter->valuePtr());
 
-  HashMap currentVids;
-  currentVids.reserve(gnSize);
-  historyVids_.reserve(historyVids_.size() + gnSize);
+  // Vids discovered this step are committed to the history only after the scan, so the
+  // history checks below keep seeing the state of the previous steps
+  std::vector<std::pair<uint32_t, uint32_t>> pendingSteps;
+  pendingSteps.reserve(gnSize);
+  DenseIdSet currentVids;
+  vidDict_.reserve(vidDict_.size() + gnSize);
   auto startVids = iter->vids();
-  if (currentStep_ == 1) {
-    for (auto& startVid : startVids) {
-      currentVids.emplace(startVid, 0);
+  for (auto& startVid : startVids) {
+    auto id = vidDict_.intern(startVid);
+    if (currentStep_ == 1 && currentVids.insert(id)) {
+      pendingSteps.emplace_back(id, 0);
     }
+    validVids_.insert(id);
   }
-  validVids_.insert(std::make_move_iterator(startVids.begin()),
-                    std::make_move_iterator(startVids.end()));
   auto& biDirectEdgeTypes = subgraph_->biDirectEdgeTypes();
   while (iter->valid()) {
     const auto& dst = iter->getEdgeProp("*", nebula::kDst);
@@ -147,8 +151,9 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
       iter->next();
       continue;
     }
-    auto findIter = historyVids_.find(dst);
-    if (findIter != historyVids_.end()) {
+    auto id = vidDict_.intern(dst);
+    auto historyStep = id < historySteps_.size() ? historySteps_[id] : kNoStep;
+    if (historyStep != kNoStep) {
       if (biDirectEdgeTypes.empty()) {
         iter->next();
       } else {
@@ -159,7 +164,7 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
         }
         auto type = typeVal.getInt();
         if (biDirectEdgeTypes.find(type) != biDirectEdgeTypes.end()) {
-          if (type < 0 || findIter->second + 2 == currentStep_) {
+          if (type < 0 || historyStep + 2 == currentStep_) {
             iter->erase();
           } else {
             iter->next();
@@ -173,9 +178,10 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
         iter->erase();
         continue;
       }
-      if (currentVids.emplace(dst, currentStep_).second) {
+      if (currentVids.insert(id)) {
+        pendingSteps.emplace_back(id, currentStep_);
         // next vids for getNeighbor
-        vids_.emplace_back(std::move(dst));
+        vids_.emplace_back(dst);
       }
       iter->next();
     }
@@ -183,9 +189,13 @@ bool SubgraphExecutor::process(std::unique_ptr<GetNeighborsIter> iter) {
   iter->reset();
   builder.iter(std::move(iter));
   finish(builder.build());
-  // update historyVids
-  historyVids_.insert(std::make_move_iterator(currentVids.begin()),
-                      std::make_move_iterator(currentVids.end()));
+  // update history
+  if (historySteps_.size() < vidDict_.size()) {
+    historySteps_.resize(vidDict_.size(), kNoStep);
+  }
+  for (const auto& [id, step] : pendingSteps) {
+    historySteps_[id] = step;
+  }
   if (currentStep_ != 1 && subgraph_->tagFilter()) {
     filterEdges(-1);
   }
@@ -5,10 +5,9 @@
 #ifndef GRAPH_EXECUTOR_ALGO_SUBGRAPHEXECUTOR_H_
 #define GRAPH_EXECUTOR_ALGO_SUBGRAPHEXECUTOR_H_
 
-#include <robin_hood.h>
-
 #include "graph/executor/StorageAccessExecutor.h"
 #include "graph/planner/plan/Algo.h"
+#include "graph/util/VidDictionary.h"
 
 // Subgraph receive result from GetNeighbors
 // There are two Main functions
@@ -16,9 +15,8 @@
 // Second: Delete previously visited edges and save the result(iter) to the variable `resultVar`
 //
 // Member:
-// `historyVids_` : is hash table
-//    KEY   : the VID of the visited destination Vertex
-//    VALUE : the number of steps to visit the KEY (starting vertex is 0)
+// `historySteps_` : indexed by the dense id of the visited destination Vertex (vidDict_)
+//    VALUE : the number of steps to visit the vid (starting vertex is 0), kNoStep if unseen
 // since each vertex will only be visited once, if it is a one-way edge expansion, there will be no
 // duplicate edges. we only need to focus on the case of two-way expansion
 //
@@ -44,9 +42,6 @@ using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsRespo
 
 class SubgraphExecutor : public StorageAccessExecutor {
  public:
-  using HashMap = robin_hood::unordered_flat_map<Value, size_t, std::hash<Value>>;
-  using HashSet = robin_hood::unordered_flat_set<Value, std::hash<Value>>;
-
   SubgraphExecutor(const PlanNode* node, QueryContext* qctx)
       : StorageAccessExecutor("SubgraphExecutor", node, qctx) {
     subgraph_ = asNode<Subgraph>(node);
@@ -64,13 +59,19 @@ class SubgraphExecutor : public StorageAccessExecutor {
   folly::Future<Status> handleResponse(RpcResponse&& resps);
 
  private:
-  HashMap historyVids_;
+  static constexpr uint32_t kNoStep = std::numeric_limits<uint32_t>::max();
+
+  // Every vid touched by this subgraph is interned once; all the per-step membership
+  // tests below run on the dense ids
+  VidDictionary vidDict_;
+  // step at which each dense id entered the history, kNoStep when unseen
+  std::vector<uint32_t> historySteps_;
   const Subgraph* subgraph_{nullptr};
   size_t currentStep_{1};
   size_t totalSteps_{1};
   std::vector<Value> vids_;
-  // save vids already visited
-  HashSet validVids_;
+  // dense ids of vids already visited
+  DenseIdSet validVids_;
 };
 
 }  // namespace graph
@@ -0,0 +1,304 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+#include "graph/executor/algo/WeightedShortestPath.h"
+
+#include "graph/service/GraphFlags.h"
+#include "graph/util/SchemaUtil.h"
+
+using nebula::storage::StorageClient;
+
+namespace nebula {
+namespace graph {
+
+folly::Future<Status> WeightedShortestPath::execute(const HashSet& startVids,
+                                                    const HashSet& endVids,
+                                                    DataSet* result) {
+  if (maxStep_ == 0) {
+    return Status::OK();
+  }
+  init(startVids, endVids);
+  std::vector<folly::Future<Status>> futures;
+  futures.reserve(starts_.size());
+  for (size_t rowNum = 0; rowNum < starts_.size(); ++rowNum) {
+    resultDs_[rowNum].colNames = pathNode_->colNames();
+    futures.emplace_back(dijkstra(rowNum, 1));
+  }
+  return folly::collectAll(futures).via(runner()).thenValue(
+      [this, result](std::vector<folly::Try<Status>>&& resps) {
+        memory::MemoryCheckGuard guard;
+        for (auto& respVal : resps) {
+          if (respVal.hasException()) {
+            auto ex = respVal.exception().get_exception<std::bad_alloc>();
+            if (ex) {
+              throw std::bad_alloc();
+            } else {
+              throw std::runtime_error(respVal.exception().what().c_str());
+            }
+          }
+          auto resp = std::move(respVal).value();
+          NG_RETURN_IF_ERROR(resp);
+        }
+        result->colNames = pathNode_->colNames();
+        for (auto& ds : resultDs_) {
+          result->append(std::move(ds));
+        }
+        return Status::OK();
+      });
+}
+
+void WeightedShortestPath::init(const HashSet& startVids, const HashSet& endVids) {
+  starts_.assign(startVids.begin(), startVids.end());
+  ends_.assign(endVids.begin(), endVids.end());
+  auto rowSize = starts_.size();
+  distMaps_.resize(rowSize);
+  buckets_.resize(rowSize);
+  resultDs_.resize(rowSize);
+  for (size_t rowNum = 0; rowNum < rowSize; ++rowNum) {
+    distMaps_[rowNum].emplace(starts_[rowNum], VertexState());
+    buckets_[rowNum][0].emplace(starts_[rowNum]);
+  }
+}
+
+size_t WeightedShortestPath::bucketOf(double dist) const {
+  auto delta = FLAGS_weighted_shortest_path_delta > 0 ? FLAGS_weighted_shortest_path_delta : 1.0;
+  return static_cast<size_t>(dist / delta);
+}
+
+double WeightedShortestPath::edgeWeight(const Edge& edge) const {
+  auto found = edge.props.find(FLAGS_weighted_shortest_path_prop);
+  if (found == edge.props.end()) {
+    return 1.0;
+  }
+  const auto& val = found->second;
+  double weight = 1.0;
+  if (val.isInt()) {
+    weight = static_cast<double>(val.getInt());
+  } else if (val.isFloat()) {
+    weight = val.getFloat();
+  }
+  // dijkstra can't take negative weights, clamp instead of failing the whole query
+  return weight < 0.0 ? 0.0 : weight;
+}
+
+folly::Future<Status> WeightedShortestPath::dijkstra(size_t rowNum, size_t stepNum) {
+  auto& buckets = buckets_[rowNum];
+  auto& distMap = distMaps_[rowNum];
+  std::vector<Value> frontier;
+  while (!buckets.empty() && frontier.empty()) {
+    auto bucket = buckets.begin();
+    frontier.reserve(bucket->second.size());
+    for (auto& vid : bucket->second) {
+      auto found = distMap.find(vid);
+      // a vid whose distance improved since it was queued lives in a cheaper bucket now
+      if (found != distMap.end() && bucketOf(found->second.dist) == bucket->first) {
+        frontier.emplace_back(vid);
+      }
+    }
+    buckets.erase(bucket);
+  }
+  if (frontier.empty()) {
+    return buildResult(rowNum);
+  }
+  return relaxBucket(rowNum, stepNum, std::move(frontier));
+}
+
+folly::Future<Status> WeightedShortestPath::relaxBucket(size_t rowNum,
+                                                        size_t stepNum,
+                                                        std::vector<Value>&& frontier) {
+  StorageClient* storageClient = qctx_->getStorageClient();
+  time::Duration getNbrTime;
+  storage::StorageClient::CommonRequestParam param(pathNode_->space(),
+                                                   qctx_->rctx()->session()->id(),
+                                                   qctx_->plan()->id(),
+                                                   qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx_->deadlineUs();
+  return storageClient
+      ->getNeighbors(param,
+                     {nebula::kVid},
+                     std::move(frontier),
+                     {},
+                     pathNode_->edgeDirection(),
+                     nullptr,
+                     pathNode_->vertexProps(),
+                     pathNode_->edgeProps(),
+                     nullptr,
+                     false,
+                     false,
+                     {},
+                     -1,
+                     nullptr,
+                     nullptr)
+      .via(runner())
+      .thenValue([this, rowNum, stepNum, getNbrTime](auto&& resp) -> folly::Future<Status> {
+        memory::MemoryCheckGuard guard;
+        addStats(resp, stepNum, getNbrTime.elapsedInUSec(), false);
+        auto completeness = handleCompleteness(resp, FLAGS_accept_partial_success);
+        if (!completeness.ok()) {
+          return folly::makeFuture<Status>(std::move(completeness).status());
+        }
+        auto& responses = std::move(resp).responses();
+        List list;
+        for (auto& response : responses) {
+          auto dataset = response.get_vertices();
+          if (dataset == nullptr) {
+            LOG(INFO) << "Empty dataset in response";
+            continue;
+          }
+          list.values.emplace_back(std::move(*dataset));
+        }
+        auto listVal = std::make_shared<Value>(std::move(list));
+        auto iter = std::make_unique<GetNeighborsIter>(listVal);
+        auto neighbors = std::make_shared<std::vector<CustomStep>>();
+        neighbors->reserve(iter->size());
+        for (iter->reset(); iter->valid(); iter->next()) {
+          auto edgeVal = iter->getEdge();
+          if (UNLIKELY(!edgeVal.isEdge())) {
+            continue;
+          }
+          CustomStep step;
+          step.emplace_back(iter->getVertex());
+          step.emplace_back(std::move(edgeVal));
+          neighbors->emplace_back(std::move(step));
+        }
+        return relaxNeighbors(rowNum, std::move(neighbors))
+            .thenValue([this, rowNum, stepNum](Status&& status) -> folly::Future<Status> {
+              if (!status.ok()) {
+                return folly::makeFuture<Status>(std::move(status));
+              }
+              return dijkstra(rowNum, stepNum + 1);
+            });
+      })
+      .thenError(folly::tag_t<std::bad_alloc>{},
+                 [](const std::bad_alloc&) {
+                   return folly::makeFuture<Status>(Executor::memoryExceededStatus());
+                 })
+      .thenError(folly::tag_t<std::exception>{}, [](const std::exception& e) {
+        return folly::makeFuture<Status>(std::runtime_error(e.what()));
+      });
+}
+
+folly::Future<Status> WeightedShortestPath::relaxNeighbors(
+    size_t rowNum, std::shared_ptr<std::vector<CustomStep>> neighbors) {
+  if (neighbors->empty()) {
+    return Status::OK();
+  }
+  size_t threadNum = FLAGS_num_path_thread == 0 ? 1 : FLAGS_num_path_thread;
+  size_t batchSize = neighbors->size() / threadNum + 1;
+  std::vector<folly::Future<std::vector<Relaxation>>> futures;
+  futures.reserve(threadNum);
+  for (size_t start = 0; start < neighbors->size(); start += batchSize) {
+    auto end = std::min(start + batchSize, neighbors->size());
+    futures.emplace_back(folly::via(runner(), [this, rowNum, neighbors, start, end]() {
+      memory::MemoryCheckGuard guard;
+      // the dist map is read only while the slices run, writes happen after collectAll
+      auto& distMap = distMaps_[rowNum];
+      std::vector<Relaxation> improved;
+      for (size_t i = start; i < end; ++i) {
+        const auto& edge = (*neighbors)[i].values.back().getEdge();
+        auto srcState = distMap.find(edge.src);
+        if (srcState == distMap.end()) {
+          continue;
+        }
+        auto hops = srcState->second.hops + 1;
+        if (hops > maxStep_) {
+          continue;
+        }
+        auto dist = srcState->second.dist + edgeWeight(edge);
+        auto dstState = distMap.find(edge.dst);
+        if (dstState != distMap.end() && dstState->second.dist <= dist) {
+          continue;
+        }
+        Relaxation relax;
+        relax.dst = edge.dst;
+        relax.state.dist = dist;
+        relax.state.hops = hops;
+        relax.state.step = (*neighbors)[i];
+        improved.emplace_back(std::move(relax));
+      }
+      return improved;
+    }));
+  }
+  return folly::collectAll(futures).via(runner()).thenValue(
+      [this, rowNum](std::vector<folly::Try<std::vector<Relaxation>>>&& resps) {
+        memory::MemoryCheckGuard guard;
+        auto& distMap = distMaps_[rowNum];
+        auto& buckets = buckets_[rowNum];
+        for (auto& respVal : resps) {
+          if (respVal.hasException()) {
+            auto ex = respVal.exception().get_exception<std::bad_alloc>();
+            if (ex) {
+              throw std::bad_alloc();
+            } else {
+              throw std::runtime_error(respVal.exception().what().c_str());
+            }
+          }
+          for (auto& relax : respVal.value()) {
+            auto found = distMap.find(relax.dst);
+            // recheck, another slice may have found a cheaper path to the same vid
+            if (found != distMap.end() && found->second.dist <= relax.state.dist) {
+              continue;
+            }
+            buckets[bucketOf(relax.state.dist)].emplace(relax.dst);
+            if (found == distMap.end()) {
+              distMap.emplace(std::move(relax.dst), std::move(relax.state));
+            } else {
+              found->second = std::move(relax.state);
+            }
+          }
+        }
+        return Status::OK();
+      });
+}
+
+folly::Future<Status> WeightedShortestPath::buildResult(size_t rowNum) {
+  auto& distMap = distMaps_[rowNum];
+  std::vector<Value> reached;
+  reached.reserve(ends_.size());
+  for (const auto& end : ends_) {
+    auto found = distMap.find(end);
+    // the start vid carries an empty step, skip it so a pair doesn't yield a zero length path
+    if (found != distMap.end() && !found->second.step.values.empty()) {
+      reached.emplace_back(end);
+    }
+  }
+  if (reached.empty()) {
+    return Status::OK();
+  }
+  return getMeetVidsProps(reached).via(runner()).thenValue(
+      [this, rowNum](std::vector<Value>&& vertices) {
+        memory::MemoryCheckGuard guard;
+        for (auto& dstVertex : vertices) {
+          if (!dstVertex.isVertex()) {
+            continue;
+          }
+          buildPathToDst(rowNum, dstVertex);
+        }
+        return Status::OK();
+      });
+}
+
+void WeightedShortestPath::buildPathToDst(size_t rowNum, const Value& dstVertex) {
+  auto& distMap = distMaps_[rowNum];
+  // walk the parent chain back to the start, collecting [vertex, edge] pairs
+  std::vector<Value> values;
+  auto cur = distMap.find(dstVertex.getVertex().vid);
+  while (cur != distMap.end() && !cur->second.step.values.empty()) {
+    auto& step = cur->second.step.values;
+    values.insert(values.begin(), step.begin(), step.end());
+    cur = distMap.find(step.front().getVertex().vid);
+  }
+  if (values.empty()) {
+    return;
+  }
+  Row row;
+  auto src = values.front();
+  values.erase(values.begin());
+  row.emplace_back(std::move(src));
+  row.emplace_back(List(std::move(values)));
+  row.emplace_back(dstVertex);
+  resultDs_[rowNum].rows.emplace_back(std::move(row));
+}
+
+}  // namespace graph
+}  // namespace nebula
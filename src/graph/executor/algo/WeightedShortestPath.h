@@ -0,0 +1,82 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+#ifndef GRAPH_EXECUTOR_ALGO_WEIGHTED_SHORTESTPATH_H_
+#define GRAPH_EXECUTOR_ALGO_WEIGHTED_SHORTESTPATH_H_
+
+#include <map>
+
+#include "graph/executor/algo/ShortestPathBase.h"
+#include "graph/planner/plan/Algo.h"
+
+namespace nebula {
+namespace graph {
+
+// Delta-stepping shortest path over an edge property, picked instead of the bfs finders when
+// --weighted_shortest_path_prop names the property holding the weight.
+//
+// Reached vertices wait in buckets of width --weighted_shortest_path_delta keyed by their
+// tentative distance. The cheapest bucket forms the frontier of one getNeighbors rpc; the
+// returned edges are relaxed in parallel slices on the query runner, and improved vertices drop
+// into the bucket of their new distance, so a vertex is re-expanded only when a cheaper path to
+// it shows up later. Missing or non-numeric weights count as 1, negative weights as 0.
+//
+// One search per start vid reaches every end vid. Unlike the bfs finders this one expands
+// forward only and reports a single cheapest path per (start, end) pair.
+class WeightedShortestPath final : public ShortestPathBase {
+ public:
+  WeightedShortestPath(const ShortestPath* node,
+                       QueryContext* qctx,
+                       std::unordered_map<std::string, std::string>* stats)
+      : ShortestPathBase(node, qctx, stats) {}
+
+  folly::Future<Status> execute(const HashSet& startVids,
+                                const HashSet& endVids,
+                                DataSet* result) override;
+
+ private:
+  // Tentative state of one reached vertex
+  struct VertexState {
+    double dist{0.0};
+    size_t hops{0};
+    // [vertex(parent), edge(parent->this)], the same shape as a step of the bfs finders;
+    // empty for the start vertex
+    CustomStep step;
+  };
+  // An improvement found while scanning one slice of the frontier edges, applied serially
+  struct Relaxation {
+    DstVid dst;
+    VertexState state;
+  };
+  using DistMap = robin_hood::unordered_flat_map<Value, VertexState, std::hash<Value>>;
+  // Bucket id -> vids queued in that bucket, cheapest bucket first
+  using Buckets = std::map<size_t, HashSet>;
+
+  void init(const HashSet& startVids, const HashSet& endVids);
+
+  folly::Future<Status> dijkstra(size_t rowNum, size_t stepNum);
+
+  folly::Future<Status> relaxBucket(size_t rowNum, size_t stepNum, std::vector<Value>&& frontier);
+
+  folly::Future<Status> relaxNeighbors(size_t rowNum,
+                                       std::shared_ptr<std::vector<CustomStep>> neighbors);
+
+  folly::Future<Status> buildResult(size_t rowNum);
+
+  void buildPathToDst(size_t rowNum, const Value& dstVertex);
+
+  double edgeWeight(const Edge& edge) const;
+
+  size_t bucketOf(double dist) const;
+
+ private:
+  std::vector<StartVid> starts_;
+  std::vector<EndVid> ends_;
+  std::vector<DistMap> distMaps_;
+  std::vector<Buckets> buckets_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_EXECUTOR_ALGO_WEIGHTED_SHORTESTPATH_H_
@@ -49,30 +49,43 @@ folly::Future<Status> UpdateVertexExecutor::execute() {
       uvNode->getSpaceId(), sess->id(), plan->id(), plan->isProfileEnabled());
   return qctx()
       ->getStorageClient()
-      ->updateVertex(param,
-                     uvNode->getVId(),
-                     uvNode->getTagId(),
-                     uvNode->getUpdatedProps(),
-                     uvNode->getInsertable(),
-                     uvNode->getReturnProps(),
-                     uvNode->getCondition())
+      ->batchUpdateVertex(param,
+                          uvNode->getVIds(),
+                          uvNode->getTagId(),
+                          uvNode->getUpdatedProps(),
+                          uvNode->getInsertable(),
+                          uvNode->getReturnProps(),
+                          uvNode->getCondition())
       .via(runner())
       .ensure([updateVertTime]() {
         VLOG(1) << "Update vertice time: " << updateVertTime.elapsedInUSec() << "us";
       })
-      .thenValue([this](StatusOr<storage::cpp2::UpdateResponse> resp) {
+      .thenValue([this](StatusOr<std::vector<storage::cpp2::UpdateResponse>> resp) {
         memory::MemoryCheckGuard guard;
         SCOPED_TIMER(&execTime_);
         if (!resp.ok()) {
           LOG(WARNING) << "Update vertices fail: " << resp.status();
           return resp.status();
         }
-        auto value = std::move(resp).value();
-        for (auto &code : value.get_result().get_failed_parts()) {
-          NG_RETURN_IF_ERROR(handleErrorCode(code.get_code(), code.get_part_id()));
+        // One response per part, merge the result rows into one dataset
+        DataSet merged;
+        bool hasProps = false;
+        for (auto &value : resp.value()) {
+          for (auto &code : value.get_result().get_failed_parts()) {
+            NG_RETURN_IF_ERROR(handleErrorCode(code.get_code(), code.get_part_id()));
+          }
+          if (value.props_ref().has_value()) {
+            if (!hasProps) {
+              merged.colNames = std::move((*value.props_ref()).colNames);
+              hasProps = true;
+            }
+            for (auto &row : (*value.props_ref()).rows) {
+              merged.rows.emplace_back(std::move(row));
+            }
+          }
         }
-        if (value.props_ref().has_value()) {
-          auto status = handleResult(std::move(*value.props_ref()));
+        if (hasProps) {
+          auto status = handleResult(std::move(merged));
           if (!status.ok()) {
             return status.status();
           }
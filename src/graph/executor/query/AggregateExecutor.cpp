@@ -6,6 +6,12 @@
 
 #include "graph/planner/plan/Query.h"
 
+DEFINE_uint32(agg_hash_partitions,
+              0,
+              "hash-partition the aggregation input by group key into this many buckets and "
+              "aggregate every bucket independently on the executor pool, 0 or 1 aggregates "
+              "the whole input on one thread");
+
 namespace nebula {
 namespace graph {
 
@@ -30,6 +36,11 @@ folly::Future<Status> AggregateExecutor::execute() {
     }
   }
 
+  if (FLAGS_agg_hash_partitions > 1 && !groupKeys.empty() && iter->valid() &&
+      ectx_->getResult(agg->inputVar()).value().isDataSet()) {
+    return executePartitioned(agg);
+  }
+
   std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>> result;
 
   // generate default result when input dataset is empty
@@ -98,5 +109,149 @@ folly::Future<Status> AggregateExecutor::execute() {
   return finish(ResultBuilder().value(Value(std::move(ds))).build());
 }
 
+folly::Future<Status> AggregateExecutor::executePartitioned(const Aggregate* agg) {
+  auto iter = ectx_->getResult(agg->inputVar()).iter();
+  const auto& colNames = ectx_->getResult(agg->inputVar()).value().getDataSet().colNames;
+  size_t numParts = FLAGS_agg_hash_partitions;
+  const auto* groupKeysPtr = &agg->groupKeys();
+
+  auto scatter = [this, groupKeysPtr, numParts, colNames](
+                     size_t begin, size_t end, Iterator* tmpIter) -> std::vector<DataSet> {
+    std::vector<Expression*> tmpKeys;
+    tmpKeys.reserve(groupKeysPtr->size());
+    for (auto* e : *groupKeysPtr) {
+      tmpKeys.emplace_back(e->clone());
+    }
+    std::vector<DataSet> parts(numParts);
+    for (auto& p : parts) {
+      p.colNames = colNames;
+    }
+    QueryExpressionContext ctx(ectx_);
+    std::hash<List> hasher;
+    for (; tmpIter->valid() && begin++ < end; tmpIter->next()) {
+      List list;
+      list.values.reserve(tmpKeys.size());
+      for (auto* key : tmpKeys) {
+        list.values.emplace_back(key->eval(ctx(tmpIter)));
+      }
+      parts[hasher(list) % numParts].rows.emplace_back(*tmpIter->row());
+    }
+    return parts;
+  };
+
+  auto gather =
+      [this, agg, numParts](
+          std::vector<folly::Try<std::vector<DataSet>>>&& results) -> folly::Future<Status> {
+    memory::MemoryCheckGuard guard;
+    std::vector<DataSet> merged(numParts);
+    for (auto& respVal : results) {
+      if (respVal.hasException()) {
+        auto ex = respVal.exception().get_exception<std::bad_alloc>();
+        if (ex) {
+          throw std::bad_alloc();
+        } else {
+          throw std::runtime_error(respVal.exception().what().c_str());
+        }
+      }
+      auto parts = std::move(respVal).value();
+      for (size_t p = 0; p < numParts; ++p) {
+        if (merged[p].rows.empty()) {
+          merged[p] = std::move(parts[p]);
+        } else {
+          merged[p].rows.insert(merged[p].rows.end(),
+                                std::make_move_iterator(parts[p].rows.begin()),
+                                std::make_move_iterator(parts[p].rows.end()));
+        }
+      }
+    }
+
+    std::vector<folly::Future<DataSet>> futures;
+    futures.reserve(numParts);
+    for (auto& part : merged) {
+      if (part.rows.empty()) {
+        continue;
+      }
+      futures.emplace_back(
+          folly::via(runner(), [this, agg, part = std::move(part)]() mutable -> DataSet {
+            // MemoryTrackerVerified
+            memory::MemoryCheckGuard guard2;
+            auto val = std::make_shared<Value>(std::move(part));
+            SequentialIter partIter(val);
+            return aggregatePartition(agg, &partIter);
+          }));
+    }
+    return folly::collect(futures).via(runner()).thenValue(
+        [this, agg](std::vector<DataSet>&& groupResults) -> Status {
+          memory::MemoryCheckGuard guard3;
+          DataSet ds;
+          ds.colNames = agg->colNames();
+          for (auto& part : groupResults) {
+            ds.rows.insert(ds.rows.end(),
+                           std::make_move_iterator(part.rows.begin()),
+                           std::make_move_iterator(part.rows.end()));
+          }
+          finish(ResultBuilder().value(Value(std::move(ds))).build());
+          return Status::OK();
+        });
+  };
+
+  return runMultiJobs(std::move(scatter), std::move(gather), iter.get());
+}
+
+DataSet AggregateExecutor::aggregatePartition(const Aggregate* agg, Iterator* iter) {
+  std::vector<Expression*> groupKeys;
+  groupKeys.reserve(agg->groupKeys().size());
+  for (auto* e : agg->groupKeys()) {
+    groupKeys.emplace_back(e->clone());
+  }
+  // group items hold the AggData they are applied to, clone them per partition
+  std::vector<Expression*> groupItems;
+  groupItems.reserve(agg->groupItems().size());
+  for (auto* e : agg->groupItems()) {
+    groupItems.emplace_back(e->clone());
+  }
+
+  QueryExpressionContext ctx(ectx_);
+  std::unordered_map<List, std::vector<std::unique_ptr<AggData>>, std::hash<nebula::List>> result;
+  for (; iter->valid(); iter->next()) {
+    List list;
+    for (auto* key : groupKeys) {
+      list.values.emplace_back(key->eval(ctx(iter)));
+    }
+
+    auto it = result.find(list);
+    if (it == result.end()) {
+      std::vector<std::unique_ptr<AggData>> cols;
+      for (size_t i = 0; i < groupItems.size(); ++i) {
+        cols.emplace_back(new AggData());
+      }
+      result.emplace(std::make_pair(list, std::move(cols)));
+    } else {
+      DCHECK_EQ(it->second.size(), groupItems.size());
+    }
+
+    for (size_t i = 0; i < groupItems.size(); ++i) {
+      auto* item = groupItems[i];
+      if (item->kind() == Expression::Kind::kAggregate) {
+        static_cast<AggregateExpression*>(item)->setAggData(result[list][i].get());
+        item->eval(ctx(iter));
+      } else {
+        result[list][i]->setResult(item->eval(ctx(iter)));
+      }
+    }
+  }
+
+  DataSet ds;
+  ds.rows.reserve(result.size());
+  for (auto& kv : result) {
+    Row row;
+    for (auto& v : kv.second) {
+      row.values.emplace_back(v->result());
+    }
+    ds.rows.emplace_back(std::move(row));
+  }
+  return ds;
+}
+
 }  // namespace graph
 }  // namespace nebula
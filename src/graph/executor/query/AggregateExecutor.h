@@ -11,12 +11,25 @@
 namespace nebula {
 namespace graph {
 
+class Aggregate;
+
 class AggregateExecutor final : public Executor {
  public:
   AggregateExecutor(const PlanNode *node, QueryContext *qctx)
       : Executor("AggregateExecutor", node, qctx) {}
 
   folly::Future<Status> execute() override;
+
+ private:
+  // Partitioned parallel mode: morsel jobs hash-partition the input rows by group key into
+  // FLAGS_agg_hash_partitions buckets, then every bucket is aggregated independently on the
+  // executor pool with its own cloned expressions. All rows of one group always land in the
+  // same bucket, so the partial tables never have to be merged.
+  folly::Future<Status> executePartitioned(const Aggregate *agg);
+
+  // The single-threaded grouping loop, run over one partition with per-partition clones of the
+  // group keys and items
+  DataSet aggregatePartition(const Aggregate *agg, Iterator *iter);
 };
 
 }  // namespace graph
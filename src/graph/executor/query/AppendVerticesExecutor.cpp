@@ -10,6 +10,11 @@ using nebula::storage::StorageClient;
 using nebula::storage::StorageRpcResponse;
 using nebula::storage::cpp2::GetPropResponse;
 
+DEFINE_uint64(append_vertices_pipeline_batch_rows,
+              0,
+              "cut the AppendVertices request into batches of this many rows and digest every "
+              "batch's getProps response while the rpcs of the other batches are still in "
+              "flight, 0 sends the whole request as one rpc");
 DECLARE_bool(optimize_appendvertices);
 
 namespace nebula {
@@ -42,10 +47,16 @@ folly::Future<Status> AppendVerticesExecutor::appendVertices() {
     return finish(ResultBuilder().value(Value(DataSet(av->colNames()))).build());
   }
 
+  if (FLAGS_append_vertices_pipeline_batch_rows > 0 &&
+      vertices.rows.size() > FLAGS_append_vertices_pipeline_batch_rows) {
+    return appendVerticesPipelined(av, std::move(vertices));
+  }
+
   StorageClient::CommonRequestParam param(av->space(),
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
 
   time::Duration getPropsTime;
   return DCHECK_NOTNULL(storageClient)
@@ -73,6 +84,126 @@ folly::Future<Status> AppendVerticesExecutor::appendVertices() {
       });
 }
 
+folly::Future<Status> AppendVerticesExecutor::appendVerticesPipelined(const AppendVertices *av,
+                                                                      DataSet &&vertices) {
+  StorageClient *storageClient = qctx()->getStorageClient();
+  StorageClient::CommonRequestParam param(av->space(),
+                                          qctx()->rctx()->session()->id(),
+                                          qctx()->plan()->id(),
+                                          qctx()->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
+  result_.colNames = av->colNames();
+  size_t batchRows = FLAGS_append_vertices_pipeline_batch_rows;
+  size_t numRows = vertices.rows.size();
+  std::vector<folly::Future<Status>> futures;
+  futures.reserve(numRows / batchRows + 1);
+  time::Duration getPropsTime;
+  for (size_t begin = 0; begin < numRows; begin += batchRows) {
+    auto end = std::min(begin + batchRows, numRows);
+    DataSet batch;
+    batch.colNames = vertices.colNames;
+    batch.rows.insert(batch.rows.end(),
+                      std::make_move_iterator(vertices.rows.begin() + begin),
+                      std::make_move_iterator(vertices.rows.begin() + end));
+    futures.emplace_back(
+        DCHECK_NOTNULL(storageClient)
+            ->getProps(param,
+                       std::move(batch),
+                       av->props(),
+                       nullptr,
+                       av->exprs(),
+                       av->dedup(),
+                       av->orderBy(),
+                       av->limit(qctx()),
+                       av->filter())
+            .via(runner())
+            .thenValue([this](StorageRpcResponse<GetPropResponse> &&rpcResp) {
+              // MemoryTrackerVerified
+              memory::MemoryCheckGuard guard;
+              SCOPED_TIMER(&execTime_);
+              addStats(rpcResp);
+              return handleBatchResp(std::move(rpcResp));
+            }));
+  }
+  return folly::collect(futures).via(runner()).thenValue(
+      [this, getPropsTime](std::vector<Status> &&statuses) {
+        SCOPED_TIMER(&execTime_);
+        addState("total_rpc", getPropsTime);
+        for (auto &s : statuses) {
+          NG_RETURN_IF_ERROR(s);
+        }
+        return finishPipelined();
+      });
+}
+
+Status AppendVerticesExecutor::handleBatchResp(
+    storage::StorageRpcResponse<storage::cpp2::GetPropResponse> &&rpcResp) {
+  auto result = handleCompleteness(rpcResp, FLAGS_accept_partial_success);
+  NG_RETURN_IF_ERROR(result);
+  auto state = std::move(result).value();
+  auto *av = asNode<AppendVertices>(node());
+  // batches are handled concurrently, clone the filter as the multi jobs paths do
+  auto vFilter = av->vFilter() ? av->vFilter()->clone() : nullptr;
+  QueryExpressionContext ctx(qctx()->ectx());
+
+  DataSet ds;
+  for (auto &resp : rpcResp.responses()) {
+    if (!resp.props_ref().has_value()) {
+      continue;
+    }
+    auto iter = PropIter(std::make_shared<Value>(std::move(*resp.props_ref())));
+    for (; iter.valid(); iter.next()) {
+      if (vFilter != nullptr) {
+        auto &vFilterVal = vFilter->eval(ctx(&iter));
+        if (!vFilterVal.isBool() || !vFilterVal.getBool()) {
+          continue;
+        }
+      }
+      if (!av->trackPrevPath()) {  // eg. MATCH (v:Person) RETURN v
+        Row row;
+        row.values.emplace_back(iter.getVertex());
+        ds.rows.emplace_back(std::move(row));
+      } else {
+        dsts_.emplace(iter.getColumn(kVid), iter.getVertex());
+      }
+    }
+  }
+
+  std::lock_guard<std::mutex> g(resultLock_);
+  if (state != Result::State::kSuccess) {
+    pipelineState_ = state;
+  }
+  if (!ds.rows.empty()) {
+    result_.rows.insert(result_.rows.end(),
+                        std::make_move_iterator(ds.rows.begin()),
+                        std::make_move_iterator(ds.rows.end()));
+  }
+  return Status::OK();
+}
+
+Status AppendVerticesExecutor::finishPipelined() {
+  auto *av = asNode<AppendVertices>(node());
+  if (!av->trackPrevPath()) {
+    return finish(ResultBuilder().value(Value(std::move(result_))).state(pipelineState_).build());
+  }
+
+  auto *src = av->src();
+  QueryExpressionContext ctx(qctx()->ectx());
+  auto inputIter = qctx()->ectx()->getResult(av->inputVar()).iter();
+  result_.rows.reserve(inputIter->size());
+  bool mv = movable(av->inputVars().front());
+  for (; inputIter->valid(); inputIter->next()) {
+    auto dstFound = dsts_.find(src->eval(ctx(inputIter.get())));
+    if (dstFound == dsts_.end()) {
+      continue;
+    }
+    Row row = mv ? inputIter->moveRow() : *inputIter->row();
+    row.values.emplace_back(dstFound->second);
+    result_.rows.emplace_back(std::move(row));
+  }
+  return finish(ResultBuilder().value(Value(std::move(result_))).state(pipelineState_).build());
+}
+
 Status AppendVerticesExecutor::handleNullProp(const AppendVertices *av) {
   auto iter = ectx_->getResult(av->inputVar()).iter();
   auto *src = av->src();
@@ -26,6 +26,18 @@ class AppendVerticesExecutor final : public GetPropExecutor {
 
   folly::Future<Status> appendVertices();
 
+  /**
+   * Pipelined mode: the request is cut into fixed-size row batches, each batch's getProps rpc is
+   * issued up front and its response is digested as soon as it lands, while the rpcs of the
+   * other batches are still in flight. This bounds the materialized props to one batch at a time
+   * and overlaps the storage fan-out with the local row building.
+   */
+  folly::Future<Status> appendVerticesPipelined(const AppendVertices *av, DataSet &&vertices);
+
+  Status handleBatchResp(storage::StorageRpcResponse<storage::cpp2::GetPropResponse> &&rpcResp);
+
+  Status finishPipelined();
+
   Status handleResp(storage::StorageRpcResponse<storage::cpp2::GetPropResponse> &&rpcResp);
 
   Status handleNullProp(const AppendVertices *av);
@@ -43,6 +55,9 @@ class AppendVerticesExecutor final : public GetPropExecutor {
   // DstId -> Vertex
   folly::ConcurrentHashMap<Value, Value> dsts_;
   DataSet result_;
+  // guards result_ and pipelineState_ when the pipelined batches land concurrently
+  std::mutex resultLock_;
+  Result::State pipelineState_{Result::State::kSuccess};
 };
 
 }  // namespace graph
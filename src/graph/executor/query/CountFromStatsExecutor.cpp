@@ -0,0 +1,48 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/executor/query/CountFromStatsExecutor.h"
+
+#include "clients/meta/MetaClient.h"
+#include "graph/planner/plan/Query.h"
+
+namespace nebula {
+namespace graph {
+
+folly::Future<Status> CountFromStatsExecutor::execute() {
+  SCOPED_TIMER(&execTime_);
+  auto *count = asNode<CountFromStats>(node());
+  return qctx()->getMetaClient()->getStats(count->space()).via(runner()).thenValue(
+      [this, count](StatusOr<meta::cpp2::StatsItem> resp) {
+        if (!resp.ok()) {
+          return Status::Error(
+              "Get stats of space %d failed: %s. Run `SUBMIT JOB STATS' first or disable "
+              "enable_count_from_stats.",
+              count->space(),
+              resp.status().toString().c_str());
+        }
+        auto statsItem = std::move(resp).value();
+        int64_t result = 0;
+        if (count->schemaName().empty()) {
+          result = count->isEdge() ? *statsItem.space_edges_ref() : *statsItem.space_vertices_ref();
+        } else if (count->isEdge()) {
+          const auto &edges = statsItem.get_edges();
+          auto iter = edges.find(count->schemaName());
+          result = iter == edges.end() ? 0 : iter->second;
+        } else {
+          const auto &tags = statsItem.get_tag_vertices();
+          auto iter = tags.find(count->schemaName());
+          result = iter == tags.end() ? 0 : iter->second;
+        }
+        DataSet ds;
+        ds.colNames = count->colNames();
+        Row row;
+        row.values.emplace_back(result);
+        ds.rows.emplace_back(std::move(row));
+        return finish(ResultBuilder().value(Value(std::move(ds))).build());
+      });
+}
+
+}  // namespace graph
+}  // namespace nebula
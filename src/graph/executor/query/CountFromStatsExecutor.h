@@ -0,0 +1,27 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_EXECUTOR_QUERY_COUNTFROMSTATSEXECUTOR_H_
+#define GRAPH_EXECUTOR_QUERY_COUNTFROMSTATSEXECUTOR_H_
+
+#include "graph/executor/Executor.h"
+
+// Serve an ungrouped COUNT over a whole tag, edge type or space from the stats kept by
+// the meta service, planned by OptimizeCountFromStatsRule instead of a full scan.
+namespace nebula {
+namespace graph {
+
+class CountFromStatsExecutor final : public Executor {
+ public:
+  CountFromStatsExecutor(const PlanNode *node, QueryContext *qctx)
+      : Executor("CountFromStatsExecutor", node, qctx) {}
+
+ private:
+  folly::Future<Status> execute() override;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_EXECUTOR_QUERY_COUNTFROMSTATSEXECUTOR_H_
@@ -7,9 +7,42 @@
 #include <robin_hood.h>
 
 #include "graph/planner/plan/Query.h"
+#include "graph/util/RowSpiller.h"
+
+DECLARE_uint64(executor_spill_batch_rows);
 
 namespace nebula {
 namespace graph {
+
+namespace {
+
+// Spill the accumulated rows when memory is tight; the restore below brings them back after the
+// drained inputs have released their memory
+Status maybeSpill(RowSpiller& spiller, DataSet& ds) {
+  if (UNLIKELY(ds.rows.size() >= FLAGS_executor_spill_batch_rows) && RowSpiller::needSpill()) {
+    return spiller.spill(ds);
+  }
+  return Status::OK();
+}
+
+Status restoreSpilled(RowSpiller& spiller, DataSet& ds) {
+  if (spiller.rowSize() == 0) {
+    return Status::OK();
+  }
+  NG_RETURN_IF_ERROR(spiller.spill(ds));
+  NG_RETURN_IF_ERROR(spiller.rewind());
+  ds.rows.reserve(spiller.rowSize());
+  while (spiller.hasMore()) {
+    auto chunk = spiller.restore(FLAGS_executor_spill_batch_rows);
+    NG_RETURN_IF_ERROR(chunk);
+    auto rows = std::move(chunk).value().rows;
+    ds.rows.insert(
+        ds.rows.end(), std::make_move_iterator(rows.begin()), std::make_move_iterator(rows.end()));
+  }
+  return Status::OK();
+}
+
+}  // namespace
 folly::Future<Status> DataCollectExecutor::execute() {
   return doCollect().ensure([this]() {
     result_ = Value::kEmpty;
@@ -104,6 +137,7 @@ Status DataCollectExecutor::rowBasedMove(const std::vector<std::string>& vars) {
     cap += iter->size();
   }
   ds.rows.reserve(cap);
+  RowSpiller spiller("data_collect");
   for (auto& var : vars) {
     auto& result = ectx_->getResult(var);
     auto iter = result.iter();
@@ -111,9 +145,11 @@ Status DataCollectExecutor::rowBasedMove(const std::vector<std::string>& vars) {
       auto* seqIter = static_cast<SequentialIter*>(iter.get());
       for (; seqIter->valid(); seqIter->next()) {
         ds.rows.emplace_back(seqIter->moveRow());
+        NG_RETURN_IF_ERROR(maybeSpill(spiller, ds));
       }
     }
   }
+  NG_RETURN_IF_ERROR(restoreSpilled(spiller, ds));
   result_.setDataSet(std::move(ds));
   return Status::OK();
 }
@@ -129,6 +165,7 @@ Status DataCollectExecutor::collectAllPaths(const std::vector<std::string>& vars
   ds.colNames = std::move(colNames_);
   DCHECK(!ds.colNames.empty());
 
+  RowSpiller spiller("data_collect");
   for (auto& var : vars) {
     auto& hist = ectx_->getHistory(var);
     for (auto& result : hist) {
@@ -137,10 +174,12 @@ Status DataCollectExecutor::collectAllPaths(const std::vector<std::string>& vars
         auto* seqIter = static_cast<SequentialIter*>(iter.get());
         for (; seqIter->valid(); seqIter->next()) {
           ds.rows.emplace_back(seqIter->moveRow());
+          NG_RETURN_IF_ERROR(maybeSpill(spiller, ds));
         }
       }
     }
   }
+  NG_RETURN_IF_ERROR(restoreSpilled(spiller, ds));
   result_.setDataSet(std::move(ds));
   return Status::OK();
 }
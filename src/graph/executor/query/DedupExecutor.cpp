@@ -9,6 +9,27 @@
 #include "graph/planner/plan/Query.h"
 namespace nebula {
 namespace graph {
+namespace {
+// A row pointer carrying the deep hash of the row, computed once at insert. Probes of a
+// colliding bucket compare the cached hashes before walking the row values again.
+struct HashedRow {
+  explicit HashedRow(const Row* r) : row(r), hash(std::hash<Row>()(*r)) {}
+
+  bool operator==(const HashedRow& rhs) const {
+    return row == rhs.row || (hash == rhs.hash && *row == *rhs.row);
+  }
+
+  const Row* row;
+  size_t hash;
+};
+
+struct HashedRowHasher {
+  size_t operator()(const HashedRow& r) const {
+    return r.hash;
+  }
+};
+}  // namespace
+
 folly::Future<Status> DedupExecutor::execute() {
   // MemoryTrackerVerified
   SCOPED_TIMER(&execTime_);
@@ -16,6 +37,11 @@ folly::Future<Status> DedupExecutor::execute() {
   auto* dedup = asNode<Dedup>(node());
   DCHECK(!dedup->inputVar().empty());
   Result result = ectx_->getResult(dedup->inputVar());
+  if (!movable(dedup->inputVar())) {
+    // The dedup erases rows from the underlying DataSet in place, so take a private copy
+    // when other readers of the variable remain (copy on first mutation)
+    result.detach();
+  }
   auto* iter = result.iterRef();
 
   if (UNLIKELY(iter == nullptr)) {
@@ -25,10 +51,10 @@ folly::Future<Status> DedupExecutor::execute() {
   if (UNLIKELY(iter->isGetNeighborsIter() || iter->isDefaultIter())) {
     return Status::Error("Invalid iterator kind, %d", static_cast<uint16_t>(iter->kind()));
   }
-  robin_hood::unordered_flat_set<const Row*, std::hash<const Row*>> unique;
+  robin_hood::unordered_flat_set<HashedRow, HashedRowHasher> unique;
   unique.reserve(iter->size());
   while (iter->valid()) {
-    if (!unique.emplace(iter->row()).second) {
+    if (!unique.emplace(HashedRow(iter->row())).second) {
       iter->unstableErase();
     } else {
       iter->next();
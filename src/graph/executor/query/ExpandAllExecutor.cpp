@@ -69,21 +69,24 @@ folly::Future<Status> ExpandAllExecutor::execute() {
 
 folly::Future<Status> ExpandAllExecutor::GetDstBySrc() {
   currentStep_++;
+  // when exactly two rounds remain, let storaged run both hops in one rpc
+  bool twoHop = FLAGS_expand_two_hop_pushdown && currentStep_ == maxSteps_;
   time::Duration getDstTime;
   StorageClient* storageClient = qctx_->getStorageClient();
   StorageClient::CommonRequestParam param(expand_->space(),
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
   std::vector<Value> vids(nextStepVids_.size());
   std::move(nextStepVids_.begin(), nextStepVids_.end(), vids.begin());
-  return storageClient->getDstBySrc(param, std::move(vids), expand_->edgeTypes())
+  return storageClient->getDstBySrc(param, std::move(vids), expand_->edgeTypes(), twoHop ? 2 : 1)
       .via(runner())
       .ensure([this, getDstTime]() {
         SCOPED_TIMER(&execTime_);
         addState("total_rpc_time", getDstTime);
       })
-      .thenValue([this](StorageRpcResponse<GetDstBySrcResponse>&& resps) {
+      .thenValue([this, twoHop](StorageRpcResponse<GetDstBySrcResponse>&& resps) {
         memory::MemoryCheckGuard guard;
         nextStepVids_.clear();
         SCOPED_TIMER(&execTime_);
@@ -102,6 +105,28 @@ folly::Future<Status> ExpandAllExecutor::GetDstBySrc() {
           return folly::makeFuture<Status>(result.status());
         }
         auto& responses = resps.responses();
+        if (twoHop) {
+          // storaged already ran the second hop for the dsts it owns, only the dsts it
+          // handed back in unexpanded_dsts still need their remaining hop
+          currentStep_++;
+          for (auto& resp : responses) {
+            auto* dataset = resp.get_dsts();
+            if (dataset == nullptr) continue;
+            for (auto& row : dataset->rows) {
+              result_.rows.emplace_back(row);
+            }
+            auto* unexpanded = resp.get_unexpanded_dsts();
+            if (unexpanded == nullptr) continue;
+            for (auto& row : unexpanded->rows) {
+              nextStepVids_.insert(row.values.begin(), row.values.end());
+            }
+          }
+          if (nextStepVids_.empty()) {
+            finish(ResultBuilder().value(Value(std::move(result_))).build());
+            return folly::makeFuture<Status>(Status::OK());
+          }
+          return GetDstBySrc();
+        }
         if (currentStep_ <= maxSteps_) {
           for (auto& resp : responses) {
             auto* dataset = resp.get_dsts();
@@ -139,6 +164,7 @@ folly::Future<Status> ExpandAllExecutor::getNeighbors() {
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
   std::vector<Value> vids(nextStepVids_.size());
   std::move(nextStepVids_.begin(), nextStepVids_.end(), vids.begin());
   QueryExpressionContext qec(qctx()->ectx());
@@ -74,6 +74,7 @@ folly::Future<Status> ExpandExecutor::GetDstBySrc() {
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
   std::vector<Value> vids(nextStepVids_.size());
   std::move(nextStepVids_.begin(), nextStepVids_.end(), vids.begin());
   return storageClient->getDstBySrc(param, std::move(vids), expand_->edgeTypes())
@@ -139,6 +140,7 @@ folly::Future<Status> ExpandExecutor::getNeighbors() {
                                           qctx_->rctx()->session()->id(),
                                           qctx_->plan()->id(),
                                           qctx_->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
   std::vector<Value> vids(nextStepVids_.size());
   std::move(nextStepVids_.begin(), nextStepVids_.end(), vids.begin());
   return storageClient
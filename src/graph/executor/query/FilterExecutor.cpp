@@ -4,12 +4,115 @@
 
 #include "graph/executor/query/FilterExecutor.h"
 
+#include <robin_hood.h>
+
+#include "common/expression/ExprBytecode.h"
+#include "common/function/FunctionManager.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/service/GraphFlags.h"
+#include "graph/util/ExpressionUtils.h"
+
+DEFINE_uint64(filter_memo_max_cardinality,
+              1024,
+              "Max number of distinct key values memoized when evaluating a filter condition, "
+              "the memo is dropped once the input exceeds this cardinality, 0 disables it");
 
 namespace nebula {
 namespace graph {
 
+namespace {
+
+// Whether the condition always yields the same verdict for the same values of the columns it
+// references: every row-dependent leaf is an input or variable property and every called
+// function is pure. Fills `keyCols` with the (deduplicated) referenced column names.
+bool isMemoizable(const Expression *condition, std::vector<std::string> &keyCols) {
+  static const std::unordered_set<Expression::Kind> kNonMemoizable = {
+      Expression::Kind::kTagProperty,   Expression::Kind::kLabelTagProperty,
+      Expression::Kind::kEdgeProperty,  Expression::Kind::kDstProperty,
+      Expression::Kind::kSrcProperty,   Expression::Kind::kEdgeSrc,
+      Expression::Kind::kEdgeType,      Expression::Kind::kEdgeRank,
+      Expression::Kind::kEdgeDst,       Expression::Kind::kVertex,
+      Expression::Kind::kEdge,          Expression::Kind::kLabel,
+      Expression::Kind::kLabelAttribute, Expression::Kind::kColumn,
+      Expression::Kind::kUUID,          Expression::Kind::kVar,
+      Expression::Kind::kVersionedVar,  Expression::Kind::kAggregate,
+      Expression::Kind::kESQUERY,       Expression::Kind::kMatchPathPattern,
+      Expression::Kind::kSubscriptRange};
+  if (ExpressionUtils::hasAny(condition, kNonMemoizable)) {
+    return false;
+  }
+  for (const auto *funcExpr :
+       ExpressionUtils::collectAll(condition, {Expression::Kind::kFunctionCall})) {
+    auto *func = static_cast<const FunctionCallExpression *>(funcExpr);
+    auto pure = FunctionManager::getIsPure(func->name(), func->args()->args().size());
+    if (!pure.ok() || !pure.value()) {
+      return false;
+    }
+  }
+  for (const auto *propExpr : ExpressionUtils::collectAll(
+           condition, {Expression::Kind::kInputProperty, Expression::Kind::kVarProperty})) {
+    const auto &prop = static_cast<const PropertyExpression *>(propExpr)->prop();
+    if (prop == "*") {
+      return false;
+    }
+    keyCols.emplace_back(prop);
+  }
+  if (keyCols.empty()) {
+    // Constant condition, nothing worth memoizing
+    return false;
+  }
+  std::sort(keyCols.begin(), keyCols.end());
+  keyCols.erase(std::unique(keyCols.begin(), keyCols.end()), keyCols.end());
+  return true;
+}
+
+// Memoizes the verdict of the filter per distinct combination of the referenced column
+// values in a small open-addressing hash map, so that low cardinality inputs evaluate the
+// condition only once per distinct key. The memo turns itself off once the cardinality bound
+// is exceeded.
+class FilterMemo final {
+ public:
+  explicit FilterMemo(const Expression *condition) {
+    if (FLAGS_filter_memo_max_cardinality > 0) {
+      enabled_ = isMemoizable(condition, cols_);
+    }
+  }
+
+  // Returns the cached verdict of the current row, nullptr when unknown
+  const Value *find(Iterator *iter) {
+    if (!enabled_) {
+      return nullptr;
+    }
+    key_.values.clear();
+    for (const auto &col : cols_) {
+      key_.values.emplace_back(iter->getColumn(col));
+    }
+    auto found = cache_.find(key_);
+    return found == cache_.end() ? nullptr : &found->second;
+  }
+
+  // Remembers the verdict of the key built by the preceding find() call
+  void insert(const Value &val) {
+    if (!enabled_) {
+      return;
+    }
+    if (cache_.size() >= FLAGS_filter_memo_max_cardinality) {
+      enabled_ = false;
+      cache_.clear();
+      return;
+    }
+    cache_.emplace(key_, val);
+  }
+
+ private:
+  bool enabled_{false};
+  std::vector<std::string> cols_;
+  List key_;
+  robin_hood::unordered_flat_map<List, Value, std::hash<List>> cache_;
+};
+
+}  // namespace
+
 folly::Future<Status> FilterExecutor::execute() {
   SCOPED_TIMER(&execTime_);
   auto *filter = asNode<Filter>(node());
@@ -72,9 +175,21 @@ StatusOr<DataSet> FilterExecutor::handleJob(size_t begin, size_t end, Iterator *
   auto *filter = asNode<Filter>(node());
   QueryExpressionContext ctx(ectx_);
   auto condition = filter->condition()->clone();
+  FilterMemo memo(condition);
+  std::unique_ptr<ExprBytecode> program;
+  if (FLAGS_enable_expression_bytecode) {
+    program = ExprBytecode::compile(condition);
+  }
   DataSet ds;
   for (; iter->valid() && begin++ < end; iter->next()) {
-    auto val = condition->eval(ctx(iter));
+    Value val;
+    const Value *cached = memo.find(iter);
+    if (cached != nullptr) {
+      val = *cached;
+    } else {
+      val = program != nullptr ? program->eval(ctx(iter)) : condition->eval(ctx(iter));
+      memo.insert(val);
+    }
     if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
       return Status::Error("Failed to evaluate condition: %s. %s%s",
                            condition->toString().c_str(),
@@ -105,10 +220,22 @@ Status FilterExecutor::handleSingleJobFilter() {
   ResultBuilder builder;
   QueryExpressionContext ctx(ectx_);
   auto condition = filter->condition();
+  FilterMemo memo(condition);
+  std::unique_ptr<ExprBytecode> program;
+  if (FLAGS_enable_expression_bytecode) {
+    program = ExprBytecode::compile(condition);
+  }
   if (LIKELY(canMoveData)) {
     builder.value(result.valuePtr());
     while (iter->valid()) {
-      auto val = condition->eval(ctx(iter));
+      Value val;
+      const Value *cached = memo.find(iter);
+      if (cached != nullptr) {
+        val = *cached;
+      } else {
+        val = program != nullptr ? program->eval(ctx(iter)) : condition->eval(ctx(iter));
+        memo.insert(val);
+      }
       if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
         return Status::Error("Failed to evaluate condition: %s. %s%s",
                              condition->toString().c_str(),
@@ -134,7 +261,14 @@ Status FilterExecutor::handleSingleJobFilter() {
     ds.colNames = result.getColNames();
     ds.rows.reserve(iter->size());
     for (; iter->valid(); iter->next()) {
-      auto val = condition->eval(ctx(iter));
+      Value val;
+      const Value *cached = memo.find(iter);
+      if (cached != nullptr) {
+        val = *cached;
+      } else {
+        val = program != nullptr ? program->eval(ctx(iter)) : condition->eval(ctx(iter));
+        memo.insert(val);
+      }
       if (val.isBadNull() || (!val.empty() && !val.isImplicitBool() && !val.isNull())) {
         return Status::Error("Failed to evaluate condition: %s. %s%s",
                              condition->toString().c_str(),
@@ -85,6 +85,10 @@ folly::Future<Status> GetEdgesExecutor::getEdges() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
+  // merge each response on the IO thread that received it, overlapping the merge with the
+  // network wait for the remaining hosts
+  auto streamed = std::make_shared<StreamedProps>();
   return DCHECK_NOTNULL(client)
       ->getProps(param,
                  std::move(edges),
@@ -94,17 +98,18 @@ folly::Future<Status> GetEdgesExecutor::getEdges() {
                  ge->dedup(),
                  ge->orderBy(),
                  ge->getValidLimit(),
-                 ge->filter())
+                 ge->filter(),
+                 makeStreamedMerger(streamed))
       .via(runner())
       .ensure([this, getPropsTime]() {
         SCOPED_TIMER(&execTime_);
         addState("total_rpc", getPropsTime);
       })
-      .thenValue([this, ge](StorageRpcResponse<GetPropResponse> &&rpcResp) {
+      .thenValue([this, ge, streamed](StorageRpcResponse<GetPropResponse> &&rpcResp) {
         memory::MemoryCheckGuard guard;
         SCOPED_TIMER(&execTime_);
         addStats(rpcResp);
-        return handleResp(std::move(rpcResp), ge->colNames());
+        return handleResp(std::move(rpcResp), ge->colNames(), streamed);
       });
 }
 
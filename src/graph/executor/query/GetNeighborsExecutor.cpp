@@ -40,6 +40,23 @@ folly::Future<Status> GetNeighborsExecutor::execute() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
+  // When not profiling, consume each storage response as it arrives: its dataset is moved into
+  // the final result while other hosts are still sending, so graphd buffers one copy of the
+  // expansion instead of holding every partition's response until the last one lands. The
+  // buffered path is kept under profiling, which needs the per-response sizes.
+  bool streaming = !qctx()->plan()->isProfileEnabled();
+  auto streamedResult = std::make_shared<List>();
+  std::function<void(GetNeighborsResponse&)> onEachResponse = nullptr;
+  if (streaming) {
+    onEachResponse = [streamedResult](GetNeighborsResponse& resp) {
+      auto* dataset = resp.vertices_ref().has_value() ? &(*resp.vertices_ref()) : nullptr;
+      if (dataset != nullptr) {
+        streamedResult->values.emplace_back(std::move(*dataset));
+        resp.vertices_ref().reset();
+      }
+    };
+  }
   return storageClient
       ->getNeighbors(param,
                      {nebula::kVid},
@@ -55,44 +72,52 @@ folly::Future<Status> GetNeighborsExecutor::execute() {
                      gn_->orderBy(),
                      gn_->limit(qec),
                      gn_->filter(),
-                     nullptr)
+                     nullptr,
+                     std::move(onEachResponse))
       .via(runner())
       .ensure([this, getNbrTime]() {
         SCOPED_TIMER(&execTime_);
         addState("total_rpc_time", getNbrTime);
       })
-      .thenValue([this](StorageRpcResponse<GetNeighborsResponse>&& resp) {
-        memory::MemoryCheckGuard guard;
-        SCOPED_TIMER(&execTime_);
-        auto& hostLatency = resp.hostLatency();
-        for (size_t i = 0; i < hostLatency.size(); ++i) {
-          size_t size = 0u;
-          auto& result = resp.responses()[i];
-          if (result.vertices_ref().has_value()) {
-            size = (*result.vertices_ref()).size();
-          }
-          auto info = util::collectRespProfileData(result.result, hostLatency[i], size);
-          addState(folly::sformat("resp[{}]", i), info);
-        }
-        return handleResponse(resp);
-      });
+      .thenValue(
+          [this, streaming, streamedResult](StorageRpcResponse<GetNeighborsResponse>&& resp) {
+            memory::MemoryCheckGuard guard;
+            SCOPED_TIMER(&execTime_);
+            if (!streaming) {
+              auto& hostLatency = resp.hostLatency();
+              for (size_t i = 0; i < hostLatency.size(); ++i) {
+                size_t size = 0u;
+                auto& result = resp.responses()[i];
+                if (result.vertices_ref().has_value()) {
+                  size = (*result.vertices_ref()).size();
+                }
+                auto info = util::collectRespProfileData(result.result, hostLatency[i], size);
+                addState(folly::sformat("resp[{}]", i), info);
+              }
+            }
+            return handleResponse(resp, streaming ? streamedResult.get() : nullptr);
+          });
 }
 
-Status GetNeighborsExecutor::handleResponse(RpcResponse& resps) {
+Status GetNeighborsExecutor::handleResponse(RpcResponse& resps, List* streamed) {
   auto result = handleCompleteness(resps, FLAGS_accept_partial_success);
   NG_RETURN_IF_ERROR(result);
   ResultBuilder builder;
   builder.state(result.value());
 
-  auto& responses = resps.responses();
   List list;
-  for (auto& resp : responses) {
-    auto dataset = resp.get_vertices();
-    if (dataset == nullptr) {
-      continue;
-    }
+  if (streamed != nullptr) {
+    list = std::move(*streamed);
+  } else {
+    auto& responses = resps.responses();
+    for (auto& resp : responses) {
+      auto dataset = resp.get_vertices();
+      if (dataset == nullptr) {
+        continue;
+      }
 
-    list.values.emplace_back(std::move(*dataset));
+      list.values.emplace_back(std::move(*dataset));
+    }
   }
   builder.value(Value(std::move(list))).iter(Iterator::Kind::kGetNeighbors);
   return finish(builder.build());
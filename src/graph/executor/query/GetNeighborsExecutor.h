@@ -25,7 +25,9 @@ class GetNeighborsExecutor final : public StorageAccessExecutor {
 
  private:
   using RpcResponse = storage::StorageRpcResponse<storage::cpp2::GetNeighborsResponse>;
-  Status handleResponse(RpcResponse& resps);
+  // `streamed` holds the datasets already moved out of the responses on arrival, nullptr means
+  // the buffered path where the datasets are still inside `resps`
+  Status handleResponse(RpcResponse& resps, List* streamed = nullptr);
 
  private:
   const GetNeighbors* gn_;
@@ -18,23 +18,57 @@ class GetPropExecutor : public StorageAccessExecutor {
   GetPropExecutor(const std::string &name, const PlanNode *node, QueryContext *qctx)
       : StorageAccessExecutor(name, node, qctx) {}
 
+  // props merged on the IO thread as responses arrive, see makeStreamedMerger
+  struct StreamedProps {
+    nebula::DataSet dataset;
+    bool partial{false};
+  };
+
+  // Merge each GetPropResponse into *result on the IO thread that received it, so the merge
+  // overlaps with the network wait for the hosts that have not responded yet. All hooks of
+  // one rpc batch run on the same IO thread, so no locking is needed.
+  static std::function<void(storage::cpp2::GetPropResponse &)> makeStreamedMerger(
+      std::shared_ptr<StreamedProps> result) {
+    return [result](storage::cpp2::GetPropResponse &resp) {
+      if (resp.props_ref().has_value()) {
+        if (UNLIKELY(!result->dataset.append(std::move(*resp.props_ref())))) {
+          // it's impossible according to the interface
+          LOG(ERROR) << "Heterogeneous props dataset";
+          result->partial = true;
+        }
+        resp.props_ref().reset();
+      } else {
+        result->partial = true;
+      }
+    };
+  }
+
   template <typename Response>
   Status handleResp(storage::StorageRpcResponse<Response> &&rpcResp,
-                    const std::vector<std::string> &colNames) {
+                    const std::vector<std::string> &colNames,
+                    std::shared_ptr<StreamedProps> streamed = nullptr) {
     auto result = handleCompleteness(rpcResp, FLAGS_accept_partial_success);
     NG_RETURN_IF_ERROR(result);
     auto state = std::move(result).value();
-    // Ok, merge DataSets to one
     nebula::DataSet v;
-    for (auto &resp : rpcResp.responses()) {
-      if (resp.props_ref().has_value()) {
-        if (UNLIKELY(!v.append(std::move(*resp.props_ref())))) {
-          // it's impossible according to the interface
-          LOG(ERROR) << "Heterogeneous props dataset";
+    if (streamed != nullptr) {
+      // already merged while the responses were arriving
+      v = std::move(streamed->dataset);
+      if (streamed->partial) {
+        state = Result::State::kPartialSuccess;
+      }
+    } else {
+      // Ok, merge DataSets to one
+      for (auto &resp : rpcResp.responses()) {
+        if (resp.props_ref().has_value()) {
+          if (UNLIKELY(!v.append(std::move(*resp.props_ref())))) {
+            // it's impossible according to the interface
+            LOG(ERROR) << "Heterogeneous props dataset";
+            state = Result::State::kPartialSuccess;
+          }
+        } else {
           state = Result::State::kPartialSuccess;
         }
-      } else {
-        state = Result::State::kPartialSuccess;
       }
     }
     if (!colNames.empty()) {
@@ -35,6 +35,10 @@ folly::Future<Status> GetVerticesExecutor::getVertices() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
+  // merge each response on the IO thread that received it, overlapping the merge with the
+  // network wait for the remaining hosts
+  auto streamed = std::make_shared<StreamedProps>();
   return DCHECK_NOTNULL(storageClient)
       ->getProps(param,
                  std::move(vertices),
@@ -44,17 +48,18 @@ folly::Future<Status> GetVerticesExecutor::getVertices() {
                  gv->dedup(),
                  gv->orderBy(),
                  gv->getValidLimit(),
-                 gv->filter())
+                 gv->filter(),
+                 makeStreamedMerger(streamed))
       .via(runner())
       .ensure([this, getPropsTime]() {
         SCOPED_TIMER(&execTime_);
         addState("total_rpc", getPropsTime);
       })
-      .thenValue([this, gv](StorageRpcResponse<GetPropResponse> &&rpcResp) {
+      .thenValue([this, gv, streamed](StorageRpcResponse<GetPropResponse> &&rpcResp) {
         memory::MemoryCheckGuard guard;
         SCOPED_TIMER(&execTime_);
         addStats(rpcResp);
-        return handleResp(std::move(rpcResp), gv->colNames());
+        return handleResp(std::move(rpcResp), gv->colNames(), streamed);
       });
 }
 
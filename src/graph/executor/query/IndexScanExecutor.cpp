@@ -76,6 +76,7 @@ folly::Future<Status> IndexScanExecutor::indexScan() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
   return storageClient
       ->lookupIndex(param,
                     ictxs,
@@ -83,7 +84,8 @@ folly::Future<Status> IndexScanExecutor::indexScan() {
                     lookup->schemaId(),
                     lookup->returnColumns(),
                     lookup->orderBy(),
-                    lookup->limit(qctx_))
+                    lookup->limit(qctx_),
+                    lookup->statColumns())
       .via(runner())
       .thenValue([this](StorageRpcResponse<LookupIndexResp> &&rpcResp) {
         // MemoryTrackerVerified
@@ -101,6 +103,10 @@ Status IndexScanExecutor::handleResp(storage::StorageRpcResponse<Resp> &&rpcResp
     return std::move(completeness).status();
   }
   auto state = std::move(completeness).value();
+  const auto &statColumns = asNode<IndexScan>(node())->statColumns();
+  if (!statColumns.empty()) {
+    return handleStatResp(std::move(rpcResp), state);
+  }
   nebula::DataSet v;
   for (auto &resp : rpcResp.responses()) {
     if (resp.data_ref().has_value()) {
@@ -122,5 +128,53 @@ Status IndexScanExecutor::handleResp(storage::StorageRpcResponse<Resp> &&rpcResp
       ResultBuilder().value(std::move(v)).iter(Iterator::Kind::kProp).state(state).build());
 }
 
+template <typename Resp>
+Status IndexScanExecutor::handleStatResp(storage::StorageRpcResponse<Resp> &&rpcResp,
+                                         Result::State state) {
+  const auto &statColumns = asNode<IndexScan>(node())->statColumns();
+  Row merged;
+  merged.values.resize(statColumns.size());
+  for (size_t i = 0; i < statColumns.size(); i++) {
+    auto type = statColumns[i].get_stat();
+    if (type == storage::cpp2::StatType::COUNT || type == storage::cpp2::StatType::SUM) {
+      merged.values[i] = 0L;
+    }
+  }
+  for (auto &resp : rpcResp.responses()) {
+    if (!resp.stat_data_ref().has_value() || (*resp.stat_data_ref()).rows.empty()) {
+      continue;
+    }
+    const auto &partial = (*resp.stat_data_ref()).rows.front();
+    if (partial.values.size() != statColumns.size()) {
+      return Status::Error("Unexpected stat row size from storage: %lu vs. %lu",
+                           partial.values.size(),
+                           statColumns.size());
+    }
+    for (size_t i = 0; i < statColumns.size(); i++) {
+      const auto &val = partial.values[i];
+      auto &acc = merged.values[i];
+      switch (statColumns[i].get_stat()) {
+        case storage::cpp2::StatType::COUNT:
+        case storage::cpp2::StatType::SUM:
+          acc = acc + val;
+          break;
+        case storage::cpp2::StatType::MAX:
+          acc = acc.empty() || val > acc ? val : acc;
+          break;
+        case storage::cpp2::StatType::MIN:
+          acc = acc.empty() || val < acc ? val : acc;
+          break;
+        default:
+          return Status::Error("Invalid stat type pushed down to storage");
+      }
+    }
+  }
+  nebula::DataSet v;
+  v.colNames = node()->colNames();
+  DCHECK_EQ(v.colNames.size(), merged.values.size());
+  v.rows.emplace_back(std::move(merged));
+  return finish(ResultBuilder().value(std::move(v)).state(state).build());
+}
+
 }  // namespace graph
 }  // namespace nebula
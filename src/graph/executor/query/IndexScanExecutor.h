@@ -27,6 +27,10 @@ class IndexScanExecutor final : public StorageAccessExecutor {
   template <typename Resp>
   Status handleResp(storage::StorageRpcResponse<Resp> &&rpcResp);
 
+  // Merge the per-part partial aggregates of stat_data into the single aggregate row
+  template <typename Resp>
+  Status handleStatResp(storage::StorageRpcResponse<Resp> &&rpcResp, Result::State state);
+
  private:
   const IndexScan *gn_;
 };
@@ -6,6 +6,20 @@
 
 #include "graph/planner/plan/Query.h"
 #include "graph/service/GraphFlags.h"
+#include "graph/util/RowSpiller.h"
+
+DECLARE_uint64(executor_spill_batch_rows);
+
+DEFINE_uint32(join_hash_partitions,
+              0,
+              "radix-partition both join sides by key hash into this many partitions and "
+              "build/probe them independently on the executor pool, 0 or 1 builds and probes a "
+              "single hash table");
+DEFINE_uint64(adaptive_join_min_rows,
+              0,
+              "when the smaller join side turns out to hold at least this many rows at runtime, "
+              "switch to the partitioned join even if --join_hash_partitions is not set, 0 "
+              "disables the adaptive switch");
 
 namespace nebula {
 namespace graph {
@@ -13,6 +27,9 @@ folly::Future<Status> InnerJoinExecutor::execute() {
   SCOPED_TIMER(&execTime_);
   auto* joinNode = asNode<Join>(node());
   NG_RETURN_IF_ERROR(checkInputDataSets());
+  if (choosePartitionedJoin()) {
+    return joinPartitioned(joinNode->hashKeys(), joinNode->probeKeys(), joinNode->colNames());
+  }
   if (FLAGS_max_job_size <= 1) {
     return join(joinNode->hashKeys(), joinNode->probeKeys(), joinNode->colNames());
   } else {
@@ -25,6 +42,18 @@ Status InnerJoinExecutor::close() {
   return Executor::close();
 }
 
+bool InnerJoinExecutor::choosePartitionedJoin() {
+  numJoinParts_ = FLAGS_join_hash_partitions;
+  // The planner fixed the strategy before it could know the input sizes. If even the smaller
+  // (build) side turns out far bigger than a single-threaded hash table is good for, upgrade
+  // to the partitioned join here, where the actual cardinalities are known.
+  if (numJoinParts_ <= 1 && FLAGS_adaptive_join_min_rows > 0 && FLAGS_max_job_size > 1 &&
+      std::min(lhsIter_->size(), rhsIter_->size()) >= FLAGS_adaptive_join_min_rows) {
+    numJoinParts_ = FLAGS_max_job_size;
+  }
+  return numJoinParts_ > 1 && !lhsIter_->empty() && !rhsIter_->empty();
+}
+
 folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& hashKeys,
                                               const std::vector<Expression*>& probeKeys,
                                               const std::vector<std::string>& colNames) {
@@ -52,7 +81,7 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
       result = singleKeyProbe(hashKeys.front(), lhsIter_.get(), hashTable);
     }
   } else {
-    std::unordered_map<List, std::vector<const Row*>> hashTable;
+    std::unordered_map<HashedKey, std::vector<const Row*>> hashTable;
     hashTable.reserve(bucketSize);
     if (lhsIter_->size() < rhsIter_->size()) {
       buildHashTable(hashKeys, lhsIter_.get(), hashTable);
@@ -72,7 +101,7 @@ folly::Future<Status> InnerJoinExecutor::join(const std::vector<Expression*>& ha
 DataSet InnerJoinExecutor::probe(
     const std::vector<Expression*>& probeKeys,
     Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
+    const std::unordered_map<HashedKey, std::vector<const Row*>>& hashTable) const {
   DataSet ds;
   QueryExpressionContext ctx(ectx_);
   ds.rows.reserve(probeIter->size());
@@ -83,12 +112,13 @@ DataSet InnerJoinExecutor::probe(
       Value val = col->eval(ctx(probeIter));
       list.values.emplace_back(std::move(val));
     }
+    HashedKey key(std::move(list));
     if (mv_) {
       // Probe row only match key in HashTable once, so we could move it directly,
       // key/value in HashTable will be matched multiple times, so we can't move it.
-      buildNewRow<List>(hashTable, list, probeIter->moveRow(), ds);
+      buildNewRow<HashedKey>(hashTable, key, probeIter->moveRow(), ds);
     } else {
-      buildNewRow<List>(hashTable, list, *probeIter->row(), ds);
+      buildNewRow<HashedKey>(hashTable, key, *probeIter->row(), ds);
     }
   }
   return ds;
@@ -167,7 +197,8 @@ folly::Future<Status> InnerJoinExecutor::probe(const std::vector<Expression*>& p
         Value val = col->eval(ctx(tmpIter));
         list.values.emplace_back(std::move(val));
       }
-      buildNewRow<List>(listHashTable_, list, *tmpIter->row(), ds);
+      HashedKey key(std::move(list));
+      buildNewRow<HashedKey>(listHashTable_, key, *tmpIter->row(), ds);
     }
     return ds;
   };
@@ -242,6 +273,262 @@ folly::Future<Status> InnerJoinExecutor::singleKeyProbe(Expression* probeKey, It
   return runMultiJobs(std::move(scatter), std::move(gather), probeIter);
 }
 
+folly::Future<Status> InnerJoinExecutor::joinPartitioned(const std::vector<Expression*>& hashKeys,
+                                                         const std::vector<Expression*>& probeKeys,
+                                                         const std::vector<std::string>& colNames) {
+  DCHECK_EQ(hashKeys.size(), probeKeys.size());
+  if (RowSpiller::needSpill() && lhsIter_->isSequentialIter() && rhsIter_->isSequentialIter()) {
+    return joinSpilled(hashKeys, probeKeys, colNames);
+  }
+  Iterator* buildIter = nullptr;
+  Iterator* probeIter = nullptr;
+  const std::vector<Expression*>* buildKeys = nullptr;
+  const std::vector<Expression*>* probeSideKeys = nullptr;
+  if (lhsIter_->size() < rhsIter_->size()) {
+    buildIter = lhsIter_.get();
+    buildKeys = &hashKeys;
+    probeIter = rhsIter_.get();
+    probeSideKeys = &probeKeys;
+  } else {
+    exchange_ = true;
+    buildIter = rhsIter_.get();
+    buildKeys = &probeKeys;
+    probeIter = lhsIter_.get();
+    probeSideKeys = &hashKeys;
+  }
+
+  // The two sides are partitioned concurrently, neither depends on the other
+  auto buildFuture = partitionByKeyHash(*buildKeys, buildIter);
+  auto probeFuture = partitionByKeyHash(*probeSideKeys, probeIter);
+  return folly::collect(std::move(buildFuture), std::move(probeFuture))
+      .via(runner())
+      .thenValue([this, colNames](
+                     std::tuple<std::vector<KeyedRows>, std::vector<KeyedRows>>&& parts) mutable {
+        auto buildParts = std::make_shared<std::vector<KeyedRows>>(std::move(std::get<0>(parts)));
+        auto probeParts = std::make_shared<std::vector<KeyedRows>>(std::move(std::get<1>(parts)));
+        auto numParts = buildParts->size();
+        std::vector<folly::Future<DataSet>> futures;
+        futures.reserve(numParts);
+        for (size_t p = 0; p < numParts; ++p) {
+          futures.emplace_back(
+              folly::via(runner(), [this, p, buildParts, probeParts]() -> DataSet {
+                // MemoryTrackerVerified
+                memory::MemoryCheckGuard guard;
+                return joinPartition((*buildParts)[p], (*probeParts)[p]);
+              }));
+        }
+        return folly::collect(futures).via(runner()).thenValue(
+            [this, colNames = std::move(colNames)](std::vector<DataSet>&& results) -> Status {
+              memory::MemoryCheckGuard guard;
+              DataSet result;
+              result.colNames = colNames;
+              for (auto& ds : results) {
+                result.rows.insert(result.rows.end(),
+                                   std::make_move_iterator(ds.rows.begin()),
+                                   std::make_move_iterator(ds.rows.end()));
+              }
+              finish(ResultBuilder().value(Value(std::move(result))).build());
+              return Status::OK();
+            });
+      });
+}
+
+folly::Future<std::vector<InnerJoinExecutor::KeyedRows>> InnerJoinExecutor::partitionByKeyHash(
+    const std::vector<Expression*>& keys, Iterator* iter) {
+  size_t numParts = numJoinParts_;
+  const auto* keysPtr = &keys;
+  auto scatter = [this, keysPtr, numParts](
+                     size_t begin, size_t end, Iterator* tmpIter) -> std::vector<KeyedRows> {
+    std::vector<Expression*> tmpKeys;
+    tmpKeys.reserve(keysPtr->size());
+    for (auto* e : *keysPtr) {
+      tmpKeys.emplace_back(e->clone());
+    }
+    std::vector<KeyedRows> parts(numParts);
+    QueryExpressionContext ctx(ectx_);
+    std::hash<Value> hasher;
+    for (; tmpIter->valid() && begin++ < end; tmpIter->next()) {
+      Value key;
+      if (tmpKeys.size() == 1) {
+        key = tmpKeys.front()->eval(ctx(tmpIter));
+      } else {
+        List list;
+        list.values.reserve(tmpKeys.size());
+        for (auto* col : tmpKeys) {
+          list.values.emplace_back(col->eval(ctx(tmpIter)));
+        }
+        key = Value(std::move(list));
+      }
+      parts[hasher(key) % numParts].emplace_back(std::move(key), tmpIter->row());
+    }
+    return parts;
+  };
+
+  auto gather = [numParts](std::vector<folly::Try<std::vector<KeyedRows>>>&& results)
+      -> std::vector<KeyedRows> {
+    memory::MemoryCheckGuard guard;
+    std::vector<KeyedRows> merged(numParts);
+    for (auto& respVal : results) {
+      if (respVal.hasException()) {
+        auto ex = respVal.exception().get_exception<std::bad_alloc>();
+        if (ex) {
+          throw std::bad_alloc();
+        } else {
+          throw std::runtime_error(respVal.exception().what().c_str());
+        }
+      }
+      auto parts = std::move(respVal).value();
+      for (size_t p = 0; p < numParts; ++p) {
+        if (merged[p].empty()) {
+          merged[p] = std::move(parts[p]);
+        } else {
+          merged[p].insert(merged[p].end(),
+                           std::make_move_iterator(parts[p].begin()),
+                           std::make_move_iterator(parts[p].end()));
+        }
+      }
+    }
+    return merged;
+  };
+
+  return runMultiJobs(std::move(scatter), std::move(gather), iter);
+}
+
+DataSet InnerJoinExecutor::joinPartition(const KeyedRows& buildRows,
+                                         const KeyedRows& probeRows) const {
+  DataSet ds;
+  if (buildRows.empty() || probeRows.empty()) {
+    return ds;
+  }
+  std::unordered_map<Value, std::vector<const Row*>> table;
+  table.reserve(buildRows.size());
+  for (auto& kv : buildRows) {
+    table[kv.first].emplace_back(kv.second);
+  }
+  ds.rows.reserve(probeRows.size());
+  for (auto& kv : probeRows) {
+    buildNewRow<Value>(table, kv.first, *kv.second, ds);
+  }
+  return ds;
+}
+
+namespace {
+
+std::vector<std::string> colNamesOf(Iterator* iter) {
+  const auto& colIndices = static_cast<SequentialIter*>(iter)->getColIndices();
+  std::vector<std::string> colNames(colIndices.size());
+  for (const auto& kv : colIndices) {
+    colNames[kv.second] = kv.first;
+  }
+  return colNames;
+}
+
+}  // namespace
+
+folly::Future<Status> InnerJoinExecutor::joinSpilled(const std::vector<Expression*>& hashKeys,
+                                                     const std::vector<Expression*>& probeKeys,
+                                                     const std::vector<std::string>& colNames) {
+  size_t numParts = numJoinParts_;
+  Iterator* buildIter = nullptr;
+  Iterator* probeIter = nullptr;
+  const std::vector<Expression*>* buildKeys = nullptr;
+  const std::vector<Expression*>* probeSideKeys = nullptr;
+  if (lhsIter_->size() < rhsIter_->size()) {
+    buildIter = lhsIter_.get();
+    buildKeys = &hashKeys;
+    probeIter = rhsIter_.get();
+    probeSideKeys = &probeKeys;
+  } else {
+    exchange_ = true;
+    buildIter = rhsIter_.get();
+    buildKeys = &probeKeys;
+    probeIter = lhsIter_.get();
+    probeSideKeys = &hashKeys;
+  }
+  // The restored chunks need the original column names, the key expressions resolve their
+  // columns by name
+  auto buildColNames = colNamesOf(buildIter);
+  auto probeColNames = colNamesOf(probeIter);
+
+  auto buildParts = partitionToSpill(*buildKeys, buildIter, numParts);
+  NG_RETURN_IF_ERROR(buildParts);
+  auto probeParts = partitionToSpill(*probeSideKeys, probeIter, numParts);
+  NG_RETURN_IF_ERROR(probeParts);
+
+  DataSet result;
+  result.colNames = colNames;
+  // The restored probe rows are owned by this executor, probe() may move them
+  mv_ = true;
+  for (size_t p = 0; p < numParts; ++p) {
+    auto& buildSpiller = buildParts.value()[p];
+    auto& probeSpiller = probeParts.value()[p];
+    if (buildSpiller->rowSize() == 0 || probeSpiller->rowSize() == 0) {
+      continue;
+    }
+    // One partition's build table in memory at a time
+    NG_RETURN_IF_ERROR(buildSpiller->rewind());
+    auto buildDs = buildSpiller->restore(buildSpiller->rowSize());
+    NG_RETURN_IF_ERROR(buildDs);
+    buildDs.value().colNames = buildColNames;
+    auto buildVal = std::make_shared<Value>(std::move(buildDs).value());
+    SequentialIter partBuildIter(buildVal);
+    std::unordered_map<HashedKey, std::vector<const Row*>> table;
+    table.reserve(partBuildIter.size());
+    buildHashTable(*buildKeys, &partBuildIter, table);
+
+    // The probe side streams back in bounded batches
+    NG_RETURN_IF_ERROR(probeSpiller->rewind());
+    while (probeSpiller->hasMore()) {
+      auto probeDs = probeSpiller->restore(FLAGS_executor_spill_batch_rows);
+      NG_RETURN_IF_ERROR(probeDs);
+      probeDs.value().colNames = probeColNames;
+      auto probeVal = std::make_shared<Value>(std::move(probeDs).value());
+      SequentialIter partProbeIter(probeVal);
+      auto partResult = probe(*probeSideKeys, &partProbeIter, table);
+      result.rows.insert(result.rows.end(),
+                         std::make_move_iterator(partResult.rows.begin()),
+                         std::make_move_iterator(partResult.rows.end()));
+    }
+  }
+  return finish(ResultBuilder().value(Value(std::move(result))).build());
+}
+
+StatusOr<std::vector<std::unique_ptr<RowSpiller>>> InnerJoinExecutor::partitionToSpill(
+    const std::vector<Expression*>& keys, Iterator* iter, size_t numParts) {
+  std::vector<std::unique_ptr<RowSpiller>> spillers;
+  spillers.reserve(numParts);
+  for (size_t p = 0; p < numParts; ++p) {
+    spillers.emplace_back(std::make_unique<RowSpiller>("inner_join"));
+  }
+  std::vector<DataSet> bufs(numParts);
+  QueryExpressionContext ctx(ectx_);
+  std::hash<Value> hasher;
+  for (; iter->valid(); iter->next()) {
+    Value key;
+    if (keys.size() == 1) {
+      key = keys.front()->eval(ctx(iter));
+    } else {
+      List list;
+      list.values.reserve(keys.size());
+      for (auto* col : keys) {
+        list.values.emplace_back(col->eval(ctx(iter)));
+      }
+      key = Value(std::move(list));
+    }
+    auto p = hasher(key) % numParts;
+    bufs[p].rows.emplace_back(*iter->row());
+    if (bufs[p].rows.size() >= FLAGS_executor_spill_batch_rows) {
+      NG_RETURN_IF_ERROR(spillers[p]->spill(bufs[p]));
+    }
+  }
+  for (size_t p = 0; p < numParts; ++p) {
+    if (!bufs[p].rows.empty()) {
+      NG_RETURN_IF_ERROR(spillers[p]->spill(bufs[p]));
+    }
+  }
+  return spillers;
+}
+
 template <class T>
 void InnerJoinExecutor::buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
                                     const T& val,
@@ -291,6 +578,9 @@ folly::Future<Status> HashInnerJoinExecutor::execute() {
   SCOPED_TIMER(&execTime_);
   auto* joinNode = asNode<HashJoin>(node());
   NG_RETURN_IF_ERROR(checkBiInputDataSets());
+  if (choosePartitionedJoin()) {
+    return joinPartitioned(joinNode->hashKeys(), joinNode->probeKeys(), joinNode->colNames());
+  }
   return join(joinNode->hashKeys(), joinNode->probeKeys(), joinNode->colNames());
 }
 
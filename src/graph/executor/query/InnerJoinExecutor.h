@@ -9,6 +9,8 @@
 namespace nebula {
 namespace graph {
 
+class RowSpiller;
+
 class InnerJoinExecutor : public JoinExecutor {
  public:
   InnerJoinExecutor(const PlanNode* node, QueryContext* qctx)
@@ -26,7 +28,7 @@ class InnerJoinExecutor : public JoinExecutor {
 
   DataSet probe(const std::vector<Expression*>& probeKeys,
                 Iterator* probeIter,
-                const std::unordered_map<List, std::vector<const Row*>>& hashTable) const;
+                const std::unordered_map<HashedKey, std::vector<const Row*>>& hashTable) const;
 
   DataSet singleKeyProbe(Expression* probeKey,
                          Iterator* probeIter,
@@ -42,6 +44,38 @@ class InnerJoinExecutor : public JoinExecutor {
 
   folly::Future<Status> singleKeyProbe(Expression* probeKey, Iterator* probeIter);
 
+  // Partitioned parallel mode: both sides are radix-partitioned by key hash into numJoinParts_
+  // partitions, every partition builds and probes its own hash table
+  // independently on the executor pool and the per-partition results are concatenated. Rows with
+  // equal keys always land in the same partition, so the partitions never have to look at each
+  // other.
+  using KeyedRows = std::vector<std::pair<Value, const Row*>>;
+
+  folly::Future<Status> joinPartitioned(const std::vector<Expression*>& hashKeys,
+                                        const std::vector<Expression*>& probeKeys,
+                                        const std::vector<std::string>& colNames);
+
+  // Decide, now that both inputs have materialized and their actual sizes are known, whether
+  // to run the partitioned join and with how many partitions (stored in numJoinParts_)
+  bool choosePartitionedJoin();
+
+  // Cut the iterator into job slices, evaluate the key of every row (multi-key rows are keyed by
+  // the List of their key values) and merge the slices into one row list per partition
+  folly::Future<std::vector<KeyedRows>> partitionByKeyHash(const std::vector<Expression*>& keys,
+                                                           Iterator* iter);
+
+  DataSet joinPartition(const KeyedRows& buildRows, const KeyedRows& probeRows) const;
+
+  // Grace-hash mode under memory pressure: both sides are hash-partitioned into per-partition
+  // spill files, then every partition is joined on its own with only that partition's rows in
+  // memory, so the query finishes slowly instead of failing with out of memory.
+  folly::Future<Status> joinSpilled(const std::vector<Expression*>& hashKeys,
+                                    const std::vector<Expression*>& probeKeys,
+                                    const std::vector<std::string>& colNames);
+
+  StatusOr<std::vector<std::unique_ptr<RowSpiller>>> partitionToSpill(
+      const std::vector<Expression*>& keys, Iterator* iter, size_t numParts);
+
   template <class T>
   void buildNewRow(const std::unordered_map<T, std::vector<const Row*>>& hashTable,
                    const T& val,
@@ -52,6 +86,10 @@ class InnerJoinExecutor : public JoinExecutor {
 
   const std::string& rightVar() const;
 
+ protected:
+  // Number of partitions the partitioned join runs with, chosen per execution
+  size_t numJoinParts_{0};
+
  private:
   bool exchange_{false};
   // Does the probe result movable?
@@ -17,6 +17,29 @@ folly::Future<Status> IntersectExecutor::execute() {
   auto left = getLeftInputData();
   auto right = getRightInputData();
 
+  if (inputsFullySorted()) {
+    // Both inputs arrive sorted by every column, so a single merge pass decides
+    // membership without hashing the right side
+    auto* lIter = left.iterRef();
+    auto* rIter = right.iterRef();
+    DataSet ds;
+    ds.colNames = lIter->valuePtr()->getDataSet().colNames;
+    while (lIter->valid() && rIter->valid()) {
+      if (*lIter->row() < *rIter->row()) {
+        lIter->next();
+      } else if (*rIter->row() < *lIter->row()) {
+        rIter->next();
+      } else {
+        // Keep the right cursor put so duplicate left rows all match, as with the hash set
+        ds.rows.emplace_back(*lIter->row());
+        lIter->next();
+      }
+    }
+    ResultBuilder builder;
+    builder.value(Value(std::move(ds))).iter(Iterator::Kind::kSequential);
+    return finish(builder.build());
+  }
+
   std::unordered_set<const Row*> hashSet;
   for (; right.iterRef()->valid(); right.iterRef()->next()) {
     hashSet.insert(right.iterRef()->row());
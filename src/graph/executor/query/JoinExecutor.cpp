@@ -73,9 +73,10 @@ Status JoinExecutor::checkBiInputDataSets() {
   return Status::OK();
 }
 
-void JoinExecutor::buildHashTable(const std::vector<Expression*>& hashKeys,
-                                  Iterator* iter,
-                                  std::unordered_map<List, std::vector<const Row*>>& hashTable) {
+void JoinExecutor::buildHashTable(
+    const std::vector<Expression*>& hashKeys,
+    Iterator* iter,
+    std::unordered_map<HashedKey, std::vector<const Row*>>& hashTable) {
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
     List list;
@@ -85,7 +86,7 @@ void JoinExecutor::buildHashTable(const std::vector<Expression*>& hashKeys,
       list.values.emplace_back(std::move(val));
     }
 
-    auto& vals = hashTable[list];
+    auto& vals = hashTable[HashedKey(std::move(list))];
     vals.emplace_back(iter->row());
   }
 }
@@ -10,6 +10,35 @@
 namespace nebula {
 namespace graph {
 
+// A multi-column join key carrying the hash of its values, computed once when the key is
+// built. Probes compare the cached hashes first, so the deep List walk only happens on a
+// genuine hash collision, and table growth never has to rehash the key values.
+struct HashedKey {
+  explicit HashedKey(List k) : key(std::move(k)), hash(std::hash<List>()(key)) {}
+
+  bool operator==(const HashedKey& rhs) const {
+    return hash == rhs.hash && key == rhs.key;
+  }
+
+  List key;
+  size_t hash;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+namespace std {
+template <>
+struct hash<nebula::graph::HashedKey> {
+  size_t operator()(const nebula::graph::HashedKey& k) const {
+    return k.hash;
+  }
+};
+}  // namespace std
+
+namespace nebula {
+namespace graph {
+
 class JoinExecutor : public Executor {
  public:
   JoinExecutor(const std::string& name, const PlanNode* node, QueryContext* qctx)
@@ -22,7 +51,7 @@ class JoinExecutor : public Executor {
 
   void buildHashTable(const std::vector<Expression*>& hashKeys,
                       Iterator* iter,
-                      std::unordered_map<List, std::vector<const Row*>>& hashTable);
+                      std::unordered_map<HashedKey, std::vector<const Row*>>& hashTable);
 
   void buildSingleKeyHashTable(Expression* hashKey,
                                Iterator* iter,
@@ -41,7 +70,7 @@ class JoinExecutor : public Executor {
   // of the right. If not, rhsOutputColIdxs_ will be empty.
   std::optional<std::vector<size_t>> rhsOutputColIdxs_;
   std::unordered_map<Value, std::vector<const Row*>> hashTable_;
-  std::unordered_map<List, std::vector<const Row*>> listHashTable_;
+  std::unordered_map<HashedKey, std::vector<const Row*>> listHashTable_;
 };
 }  // namespace graph
 }  // namespace nebula
@@ -43,7 +43,7 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
       result = singleKeyProbe(hashKeys.front(), lhsIter_.get(), hashTable);
     }
   } else {
-    std::unordered_map<List, std::vector<const Row*>> hashTable;
+    std::unordered_map<HashedKey, std::vector<const Row*>> hashTable;
     hashTable.reserve(rhsIter_->empty() ? 1 : rhsIter_->size());
     if (!lhsIter_->empty()) {
       buildHashTable(probeKeys, rhsIter_.get(), hashTable);
@@ -59,7 +59,7 @@ folly::Future<Status> LeftJoinExecutor::join(const std::vector<Expression*>& has
 DataSet LeftJoinExecutor::probe(
     const std::vector<Expression*>& probeKeys,
     Iterator* probeIter,
-    const std::unordered_map<List, std::vector<const Row*>>& hashTable) const {
+    const std::unordered_map<HashedKey, std::vector<const Row*>>& hashTable) const {
   DataSet ds;
   ds.rows.reserve(probeIter->size());
   QueryExpressionContext ctx(ectx_);
@@ -71,12 +71,13 @@ DataSet LeftJoinExecutor::probe(
       list.values.emplace_back(std::move(val));
     }
 
+    HashedKey key(std::move(list));
     if (mv_) {
       // Probe row only match key in HashTable once, so we could move it directly,
       // key/value in HashTable will be matched multiple times, so we can't move it.
-      buildNewRow<List>(hashTable, list, probeIter->moveRow(), ds);
+      buildNewRow<HashedKey>(hashTable, key, probeIter->moveRow(), ds);
     } else {
-      buildNewRow<List>(hashTable, list, *probeIter->row(), ds);
+      buildNewRow<HashedKey>(hashTable, key, *probeIter->row(), ds);
     }
   }
   return ds;
@@ -144,7 +145,8 @@ folly::Future<Status> LeftJoinExecutor::probe(const std::vector<Expression*>& pr
         list.values.emplace_back(std::move(val));
       }
 
-      buildNewRow<List>(listHashTable_, list, *tmpIter->row(), ds);
+      HashedKey key(std::move(list));
+      buildNewRow<HashedKey>(listHashTable_, key, *tmpIter->row(), ds);
     }
     return ds;
   };
@@ -19,6 +19,26 @@ folly::Future<Status> MinusExecutor::execute() {
   auto left = getLeftInputData();
   auto right = getRightInputData();
 
+  if (inputsFullySorted()) {
+    // Both inputs arrive sorted by every column, so a single merge pass decides
+    // membership without hashing the right side
+    auto* lIter = left.iterRef();
+    auto* rIter = right.iterRef();
+    DataSet ds;
+    ds.colNames = lIter->valuePtr()->getDataSet().colNames;
+    for (; lIter->valid(); lIter->next()) {
+      while (rIter->valid() && *rIter->row() < *lIter->row()) {
+        rIter->next();
+      }
+      if (!rIter->valid() || *lIter->row() < *rIter->row()) {
+        ds.rows.emplace_back(*lIter->row());
+      }
+    }
+    ResultBuilder builder;
+    builder.value(Value(std::move(ds))).iter(Iterator::Kind::kSequential);
+    return finish(builder.build());
+  }
+
   robin_hood::unordered_flat_set<const Row*, std::hash<const Row*>> hashSet;
   hashSet.reserve(right.iterRef()->size());
   for (; right.iterRef()->valid(); right.iterRef()->next()) {
@@ -19,7 +19,14 @@ folly::Future<Status> PatternApplyExecutor::execute() {
 
 Status PatternApplyExecutor::checkBiInputDataSets() {
   auto* patternApply = asNode<PatternApply>(node());
-  lhsIter_ = ectx_->getResult(patternApply->leftInputVar()).iter();
+  mv_ = movable(node()->inputVars()[0]);
+  Result lhsResult = ectx_->getResult(patternApply->leftInputVar());
+  if (!mv_) {
+    // The rows that do not match are erased from the underlying DataSet in place, so take a
+    // private copy when other readers of the variable remain (copy on first mutation)
+    lhsResult.detach();
+  }
+  lhsIter_ = std::move(lhsResult).iter();
   DCHECK(!!lhsIter_);
   if (lhsIter_->isGetNeighborsIter() || lhsIter_->isDefaultIter()) {
     std::stringstream ss;
@@ -63,43 +70,65 @@ void PatternApplyExecutor::collectValidKey(Expression* keyCol,
   }
 }
 
-DataSet PatternApplyExecutor::applyZeroKey(Iterator* appliedIter, const bool allValid) {
-  DataSet ds;
-  ds.rows.reserve(appliedIter->size());
+void PatternApplyExecutor::collectMatchedKeys(const std::vector<Expression*>& keyCols,
+                                              Iterator* iter,
+                                              const std::unordered_set<List>& appliedKeys,
+                                              std::unordered_set<List>& validKeys) const {
+  QueryExpressionContext ctx(ectx_);
+  for (; iter->valid() && validKeys.size() < appliedKeys.size(); iter->next()) {
+    List list;
+    list.values.reserve(keyCols.size());
+    for (auto& col : keyCols) {
+      Value val = col->eval(ctx(iter));
+      list.values.emplace_back(std::move(val));
+    }
+    if (appliedKeys.find(list) != appliedKeys.end()) {
+      validKeys.emplace(std::move(list));
+    }
+  }
+}
+
+void PatternApplyExecutor::collectMatchedKey(Expression* keyCol,
+                                             Iterator* iter,
+                                             const std::unordered_set<Value>& appliedKeys,
+                                             std::unordered_set<Value>& validKey) const {
   QueryExpressionContext ctx(ectx_);
-  for (; appliedIter->valid(); appliedIter->next()) {
-    Row row = mv_ ? appliedIter->moveRow() : *appliedIter->row();
-    if (allValid) {
-      ds.rows.emplace_back(std::move(row));
+  for (; iter->valid() && validKey.size() < appliedKeys.size(); iter->next()) {
+    auto& val = keyCol->eval(ctx(iter));
+    if (appliedKeys.find(val) != appliedKeys.end()) {
+      validKey.emplace(val);
     }
   }
-  return ds;
 }
 
-DataSet PatternApplyExecutor::applySingleKey(Expression* appliedKey,
-                                             Iterator* appliedIter,
-                                             const std::unordered_set<Value>& validKey) {
-  DataSet ds;
-  ds.rows.reserve(appliedIter->size());
+void PatternApplyExecutor::applyZeroKey(Iterator* appliedIter, const bool allValid) {
+  if (allValid) {
+    return;
+  }
+  appliedIter->clear();
+}
+
+void PatternApplyExecutor::applySingleKey(Expression* appliedKey,
+                                          Iterator* appliedIter,
+                                          const std::unordered_set<Value>& validKey) {
   QueryExpressionContext ctx(ectx_);
-  for (; appliedIter->valid(); appliedIter->next()) {
+  while (appliedIter->valid()) {
     auto& val = appliedKey->eval(ctx(appliedIter));
     bool applyFlag = (validKey.find(val) != validKey.end()) ^ isAntiPred_;
     if (applyFlag) {
-      Row row = mv_ ? appliedIter->moveRow() : *appliedIter->row();
-      ds.rows.emplace_back(std::move(row));
+      appliedIter->next();
+    } else {
+      appliedIter->unstableErase();
     }
   }
-  return ds;
+  appliedIter->reset();
 }
 
-DataSet PatternApplyExecutor::applyMultiKey(std::vector<Expression*> appliedKeys,
-                                            Iterator* appliedIter,
-                                            const std::unordered_set<List>& validKeys) {
-  DataSet ds;
-  ds.rows.reserve(appliedIter->size());
+void PatternApplyExecutor::applyMultiKey(std::vector<Expression*> appliedKeys,
+                                         Iterator* appliedIter,
+                                         const std::unordered_set<List>& validKeys) {
   QueryExpressionContext ctx(ectx_);
-  for (; appliedIter->valid(); appliedIter->next()) {
+  while (appliedIter->valid()) {
     List list;
     list.values.reserve(appliedKeys.size());
     for (auto& col : appliedKeys) {
@@ -109,27 +138,36 @@ DataSet PatternApplyExecutor::applyMultiKey(std::vector<Expression*> appliedKeys
 
     bool applyFlag = (validKeys.find(list) != validKeys.end()) ^ isAntiPred_;
     if (applyFlag) {
-      Row row = mv_ ? appliedIter->moveRow() : *appliedIter->row();
-      ds.rows.emplace_back(std::move(row));
+      appliedIter->next();
+    } else {
+      appliedIter->unstableErase();
     }
   }
-  return ds;
+  appliedIter->reset();
 }
 
 folly::Future<Status> PatternApplyExecutor::patternApply() {
   auto* patternApplyNode = asNode<PatternApply>(node());
   NG_RETURN_IF_ERROR(checkBiInputDataSets());
 
-  DataSet result;
-  mv_ = movable(node()->inputVars()[0]);
   auto keyCols = patternApplyNode->keyCols();
   if (keyCols.size() == 0) {
     // Reverse the valid flag if the pattern predicate is an anti-predicate
     applyZeroKey(lhsIter_.get(), (rhsIter_->size() > 0) ^ isAntiPred_);
   } else if (keyCols.size() == 1) {
     std::unordered_set<Value> validKey;
-    collectValidKey(keyCols[0]->clone(), rhsIter_.get(), validKey);
-    result = applySingleKey(keyCols[0]->clone(), lhsIter_.get(), validKey);
+    if (rhsIter_->size() > lhsIter_->size()) {
+      // When the pattern side is the bigger one, summarize the applied side's distinct keys
+      // first and scan the pattern side against that summary, so the key set stays bounded by
+      // the applied side and the scan can stop early once every key is accounted for
+      std::unordered_set<Value> appliedKeys;
+      collectValidKey(keyCols[0]->clone(), lhsIter_.get(), appliedKeys);
+      lhsIter_->reset();
+      collectMatchedKey(keyCols[0]->clone(), rhsIter_.get(), appliedKeys, validKey);
+    } else {
+      collectValidKey(keyCols[0]->clone(), rhsIter_.get(), validKey);
+    }
+    applySingleKey(keyCols[0]->clone(), lhsIter_.get(), validKey);
   } else {
     // Copy the keyCols to refresh the inside propIndex_ cache
     auto cloneExpr = [](std::vector<Expression*> exprs) {
@@ -142,12 +180,18 @@ folly::Future<Status> PatternApplyExecutor::patternApply() {
     };
 
     std::unordered_set<List> validKeys;
-    collectValidKeys(cloneExpr(keyCols), rhsIter_.get(), validKeys);
-    result = applyMultiKey(cloneExpr(keyCols), lhsIter_.get(), validKeys);
+    if (rhsIter_->size() > lhsIter_->size()) {
+      std::unordered_set<List> appliedKeys;
+      collectValidKeys(cloneExpr(keyCols), lhsIter_.get(), appliedKeys);
+      lhsIter_->reset();
+      collectMatchedKeys(cloneExpr(keyCols), rhsIter_.get(), appliedKeys, validKeys);
+    } else {
+      collectValidKeys(cloneExpr(keyCols), rhsIter_.get(), validKeys);
+    }
+    applyMultiKey(cloneExpr(keyCols), lhsIter_.get(), validKeys);
   }
 
-  result.colNames = patternApplyNode->colNames();
-  return finish(ResultBuilder().value(Value(std::move(result))).build());
+  return finish(ResultBuilder().value(lhsIter_->valuePtr()).iter(std::move(lhsIter_)).build());
 }
 
 }  // namespace graph
@@ -28,15 +28,31 @@ class PatternApplyExecutor : public Executor {
                        Iterator* iter,
                        std::unordered_set<Value>& validKey) const;
 
-  DataSet applyZeroKey(Iterator* appliedIter, const bool allValid);
+  // Semi-join variants of the collectors above: only the pattern-side keys that also occur on
+  // the applied side can affect the result, so keys outside appliedKeys are dropped instead of
+  // stored, and the scan stops as soon as every applied-side key has been seen
+  void collectMatchedKeys(const std::vector<Expression*>& keyCols,
+                          Iterator* iter,
+                          const std::unordered_set<List>& appliedKeys,
+                          std::unordered_set<List>& validKeys) const;
 
-  DataSet applySingleKey(Expression* appliedCol,
-                         Iterator* appliedIter,
-                         const std::unordered_set<Value>& validKey);
+  void collectMatchedKey(Expression* keyCol,
+                         Iterator* iter,
+                         const std::unordered_set<Value>& appliedKeys,
+                         std::unordered_set<Value>& validKey) const;
 
-  DataSet applyMultiKey(std::vector<Expression*> appliedKeys,
-                        Iterator* appliedIter,
-                        const std::unordered_set<List>& validKeys);
+  // The apply is a pure semi-join filter, so the rows that do not match are erased from the
+  // applied iterator in place and the result shares the underlying DataSet with the input
+  // instead of materializing a filtered copy
+  void applyZeroKey(Iterator* appliedIter, const bool allValid);
+
+  void applySingleKey(Expression* appliedCol,
+                      Iterator* appliedIter,
+                      const std::unordered_set<Value>& validKey);
+
+  void applyMultiKey(std::vector<Expression*> appliedKeys,
+                     Iterator* appliedIter,
+                     const std::unordered_set<List>& validKeys);
 
   folly::Future<Status> patternApply();
   std::unique_ptr<Iterator> lhsIter_;
@@ -44,7 +60,8 @@ class PatternApplyExecutor : public Executor {
 
   // Should apply the reverse when the pattern is an anti-predicate
   bool isAntiPred_{false};
-  // Check if the apply side dataset movable
+  // Whether the apply side dataset is exclusively owned, it's filtered in place when true and
+  // detached to a private copy first when false
   bool mv_{false};
 };
 
@@ -4,6 +4,8 @@
 
 #include "graph/executor/query/ProjectExecutor.h"
 
+#include "common/expression/ExprBytecode.h"
+#include "common/expression/PropertyExpression.h"
 #include "graph/planner/plan/Query.h"
 #include "graph/service/GraphFlags.h"
 
@@ -59,14 +61,50 @@ folly::Future<Status> ProjectExecutor::execute() {
 DataSet ProjectExecutor::handleJob(size_t begin, size_t end, Iterator *iter) {
   auto *project = asNode<Project>(node());
   auto columns = project->columns()->clone();
+  auto cols = columns->columns();
+  // Columns that are plain references to an input column skip evaluation altogether:
+  // the index is resolved once and the cell is copied straight out of the iterator row
+  std::vector<int64_t> colRefs(cols.size(), -1);
+  for (size_t i = 0; i < cols.size(); ++i) {
+    const auto *expr = cols[i]->expr();
+    const std::string *propName = nullptr;
+    if (expr->kind() == Expression::Kind::kInputProperty) {
+      propName = &static_cast<const InputPropertyExpression *>(expr)->prop();
+    } else if (expr->kind() == Expression::Kind::kVarProperty &&
+               static_cast<const VariablePropertyExpression *>(expr)->sym() ==
+                   project->inputVar()) {
+      propName = &static_cast<const VariablePropertyExpression *>(expr)->prop();
+    }
+    if (propName != nullptr && *propName != "*") {
+      auto idx = iter->getColumnIndex(*propName);
+      if (idx.ok()) {
+        colRefs[i] = idx.value();
+      }
+    }
+  }
+  // Columns whose expression compiles to bytecode are evaluated by the flat program, the
+  // others keep the interpreter
+  std::vector<std::unique_ptr<ExprBytecode>> programs(cols.size());
+  if (FLAGS_enable_expression_bytecode) {
+    for (size_t i = 0; i < cols.size(); ++i) {
+      if (colRefs[i] < 0) {
+        programs[i] = ExprBytecode::compile(cols[i]->expr());
+      }
+    }
+  }
   DataSet ds;
   ds.colNames = project->colNames();
   QueryExpressionContext ctx(qctx()->ectx());
   ds.rows.reserve(end - begin);
   for (; iter->valid() && begin++ < end; iter->next()) {
     Row row;
-    for (auto &col : columns->columns()) {
-      Value val = col->expr()->eval(ctx(iter));
+    for (size_t i = 0; i < cols.size(); ++i) {
+      if (colRefs[i] >= 0) {
+        row.values.emplace_back(iter->getColumn(colRefs[i]));
+        continue;
+      }
+      Value val =
+          programs[i] != nullptr ? programs[i]->eval(ctx(iter)) : cols[i]->expr()->eval(ctx(iter));
       row.values.emplace_back(std::move(val));
     }
     ds.rows.emplace_back(std::move(row));
@@ -40,7 +40,8 @@ Status RollUpApplyExecutor::checkBiInputDataSets() {
 void RollUpApplyExecutor::buildHashTable(const std::vector<Expression*>& compareCols,
                                          const InputPropertyExpression* collectCol,
                                          Iterator* iter,
-                                         std::unordered_map<List, List>& hashTable) const {
+                                         std::unordered_map<List, List>& hashTable,
+                                         const std::unordered_set<List>* probeKeys) const {
   QueryExpressionContext ctx(ectx_);
 
   for (; iter->valid(); iter->next()) {
@@ -50,6 +51,9 @@ void RollUpApplyExecutor::buildHashTable(const std::vector<Expression*>& compare
       Value val = col->eval(ctx(iter));
       list.values.emplace_back(std::move(val));
     }
+    if (probeKeys != nullptr && probeKeys->find(list) == probeKeys->end()) {
+      continue;
+    }
 
     auto& vals = hashTable[list];
     vals.emplace_back(const_cast<InputPropertyExpression*>(collectCol)->eval(ctx(iter)));
@@ -60,16 +64,45 @@ void RollUpApplyExecutor::buildSingleKeyHashTable(
     Expression* compareCol,
     const InputPropertyExpression* collectCol,
     Iterator* iter,
-    std::unordered_map<Value, List>& hashTable) const {
+    std::unordered_map<Value, List>& hashTable,
+    const std::unordered_set<Value>* probeKeys) const {
   QueryExpressionContext ctx(ectx_);
   for (; iter->valid(); iter->next()) {
     auto& val = compareCol->eval(ctx(iter));
+    if (probeKeys != nullptr && probeKeys->find(val) == probeKeys->end()) {
+      continue;
+    }
 
     auto& vals = hashTable[val];
     vals.emplace_back(const_cast<InputPropertyExpression*>(collectCol)->eval(ctx(iter)));
   }
 }
 
+void RollUpApplyExecutor::collectProbeKeys(const std::vector<Expression*>& compareCols,
+                                           Iterator* iter,
+                                           std::unordered_set<List>& probeKeys) const {
+  QueryExpressionContext ctx(ectx_);
+  for (; iter->valid(); iter->next()) {
+    List list;
+    list.values.reserve(compareCols.size());
+    for (auto& col : compareCols) {
+      Value val = col->eval(ctx(iter));
+      list.values.emplace_back(std::move(val));
+    }
+    probeKeys.emplace(std::move(list));
+  }
+}
+
+void RollUpApplyExecutor::collectProbeKey(Expression* compareCol,
+                                          Iterator* iter,
+                                          std::unordered_set<Value>& probeKeys) const {
+  QueryExpressionContext ctx(ectx_);
+  for (; iter->valid(); iter->next()) {
+    auto& val = compareCol->eval(ctx(iter));
+    probeKeys.emplace(val);
+  }
+}
+
 void RollUpApplyExecutor::buildZeroKeyHashTable(const InputPropertyExpression* collectCol,
                                                 Iterator* iter,
                                                 List& hashTable) const {
@@ -152,8 +185,20 @@ folly::Future<Status> RollUpApplyExecutor::rollUpApply() {
     result = probeZeroKey(lhsIter_.get(), hashTable);
   } else if (compareCols.size() == 1) {
     std::unordered_map<Value, List> hashTable;
-    buildSingleKeyHashTable(
-        compareCols[0]->clone(), rollUpApplyNode->collectCol(), rhsIter_.get(), hashTable);
+    std::unordered_set<Value> probeKeys;
+    const std::unordered_set<Value>* probeKeysPtr = nullptr;
+    if (rhsIter_->size() > lhsIter_->size()) {
+      // When the pattern side is the bigger one, summarize the probe side's distinct keys
+      // first so the hash table only collects rows that some probe row will ask for
+      collectProbeKey(compareCols[0]->clone(), lhsIter_.get(), probeKeys);
+      lhsIter_->reset();
+      probeKeysPtr = &probeKeys;
+    }
+    buildSingleKeyHashTable(compareCols[0]->clone(),
+                            rollUpApplyNode->collectCol(),
+                            rhsIter_.get(),
+                            hashTable,
+                            probeKeysPtr);
     result = probeSingleKey(compareCols[0]->clone(), lhsIter_.get(), hashTable);
   } else {
     // Copy the compareCols to make sure the propIndex_ is not cached in the expr
@@ -167,8 +212,18 @@ folly::Future<Status> RollUpApplyExecutor::rollUpApply() {
     };
 
     std::unordered_map<List, List> hashTable;
-    buildHashTable(
-        cloneExpr(compareCols), rollUpApplyNode->collectCol(), rhsIter_.get(), hashTable);
+    std::unordered_set<List> probeKeys;
+    const std::unordered_set<List>* probeKeysPtr = nullptr;
+    if (rhsIter_->size() > lhsIter_->size()) {
+      collectProbeKeys(cloneExpr(compareCols), lhsIter_.get(), probeKeys);
+      lhsIter_->reset();
+      probeKeysPtr = &probeKeys;
+    }
+    buildHashTable(cloneExpr(compareCols),
+                   rollUpApplyNode->collectCol(),
+                   rhsIter_.get(),
+                   hashTable,
+                   probeKeysPtr);
 
     result = probe(cloneExpr(compareCols), lhsIter_.get(), hashTable);
   }
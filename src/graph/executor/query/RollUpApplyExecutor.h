@@ -22,15 +22,29 @@ class RollUpApplyExecutor : public Executor {
 
   Status checkBiInputDataSets();
 
+  // probeKeys, when not null, holds the distinct key set of the probe (left) side: rows whose
+  // key cannot be probed are skipped instead of collected, a semi-join style pre-filter for
+  // the common case where the pattern side is much bigger than the side it is rolled up onto
   void buildHashTable(const std::vector<Expression*>& compareCols,
                       const InputPropertyExpression* collectCol,
                       Iterator* iter,
-                      std::unordered_map<List, List>& hashTable) const;
+                      std::unordered_map<List, List>& hashTable,
+                      const std::unordered_set<List>* probeKeys = nullptr) const;
 
   void buildSingleKeyHashTable(Expression* compareCol,
                                const InputPropertyExpression* collectCol,
                                Iterator* iter,
-                               std::unordered_map<Value, List>& hashTable) const;
+                               std::unordered_map<Value, List>& hashTable,
+                               const std::unordered_set<Value>* probeKeys = nullptr) const;
+
+  // Collect the distinct keys of the probe (left) side to bound the hash table build
+  void collectProbeKeys(const std::vector<Expression*>& compareCols,
+                        Iterator* iter,
+                        std::unordered_set<List>& probeKeys) const;
+
+  void collectProbeKey(Expression* compareCol,
+                       Iterator* iter,
+                       std::unordered_set<Value>& probeKeys) const;
 
   void buildZeroKeyHashTable(const InputPropertyExpression* collectCol,
                              Iterator* iter,
@@ -28,6 +28,7 @@ folly::Future<Status> ScanEdgesExecutor::scanEdges() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
   return DCHECK_NOTNULL(client)
       ->scanEdge(param, *DCHECK_NOTNULL(se->props()), se->limit(), se->filter())
       .via(runner())
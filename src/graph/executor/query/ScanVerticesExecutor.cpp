@@ -29,6 +29,7 @@ folly::Future<Status> ScanVerticesExecutor::scanVertices() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
+  param.deadlineUs = qctx()->deadlineUs();
   return DCHECK_NOTNULL(storageClient)
       ->scanVertex(param, *DCHECK_NOTNULL(sv->props()), sv->limit(), sv->filter())
       .via(runner())
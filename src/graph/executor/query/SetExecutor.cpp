@@ -71,5 +71,19 @@ Result SetExecutor::getRightInputData() const {
   return ectx_->getResult(right);
 }
 
+bool SetExecutor::inputsFullySorted() const {
+  auto setNode = asNode<SetOp>(node());
+  auto sortOrder = [this](const std::string& var) -> std::vector<std::string> {
+    auto* variable = qctx_->symTable()->getVar(var);
+    if (variable == nullptr || variable->writtenBy.size() != 1) {
+      return {};
+    }
+    return (*variable->writtenBy.begin())->sortedBy();
+  };
+  auto leftOrder = sortOrder(setNode->leftInputVar());
+  return !leftOrder.empty() && leftOrder == colNames_ &&
+         sortOrder(setNode->rightInputVar()) == leftOrder;
+}
+
 }  // namespace graph
 }  // namespace nebula
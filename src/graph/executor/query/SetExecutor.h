@@ -15,6 +15,9 @@ class SetExecutor : public Executor {
   std::unique_ptr<Iterator> getRightInputDataIter() const;
   Result getLeftInputData() const;
   Result getRightInputData() const;
+  // Whether both inputs are known to arrive sorted ascending by every column, so a
+  // single merge pass can replace the hash table. Call after checkInputDataSets().
+  bool inputsFullySorted() const;
 
  protected:
   SetExecutor(const std::string &name, const PlanNode *node, QueryContext *qctx)
@@ -4,11 +4,101 @@
 
 #include "graph/executor/query/SortExecutor.h"
 
+#include <cstring>
+#include <numeric>
+
 #include "graph/planner/plan/Query.h"
+#include "graph/util/ColumnarBlock.h"
+#include "graph/util/RowSpiller.h"
+
+DECLARE_uint64(executor_spill_batch_rows);
 
 namespace nebula {
 namespace graph {
 
+namespace {
+
+// One sorted run on disk plus the batch currently restored from it
+struct RunCursor {
+  std::unique_ptr<RowSpiller> spiller;
+  DataSet buf;
+  size_t pos{0};
+};
+
+// External merge sort: cut the input into runs, sort each run in memory and spill it,
+// then stream a k-way merge of the runs into the output. Peak memory is roughly one
+// copy of the dataset (the merged output, which downstream iterators need materialized
+// anyway) plus one restore batch per run, instead of input and output side by side.
+template <typename Comparator>
+StatusOr<DataSet> externalMergeSort(SequentialIter *iter,
+                                    std::vector<std::string> colNames,
+                                    const Comparator &comparator) {
+  const auto total = iter->size();
+  const auto runRows = std::max<size_t>(FLAGS_executor_spill_batch_rows, 1);
+
+  std::vector<RunCursor> runs;
+  runs.reserve(total / runRows + 1);
+  auto rowIt = iter->begin();
+  while (rowIt != iter->end()) {
+    auto n = std::min<size_t>(runRows, std::distance(rowIt, iter->end()));
+    DataSet run;
+    run.rows.reserve(n);
+    for (size_t i = 0; i < n; ++i, ++rowIt) {
+      run.rows.emplace_back(std::move(*rowIt));
+    }
+    std::sort(run.rows.begin(), run.rows.end(), comparator);
+    RunCursor cursor;
+    cursor.spiller = std::make_unique<RowSpiller>("sort_run");
+    NG_RETURN_IF_ERROR(cursor.spiller->spill(run));
+    runs.emplace_back(std::move(cursor));
+  }
+  iter->clear();
+
+  auto refill = [](RunCursor &rc) -> Status {
+    if (rc.pos < rc.buf.rows.size() || !rc.spiller->hasMore()) {
+      return Status::OK();
+    }
+    auto batch = rc.spiller->restore(FLAGS_executor_spill_batch_rows);
+    NG_RETURN_IF_ERROR(batch);
+    rc.buf = std::move(batch).value();
+    rc.pos = 0;
+    return Status::OK();
+  };
+
+  std::vector<size_t> heap;
+  heap.reserve(runs.size());
+  for (size_t i = 0; i < runs.size(); ++i) {
+    NG_RETURN_IF_ERROR(runs[i].spiller->rewind());
+    NG_RETURN_IF_ERROR(refill(runs[i]));
+    if (runs[i].pos < runs[i].buf.rows.size()) {
+      heap.emplace_back(i);
+    }
+  }
+  // Max-heap on the inverted comparator, so the top is the smallest front row
+  auto heapCmp = [&runs, &comparator](size_t l, size_t r) {
+    return comparator(runs[r].buf.rows[runs[r].pos], runs[l].buf.rows[runs[l].pos]);
+  };
+  std::make_heap(heap.begin(), heap.end(), heapCmp);
+
+  DataSet out(std::move(colNames));
+  out.rows.reserve(total);
+  while (!heap.empty()) {
+    std::pop_heap(heap.begin(), heap.end(), heapCmp);
+    auto &rc = runs[heap.back()];
+    out.rows.emplace_back(std::move(rc.buf.rows[rc.pos]));
+    ++rc.pos;
+    NG_RETURN_IF_ERROR(refill(rc));
+    if (rc.pos < rc.buf.rows.size()) {
+      std::push_heap(heap.begin(), heap.end(), heapCmp);
+    } else {
+      heap.pop_back();
+    }
+  }
+  return out;
+}
+
+}  // namespace
+
 folly::Future<Status> SortExecutor::execute() {
   SCOPED_TIMER(&execTime_);
 
@@ -43,7 +133,67 @@ folly::Future<Status> SortExecutor::execute() {
   };
 
   auto seqIter = static_cast<SequentialIter *>(iter);
-  std::sort(seqIter->begin(), seqIter->end(), comparator);
+
+  // Under memory pressure an in-place sort is still fine, but the dataset may be about
+  // to not fit at all once downstream copies it; go through the spill files instead
+  if (RowSpiller::needSpill() && seqIter->size() > FLAGS_executor_spill_batch_rows) {
+    std::vector<std::string> colNames;
+    if (result.valuePtr() != nullptr && result.valuePtr()->isDataSet()) {
+      colNames = result.valuePtr()->getDataSet().colNames;
+    }
+    auto sorted = externalMergeSort(seqIter, std::move(colNames), comparator);
+    NG_RETURN_IF_ERROR(sorted);
+    return finish(ResultBuilder().value(Value(std::move(sorted).value())).build());
+  }
+
+  // When every key column holds one scalar type throughout, sort an index vector over
+  // typed column vectors instead: the hot loop compares raw ints/doubles/strings with
+  // no per-cell Value dispatch, and each row is moved exactly once at the end
+  std::vector<size_t> keyCols;
+  keyCols.reserve(factors.size());
+  for (auto &item : factors) {
+    keyCols.emplace_back(item.first);
+  }
+  auto block = ColumnarBlock::extract(seqIter->begin(), seqIter->end(), keyCols);
+  if (block.has_value()) {
+    std::vector<uint32_t> idx(block->numRows());
+    std::iota(idx.begin(), idx.end(), 0);
+    std::vector<bool> descending;
+    descending.reserve(factors.size());
+    for (auto &item : factors) {
+      descending.push_back(item.second == OrderFactor::OrderType::DESCEND);
+    }
+    size_t stride = 0;
+    auto keys = block->normalizeKeys(descending, &stride);
+    if (keys.has_value()) {
+      // All keys are fixed-width: one memcmp over the normalized key replaces the whole
+      // per-column comparison loop
+      const uint8_t *base = keys->data();
+      std::sort(idx.begin(), idx.end(), [base, stride](uint32_t lhs, uint32_t rhs) {
+        return std::memcmp(base + lhs * stride, base + rhs * stride, stride) < 0;
+      });
+    } else {
+      std::sort(idx.begin(), idx.end(), [&block, &factors](uint32_t lhs, uint32_t rhs) {
+        for (size_t k = 0; k < factors.size(); ++k) {
+          auto cmp = block->compareAt(k, lhs, rhs);
+          if (cmp == 0) {
+            continue;
+          }
+          return factors[k].second == OrderFactor::OrderType::ASCEND ? cmp < 0 : cmp > 0;
+        }
+        return false;
+      });
+    }
+    std::vector<Row> sorted;
+    sorted.reserve(idx.size());
+    auto beg = seqIter->begin();
+    for (auto i : idx) {
+      sorted.emplace_back(std::move(*(beg + i)));
+    }
+    std::move(sorted.begin(), sorted.end(), beg);
+  } else {
+    std::sort(seqIter->begin(), seqIter->end(), comparator);
+  }
   return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
 }
 
@@ -4,7 +4,10 @@
 
 #include "graph/executor/query/TopNExecutor.h"
 
+#include <numeric>
+
 #include "graph/planner/plan/Query.h"
+#include "graph/util/ColumnarBlock.h"
 
 namespace nebula {
 namespace graph {
@@ -59,7 +62,42 @@ folly::Future<Status> TopNExecutor::execute() {
     return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
   }
 
-  executeTopN<SequentialIter>(iter);
+  // Same columnar shortcut as SortExecutor: select over an index vector backed by typed
+  // key columns when the keys are uniformly typed scalars, fall back to the row heap
+  auto seqIter = static_cast<SequentialIter *>(iter);
+  std::vector<size_t> keyCols;
+  keyCols.reserve(factors.size());
+  for (auto &item : factors) {
+    keyCols.emplace_back(item.first);
+  }
+  auto block = ColumnarBlock::extract(seqIter->begin(), seqIter->end(), keyCols);
+  if (block.has_value()) {
+    std::vector<uint32_t> idx(block->numRows());
+    std::iota(idx.begin(), idx.end(), 0);
+    std::partial_sort(idx.begin(),
+                      idx.begin() + heapSize_,
+                      idx.end(),
+                      [&block, &factors](uint32_t lhs, uint32_t rhs) {
+                        for (size_t k = 0; k < factors.size(); ++k) {
+                          auto cmp = block->compareAt(k, lhs, rhs);
+                          if (cmp == 0) {
+                            continue;
+                          }
+                          return factors[k].second == OrderFactor::OrderType::ASCEND ? cmp < 0
+                                                                                     : cmp > 0;
+                        }
+                        return false;
+                      });
+    std::vector<Row> top;
+    top.reserve(maxCount_);
+    auto beg = seqIter->begin();
+    for (int i = 0; i < maxCount_; ++i) {
+      top.emplace_back(std::move(*(beg + idx[offset_ + i])));
+    }
+    std::move(top.begin(), top.end(), beg);
+  } else {
+    executeTopN<SequentialIter>(iter);
+  }
   iter->eraseRange(maxCount_, size);
   return finish(ResultBuilder().value(result.valuePtr()).iter(std::move(result).iter()).build());
 }
@@ -54,7 +54,7 @@ Status TraverseExecutor::buildRequestVids() {
       } else {
         vidIter->second.emplace_back(std::move(prevPath));
       }
-      vids_.emplace(vid);
+      queueVid(vid);
     }
   } else {
     const auto& spaceInfo = qctx()->rctx()->session()->space();
@@ -69,7 +69,7 @@ Status TraverseExecutor::buildRequestVids() {
       // DCHECK_EQ(vid.type(), vidType)
       //     << "Mismatched vid type: " << vid.type() << ", space vid type: " << vidType;
       if (vid.type() == vidType) {
-        vids_.emplace(vid);
+        queueVid(vid);
       }
     }
   }
@@ -85,8 +85,9 @@ folly::Future<Status> TraverseExecutor::getNeighbors() {
                                           qctx()->rctx()->session()->id(),
                                           qctx()->plan()->id(),
                                           qctx()->plan()->isProfileEnabled());
-  std::vector<Value> vids(vids_.size());
-  std::move(vids_.begin(), vids_.end(), vids.begin());
+  param.deadlineUs = qctx()->deadlineUs();
+  auto vids = std::move(vids_);
+  vids_ = std::vector<Value>();
   return storageClient
       ->getNeighbors(param,
                      {nebula::kVid},
@@ -108,6 +109,7 @@ folly::Future<Status> TraverseExecutor::getNeighbors() {
         // MemoryTrackerVerified
         memory::MemoryCheckGuard guard;
         vids_.clear();
+        queuedVids_.clear();
         SCOPED_TIMER(&execTime_);
         addStats(resp, getNbrTime.elapsedInUSec());
         time::Duration expandTime;
@@ -234,7 +236,7 @@ folly::Future<Status> TraverseExecutor::asyncExpandOneStep(RpcResponse&& resps)
         vids_.reserve(sizeOf(*vidsList));
         for (auto& vids : *vidsList) {
           for (auto& v : vids) {
-            vids_.emplace(std::move(v));
+            queueVid(v);
           }
         }
 
@@ -263,12 +265,17 @@ folly::Future<Status> TraverseExecutor::expandOneStep(RpcResponse&& resps) {
   }
 
   initVertices_.reserve(numRows);
+  VidHashSet vids;
   for (auto& resp : resps.responses()) {
     auto dataset = resp.get_vertices();
     if (dataset) {
-      buildAdjList(*dataset, initVertices_, vids_, adjList_);
+      buildAdjList(*dataset, initVertices_, vids, adjList_);
     }
   }
+  vids_.reserve(vids_.size() + vids.size());
+  for (auto& v : vids) {
+    queueVid(v);
+  }
 
   return Status::OK();
 }
@@ -348,7 +355,7 @@ void TraverseExecutor::expand(GetNeighborsIter* iter) {
     }
     const auto& dst = edge.getEdge().dst;
     if (adjList_.find(dst) == adjList_.end()) {
-      vids_.emplace(dst);
+      queueVid(dst);
     }
     const auto& vertex = iter->getVertex();
     curVertex = curVertex.empty() ? vertex : curVertex;
@@ -412,21 +419,75 @@ folly::Future<Status> TraverseExecutor::buildResult() {
   if (maxStep == 0) {
     return finish(ResultBuilder().value(Value(std::move(result_))).build());
   }
+  buildTopNComparator();
   if (FLAGS_max_job_size <= 1) {
     for (const auto& initVertex : initVertices_) {
       auto paths = buildPath(initVertex, minStep, maxStep);
       if (paths.empty()) {
         continue;
       }
-      result_.rows.insert(result_.rows.end(),
-                          std::make_move_iterator(paths.begin()),
-                          std::make_move_iterator(paths.end()));
+      collectResultRows(std::move(paths));
     }
     return finish(ResultBuilder().value(Value(std::move(result_))).build());
   }
   return buildPathMultiJobs(minStep, maxStep);
 }
 
+void TraverseExecutor::buildTopNComparator() {
+  if (traverse_->topNLimit() < 0) {
+    return;
+  }
+  const auto& factors = traverse_->topNFactors();
+  topNCmp_ = [&factors](const Row& lhs, const Row& rhs) {
+    for (auto& item : factors) {
+      auto index = item.first;
+      auto orderType = item.second;
+      if (lhs[index] == rhs[index]) {
+        continue;
+      }
+      if (orderType == OrderFactor::OrderType::ASCEND) {
+        return lhs[index] < rhs[index];
+      } else if (orderType == OrderFactor::OrderType::DESCEND) {
+        return lhs[index] > rhs[index];
+      }
+    }
+    return false;
+  };
+}
+
+void TraverseExecutor::collectResultRows(std::vector<Row>&& rows) {
+  auto limit = traverse_->topNLimit();
+  if (limit < 0) {
+    result_.rows.insert(result_.rows.end(),
+                        std::make_move_iterator(rows.begin()),
+                        std::make_move_iterator(rows.end()));
+    return;
+  }
+  // A TopN above pushed its bound down here: keep only the best `limit` rows as a heap with
+  // the worst retained row on top, the TopN will do the final ordering of the survivors
+  auto bound = static_cast<size_t>(limit);
+  for (auto& row : rows) {
+    if (result_.rows.size() < bound) {
+      result_.rows.emplace_back(std::move(row));
+      continue;
+    }
+    if (!topNHeaped_) {
+      std::make_heap(result_.rows.begin(), result_.rows.end(), topNCmp_);
+      // The zero step rows may already run over the bound
+      while (result_.rows.size() > bound) {
+        std::pop_heap(result_.rows.begin(), result_.rows.end(), topNCmp_);
+        result_.rows.pop_back();
+      }
+      topNHeaped_ = true;
+    }
+    if (topNCmp_(row, result_.rows.front())) {
+      std::pop_heap(result_.rows.begin(), result_.rows.end(), topNCmp_);
+      result_.rows.back() = std::move(row);
+      std::push_heap(result_.rows.begin(), result_.rows.end(), topNCmp_);
+    }
+  }
+}
+
 folly::Future<Status> TraverseExecutor::buildPathMultiJobs(size_t minStep, size_t maxStep) {
   DataSet vertices;
   vertices.rows.reserve(initVertices_.size());
@@ -472,9 +533,7 @@ folly::Future<Status> TraverseExecutor::buildPathMultiJobs(size_t minStep, size_
       if (rows.empty()) {
         continue;
       }
-      result_.rows.insert(result_.rows.end(),
-                          std::make_move_iterator(rows.begin()),
-                          std::make_move_iterator(rows.end()));
+      collectResultRows(std::move(rows));
     }
     finish(ResultBuilder().value(Value(std::move(result_))).build());
     return Status::OK();
@@ -9,6 +9,7 @@
 
 #include "graph/executor/StorageAccessExecutor.h"
 #include "graph/planner/plan/Query.h"
+#include "graph/util/VidDictionary.h"
 #include "interface/gen-cpp2/storage_types.h"
 
 // only used in match scenarios
@@ -74,6 +75,12 @@ class TraverseExecutor final : public StorageAccessExecutor {
 
   folly::Future<Status> buildResult();
 
+  void buildTopNComparator();
+
+  // Append the rows to the result, keeping only the best topNLimit rows in a bounded heap
+  // when a TopN bound was pushed down into this node
+  void collectResultRows(std::vector<Row>&& rows);
+
   std::vector<Row> buildPath(const Value& initVertex, size_t minStep, size_t maxStep);
   folly::Future<Status> buildPathMultiJobs(size_t minStep, size_t maxStep);
   std::vector<Row> joinPrevPath(const Value& initVertex, const std::vector<Row>& newResult) const;
@@ -90,11 +97,23 @@ class TraverseExecutor final : public StorageAccessExecutor {
 
   Expression* selectFilter();
 
+  // Queue `vid' for the next getNeighbors round unless it is already queued this step.
+  // The dedup runs on dense ids: one intern per vid, then a bitset probe
+  void queueVid(const Value& vid) {
+    if (queuedVids_.insert(vidDict_.intern(vid))) {
+      vids_.emplace_back(vid);
+    }
+  }
+
  private:
   ObjectPool objPool_;
 
   bool genPath_{false};
-  VidHashSet vids_;
+  // Next-hop frontier plus its per-step dedup state; the dictionary lives for the whole
+  // traversal so vids revisited on later steps hash only into the flat id map
+  std::vector<Value> vids_;
+  VidDictionary vidDict_;
+  DenseIdSet queuedVids_;
   std::vector<Value> initVertices_;
   DataSet result_;
   // Key : vertex  Value : adjacent edges
@@ -103,6 +122,8 @@ class TraverseExecutor final : public StorageAccessExecutor {
   const Traverse* traverse_{nullptr};
   MatchStepRange range_;
   size_t currentStep_{0};
+  std::function<bool(const Row&, const Row&)> topNCmp_;
+  bool topNHeaped_{false};
 };
 
 }  // namespace graph
@@ -11,6 +11,8 @@
 #include "graph/planner/plan/Query.h"
 #include "graph/util/ExpressionUtils.h"
 
+DECLARE_uint64(filter_memo_max_cardinality);
+
 namespace nebula {
 namespace graph {
 
@@ -73,6 +75,20 @@ TEST_F(FilterTest, TestSequential) {
                       expected);
 }
 
+TEST_F(FilterTest, TestSequentialMemoOverflow) {
+  // Force the memo over its cardinality bound so the filter falls back to plain evaluation
+  auto oldBound = FLAGS_filter_memo_max_cardinality;
+  FLAGS_filter_memo_max_cardinality = 1;
+  DataSet expected({"name"});
+  expected.emplace_back(Row({Value("Ann")}));
+  expected.emplace_back(Row({Value("Ann")}));
+  FILTER_RESULT_CHECK("input_sequential",
+                      "filter_sequential_memo",
+                      "YIELD $-.v_name AS name WHERE $-.e_start_year >= 2010",
+                      expected);
+  FLAGS_filter_memo_max_cardinality = oldBound;
+}
+
 TEST_F(FilterTest, TestNullValue) {
   DataSet expected({"name"});
   FILTER_RESULT_CHECK(
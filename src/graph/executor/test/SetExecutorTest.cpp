@@ -460,5 +460,96 @@ TEST_F(SetExecutorTest, TestMinus) {
   }
 }
 
+TEST_F(SetExecutorTest, TestSortedMerge) {
+  // When both inputs are produced by a Sort over every column ascending, the set
+  // executors take the merge path instead of building a hash table; the results must
+  // match the hash path
+  std::vector<std::pair<size_t, OrderFactor::OrderType>> factors = {
+      {0, OrderFactor::OrderType::ASCEND},
+      {1, OrderFactor::OrderType::ASCEND},
+  };
+
+  auto test = [this, &factors](bool isMinus,
+                               const DataSet& lds,
+                               const DataSet& rds,
+                               const DataSet& expected) {
+    auto leftSort = Sort::make(qctx_.get(), StartNode::make(qctx_.get()), factors);
+    leftSort->setColNames(lds.colNames);
+    auto rightSort = Sort::make(qctx_.get(), StartNode::make(qctx_.get()), factors);
+    rightSort->setColNames(rds.colNames);
+    SetOp* setOp = nullptr;
+    if (isMinus) {
+      setOp = Minus::make(qctx_.get(), leftSort, rightSort);
+    } else {
+      setOp = Intersect::make(qctx_.get(), leftSort, rightSort);
+    }
+    setOp->setLeftVar(leftSort->outputVar());
+    setOp->setRightVar(rightSort->outputVar());
+
+    ResultBuilder lb, rb;
+    lb.value(Value(lds)).iter(Iterator::Kind::kSequential);
+    rb.value(Value(rds)).iter(Iterator::Kind::kSequential);
+    auto executor = Executor::create(setOp, qctx_.get());
+    qctx_->ectx()->setResult(leftSort->outputVar(), lb.build());
+    qctx_->ectx()->setResult(rightSort->outputVar(), rb.build());
+
+    auto fut = executor->execute();
+    auto status = std::move(fut).get();
+    EXPECT_TRUE(status.ok());
+
+    auto& result = qctx_->ectx()->getResult(setOp->outputVar());
+    EXPECT_TRUE(result.value().isDataSet());
+    EXPECT_TRUE(diffDataSet(result.value().getDataSet(), expected))
+        << "\nResult dataset: \n"
+        << result.value().getDataSet() << "Expected dataset: \n"
+        << expected;
+  };
+
+  DataSet lds;
+  lds.colNames = {"col1", "col2"};
+  lds.rows = {
+      Row({Value(1), Value("row1")}),
+      Row({Value(1), Value("row1")}),
+      Row({Value(2), Value("row2")}),
+      Row({Value(4), Value("row4")}),
+  };
+
+  DataSet rds;
+  rds.colNames = {"col1", "col2"};
+  rds.rows = {
+      Row({Value(1), Value("row1")}),
+      Row({Value(3), Value("row3")}),
+      Row({Value(4), Value("row4")}),
+  };
+
+  // Intersect keeps every left duplicate that has a match, like the hash path
+  {
+    DataSet expected;
+    expected.colNames = {"col1", "col2"};
+    expected.rows = {
+        Row({Value(1), Value("row1")}),
+        Row({Value(1), Value("row1")}),
+        Row({Value(4), Value("row4")}),
+    };
+    test(false, lds, rds, expected);
+  }
+  // Minus drops every left row with a match
+  {
+    DataSet expected;
+    expected.colNames = {"col1", "col2"};
+    expected.rows = {
+        Row({Value(2), Value("row2")}),
+    };
+    test(true, lds, rds, expected);
+  }
+  // Empty right side
+  {
+    DataSet empty;
+    empty.colNames = {"col1", "col2"};
+    test(false, lds, empty, empty);
+    test(true, lds, empty, lds);
+  }
+}
+
 }  // namespace graph
 }  // namespace nebula
@@ -32,107 +32,107 @@ void GraphStorageLocalServer::setInterface(
 }
 
 folly::Future<cpp2::GetNeighborsResponse> GraphStorageLocalServer::future_getNeighbors(
-    const cpp2::GetNeighborsRequest& request) {
+    cpp2::GetNeighborsRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::GetNeighborsResponse, future_getNeighbors);
 }
 
 folly::Future<cpp2::GetDstBySrcResponse> GraphStorageLocalServer::future_getDstBySrc(
-    const cpp2::GetDstBySrcRequest& request) {
+    cpp2::GetDstBySrcRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::GetDstBySrcResponse, future_getDstBySrc);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_addVertices(
-    const cpp2::AddVerticesRequest& request) {
+    cpp2::AddVerticesRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_addVertices);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_chainAddEdges(
-    const cpp2::AddEdgesRequest& request) {
+    cpp2::AddEdgesRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_chainAddEdges);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_addEdges(
-    const cpp2::AddEdgesRequest& request) {
+    cpp2::AddEdgesRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_addEdges);
 }
 
 folly::Future<cpp2::GetPropResponse> GraphStorageLocalServer::future_getProps(
-    const cpp2::GetPropRequest& request) {
+    cpp2::GetPropRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::GetPropResponse, future_getProps);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_deleteEdges(
-    const cpp2::DeleteEdgesRequest& request) {
+    cpp2::DeleteEdgesRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_deleteEdges);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_chainDeleteEdges(
-    const cpp2::DeleteEdgesRequest& request) {
+    cpp2::DeleteEdgesRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_chainDeleteEdges);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_deleteVertices(
-    const cpp2::DeleteVerticesRequest& request) {
+    cpp2::DeleteVerticesRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_deleteVertices);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_deleteTags(
-    const cpp2::DeleteTagsRequest& request) {
+    cpp2::DeleteTagsRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_deleteTags);
 }
 
 folly::Future<cpp2::UpdateResponse> GraphStorageLocalServer::future_updateVertex(
-    const cpp2::UpdateVertexRequest& request) {
+    cpp2::UpdateVertexRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::UpdateResponse, future_updateVertex);
 }
 
 folly::Future<cpp2::UpdateResponse> GraphStorageLocalServer::future_chainUpdateEdge(
-    const cpp2::UpdateEdgeRequest& request) {
+    cpp2::UpdateEdgeRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::UpdateResponse, future_chainUpdateEdge);
 }
 
 folly::Future<cpp2::UpdateResponse> GraphStorageLocalServer::future_updateEdge(
-    const cpp2::UpdateEdgeRequest& request) {
+    cpp2::UpdateEdgeRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::UpdateResponse, future_updateEdge);
 }
 
 folly::Future<cpp2::GetUUIDResp> GraphStorageLocalServer::future_getUUID(
-    const cpp2::GetUUIDReq& request) {
+    cpp2::GetUUIDReq request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::GetUUIDResp, future_getUUID);
 }
 
 folly::Future<cpp2::LookupIndexResp> GraphStorageLocalServer::future_lookupIndex(
-    const cpp2::LookupIndexRequest& request) {
+    cpp2::LookupIndexRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::LookupIndexResp, future_lookupIndex);
 }
 
 folly::Future<cpp2::GetNeighborsResponse> GraphStorageLocalServer::future_lookupAndTraverse(
-    const cpp2::LookupAndTraverseRequest& request) {
+    cpp2::LookupAndTraverseRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::GetNeighborsResponse, future_lookupAndTraverse);
 }
 
 folly::Future<cpp2::ScanResponse> GraphStorageLocalServer::future_scanVertex(
-    const cpp2::ScanVertexRequest& request) {
+    cpp2::ScanVertexRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ScanResponse, future_scanVertex);
 }
 
 folly::Future<cpp2::ScanResponse> GraphStorageLocalServer::future_scanEdge(
-    const cpp2::ScanEdgeRequest& request) {
+    cpp2::ScanEdgeRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ScanResponse, future_scanEdge);
 }
 
 folly::Future<cpp2::KVGetResponse> GraphStorageLocalServer::future_get(
-    const cpp2::KVGetRequest& request) {
+    cpp2::KVGetRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::KVGetResponse, future_get);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_put(
-    const cpp2::KVPutRequest& request) {
+    cpp2::KVPutRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_put);
 }
 
 folly::Future<cpp2::ExecResponse> GraphStorageLocalServer::future_remove(
-    const cpp2::KVRemoveRequest& request) {
+    cpp2::KVRemoveRequest request) {
   LOCAL_RETURN_FUTURE(threadManager_, cpp2::ExecResponse, future_remove);
 }
 
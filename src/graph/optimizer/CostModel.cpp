@@ -0,0 +1,166 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/CostModel.h"
+
+#include "common/time/WallClock.h"
+#include "graph/context/QueryContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+DEFINE_bool(enable_optimizer_cost_model,
+            false,
+            "Whether to cost scan plan alternatives with the per-space statistics collected "
+            "by the STATS job");
+DEFINE_uint32(optimizer_stats_cache_secs,
+              600,
+              "How long the optimizer caches the space statistics fetched from meta");
+
+using nebula::graph::IndexScan;
+using nebula::graph::PlanNode;
+using nebula::graph::QueryContext;
+
+namespace nebula {
+namespace opt {
+
+namespace {
+
+// Without NDV there is no per-column selectivity, so prefix and range scans get fixed
+// discounts. That is coarse, but enough to prefer any selective scan over a full scan of
+// the same schema.
+constexpr double kPrefixScanSelectivity = 0.1;
+constexpr double kRangeScanSelectivity = 0.5;
+
+struct StatsCacheEntry {
+  int64_t loadedAt{0};
+  StatusOr<SpaceStats> stats = Status::Error("Space statistics not loaded");
+};
+
+double scanRows(const IndexScan *scan, const SpaceStats &stats, QueryContext *qctx) {
+  auto nameRet = scan->isEdge() ? qctx->schemaMng()->toEdgeName(scan->space(), scan->schemaId())
+                                : qctx->schemaMng()->toTagName(scan->space(), scan->schemaId());
+  if (nameRet.ok()) {
+    const auto &counts = scan->isEdge() ? stats.edgeCounts : stats.tagVertices;
+    auto iter = counts.find(nameRet.value());
+    if (iter != counts.end()) {
+      return static_cast<double>(iter->second);
+    }
+  }
+  // The stats predate the schema (or the schema id is gone); fall back to the space total
+  return static_cast<double>(scan->isEdge() ? stats.spaceEdges : stats.spaceVertices);
+}
+
+double scanSelectivity(const IndexScan *scan) {
+  switch (scan->kind()) {
+    case PlanNode::Kind::kTagIndexPrefixScan:
+    case PlanNode::Kind::kEdgeIndexPrefixScan:
+      return kPrefixScanSelectivity;
+    case PlanNode::Kind::kTagIndexRangeScan:
+    case PlanNode::Kind::kEdgeIndexRangeScan:
+      return kRangeScanSelectivity;
+    case PlanNode::Kind::kIndexScan: {
+      // A plain IndexScan is selective only when every query context carries column hints
+      if (scan->queryContext().empty()) {
+        return 1.0;
+      }
+      for (const auto &ictx : scan->queryContext()) {
+        if (ictx.get_column_hints().empty()) {
+          return 1.0;
+        }
+      }
+      return kPrefixScanSelectivity;
+    }
+    default:
+      return 1.0;
+  }
+}
+
+}  // namespace
+
+StatusOr<SpaceStats> CostModel::loadStats(QueryContext *qctx, GraphSpaceID spaceId) {
+  static std::mutex mutex;
+  static std::unordered_map<GraphSpaceID, StatsCacheEntry> cache;
+
+  auto now = time::WallClock::fastNowInSec();
+  {
+    std::lock_guard<std::mutex> guard(mutex);
+    auto iter = cache.find(spaceId);
+    if (iter != cache.end() &&
+        now - iter->second.loadedAt < static_cast<int64_t>(FLAGS_optimizer_stats_cache_secs)) {
+      return iter->second.stats;
+    }
+  }
+
+  auto resp = qctx->getMetaClient()->getStats(spaceId).get();
+  StatusOr<SpaceStats> result = Status::OK();
+  if (!resp.ok()) {
+    // Most likely no STATS job has run for the space yet. Cache the failure too, so a
+    // space without statistics does not pay one meta RPC per query.
+    result = resp.status();
+  } else {
+    auto item = std::move(resp).value();
+    SpaceStats stats;
+    stats.spaceVertices = item.get_space_vertices();
+    stats.spaceEdges = item.get_space_edges();
+    stats.tagVertices = item.get_tag_vertices();
+    stats.edgeCounts = item.get_edges();
+    result = std::move(stats);
+  }
+
+  std::lock_guard<std::mutex> guard(mutex);
+  auto &entry = cache[spaceId];
+  entry.loadedAt = now;
+  entry.stats = result;
+  return result;
+}
+
+void CostModel::annotate(const OptGroup *root, const SpaceStats &stats, QueryContext *qctx) {
+  std::unordered_set<const OptGroup *> visited;
+  std::queue<const OptGroup *> queue;
+  queue.push(root);
+  visited.emplace(root);
+  while (!queue.empty()) {
+    const auto *group = queue.front();
+    queue.pop();
+    for (const auto *groupNode : group->groupNodes()) {
+      groupNode->node()->setCost(estimate(groupNode->node(), stats, qctx));
+      for (auto *dep : groupNode->dependencies()) {
+        if (visited.emplace(dep).second) {
+          queue.push(dep);
+        }
+      }
+      for (auto *body : groupNode->bodies()) {
+        if (visited.emplace(body).second) {
+          queue.push(body);
+        }
+      }
+    }
+  }
+}
+
+double CostModel::estimate(const PlanNode *node, const SpaceStats &stats, QueryContext *qctx) {
+  switch (node->kind()) {
+    case PlanNode::Kind::kScanVertices:
+      return static_cast<double>(stats.spaceVertices);
+    case PlanNode::Kind::kScanEdges:
+      return static_cast<double>(stats.spaceEdges);
+    case PlanNode::Kind::kIndexScan:
+    case PlanNode::Kind::kTagIndexFullScan:
+    case PlanNode::Kind::kTagIndexPrefixScan:
+    case PlanNode::Kind::kTagIndexRangeScan:
+    case PlanNode::Kind::kEdgeIndexFullScan:
+    case PlanNode::Kind::kEdgeIndexPrefixScan:
+    case PlanNode::Kind::kEdgeIndexRangeScan: {
+      const auto *scan = static_cast<const IndexScan *>(node);
+      return scanRows(scan, stats, qctx) * scanSelectivity(scan);
+    }
+    default:
+      return 0.0;
+  }
+}
+
+}  // namespace opt
+}  // namespace nebula
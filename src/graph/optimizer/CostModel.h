@@ -0,0 +1,61 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_COSTMODEL_H_
+#define GRAPH_OPTIMIZER_COSTMODEL_H_
+
+#include "common/base/StatusOr.h"
+#include "common/thrift/ThriftTypes.h"
+
+DECLARE_bool(enable_optimizer_cost_model);
+
+namespace nebula {
+namespace graph {
+class PlanNode;
+class QueryContext;
+}  // namespace graph
+
+namespace opt {
+
+class OptGroup;
+
+// Per-space cardinalities distilled from the meta StatsItem that the storage STATS job
+// collects. Counts are zero until a `SUBMIT JOB STATS` has finished for the space.
+struct SpaceStats {
+  int64_t spaceVertices{0};
+  int64_t spaceEdges{0};
+  // Vertex count per tag name and out-edge count per edge name
+  std::unordered_map<std::string, int64_t> tagVertices;
+  std::unordered_map<std::string, int64_t> edgeCounts;
+};
+
+// Assigns cardinality based costs to the plan nodes inside the optimizer memo, so that
+// OptGroup::findMinCostGroupNode compares scan alternatives by estimated rows instead of
+// falling through to the first group node. Only scan-like plan nodes get a non-zero cost;
+// everything else keeps the default and the plan choice degenerates to today's behavior.
+class CostModel final {
+ public:
+  CostModel() = delete;
+
+  // Fetch the statistics of the given space from meta. Results (including the "no stats
+  // job has run" failure) are cached process-wide for FLAGS_optimizer_stats_cache_secs to
+  // keep the meta RPC off the per-query path.
+  static StatusOr<SpaceStats> loadStats(graph::QueryContext *qctx, GraphSpaceID spaceId);
+
+  // Annotate the cost of every plan node reachable from the given memo root
+  static void annotate(const OptGroup *root, const SpaceStats &stats, graph::QueryContext *qctx);
+
+ private:
+  // Estimated number of rows the plan node produces, or 0.0 when the stats say nothing
+  // about it
+  static double estimate(const graph::PlanNode *node,
+                         const SpaceStats &stats,
+                         graph::QueryContext *qctx);
+};
+
+}  // namespace opt
+}  // namespace nebula
+
+#endif  // GRAPH_OPTIMIZER_COSTMODEL_H_
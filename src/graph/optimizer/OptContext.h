@@ -51,6 +51,16 @@ class OptContext final : private boost::noncopyable, private cpp::NonMovable {
   void addPlanNodeAndOptGroupNode(int64_t planNodeId, const OptGroupNode *optGroupNode);
   const OptGroupNode *findOptGroupNodeByPlanNodeId(int64_t planNodeId) const;
 
+  // Global change tick for the dirty tracking of the memo: bumped whenever the membership
+  // of some opt group changes, so exploration can tell changed subtrees from unchanged ones
+  uint64_t changeTick() const {
+    return changeTick_;
+  }
+
+  uint64_t bumpChangeTick() {
+    return ++changeTick_;
+  }
+
  private:
   friend OptGroup;
   friend Optimizer;
@@ -62,6 +72,8 @@ class OptContext final : private boost::noncopyable, private cpp::NonMovable {
   std::unordered_map<int64_t, const OptGroupNode *> planNodeToOptGroupNodeMap_;
   std::unordered_set<const OptGroup *> visited_;
   std::unordered_map<const OptGroup *, const graph::PlanNode *> group2PlanNodeMap_;
+  std::unordered_map<const OptGroup *, double> group2CostMap_;
+  uint64_t changeTick_{0};
 };
 
 }  // namespace opt
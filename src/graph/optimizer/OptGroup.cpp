@@ -27,16 +27,50 @@ OptGroup *OptGroup::create(OptContext *ctx) {
   return ctx->objPool()->makeAndAdd<OptGroup>(ctx);
 }
 
+void OptGroup::setExplored(const OptRule *rule) {
+  exploredRules_.emplace_back(rule, ctx_->changeTick());
+}
+
+uint64_t OptGroup::subtreeChangeTick(std::unordered_map<const OptGroup *, uint64_t> &memo) const {
+  auto found = memo.find(this);
+  if (found != memo.end()) {
+    return found->second;
+  }
+  // Seed the memo with the own tick before descending, in case of cycles through bodies
+  memo.emplace(this, changeTick_);
+  uint64_t tick = changeTick_;
+  for (auto *gn : groupNodes_) {
+    for (auto *dep : gn->dependencies()) {
+      tick = std::max(tick, dep->subtreeChangeTick(memo));
+    }
+    for (auto *body : gn->bodies()) {
+      tick = std::max(tick, body->subtreeChangeTick(memo));
+    }
+  }
+  memo[this] = tick;
+  return tick;
+}
+
 void OptGroup::setUnexplored(const OptRule *rule) {
+  std::unordered_map<const OptGroup *, uint64_t> memo;
+  setUnexplored(rule, memo);
+}
+
+void OptGroup::setUnexplored(const OptRule *rule,
+                             std::unordered_map<const OptGroup *, uint64_t> &memo) {
   if (!ctx_->visited_.emplace(this).second) {
     return;
   }
-  auto iter = std::find(exploredRules_.begin(), exploredRules_.end(), rule);
-  if (iter != exploredRules_.end()) {
+  auto iter = std::find_if(exploredRules_.begin(),
+                           exploredRules_.end(),
+                           [rule](const auto &entry) { return entry.first == rule; });
+  // Keep the rule explored while nothing below this group changed since it last matched
+  // here, so the next round does not re-match the unchanged subtree
+  if (iter != exploredRules_.end() && subtreeChangeTick(memo) > iter->second) {
     exploredRules_.erase(iter);
   }
   for (auto node : groupNodes_) {
-    node->setUnexplored(rule);
+    node->setUnexplored(rule, memo);
   }
 }
 
@@ -122,6 +156,7 @@ Status OptGroup::validate(const OptRule *rule) const {
 
 void OptGroup::addGroupNode(OptGroupNode *groupNode) {
   DCHECK_EQ(this, DCHECK_NOTNULL(groupNode)->group());
+  changeTick_ = ctx_->bumpChangeTick();
   if (outputVar_.empty()) {
     outputVar_ = groupNode->node()->outputVar();
   } else {
@@ -208,6 +243,7 @@ Status OptGroup::explore(const OptRule *rule) {
     if (result.eraseCurr) {
       (*iter)->release();
       iter = groupNodes_.erase(iter);
+      changeTick_ = ctx_->bumpChangeTick();
     } else {
       ++iter;
     }
@@ -246,7 +282,16 @@ std::pair<double, const OptGroupNode *> OptGroup::findMinCostGroupNode() const {
 }
 
 double OptGroup::getCost() const {
-  return findMinCostGroupNode().first;
+  // Groups are shared across group nodes, so memoize the min cost to keep the recursive
+  // accumulation linear in the size of the memo
+  auto &group2CostMap = ctx_->group2CostMap_;
+  auto iter = group2CostMap.find(this);
+  if (iter != group2CostMap.end()) {
+    return iter->second;
+  }
+  double cost = findMinCostGroupNode().first;
+  group2CostMap.emplace(this, cost);
+  return cost;
 }
 
 const PlanNode *OptGroup::getPlan() const {
@@ -270,6 +315,7 @@ void OptGroup::deleteRefGroupNode(const OptGroupNode *node) {
       n->release();
     }
     groupNodes_.clear();
+    changeTick_ = ctx_->bumpChangeTick();
   }
 }
 
@@ -279,16 +325,39 @@ OptGroupNode *OptGroupNode::create(OptContext *ctx, PlanNode *node, const OptGro
   return optGNode;
 }
 
+void OptGroupNode::setExplored(const OptRule *rule) {
+  exploredRules_.emplace_back(rule, group_->ctx_->changeTick());
+}
+
 void OptGroupNode::setUnexplored(const OptRule *rule) {
-  auto iter = std::find(exploredRules_.begin(), exploredRules_.end(), rule);
+  std::unordered_map<const OptGroup *, uint64_t> memo;
+  setUnexplored(rule, memo);
+}
+
+void OptGroupNode::setUnexplored(const OptRule *rule,
+                                 std::unordered_map<const OptGroup *, uint64_t> &memo) {
+  auto iter = std::find_if(exploredRules_.begin(),
+                           exploredRules_.end(),
+                           [rule](const auto &entry) { return entry.first == rule; });
   if (iter != exploredRules_.end()) {
-    exploredRules_.erase(iter);
+    // The rule could newly match on this node only if some group it depends on changed
+    // after the rule explored it
+    uint64_t tick = 0;
+    for (auto dep : dependencies_) {
+      tick = std::max(tick, dep->subtreeChangeTick(memo));
+    }
+    for (auto body : bodies_) {
+      tick = std::max(tick, body->subtreeChangeTick(memo));
+    }
+    if (tick > iter->second) {
+      exploredRules_.erase(iter);
+    }
   }
   for (auto dep : dependencies_) {
-    dep->setUnexplored(rule);
+    dep->setUnexplored(rule, memo);
   }
   for (auto body : bodies_) {
-    body->setUnexplored(rule);
+    body->setUnexplored(rule, memo);
   }
 }
 
@@ -317,7 +386,16 @@ Status OptGroupNode::explore(const OptRule *rule) {
 }
 
 double OptGroupNode::getCost() const {
-  return node_->cost();
+  // The cost of a group node is the cost of its own plan node plus the cost of the best
+  // alternative of every group it depends on, so alternatives are compared as whole subplans
+  double cost = node_->cost();
+  for (auto dep : dependencies_) {
+    cost += dep->getCost();
+  }
+  for (auto body : bodies_) {
+    cost += body->getCost();
+  }
+  return cost;
 }
 
 const PlanNode *OptGroupNode::getPlan() const {
@@ -25,13 +25,17 @@ class OptGroup final {
   static OptGroup *create(OptContext *ctx);
 
   bool isExplored(const OptRule *rule) const {
-    return std::find(exploredRules_.cbegin(), exploredRules_.cend(), rule) != exploredRules_.cend();
+    return std::find_if(exploredRules_.cbegin(), exploredRules_.cend(), [rule](const auto &entry) {
+             return entry.first == rule;
+           }) != exploredRules_.cend();
   }
 
-  void setExplored(const OptRule *rule) {
-    exploredRules_.emplace_back(rule);
-  }
+  // Record that the rule has explored this group, together with the current change tick, so
+  // setUnexplored can tell whether anything in the subtree changed afterwards
+  void setExplored(const OptRule *rule);
 
+  // Re-enable the rule only for the groups whose subtree changed since the rule explored
+  // them, instead of re-matching the whole memo every round
   void setUnexplored(const OptRule *rule);
 
   void addGroupNode(OptGroupNode *groupNode);
@@ -62,6 +66,7 @@ class OptGroup final {
 
  private:
   friend ObjectPool;
+  friend class OptGroupNode;
   explicit OptGroup(OptContext *ctx) noexcept;
 
   static constexpr int16_t kMaxExplorationRound = 128;
@@ -71,9 +76,17 @@ class OptGroup final {
                          const OptRule *rule,
                          const std::vector<OptGroup *> &patternLeaves) const;
 
+  // The largest change tick of this group and every group reachable through its group
+  // nodes' dependencies and bodies, memoized per traversal since the memo is a dag
+  uint64_t subtreeChangeTick(std::unordered_map<const OptGroup *, uint64_t> &memo) const;
+  void setUnexplored(const OptRule *rule, std::unordered_map<const OptGroup *, uint64_t> &memo);
+
   OptContext *ctx_{nullptr};
   std::list<OptGroupNode *> groupNodes_;
-  std::vector<const OptRule *> exploredRules_;
+  // Rules which explored this group, each with the global change tick at that moment
+  std::vector<std::pair<const OptRule *, uint64_t>> exploredRules_;
+  // Tick of the last membership change of this group
+  uint64_t changeTick_{0};
   // The output variable should be same across the whole group.
   std::string outputVar_;
 
@@ -111,12 +124,12 @@ class OptGroupNode final {
   }
 
   bool isExplored(const OptRule *rule) const {
-    return std::find(exploredRules_.cbegin(), exploredRules_.cend(), rule) != exploredRules_.cend();
+    return std::find_if(exploredRules_.cbegin(), exploredRules_.cend(), [rule](const auto &entry) {
+             return entry.first == rule;
+           }) != exploredRules_.cend();
   }
 
-  void setExplored(const OptRule *rule) {
-    exploredRules_.emplace_back(rule);
-  }
+  void setExplored(const OptRule *rule);
 
   void setUnexplored(const OptRule *rule);
 
@@ -139,13 +152,17 @@ class OptGroupNode final {
 
  private:
   friend ObjectPool;
+  friend OptGroup;
   OptGroupNode(graph::PlanNode *node, const OptGroup *group) noexcept;
 
+  void setUnexplored(const OptRule *rule, std::unordered_map<const OptGroup *, uint64_t> &memo);
+
   graph::PlanNode *node_{nullptr};
   const OptGroup *group_{nullptr};
   std::vector<OptGroup *> dependencies_;
   std::vector<OptGroup *> bodies_;
-  std::vector<const OptRule *> exploredRules_;
+  // Rules which explored this group node, each with the global change tick at that moment
+  std::vector<std::pair<const OptRule *, uint64_t>> exploredRules_;
 };
 
 }  // namespace opt
@@ -6,12 +6,14 @@
 #include "graph/optimizer/Optimizer.h"
 
 #include "graph/context/QueryContext.h"
+#include "graph/optimizer/CostModel.h"
 #include "graph/optimizer/OptContext.h"
 #include "graph/optimizer/OptGroup.h"
 #include "graph/optimizer/OptRule.h"
 #include "graph/planner/plan/ExecutionPlan.h"
 #include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/PlanNode.h"
+#include "graph/visitor/EliminateCommonExprVisitor.h"
 #include "graph/visitor/PrunePropertiesVisitor.h"
 
 using nebula::graph::BinaryInputNode;
@@ -22,6 +24,10 @@ using nebula::graph::Select;
 using nebula::graph::SingleDependencyNode;
 
 DEFINE_bool(enable_optimizer_property_pruner_rule, true, "");
+DEFINE_bool(enable_optimizer_common_expr_eliminate,
+            false,
+            "Whether to fold constants and share duplicate sub-expressions inside the column "
+            "lists of Project nodes after optimization");
 DEFINE_uint64(max_plan_depth, 512, "The max depth of plan tree");
 
 namespace nebula {
@@ -46,6 +52,18 @@ StatusOr<const PlanNode *> Optimizer::findBestPlan(QueryContext *qctx) {
   rootGroup->setRootGroup();
 
   NG_RETURN_IF_ERROR(doExploration(optCtx.get(), rootGroup));
+
+  if (FLAGS_enable_optimizer_cost_model && spaceID != nebula::graph::kInvalidSpaceID) {
+    auto statsRet = CostModel::loadStats(qctx, spaceID);
+    if (statsRet.ok()) {
+      CostModel::annotate(rootGroup, statsRet.value(), qctx);
+    } else {
+      // Without statistics every plan node keeps the default zero cost and the group
+      // selection below behaves exactly as before
+      VLOG(1) << "No statistics for space " << spaceID << ": " << statsRet.status();
+    }
+  }
+
   auto *newRoot = rootGroup->getPlan();
 
   NG_RETURN_IF_ERROR(postprocess(const_cast<PlanNode *>(newRoot), qctx, spaceID));
@@ -56,6 +74,10 @@ StatusOr<const PlanNode *> Optimizer::findBestPlan(QueryContext *qctx) {
 Status Optimizer::postprocess(PlanNode *root, graph::QueryContext *qctx, GraphSpaceID spaceID) {
   std::unordered_set<const PlanNode *> visitedPlanNode;
   NG_RETURN_IF_ERROR(rewriteArgumentInputVar(root, visitedPlanNode));
+  if (FLAGS_enable_optimizer_common_expr_eliminate) {
+    graph::EliminateCommonExprVisitor exprVisitor;
+    root->accept(&exprVisitor);
+  }
   if (FLAGS_enable_optimizer_property_pruner_rule) {
     graph::PropertyTracker propsUsed;
     graph::PrunePropertiesVisitor visitor(propsUsed, qctx, spaceID);
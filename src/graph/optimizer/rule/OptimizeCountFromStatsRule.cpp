@@ -0,0 +1,136 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/OptimizeCountFromStatsRule.h"
+
+#include "common/expression/AggregateExpression.h"
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/service/GraphFlags.h"
+
+using nebula::graph::Aggregate;
+using nebula::graph::CountFromStats;
+using nebula::graph::PlanNode;
+using nebula::graph::QueryContext;
+using nebula::graph::ScanEdges;
+using nebula::graph::ScanVertices;
+
+namespace nebula {
+namespace opt {
+
+/*static*/ const std::initializer_list<graph::PlanNode::Kind>
+    OptimizeCountFromStatsRule::kScanKinds{
+        graph::PlanNode::Kind::kScanVertices,
+        graph::PlanNode::Kind::kScanEdges,
+    };
+
+std::unique_ptr<OptRule> OptimizeCountFromStatsRule::kInstance =
+    std::unique_ptr<OptimizeCountFromStatsRule>(new OptimizeCountFromStatsRule());
+
+OptimizeCountFromStatsRule::OptimizeCountFromStatsRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &OptimizeCountFromStatsRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      graph::PlanNode::Kind::kAggregate,
+      {Pattern::create(graph::PlanNode::Kind::kProject, {Pattern::create(kScanKinds)})});
+  return pattern;
+}
+
+StatusOr<OptRule::TransformResult> OptimizeCountFromStatsRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  if (!FLAGS_enable_count_from_stats) {
+    return TransformResult::noTransform();
+  }
+  auto *qctx = octx->qctx();
+  auto aggGroupNode = matched.node;
+  auto scanGroupNode = matched.dependencies.front().dependencies.front().node;
+
+  const auto agg = static_cast<const Aggregate *>(aggGroupNode->node());
+  const auto scan = scanGroupNode->node();
+
+  // Only a bare COUNT over a constant is a plain row count; the Project in between is
+  // row-preserving, so it does not affect the count
+  if (!agg->groupKeys().empty() || agg->groupItems().size() != 1) {
+    return TransformResult::noTransform();
+  }
+  auto *item = agg->groupItems().front();
+  if (item->kind() != Expression::Kind::kAggregate) {
+    return TransformResult::noTransform();
+  }
+  auto *aggExpr = static_cast<AggregateExpression *>(item);
+  auto func = aggExpr->name();
+  std::transform(func.begin(), func.end(), func.begin(), ::toupper);
+  if (func != "COUNT" || aggExpr->distinct() ||
+      aggExpr->arg()->kind() != Expression::Kind::kConstant) {
+    return TransformResult::noTransform();
+  }
+
+  bool isEdge = scan->kind() == PlanNode::Kind::kScanEdges;
+  GraphSpaceID space;
+  std::string schemaName;
+  if (isEdge) {
+    const auto *scanEdges = scan->asNode<ScanEdges>();
+    if (scanEdges->filter() != nullptr || scanEdges->limit(qctx) >= 0 || scanEdges->dedup()) {
+      return TransformResult::noTransform();
+    }
+    space = scanEdges->space();
+    const auto *props = scanEdges->props();
+    if (props != nullptr && !props->empty()) {
+      if (props->size() != 1 || props->front().get_type() < 0) {
+        return TransformResult::noTransform();
+      }
+      auto nameRet = qctx->schemaMng()->toEdgeName(space, props->front().get_type());
+      if (!nameRet.ok()) {
+        return TransformResult::noTransform();
+      }
+      schemaName = std::move(nameRet).value();
+    }
+  } else {
+    const auto *scanVertices = scan->asNode<ScanVertices>();
+    if (scanVertices->filter() != nullptr || scanVertices->limit(qctx) >= 0 ||
+        scanVertices->dedup()) {
+      return TransformResult::noTransform();
+    }
+    space = scanVertices->space();
+    const auto *props = scanVertices->props();
+    if (props != nullptr && !props->empty()) {
+      // A multi-tag scan emits one row per vertex, which matches neither a per-tag
+      // count nor necessarily the whole-space count
+      if (props->size() != 1) {
+        return TransformResult::noTransform();
+      }
+      auto nameRet = qctx->schemaMng()->toTagName(space, props->front().get_tag());
+      if (!nameRet.ok()) {
+        return TransformResult::noTransform();
+      }
+      schemaName = std::move(nameRet).value();
+    }
+  }
+
+  auto *newCount = CountFromStats::make(qctx, nullptr, space, std::move(schemaName), isEdge);
+  newCount->setOutputVar(agg->outputVar());
+  newCount->setColNames(agg->colNames());
+  newCount->setInputVar(scan->asNode<graph::SingleInputNode>()->inputVar());
+  auto newGroupNode = OptGroupNode::create(octx, newCount, aggGroupNode->group());
+  for (auto dep : scanGroupNode->dependencies()) {
+    newGroupNode->dependsOn(dep);
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newGroupNode);
+  return result;
+}
+
+std::string OptimizeCountFromStatsRule::toString() const {
+  return "OptimizeCountFromStatsRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
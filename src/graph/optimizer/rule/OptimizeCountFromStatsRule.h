@@ -0,0 +1,70 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_OPTIMIZECOUNTFROMSTATSRULE_H
+#define GRAPH_OPTIMIZER_RULE_OPTIMIZECOUNTFROMSTATSRULE_H
+
+#include <initializer_list>
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Answer a bare COUNT over a full scan from the stats the meta service keeps, instead
+//  of scanning the data
+//  Required conditions:
+//   1. Match the pattern
+//   2. FLAGS_enable_count_from_stats is on (the stats are only as fresh as the last
+//      stats job, so this trades accuracy for constant-time answers and is opt-in)
+//   3. The aggregate has no group keys and exactly one item, a non-distinct COUNT over
+//      a constant (COUNT(*) or COUNT(1))
+//   4. The scan has no filter, no limit and no dedup, and covers exactly one tag or
+//      edge type (or none, for whole-space counts)
+//  Benefits:
+//   1. Constant-time counts without touching storage
+//
+//  Transformation:
+//  Before:
+//
+//  +------------------+
+//  |    Aggregate     |
+//  |   (COUNT(*))     |
+//  +--------+---------+
+//           |
+//  +--------+---------+
+//  |     Project      |
+//  +--------+---------+
+//           |
+// +---------+---------+
+// |   ScanVertices    |
+// +-------------------+
+//
+//  After:
+//
+// +-------------------+
+// |  CountFromStats   |
+// +-------------------+
+
+class OptimizeCountFromStatsRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  StatusOr<OptRule::TransformResult> transform(OptContext *ctx,
+                                               const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  OptimizeCountFromStatsRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+
+  static const std::initializer_list<graph::PlanNode::Kind> kScanKinds;
+};
+
+}  // namespace opt
+}  // namespace nebula
+#endif
@@ -0,0 +1,155 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushAggDownIndexScanRule.h"
+
+#include "common/expression/AggregateExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+using nebula::graph::Aggregate;
+using nebula::graph::IndexScan;
+using nebula::graph::PlanNode;
+using nebula::graph::QueryContext;
+
+namespace nebula {
+namespace opt {
+
+/*static*/ const std::initializer_list<graph::PlanNode::Kind>
+    PushAggDownIndexScanRule::kIndexScanKinds{
+        graph::PlanNode::Kind::kIndexScan,
+        graph::PlanNode::Kind::kTagIndexFullScan,
+        graph::PlanNode::Kind::kTagIndexRangeScan,
+        graph::PlanNode::Kind::kTagIndexPrefixScan,
+        graph::PlanNode::Kind::kEdgeIndexFullScan,
+        graph::PlanNode::Kind::kEdgeIndexRangeScan,
+        graph::PlanNode::Kind::kEdgeIndexPrefixScan,
+    };
+
+std::unique_ptr<OptRule> PushAggDownIndexScanRule::kInstance =
+    std::unique_ptr<PushAggDownIndexScanRule>(new PushAggDownIndexScanRule());
+
+PushAggDownIndexScanRule::PushAggDownIndexScanRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushAggDownIndexScanRule::pattern() const {
+  static Pattern pattern =
+      Pattern::create(graph::PlanNode::Kind::kAggregate, {Pattern::create(kIndexScanKinds)});
+  return pattern;
+}
+
+StatusOr<OptRule::TransformResult> PushAggDownIndexScanRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto *qctx = octx->qctx();
+  auto aggGroupNode = matched.node;
+  auto indexScanGroupNode = matched.dependencies.front().node;
+
+  const auto agg = static_cast<const Aggregate *>(aggGroupNode->node());
+  const auto indexScan = indexScanGroupNode->node()->asNode<graph::IndexScan>();
+
+  if (!agg->groupKeys().empty()) {
+    return TransformResult::noTransform();
+  }
+  // A limit pushed into the scan is applied per part, so aggregating behind it in
+  // storage would see a different row set than the global limit would keep
+  if (indexScan->limit(qctx) >= 0) {
+    return TransformResult::noTransform();
+  }
+  const auto &items = agg->groupItems();
+  const auto &colNames = agg->colNames();
+  if (items.empty() || items.size() != colNames.size()) {
+    return TransformResult::noTransform();
+  }
+
+  auto nameRet = indexScan->isEdge()
+                     ? qctx->schemaMng()->toEdgeName(indexScan->space(), indexScan->schemaId())
+                     : qctx->schemaMng()->toTagName(indexScan->space(), indexScan->schemaId());
+  if (!nameRet.ok()) {
+    return TransformResult::noTransform();
+  }
+  const auto &schemaName = nameRet.value();
+
+  auto *pool = qctx->objPool();
+  const auto &returnCols = indexScan->returnColumns();
+  std::vector<storage::cpp2::StatProp> statColumns;
+  statColumns.reserve(items.size());
+  for (size_t i = 0; i < items.size(); i++) {
+    if (items[i]->kind() != Expression::Kind::kAggregate) {
+      return TransformResult::noTransform();
+    }
+    auto *aggExpr = static_cast<AggregateExpression *>(items[i]);
+    if (aggExpr->distinct()) {
+      return TransformResult::noTransform();
+    }
+    auto func = aggExpr->name();
+    std::transform(func.begin(), func.end(), func.begin(), ::toupper);
+    // Only COUNT and SUM merge exactly from per-part partials: both have the identity 0
+    // on empty parts, while storage reports integer sentinels for empty MIN/MAX
+    bool isCount = func == "COUNT";
+    if (!isCount && func != "SUM") {
+      return TransformResult::noTransform();
+    }
+    std::string prop;
+    const auto *arg = aggExpr->arg();
+    if (arg->kind() == Expression::Kind::kConstant) {
+      // COUNT(*), counted over a column every matched row carries
+      if (!isCount) {
+        return TransformResult::noTransform();
+      }
+      prop = indexScan->isEdge() ? kSrc : kVid;
+    } else if (arg->kind() == Expression::Kind::kInputProperty ||
+               arg->kind() == Expression::Kind::kVarProperty) {
+      prop = static_cast<const PropertyExpression *>(arg)->prop();
+      if (std::find(returnCols.begin(), returnCols.end(), prop) == returnCols.end()) {
+        return TransformResult::noTransform();
+      }
+    } else {
+      return TransformResult::noTransform();
+    }
+
+    // The storage layer expects the stat prop as an encoded schema property expression
+    Expression *propExpr = nullptr;
+    if (indexScan->isEdge()) {
+      if (prop == kRank) {
+        propExpr = EdgeRankExpression::make(pool, schemaName);
+      } else {
+        propExpr = EdgePropertyExpression::make(pool, schemaName, prop);
+      }
+    } else {
+      propExpr = TagPropertyExpression::make(pool, schemaName, prop);
+    }
+    storage::cpp2::StatProp statProp;
+    statProp.alias_ref() = colNames[i];
+    statProp.prop_ref() = Expression::encode(*propExpr);
+    statProp.stat_ref() =
+        isCount ? storage::cpp2::StatType::COUNT : storage::cpp2::StatType::SUM;
+    statColumns.emplace_back(std::move(statProp));
+  }
+
+  auto newIndexScan = static_cast<IndexScan *>(indexScan->clone());
+  newIndexScan->setStatColumns(std::move(statColumns));
+  newIndexScan->setOutputVar(agg->outputVar());
+  newIndexScan->setColNames(colNames);
+  auto newIndexScanGroupNode = OptGroupNode::create(octx, newIndexScan, aggGroupNode->group());
+  for (auto dep : indexScanGroupNode->dependencies()) {
+    newIndexScanGroupNode->dependsOn(dep);
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newIndexScanGroupNode);
+  return result;
+}
+
+std::string PushAggDownIndexScanRule::toString() const {
+  return "PushAggDownIndexScanRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
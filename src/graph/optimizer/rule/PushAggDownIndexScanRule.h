@@ -0,0 +1,68 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHAGGDOWNINDEXSCANRULE_H
+#define GRAPH_OPTIMIZER_RULE_PUSHAGGDOWNINDEXSCANRULE_H
+
+#include <initializer_list>
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Push ungrouped COUNT/SUM aggregates down to the storage layer, so each storaged
+//  returns one partial-aggregate row instead of shipping every matched row
+//  Required conditions:
+//   1. Match the pattern
+//   2. The aggregate has no group keys
+//   3. Every aggregate item is a non-distinct COUNT or SUM over a scanned column
+//      (COUNT and SUM merge exactly from partials and have the identity 0 on empty
+//      parts; MIN/MAX are not pushed because storage reports integer sentinels for
+//      empty parts)
+//   4. No limit was pushed into the scan (a per-part limit would aggregate a
+//      different row set than the global one)
+//  Benefits:
+//   1. Only one row per storaged crosses the network
+//
+//  Transformation:
+//  Before:
+//
+//  +------------------+
+//  |    Aggregate     |
+//  |  (COUNT/SUM...)  |
+//  +--------+---------+
+//           |
+// +---------+---------+
+// |     IndexScan     |
+// +-------------------+
+//
+//  After:
+//
+// +-------------------+
+// |     IndexScan     |
+// |   (statColumns)   |
+// +-------------------+
+
+class PushAggDownIndexScanRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  StatusOr<OptRule::TransformResult> transform(OptContext *ctx,
+                                               const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushAggDownIndexScanRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+
+  static const std::initializer_list<graph::PlanNode::Kind> kIndexScanKinds;
+};
+
+}  // namespace opt
+}  // namespace nebula
+#endif
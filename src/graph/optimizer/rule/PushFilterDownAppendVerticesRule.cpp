@@ -0,0 +1,171 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushFilterDownAppendVerticesRule.h"
+
+#include "common/expression/Expression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+#include "graph/util/ExpressionUtils.h"
+#include "graph/visitor/ExtractFilterExprVisitor.h"
+#include "graph/visitor/FindVisitor.h"
+
+using nebula::Expression;
+using nebula::graph::AppendVertices;
+using nebula::graph::Filter;
+using nebula::graph::PlanNode;
+using nebula::graph::QueryContext;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> PushFilterDownAppendVerticesRule::kInstance =
+    std::unique_ptr<PushFilterDownAppendVerticesRule>(new PushFilterDownAppendVerticesRule());
+
+PushFilterDownAppendVerticesRule::PushFilterDownAppendVerticesRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern& PushFilterDownAppendVerticesRule::pattern() const {
+  static Pattern pattern =
+      Pattern::create(PlanNode::Kind::kFilter, {Pattern::create(PlanNode::Kind::kAppendVertices)});
+  return pattern;
+}
+
+bool PushFilterDownAppendVerticesRule::match(OptContext* ctx, const MatchedResult& matched) const {
+  if (!OptRule::match(ctx, matched)) {
+    return false;
+  }
+  DCHECK_EQ(matched.dependencies[0].node->node()->kind(), PlanNode::Kind::kAppendVertices);
+  auto* avNode = static_cast<const AppendVertices*>(matched.dependencies[0].node->node());
+  // When no properties are fetched the executor skips the getProps rpc altogether and a
+  // storage filter would be silently ignored
+  return !avNode->noNeedFetchProp();
+}
+
+namespace {
+
+// Whether the expression is a tag property of the destination vertex, i.e. `v.player.age`
+// where v is the node alias appended by the AppendVertices
+bool isDstVertexTagProp(const std::string& nodeAlias, const Expression* e) {
+  if (e->kind() != Expression::Kind::kLabelTagProperty) {
+    return false;
+  }
+  auto* label = static_cast<const LabelTagPropertyExpression*>(e)->label();
+  if (label->kind() != Expression::Kind::kInputProperty &&
+      label->kind() != Expression::Kind::kVarProperty) {
+    return false;
+  }
+  return static_cast<const PropertyExpression*>(label)->prop() == nodeAlias;
+}
+
+}  // namespace
+
+StatusOr<OptRule::TransformResult> PushFilterDownAppendVerticesRule::transform(
+    OptContext* octx, const MatchedResult& matched) const {
+  auto* filterGNode = matched.node;
+  auto* filterGroup = filterGNode->group();
+  auto* filter = static_cast<Filter*>(filterGNode->node());
+  auto* condition = filter->condition();
+
+  auto* avGNode = matched.dependencies[0].node;
+  auto* avNode = static_cast<AppendVertices*>(avGNode->node());
+  auto nodeAlias = avNode->nodeAlias();
+
+  auto qctx = octx->qctx();
+  auto pool = qctx->objPool();
+
+  // Pick the conjuncts which reference the destination vertex's tag properties and nothing
+  // the storage side cannot resolve
+  auto picker = [&nodeAlias, avNode, qctx, pool](const Expression* expr) -> bool {
+    bool shouldNotPick = false;
+    auto finder = [&shouldNotPick, &nodeAlias](const Expression* e) -> bool {
+      // Stop descending on a destination tag property, its label child is resolved away by
+      // the rewrite below
+      if (isDstVertexTagProp(nodeAlias, e)) return true;
+      // References to other columns, the vertex value itself or exists() cannot be answered
+      // by the getProps request
+      if (e->kind() == Expression::Kind::kInputProperty ||
+          e->kind() == Expression::Kind::kVarProperty || e->kind() == Expression::Kind::kVar) {
+        shouldNotPick = true;
+        return false;
+      }
+      if (e->kind() == Expression::Kind::kPredicate &&
+          static_cast<const PredicateExpression*>(e)->name() == "exists") {
+        shouldNotPick = true;
+        return false;
+      }
+      return false;
+    };
+    graph::FindVisitor visitor(finder, true, true);
+    const_cast<Expression*>(expr)->accept(&visitor);
+    if (shouldNotPick || visitor.results().empty()) {
+      return false;
+    }
+    // Only push conjuncts storage can evaluate as a whole, the remainder would be in tag
+    // property form which graphd cannot evaluate above the AppendVertices
+    auto* rewritten = graph::ExpressionUtils::rewriteVertexPropertyFilter(
+        pool, nodeAlias, const_cast<Expression*>(expr)->clone());
+    auto extractVisitor = graph::ExtractFilterExprVisitor::makePushGetVertices(
+        pool, avNode->space(), qctx->schemaMng());
+    rewritten->accept(&extractVisitor);
+    return extractVisitor.ok() && extractVisitor.remainedExpr() == nullptr;
+  };
+  Expression* filterPicked = nullptr;
+  Expression* filterUnpicked = nullptr;
+  graph::ExpressionUtils::splitFilter(condition, picker, &filterPicked, &filterUnpicked);
+
+  if (!filterPicked) {
+    return TransformResult::noTransform();
+  }
+  auto* storageFilter =
+      graph::ExpressionUtils::rewriteVertexPropertyFilter(pool, nodeAlias, filterPicked->clone());
+  auto* oldFilter = avNode->filter();
+  Expression* newStorageFilter =
+      oldFilter ? LogicalExpression::makeAnd(pool, storageFilter, oldFilter->clone())
+                : storageFilter;
+
+  // produce new AppendVertices node
+  auto* newAvNode = static_cast<AppendVertices*>(avNode->clone());
+  newAvNode->setFilter(newStorageFilter);
+  newAvNode->setInputVar(avNode->inputVar());
+  newAvNode->setColNames(avNode->outputVarPtr()->colNames);
+
+  // connect the optimized plan
+  TransformResult result;
+  result.eraseAll = true;
+  if (filterUnpicked) {
+    auto* newFilterNode = Filter::make(qctx, newAvNode, filterUnpicked);
+    newFilterNode->setOutputVar(filter->outputVar());
+    newFilterNode->setColNames(filter->colNames());
+    auto newFilterGNode = OptGroupNode::create(octx, newFilterNode, filterGroup);
+    // assemble the new AppendVertices group below Filter
+    auto newAvGroup = OptGroup::create(octx);
+    auto newAvGNode = newAvGroup->makeGroupNode(newAvNode);
+    newAvGNode->setDeps(avGNode->dependencies());
+    newFilterGNode->setDeps({newAvGroup});
+    newFilterNode->setInputVar(newAvNode->outputVar());
+    result.newGroupNodes.emplace_back(newFilterGNode);
+  } else {
+    // replace the new AppendVertices node with the old Filter group
+    auto newAvGNode = OptGroupNode::create(octx, newAvNode, filterGroup);
+    newAvNode->setOutputVar(filter->outputVar());
+    newAvGNode->setDeps(avGNode->dependencies());
+    result.newGroupNodes.emplace_back(newAvGNode);
+  }
+
+  return result;
+}
+
+std::string PushFilterDownAppendVerticesRule::toString() const {
+  return "PushFilterDownAppendVerticesRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
@@ -0,0 +1,45 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#pragma once
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+/*
+ * Push the conjuncts of a WHERE that only touch the destination vertex's tag properties into
+ * the storage-side filter of AppendVertices, so the non-matching vertices are dropped by
+ * storaged instead of being transferred and filtered in graphd.
+ *
+ * Before:
+ * Filter(v2.player.age > 18 AND v2.player.name == $-.name)
+ *        |
+ *   AppendVertices(v2)
+ *
+ * After :
+ * Filter(v2.player.name == $-.name)
+ *        |
+ *   AppendVertices(v2, filter_: player.age > 18)
+ */
+class PushFilterDownAppendVerticesRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  bool match(OptContext *ctx, const MatchedResult &matched) const override;
+
+  StatusOr<TransformResult> transform(OptContext *ctx, const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushFilterDownAppendVerticesRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
@@ -0,0 +1,97 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushLimitDownUnionRule.h"
+
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+using nebula::graph::Limit;
+using nebula::graph::PlanNode;
+using nebula::graph::QueryContext;
+using nebula::graph::Union;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> PushLimitDownUnionRule::kInstance =
+    std::unique_ptr<PushLimitDownUnionRule>(new PushLimitDownUnionRule());
+
+PushLimitDownUnionRule::PushLimitDownUnionRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushLimitDownUnionRule::pattern() const {
+  static Pattern pattern = Pattern::create(graph::PlanNode::Kind::kLimit,
+                                           {Pattern::create(graph::PlanNode::Kind::kUnion)});
+  return pattern;
+}
+
+StatusOr<OptRule::TransformResult> PushLimitDownUnionRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto *qctx = octx->qctx();
+  auto limitGroupNode = matched.node;
+  auto unionGroupNode = matched.dependencies.front().node;
+
+  const auto limit = static_cast<const Limit *>(limitGroupNode->node());
+  const auto uni = static_cast<const Union *>(unionGroupNode->node());
+
+  if (limit->count(qctx) < 0) {
+    return TransformResult::noTransform();
+  }
+  int64_t limitRows = limit->offset() + limit->count(qctx);
+
+  // If a branch already ends in a limit, this rule (or an explicit one in the query)
+  // has been applied; don't stack another
+  const auto &branchGroups = unionGroupNode->dependencies();
+  for (auto *branchGroup : branchGroups) {
+    for (auto *groupNode : branchGroup->groupNodes()) {
+      if (groupNode->node()->kind() == PlanNode::Kind::kLimit) {
+        return TransformResult::noTransform();
+      }
+    }
+  }
+
+  auto newLimit = static_cast<Limit *>(limit->clone());
+  newLimit->setOutputVar(limit->outputVar());
+  auto newLimitGroupNode = OptGroupNode::create(octx, newLimit, limitGroupNode->group());
+
+  auto newUnion = static_cast<Union *>(uni->clone());
+  auto newUnionGroup = OptGroup::create(octx);
+  auto newUnionGroupNode = newUnionGroup->makeGroupNode(newUnion);
+  newLimitGroupNode->dependsOn(newUnionGroup);
+  newLimit->setInputVar(newUnion->outputVar());
+
+  // Each branch only ever needs offset + count rows, whichever branch they end up
+  // coming from
+  for (size_t i = 0; i < branchGroups.size(); i++) {
+    auto *branchLimit = Limit::make(qctx, nullptr, 0, limitRows);
+    branchLimit->setInputVar(i == 0 ? uni->leftInputVar() : uni->rightInputVar());
+    branchLimit->setColNames(uni->colNames());
+    auto branchGroup = OptGroup::create(octx);
+    auto branchGroupNode = branchGroup->makeGroupNode(branchLimit);
+    branchGroupNode->dependsOn(branchGroups[i]);
+    newUnionGroupNode->dependsOn(branchGroup);
+    if (i == 0) {
+      newUnion->setLeftVar(branchLimit->outputVar());
+    } else {
+      newUnion->setRightVar(branchLimit->outputVar());
+    }
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newLimitGroupNode);
+  return result;
+}
+
+std::string PushLimitDownUnionRule::toString() const {
+  return "PushLimitDownUnionRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
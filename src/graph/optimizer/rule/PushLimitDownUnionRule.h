@@ -0,0 +1,78 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHLIMITDOWNUNIONRULE_H
+#define GRAPH_OPTIMIZER_RULE_PUSHLIMITDOWNUNIONRULE_H
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Push a limit above a UNION ALL into both branches, so each branch stops producing
+//  rows once it alone could satisfy the limit, and the per-branch limits keep sinking
+//  toward storage through the other limit pushdown rules. The outer limit stays to cap
+//  the combined result. Not applicable to INTERSECT or MINUS, which need the full
+//  branches to decide membership, nor to UNION (distinct), whose Dedup sits between the
+//  limit and the Union node and breaks the pattern.
+//  Required conditions:
+//   1. Match the pattern
+//  Benefits:
+//   1. Terminate union branches early once the limit is satisfiable
+//
+//  Transformation:
+//  Before:
+//
+//  +--------+--------+
+//  |      Limit      |
+//  |    (limit=3)    |
+//  +--------+--------+
+//           |
+//  +--------+--------+
+//  |      Union      |
+//  +--------+--------+
+//       |        |
+//    +--+--+  +--+--+
+//    | ... |  | ... |
+//    +-----+  +-----+
+//
+//  After:
+//
+//  +--------+--------+
+//  |      Limit      |
+//  |    (limit=3)    |
+//  +--------+--------+
+//           |
+//  +--------+--------+
+//  |      Union      |
+//  +--------+--------+
+//       |        |
+//  +----+----+ +---+-----+
+//  |  Limit  | |  Limit  |
+//  |(limit=3)| |(limit=3)|
+//  +----+----+ +---+-----+
+//       |        |
+//    +--+--+  +--+--+
+//    | ... |  | ... |
+//    +-----+  +-----+
+
+class PushLimitDownUnionRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  StatusOr<OptRule::TransformResult> transform(OptContext *ctx,
+                                               const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushLimitDownUnionRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+#endif
@@ -0,0 +1,108 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/optimizer/rule/PushTopNDownTraverseRule.h"
+
+#include "graph/optimizer/OptContext.h"
+#include "graph/optimizer/OptGroup.h"
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/Query.h"
+
+using nebula::graph::PlanNode;
+using nebula::graph::Project;
+using nebula::graph::QueryContext;
+using nebula::graph::TopN;
+using nebula::graph::Traverse;
+
+namespace nebula {
+namespace opt {
+
+std::unique_ptr<OptRule> PushTopNDownTraverseRule::kInstance =
+    std::unique_ptr<PushTopNDownTraverseRule>(new PushTopNDownTraverseRule());
+
+PushTopNDownTraverseRule::PushTopNDownTraverseRule() {
+  RuleSet::QueryRules().addRule(this);
+}
+
+const Pattern &PushTopNDownTraverseRule::pattern() const {
+  static Pattern pattern = Pattern::create(
+      graph::PlanNode::Kind::kTopN,
+      {Pattern::create(graph::PlanNode::Kind::kProject,
+                       {Pattern::create(graph::PlanNode::Kind::kTraverse)})});
+  return pattern;
+}
+
+StatusOr<OptRule::TransformResult> PushTopNDownTraverseRule::transform(
+    OptContext *octx, const MatchedResult &matched) const {
+  auto topNGroupNode = matched.node;
+  auto projectGroupNode = matched.dependencies.front().node;
+  auto traverseGroupNode = matched.dependencies.front().dependencies.front().node;
+
+  const auto topN = static_cast<const TopN *>(topNGroupNode->node());
+  const auto project = static_cast<const Project *>(projectGroupNode->node());
+  const auto traverse = static_cast<const Traverse *>(traverseGroupNode->node());
+
+  if (traverse->topNLimit() >= 0) {
+    return TransformResult::noTransform();
+  }
+  int64_t limitRows = topN->offset() + topN->count();
+  if (limitRows <= 0) {
+    return TransformResult::noTransform();
+  }
+
+  // Every factor column has to be a plain reference to a Traverse output column, otherwise
+  // the order seen by the Traverse would differ from the order required by the TopN
+  const auto &traverseColNames = traverse->colNames();
+  const auto &yieldColumns = project->columns()->columns();
+  std::vector<std::pair<size_t, OrderFactor::OrderType>> factors;
+  factors.reserve(topN->factors().size());
+  for (auto &factor : topN->factors()) {
+    DCHECK_LT(factor.first, yieldColumns.size());
+    auto *expr = yieldColumns[factor.first]->expr();
+    if (expr->kind() != Expression::Kind::kInputProperty &&
+        expr->kind() != Expression::Kind::kVarProperty) {
+      return TransformResult::noTransform();
+    }
+    const auto &propName = static_cast<const PropertyExpression *>(expr)->prop();
+    auto found = std::find(traverseColNames.begin(), traverseColNames.end(), propName);
+    if (found == traverseColNames.end()) {
+      return TransformResult::noTransform();
+    }
+    factors.emplace_back(std::distance(traverseColNames.begin(), found), factor.second);
+  }
+
+  auto newTopN = static_cast<TopN *>(topN->clone());
+  newTopN->setOutputVar(topN->outputVar());
+  auto newTopNGroupNode = OptGroupNode::create(octx, newTopN, topNGroupNode->group());
+
+  auto newProject = static_cast<Project *>(project->clone());
+  auto newProjectGroup = OptGroup::create(octx);
+  auto newProjectGroupNode = newProjectGroup->makeGroupNode(newProject);
+
+  auto newTraverse = static_cast<Traverse *>(traverse->clone());
+  newTraverse->setTopN(std::move(factors), limitRows);
+  auto newTraverseGroup = OptGroup::create(octx);
+  auto newTraverseGroupNode = newTraverseGroup->makeGroupNode(newTraverse);
+
+  newTopNGroupNode->dependsOn(newProjectGroup);
+  newTopN->setInputVar(newProject->outputVar());
+  newProjectGroupNode->dependsOn(newTraverseGroup);
+  newProject->setInputVar(newTraverse->outputVar());
+  for (auto dep : traverseGroupNode->dependencies()) {
+    newTraverseGroupNode->dependsOn(dep);
+  }
+
+  TransformResult result;
+  result.eraseAll = true;
+  result.newGroupNodes.emplace_back(newTopNGroupNode);
+  return result;
+}
+
+std::string PushTopNDownTraverseRule::toString() const {
+  return "PushTopNDownTraverseRule";
+}
+
+}  // namespace opt
+}  // namespace nebula
@@ -0,0 +1,73 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNTRAVERSERULE_H
+#define GRAPH_OPTIMIZER_RULE_PUSHTOPNDOWNTRAVERSERULE_H
+
+#include "graph/optimizer/OptRule.h"
+
+namespace nebula {
+namespace opt {
+
+//  Embedding the TopN bound into the Traverse node so that the executor only keeps the
+//  current best offset+count rows while building paths, instead of materializing the
+//  whole expansion and sorting it afterwards
+//  Required conditions:
+//   1. Match the pattern
+//   2. Every TopN factor column of the Project is a plain column reference that resolves
+//      to an output column of the Traverse
+//  Benefits:
+//   1. Limit data early to optimize performance
+//
+//  Transformation:
+//  Before:
+//
+//  +----------+----------+
+//  |        TopN         |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |       Project       |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |      Traverse       |
+//  +----------+----------+
+//
+//  After:
+//
+//  +----------+----------+
+//  |        TopN         |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |       Project       |
+//  +----------+----------+
+//             |
+//  +----------+----------+
+//  |      Traverse       |
+//  |  (topNFactors_=...) |
+//  | (topNLimit_=offset+ |
+//  |        count)       |
+//  +----------+----------+
+
+class PushTopNDownTraverseRule final : public OptRule {
+ public:
+  const Pattern &pattern() const override;
+
+  StatusOr<OptRule::TransformResult> transform(OptContext *ctx,
+                                               const MatchedResult &matched) const override;
+
+  std::string toString() const override;
+
+ private:
+  PushTopNDownTraverseRule();
+
+  static std::unique_ptr<OptRule> kInstance;
+};
+
+}  // namespace opt
+}  // namespace nebula
+#endif
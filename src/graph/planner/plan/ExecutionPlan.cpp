@@ -78,6 +78,7 @@ void ExecutionPlan::setPlanNodeDeps(const PlanNode* node, PlanNodeDescription* p
 void ExecutionPlan::describe(PlanDescription* planDesc) {
   planDescription_ = DCHECK_NOTNULL(planDesc);
   planDescription_->optimize_time_in_us = optimizeTimeInUs_;
+  planDescription_->validate_time_in_us = validateTimeInUs_;
   planDescription_->format = explainFormat_;
   makePlanNodeDesc(root_);
 }
@@ -49,6 +49,10 @@ class ExecutionPlan final {
     return &optimizeTimeInUs_;
   }
 
+  int32_t* validateTimeInUs() {
+    return &validateTimeInUs_;
+  }
+
   void addProfileStats(int64_t planNodeId, ProfilingStats&& profilingStats);
 
   void describe(PlanDescription* planDesc);
@@ -67,6 +71,7 @@ class ExecutionPlan final {
   void setPlanNodeDeps(const PlanNode* dep, PlanNodeDescription* planNodeDesc) const;
 
   int32_t optimizeTimeInUs_{0};
+  int32_t validateTimeInUs_{0};
   int64_t id_{-1};
   PlanNode* root_{nullptr};
   // plan description for explain and profile query
@@ -51,7 +51,7 @@ std::unique_ptr<PlanNodeDescription> Update::explain() const {
 
 std::unique_ptr<PlanNodeDescription> UpdateVertex::explain() const {
   auto desc = Update::explain();
-  addDescription("vid", vId_.toString(), desc.get());
+  addDescription("vid", folly::toJson(util::toJson(vIds_)), desc.get());
   addDescription("tagId", folly::to<std::string>(tagId_), desc.get());
   return desc;
 }
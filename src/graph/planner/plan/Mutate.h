@@ -221,7 +221,7 @@ class UpdateVertex final : public Update {
                             PlanNode* input,
                             GraphSpaceID spaceId,
                             std::string name,
-                            Value vId,
+                            std::vector<Value> vIds,
                             TagID tagId,
                             bool insertable,
                             std::vector<storage::cpp2::UpdatedProp> updatedProps,
@@ -232,7 +232,7 @@ class UpdateVertex final : public Update {
                                                      input,
                                                      spaceId,
                                                      std::move(name),
-                                                     std::move(vId),
+                                                     std::move(vIds),
                                                      tagId,
                                                      insertable,
                                                      std::move(updatedProps),
@@ -243,8 +243,8 @@ class UpdateVertex final : public Update {
 
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
-  const Value& getVId() const {
-    return vId_;
+  const std::vector<Value>& getVIds() const {
+    return vIds_;
   }
 
   TagID getTagId() const {
@@ -257,7 +257,7 @@ class UpdateVertex final : public Update {
                PlanNode* input,
                GraphSpaceID spaceId,
                std::string name,
-               Value vId,
+               std::vector<Value> vIds,
                TagID tagId,
                bool insertable,
                std::vector<storage::cpp2::UpdatedProp> updatedProps,
@@ -274,11 +274,11 @@ class UpdateVertex final : public Update {
                std::move(returnProps),
                std::move(condition),
                std::move(yieldNames)),
-        vId_(std::move(vId)),
+        vIds_(std::move(vIds)),
         tagId_(tagId) {}
 
  private:
-  Value vId_;
+  std::vector<Value> vIds_;
   TagID tagId_{-1};
 };
 
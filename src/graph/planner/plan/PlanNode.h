@@ -47,6 +47,8 @@ class PlanNode {
     kFulltextIndexScan,
     // direct value
     kValue,
+    // single-row count answered from the meta stats
+    kCountFromStats,
 
     // ------------------
     kFilter,
@@ -206,6 +208,13 @@ class PlanNode {
 
   virtual void calcCost();
 
+  // Physical property: the output column names the rows are sorted by, ascending, most
+  // significant first. Empty when no order is guaranteed. Lets executors pick merge-based
+  // algorithms over hash-based ones.
+  virtual std::vector<std::string> sortedBy() const {
+    return {};
+  }
+
   Kind kind() const {
     return kind_;
   }
@@ -294,6 +303,21 @@ class PlanNode {
     return cost_;
   }
 
+  void setCost(double cost) {
+    cost_ = cost;
+  }
+
+  // Scheduling hint set right before execution: how many worker jobs the executor of this node
+  // may fan out at most, so plan branches that run concurrently share the runner pool instead
+  // of each taking the full FLAGS_max_job_size for itself. 0 means no extra cap.
+  size_t jobLimit() const {
+    return jobLimit_;
+  }
+
+  void setJobLimit(size_t limit) {
+    jobLimit_ = limit;
+  }
+
   void setLoopLayers(std::size_t c) {
     loopLayers_ = c;
   }
@@ -331,6 +355,8 @@ class PlanNode {
   Kind kind_{Kind::kUnknown};
   int64_t id_{-1};
   double cost_{0.0};
+  // Cap on the worker jobs of this node's executor, 0 when unconstrained
+  size_t jobLimit_{0};
   std::vector<const PlanNode*> dependencies_;
   std::vector<Variable*> inputVars_;
   Variable* outputVar_;
@@ -270,6 +270,9 @@ std::unique_ptr<PlanNodeDescription> IndexScan::explain() const {
   addDescription("isEdge", folly::toJson(util::toJson(isEdge_)), desc.get());
   addDescription("returnCols", folly::toJson(util::toJson(returnCols_)), desc.get());
   addDescription("indexCtx", folly::toJson(util::toJson(contexts_)), desc.get());
+  if (!statColumns_.empty()) {
+    addDescription("statColumns", folly::toJson(util::toJson(statColumns_)), desc.get());
+  }
   return desc;
 }
 
@@ -287,6 +290,7 @@ void IndexScan::cloneMembers(const IndexScan& g) {
   isEdge_ = g.isEdge();
   schemaId_ = g.schemaId();
   yieldColumns_ = g.yieldColumns();
+  statColumns_ = g.statColumns();
 }
 
 std::unique_ptr<PlanNodeDescription> ScanVertices::explain() const {
@@ -351,6 +355,24 @@ void ScanEdges::cloneMembers(const ScanEdges& ge) {
   }
 }
 
+std::unique_ptr<PlanNodeDescription> CountFromStats::explain() const {
+  auto desc = SingleInputNode::explain();
+  addDescription("space", folly::to<std::string>(space_), desc.get());
+  addDescription("schemaName", schemaName_.empty() ? "*" : schemaName_, desc.get());
+  addDescription("isEdge", folly::toJson(util::toJson(isEdge_)), desc.get());
+  return desc;
+}
+
+PlanNode* CountFromStats::clone() const {
+  auto* newCount = CountFromStats::make(qctx_, nullptr, space_, schemaName_, isEdge_);
+  newCount->cloneMembers(*this);
+  return newCount;
+}
+
+void CountFromStats::cloneMembers(const CountFromStats& c) {
+  SingleInputNode::cloneMembers(c);
+}
+
 Filter::Filter(QueryContext* qctx, PlanNode* input, Expression* condition, bool needStableFilter)
     : SingleInputNode(qctx, Kind::kFilter, input) {
   condition_ = condition;
@@ -842,6 +864,8 @@ void Traverse::cloneMembers(const Traverse& g) {
     setTagFilter(g.tagFilter_->clone());
   }
   genPath_ = g.genPath();
+  topNFactors_ = g.topNFactors_;
+  topNLimit_ = g.topNLimit_;
 }
 
 std::unique_ptr<PlanNodeDescription> Traverse::explain() const {
@@ -854,6 +878,7 @@ std::unique_ptr<PlanNodeDescription> Traverse::explain() const {
                  firstStepFilter_ != nullptr ? firstStepFilter_->toString() : "",
                  desc.get());
   addDescription("tag filter", tagFilter_ != nullptr ? tagFilter_->toString() : "", desc.get());
+  addDescription("topN", folly::to<std::string>(topNLimit_), desc.get());
   return desc;
 }
 
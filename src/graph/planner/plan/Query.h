@@ -719,6 +719,16 @@ class IndexScan : public Explore {
     return lazyIndexHint_;
   }
 
+  const std::vector<storage::cpp2::StatProp>& statColumns() const {
+    return statColumns_;
+  }
+
+  // Aggregates pushed down to storage. When set, the scan outputs one row of merged
+  // aggregates instead of the matched rows, so only partials cross the network.
+  void setStatColumns(std::vector<storage::cpp2::StatProp> statColumns) {
+    statColumns_ = std::move(statColumns);
+  }
+
   PlanNode* clone() const override;
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
@@ -753,6 +763,7 @@ class IndexScan : public Explore {
 
   YieldColumns* yieldColumns_;
   bool lazyIndexHint_{false};
+  std::vector<storage::cpp2::StatProp> statColumns_;
 };
 
 class FulltextIndexScan : public Explore {
@@ -943,6 +954,54 @@ class ScanEdges final : public Explore {
   std::unique_ptr<std::vector<Expr>> exprs_;
 };
 
+// Answer an ungrouped COUNT over a whole tag, edge type or space from the stats the meta
+// service keeps, instead of scanning the data. Only planned when
+// FLAGS_enable_count_from_stats is on, since the stats are only as fresh as the last
+// stats job.
+class CountFromStats final : public SingleInputNode {
+ public:
+  static CountFromStats* make(QueryContext* qctx,
+                              PlanNode* input,
+                              GraphSpaceID space,
+                              std::string schemaName,
+                              bool isEdge) {
+    return qctx->objPool()->makeAndAdd<CountFromStats>(
+        qctx, input, space, std::move(schemaName), isEdge);
+  }
+
+  GraphSpaceID space() const {
+    return space_;
+  }
+
+  const std::string& schemaName() const {
+    return schemaName_;
+  }
+
+  bool isEdge() const {
+    return isEdge_;
+  }
+
+  PlanNode* clone() const override;
+  std::unique_ptr<PlanNodeDescription> explain() const override;
+
+ private:
+  friend ObjectPool;
+  CountFromStats(
+      QueryContext* qctx, PlanNode* input, GraphSpaceID space, std::string schemaName, bool isEdge)
+      : SingleInputNode(qctx, Kind::kCountFromStats, input),
+        space_(space),
+        schemaName_(std::move(schemaName)),
+        isEdge_(isEdge) {}
+
+  void cloneMembers(const CountFromStats&);
+
+ private:
+  GraphSpaceID space_{-1};
+  // The tag or edge type to count, empty for the whole space
+  std::string schemaName_;
+  bool isEdge_{false};
+};
+
 // A Filter node helps filt some records with condition.
 class Filter final : public SingleInputNode {
  public:
@@ -1131,6 +1190,18 @@ class Sort final : public SingleInputNode {
     return factors_;
   }
 
+  std::vector<std::string> sortedBy() const override {
+    std::vector<std::string> cols;
+    auto& names = colNames();
+    for (auto& factor : factors_) {
+      if (factor.second != OrderFactor::OrderType::ASCEND || factor.first >= names.size()) {
+        return {};
+      }
+      cols.emplace_back(names[factor.first]);
+    }
+    return cols;
+  }
+
   PlanNode* clone() const override;
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
@@ -1198,6 +1269,11 @@ class Limit final : public SingleInputNode {
     return count_;
   }
 
+  // A limit emits a prefix of its input, so it preserves whatever order the input has
+  std::vector<std::string> sortedBy() const override {
+    return dep() == nullptr ? std::vector<std::string>() : dep()->sortedBy();
+  }
+
   PlanNode* clone() const override;
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
@@ -1245,6 +1321,18 @@ class TopN final : public SingleInputNode {
     return count_;
   }
 
+  std::vector<std::string> sortedBy() const override {
+    std::vector<std::string> cols;
+    auto& names = colNames();
+    for (auto& factor : factors_) {
+      if (factor.second != OrderFactor::OrderType::ASCEND || factor.first >= names.size()) {
+        return {};
+      }
+      cols.emplace_back(names[factor.first]);
+    }
+    return cols;
+  }
+
   PlanNode* clone() const override;
   std::unique_ptr<PlanNodeDescription> explain() const override;
 
@@ -1766,6 +1854,21 @@ class Traverse final : public GetNeighbors {
     tagFilter_ = tagFilter;
   }
 
+  const std::vector<std::pair<size_t, OrderFactor::OrderType>>& topNFactors() const {
+    return topNFactors_;
+  }
+
+  int64_t topNLimit() const {
+    return topNLimit_;
+  }
+
+  // Bound pushed down from a TopN above this node, the factor indices are relative to this
+  // node's output columns
+  void setTopN(std::vector<std::pair<size_t, OrderFactor::OrderType>> factors, int64_t limit) {
+    topNFactors_ = std::move(factors);
+    topNLimit_ = limit;
+  }
+
  private:
   friend ObjectPool;
   Traverse(QueryContext* qctx, PlanNode* input, GraphSpaceID space)
@@ -1784,6 +1887,10 @@ class Traverse final : public GetNeighbors {
   Expression* firstStepFilter_{nullptr};
   Expression* tagFilter_{nullptr};
   bool genPath_{false};
+  // Keep only the best `topNLimit_` rows ordered by `topNFactors_` while building the result,
+  // -1 means no bound
+  std::vector<std::pair<size_t, OrderFactor::OrderType>> topNFactors_;
+  int64_t topNLimit_{-1};
 };
 
 // Append vertices to a path.
@@ -5,7 +5,12 @@
 
 #include "graph/scheduler/AsyncMsgNotifyBasedScheduler.h"
 
+#include "common/base/SampledCheck.h"
+#include "graph/util/PerfCounters.h"
+
 DECLARE_bool(enable_lifetime_optimize);
+DECLARE_int64(query_memory_quota_mb);
+DECLARE_int64(session_memory_quota_mb);
 
 namespace nebula {
 namespace graph {
@@ -36,6 +41,7 @@ folly::Future<Status> AsyncMsgNotifyBasedScheduler::schedule() {
                                           std::memory_order_relaxed);
     analyzeLifetime(root);
   }
+  analyzeParallelism(root);
   auto executor = Executor::create(root, qctx_);
   DLOG(INFO) << formatPrettyDependencyTree(executor);
   return doSchedule(executor);
@@ -267,6 +273,12 @@ folly::Future<Status> AsyncMsgNotifyBasedScheduler::runExecute(Executor* executo
     folly::Future<Status> status = Status::OK();
     {
       memory::MemoryCheckGuard guard;
+      // Charge this executor's allocations against the query and the session quotas
+      memory::MemoryScopeGuard scope(
+          {qctx_->memoryUsed(), FLAGS_query_memory_quota_mb * memory::MiB},
+          {qctx_->rctx()->session()->memoryUsed(), FLAGS_session_memory_quota_mb * memory::MiB});
+      PerfCounterScope perfScope(executor);
+      SampledCheck::Scope verifyScope(qctx_->verifyChecks());
       status = executor->execute();
     }
     return std::move(status).thenError(folly::tag_t<std::bad_alloc>{}, [](const std::bad_alloc&) {
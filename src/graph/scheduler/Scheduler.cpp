@@ -18,9 +18,88 @@
 #include "graph/planner/plan/PlanNode.h"
 #include "graph/planner/plan/Query.h"
 
+DEFINE_bool(enable_parallelism_budget,
+            false,
+            "Divide max_job_size between plan branches that run concurrently, weighted by the "
+            "optimizer's cost estimates, instead of letting every branch fan out to the full "
+            "job size");
+DECLARE_int32(max_job_size);
+
 namespace nebula {
 namespace graph {
 
+namespace {
+
+// Sum of the optimizer's cost estimates over the subtree, used to weight the budget split
+// between sibling branches; stays 0 when the cost model did not annotate the plan
+double subtreeCost(const PlanNode* node, std::unordered_map<const PlanNode*, double>& memo) {
+  auto found = memo.find(node);
+  if (found != memo.end()) {
+    return found->second;
+  }
+  double total = node->cost() > 0.0 ? node->cost() : 0.0;
+  for (auto* dep : node->dependencies()) {
+    total += subtreeCost(dep, memo);
+  }
+  memo[node] = total;
+  return total;
+}
+
+void distributeBudget(const PlanNode* node,
+                      size_t budget,
+                      std::unordered_map<const PlanNode*, double>& costMemo,
+                      std::unordered_map<const PlanNode*, size_t>& assigned) {
+  // A node shared by several branches serves all of them, so keep the largest budget it is
+  // reached with
+  auto found = assigned.find(node);
+  if (found != assigned.end() && found->second >= budget) {
+    return;
+  }
+  assigned[node] = budget;
+  const_cast<PlanNode*>(node)->setJobLimit(budget);
+
+  const auto& deps = node->dependencies();
+  if (deps.size() <= 1) {
+    for (auto* dep : deps) {
+      distributeBudget(dep, budget, costMemo, assigned);
+    }
+  } else {
+    // The scheduler triggers all dependencies at once, so they share this node's budget, each
+    // branch in proportion to its estimated cost when the cost model annotated the plan and
+    // evenly otherwise, with at least one job per branch
+    double totalCost = 0.0;
+    for (auto* dep : deps) {
+      totalCost += subtreeCost(dep, costMemo);
+    }
+    for (auto* dep : deps) {
+      size_t share = totalCost > 0.0
+                         ? static_cast<size_t>(budget * (subtreeCost(dep, costMemo) / totalCost))
+                         : budget / deps.size();
+      distributeBudget(dep, std::max<size_t>(share, 1), costMemo, assigned);
+    }
+  }
+
+  // The bodies of Select/Loop are scheduled while no sibling of this node runs, so they get
+  // the node's full budget rather than a share of it
+  switch (node->kind()) {
+    case PlanNode::Kind::kSelect: {
+      auto sel = static_cast<const Select*>(node);
+      distributeBudget(sel->then(), budget, costMemo, assigned);
+      distributeBudget(sel->otherwise(), budget, costMemo, assigned);
+      break;
+    }
+    case PlanNode::Kind::kLoop: {
+      auto loop = static_cast<const Loop*>(node);
+      distributeBudget(loop->body(), budget, costMemo, assigned);
+      break;
+    }
+    default:
+      break;
+  }
+}
+
+}  // namespace
+
 /*static*/ void Scheduler::analyzeLifetime(const PlanNode* root, std::size_t loopLayers) {
   std::stack<std::tuple<const PlanNode*, std::size_t>> stack;
   std::unordered_set<const PlanNode*> visited;
@@ -69,5 +148,14 @@ namespace graph {
   }
 }
 
+/*static*/ void Scheduler::analyzeParallelism(const PlanNode* root) {
+  if (!FLAGS_enable_parallelism_budget || FLAGS_max_job_size <= 1) {
+    return;
+  }
+  std::unordered_map<const PlanNode*, double> costMemo;
+  std::unordered_map<const PlanNode*, size_t> assigned;
+  distributeBudget(root, static_cast<size_t>(FLAGS_max_job_size), costMemo, assigned);
+}
+
 }  // namespace graph
 }  // namespace nebula
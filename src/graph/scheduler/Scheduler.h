@@ -26,6 +26,13 @@ class Scheduler : private boost::noncopyable, private cpp::NonMovable {
 
   static void analyzeLifetime(const PlanNode *node, std::size_t loopLayers = 0);
 
+  // Divide the FLAGS_max_job_size worker budget over the plan before execution: branches the
+  // scheduler will trigger concurrently share the budget of the node joining them, weighted by
+  // the optimizer's cost estimates when present, so two heavy branches cannot each fan out to
+  // the full job size and oversubscribe the runner pool. The per-node result is stored as
+  // PlanNode::jobLimit() and picked up by Executor::getBatchSize().
+  static void analyzeParallelism(const PlanNode *root);
+
  protected:
   // use by debugger to check query which crash in runtime
   std::string query_;
@@ -0,0 +1,215 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/scheduler/WorkStealingScheduler.h"
+
+#include "common/base/SampledCheck.h"
+#include "common/memory/MemoryTracker.h"
+#include "graph/util/PerfCounters.h"
+
+DEFINE_bool(enable_work_stealing_scheduler,
+            false,
+            "Schedule the executors of a query as a dependency-counted task DAG dispatched to "
+            "the runner pool, instead of one future chain with message notifications per plan "
+            "node");
+DECLARE_bool(enable_lifetime_optimize);
+DECLARE_int64(query_memory_quota_mb);
+DECLARE_int64(session_memory_quota_mb);
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+bool hasControlFlow(const PlanNode* node, std::unordered_set<const PlanNode*>& visited) {
+  if (!visited.emplace(node).second) {
+    return false;
+  }
+  auto kind = node->kind();
+  if (kind == PlanNode::Kind::kLoop || kind == PlanNode::Kind::kSelect ||
+      kind == PlanNode::Kind::kArgument) {
+    return true;
+  }
+  for (auto* dep : node->dependencies()) {
+    if (hasControlFlow(dep, visited)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // anonymous namespace
+
+WorkStealingScheduler::WorkStealingScheduler(QueryContext* qctx) : Scheduler() {
+  qctx_ = qctx;
+  query_ = qctx->rctx()->query();
+}
+
+void WorkStealingScheduler::waitFinish() {
+  if (fallback_ != nullptr) {
+    fallback_->waitFinish();
+    return;
+  }
+  std::unique_lock<std::mutex> lck(emtx_);
+  cv_.wait(lck, [this] { return executing_ == 0; });
+}
+
+folly::Future<Status> WorkStealingScheduler::schedule() {
+  auto root = qctx_->plan()->root();
+  std::unordered_set<const PlanNode*> visited;
+  if (hasControlFlow(root, visited)) {
+    // The bodies of Loop/Select are separate plans scheduled on demand, which a task DAG built
+    // up front cannot cover
+    fallback_ = std::make_unique<AsyncMsgNotifyBasedScheduler>(qctx_);
+    return fallback_->schedule();
+  }
+  if (FLAGS_enable_lifetime_optimize) {
+    // special for root
+    root->outputVarPtr()->userCount.store(std::numeric_limits<uint64_t>::max(),
+                                          std::memory_order_relaxed);
+    analyzeLifetime(root);
+  }
+  analyzeParallelism(root);
+  auto executor = Executor::create(root, qctx_);
+  buildTaskDag(executor);
+  auto resultFuture = promise_.getFuture();
+  auto* runner = qctx_->rctx()->runner();
+  // Kick off every leaf, any free worker of the pool may pick one up
+  for (auto& task : tasks_) {
+    if (task->pendingDeps.load(std::memory_order_relaxed) == 0) {
+      runner->add([this, t = task.get()]() { runTask(t); });
+    }
+  }
+  return resultFuture;
+}
+
+void WorkStealingScheduler::buildTaskDag(Executor* root) {
+  std::unordered_map<Executor*, Task*> taskOf;
+  std::queue<Executor*> queue;
+  tasks_.emplace_back(std::make_unique<Task>(root));
+  taskOf.emplace(root, tasks_.back().get());
+  queue.push(root);
+  while (!queue.empty()) {
+    auto* exe = queue.front();
+    queue.pop();
+    auto* task = taskOf[exe];
+    for (auto* dep : exe->depends()) {
+      auto found = taskOf.find(dep);
+      if (found == taskOf.end()) {
+        tasks_.emplace_back(std::make_unique<Task>(dep));
+        found = taskOf.emplace(dep, tasks_.back().get()).first;
+        queue.push(dep);
+      }
+      found->second->dependents.emplace_back(task);
+      task->pendingDeps.fetch_add(1, std::memory_order_relaxed);
+    }
+  }
+  remaining_.store(tasks_.size(), std::memory_order_relaxed);
+}
+
+void WorkStealingScheduler::runTask(Task* task) {
+  addExecuting();
+  if (hasFailStatus()) {
+    // Some other executor has failed, just propagate doneness so the query settles
+    finishTask(task);
+    removeExecuting();
+    return;
+  }
+  execute(task->exe).thenTry([this, task](auto&& t) {
+    if (t.hasException()) {
+      setFailStatus(Status::Error(std::move(t).exception().what()));
+    } else if (!t.value().ok()) {
+      DLOG(INFO) << "[" << task->exe->name() << "," << task->exe->id() << "]"
+                 << " fail with: " << t.value().toString();
+      setFailStatus(std::move(t).value());
+    }
+    finishTask(task);
+    removeExecuting();
+  });
+}
+
+void WorkStealingScheduler::finishTask(Task* task) {
+  auto* runner = qctx_->rctx()->runner();
+  for (auto* dependent : task->dependents) {
+    if (dependent->pendingDeps.fetch_sub(1) == 1) {
+      runner->add([this, dependent]() { runTask(dependent); });
+    }
+  }
+  if (remaining_.fetch_sub(1) == 1) {
+    std::unique_lock<std::mutex> lck(smtx_);
+    if (failedStatus_.has_value()) {
+      promise_.setValue(failedStatus_.value());
+    } else {
+      promise_.setValue(Status::OK());
+    }
+  }
+}
+
+folly::Future<Status> WorkStealingScheduler::execute(Executor* executor) {
+  auto status = executor->open();
+  if (!status.ok()) {
+    return executor->error(std::move(status));
+  }
+  // catch Executor::execute here, upward call stack should only get Status, no exceptions.
+  try {
+    folly::Future<Status> exeStatus = Status::OK();
+    {
+      memory::MemoryCheckGuard guard;
+      // Charge this executor's allocations against the query and the session quotas
+      memory::MemoryScopeGuard scope(
+          {qctx_->memoryUsed(), FLAGS_query_memory_quota_mb * memory::MiB},
+          {qctx_->rctx()->session()->memoryUsed(), FLAGS_session_memory_quota_mb * memory::MiB});
+      PerfCounterScope perfScope(executor);
+      SampledCheck::Scope verifyScope(qctx_->verifyChecks());
+      exeStatus = executor->execute();
+    }
+    return std::move(exeStatus)
+        .thenError(folly::tag_t<std::bad_alloc>{},
+                   [](const std::bad_alloc&) {
+                     return folly::makeFuture<Status>(Status::GraphMemoryExceeded(
+                         "(%d)",
+                         static_cast<int32_t>(nebula::cpp2::ErrorCode::E_GRAPH_MEMORY_EXCEEDED)));
+                   })
+        .thenValue([executor](Status s) {
+          if (!s.ok()) {
+            return s;
+          }
+          return executor->close();
+        });
+  } catch (std::bad_alloc& e) {
+    return folly::makeFuture<Status>(Status::GraphMemoryExceeded(
+        "(%d)", static_cast<int32_t>(nebula::cpp2::ErrorCode::E_GRAPH_MEMORY_EXCEEDED)));
+  } catch (std::exception& e) {
+    return folly::makeFuture<Status>(Status::Error("%s", e.what()));
+  } catch (...) {
+    return folly::makeFuture<Status>(Status::Error("unknown error"));
+  }
+}
+
+void WorkStealingScheduler::setFailStatus(Status status) {
+  std::unique_lock<std::mutex> lck(smtx_);
+  if (!failedStatus_.has_value()) {
+    failedStatus_ = std::move(status);
+  }
+}
+
+bool WorkStealingScheduler::hasFailStatus() {
+  std::unique_lock<std::mutex> lck(smtx_);
+  return failedStatus_.has_value();
+}
+
+void WorkStealingScheduler::addExecuting() {
+  std::unique_lock<std::mutex> lck(emtx_);
+  executing_++;
+}
+
+void WorkStealingScheduler::removeExecuting() {
+  std::unique_lock<std::mutex> lck(emtx_);
+  executing_--;
+  cv_.notify_one();
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,86 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SCHEDULER_WORKSTEALINGSCHEDULER_H_
+#define GRAPH_SCHEDULER_WORKSTEALINGSCHEDULER_H_
+
+#include "graph/scheduler/AsyncMsgNotifyBasedScheduler.h"
+#include "graph/scheduler/Scheduler.h"
+
+namespace nebula {
+namespace graph {
+/**
+ * This scheduler turns the execution plan into a dependency-counted task DAG instead of wiring
+ * one future chain with message notifications per plan node. Every executor becomes a task
+ * holding the number of its unfinished dependencies, a finishing task decrements the counters of
+ * its dependents and dispatches the ones reaching zero to the runner pool, so independent
+ * branches run wherever a worker is free and each node costs one dispatch instead of a
+ * collect/notify round trip. Plans containing control flow (Loop/Select, and the Argument nodes
+ * their bodies use) are delegated to AsyncMsgNotifyBasedScheduler, their bodies are separate
+ * plans which a prebuilt task DAG cannot cover.
+ */
+class WorkStealingScheduler final : public Scheduler {
+ public:
+  explicit WorkStealingScheduler(QueryContext* qctx);
+
+  folly::Future<Status> schedule() override;
+
+  void waitFinish() override;
+
+ private:
+  struct Task {
+    explicit Task(Executor* e) : exe(e) {}
+
+    Executor* exe{nullptr};
+    // number of dependencies which have not finished yet, the task is ready at zero
+    std::atomic<size_t> pendingDeps{0};
+    // tasks waiting for this one
+    std::vector<Task*> dependents;
+  };
+
+  /**
+   * @brief Build one task per executor of the DAG below root and count their dependencies
+   */
+  void buildTaskDag(Executor* root);
+
+  /**
+   * @brief Open, execute and close the executor of the task, then hand its dependents over to
+   * the runner pool
+   */
+  void runTask(Task* task);
+
+  /**
+   * @brief Mark the task finished: dispatch every dependent whose last dependency this was, and
+   * settle the result promise when no task remains
+   */
+  void finishTask(Task* task);
+
+  folly::Future<Status> execute(Executor* executor);
+
+  void setFailStatus(Status status);
+
+  bool hasFailStatus();
+
+  void addExecuting();
+
+  void removeExecuting();
+
+ private:
+  // set if some Executor failed, then other Executors no need to do Executor::execute() further
+  std::mutex smtx_;
+  std::optional<Status> failedStatus_;
+  std::mutex emtx_;
+  std::condition_variable cv_;
+  size_t executing_{0};
+  QueryContext* qctx_{nullptr};
+  std::vector<std::unique_ptr<Task>> tasks_;
+  std::atomic<size_t> remaining_{0};
+  folly::Promise<Status> promise_;
+  // handles the plans with control flow nodes
+  std::unique_ptr<AsyncMsgNotifyBasedScheduler> fallback_;
+};
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_SCHEDULER_WORKSTEALINGSCHEDULER_H_
@@ -0,0 +1,249 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/FederatedQuery.h"
+
+#include "clients/meta/MetaClient.h"
+#include "graph/service/PermissionManager.h"
+#include "graph/service/QueryEngine.h"
+#include "graph/session/ClientSession.h"
+
+DEFINE_bool(enable_multi_space_federation,
+            false,
+            "Whether a query may scatter-gather one statement across several spaces with a "
+            "leading federate(...) hint, merging the result sets by UNION ALL");
+
+DEFINE_int32(max_federated_spaces,
+             16,
+             "Maximum number of spaces one federated query may target, each space runs a "
+             "full sub-query in parallel");
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+constexpr char kHintOpen[] = "/*+";
+constexpr char kHintClose[] = "*/";
+constexpr char kFederateKeyword[] = "federate";
+
+size_t skipSpaces(const std::string& s, size_t pos) {
+  while (pos < s.size() && std::isspace(static_cast<unsigned char>(s[pos]))) {
+    pos++;
+  }
+  return pos;
+}
+
+}  // namespace
+
+bool FederatedQuery::isFederated(const std::string& query) {
+  if (!FLAGS_enable_multi_space_federation) {
+    return false;
+  }
+  auto pos = skipSpaces(query, 0);
+  if (query.compare(pos, strlen(kHintOpen), kHintOpen) != 0) {
+    return false;
+  }
+  pos = skipSpaces(query, pos + strlen(kHintOpen));
+  return query.compare(pos, strlen(kFederateKeyword), kFederateKeyword) == 0;
+}
+
+StatusOr<std::pair<std::vector<std::string>, std::string>> FederatedQuery::parseHint(
+    const std::string& query) {
+  auto pos = skipSpaces(query, 0);
+  pos = skipSpaces(query, pos + strlen(kHintOpen));
+  pos = skipSpaces(query, pos + strlen(kFederateKeyword));
+  if (pos >= query.size() || query[pos] != '(') {
+    return Status::SyntaxError("Expected '(' after federate");
+  }
+  pos++;
+  std::vector<std::string> spaces;
+  while (true) {
+    pos = skipSpaces(query, pos);
+    size_t start = pos;
+    while (pos < query.size() &&
+           (std::isalnum(static_cast<unsigned char>(query[pos])) || query[pos] == '_')) {
+      pos++;
+    }
+    if (pos == start) {
+      return Status::SyntaxError("Expected a space name in federate hint");
+    }
+    spaces.emplace_back(query.substr(start, pos - start));
+    pos = skipSpaces(query, pos);
+    if (pos < query.size() && query[pos] == ',') {
+      pos++;
+      continue;
+    }
+    break;
+  }
+  if (pos >= query.size() || query[pos] != ')') {
+    return Status::SyntaxError("Expected ')' closing the federate space list");
+  }
+  pos = skipSpaces(query, pos + 1);
+  if (query.compare(pos, strlen(kHintClose), kHintClose) != 0) {
+    return Status::SyntaxError("Expected '*/' closing the federate hint");
+  }
+  auto stmt = query.substr(pos + strlen(kHintClose));
+  if (skipSpaces(stmt, 0) >= stmt.size()) {
+    return Status::SyntaxError("Empty statement after federate hint");
+  }
+  return std::make_pair(std::move(spaces), std::move(stmt));
+}
+
+void FederatedQuery::fail(RequestContext<ExecutionResponse>* rctx,
+                          ErrorCode code,
+                          const std::string& message) {
+  rctx->resp().errorCode = code;
+  rctx->resp().errorMsg = std::make_unique<std::string>(message);
+  rctx->resp().latencyInUs = rctx->duration().elapsedInUSec();
+  rctx->finish();
+}
+
+void FederatedQuery::execute(RequestContextPtr rctx, QueryEngine* engine) {
+  auto parsed = parseHint(rctx->query());
+  if (!parsed.ok()) {
+    fail(rctx.get(), ErrorCode::E_SYNTAX_ERROR, parsed.status().toString());
+    return;
+  }
+  auto spaces = std::move(parsed).value();
+  if (spaces.first.size() > static_cast<size_t>(FLAGS_max_federated_spaces)) {
+    fail(rctx.get(),
+         ErrorCode::E_SEMANTIC_ERROR,
+         folly::stringPrintf("A federated query may target at most %d spaces, got %zu",
+                             FLAGS_max_federated_spaces,
+                             spaces.first.size()));
+    return;
+  }
+  if (rctx->session() == nullptr) {
+    fail(rctx.get(), ErrorCode::E_SESSION_INVALID, "Session not found");
+    return;
+  }
+
+  std::vector<folly::Future<ExecutionResponse>> futures;
+  futures.reserve(spaces.first.size());
+  for (const auto& spaceName : spaces.first) {
+    futures.emplace_back(executeOnSpace(engine, rctx.get(), spaceName, spaces.second));
+  }
+
+  auto* runner = rctx->runner();
+  folly::collectAll(std::move(futures))
+      .via(runner)
+      .thenValue([rctx = std::move(rctx),
+                  spaceNames = std::move(spaces.first)](auto&& tries) mutable {
+        DataSet merged;
+        for (size_t i = 0; i < tries.size(); i++) {
+          if (tries[i].hasException()) {
+            fail(rctx.get(),
+                 ErrorCode::E_EXECUTION_ERROR,
+                 folly::stringPrintf("Federated sub-query on space `%s' threw: %s",
+                                     spaceNames[i].c_str(),
+                                     tries[i].exception().what().c_str()));
+            return;
+          }
+          auto& resp = tries[i].value();
+          if (resp.errorCode != ErrorCode::SUCCEEDED) {
+            fail(rctx.get(),
+                 resp.errorCode,
+                 folly::stringPrintf("Federated sub-query on space `%s' failed: %s",
+                                     spaceNames[i].c_str(),
+                                     resp.errorMsg != nullptr ? resp.errorMsg->c_str() : ""));
+            return;
+          }
+          if (resp.data == nullptr) {
+            fail(rctx.get(),
+                 ErrorCode::E_SEMANTIC_ERROR,
+                 folly::stringPrintf("Federated sub-query on space `%s' returned no data set, "
+                                     "only read statements can be federated",
+                                     spaceNames[i].c_str()));
+            return;
+          }
+          if (merged.colNames.empty()) {
+            merged = std::move(*resp.data);
+          } else {
+            if (resp.data->colNames != merged.colNames) {
+              fail(rctx.get(),
+                   ErrorCode::E_SEMANTIC_ERROR,
+                   folly::stringPrintf("Federated sub-query on space `%s' returned a different "
+                                       "column list",
+                                       spaceNames[i].c_str()));
+              return;
+            }
+            merged.append(std::move(*resp.data));
+          }
+        }
+        auto& resp = rctx->resp();
+        resp.errorCode = ErrorCode::SUCCEEDED;
+        resp.spaceName = std::make_unique<std::string>(rctx->session()->space().name);
+        resp.data = std::make_unique<DataSet>(std::move(merged));
+        resp.latencyInUs = rctx->duration().elapsedInUSec();
+        rctx->finish();
+      });
+}
+
+folly::Future<ExecutionResponse> FederatedQuery::executeOnSpace(
+    QueryEngine* engine,
+    RequestContext<ExecutionResponse>* parent,
+    const std::string& spaceName,
+    const std::string& stmt) {
+  auto* metaClient = engine->metaClient();
+  // Everything the sub-query needs is copied out of the parent context up front, the
+  // parent stays alive until all sub-futures are collected but must not be touched from
+  // several continuations concurrently.
+  auto sessionCopy = parent->session()->getSession();
+  auto parameterMap = parent->parameterMap();
+  auto* runner = parent->runner();
+  auto* sessionMgr = parent->sessionMgr();
+  return metaClient->getSpace(spaceName)
+      .via(runner)
+      .thenValue([engine,
+                  metaClient,
+                  runner,
+                  sessionMgr,
+                  spaceName,
+                  stmt,
+                  sessionCopy = std::move(sessionCopy),
+                  parameterMap = std::move(parameterMap)](
+                     StatusOr<meta::cpp2::SpaceItem> resp) mutable
+                 -> folly::Future<ExecutionResponse> {
+        auto makeError = [](ErrorCode code, const std::string& message) {
+          ExecutionResponse error;
+          error.errorCode = code;
+          error.errorMsg = std::make_unique<std::string>(message);
+          return folly::makeFuture<ExecutionResponse>(std::move(error));
+        };
+        if (!resp.ok()) {
+          return makeError(ErrorCode::E_EXECUTION_ERROR,
+                           folly::stringPrintf("Get space `%s' failed: %s",
+                                               spaceName.c_str(),
+                                               resp.status().toString().c_str()));
+        }
+        auto spaceId = resp.value().get_space_id();
+        // The ephemeral session carries the caller's user and roles, switched to the
+        // target space and never registered with the session manager
+        auto subSession = ClientSession::create(std::move(sessionCopy), metaClient);
+        auto permission = PermissionManager::canReadSpace(subSession.get(), spaceId);
+        if (!permission.ok()) {
+          return makeError(ErrorCode::E_BAD_PERMISSION, permission.toString());
+        }
+        SpaceInfo spaceInfo;
+        spaceInfo.id = spaceId;
+        spaceInfo.name = spaceName;
+        spaceInfo.spaceDesc = resp.value().get_properties();
+        subSession->setSpace(std::move(spaceInfo));
+
+        auto subCtx = std::make_unique<RequestContext<ExecutionResponse>>();
+        subCtx->setQuery(stmt);
+        subCtx->setRunner(runner);
+        subCtx->setSessionMgr(sessionMgr);
+        subCtx->setSession(std::move(subSession));
+        subCtx->setParameterMap(std::move(parameterMap));
+        auto future = subCtx->future();
+        engine->execute(std::move(subCtx));
+        return future;
+      });
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,78 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_FEDERATEDQUERY_H_
+#define GRAPH_SERVICE_FEDERATEDQUERY_H_
+
+#include <string>
+#include <vector>
+
+#include "common/base/StatusOr.h"
+#include "graph/service/RequestContext.h"
+#include "interface/gen-cpp2/GraphService.h"
+
+namespace nebula {
+namespace graph {
+
+class QueryEngine;
+
+/**
+ * Scatter-gather execution of one read statement across several spaces, for deployments
+ * that shard tenants by space. A query of the form
+ *
+ *   /*+ federate(space1, space2, ...) *\/ <statement>
+ *
+ * runs <statement> once per listed space in parallel and merges the result sets by
+ * UNION ALL semantics, replacing the client side loop of N sequential queries.
+ *
+ * Every sub-query gets its own ephemeral ClientSession (a copy of the caller's session
+ * switched to the target space, never registered with the session manager) and its own
+ * QueryContext, so the sub-plans do not share any mutable state. They do share the
+ * caller's runner and the engine's workload pools, so federation does not escape the
+ * executor budget of a single query. Read permission on every listed space is checked
+ * against the caller's roles before anything runs.
+ *
+ * Behind enable_multi_space_federation (default off); with the flag off the hint is an
+ * ordinary comment and the statement runs against the current space only.
+ */
+class FederatedQuery final {
+ public:
+  FederatedQuery() = delete;
+
+  using RequestContextPtr = std::unique_ptr<RequestContext<ExecutionResponse>>;
+
+  /**
+   * @brief Whether the query carries a federation hint and federation is enabled
+   */
+  static bool isFederated(const std::string& query);
+
+  /**
+   * @brief Fan the hinted statement out across its target spaces through the engine,
+   * merge the result sets and finish the request context
+   */
+  static void execute(RequestContextPtr rctx, QueryEngine* engine);
+
+ private:
+  /**
+   * @brief Split "/*+ federate(s1, s2) *\/ stmt" into the space list and the statement,
+   * syntax errors come back as a Status
+   */
+  static StatusOr<std::pair<std::vector<std::string>, std::string>> parseHint(
+      const std::string& query);
+
+  static folly::Future<ExecutionResponse> executeOnSpace(QueryEngine* engine,
+                                                         RequestContext<ExecutionResponse>* parent,
+                                                         const std::string& spaceName,
+                                                         const std::string& stmt);
+
+  static void fail(RequestContext<ExecutionResponse>* rctx,
+                   ErrorCode code,
+                   const std::string& message);
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_SERVICE_FEDERATEDQUERY_H_
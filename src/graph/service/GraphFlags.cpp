@@ -16,6 +16,19 @@ DEFINE_int32(
     session_reclaim_interval_secs,
     60,
     "Period we try to reclaim expired sessions and update session information to the meta server");
+DEFINE_int64(query_deadline_ms,
+             0,
+             "Abort a query once it has been running this long, and carry the remaining budget "
+             "into storage RPCs so storaged also stops scanning for it. 0 disables the deadline");
+DEFINE_int64(cursor_page_rows,
+             0,
+             "Page query results that exceed this many rows: the response carries the first page "
+             "plus a cursor id and the rest is fetched page by page with fetchCursor(), so one "
+             "huge response does not have to be serialized in one piece. 0 disables paging");
+DEFINE_int32(session_update_batch_size,
+             0,
+             "Update session information to the meta server in batches of this many sessions, so "
+             "one huge RPC does not stall the session scavenger. 0 sends all sessions in one RPC");
 DEFINE_int32(num_netio_threads,
              0,
              "The number of networking threads, 0 for number of physical CPU cores");
@@ -51,8 +64,19 @@ DEFINE_string(auth_type,
               "cloud for cloud authentication");
 
 DEFINE_string(cloud_http_url, "", "cloud http url including ip, port, url path");
+DEFINE_int32(auth_cache_ttl_secs,
+             0,
+             "Cache successful credential checks for this many seconds so reconnect storms skip "
+             "repeated authentication work. 0 disables the cache. A password change may take up "
+             "to the TTL to be enforced for a credential that already authenticated");
+DEFINE_int32(auth_cache_capacity, 10240, "Max number of cached credential checks");
 DEFINE_uint32(max_allowed_statements, 512, "Max allowed sequential statements");
 DEFINE_uint32(max_allowed_query_size, 4194304, "Max allowed sequential query size");
+DEFINE_bool(enable_fast_parser,
+            false,
+            "Try the hand-written fast-path recognizer for hot statement shapes (GO, FETCH PROP) "
+            "before the bison parser. The hit rate shows up as num_fast_path_parses against "
+            "num_queries");
 
 DEFINE_uint32(max_statements,
               1024,
@@ -63,6 +87,17 @@ DEFINE_int64(max_allowed_connections,
 
 DEFINE_bool(enable_optimizer, false, "Whether to enable optimizer");
 
+DEFINE_bool(enable_expression_bytecode,
+            false,
+            "Whether to compile supported filter/projection expressions into flat bytecode "
+            "instead of interpreting the expression tree");
+
+DEFINE_bool(enable_count_from_stats,
+            false,
+            "Whether to answer ungrouped COUNT over a whole tag/edge type/space from the stats "
+            "kept by the meta service instead of scanning. The answer is only as fresh as the "
+            "last stats job");
+
 #ifndef BUILD_STANDALONE
 DEFINE_uint32(ft_request_retry_times, 3, "Retry times if fulltext request failed");
 DEFINE_bool(enable_client_white_list, true, "Turn on/off the client white list.");
@@ -91,6 +126,18 @@ DEFINE_bool(optimize_appendvertices, false, "if true, return directly without go
 
 DEFINE_uint32(num_path_thread, 10, "number of threads to build path");
 
+DEFINE_string(weighted_shortest_path_prop,
+              "",
+              "Edge property used as the weight of shortest path, empty keeps the unweighted "
+              "bfs path finders");
+DEFINE_double(weighted_shortest_path_delta,
+              1.0,
+              "Bucket width of the delta-stepping weighted shortest path finder");
+DEFINE_bool(expand_two_hop_pushdown,
+            false,
+            "If true, the last two rounds of a dst-only expansion are pushed down to storaged "
+            "as a single two-hop getDstBySrc call");
+
 // Sanity-checking Flag Values
 static bool ValidateSessIdleTimeout(const char* flagname, int32_t value) {
   // The max timeout is 604800 seconds(a week)
@@ -118,3 +165,18 @@ DEFINE_uint32(
     "Background garbage clean workers, default number is 0 which means using hardware core size.");
 
 DEFINE_bool(graph_use_vertex_key, false, "whether allow insert or query the vertex key");
+
+DEFINE_int64(query_memory_quota_mb,
+             0,
+             "Maximum tracked memory a single query may hold, a query exceeding it fails with a "
+             "memory exceeded error instead of pushing the whole process to the limit, 0 means "
+             "no per-query quota");
+DEFINE_int64(session_memory_quota_mb,
+             0,
+             "Maximum tracked memory all queries of one session may hold together, 0 means no "
+             "per-session quota");
+DEFINE_double(query_admission_memory_ratio,
+              0.0,
+              "Reject new queries when the tracked memory usage exceeds this ratio of the memory "
+              "tracker limit, so in-flight queries can finish instead of failing at the high "
+              "watermark, 0 disables admission control");
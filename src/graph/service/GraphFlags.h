@@ -12,6 +12,9 @@ DECLARE_int32(port);
 DECLARE_int32(client_idle_timeout_secs);
 DECLARE_int32(session_idle_timeout_secs);
 DECLARE_int32(session_reclaim_interval_secs);
+DECLARE_int32(session_update_batch_size);
+DECLARE_int64(query_deadline_ms);
+DECLARE_int64(cursor_page_rows);
 DECLARE_int32(num_netio_threads);
 DECLARE_int32(num_accept_threads);
 DECLARE_uint32(num_max_connections);
@@ -39,6 +42,8 @@ DECLARE_string(default_collate);
 DECLARE_bool(enable_authorize);
 DECLARE_string(auth_type);
 DECLARE_string(cloud_http_url);
+DECLARE_int32(auth_cache_ttl_secs);
+DECLARE_int32(auth_cache_capacity);
 DECLARE_uint32(max_allowed_statements);
 DECLARE_int32(max_sessions_per_ip_per_user);
 
@@ -53,8 +58,13 @@ DECLARE_uint32(password_lock_time_in_secs);
 
 // Optimizer
 DECLARE_bool(enable_optimizer);
+DECLARE_bool(enable_expression_bytecode);
+DECLARE_bool(enable_count_from_stats);
 DECLARE_bool(optimize_appendvertice);
 DECLARE_uint32(num_path_thread);
+DECLARE_string(weighted_shortest_path_prop);
+DECLARE_double(weighted_shortest_path_delta);
+DECLARE_bool(expand_two_hop_pushdown);
 
 DECLARE_int64(max_allowed_connections);
 
@@ -74,4 +84,8 @@ DECLARE_uint32(gc_worker_size);
 
 DECLARE_bool(graph_use_vertex_key);
 
+DECLARE_int64(query_memory_quota_mb);
+DECLARE_int64(session_memory_quota_mb);
+DECLARE_double(query_admission_memory_ratio);
+
 #endif  // GRAPH_GRAPHFLAGS_H_
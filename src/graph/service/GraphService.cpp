@@ -15,6 +15,7 @@
 #include "common/stats/StatsManager.h"
 #include "common/time/Duration.h"
 #include "common/time/TimezoneInfo.h"
+#include "common/time/WallClock.h"
 #include "graph/service/CloudAuthenticator.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/service/PasswordAuthenticator.h"
@@ -66,6 +67,11 @@ Status GraphService::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecuto
                          initSessionMgrStatus.toString().c_str());
   }
 
+  if (FLAGS_auth_cache_ttl_secs > 0) {
+    authCache_ =
+        std::make_unique<ConcurrentLRUCache<std::string, int64_t>>(FLAGS_auth_cache_capacity);
+  }
+
   queryEngine_ = std::make_unique<QueryEngine>();
   return queryEngine_->init(std::move(ioExecutor), metaClient_.get());
 }
@@ -85,56 +91,63 @@ folly::Future<AuthResponse> GraphService::future_authenticate(const std::string&
 
   auto ctx = std::make_unique<RequestContext<AuthResponse>>();
   auto future = ctx->future();
+  auto* runner = getThreadManager();
 
-  // check username and password failed
-  auto authResult = auth(username, password);
-  if (!authResult.ok()) {
-    ctx->resp().errorCode = ErrorCode::E_BAD_USERNAME_PASSWORD;
-    ctx->resp().errorMsg.reset(new std::string(authResult.toString()));
-    ctx->finish();
-    stats::StatsManager::addValue(kNumAuthFailedSessions);
-    stats::StatsManager::addValue(kNumAuthFailedSessionsBadUserNamePassword);
-    return future;
-  }
+  // The credential check can block: the cloud authenticator does a synchronous HTTP round trip.
+  // Run the whole pipeline on the worker pool so a reconnect storm cannot saturate the IO
+  // threads with inline authentication work.
+  folly::via(
+      runner, [this, runner, username, password, clientIp, ctx = std::move(ctx)]() mutable {
+        // check username and password failed
+        auto authResult = authWithCache(username, password);
+        if (!authResult.ok()) {
+          ctx->resp().errorCode = ErrorCode::E_BAD_USERNAME_PASSWORD;
+          ctx->resp().errorMsg.reset(new std::string(authResult.toString()));
+          ctx->finish();
+          stats::StatsManager::addValue(kNumAuthFailedSessions);
+          stats::StatsManager::addValue(kNumAuthFailedSessionsBadUserNamePassword);
+          return;
+        }
 
-  if (sessionManager_->isOutOfConnections()) {
-    ctx->resp().errorCode = ErrorCode::E_TOO_MANY_CONNECTIONS;
-    ctx->resp().errorMsg.reset(new std::string("Too many connections in the cluster"));
-    ctx->finish();
-    stats::StatsManager::addValue(kNumAuthFailedSessions);
-    stats::StatsManager::addValue(kNumAuthFailedSessionsOutOfMaxAllowed);
-    return future;
-  }
+        if (sessionManager_->isOutOfConnections()) {
+          ctx->resp().errorCode = ErrorCode::E_TOO_MANY_CONNECTIONS;
+          ctx->resp().errorMsg.reset(new std::string("Too many connections in the cluster"));
+          ctx->finish();
+          stats::StatsManager::addValue(kNumAuthFailedSessions);
+          stats::StatsManager::addValue(kNumAuthFailedSessionsOutOfMaxAllowed);
+          return;
+        }
 
-  auto cb = [user = username, cIp = clientIp, ctx = std::move(ctx)](
-                StatusOr<std::shared_ptr<ClientSession>> ret) mutable {
-    VLOG(2) << "Create session doFinish";
-    if (!ret.ok()) {
-      LOG(ERROR) << "Create session for userName: " << user << ", ip: " << cIp
-                 << " failed: " << ret.status();
-      ctx->resp().errorCode = ErrorCode::E_SESSION_INVALID;
-      ctx->resp().errorMsg.reset(new std::string(ret.status().toString()));
-      return ctx->finish();
-    }
-    auto sessionPtr = std::move(ret).value();
-    if (sessionPtr == nullptr) {
-      LOG(ERROR) << "Get session for sessionId is nullptr";
-      ctx->resp().errorCode = ErrorCode::E_SESSION_INVALID;
-      ctx->resp().errorMsg.reset(new std::string("Get session for sessionId is nullptr"));
-      return ctx->finish();
-    }
-    stats::StatsManager::addValue(kNumOpenedSessions);
-    stats::StatsManager::addValue(kNumActiveSessions);
-    ctx->setSession(sessionPtr);
-    ctx->resp().sessionId.reset(new int64_t(ctx->session()->id()));
-    ctx->resp().timeZoneOffsetSeconds.reset(
-        new int32_t(time::Timezone::getGlobalTimezone().utcOffsetSecs()));
-    ctx->resp().timeZoneName.reset(
-        new std::string(time::Timezone::getGlobalTimezone().stdZoneName()));
-    return ctx->finish();
-  };
+        auto cb = [user = username, cIp = clientIp, ctx = std::move(ctx)](
+                      StatusOr<std::shared_ptr<ClientSession>> ret) mutable {
+          VLOG(2) << "Create session doFinish";
+          if (!ret.ok()) {
+            LOG(ERROR) << "Create session for userName: " << user << ", ip: " << cIp
+                       << " failed: " << ret.status();
+            ctx->resp().errorCode = ErrorCode::E_SESSION_INVALID;
+            ctx->resp().errorMsg.reset(new std::string(ret.status().toString()));
+            return ctx->finish();
+          }
+          auto sessionPtr = std::move(ret).value();
+          if (sessionPtr == nullptr) {
+            LOG(ERROR) << "Get session for sessionId is nullptr";
+            ctx->resp().errorCode = ErrorCode::E_SESSION_INVALID;
+            ctx->resp().errorMsg.reset(new std::string("Get session for sessionId is nullptr"));
+            return ctx->finish();
+          }
+          stats::StatsManager::addValue(kNumOpenedSessions);
+          stats::StatsManager::addValue(kNumActiveSessions);
+          ctx->setSession(sessionPtr);
+          ctx->resp().sessionId.reset(new int64_t(ctx->session()->id()));
+          ctx->resp().timeZoneOffsetSeconds.reset(
+              new int32_t(time::Timezone::getGlobalTimezone().utcOffsetSecs()));
+          ctx->resp().timeZoneName.reset(
+              new std::string(time::Timezone::getGlobalTimezone().stdZoneName()));
+          return ctx->finish();
+        };
 
-  sessionManager_->createSession(username, clientIp, getThreadManager()).thenValue(std::move(cb));
+        sessionManager_->createSession(username, clientIp, runner).thenValue(std::move(cb));
+      });
   return future;
 }
 
@@ -176,6 +189,18 @@ folly::Future<ExecutionResponse> GraphService::future_executeWithParameter(
           new std::string(folly::stringPrintf("SessionId[%ld] does not exist", sessionId)));
       return ctx->finish();
     }
+    // Admission control: reject new queries before they are parsed when the process is close
+    // to its memory limit, so the in-flight queries get to finish instead of random ones
+    // failing at the high watermark
+    if (FLAGS_query_admission_memory_ratio > 0.0 &&
+        memory::MemoryStats::instance().usedRatio() > FLAGS_query_admission_memory_ratio) {
+      ctx->resp().errorCode = ErrorCode::E_EXECUTION_ERROR;
+      ctx->resp().errorMsg.reset(new std::string(
+          folly::stringPrintf("Query rejected, the memory usage is over the admission ratio(%lf), "
+                              "try again later",
+                              FLAGS_query_admission_memory_ratio)));
+      return ctx->finish();
+    }
     stats::StatsManager::addValue(kNumQueries);
     stats::StatsManager::addValue(kNumActiveQueries);
     if (FLAGS_enable_space_level_metrics && sessionPtr->space().name != "") {
@@ -218,6 +243,46 @@ folly::Future<std::string> GraphService::future_executeJsonWithParameter(
   });
 }
 
+folly::Future<ExecutionResponse> GraphService::future_fetchCursor(int64_t sessionId,
+                                                                  int64_t cursorId) {
+  auto ctx = std::make_unique<RequestContext<ExecutionResponse>>();
+  ctx->setRunner(getThreadManager());
+  ctx->setSessionMgr(sessionManager_.get());
+  auto future = ctx->future();
+  auto cb = [sessionId, cursorId, ctx = std::move(ctx)](
+                StatusOr<std::shared_ptr<ClientSession>> ret) mutable {
+    if (!ret.ok()) {
+      ctx->resp().errorCode = ErrorCode::E_SESSION_INVALID;
+      ctx->resp().errorMsg.reset(new std::string(folly::stringPrintf(
+          "Get sessionId[%ld] failed: %s", sessionId, ret.status().toString().c_str())));
+      return ctx->finish();
+    }
+    auto sessionPtr = std::move(ret).value();
+    if (sessionPtr == nullptr) {
+      ctx->resp().errorCode = ErrorCode::E_SESSION_INVALID;
+      ctx->resp().errorMsg.reset(
+          new std::string(folly::stringPrintf("SessionId[%ld] does not exist", sessionId)));
+      return ctx->finish();
+    }
+    sessionPtr->charge();
+    bool hasMore = false;
+    auto page = sessionPtr->nextCursorPage(cursorId, FLAGS_cursor_page_rows, &hasMore);
+    if (!page.ok()) {
+      ctx->resp().errorCode = ErrorCode::E_EXECUTION_ERROR;
+      ctx->resp().errorMsg = std::make_unique<std::string>(page.status().toString());
+      return ctx->finish();
+    }
+    ctx->resp().data = std::make_unique<DataSet>(std::move(page).value());
+    if (hasMore) {
+      ctx->resp().cursor = std::make_unique<int64_t>(cursorId);
+    }
+    ctx->resp().latencyInUs = ctx->duration().elapsedInUSec();
+    ctx->finish();
+  };
+  sessionManager_->findSession(sessionId, getThreadManager()).thenValue(std::move(cb));
+  return future;
+}
+
 Status GraphService::auth(const std::string& username, const std::string& password) {
   auto metaClient = queryEngine_->metaClient();
 
@@ -250,6 +315,23 @@ Status GraphService::auth(const std::string& username, const std::string& passwo
   return Status::Error("Unknown auth type: %s", FLAGS_auth_type.c_str());
 }
 
+Status GraphService::authWithCache(const std::string& username, const std::string& password) {
+  if (authCache_ == nullptr) {
+    return auth(username, password);
+  }
+  auto key = username + ":" + proxygen::md5Encode(folly::StringPiece(password));
+  auto cached = authCache_->get(key);
+  if (cached.ok() && cached.value() > time::WallClock::fastNowInSec()) {
+    return Status::OK();
+  }
+  auto result = auth(username, password);
+  if (result.ok()) {
+    authCache_->insert(std::move(key),
+                       time::WallClock::fastNowInSec() + FLAGS_auth_cache_ttl_secs);
+  }
+  return result;
+}
+
 folly::Future<cpp2::VerifyClientVersionResp> GraphService::future_verifyClientVersion(
     const cpp2::VerifyClientVersionReq& req) {
   std::unordered_set<std::string> whiteList;
@@ -7,6 +7,7 @@
 #define GRAPH_SERVICE_GRAPHSERVICE_H_
 
 #include "common/base/Base.h"
+#include "common/base/ConcurrentLRUCache.h"
 #include "graph/service/Authenticator.h"
 #include "graph/service/QueryEngine.h"
 #include "graph/session/GraphSessionManager.h"
@@ -48,6 +49,9 @@ class GraphService final : public cpp2::GraphServiceSvIf {
   folly::Future<std::string> future_executeJson(int64_t sessionId,
                                                 const std::string& stmt) override;
 
+  folly::Future<ExecutionResponse> future_fetchCursor(int64_t sessionId,
+                                                      int64_t cursorId) override;
+
   folly::Future<cpp2::VerifyClientVersionResp> future_verifyClientVersion(
       const cpp2::VerifyClientVersionReq& req) override;
 
@@ -56,8 +60,15 @@ class GraphService final : public cpp2::GraphServiceSvIf {
  private:
   Status auth(const std::string& username, const std::string& password);
 
+  // Checks the TTL-bounded credential cache before falling back to auth(), only successful
+  // checks are cached so a rejected password is always re-verified
+  Status authWithCache(const std::string& username, const std::string& password);
+
   std::unique_ptr<GraphSessionManager> sessionManager_;
   std::unique_ptr<QueryEngine> queryEngine_;
+  // Maps md5(user:password) to the wall clock time in seconds the cached check expires at,
+  // nullptr unless FLAGS_auth_cache_ttl_secs > 0
+  std::unique_ptr<ConcurrentLRUCache<std::string, int64_t>> authCache_;
 };
 
 }  // namespace graph
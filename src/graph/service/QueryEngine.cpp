@@ -5,13 +5,19 @@
 
 #include "graph/service/QueryEngine.h"
 
+#include <folly/executors/task_queue/LifoSemMPMCQueue.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/hash/Hash.h>
+
 #include "common/base/Base.h"
+#include "common/base/SampledCheck.h"
 #include "common/memory/MemoryUtils.h"
 #include "common/meta/ServerBasedIndexManager.h"
 #include "common/meta/ServerBasedSchemaManager.h"
 #include "graph/context/QueryContext.h"
 #include "graph/optimizer/OptRule.h"
 #include "graph/planner/PlannersRegister.h"
+#include "graph/service/FederatedQuery.h"
 #include "graph/service/GraphFlags.h"
 #include "graph/service/QueryInstance.h"
 #include "version/Version.h"
@@ -21,6 +27,39 @@ DECLARE_bool(enable_optimizer);
 DECLARE_string(meta_server_addrs);
 DEFINE_int32(check_memory_interval_in_secs, 1, "Memory check interval in seconds");
 
+DEFINE_int32(num_heavy_query_threads,
+             0,
+             "Number of threads of the heavy workload class pool. When positive, queries are "
+             "classified at plan time and light/heavy queries run on separate pools instead of "
+             "the shared worker pool. 0 disables workload isolation");
+DEFINE_int32(num_light_query_threads,
+             0,
+             "Number of threads of the light workload class pool, 0 means the hardware "
+             "concurrency. Only meaningful when num_heavy_query_threads is positive");
+DEFINE_int32(light_query_queue_limit,
+             8192,
+             "Maximum number of pending tasks in the light pool; tasks beyond the limit are "
+             "rejected and fail their query");
+DEFINE_int32(heavy_query_queue_limit,
+             1024,
+             "Maximum number of pending tasks in the heavy pool; tasks beyond the limit are "
+             "rejected and fail their query");
+DEFINE_uint64(heavy_query_rows_threshold,
+              100000,
+              "A query classified as light is moved to the heavy pool once one of its "
+              "executors produces more rows than this, correcting the plan time estimate");
+
+DEFINE_int32(session_affinity_groups,
+             0,
+             "Number of session affinity runner groups. When positive, each session is hashed "
+             "to one group of worker threads and all its queries run there, so repeated "
+             "similar queries of a session hit warm instruction caches and allocator arenas. "
+             "Workload isolation, when also enabled, still takes precedence over the affinity "
+             "group. 0 disables session affinity");
+DEFINE_int32(session_affinity_threads_per_group,
+             1,
+             "Number of worker threads per session affinity group");
+
 namespace nebula {
 namespace graph {
 
@@ -41,18 +80,72 @@ Status QueryEngine::init(std::shared_ptr<folly::IOThreadPoolExecutor> ioExecutor
     rulesets.emplace_back(&opt::RuleSet::QueryRules());
   }
   optimizer_ = std::make_unique<opt::Optimizer>(rulesets);
+  setupWorkloadPools();
+  setupAffinityPools();
 
   return setupMemoryMonitorThread();
 }
 
+void QueryEngine::setupWorkloadPools() {
+  if (FLAGS_num_heavy_query_threads <= 0) {
+    return;
+  }
+  auto lightThreads = FLAGS_num_light_query_threads > 0
+                          ? FLAGS_num_light_query_threads
+                          : static_cast<int32_t>(std::thread::hardware_concurrency());
+  lightPool_ = std::make_shared<folly::CPUThreadPoolExecutor>(
+      lightThreads,
+      std::make_unique<folly::LifoSemMPMCQueue<folly::CPUThreadPoolExecutor::CPUTask,
+                                               folly::QueueBehaviorIfFull::THROW>>(
+          FLAGS_light_query_queue_limit),
+      std::make_shared<folly::NamedThreadFactory>("light-query"));
+  heavyPool_ = std::make_shared<folly::CPUThreadPoolExecutor>(
+      FLAGS_num_heavy_query_threads,
+      std::make_unique<folly::LifoSemMPMCQueue<folly::CPUThreadPoolExecutor::CPUTask,
+                                               folly::QueueBehaviorIfFull::THROW>>(
+          FLAGS_heavy_query_queue_limit),
+      std::make_shared<folly::NamedThreadFactory>("heavy-query"));
+  LOG(INFO) << "Workload isolation enabled: " << lightThreads << " light / "
+            << FLAGS_num_heavy_query_threads << " heavy query threads";
+}
+
+void QueryEngine::setupAffinityPools() {
+  if (FLAGS_session_affinity_groups <= 0) {
+    return;
+  }
+  auto threads = std::max(FLAGS_session_affinity_threads_per_group, 1);
+  affinityPools_.reserve(FLAGS_session_affinity_groups);
+  for (int32_t i = 0; i < FLAGS_session_affinity_groups; i++) {
+    affinityPools_.emplace_back(std::make_shared<folly::CPUThreadPoolExecutor>(
+        threads,
+        std::make_shared<folly::NamedThreadFactory>(folly::stringPrintf("affin-query-%d", i))));
+  }
+  LOG(INFO) << "Session affinity enabled: " << FLAGS_session_affinity_groups << " groups of "
+            << threads << " threads";
+}
+
 // Create query context and query instance and execute it
 void QueryEngine::execute(RequestContextPtr rctx) {
+  if (FederatedQuery::isFederated(rctx->query())) {
+    // fans out one sub-query per target space through this very method, each with the
+    // hint stripped off, and finishes the context after merging
+    FederatedQuery::execute(std::move(rctx), this);
+    return;
+  }
+  if (!affinityPools_.empty() && rctx->session() != nullptr) {
+    // consistent hash of the session to its runner group, all queries of one session run
+    // on the same few threads
+    auto idx = folly::hash::twang_mix64(rctx->session()->id()) % affinityPools_.size();
+    rctx->setRunner(affinityPools_[idx].get());
+  }
   auto qctx = std::make_unique<QueryContext>(std::move(rctx),
                                              schemaManager_.get(),
                                              indexManager_.get(),
                                              storage_.get(),
                                              metaClient_,
                                              charsetInfo_);
+  qctx->setWorkloadRunners(lightPool_.get(), heavyPool_.get());
+  qctx->setVerifyChecks(SampledCheck::sampleRequest());
   auto* instance = new QueryInstance(std::move(qctx), optimizer_.get());
   instance->execute();
 }
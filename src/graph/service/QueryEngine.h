@@ -6,6 +6,7 @@
 #ifndef GRAPH_SERVICE_QUERYENGINE_H_
 #define GRAPH_SERVICE_QUERYENGINE_H_
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
 #include <folly/executors/IOThreadPoolExecutor.h>
 
 #include <boost/core/noncopyable.hpp>
@@ -28,6 +29,13 @@ namespace graph {
  * QueryEngine is responsible to create and manage ExecutionPlan.
  * For the time being, we don't have the execution plan cache support,
  * instead we create a plan for each query, and destroy it upon finish.
+ *
+ * Caching optimized plans for repeated (parameterized) statements is blocked by ownership:
+ * the parser, the validators and the planner all allocate AST nodes, expressions, plan nodes
+ * and symbols from the per-query ObjectPool owned by QueryContext, so a plan cannot outlive
+ * its query. A plan cache needs those artifacts moved to a pool owned by the cache entry,
+ * parameters rebound per execution, and entries invalidated on schema version bumps from
+ * MetaClient.
  */
 class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
  public:
@@ -47,6 +55,22 @@ class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
  private:
   Status setupMemoryMonitorThread();
 
+  /**
+   * @brief Create the per-workload-class runner pools when num_heavy_query_threads is
+   * positive. Queries are classified at plan time and run on the light or the heavy pool
+   * instead of the shared thrift worker pool, so an analytical query queued behind its own
+   * class cannot starve point lookups.
+   */
+  void setupWorkloadPools();
+
+  /**
+   * @brief Create the session affinity runner groups when session_affinity_groups is
+   * positive. Each session hashes to one small group of worker threads, so the repeated
+   * queries of a session reuse warm instruction caches and allocator arenas instead of
+   * bouncing across the whole shared pool.
+   */
+  void setupAffinityPools();
+
   std::unique_ptr<meta::SchemaManager> schemaManager_;
   std::unique_ptr<meta::IndexManager> indexManager_;
   std::unique_ptr<storage::StorageClient> storage_;
@@ -54,6 +78,11 @@ class QueryEngine final : public boost::noncopyable, public cpp::NonMovable {
   std::unique_ptr<thread::GenericWorker> memoryMonitorThread_;
   meta::MetaClient* metaClient_{nullptr};
   CharsetInfo* charsetInfo_{nullptr};
+  // Workload class runner pools, both null unless workload isolation is enabled
+  std::shared_ptr<folly::CPUThreadPoolExecutor> lightPool_;
+  std::shared_ptr<folly::CPUThreadPoolExecutor> heavyPool_;
+  // Session affinity runner groups, empty unless session affinity is enabled
+  std::vector<std::shared_ptr<folly::CPUThreadPoolExecutor>> affinityPools_;
 };
 
 }  // namespace graph
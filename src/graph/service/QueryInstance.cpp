@@ -12,9 +12,13 @@
 #include "graph/executor/Executor.h"
 #include "graph/optimizer/OptRule.h"
 #include "graph/planner/plan/ExecutionPlan.h"
+#include "graph/planner/plan/Logic.h"
 #include "graph/planner/plan/PlanNode.h"
 #include "graph/scheduler/AsyncMsgNotifyBasedScheduler.h"
 #include "graph/scheduler/Scheduler.h"
+#include "graph/scheduler/WorkStealingScheduler.h"
+#include "graph/service/GraphFlags.h"
+#include "graph/service/QueryResultCache.h"
 #include "graph/stats/GraphStats.h"
 #include "graph/util/AstUtils.h"
 #include "graph/validator/Validator.h"
@@ -22,6 +26,8 @@
 #include "parser/Sentence.h"
 #include "parser/SequentialSentences.h"
 
+DECLARE_bool(enable_work_stealing_scheduler);
+
 using nebula::opt::Optimizer;
 using nebula::opt::OptRule;
 using nebula::opt::RuleSet;
@@ -29,15 +35,119 @@ using nebula::opt::RuleSet;
 namespace nebula {
 namespace graph {
 
+namespace {
+
+// Plan node kinds that mark a plan as heavy: full scans, iterative constructs and graph
+// algorithms. Everything else (point fetches, index prefix lookups, DML) stays light
+bool isHeavyKind(PlanNode::Kind kind) {
+  switch (kind) {
+    case PlanNode::Kind::kScanVertices:
+    case PlanNode::Kind::kScanEdges:
+    case PlanNode::Kind::kTagIndexFullScan:
+    case PlanNode::Kind::kEdgeIndexFullScan:
+    case PlanNode::Kind::kFulltextIndexScan:
+    case PlanNode::Kind::kLoop:
+    case PlanNode::Kind::kTraverse:
+    case PlanNode::Kind::kShortestPath:
+    case PlanNode::Kind::kBFSShortest:
+    case PlanNode::Kind::kMultiShortestPath:
+    case PlanNode::Kind::kSubgraph:
+      return true;
+    default:
+      return false;
+  }
+}
+
+bool containsHeavyNode(const PlanNode *node, std::unordered_set<int64_t> &visited) {
+  if (node == nullptr || !visited.emplace(node->id()).second) {
+    return false;
+  }
+  if (isHeavyKind(node->kind())) {
+    return true;
+  }
+  if (node->kind() == PlanNode::Kind::kSelect) {
+    auto *select = static_cast<const Select *>(node);
+    if (containsHeavyNode(select->then(), visited) ||
+        containsHeavyNode(select->otherwise(), visited)) {
+      return true;
+    }
+  }
+  for (size_t i = 0; i < node->numDeps(); ++i) {
+    if (containsHeavyNode(node->dep(i), visited)) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Plan node kinds whose success makes previously cached results of the space stale
+bool isMutationKind(PlanNode::Kind kind) {
+  switch (kind) {
+    case PlanNode::Kind::kInsertVertices:
+    case PlanNode::Kind::kInsertEdges:
+    case PlanNode::Kind::kDeleteVertices:
+    case PlanNode::Kind::kDeleteEdges:
+    case PlanNode::Kind::kDeleteTags:
+    case PlanNode::Kind::kUpdateVertex:
+    case PlanNode::Kind::kUpdateEdge:
+    case PlanNode::Kind::kAlterTag:
+    case PlanNode::Kind::kAlterEdge:
+    case PlanNode::Kind::kDropTag:
+    case PlanNode::Kind::kDropEdge:
+    case PlanNode::Kind::kDropSpace:
+    case PlanNode::Kind::kClearSpace:
+    // Submitted jobs may ingest data, be conservative
+    case PlanNode::Kind::kSubmitJob:
+      return true;
+    default:
+      return false;
+  }
+}
+
+// Walk the plan once to decide how it interacts with the result cache: a plan made of
+// query nodes only is cacheable, a plan touching any mutation kind invalidates the space
+void analyzePlanForCache(const PlanNode *node,
+                         std::unordered_set<int64_t> &visited,
+                         bool &allQueryNodes,
+                         bool &mutates) {
+  if (node == nullptr || !visited.emplace(node->id()).second) {
+    return;
+  }
+  if (!node->isQueryNode()) {
+    allQueryNodes = false;
+  }
+  if (isMutationKind(node->kind())) {
+    mutates = true;
+  }
+  if (node->kind() == PlanNode::Kind::kSelect) {
+    auto *select = static_cast<const Select *>(node);
+    analyzePlanForCache(select->then(), visited, allQueryNodes, mutates);
+    analyzePlanForCache(select->otherwise(), visited, allQueryNodes, mutates);
+  }
+  for (size_t i = 0; i < node->numDeps(); ++i) {
+    analyzePlanForCache(node->dep(i), visited, allQueryNodes, mutates);
+  }
+}
+
+}  // namespace
+
 QueryInstance::QueryInstance(std::unique_ptr<QueryContext> qctx, Optimizer *optimizer) {
   qctx_ = std::move(qctx);
   optimizer_ = DCHECK_NOTNULL(optimizer);
-  scheduler_ = std::make_unique<AsyncMsgNotifyBasedScheduler>(qctx_.get());
+  if (FLAGS_enable_work_stealing_scheduler) {
+    scheduler_ = std::make_unique<WorkStealingScheduler>(qctx_.get());
+  } else {
+    scheduler_ = std::make_unique<AsyncMsgNotifyBasedScheduler>(qctx_.get());
+  }
   qctx_->rctx()->session()->addQuery(qctx_.get());
 }
 
 void QueryInstance::execute() {
   try {
+    if (FLAGS_enable_query_result_cache && tryServeFromCache()) {
+      return;
+    }
+
     Status status = validateAndOptimize();
     if (!status.ok()) {
       onError(std::move(status));
@@ -50,6 +160,8 @@ void QueryInstance::execute() {
       return;
     }
 
+    classifyWorkload();
+
     // The execution engine converts the physical execution plan generated by the Planner into a
     // series of Executors through the Scheduler to drive the execution of the Executors.
     scheduler_->schedule()
@@ -79,8 +191,12 @@ Status QueryInstance::validateAndOptimize() {
   auto &spaceName = rctx->session()->space().name;
   VLOG(1) << "Parsing query: " << rctx->query();
   // Result of parsing, get the parsing tree
-  auto result = GQLParser(qctx()).parse(rctx->query());
+  GQLParser parser(qctx());
+  auto result = parser.parse(rctx->query());
   NG_RETURN_IF_ERROR(result);
+  if (parser.usedFastPath()) {
+    stats::StatsManager::addValue(kNumFastPathParses);
+  }
   sentence_ = std::move(result).value();
   if (sentence_->kind() == Sentence::Kind::kSequential) {
     size_t num = static_cast<const SequentialSentences *>(sentence_.get())->numSentences();
@@ -98,7 +214,10 @@ Status QueryInstance::validateAndOptimize() {
   }
 
   // Validate the query, if failed, return
-  NG_RETURN_IF_ERROR(Validator::validate(sentence_.get(), qctx()));
+  {
+    SCOPED_TIMER(qctx_->plan()->validateTimeInUs());
+    NG_RETURN_IF_ERROR(Validator::validate(sentence_.get(), qctx()));
+  }
   // Optimize the query, and get the execution plan. We should not pass the optimizer errors to user
   // since the message is often not easy to understand. Logging them is enough.
   if (auto status = findBestPlan(); !status.ok()) {
@@ -113,6 +232,63 @@ Status QueryInstance::validateAndOptimize() {
   return Status::OK();
 }
 
+bool QueryInstance::tryServeFromCache() {
+  auto *rctx = qctx_->rctx();
+  cacheSpaceId_ = rctx->session()->space().id;
+  if (cacheSpaceId_ <= 0) {
+    return false;
+  }
+  cacheKey_ =
+      QueryResultCache::makeKey(rctx->session()->user(), rctx->query(), rctx->parameterMap());
+  DataSet cached;
+  if (!QueryResultCache::instance()->get(cacheSpaceId_, cacheKey_, &cached)) {
+    return false;
+  }
+  VLOG(1) << "Serve query from result cache: " << rctx->query();
+  auto &resp = rctx->resp();
+  resp.spaceName = std::make_unique<std::string>(rctx->session()->space().name);
+  resp.data = std::make_unique<DataSet>(std::move(cached));
+  resp.latencyInUs = rctx->duration().elapsedInUSec();
+  rctx->finish();
+  rctx->session()->deleteQuery(qctx_.get());
+  // Nothing was scheduled, so no async sub-task can reach this instance anymore
+  delete this;
+  return true;
+}
+
+void QueryInstance::updateResultCache() {
+  if (cacheSpaceId_ <= 0) {
+    return;
+  }
+  bool allQueryNodes = true;
+  bool mutates = false;
+  std::unordered_set<int64_t> visited;
+  analyzePlanForCache(qctx_->plan()->root(), visited, allQueryNodes, mutates);
+  if (mutates) {
+    QueryResultCache::instance()->invalidate(cacheSpaceId_);
+    return;
+  }
+  auto &resp = qctx_->rctx()->resp();
+  // Explained/profiled, paged or not purely read-only results are not cacheable
+  if (!allQueryNodes || resp.errorCode != ErrorCode::SUCCEEDED || resp.data == nullptr ||
+      resp.cursor != nullptr || resp.planDesc != nullptr) {
+    return;
+  }
+  QueryResultCache::instance()->put(cacheSpaceId_, cacheKey_, *resp.data);
+}
+
+void QueryInstance::classifyWorkload() {
+  auto *light = qctx_->lightRunner();
+  auto *heavy = qctx_->heavyRunner();
+  if (light == nullptr || heavy == nullptr) {
+    return;
+  }
+  std::unordered_set<int64_t> visited;
+  bool isHeavy = containsHeavyNode(qctx_->plan()->root(), visited);
+  qctx_->rctx()->setRunner(isHeavy ? heavy : light);
+  VLOG(1) << "Query classified as " << (isHeavy ? "heavy" : "light") << " workload";
+}
+
 bool QueryInstance::explainOrContinue() {
   if (sentence_->kind() != Sentence::Kind::kExplain) {
     return true;
@@ -131,6 +307,10 @@ void QueryInstance::onFinish() {
 
   fillRespData(&rctx->resp());
 
+  if (FLAGS_enable_query_result_cache) {
+    updateResultCache();
+  }
+
   auto latency = rctx->duration().elapsedInUSec();
   rctx->resp().latencyInUs = latency;
   addSlowQueryStats(latency, spaceName);
@@ -243,6 +423,20 @@ void QueryInstance::fillRespData(ExecutionResponse *resp) {
   // Fill dataset
   auto result = value.moveDataSet();
   if (!result.colNames.empty()) {
+    if (FLAGS_cursor_page_rows > 0 &&
+        result.rows.size() > static_cast<size_t>(FLAGS_cursor_page_rows)) {
+      // Keep only the first page in the response and park the rest on the session, so a
+      // huge result is never serialized in one piece. The client walks the remainder with
+      // fetchCursor().
+      DataSet rest(result.colNames);
+      rest.rows.reserve(result.rows.size() - FLAGS_cursor_page_rows);
+      std::move(result.rows.begin() + FLAGS_cursor_page_rows,
+                result.rows.end(),
+                std::back_inserter(rest.rows));
+      result.rows.resize(FLAGS_cursor_page_rows);
+      auto cursorId = qctx_->rctx()->session()->addCursor(std::move(rest));
+      resp->cursor = std::make_unique<int64_t>(cursorId);
+    }
     resp->data = std::make_unique<DataSet>(std::move(result));
   } else {
     resp->errorCode = ErrorCode::E_EXECUTION_ERROR;
@@ -52,6 +52,29 @@ class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
   void onError(Status);
 
   Status validateAndOptimize();
+
+  /**
+   * @brief Pick the runner pool of this query by its workload class. The plan is classified
+   * as heavy when it contains full scans, loops or graph algorithms; everything else stays
+   * on the light pool. No-op unless workload isolation is enabled, see
+   * FLAGS_num_heavy_query_threads
+   */
+  void classifyWorkload();
+
+  /**
+   * @brief Try to answer the query from the result cache before it is even parsed. On a
+   * hit the response is filled and this instance is released, see FLAGS_enable_query_result_cache
+   *
+   * @return Whether the query was served from the cache
+   */
+  bool tryServeFromCache();
+
+  /**
+   * @brief After a successful execution, either cache the result (read-only statements) or
+   * invalidate the space's cached results (mutations)
+   */
+  void updateResultCache();
+
   // Return true if continue to execute
   bool explainOrContinue();
   void addSlowQueryStats(uint64_t latency, const std::string& spaceName) const;
@@ -59,6 +82,10 @@ class QueryInstance final : public boost::noncopyable, public cpp::NonMovable {
   Status findBestPlan();
 
   std::unique_ptr<Sentence> sentence_;
+  // Result cache key of this query, kept from the lookup so the finish path can fill the
+  // cache without rebuilding it
+  std::string cacheKey_;
+  GraphSpaceID cacheSpaceId_{-1};
   std::unique_ptr<QueryContext> qctx_;
   std::unique_ptr<Scheduler> scheduler_;
   opt::Optimizer* optimizer_{nullptr};
@@ -0,0 +1,86 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/service/QueryResultCache.h"
+
+#include "common/time/WallClock.h"
+
+DEFINE_bool(enable_query_result_cache,
+            false,
+            "Whether to cache the results of read-only statements, so identical queries "
+            "against unchanged data are answered without planning and execution");
+DEFINE_uint64(query_result_cache_capacity, 1024, "Max number of cached query results");
+DEFINE_int32(query_result_cache_ttl_secs,
+             10,
+             "Seconds a cached query result stays valid. Writes issued through other graphd "
+             "processes become visible at latest after this interval");
+
+namespace nebula {
+namespace graph {
+
+QueryResultCache* QueryResultCache::instance() {
+  static QueryResultCache cache;
+  return &cache;
+}
+
+QueryResultCache::QueryResultCache()
+    : cache_(std::max<uint64_t>(FLAGS_query_result_cache_capacity, 1 << 5)) {}
+
+std::string QueryResultCache::makeKey(const std::string& user,
+                                      const std::string& query,
+                                      const std::unordered_map<std::string, Value>& params) {
+  std::string key;
+  key.reserve(user.size() + query.size() + 1);
+  key.append(user).append(1, '\0').append(query);
+  if (!params.empty()) {
+    // Sort the names so that the same parameter map always yields the same key
+    std::vector<std::string> names;
+    names.reserve(params.size());
+    for (auto& param : params) {
+      names.emplace_back(param.first);
+    }
+    std::sort(names.begin(), names.end());
+    for (auto& name : names) {
+      key.append(1, '\0').append(name).append(1, '=').append(params.at(name).toString());
+    }
+  }
+  return key;
+}
+
+bool QueryResultCache::get(GraphSpaceID spaceId, const std::string& key, DataSet* result) {
+  auto ret = cache_.get(key);
+  if (!ret.ok()) {
+    return false;
+  }
+  auto entry = std::move(ret).value();
+  if (entry->expireAt < time::WallClock::fastNowInSec() || entry->epoch != spaceEpoch(spaceId)) {
+    cache_.evict(key);
+    return false;
+  }
+  *result = entry->data;
+  return true;
+}
+
+void QueryResultCache::put(GraphSpaceID spaceId, const std::string& key, DataSet result) {
+  auto entry = std::make_shared<Entry>();
+  entry->data = std::move(result);
+  entry->expireAt = time::WallClock::fastNowInSec() + FLAGS_query_result_cache_ttl_secs;
+  entry->epoch = spaceEpoch(spaceId);
+  cache_.insert(key, std::move(entry));
+}
+
+void QueryResultCache::invalidate(GraphSpaceID spaceId) {
+  std::lock_guard<std::mutex> guard(epochLock_);
+  ++epochs_[spaceId];
+}
+
+uint64_t QueryResultCache::spaceEpoch(GraphSpaceID spaceId) {
+  std::lock_guard<std::mutex> guard(epochLock_);
+  auto it = epochs_.find(spaceId);
+  return it == epochs_.end() ? 0 : it->second;
+}
+
+}  // namespace graph
+}  // namespace nebula
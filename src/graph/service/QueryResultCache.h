@@ -0,0 +1,76 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_SERVICE_QUERYRESULTCACHE_H_
+#define GRAPH_SERVICE_QUERYRESULTCACHE_H_
+
+#include "common/base/Base.h"
+#include "common/base/ConcurrentLRUCache.h"
+#include "common/datatypes/DataSet.h"
+#include "common/datatypes/Value.h"
+#include "common/thrift/ThriftTypes.h"
+
+DECLARE_bool(enable_query_result_cache);
+
+namespace nebula {
+namespace graph {
+
+/**
+ * @brief Result cache for read-only statements, serving dashboards which re-run identical
+ * queries every few seconds against rarely changing data. Entries are keyed by
+ * (user, space, query text, parameters) and expire after FLAGS_query_result_cache_ttl_secs.
+ * Any mutation executed through this graphd invalidates the whole space eagerly; writes
+ * issued through other graphds are only bounded by the TTL. Opt-in, see
+ * FLAGS_enable_query_result_cache.
+ */
+class QueryResultCache final {
+ public:
+  static QueryResultCache* instance();
+
+  /**
+   * @brief Build the cache key of a statement. The user is part of the key so that a
+   * cache hit never bypasses a permission check the validator would have failed.
+   */
+  static std::string makeKey(const std::string& user,
+                             const std::string& query,
+                             const std::unordered_map<std::string, Value>& params);
+
+  /**
+   * @brief Look up a cached result. Return true and fill result on a fresh hit, false on a
+   * miss or when the entry is stale (expired or written after a space invalidation).
+   */
+  bool get(GraphSpaceID spaceId, const std::string& key, DataSet* result);
+
+  /**
+   * @brief Cache the result of a successfully finished read-only statement.
+   */
+  void put(GraphSpaceID spaceId, const std::string& key, DataSet result);
+
+  /**
+   * @brief Drop all entries of the given space, called after a mutation in it succeeds.
+   */
+  void invalidate(GraphSpaceID spaceId);
+
+ private:
+  QueryResultCache();
+
+  struct Entry {
+    DataSet data;
+    int64_t expireAt;
+    uint64_t epoch;
+  };
+
+  uint64_t spaceEpoch(GraphSpaceID spaceId);
+
+  ConcurrentLRUCache<std::string, std::shared_ptr<Entry>> cache_;
+  // Bumped on every invalidation, entries written under an older epoch are ignored. This
+  // keeps invalidate() O(1) instead of walking the lru buckets
+  std::mutex epochLock_;
+  std::unordered_map<GraphSpaceID, uint64_t> epochs_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_SERVICE_QUERYRESULTCACHE_H_
@@ -15,6 +15,7 @@ namespace graph {
 ClientSession::ClientSession(meta::cpp2::Session&& session, meta::MetaClient* metaClient) {
   session_ = std::move(session);
   metaClient_ = metaClient;
+  lastActiveTimeUs_.store(time::WallClock::fastNowInMicroSec(), std::memory_order_relaxed);
 }
 
 std::shared_ptr<ClientSession> ClientSession::create(meta::cpp2::Session&& session,
@@ -23,14 +24,15 @@ std::shared_ptr<ClientSession> ClientSession::create(meta::cpp2::Session&& sessi
 }
 
 void ClientSession::charge() {
-  folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
-  idleDuration_.reset();
-  session_.update_time_ref() = time::WallClock::fastNowInMicroSec();
+  // This runs on every query of every session, a plain relaxed store keeps it off
+  // the session spin lock
+  lastActiveTimeUs_.store(time::WallClock::fastNowInMicroSec(), std::memory_order_relaxed);
 }
 
 uint64_t ClientSession::idleSeconds() {
-  folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
-  return idleDuration_.elapsedInSec();
+  auto idleUs =
+      time::WallClock::fastNowInMicroSec() - lastActiveTimeUs_.load(std::memory_order_relaxed);
+  return idleUs <= 0 ? 0 : static_cast<uint64_t>(idleUs) / 1000000;
 }
 
 void ClientSession::addQuery(QueryContext* qctx) {
@@ -104,5 +106,43 @@ void ClientSession::markAllQueryKilled() {
         contexts_.size());
   }
 }
+
+int64_t ClientSession::addCursor(DataSet&& rest) {
+  folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
+  if (cursors_.size() >= kMaxCursors) {
+    // Ids grow monotonically, so the smallest one is the oldest cursor
+    auto oldest = std::min_element(cursors_.begin(), cursors_.end(), [](auto& l, auto& r) {
+      return l.first < r.first;
+    });
+    cursors_.erase(oldest);
+  }
+  auto id = nextCursorId_++;
+  cursors_.emplace(id, std::move(rest));
+  return id;
+}
+
+StatusOr<DataSet> ClientSession::nextCursorPage(int64_t cursorId,
+                                                int64_t pageRows,
+                                                bool* hasMore) {
+  folly::RWSpinLock::WriteHolder wHolder(rwSpinLock_);
+  auto iter = cursors_.find(cursorId);
+  if (iter == cursors_.end()) {
+    return Status::Error("Cursor %ld does not exist or has expired", cursorId);
+  }
+  auto& rest = iter->second;
+  if (pageRows <= 0 || rest.rows.size() <= static_cast<size_t>(pageRows)) {
+    DataSet page = std::move(rest);
+    cursors_.erase(iter);
+    *hasMore = false;
+    return page;
+  }
+  DataSet page(rest.colNames);
+  page.rows.reserve(pageRows);
+  std::move(rest.rows.begin(), rest.rows.begin() + pageRows, std::back_inserter(page.rows));
+  rest.rows.erase(rest.rows.begin(), rest.rows.begin() + pageRows);
+  *hasMore = true;
+  return page;
+}
+
 }  // namespace graph
 }  // namespace nebula
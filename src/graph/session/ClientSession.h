@@ -6,7 +6,7 @@
 #define GRAPH_SESSION_CLIENTSESSION_H_
 
 #include "clients/meta/MetaClient.h"
-#include "common/time/Duration.h"
+#include "common/datatypes/DataSet.h"
 #include "interface/gen-cpp2/meta_types.h"
 
 namespace nebula {
@@ -132,8 +132,14 @@ class ClientSession final {
   }
 
   meta::cpp2::Session getSession() const {
-    folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
-    return session_;
+    meta::cpp2::Session copy;
+    {
+      folly::RWSpinLock::ReadHolder rHolder(rwSpinLock_);
+      copy = session_;
+    }
+    // The touch time is maintained outside the lock, fold it into the copy
+    copy.update_time_ref() = lastActiveTimeUs_.load(std::memory_order_relaxed);
+    return copy;
   }
 
   void updateSpaceName(const std::string& spaceName) {
@@ -160,6 +166,21 @@ class ClientSession final {
   // Marks all queries as killed.
   void markAllQueryKilled();
 
+  // Stashes the unsent remainder of a paged result and returns the cursor id the client
+  // fetches it with, see FLAGS_cursor_page_rows. At most kMaxCursors cursors are kept per
+  // session, the oldest one is dropped when the cap is hit.
+  int64_t addCursor(DataSet&& rest);
+
+  // Pops the next page (up to pageRows rows, everything left when pageRows <= 0) off the
+  // cursor. Sets *hasMore and drops the cursor once it is exhausted.
+  StatusOr<DataSet> nextCursorPage(int64_t cursorId, int64_t pageRows, bool* hasMore);
+
+  // Tracked bytes held across all queries of the session, charged by the memory tracker
+  // while an executor of one of its queries runs under a MemoryScopeGuard
+  std::atomic<int64_t>* memoryUsed() {
+    return &memoryUsed_;
+  }
+
  private:
   ClientSession() = default;
 
@@ -167,9 +188,10 @@ class ClientSession final {
 
  private:
   SpaceInfo space_;  // The space that the session is using.
-  // When the idle time exceeds FLAGS_session_idle_timeout_secs,
-  // the session will expire and then be reclaimed.
-  time::Duration idleDuration_;
+  // Wall clock time in us of the last query on the session. When the idle time exceeds
+  // FLAGS_session_idle_timeout_secs, the session will expire and then be reclaimed.
+  // Atomic instead of guarded by rwSpinLock_ because charge() runs on every query.
+  std::atomic<int64_t> lastActiveTimeUs_{0};
   meta::cpp2::Session session_;            // The session object used in RPC.
   meta::MetaClient* metaClient_{nullptr};  // The client of the meta server.
   mutable folly::RWSpinLock rwSpinLock_;
@@ -181,6 +203,13 @@ class ClientSession final {
   // An ExecutionPlanID represents a query.
   // A QueryContext also represents a query.
   std::unordered_map<ExecutionPlanID, QueryContext*> contexts_;
+  std::atomic<int64_t> memoryUsed_{0};
+
+  static constexpr size_t kMaxCursors = 8;
+  // Unsent remainders of paged results keyed by cursor id. Dying with the session is
+  // what bounds their lifetime, there is no separate expiry.
+  std::unordered_map<int64_t, DataSet> cursors_;
+  int64_t nextCursorId_{1};
 };
 
 }  // namespace graph
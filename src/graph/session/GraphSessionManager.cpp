@@ -285,13 +285,23 @@ void GraphSessionManager::updateSessionsToMeta() {
     removeSessionFromLocalCache(killSessions);
   };
 
-  auto result = metaClient_->updateSessions(sessions).get();
-  if (!result.ok()) {
-    LOG(ERROR) << "Update sessions failed: " << result.status();
-    return;
+  // Send the update in batches so one huge RPC does not stall the scavenger round,
+  // a failed batch does not block the remaining ones from refreshing their sessions
+  auto batchSize = FLAGS_session_update_batch_size > 0
+                       ? static_cast<size_t>(FLAGS_session_update_batch_size)
+                       : sessions.size();
+  for (size_t from = 0; from < sessions.size(); from += batchSize) {
+    auto to = std::min(sessions.size(), from + batchSize);
+    std::vector<meta::cpp2::Session> batch(std::make_move_iterator(sessions.begin() + from),
+                                           std::make_move_iterator(sessions.begin() + to));
+    auto result = metaClient_->updateSessions(batch).get();
+    if (!result.ok()) {
+      LOG(ERROR) << "Update sessions failed: " << result.status();
+      continue;
+    }
+    handleKilledQueries(result);
+    handleKilledSessions(result);
   }
-  handleKilledQueries(result);
-  handleKilledSessions(result);
 }
 
 void GraphSessionManager::updateSessionInfo(ClientSession* session) {
@@ -23,6 +23,7 @@ stats::CounterId kNumSlowQueries;
 stats::CounterId kNumQueryErrors;
 stats::CounterId kNumQueryErrorsLeaderChanges;
 stats::CounterId kNumSentences;
+stats::CounterId kNumFastPathParses;
 stats::CounterId kQueryLatencyUs;
 stats::CounterId kSlowQueryLatencyUs;
 stats::CounterId kNumKilledQueries;
@@ -46,6 +47,7 @@ void initGraphStats() {
   kNumActiveQueries = stats::StatsManager::registerStats("num_active_queries", "sum");
   kNumSlowQueries = stats::StatsManager::registerStats("num_slow_queries", "rate, sum");
   kNumSentences = stats::StatsManager::registerStats("num_sentences", "rate, sum");
+  kNumFastPathParses = stats::StatsManager::registerStats("num_fast_path_parses", "rate, sum");
   kNumQueryErrors = stats::StatsManager::registerStats("num_query_errors", "rate, sum");
   kNumQueryErrorsLeaderChanges =
       stats::StatsManager::registerStats("num_query_errors_leader_changes", "rate, sum");
@@ -23,6 +23,9 @@ extern stats::CounterId kNumQueryErrors;
 extern stats::CounterId kNumQueryErrorsLeaderChanges;
 // A sequential sentence is treated as multiple sentences separated by `;`
 extern stats::CounterId kNumSentences;
+// Queries answered by the fast-path recognizer instead of the bison parser, see
+// FLAGS_enable_fast_parser. Hit rate = num_fast_path_parses / num_queries
+extern stats::CounterId kNumFastPathParses;
 extern stats::CounterId kQueryLatencyUs;
 extern stats::CounterId kSlowQueryLatencyUs;
 extern stats::CounterId kNumKilledQueries;
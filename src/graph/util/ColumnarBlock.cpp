@@ -0,0 +1,170 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/util/ColumnarBlock.h"
+
+#include <folly/lang/Bits.h>
+
+#include <cstring>
+
+#include "common/base/Logging.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+// Order-preserving transforms into big-endian unsigned words, the usual key
+// normalization tricks: flip the sign bit for two's complement ints; for doubles flip
+// everything on negatives and only the sign bit on positives
+inline uint64_t encodeInt(int64_t v) {
+  return folly::Endian::big(static_cast<uint64_t>(v) ^ (1ULL << 63));
+}
+
+inline uint64_t encodeFloat(double d) {
+  uint64_t bits;
+  std::memcpy(&bits, &d, sizeof(bits));
+  if (bits & (1ULL << 63)) {
+    bits = ~bits;
+  } else {
+    bits |= (1ULL << 63);
+  }
+  return folly::Endian::big(bits);
+}
+
+}  // namespace
+
+std::optional<ColumnarBlock> ColumnarBlock::extract(std::vector<Row>::const_iterator begin,
+                                                    std::vector<Row>::const_iterator end,
+                                                    const std::vector<size_t>& colIndices) {
+  ColumnarBlock block;
+  block.numRows_ = std::distance(begin, end);
+  if (block.numRows_ == 0) {
+    return std::nullopt;
+  }
+  block.cols_.resize(colIndices.size());
+
+  for (size_t c = 0; c < colIndices.size(); ++c) {
+    auto colIdx = colIndices[c];
+    if (colIdx >= begin->values.size()) {
+      return std::nullopt;
+    }
+    auto& col = block.cols_[c];
+    // The first row fixes the column type, every other row must match it
+    switch ((*begin)[colIdx].type()) {
+      case Value::Type::INT:
+        col.type = ColType::kInt;
+        col.ints.reserve(block.numRows_);
+        break;
+      case Value::Type::FLOAT:
+        col.type = ColType::kFloat;
+        col.floats.reserve(block.numRows_);
+        break;
+      case Value::Type::STRING:
+        col.type = ColType::kString;
+        col.strings.reserve(block.numRows_);
+        break;
+      case Value::Type::BOOL:
+        col.type = ColType::kBool;
+        col.bools.reserve(block.numRows_);
+        break;
+      default:
+        return std::nullopt;
+    }
+    for (auto it = begin; it != end; ++it) {
+      const auto& cell = (*it)[colIdx];
+      switch (col.type) {
+        case ColType::kInt:
+          if (!cell.isInt()) {
+            return std::nullopt;
+          }
+          col.ints.emplace_back(cell.getInt());
+          break;
+        case ColType::kFloat:
+          if (!cell.isFloat()) {
+            return std::nullopt;
+          }
+          col.floats.emplace_back(cell.getFloat());
+          break;
+        case ColType::kString:
+          if (!cell.isStr()) {
+            return std::nullopt;
+          }
+          col.strings.emplace_back(&cell.getStr());
+          break;
+        case ColType::kBool:
+          if (!cell.isBool()) {
+            return std::nullopt;
+          }
+          col.bools.emplace_back(cell.getBool());
+          break;
+      }
+    }
+  }
+  return block;
+}
+
+std::optional<std::vector<uint8_t>> ColumnarBlock::normalizeKeys(
+    const std::vector<bool>& descending, size_t* strideOut) const {
+  DCHECK_EQ(descending.size(), cols_.size());
+  size_t stride = 0;
+  for (const auto& col : cols_) {
+    switch (col.type) {
+      case ColType::kInt:
+      case ColType::kFloat:
+        stride += sizeof(uint64_t);
+        break;
+      case ColType::kBool:
+        stride += 1;
+        break;
+      case ColType::kString:
+        return std::nullopt;
+    }
+  }
+
+  std::vector<uint8_t> keys(stride * numRows_);
+  size_t offset = 0;
+  for (size_t c = 0; c < cols_.size(); ++c) {
+    const auto& col = cols_[c];
+    uint8_t* out = keys.data() + offset;
+    switch (col.type) {
+      case ColType::kInt:
+        for (size_t r = 0; r < numRows_; ++r, out += stride) {
+          auto word = encodeInt(col.ints[r]);
+          std::memcpy(out, &word, sizeof(word));
+        }
+        offset += sizeof(uint64_t);
+        break;
+      case ColType::kFloat:
+        for (size_t r = 0; r < numRows_; ++r, out += stride) {
+          auto word = encodeFloat(col.floats[r]);
+          std::memcpy(out, &word, sizeof(word));
+        }
+        offset += sizeof(uint64_t);
+        break;
+      case ColType::kBool:
+        for (size_t r = 0; r < numRows_; ++r, out += stride) {
+          *out = col.bools[r];
+        }
+        offset += 1;
+        break;
+      case ColType::kString:
+        return std::nullopt;
+    }
+    if (descending[c]) {
+      size_t width = col.type == ColType::kBool ? 1 : sizeof(uint64_t);
+      uint8_t* cell = keys.data() + offset - width;
+      for (size_t r = 0; r < numRows_; ++r, cell += stride) {
+        for (size_t b = 0; b < width; ++b) {
+          cell[b] = ~cell[b];
+        }
+      }
+    }
+  }
+  *strideOut = stride;
+  return keys;
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,102 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_UTIL_COLUMNARBLOCK_H_
+#define GRAPH_UTIL_COLUMNARBLOCK_H_
+
+#include <optional>
+
+#include "common/datatypes/DataSet.h"
+
+namespace nebula {
+namespace graph {
+
+/**
+ * Column-major view over the key columns of a row block. Sort-style executors compare
+ * the same few columns across every row; pulling those columns into typed vectors up
+ * front lets the hot loop compare plain int64_t/double/string values instead of going
+ * through Value's per-cell type dispatch on every comparison.
+ *
+ * The block only borrows from the rows it was extracted from: string cells are kept as
+ * pointers into the original Values. It must therefore be fully consumed before the
+ * rows are moved or destroyed.
+ */
+class ColumnarBlock final {
+ public:
+  enum class ColType : uint8_t {
+    kInt,
+    kFloat,
+    kString,
+    kBool,
+  };
+
+  struct Column {
+    ColType type;
+    std::vector<int64_t> ints;
+    std::vector<double> floats;
+    std::vector<const std::string*> strings;
+    std::vector<uint8_t> bools;
+  };
+
+  /**
+   * Extract the given columns from [begin, end). Returns std::nullopt when any cell is
+   * not a non-null scalar of its column's uniform type; callers must then keep the
+   * row-wise path. Bailing instead of widening keeps Value's cross-type and null
+   * ordering rules out of the typed loops entirely, so both paths order identically.
+   */
+  static std::optional<ColumnarBlock> extract(std::vector<Row>::const_iterator begin,
+                                              std::vector<Row>::const_iterator end,
+                                              const std::vector<size_t>& colIndices);
+
+  size_t numRows() const {
+    return numRows_;
+  }
+
+  /**
+   * Encode the extracted columns into one contiguous byte string per row such that
+   * memcmp over the strings orders rows exactly like compareAt over every column in
+   * extraction order. Descending columns are stored bit-inverted, so one memcmp handles
+   * mixed ASC/DESC factor lists. Returns std::nullopt when a column is a string --
+   * variable-length keys don't normalize into a fixed stride -- and writes the per-row
+   * key width to `strideOut` otherwise.
+   */
+  std::optional<std::vector<uint8_t>> normalizeKeys(const std::vector<bool>& descending,
+                                                    size_t* strideOut) const;
+
+  // Three-way comparison of rows l and r on extracted column c. `c` indexes the
+  // extraction list, not the original dataset.
+  int compareAt(size_t c, size_t l, size_t r) const {
+    const auto& col = cols_[c];
+    switch (col.type) {
+      case ColType::kInt:
+        return threeWay(col.ints[l], col.ints[r]);
+      case ColType::kFloat:
+        return threeWay(col.floats[l], col.floats[r]);
+      case ColType::kString:
+        return threeWay(*col.strings[l], *col.strings[r]);
+      case ColType::kBool:
+        return threeWay(col.bools[l], col.bools[r]);
+    }
+    return 0;
+  }
+
+ private:
+  template <typename T>
+  static int threeWay(const T& l, const T& r) {
+    if (l < r) {
+      return -1;
+    }
+    if (r < l) {
+      return 1;
+    }
+    return 0;
+  }
+
+  size_t numRows_{0};
+  std::vector<Column> cols_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+#endif  // GRAPH_UTIL_COLUMNARBLOCK_H_
@@ -0,0 +1,113 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/util/PerfCounters.h"
+
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <cstring>
+
+#include "common/memory/MemoryTracker.h"
+#include "graph/executor/Executor.h"
+
+DEFINE_bool(enable_profile_hardware_counters,
+            false,
+            "Sample cpu cycles and cache misses per executor through perf_event and attach them "
+            "to the PROFILE output, needs perf_event access on the host");
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+// The counter pair of one scheduler thread, opened on first use and kept for the thread's
+// lifetime so scoping an executor costs two ioctls and two reads
+struct ThreadCounters {
+  int cyclesFd{-1};
+  int cacheMissFd{-1};
+
+  ThreadCounters() {
+    cyclesFd = open(PERF_COUNT_HW_CPU_CYCLES);
+    cacheMissFd = open(PERF_COUNT_HW_CACHE_MISSES);
+  }
+
+  ~ThreadCounters() {
+    if (cyclesFd >= 0) {
+      ::close(cyclesFd);
+    }
+    if (cacheMissFd >= 0) {
+      ::close(cacheMissFd);
+    }
+  }
+
+  static int open(uint64_t config) {
+    struct perf_event_attr attr;
+    ::memset(&attr, 0, sizeof(attr));
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = 1;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    int fd = ::syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0) {
+      LOG_FIRST_N(WARNING, 1) << "perf_event_open failed: " << ::strerror(errno)
+                              << ", hardware counters will not be recorded";
+    }
+    return fd;
+  }
+
+  bool valid() const {
+    return cyclesFd >= 0 && cacheMissFd >= 0;
+  }
+
+  void start() {
+    ::ioctl(cyclesFd, PERF_EVENT_IOC_RESET, 0);
+    ::ioctl(cacheMissFd, PERF_EVENT_IOC_RESET, 0);
+    ::ioctl(cyclesFd, PERF_EVENT_IOC_ENABLE, 0);
+    ::ioctl(cacheMissFd, PERF_EVENT_IOC_ENABLE, 0);
+  }
+
+  std::pair<int64_t, int64_t> stop() {
+    ::ioctl(cyclesFd, PERF_EVENT_IOC_DISABLE, 0);
+    ::ioctl(cacheMissFd, PERF_EVENT_IOC_DISABLE, 0);
+    int64_t cycles = -1;
+    int64_t misses = -1;
+    if (::read(cyclesFd, &cycles, sizeof(cycles)) != sizeof(cycles)) {
+      cycles = -1;
+    }
+    if (::read(cacheMissFd, &misses, sizeof(misses)) != sizeof(misses)) {
+      misses = -1;
+    }
+    return {cycles, misses};
+  }
+};
+
+thread_local ThreadCounters threadCounters;
+
+}  // namespace
+
+PerfCounterScope::PerfCounterScope(Executor* executor) {
+  if (!FLAGS_enable_profile_hardware_counters || !threadCounters.valid()) {
+    return;
+  }
+  executor_ = executor;
+  allocatedStart_ = memory::MemoryStats::threadAllocatedBytes();
+  threadCounters.start();
+}
+
+PerfCounterScope::~PerfCounterScope() {
+  if (executor_ == nullptr) {
+    return;
+  }
+  auto [cycles, misses] = threadCounters.stop();
+  executor_->addPerfStats(
+      cycles, misses, memory::MemoryStats::threadAllocatedBytes() - allocatedStart_);
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -0,0 +1,40 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_UTIL_PERFCOUNTERS_H_
+#define GRAPH_UTIL_PERFCOUNTERS_H_
+
+#include <cstdint>
+
+namespace nebula {
+namespace graph {
+
+class Executor;
+
+// Samples the cpu cycles, cache misses and tracked allocation bytes an executor burns on the
+// scheduler thread, through per-thread perf_event counters opened lazily per thread. The
+// sample is attached to the executor's profiling stats and shows up in the PROFILE output, so
+// a slow plan node can be told apart as compute bound, cache bound or allocation heavy.
+//
+// Opt-in via --enable_profile_hardware_counters; when the flag is off or perf_event is not
+// available (e.g. kernel.perf_event_paranoid too strict in a container) the scope is a no-op.
+// Only the synchronous part of Executor::execute() is covered, async continuations like
+// storage RPC handling are not attributed.
+class PerfCounterScope final {
+ public:
+  explicit PerfCounterScope(Executor* executor);
+  ~PerfCounterScope();
+
+  PerfCounterScope(const PerfCounterScope&) = delete;
+  PerfCounterScope& operator=(const PerfCounterScope&) = delete;
+
+ private:
+  Executor* executor_{nullptr};
+  int64_t allocatedStart_{0};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_UTIL_PERFCOUNTERS_H_
@@ -0,0 +1,130 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include "graph/util/RowSpiller.h"
+
+#include <thrift/lib/cpp2/protocol/Serializer.h>
+#include <unistd.h>
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include "common/datatypes/ValueOps-inl.h"
+#include "common/fs/FileUtils.h"
+#include "common/memory/MemoryTracker.h"
+
+DEFINE_string(executor_spill_dir, "/tmp", "Directory where executor spill files are written");
+DEFINE_double(executor_spill_memory_ratio,
+              0.0,
+              "Spill executor intermediate rows to disk when the tracked memory usage exceeds "
+              "this ratio of the memory limit, 0 disables spilling");
+DEFINE_uint64(executor_spill_batch_rows,
+              4096,
+              "Number of rows accumulated per chunk when spilling and read back per batch when "
+              "restoring spilled data");
+
+namespace nebula {
+namespace graph {
+
+bool RowSpiller::needSpill() {
+  return FLAGS_executor_spill_memory_ratio > 0.0 &&
+         memory::MemoryStats::instance().usedRatio() > FLAGS_executor_spill_memory_ratio;
+}
+
+RowSpiller::RowSpiller(const std::string& prefix) : prefix_(prefix) {}
+
+RowSpiller::~RowSpiller() {
+  if (file_ != nullptr) {
+    ::fclose(file_);
+    ::unlink(path_.c_str());
+  }
+}
+
+Status RowSpiller::open() {
+  auto pathTemplate = fs::FileUtils::joinPath(FLAGS_executor_spill_dir, prefix_ + ".XXXXXX");
+  std::vector<char> buf(pathTemplate.begin(), pathTemplate.end());
+  buf.push_back('\0');
+  int fd = ::mkstemp(buf.data());
+  if (fd < 0) {
+    return Status::Error(
+        "Failed to create spill file %s: %s", pathTemplate.c_str(), ::strerror(errno));
+  }
+  path_ = buf.data();
+  file_ = ::fdopen(fd, "w+");
+  if (file_ == nullptr) {
+    ::close(fd);
+    ::unlink(path_.c_str());
+    return Status::Error("Failed to open spill file %s: %s", path_.c_str(), ::strerror(errno));
+  }
+  return Status::OK();
+}
+
+Status RowSpiller::spill(DataSet& ds) {
+  if (file_ == nullptr) {
+    NG_RETURN_IF_ERROR(open());
+  }
+  std::string buf;
+  for (auto& row : ds.rows) {
+    buf.clear();
+    apache::thrift::CompactSerializer::serialize(Value(std::move(row)), &buf);
+    uint32_t len = buf.size();
+    if (::fwrite(&len, sizeof(len), 1, file_) != 1 ||
+        ::fwrite(buf.data(), 1, len, file_) != len) {
+      return Status::Error("Failed to write spill file %s: %s", path_.c_str(), ::strerror(errno));
+    }
+  }
+  rowCount_ += ds.rows.size();
+  ds.rows.clear();
+  return Status::OK();
+}
+
+Status RowSpiller::rewind() {
+  restored_ = 0;
+  if (file_ == nullptr) {
+    return Status::OK();
+  }
+  if (::fflush(file_) != 0 || ::fseek(file_, 0, SEEK_SET) != 0) {
+    return Status::Error("Failed to rewind spill file %s: %s", path_.c_str(), ::strerror(errno));
+  }
+  return Status::OK();
+}
+
+StatusOr<DataSet> RowSpiller::restore(std::size_t maxRows) {
+  DataSet ds;
+  if (file_ == nullptr) {
+    return ds;
+  }
+  std::vector<std::string> bufs;
+  std::size_t batchBytes = 0;
+  while (restored_ + bufs.size() < rowCount_ && bufs.size() < maxRows) {
+    uint32_t len = 0;
+    if (::fread(&len, sizeof(len), 1, file_) != 1) {
+      return Status::Error("Failed to read spill file %s: %s", path_.c_str(), ::strerror(errno));
+    }
+    std::string buf;
+    buf.resize(len);
+    if (::fread(&buf[0], 1, len, file_) != len) {
+      return Status::Error("Failed to read spill file %s: %s", path_.c_str(), ::strerror(errno));
+    }
+    batchBytes += len;
+    bufs.emplace_back(std::move(buf));
+  }
+  // Charge the tracker once for the whole batch instead of refilling the thread reserve row by
+  // row; the serialized size is a close proxy for the materialized rows
+  memory::MemoryTracker::reserve(batchBytes);
+  for (auto& buf : bufs) {
+    Value row;
+    apache::thrift::CompactSerializer::deserialize(buf, row);
+    if (UNLIKELY(!row.isList())) {
+      return Status::Error("Bad row in spill file %s", path_.c_str());
+    }
+    ds.rows.emplace_back(row.moveList());
+    ++restored_;
+  }
+  return ds;
+}
+
+}  // namespace graph
+}  // namespace nebula
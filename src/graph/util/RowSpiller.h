@@ -0,0 +1,64 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_UTIL_ROWSPILLER_H_
+#define GRAPH_UTIL_ROWSPILLER_H_
+
+#include <boost/core/noncopyable.hpp>
+
+#include "common/base/StatusOr.h"
+#include "common/cpp/helpers.h"
+#include "common/datatypes/DataSet.h"
+
+namespace nebula {
+namespace graph {
+
+// Spills DataSet rows to a temp file so executors can keep their working set under the memory
+// quota instead of failing the whole query. Rows are written length-prefixed in the thrift
+// compact Value codec, the same format rows travel in on the wire, and streamed back in bounded
+// batches through restore().
+//
+// Usage: append row chunks with spill() while producing, then rewind() once and drain the rows
+// with restore(). The backing file lives in FLAGS_executor_spill_dir and is removed when the
+// spiller is destroyed.
+class RowSpiller final : public boost::noncopyable, cpp::NonMovable {
+ public:
+  explicit RowSpiller(const std::string& prefix);
+  ~RowSpiller();
+
+  // True when spilling is enabled and the tracked memory usage exceeds the watermark
+  static bool needSpill();
+
+  // Append the rows of `ds' to the spill file and drop them; colNames stay untouched
+  Status spill(DataSet& ds);
+
+  // Seek back to the first row before restoring
+  Status rewind();
+
+  bool hasMore() const {
+    return restored_ < rowCount_;
+  }
+
+  std::size_t rowSize() const {
+    return rowCount_;
+  }
+
+  // Read back up to `maxRows' rows; an empty DataSet means the file is drained
+  StatusOr<DataSet> restore(std::size_t maxRows);
+
+ private:
+  // The file is created lazily on the first spill
+  Status open();
+
+  std::string prefix_;
+  std::string path_;
+  FILE* file_{nullptr};
+  std::size_t rowCount_{0};
+  std::size_t restored_{0};
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_UTIL_ROWSPILLER_H_
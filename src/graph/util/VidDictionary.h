@@ -0,0 +1,81 @@
+// Copyright (c) 2023 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#ifndef GRAPH_UTIL_VIDDICTIONARY_H_
+#define GRAPH_UTIL_VIDDICTIONARY_H_
+
+#include <robin_hood.h>
+
+#include <boost/dynamic_bitset.hpp>
+
+#include "common/datatypes/Value.h"
+
+namespace nebula {
+namespace graph {
+
+// Maps vids to dense uint32 ids for the lifetime of one traversal. Deep traversals test
+// the same vids against several sets (visited, history, current frontier); interning the
+// vid once and doing the membership tests on dense ids through DenseIdSet turns every
+// test after the first into a bitset probe with no hashing and no Value comparison.
+// Because the ids are assigned contiguously, a plain bitset is already the optimal set
+// representation -- compressed bitmaps only pay off over sparse id universes.
+class VidDictionary final {
+ public:
+  static constexpr uint32_t kNotSeen = std::numeric_limits<uint32_t>::max();
+
+  // Return the dense id of `vid', assigning the next free id on first sight
+  uint32_t intern(const Value& vid) {
+    return ids_.emplace(vid, static_cast<uint32_t>(ids_.size())).first->second;
+  }
+
+  // Return the dense id of `vid', or kNotSeen when it was never interned
+  uint32_t lookup(const Value& vid) const {
+    auto it = ids_.find(vid);
+    return it == ids_.end() ? kNotSeen : it->second;
+  }
+
+  size_t size() const {
+    return ids_.size();
+  }
+
+  void reserve(size_t n) {
+    ids_.reserve(n);
+  }
+
+ private:
+  robin_hood::unordered_flat_map<Value, uint32_t, std::hash<Value>> ids_;
+};
+
+// Grow-on-demand bitset keyed by VidDictionary ids
+class DenseIdSet final {
+ public:
+  // Return true when `id' was not in the set yet
+  bool insert(uint32_t id) {
+    if (id >= bits_.size()) {
+      bits_.resize(std::max<size_t>(id + 1, bits_.size() * 2), false);
+    }
+    if (bits_[id]) {
+      return false;
+    }
+    bits_[id] = true;
+    return true;
+  }
+
+  bool contains(uint32_t id) const {
+    return id < bits_.size() && bits_[id];
+  }
+
+  // Empty the set but keep the allocation for the next step
+  void clear() {
+    bits_.reset();
+  }
+
+ private:
+  boost::dynamic_bitset<> bits_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_UTIL_VIDDICTIONARY_H_
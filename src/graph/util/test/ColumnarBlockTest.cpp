@@ -0,0 +1,106 @@
+// Copyright (c) 2022 vesoft inc. All rights reserved.
+//
+// This source code is licensed under Apache 2.0 License.
+
+#include <gtest/gtest.h>
+
+#include <cstring>
+
+#include "graph/util/ColumnarBlock.h"
+
+namespace nebula {
+namespace graph {
+
+TEST(ColumnarBlockTest, ExtractTyped) {
+  std::vector<Row> rows;
+  rows.emplace_back(Row({Value(3), Value("c"), Value(1.5)}));
+  rows.emplace_back(Row({Value(1), Value("a"), Value(0.5)}));
+  rows.emplace_back(Row({Value(2), Value("b"), Value(2.5)}));
+
+  auto block = ColumnarBlock::extract(rows.cbegin(), rows.cend(), {0, 1, 2});
+  ASSERT_TRUE(block.has_value());
+  ASSERT_EQ(block->numRows(), 3);
+  // Column 0: 3 > 1, 1 < 2
+  EXPECT_GT(block->compareAt(0, 0, 1), 0);
+  EXPECT_LT(block->compareAt(0, 1, 2), 0);
+  // Column 1: "c" > "a"
+  EXPECT_GT(block->compareAt(1, 0, 1), 0);
+  // Column 2: 1.5 < 2.5, equal to itself
+  EXPECT_LT(block->compareAt(2, 0, 2), 0);
+  EXPECT_EQ(block->compareAt(2, 1, 1), 0);
+}
+
+TEST(ColumnarBlockTest, BailOnMixedAndNull) {
+  {
+    // Mixed int/string in one column
+    std::vector<Row> rows;
+    rows.emplace_back(Row({Value(1)}));
+    rows.emplace_back(Row({Value("oops")}));
+    EXPECT_FALSE(ColumnarBlock::extract(rows.cbegin(), rows.cend(), {0}).has_value());
+  }
+  {
+    // Null cell
+    std::vector<Row> rows;
+    rows.emplace_back(Row({Value(1)}));
+    rows.emplace_back(Row({Value::kNullValue}));
+    EXPECT_FALSE(ColumnarBlock::extract(rows.cbegin(), rows.cend(), {0}).has_value());
+  }
+  {
+    // Non-scalar column
+    std::vector<Row> rows;
+    rows.emplace_back(Row({Value(List({Value(1)}))}));
+    EXPECT_FALSE(ColumnarBlock::extract(rows.cbegin(), rows.cend(), {0}).has_value());
+  }
+  {
+    // Out-of-range column index
+    std::vector<Row> rows;
+    rows.emplace_back(Row({Value(1)}));
+    EXPECT_FALSE(ColumnarBlock::extract(rows.cbegin(), rows.cend(), {5}).has_value());
+  }
+}
+
+TEST(ColumnarBlockTest, NormalizeKeysMatchesCompareAt) {
+  std::vector<Row> rows;
+  rows.emplace_back(Row({Value(-3), Value(1.5), Value(true)}));
+  rows.emplace_back(Row({Value(7), Value(-0.5), Value(false)}));
+  rows.emplace_back(Row({Value(-3), Value(-2.5), Value(true)}));
+  rows.emplace_back(Row({Value(0), Value(1.5), Value(false)}));
+
+  auto block = ColumnarBlock::extract(rows.cbegin(), rows.cend(), {0, 1, 2});
+  ASSERT_TRUE(block.has_value());
+  // Second column descending: memcmp over the normalized keys must agree with the
+  // column-by-column comparison on every row pair
+  std::vector<bool> descending = {false, true, false};
+  size_t stride = 0;
+  auto keys = block->normalizeKeys(descending, &stride);
+  ASSERT_TRUE(keys.has_value());
+  ASSERT_EQ(stride, 17);
+  ASSERT_EQ(keys->size(), stride * rows.size());
+
+  for (size_t l = 0; l < rows.size(); ++l) {
+    for (size_t r = 0; r < rows.size(); ++r) {
+      int expected = 0;
+      for (size_t c = 0; c < 3; ++c) {
+        auto cmp = block->compareAt(c, l, r);
+        if (cmp != 0) {
+          expected = descending[c] ? -cmp : cmp;
+          break;
+        }
+      }
+      auto actual = std::memcmp(keys->data() + l * stride, keys->data() + r * stride, stride);
+      EXPECT_EQ(actual < 0, expected < 0) << "rows " << l << " vs " << r;
+      EXPECT_EQ(actual > 0, expected > 0) << "rows " << l << " vs " << r;
+    }
+  }
+
+  // String columns have no fixed-width normalization
+  std::vector<Row> strRows;
+  strRows.emplace_back(Row({Value("a")}));
+  auto withStr = ColumnarBlock::extract(strRows.cbegin(), strRows.cend(), {0});
+  ASSERT_TRUE(withStr.has_value());
+  size_t unused = 0;
+  EXPECT_FALSE(withStr->normalizeKeys({false}, &unused).has_value());
+}
+
+}  // namespace graph
+}  // namespace nebula
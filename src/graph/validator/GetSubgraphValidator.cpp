@@ -44,7 +44,7 @@ Status GetSubgraphValidator::validateInBound(InBoundClause* in) {
       }
 
       std::string edgeName = *e->edge();
-      auto et = qctx_->schemaMng()->toEdgeType(space.id, edgeName);
+      auto et = qctx_->toEdgeType(space.id, edgeName);
       NG_RETURN_IF_ERROR(et);
       edgeNames.emplace(edgeName);
 
@@ -69,7 +69,7 @@ Status GetSubgraphValidator::validateOutBound(OutBoundClause* out) {
         return Status::SemanticError("Get Subgraph not support rename edge name.");
       }
       std::string edgeName = *e->edge();
-      auto et = qctx_->schemaMng()->toEdgeType(space.id, edgeName);
+      auto et = qctx_->toEdgeType(space.id, edgeName);
       NG_RETURN_IF_ERROR(et);
       edgeNames.emplace(edgeName);
       edgeTypes.emplace(et.value());
@@ -94,7 +94,7 @@ Status GetSubgraphValidator::validateBothInOutBound(BothInOutClause* out) {
         return Status::SemanticError("Get Subgraph not support rename edge name.");
       }
       std::string edgeName = *e->edge();
-      auto et = qctx_->schemaMng()->toEdgeType(space.id, edgeName);
+      auto et = qctx_->toEdgeType(space.id, edgeName);
       NG_RETURN_IF_ERROR(et);
       edgeNames.emplace(edgeName);
       auto v = et.value();
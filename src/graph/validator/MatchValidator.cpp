@@ -201,7 +201,6 @@ Status MatchValidator::buildPathExpr(const MatchPath *path,
 Status MatchValidator::buildNodeInfo(const MatchPath *path,
                                      std::vector<NodeInfo> &nodeInfos,
                                      std::unordered_map<std::string, AliasType> &aliases) {
-  auto *sm = qctx_->schemaMng();
   auto steps = path->steps();
   auto *pool = qctx_->objPool();
   nodeInfos.resize(steps + 1);
@@ -222,7 +221,7 @@ Status MatchValidator::buildNodeInfo(const MatchPath *path,
       auto &labels = node->labels()->labels();
       for (const auto &label : labels) {
         if (label != nullptr) {
-          auto tid = sm->toTagID(space_.id, *label->label());
+          auto tid = qctx_->toTagID(space_.id, *label->label());
           if (!tid.ok()) {
             return Status::SemanticError("`%s': Unknown tag", label->label()->c_str());
           }
@@ -281,7 +280,6 @@ Status MatchValidator::buildNodeInfo(const MatchPath *path,
 Status MatchValidator::buildEdgeInfo(const MatchPath *path,
                                      std::vector<EdgeInfo> &edgeInfos,
                                      std::unordered_map<std::string, AliasType> &aliases) {
-  auto *sm = qctx_->schemaMng();
   auto steps = path->steps();
   edgeInfos.resize(steps);
 
@@ -294,7 +292,7 @@ Status MatchValidator::buildEdgeInfo(const MatchPath *path,
     auto anonymous = false;
     if (!types.empty()) {
       for (auto &type : types) {
-        auto etype = sm->toEdgeType(space_.id, *type);
+        auto etype = qctx_->toEdgeType(space_.id, *type);
         if (!etype.ok()) {
           return Status::SemanticError("`%s': Unknown edge type", type->c_str());
         }
@@ -304,8 +302,8 @@ Status MatchValidator::buildEdgeInfo(const MatchPath *path,
     } else {
       const auto allEdgesResult = cypherCtx_->qctx->schemaMng()->getAllVerEdgeSchema(space_.id);
       NG_RETURN_IF_ERROR(allEdgesResult);
-      const auto allEdges = std::move(allEdgesResult).value();
-      for (const auto &edgeSchema : allEdges) {
+      const auto allEdges = allEdgesResult.value();
+      for (const auto &edgeSchema : *allEdges) {
         edgeInfos[i].edgeTypes.emplace_back(edgeSchema.first);
         auto typeName = cypherCtx_->qctx->schemaMng()->toEdgeName(space_.id, edgeSchema.first);
         NG_RETURN_IF_ERROR(typeName);
@@ -836,12 +836,21 @@ Expression *UpdateValidator::rewriteSymExpr(Expression *expr,
 
 Status UpdateVertexValidator::validateImpl() {
   auto sentence = static_cast<UpdateVertexSentence *>(sentence_);
-  auto idRet = SchemaUtil::toVertexID(sentence->getVid(), vidType_);
-  if (!idRet.ok()) {
-    LOG(ERROR) << idRet.status();
-    return std::move(idRet).status();
+  std::vector<Expression *> vidExprs;
+  if (sentence->vidList() != nullptr) {
+    vidExprs = sentence->vidList()->vidList();
+  } else {
+    vidExprs.emplace_back(sentence->getVid());
+  }
+  vIds_.reserve(vidExprs.size());
+  for (auto *vidExpr : vidExprs) {
+    auto idRet = SchemaUtil::toVertexID(vidExpr, vidType_);
+    if (!idRet.ok()) {
+      LOG(ERROR) << idRet.status();
+      return std::move(idRet).status();
+    }
+    vIds_.emplace_back(std::move(idRet).value());
   }
-  vId_ = std::move(idRet).value();
   NG_RETURN_IF_ERROR(initProps());
   auto ret = qctx_->schemaMng()->toTagID(spaceId_, name_);
   if (!ret.ok()) {
@@ -857,7 +866,7 @@ Status UpdateVertexValidator::toPlan() {
                                     nullptr,
                                     spaceId_,
                                     std::move(name_),
-                                    vId_,
+                                    std::move(vIds_),
                                     tagId_,
                                     insertable_,
                                     std::move(updatedProps_),
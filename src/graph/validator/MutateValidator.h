@@ -181,7 +181,7 @@ class UpdateVertexValidator final : public UpdateValidator {
   Status toPlan() override;
 
  private:
-  Value vId_;
+  std::vector<Value> vIds_;
   TagID tagId_{-1};
 };
 
@@ -65,7 +65,8 @@ class MockSchemaManager final : public nebula::meta::SchemaManager {
   }
 
   // Returns all version of all tags
-  StatusOr<meta::TagSchemas> getAllVerTagSchema(GraphSpaceID space) override {
+  StatusOr<std::shared_ptr<const meta::TagSchemas>> getAllVerTagSchema(
+      GraphSpaceID space) override {
     meta::TagSchemas allVerTagSchemas;
     const auto& tagSchemas = tagSchemas_[space];
     for (const auto& tagSchema : tagSchemas) {
@@ -73,7 +74,7 @@ class MockSchemaManager final : public nebula::meta::SchemaManager {
           tagSchema.first,
           std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>{tagSchema.second});
     }
-    return allVerTagSchemas;
+    return std::make_shared<const meta::TagSchemas>(std::move(allVerTagSchemas));
   }
 
   // Returns all latest version of schemas of all tags in the given space
@@ -87,7 +88,8 @@ class MockSchemaManager final : public nebula::meta::SchemaManager {
   }
 
   // Returns all version of all edges
-  StatusOr<meta::EdgeSchemas> getAllVerEdgeSchema(GraphSpaceID space) override {
+  StatusOr<std::shared_ptr<const meta::EdgeSchemas>> getAllVerEdgeSchema(
+      GraphSpaceID space) override {
     meta::EdgeSchemas allVerEdgeSchemas;
     const auto& edgeSchemas = edgeSchemas_[space];
     for (const auto& edgeSchema : edgeSchemas) {
@@ -95,7 +97,7 @@ class MockSchemaManager final : public nebula::meta::SchemaManager {
           edgeSchema.first,
           std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>{edgeSchema.second});
     }
-    return allVerEdgeSchemas;
+    return std::make_shared<const meta::EdgeSchemas>(std::move(allVerEdgeSchemas));
   }
 
   // Returns all latest version of  edges schema
@@ -0,0 +1,139 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/visitor/EliminateCommonExprVisitor.h"
+
+#include "common/function/FunctionManager.h"
+#include "graph/util/ExpressionUtils.h"
+#include "graph/visitor/RewriteVisitor.h"
+
+namespace nebula {
+namespace graph {
+
+namespace {
+
+// Whether the sub-tree is worth pointing two occurrences at: leaves cost as little as the
+// shared pointer itself, while stateful constructs and impure function calls should keep
+// their own node so that pointer identity never suggests value identity.
+bool isShareable(const Expression *expr) {
+  static const std::unordered_set<Expression::Kind> kLeaves = {
+      Expression::Kind::kConstant,     Expression::Kind::kInputProperty,
+      Expression::Kind::kVarProperty,  Expression::Kind::kVar,
+      Expression::Kind::kLabel,        Expression::Kind::kLabelAttribute,
+      Expression::Kind::kTagProperty,  Expression::Kind::kEdgeProperty,
+      Expression::Kind::kDstProperty,  Expression::Kind::kSrcProperty,
+      Expression::Kind::kEdgeSrc,      Expression::Kind::kEdgeType,
+      Expression::Kind::kEdgeRank,     Expression::Kind::kEdgeDst,
+      Expression::Kind::kVertex,       Expression::Kind::kEdge,
+      Expression::Kind::kColumn,       Expression::Kind::kUUID,
+      Expression::Kind::kVersionedVar};
+  if (kLeaves.count(expr->kind()) != 0) {
+    return false;
+  }
+  static const std::unordered_set<Expression::Kind> kStateful = {Expression::Kind::kAggregate,
+                                                                 Expression::Kind::kUUID,
+                                                                 Expression::Kind::kVersionedVar,
+                                                                 Expression::Kind::kESQUERY};
+  if (ExpressionUtils::hasAny(expr, kStateful)) {
+    return false;
+  }
+  for (const auto *funcExpr :
+       ExpressionUtils::collectAll(expr, {Expression::Kind::kFunctionCall})) {
+    auto *func = static_cast<const FunctionCallExpression *>(funcExpr);
+    auto pure = FunctionManager::getIsPure(func->name(), func->args()->args().size());
+    if (!pure.ok() || !pure.value()) {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+void EliminateCommonExprVisitor::visit(PlanNode *node) {
+  if (!visitedPlanNode_.emplace(node).second) {
+    return;
+  }
+  for (const auto *dep : node->dependencies()) {
+    const_cast<PlanNode *>(dep)->accept(this);
+  }
+}
+
+void EliminateCommonExprVisitor::visit(Project *node) {
+  if (node->columns() != nullptr) {
+    reduceColumns(node->columns());
+  }
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::visit(Filter *node) {
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::visit(Aggregate *node) {
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::visit(Traverse *node) {
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::visit(ScanEdges *node) {
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::visit(AppendVertices *node) {
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::visit(HashJoin *node) {
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::visit(Union *node) {
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::visit(Unwind *node) {
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::visit(CrossJoin *node) {
+  visit(static_cast<PlanNode *>(node));
+}
+
+void EliminateCommonExprVisitor::reduceColumns(YieldColumns *columns) {
+  // Canonical node of every shareable sub-tree seen so far, keyed by its text
+  std::unordered_map<std::string, Expression *> seen;
+  auto matcher = [&seen](const Expression *expr) -> bool {
+    if (!isShareable(expr)) {
+      return false;
+    }
+    auto found = seen.find(expr->toString());
+    if (found == seen.end()) {
+      // First occurrence becomes the canonical node, keep descending so its own
+      // sub-trees get registered too
+      seen.emplace(expr->toString(), const_cast<Expression *>(expr));
+      return false;
+    }
+    return found->second != expr;
+  };
+  auto rewriter = [&seen](const Expression *expr) -> Expression * {
+    return seen[expr->toString()];
+  };
+  for (auto &col : columns->columns()) {
+    auto folded = ExpressionUtils::foldConstantExpr(col->expr());
+    if (folded.ok()) {
+      col->setExpr(folded.value());
+    }
+    auto *shared = RewriteVisitor::transform(col->expr(), matcher, rewriter);
+    if (shared != nullptr) {
+      col->setExpr(shared);
+    }
+  }
+}
+
+}  // namespace graph
+}  // namespace nebula
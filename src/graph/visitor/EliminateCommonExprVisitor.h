@@ -0,0 +1,48 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef GRAPH_VISITOR_ELIMINATECOMMONEXPRVISITOR_H_
+#define GRAPH_VISITOR_ELIMINATECOMMONEXPRVISITOR_H_
+
+#include "graph/planner/plan/PlanNode.h"
+#include "graph/planner/plan/PlanNodeVisitor.h"
+#include "graph/planner/plan/Query.h"
+
+namespace nebula {
+namespace graph {
+
+// Rewrites the yield columns of every Project in the plan: constant sub-trees are folded
+// and textually identical compound sub-trees inside one column list are shared through the
+// same pooled node, so repeated expressions like properties(e).weight do not keep one
+// private copy per occurrence. The rewrite is best effort, a column whose folding fails is
+// left untouched and reports its error at evaluation time as before.
+class EliminateCommonExprVisitor final : public PlanNodeVisitor {
+ public:
+  EliminateCommonExprVisitor() = default;
+
+  void visit(PlanNode *node) override;
+  void visit(Project *node) override;
+
+  void visit(Filter *node) override;
+  void visit(Aggregate *node) override;
+  void visit(Traverse *node) override;
+  void visit(ScanEdges *node) override;
+  void visit(AppendVertices *node) override;
+  void visit(HashJoin *node) override;
+  void visit(Union *node) override;
+  void visit(Unwind *node) override;
+  void visit(CrossJoin *node) override;
+
+  // Folds constants and shares duplicate sub-trees inside one column list, in place
+  static void reduceColumns(YieldColumns *columns);
+
+ private:
+  std::unordered_set<const PlanNode *> visitedPlanNode_;
+};
+
+}  // namespace graph
+}  // namespace nebula
+
+#endif  // GRAPH_VISITOR_ELIMINATECOMMONEXPRVISITOR_H_
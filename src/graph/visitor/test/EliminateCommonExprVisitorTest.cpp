@@ -0,0 +1,58 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "graph/visitor/EliminateCommonExprVisitor.h"
+#include "graph/visitor/test/VisitorTestBase.h"
+
+namespace nebula {
+namespace graph {
+
+class EliminateCommonExprVisitorTest : public VisitorTestBase {};
+
+TEST_F(EliminateCommonExprVisitorTest, TestFoldConstant) {
+  // YIELD 1 + 2 AS v
+  YieldColumns columns;
+  columns.addColumn(new YieldColumn(addExpr(constantExpr(1), constantExpr(2)), "v"));
+  EliminateCommonExprVisitor::reduceColumns(&columns);
+  auto expected = ConstantExpression::make(pool, 3);
+  ASSERT_EQ(*columns.columns()[0]->expr(), *expected);
+}
+
+TEST_F(EliminateCommonExprVisitorTest, TestShareDuplicateSubTree) {
+  // YIELD abs($var) + 1 AS a, abs($var) + 2 AS b
+  YieldColumns columns;
+  columns.addColumn(new YieldColumn(addExpr(fnExpr("abs", {varExpr("var")}), constantExpr(1)), "a"));
+  columns.addColumn(new YieldColumn(addExpr(fnExpr("abs", {varExpr("var")}), constantExpr(2)), "b"));
+  EliminateCommonExprVisitor::reduceColumns(&columns);
+  auto *lhs = static_cast<ArithmeticExpression *>(columns.columns()[0]->expr());
+  auto *rhs = static_cast<ArithmeticExpression *>(columns.columns()[1]->expr());
+  // Both columns must point at the very same function call node
+  ASSERT_EQ(lhs->left(), rhs->left());
+}
+
+TEST_F(EliminateCommonExprVisitorTest, TestKeepImpureFunction) {
+  // rand32() is not pure, every occurrence keeps its own node
+  YieldColumns columns;
+  columns.addColumn(new YieldColumn(addExpr(fnExpr("rand32", {}), constantExpr(1)), "a"));
+  columns.addColumn(new YieldColumn(addExpr(fnExpr("rand32", {}), constantExpr(2)), "b"));
+  EliminateCommonExprVisitor::reduceColumns(&columns);
+  auto *lhs = static_cast<ArithmeticExpression *>(columns.columns()[0]->expr());
+  auto *rhs = static_cast<ArithmeticExpression *>(columns.columns()[1]->expr());
+  ASSERT_NE(lhs->left(), rhs->left());
+}
+
+TEST_F(EliminateCommonExprVisitorTest, TestKeepLeaves) {
+  // Plain column references are never shared, only compound sub-trees are
+  YieldColumns columns;
+  columns.addColumn(new YieldColumn(addExpr(varExpr("var"), constantExpr(1)), "a"));
+  columns.addColumn(new YieldColumn(addExpr(varExpr("var"), constantExpr(2)), "b"));
+  EliminateCommonExprVisitor::reduceColumns(&columns);
+  auto *lhs = static_cast<ArithmeticExpression *>(columns.columns()[0]->expr());
+  auto *rhs = static_cast<ArithmeticExpression *>(columns.columns()[1]->expr());
+  ASSERT_NE(lhs->left(), rhs->left());
+}
+
+}  // namespace graph
+}  // namespace nebula
@@ -75,6 +75,8 @@ struct PlanDescription {
     3: required binary                        format;
     // the time optimizer spent
     4: required i32                           optimize_time_in_us;
+    // the time the validators spent, only filled for PROFILE/EXPLAIN
+    5: optional i32                           validate_time_in_us;
 } (cpp.type = "nebula::PlanDescription", cpp.noncopyable)
 
 
@@ -86,6 +88,9 @@ struct ExecutionResponse {
     5: optional binary                  error_msg;
     6: optional PlanDescription         plan_desc;
     7: optional binary                  comment;        // Supplementary instruction
+    // Set when the result is paged: fetch the remaining rows with fetchCursor().
+    // The cursor lives on the session and is dropped when the session closes.
+    8: optional i64                     cursor;
 } (cpp.type = "nebula::ExecutionResponse", cpp.noncopyable)
 
 
@@ -119,6 +124,9 @@ service GraphService {
     // Same as execute(), but response will be a json string
     binary executeJson(1: i64 sessionId, 2: binary stmt)
     binary executeJsonWithParameter(1: i64 sessionId, 2: binary stmt, 3: map<binary, common.Value>(cpp.template = "std::unordered_map") parameterMap)
+
+    // Fetches the next page of a paged result, see ExecutionResponse.cursor
+    ExecutionResponse fetchCursor(1: i64 sessionId, 2: i64 cursorId)
     
     VerifyClientVersionResp verifyClientVersion(1: VerifyClientVersionReq req)
 }
@@ -328,6 +328,13 @@ struct StatsItem {
     6: map<common.PartitionID, list<Correlativity>>
         (cpp.template = "std::unordered_map") negative_part_correlativity,
     7: JobStatus                              status,
+    // Serialized HyperLogLog sketch over the vertex ids, register-wise max merges
+    // sketches of different parts/hosts into a space-wide NDV estimate.
+    8: optional binary                        vid_sketch,
+    // log2(out-degree) bucket -> estimated number of source vertices in the bucket,
+    // sampled and maintained inline when enable_approx_stats is on.
+    9: optional map<i32, i64>
+        (cpp.template = "std::unordered_map") degree_histogram,
 }
 
 // Graph space related operations.
@@ -360,6 +367,9 @@ struct ListSpacesResp {
     // Valid if ret equals E_LEADER_CHANGED.
     2: common.HostAddr  leader,
     3: list<IdName>     spaces,
+    // When each space was last changed, so clients can skip reloading unchanged spaces
+    4: optional map<common.GraphSpaceID, i64>
+        (cpp.template = "std::unordered_map") update_times,
 }
 
 struct GetSpaceReq {
@@ -902,6 +912,7 @@ struct ListZonesResp {
 enum ListenerType {
     UNKNOWN       = 0x00,
     ELASTICSEARCH = 0x01,
+    CDC           = 0x02,
 } (cpp.enum_strict)
 
 struct AddListenerReq {
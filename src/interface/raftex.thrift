@@ -7,6 +7,8 @@ namespace cpp nebula.raftex
 
 include "common.thrift"
 
+cpp_include "folly/io/IOBuf.h"
+
 enum Role {
     LEADER      = 1, // the leader
     FOLLOWER    = 2; // following a leader
@@ -52,9 +54,10 @@ struct AskForVoteResponse {
 
 // Log entries being sent to follower, logId is not included, it could be calculated by
 // last_log_id_sent and offset in log_str_list in AppendLogRequest
+// log_str adopts the leader's in-memory log buffer records without copying
 struct RaftLogEntry {
     1: ClusterID cluster;
-    2: binary    log_str;
+    2: binary    (cpp.type = "std::unique_ptr<folly::IOBuf>") log_str;
     3: TermID    log_term;
 }
 
@@ -89,6 +92,9 @@ struct SendSnapshotRequest {
     6: string       leader_addr;
     7: Port         leader_port;
     8: list<binary> rows;
+    // Running totals of the sending stream. The snapshot may be sent over several concurrent
+    // sub-range streams, only the totals of the final request (done == true) cover the whole
+    // snapshot and are verified by the receiver
     9: i64          total_size;
     10: i64         total_count;
     11: bool        done;
@@ -115,6 +121,16 @@ struct HeartbeatResponse {
     7: TermID           last_log_term;
 }
 
+// Heartbeats of all parts on one node destined to the same peer, multiplexed into a single rpc.
+// The i-th response corresponds to the i-th request
+struct BatchHeartbeatRequest {
+    1: list<HeartbeatRequest>   reqs;
+}
+
+struct BatchHeartbeatResponse {
+    1: list<HeartbeatResponse>  resps;
+}
+
 struct SendSnapshotResponse {
     1: common.ErrorCode error_code;
     2: TermID           current_term;
@@ -142,5 +158,6 @@ service RaftexService {
     AppendLogResponse appendLog(1: AppendLogRequest req);
     SendSnapshotResponse sendSnapshot(1: SendSnapshotRequest req);
     HeartbeatResponse heartbeat(1: HeartbeatRequest req) (thread = 'eb');
+    BatchHeartbeatResponse batchHeartbeat(1: BatchHeartbeatRequest req) (thread = 'eb');
     GetStateResponse getState(1: GetStateRequest req);
 }
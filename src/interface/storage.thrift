@@ -25,6 +25,15 @@ struct RequestCommon {
     1: optional common.SessionID session_id,
     2: optional common.ExecutionPlanID plan_id,
     3: optional bool profile_detail,
+    // Remaining execution budget of the query in milliseconds when the request was sent.
+    // Storaged computes a local deadline from it on arrival and aborts iteration once the
+    // deadline passes, so abandoned queries stop burning CPU mid-scan.
+    4: optional i64 timeout_ms,
+    // Hard budget of key-values one request may examine across all its scan loops.
+    // Once exceeded the scans stop and the response carries scan_budget_exhausted,
+    // protecting storaged from badly-planned queries whose limit only applies in
+    // graphd. 0 or unset means unlimited.
+    5: optional i64 max_scanned_keys,
 }
 
 struct PartitionResult {
@@ -41,6 +50,9 @@ struct ResponseCommon {
     // Query latency from storage service
     2: required i64                     latency_in_us,
     3: optional map<string,i32>         latency_detail_us,
+    // True when the scan stopped early because max_scanned_keys of the request was
+    // reached, so the data returned is a partial result.
+    4: optional bool                    scan_budget_exhausted,
 }
 
 
@@ -247,12 +259,45 @@ struct GetDstBySrcRequest {
         (cpp.template = "std::unordered_map")   parts,
     3: list<common.EdgeType>                    edge_types,
     4: optional RequestCommon                   common,
+    // expand up to this many hops locally, chaining the second hop for dsts whose part
+    // lives on this host; only 1 and 2 are supported
+    5: i32                                      max_hops = 1,
 }
 
 struct GetDstBySrcResponse {
     1: required ResponseCommon                  result,
     // Only one dst column, each row is a dst
     2: optional common.DataSet                  dsts,
+    // set when max_hops > 1: first-hop dsts whose part is not on this host, which the
+    // client must still expand for the remaining hop
+    3: optional common.DataSet                  unexpanded_dsts,
+}
+
+struct GetSubgraphRequest {
+    1: common.GraphSpaceID                      space_id,
+    // list of start vids in each local part
+    2: map<common.PartitionID, list<common.Value>>
+        (cpp.template = "std::unordered_map")   parts,
+    // empty means all edge types, a negative type means the reversed direction
+    3: list<common.EdgeType>                    edge_types,
+    // number of expansion steps run on this host
+    4: required i32                             steps,
+    5: optional RequestCommon                   common,
+    // when true the response carries vid_dict and the edge rows reference vids by their
+    // 32-bit index into it, which shrinks the payload a lot for spaces with long vids
+    6: bool                                     use_vid_dict = false,
+}
+
+struct GetSubgraphResponse {
+    1: required ResponseCommon                  result,
+    // deduplicated edge keys, columns are _src, _type, _ranking and _dst
+    2: optional common.DataSet                  edges,
+    // vids reached during the expansion whose part is not on this host, columns are
+    // _vid and _remaining_steps; the client continues the bfs from them elsewhere
+    3: optional common.DataSet                  boundary_vids,
+    // set when use_vid_dict was requested: every distinct vid once, in first-seen order;
+    // the edge columns are then _src_id and _dst_id, indexes into this list
+    4: optional list<common.Value>              vid_dict,
 }
 
 
@@ -287,6 +332,9 @@ struct GetPropRequest {
     // will be returned
     9: optional binary                          filter,
     10: optional RequestCommon                  common,
+    // Only check whether the vertices exist, without reading any property. The response
+    // holds one (_vid, _exists) row per input vertex. Ignored for edge requests.
+    11: optional bool                           exists_only,
 
 }
 
@@ -455,6 +503,10 @@ struct UpdateVertexRequest {
     // If provided, the update happens only when the condition evaluates true
     8: optional binary              condition,
     9: optional RequestCommon       common,
+    // Batch form: all ids live in part_id and share the props/condition above.
+    // When set it supersedes vertex_id, which is kept as the first id of the
+    // batch so that older storaged still applies part of the request.
+    10: optional list<common.Value> vertex_ids,
 }
 /*
  * End of UpdateVertex section
@@ -590,6 +642,14 @@ struct LookupAndTraverseRequest {
 struct ScanCursor {
     // next start key of scan, only valid when has_next is true
     1: optional binary                      next_cursor,
+    // Part the cursor was produced on, set by storaged on every batch so a
+    // resumed scan can be validated and routed to any replica of the part
+    2: optional common.PartitionID          part_id,
+    // Log id the serving replica had committed when the batch was produced.
+    // A replica resuming the scan rejects the cursor when it has committed
+    // less than this, so an export job failing over to another replica never
+    // observes the part rewinding behind data it already consumed.
+    3: optional i64                         snapshot_seq,
 }
 
 struct ScanVertexRequest {
@@ -609,6 +669,9 @@ struct ScanVertexRequest {
     // if set to false, forbid follower read
     9: bool                                enable_read_from_follower = true,
     10: optional RequestCommon              common,
+    // if set to true, the rows scanned by each partition are returned as separate
+    // datasets in ScanResponse.prop_blocks instead of being merged into props
+    11: bool                                return_prop_blocks = false,
 }
 
 struct ScanEdgeRequest {
@@ -639,6 +702,9 @@ struct ScanResponse {
     2: optional common.DataSet              props,
     3: map<common.PartitionID, ScanCursor> (cpp.template = "std::unordered_map")
                                             cursors;
+    // per-partition datasets, only set when the request asks for return_prop_blocks,
+    // each block shares the column names described in the request
+    4: optional list<common.DataSet>        prop_blocks;
 }
 
 struct TaskPara {
@@ -683,6 +749,7 @@ struct KVRemoveRequest {
 service GraphStorageService {
     GetNeighborsResponse getNeighbors(1: GetNeighborsRequest req);
     GetDstBySrcResponse getDstBySrc(1: GetDstBySrcRequest req);
+    GetSubgraphResponse getSubgraph(1: GetSubgraphRequest req);
 
     // Get vertex or edge properties
     GetPropResponse getProps(1: GetPropRequest req);
@@ -736,6 +803,12 @@ struct TransLeaderReq {
 }
 
 
+struct DrainLeadersReq {
+    // Spaces to move leaders away from, drain all spaces when empty.
+    1: list<common.GraphSpaceID> space_ids,
+}
+
+
 struct AddPartReq {
     1: common.GraphSpaceID   space_id,
     2: common.PartitionID    part_id,
@@ -778,6 +851,13 @@ struct GetLeaderReq {
 struct CreateCPRequest {
     1: list<common.GraphSpaceID>  space_ids,
     2: binary                     name,
+    // When set for a space, an incremental checkpoint is created instead of a full
+    // one: no rocksdb checkpoint is taken and only the wal files holding logs after
+    // the given id per part are linked. The ids are the ones the previous backup
+    // returned in CheckpointInfo.parts.
+    3: optional map<common.GraphSpaceID, map<common.PartitionID, common.LogID>
+        (cpp.template = "std::unordered_map")>
+        (cpp.template = "std::unordered_map") previous_log_ids,
 }
 
 struct CreateCPResp {
@@ -865,9 +945,28 @@ struct ClearSpaceResp {
     1: common.ErrorCode code,
 }
 
+struct CloneSpaceReq {
+    1: common.GraphSpaceID old_space_id,
+    2: common.GraphSpaceID new_space_id,
+}
+
+struct CloneSpaceResp {
+    1: common.ErrorCode code,
+}
+
+struct KillPlanReq {
+    1: common.SessionID         session_id,
+    2: common.ExecutionPlanID   plan_id,
+}
+
+struct KillPlanResp {
+    1: common.ErrorCode code,
+}
+
 service StorageAdminService {
     // Interfaces for admin operations
     AdminExecResp transLeader(1: TransLeaderReq req);
+    AdminExecResp drainLeaders(1: DrainLeadersReq req);
     AdminExecResp addPart(1: AddPartReq req);
     AdminExecResp addLearner(1: AddLearnerReq req);
     AdminExecResp removePart(1: RemovePartReq req);
@@ -888,6 +987,12 @@ service StorageAdminService {
     StopTaskResp  stopAdminTask(1: StopTaskRequest req);
 
     ClearSpaceResp clearSpace(1: ClearSpaceReq req);
+
+    // Clone the local data of one space into another via checkpoint hard links
+    CloneSpaceResp cloneSpace(1: CloneSpaceReq req);
+
+    // Abort an in-flight plan execution by the (session, plan) id carried in RequestCommon
+    KillPlanResp killPlan(1: KillPlanReq req);
 }
 
 
@@ -7,13 +7,24 @@
 
 DEFINE_int32(disk_check_interval_secs, 10, "interval to check free space of data path");
 DEFINE_uint64(minimum_reserved_bytes, 1UL << 30, "minimum reserved bytes of each data path");
+DEFINE_int32(wal_group_sync_window_us,
+             0,
+             "Microseconds the wal sync leader of one device waits for other parts to join "
+             "before issuing the shared fsync. 0 means group sync is disabled.");
 
 namespace nebula {
 namespace kvstore {
 
 DiskManager::DiskManager(const std::vector<std::string>& dataPaths,
                          std::shared_ptr<thread::GenericWorker> bgThread)
+    : DiskManager(dataPaths, {}, bgThread) {}
+
+DiskManager::DiskManager(const std::vector<std::string>& dataPaths,
+                         const std::vector<std::string>& walPaths,
+                         std::shared_ptr<thread::GenericWorker> bgThread)
     : bgThread_(bgThread) {
+  CHECK(walPaths.empty() || walPaths.size() == dataPaths.size())
+      << "wal paths must pair with data paths one to one";
   try {
     // atomic is not copy-constructible
     std::vector<std::atomic_uint64_t> freeBytes(dataPaths.size() + 1);
@@ -35,6 +46,25 @@ DiskManager::DiskManager(const std::vector<std::string>& dataPaths,
       freeBytes[index++] = info.available;
     }
     freeBytes_ = std::move(freeBytes);
+    if (!walPaths.empty()) {
+      std::vector<std::atomic_uint64_t> walFreeBytes(walPaths.size());
+      index = 0;
+      for (const auto& path : walPaths) {
+        auto absolute = boost::filesystem::absolute(path);
+        if (!boost::filesystem::exists(absolute)) {
+          if (!boost::filesystem::create_directories(absolute)) {
+            LOG(FATAL) << folly::sformat("WalPath:{} does not exist, create failed.", path);
+          }
+        } else if (!boost::filesystem::is_directory(absolute)) {
+          LOG(FATAL) << "WalPath is not a valid directory: " << path;
+        }
+        auto canonical = boost::filesystem::canonical(path);
+        auto info = boost::filesystem::space(canonical);
+        paths->walPaths_.emplace_back(std::move(canonical));
+        walFreeBytes[index++] = info.available;
+      }
+      walFreeBytes_ = std::move(walFreeBytes);
+    }
   } catch (boost::filesystem::filesystem_error& e) {
     LOG(FATAL) << "DataPath invalid: " << e.what();
   }
@@ -78,6 +108,23 @@ StatusOr<std::string> DiskManager::path(GraphSpaceID spaceId, PartitionID partId
   return Status::Error("Part not found");
 }
 
+StatusOr<std::string> DiskManager::walPath(GraphSpaceID spaceId, PartitionID partId) const {
+  folly::rcu_reader guard;
+  Paths* paths = paths_.load(std::memory_order_acquire);
+  if (paths->walPaths_.empty()) {
+    return Status::Error("No dedicated wal device configured");
+  }
+  auto spaceIt = paths->partIndex_.find(spaceId);
+  if (spaceIt == paths->partIndex_.end()) {
+    return Status::Error("Space not found");
+  }
+  auto partIt = spaceIt->second.find(partId);
+  if (partIt == spaceIt->second.end()) {
+    return Status::Error("Part not found");
+  }
+  return paths->walPaths_[partIt->second].string();
+}
+
 void DiskManager::addPartToPath(GraphSpaceID spaceId, PartitionID partId, const std::string& path) {
   std::lock_guard<std::mutex> lg(lock_);
   try {
@@ -147,7 +194,16 @@ bool DiskManager::hasEnoughSpace(GraphSpaceID spaceId, PartitionID partId) const
   if (partIt == spaceIt->second.end()) {
     return false;
   }
-  return freeBytes_[partIt->second].load(std::memory_order_relaxed) >= FLAGS_minimum_reserved_bytes;
+  if (freeBytes_[partIt->second].load(std::memory_order_relaxed) < FLAGS_minimum_reserved_bytes) {
+    return false;
+  }
+  // The wal of the part lives on a dedicated device which must not fill up either
+  if (!walFreeBytes_.empty() &&
+      walFreeBytes_[partIt->second].load(std::memory_order_relaxed) <
+          FLAGS_minimum_reserved_bytes) {
+    return false;
+  }
+  return true;
 }
 
 void DiskManager::refresh() {
@@ -164,6 +220,71 @@ void DiskManager::refresh() {
       LOG(WARNING) << "Get filesystem info of " << paths->dataPaths_[i] << " failed";
     }
   }
+  for (size_t i = 0; i < paths->walPaths_.size(); i++) {
+    boost::system::error_code ec;
+    auto info = boost::filesystem::space(paths->walPaths_[i], ec);
+    if (!ec) {
+      VLOG(2) << "Refresh filesystem info of " << paths->walPaths_[i];
+      walFreeBytes_[i] = info.available;
+    } else {
+      LOG(WARNING) << "Get filesystem info of " << paths->walPaths_[i] << " failed";
+    }
+  }
+}
+
+
+std::shared_ptr<WalSyncCoordinator> WalSyncCoordinator::instanceForWal(
+    const std::string& partWalDir) {
+  auto parent = boost::filesystem::path(partWalDir).parent_path().string();
+  static std::mutex instanceLock;
+  static std::unordered_map<std::string, std::shared_ptr<WalSyncCoordinator>> instances;
+  std::lock_guard<std::mutex> g(instanceLock);
+  auto it = instances.find(parent);
+  if (it != instances.end()) {
+    return it->second;
+  }
+  auto coordinator = std::make_shared<WalSyncCoordinator>(FLAGS_wal_group_sync_window_us);
+  instances.emplace(std::move(parent), coordinator);
+  return coordinator;
+}
+
+bool WalSyncCoordinator::groupSync(int fd) {
+  std::unique_lock<std::mutex> lck(lock_);
+  auto myGen = currGen_;
+  pendingFds_.emplace(fd);
+  while (syncedGen_ < myGen + 1) {
+    if (leaderActive_) {
+      cv_.wait(lck);
+      continue;
+    }
+    // No sync in flight, so this caller leads the next window. Waiters that wake up
+    // unsatisfied take over the lead for the fds that piled up meanwhile.
+    leaderActive_ = true;
+    lck.unlock();
+    if (windowUs_ > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(windowUs_));
+    }
+    lck.lock();
+    auto gen = currGen_++;
+    std::set<int> fds;
+    fds.swap(pendingFds_);
+    lck.unlock();
+    bool ok = true;
+    for (auto walFd : fds) {
+      if (::fsync(walFd) == -1) {
+        LOG(WARNING) << "group sync wal fd " << walFd << " failed, error: " << strerror(errno);
+        ok = false;
+      }
+    }
+    lck.lock();
+    syncedGen_ = gen + 1;
+    if (!ok) {
+      lastFailedGen_ = gen + 1;
+    }
+    leaderActive_ = false;
+    cv_.notify_all();
+  }
+  return lastFailedGen_ < myGen + 1;
 }
 
 }  // namespace kvstore
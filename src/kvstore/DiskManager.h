@@ -31,6 +31,7 @@ using SpaceDiskPartsMap =
 class DiskManager {
   FRIEND_TEST(DiskManagerTest, AvailableTest);
   FRIEND_TEST(DiskManagerTest, WalNoSpaceTest);
+  FRIEND_TEST(DiskManagerTest, WalDeviceTest);
 
  public:
   /**
@@ -42,6 +43,18 @@ class DiskManager {
   DiskManager(const std::vector<std::string>& dataPaths,
               std::shared_ptr<thread::GenericWorker> bgThread = nullptr);
 
+  /**
+   * @brief Construct a Disk Manager which also tracks dedicated wal devices
+   *
+   * @param dataPaths `data_path` in configuration
+   * @param walPaths Wal device per data path, matched by index; empty means the wal
+   * shares the data disks
+   * @param bgThread Background thread to refresh remaining spaces of each path
+   */
+  DiskManager(const std::vector<std::string>& dataPaths,
+              const std::vector<std::string>& walPaths,
+              std::shared_ptr<thread::GenericWorker> bgThread = nullptr);
+
   ~DiskManager();
 
   /**
@@ -65,6 +78,16 @@ class DiskManager {
    */
   StatusOr<std::string> path(GraphSpaceID spaceId, PartitionID partId) const;
 
+  /**
+   * @brief Canonical wal device of the disk holding the given partition. Only
+   * available when dedicated wal devices are configured
+   *
+   * @param spaceId
+   * @param partId
+   * @return StatusOr<std::string> wal device path if configured and part is found
+   */
+  StatusOr<std::string> walPath(GraphSpaceID spaceId, PartitionID partId) const;
+
   /**
    * @brief Add a partition to a given path, called when add a partition in NebulaStore
    * @pre Path is the space path, so it must end with /nebula/spaceId and path must exists
@@ -111,6 +134,8 @@ class DiskManager {
   struct Paths {
     // canonical path of data_path flag
     std::vector<boost::filesystem::path> dataPaths_;
+    // canonical wal device per data path, empty when wal shares the data disks
+    std::vector<boost::filesystem::path> walPaths_;
     // given a space and data path, return all parts in the path
     std::unordered_map<GraphSpaceID, PartDiskMap> partPath_;
     // the index in dataPaths_ for a given space + part
@@ -123,11 +148,58 @@ class DiskManager {
   std::atomic<Paths*> paths_;
   // free space available to a non-privileged process, in bytes
   std::vector<std::atomic_uint64_t> freeBytes_;
+  // free bytes of each wal device, aligned with freeBytes_; empty when no dedicated
+  // wal devices are configured
+  std::vector<std::atomic_uint64_t> walFreeBytes_;
 
   // lock used to protect partPath_ and partIndex_
   std::mutex lock_;
 };
 
+/**
+ * @brief Batches wal fsyncs of all parts whose wal lives on the same device. Callers block
+ * until an fsync covering everything they wrote has completed, so hundreds of parts issue
+ * one shared fsync per window instead of one each.
+ */
+class WalSyncCoordinator {
+ public:
+  explicit WalSyncCoordinator(int32_t windowUs) : windowUs_(windowUs) {}
+
+  /**
+   * @brief Return the coordinator of the device a part's wal dir lives on. All parts of one
+   * engine keep their wal under "<walRoot>/wal/<partId>", so the parent directory identifies
+   * the device the fsyncs should be grouped on.
+   *
+   * @param partWalDir Wal directory of one part
+   */
+  static std::shared_ptr<WalSyncCoordinator> instanceForWal(const std::string& partWalDir);
+
+  /**
+   * @brief Block until an fsync covering everything written to fd before the call completed.
+   * The first caller of a window becomes the leader: it waits for the window to let other
+   * parts pile in, then issues one fsync per distinct fd and wakes all of them.
+   *
+   * @param fd Wal file descriptor, must stay open until the call returns
+   * @return false if the covering fsync (or a later one) reported an error
+   */
+  bool groupSync(int fd);
+
+ private:
+  const int32_t windowUs_;
+
+  std::mutex lock_;
+  std::condition_variable cv_;
+  // fds waiting for the next sync, deduplicated per window
+  std::set<int> pendingFds_;
+  // generation the pending fds belong to, bumped when a leader takes them
+  uint64_t currGen_{0};
+  // all writes registered before this generation are durable
+  uint64_t syncedGen_{0};
+  // latest generation whose fsync reported an error, 0 means none
+  uint64_t lastFailedGen_{0};
+  bool leaderActive_{false};
+};
+
 }  // namespace kvstore
 }  // namespace nebula
 
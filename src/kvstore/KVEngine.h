@@ -6,6 +6,8 @@
 #ifndef KVSTORE_KVENGINE_H_
 #define KVSTORE_KVENGINE_H_
 
+#include <folly/futures/Future.h>
+
 #include "common/base/Base.h"
 #include "common/base/ErrorOr.h"
 #include "common/base/Status.h"
@@ -121,6 +123,16 @@ class KVEngine {
                                       std::string* value,
                                       const void* snapshot = nullptr) = 0;
 
+  /**
+   * @brief Check whether a key exists without retrieving its value. An engine with bloom
+   * filters answers most absent keys without touching any data block.
+   *
+   * @param key Key to check
+   * @param found Set to whether the key exists
+   * @return nebula::cpp2::ErrorCode
+   */
+  virtual nebula::cpp2::ErrorCode exists(const std::string& key, bool* found) = 0;
+
   /**
    * @brief Read a list of keys
    *
@@ -132,17 +144,35 @@ class KVEngine {
   virtual std::vector<Status> multiGet(const std::vector<std::string>& keys,
                                        std::vector<std::string>* values) = 0;
 
+  /**
+   * @brief Asynchronous counterpart of multiGet, per-key status and values aligned with keys.
+   *
+   * The base implementation reads synchronously and returns a ready future; an engine with a
+   * natively asynchronous read path should override it.
+   *
+   * @param keys Keys to read
+   * @return Per-key status and values, aligned with keys
+   */
+  virtual folly::SemiFuture<std::pair<std::vector<Status>, std::vector<std::string>>> asyncMultiGet(
+      std::vector<std::string> keys) {
+    std::vector<std::string> values;
+    auto status = multiGet(keys, &values);
+    return folly::makeSemiFuture(std::make_pair(std::move(status), std::move(values)));
+  }
+
   /**
    * @brief Get all results in range [start, end)
    *
    * @param start Start key, inclusive
    * @param end End key, exclusive
    * @param iter Iterator in range [start, end), returns by kv engine
+   * @param readaheadSize Read-ahead bytes hint of the scan, 0 leaves the engine default
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode range(const std::string& start,
                                         const std::string& end,
-                                        std::unique_ptr<KVIterator>* iter) = 0;
+                                        std::unique_ptr<KVIterator>* iter,
+                                        size_t readaheadSize = 0) = 0;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
@@ -150,11 +180,13 @@ class KVEngine {
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix', returns by kv engine
    * @param snapshot Snapshot from kv engine. nullptr means no snapshot.
+   * @param readaheadSize Read-ahead bytes hint of the scan, 0 leaves the engine default
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode prefix(const std::string& prefix,
                                          std::unique_ptr<KVIterator>* iter,
-                                         const void* snapshot = nullptr) = 0;
+                                         const void* snapshot = nullptr,
+                                         size_t readaheadSize = 0) = 0;
 
   /**
    * @brief Get all results with 'prefix' str as prefix starting form 'start'
@@ -162,11 +194,13 @@ class KVEngine {
    * @param start Start key, inclusive
    * @param prefix The prefix of keys to iterate
    * @param iter Iterator of keys starts with 'prefix' beginning from 'start', returns by kv engine
+   * @param readaheadSize Read-ahead bytes hint of the scan, 0 leaves the engine default
    * @return nebula::cpp2::ErrorCode
    */
   virtual nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
                                                   const std::string& prefix,
-                                                  std::unique_ptr<KVIterator>* iter) = 0;
+                                                  std::unique_ptr<KVIterator>* iter,
+                                                  size_t readaheadSize = 0) = 0;
 
   /**
    * @brief Scan all keys in kv engine
@@ -218,6 +252,19 @@ class KVEngine {
    */
   virtual nebula::cpp2::ErrorCode removeRange(const std::string& start, const std::string& end) = 0;
 
+  /**
+   * @brief Physically drop the sst files fully contained in [start, end) and compact the
+   * boundary files, so a bulk removal reclaims disk space in O(files) instead of leaving
+   * range tombstones behind until the next full compaction. Keys in the range must have
+   * been logically removed (e.g. by removeRange) before calling this.
+   *
+   * @param start Start key, inclusive
+   * @param end End key, exclusive
+   * @return nebula::cpp2::ErrorCode
+   */
+  virtual nebula::cpp2::ErrorCode deleteFilesInRange(const std::string& start,
+                                                     const std::string& end) = 0;
+
   /**
    * @brief Add partId into current storage engine.
    *
@@ -310,6 +357,17 @@ class KVEngine {
    */
   virtual nebula::cpp2::ErrorCode compact() = 0;
 
+  /**
+   * @brief Hint the engine to prioritize compacting the given key range, so a frequently
+   * read range drains its read amplification ahead of other compaction work
+   *
+   * @param begin Start key of the range, inclusive
+   * @param end End key of the range, exclusive
+   * @return nebula::cpp2::ErrorCode
+   */
+  virtual nebula::cpp2::ErrorCode suggestCompactRange(const std::string& begin,
+                                                      const std::string& end) = 0;
+
   /**
    * @brief Flush data in memtable into sst
    *
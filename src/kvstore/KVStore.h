@@ -6,6 +6,7 @@
 #ifndef KVSTORE_KVSTORE_H_
 #define KVSTORE_KVSTORE_H_
 
+#include <folly/futures/Future.h>
 #include <rocksdb/compaction_filter.h>
 #include <rocksdb/merge_operator.h>
 
@@ -37,6 +38,12 @@ struct KVOptions {
 
   std::string walPath_;
 
+  // Optional dedicated wal device per data path, matched by index with dataPaths_.
+  // When set, each engine keeps its wal on the paired path (typically low-latency
+  // media) so compaction traffic on the data disk does not queue in front of wal
+  // fsyncs. Overrides walPath_ when non-empty.
+  std::vector<std::string> walPaths_;
+
   // Path for listener, only wal is stored, the structure would be
   // spaceId/partId/wal
   std::string listenerPath_;
@@ -134,6 +141,35 @@ class KVStore {
                                       bool canReadFromFollower = false,
                                       const void* snapshot = nullptr) = 0;
 
+  /**
+   * @brief Check whether a key exists without retrieving its value. The default
+   * implementation falls back to a plain read; stores whose engines carry bloom filters
+   * should override it to answer absent keys without touching any data block.
+   *
+   * @param spaceId
+   * @param partId
+   * @param key
+   * @param found Set to whether the key exists
+   * @param canReadFromFollower
+   * @return nebula::cpp2::ErrorCode
+   */
+  virtual nebula::cpp2::ErrorCode exists(GraphSpaceID spaceId,
+                                         PartitionID partId,
+                                         const std::string& key,
+                                         bool* found,
+                                         bool canReadFromFollower = false) {
+    std::string value;
+    auto ret = get(spaceId, partId, key, &value, canReadFromFollower);
+    if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      *found = true;
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+      *found = false;
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    return ret;
+  }
+
   /**
    * @brief Read a list of keys
    *
@@ -153,6 +189,51 @@ class KVStore {
       std::vector<std::string>* values,
       bool canReadFromFollower = false) = 0;
 
+  // ErrorCode of the whole read, then per-key status and values aligned with the keys
+  using AsyncMultiGetResult =
+      std::tuple<nebula::cpp2::ErrorCode, std::vector<Status>, std::vector<std::string>>;
+
+  /**
+   * @brief Asynchronous counterpart of get: the result is delivered through the returned
+   * SemiFuture instead of tying up the calling thread for the duration of a blocking read. The
+   * base implementation reads synchronously and returns a ready future.
+   *
+   * @param spaceId
+   * @param partId
+   * @param key
+   * @param canReadFromFollower
+   * @return ErrorCode and the value
+   */
+  virtual folly::SemiFuture<std::pair<nebula::cpp2::ErrorCode, std::string>> asyncGet(
+      GraphSpaceID spaceId,
+      PartitionID partId,
+      std::string key,
+      bool canReadFromFollower = false) {
+    std::string value;
+    auto ret = get(spaceId, partId, key, &value, canReadFromFollower);
+    return folly::makeSemiFuture(std::make_pair(ret, std::move(value)));
+  }
+
+  /**
+   * @brief Asynchronous counterpart of multiGet, same convention for partial results. The base
+   * implementation reads synchronously and returns a ready future.
+   *
+   * @param spaceId
+   * @param partId
+   * @param keys Keys to read
+   * @param canReadFromFollower
+   * @return AsyncMultiGetResult
+   */
+  virtual folly::SemiFuture<AsyncMultiGetResult> asyncMultiGet(GraphSpaceID spaceId,
+                                                               PartitionID partId,
+                                                               std::vector<std::string> keys,
+                                                               bool canReadFromFollower = false) {
+    std::vector<std::string> values;
+    auto ret = multiGet(spaceId, partId, keys, &values, canReadFromFollower);
+    return folly::makeSemiFuture(
+        AsyncMultiGetResult(ret.first, std::move(ret.second), std::move(values)));
+  }
+
   /**
    * @brief Get all results in range [start, end)
    *
@@ -5,6 +5,7 @@
 
 #include "kvstore/LogEncoder.h"
 
+#include <folly/hash/Checksum.h>
 #include <thrift/lib/cpp2/protocol/CompactProtocol.h>
 #include <thrift/lib/cpp2/protocol/Serializer.h>
 
@@ -12,10 +13,18 @@
 #include "common/datatypes/HostAddrOps-inl.h"
 #include "common/time/WallClock.h"
 
+DEFINE_bool(wal_compact_batch_encoding,
+            false,
+            "Encode batch logs with varint lengths and one checksum per batch instead of "
+            "fixed 4-byte lengths. Enable only after every host in the cluster runs a "
+            "version that can decode OP_BATCH_WRITE_COMPACT logs");
+
 namespace nebula {
 namespace kvstore {
 
 constexpr auto kHeadLen = sizeof(int64_t) + 1 + sizeof(uint32_t);
+// Timestamp plus log type, without the fixed-length value count
+constexpr auto kTsTypeLen = sizeof(int64_t) + 1;
 
 std::string encodeKV(const folly::StringPiece& key, const folly::StringPiece& val) {
   uint32_t ksize = key.size();
@@ -160,8 +169,89 @@ std::vector<folly::StringPiece> decodeMultiValues(folly::StringPiece encoded) {
   return values;
 }
 
+// Compact layout: timestamp | type | varint(num ops)
+//                 | num ops * (op type | varint(key len) | key | varint(val len) | val)
+//                 | crc32c over everything after the type byte
+static std::string encodeBatchValueCompact(
+    const std::vector<std::tuple<BatchLogType, std::string, std::string>>& batch) {
+  auto type = LogType::OP_BATCH_WRITE_COMPACT;
+  size_t totalLen = 0;
+  for (auto& op : batch) {
+    totalLen += 1 + 2 * folly::kMaxVarintLength64 + std::get<1>(op).size() + std::get<2>(op).size();
+  }
+
+  std::string encoded;
+  encoded.reserve(kTsTypeLen + totalLen + sizeof(uint32_t));
+
+  // Timestamp (8 bytes)
+  int64_t ts = time::WallClock::fastNowInMilliSec();
+  encoded.append(reinterpret_cast<char*>(&ts), sizeof(int64_t));
+  // Log type
+  encoded.append(reinterpret_cast<char*>(&type), 1);
+  uint8_t varint[folly::kMaxVarintLength64];
+  auto appendVarint = [&encoded, &varint](uint64_t v) {
+    encoded.append(reinterpret_cast<char*>(varint), folly::encodeVarint(v, varint));
+  };
+  // Number of values
+  appendVarint(batch.size());
+  // Values
+  for (auto& op : batch) {
+    auto opType = std::get<0>(op);
+    const auto& key = std::get<1>(op);
+    const auto& val = std::get<2>(op);
+    encoded.append(reinterpret_cast<char*>(&opType), 1);
+    appendVarint(key.size());
+    encoded.append(key.data(), key.size());
+    appendVarint(val.size());
+    encoded.append(val.data(), val.size());
+  }
+  // One checksum for the whole batch
+  uint32_t checksum = folly::crc32c(reinterpret_cast<const uint8_t*>(encoded.data()) + kTsTypeLen,
+                                    encoded.size() - kTsTypeLen);
+  encoded.append(reinterpret_cast<char*>(&checksum), sizeof(uint32_t));
+
+  return encoded;
+}
+
+static StatusOr<
+    std::vector<std::pair<BatchLogType, std::pair<folly::StringPiece, folly::StringPiece>>>>
+decodeBatchValueCompact(folly::StringPiece encoded) {
+  std::vector<std::pair<BatchLogType, std::pair<folly::StringPiece, folly::StringPiece>>> batch;
+  CHECK_GE(encoded.size(), kTsTypeLen + sizeof(uint32_t));
+  const auto* payload = reinterpret_cast<const uint8_t*>(encoded.begin()) + kTsTypeLen;
+  auto payloadLen = encoded.size() - kTsTypeLen - sizeof(uint32_t);
+  uint32_t expected;
+  memcpy(&expected, payload + payloadLen, sizeof(uint32_t));
+  auto actual = folly::crc32c(payload, payloadLen);
+  if (actual != expected) {
+    // Never hand a partial or empty batch back: a caller applying it would advance the
+    // committed log id over the corrupted entry and diverge from the other replicas
+    return Status::Error("Batch log checksum mismatch, expected %u, got %u", expected, actual);
+  }
+
+  folly::ByteRange range(payload, payloadLen);
+  auto numValues = folly::decodeVarint(range);
+  batch.reserve(numValues);
+  for (auto i = 0U; i < numValues; i++) {
+    auto type = static_cast<BatchLogType>(range.front());
+    range.advance(1);
+    auto klen = folly::decodeVarint(range);
+    folly::StringPiece key(reinterpret_cast<const char*>(range.begin()), klen);
+    range.advance(klen);
+    auto vlen = folly::decodeVarint(range);
+    folly::StringPiece val(reinterpret_cast<const char*>(range.begin()), vlen);
+    range.advance(vlen);
+    batch.emplace_back(type, std::pair<folly::StringPiece, folly::StringPiece>(key, val));
+  }
+  DCHECK(range.empty());
+  return batch;
+}
+
 std::string encodeBatchValue(
     const std::vector<std::tuple<BatchLogType, std::string, std::string>>& batch) {
+  if (FLAGS_wal_compact_batch_encoding) {
+    return encodeBatchValueCompact(batch);
+  }
   auto type = LogType::OP_BATCH_WRITE;
   std::string encoded;
   encoded.reserve(1024);
@@ -191,8 +281,11 @@ std::string encodeBatchValue(
   return encoded;
 }
 
-std::vector<std::pair<BatchLogType, std::pair<folly::StringPiece, folly::StringPiece>>>
+StatusOr<std::vector<std::pair<BatchLogType, std::pair<folly::StringPiece, folly::StringPiece>>>>
 decodeBatchValue(folly::StringPiece encoded) {
+  if (encoded[sizeof(int64_t)] == LogType::OP_BATCH_WRITE_COMPACT) {
+    return decodeBatchValueCompact(encoded);
+  }
   // Skip the timestamp and the first type byte
   auto* p = encoded.begin() + sizeof(int64_t) + 1;
   uint32_t numValues = *(reinterpret_cast<const uint32_t*>(p));
@@ -7,9 +7,12 @@
 #define KVSTORE_LOGENCODER_H_
 #include <boost/core/noncopyable.hpp>
 
+#include "common/base/StatusOr.h"
 #include "common/cpp/helpers.h"
 #include "kvstore/Common.h"
 
+DECLARE_bool(wal_compact_batch_encoding);
+
 namespace nebula {
 namespace kvstore {
 
@@ -24,6 +27,9 @@ enum LogType : char {
   OP_ADD_PEER = 0x09,
   OP_REMOVE_PEER = 0x10,
   OP_BATCH_WRITE = 0x11,
+  // Same payload as OP_BATCH_WRITE but with varint lengths and a trailing per-batch
+  // checksum, written when FLAGS_wal_compact_batch_encoding is on
+  OP_BATCH_WRITE_COMPACT = 0x12,
 };
 
 enum BatchLogType : char {
@@ -98,7 +104,8 @@ std::string encodeMultiValues(LogType type, folly::StringPiece v1, folly::String
 std::vector<folly::StringPiece> decodeMultiValues(folly::StringPiece encoded);
 
 /**
- * @brief Encode a log batch
+ * @brief Encode a log batch. Emits the compact OP_BATCH_WRITE_COMPACT layout when
+ * FLAGS_wal_compact_batch_encoding is on, the fixed-length OP_BATCH_WRITE one otherwise
  *
  * @param batch
  * @return std::string Encoded wal
@@ -107,13 +114,14 @@ std::string encodeBatchValue(
     const std::vector<std::tuple<BatchLogType, std::string, std::string>>& batch);
 
 /**
- * @brief Decode into log batchs
+ * @brief Decode into log batchs, accepting both batch layouts
  *
  * @param encoded Encoded wal
- * @return std::vector<std::pair<BatchLogType, std::pair<folly::StringPiece, folly::StringPiece>>>
- * Log batch
+ * @return StatusOr<std::vector<std::pair<BatchLogType, std::pair<folly::StringPiece,
+ * folly::StringPiece>>>> Log batch, or an error when the per-batch checksum of the compact
+ * layout does not match. A caller must not apply anything from a failed decode
  */
-std::vector<std::pair<BatchLogType, std::pair<folly::StringPiece, folly::StringPiece>>>
+StatusOr<std::vector<std::pair<BatchLogType, std::pair<folly::StringPiece, folly::StringPiece>>>>
 decodeBatchValue(folly::StringPiece encoded);
 
 /**
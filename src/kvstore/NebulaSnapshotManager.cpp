@@ -13,6 +13,11 @@ DEFINE_uint32(snapshot_part_rate_limit,
               1024 * 1024 * 10,
               "max bytes of pulling snapshot for each partition in one second");
 DEFINE_uint32(snapshot_batch_size, 1024 * 512, "batch size for snapshot, in bytes");
+DEFINE_uint32(snapshot_concurrent_sub_ranges,
+              1,
+              "number of sub-ranges of one part sent concurrently when sending snapshot, each "
+              "sub-range stream is rate limited separately. 1 means the whole part is sent as a "
+              "single stream");
 
 namespace nebula {
 namespace kvstore {
@@ -74,8 +79,75 @@ void NebulaSnapshotManager::accessAllRowsInSnapshot(GraphSpaceID spaceId,
       FLAGS_snapshot_part_rate_limit,
       FLAGS_snapshot_batch_size);
 
-  auto rateLimiter = std::make_unique<kvstore::RateLimiter>();
   auto tables = NebulaKeyUtils::snapshotPrefix(partId);
+  if (FLAGS_snapshot_concurrent_sub_ranges > 1 && tables.size() > 1) {
+    // Each sub-range (table prefix) of the part is scanned and sent as its own stream with its
+    // own rate limiter. The callback must be safe to invoke from multiple threads. The keys of
+    // different sub-ranges do not overlap, so the receiver can apply the batches in any order,
+    // the totals are only verified on the final batch.
+    std::atomic<size_t> taskIdx{0};
+    std::atomic<bool> failed{false};
+    std::atomic<int64_t> sharedCount{0};
+    std::atomic<int64_t> sharedSize{0};
+    auto worker = [&]() {
+      while (!failed.load()) {
+        auto i = taskIdx.fetch_add(1);
+        if (i >= tables.size()) {
+          return;
+        }
+        kvstore::RateLimiter rateLimiter;
+        std::vector<std::string> subData;
+        int64_t subCount = 0;
+        int64_t subSize = 0;
+        if (!accessTable(spaceId,
+                         partId,
+                         snapshot,
+                         tables[i],
+                         cb,
+                         commitLogId,
+                         commitLogTerm,
+                         subData,
+                         subCount,
+                         subSize,
+                         &rateLimiter)) {
+          failed.store(true);
+          return;
+        }
+        // flush the tail batch of this sub-range
+        if (!subData.empty() &&
+            !cb(commitLogId,
+                commitLogTerm,
+                subData,
+                subCount,
+                subSize,
+                raftex::SnapshotStatus::IN_PROGRESS)) {
+          failed.store(true);
+          return;
+        }
+        sharedCount.fetch_add(subCount);
+        sharedSize.fetch_add(subSize);
+      }
+    };
+    auto numThreads = std::min(static_cast<size_t>(FLAGS_snapshot_concurrent_sub_ranges),
+                               tables.size());
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < numThreads; i++) {
+      threads.emplace_back(worker);
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+    if (failed.load()) {
+      cb(commitLogId, commitLogTerm, data, totalCount, totalSize, raftex::SnapshotStatus::FAILED);
+      return;
+    }
+    totalCount = sharedCount.load();
+    totalSize = sharedSize.load();
+    cb(commitLogId, commitLogTerm, data, totalCount, totalSize, raftex::SnapshotStatus::DONE);
+    return;
+  }
+
+  auto rateLimiter = std::make_unique<kvstore::RateLimiter>();
   for (const auto& prefix : tables) {
     if (!accessTable(spaceId,
                      partId,
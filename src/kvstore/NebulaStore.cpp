@@ -7,6 +7,8 @@
 
 #include <folly/Likely.h>
 #include <folly/ScopeGuard.h>
+#include <rocksdb/concurrent_task_limiter.h>
+#include <rocksdb/statistics.h>
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
 #include <algorithm>
@@ -17,12 +19,53 @@
 #include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/NebulaSnapshotManager.h"
 #include "kvstore/RocksEngine.h"
+#include "kvstore/listener/cdc/CDCListener.h"
 #include "kvstore/listener/elasticsearch/ESListener.h"
+#include "kvstore/stats/KVStats.h"
 
 DEFINE_string(engine_type, "rocksdb", "rocksdb, memory...");
 DEFINE_int32(num_workers, 4, "Number of worker threads");
 DEFINE_int32(clean_wal_interval_secs, 600, "interval to trigger clean expired wal");
+DEFINE_int32(secondary_cache_stats_interval_secs,
+             60,
+             "interval to report rocksdb secondary block cache hits and misses");
+DEFINE_int32(compaction_rebalance_interval_secs,
+             30,
+             "interval to rebalance the shared compaction thread budget between the query "
+             "serving and the bulk load spaces");
+DEFINE_int32(compaction_l0_pressure_files,
+             8,
+             "number of L0 files in any query serving space at which the bulk load spaces are "
+             "squeezed to one compaction thread");
 DEFINE_bool(auto_remove_invalid_space, true, "whether remove data of invalid space when restart");
+DEFINE_int32(write_stall_check_interval_ms,
+             0,
+             "When positive, poll each space's engines for rocksdb write stalls at this "
+             "interval, and reject bulk writes (asyncMultiPut/asyncAppendBatch) to a stalled "
+             "space with E_WRITE_STALLED so ingest backs off before it drags down the shared "
+             "raft apply threads. 0 disables the check");
+DEFINE_bool(enable_part_read_hinting,
+            false,
+            "Track per-part read counts and periodically recompute the hot part set. Hot "
+            "parts get their key ranges suggested to rocksdb compaction so they stay "
+            "read-optimized, and their scans use hot_part_readahead_bytes of read-ahead");
+
+DEFINE_int32(part_hot_set_refresh_secs, 60, "Interval to recompute the hot part set");
+
+DEFINE_double(part_hot_set_coverage,
+              0.8,
+              "The hot set is the smallest group of parts covering this fraction of the "
+              "reads of the last interval");
+
+DEFINE_uint64(hot_part_readahead_bytes,
+              2 * 1024 * 1024,
+              "readahead_size of scans on hot parts when enable_part_read_hinting is on, "
+              "0 leaves the rocksdb default");
+
+DEFINE_int64(follower_read_max_lag_logs,
+             1000,
+             "max number of logs a follower or learner may lag behind the leader's advertised "
+             "commit point while still serving bounded-staleness reads");
 
 DECLARE_bool(rocksdb_disable_wal);
 DECLARE_int32(rocksdb_backup_interval_secs);
@@ -56,7 +99,7 @@ bool NebulaStore::init() {
     LOG(ERROR) << "Start the raft service failed";
     return false;
   }
-  diskMan_.reset(new DiskManager(options_.dataPaths_, storeWorker_));
+  diskMan_.reset(new DiskManager(options_.dataPaths_, options_.walPaths_, storeWorker_));
   // todo(doodle): we could support listener and normal storage start at same
   // instance
   if (!isListener()) {
@@ -72,6 +115,24 @@ bool NebulaStore::init() {
   storeWorker_->addDelayTask(FLAGS_clean_wal_interval_secs * 1000, &NebulaStore::cleanWAL, this);
   storeWorker_->addRepeatTask(
       FLAGS_rocksdb_backup_interval_secs * 1000, &NebulaStore::backup, this);
+  if (!FLAGS_rocksdb_secondary_cache_path.empty() && FLAGS_enable_rocksdb_statistics) {
+    storeWorker_->addRepeatTask(FLAGS_secondary_cache_stats_interval_secs * 1000,
+                                &NebulaStore::reportSecondaryCacheStats,
+                                this);
+  }
+  if (FLAGS_num_compaction_threads > 1 && !FLAGS_rocksdb_bulk_load_space_ids.empty()) {
+    storeWorker_->addRepeatTask(FLAGS_compaction_rebalance_interval_secs * 1000,
+                                &NebulaStore::rebalanceCompactionBudget,
+                                this);
+  }
+  if (FLAGS_write_stall_check_interval_ms > 0) {
+    storeWorker_->addRepeatTask(
+        FLAGS_write_stall_check_interval_ms, &NebulaStore::checkWriteStall, this);
+  }
+  if (FLAGS_enable_part_read_hinting) {
+    storeWorker_->addRepeatTask(
+        FLAGS_part_hot_set_refresh_secs * 1000, &NebulaStore::refreshHotParts, this);
+  }
   LOG(INFO) << "Register handler...";
   options_.partMan_->registerHandler(this);
   return true;
@@ -102,7 +163,7 @@ void NebulaStore::loadPartFromDataPath() {
       }
 
       enginesPath.emplace_back(rootPath + "/" + dir);
-      futures.emplace_back(newEngineAsync(spaceId, path, options_.walPath_));
+      futures.emplace_back(newEngineAsync(spaceId, path, walPath(path)));
     }
   }
 
@@ -127,6 +188,15 @@ void NebulaStore::loadPartFromDataPath() {
 
   // avoid duplicate engine created
   std::unordered_set<std::pair<GraphSpaceID, PartitionID>> partSet;
+  // Parts to open are gathered across all engines first and dispatched to the background
+  // pool in one batch, so parts on different disks open in parallel instead of disk by disk.
+  struct PartToOpen {
+    GraphSpaceID spaceId;
+    PartitionID partId;
+    KVEngine* engine;
+    Peers raftPeers;
+  };
+  std::vector<std::vector<PartToOpen>> partsPerEngine;
   for (auto& spaceEngine : spaceEngines) {
     GraphSpaceID spaceId = spaceEngine.first;
     for (auto& engine : spaceEngine.second) {
@@ -224,68 +294,97 @@ void NebulaStore::loadPartFromDataPath() {
         enginePtr = spaceIt->second->engines_.back().get();
       }
 
-      std::atomic<size_t> counter(partRaftPeers.size());
-      folly::Baton<true, std::atomic> baton;
       LOG(INFO) << "Need to open " << partRaftPeers.size() << " parts of space " << spaceId;
+      std::vector<PartToOpen> engineParts;
+      engineParts.reserve(partRaftPeers.size());
       for (auto& it : partRaftPeers) {
-        auto& partId = it.first;
-        Peers& raftPeers = it.second;
-
-        bgWorkers_->addTask(
-            [spaceId, partId, &raftPeers, enginePtr, &counter, &baton, this]() mutable {
-              // create part
-              bool isLearner = false;
-              std::vector<HostAddr> addrs;  // raft peers
-              for (auto& [addr, raftPeer] : raftPeers.getPeers()) {
-                if (addr == raftAddr_) {  // self
-                  if (raftPeer.status == Peer::Status::kLearner) {
-                    isLearner = true;
-                  }
-                } else {  // others
-                  if (raftPeer.status == Peer::Status::kNormalPeer ||
-                      raftPeer.status == Peer::Status::kPromotedPeer) {
-                    addrs.emplace_back(addr);
-                  }
-                }
-              }
-              auto part = newPart(spaceId, partId, enginePtr, isLearner, addrs);
-              LOG(INFO) << "Load part " << spaceId << ", " << partId << " from disk";
-
-              // add learner peers
-              if (!isLearner) {
-                for (auto& [addr, raftPeer] : raftPeers.getPeers()) {
-                  if (addr == raftAddr_) {
-                    continue;
-                  }
-
-                  if (raftPeer.status == Peer::Status::kLearner) {
-                    part->addLearner(addr, true);
-                  }
-                }
-              }
+        engineParts.emplace_back(PartToOpen{spaceId, it.first, enginePtr, std::move(it.second)});
+      }
+      partsPerEngine.emplace_back(std::move(engineParts));
+    }
+  }
 
-              // add part to space
-              {
-                folly::RWSpinLock::WriteHolder holder(&lock_);
-                auto iter = spaces_.find(spaceId);
-                CHECK(iter != spaces_.end());
-                // Check if part already exists.
-                // Prevent the same part from existing on different dataPaths.
-                auto ret = iter->second->parts_.emplace(partId, part);
-                if (!ret.second) {
-                  LOG(FATAL) << "Part already exists, partId " << partId;
-                }
-              }
-              counter.fetch_sub(1);
-              if (counter.load() == 0) {
-                baton.post();
-              }
-            });
+  // Interleave parts of different engines so the worker pool keeps every disk busy instead
+  // of draining one engine's queue before touching the next
+  std::vector<PartToOpen> partsToOpen;
+  for (size_t round = 0;; ++round) {
+    bool anyLeft = false;
+    for (auto& engineParts : partsPerEngine) {
+      if (round < engineParts.size()) {
+        partsToOpen.emplace_back(std::move(engineParts[round]));
+        anyLeft = true;
       }
-      baton.wait();
-      LOG(INFO) << "Load space " << spaceId << " complete";
+    }
+    if (!anyLeft) {
+      break;
     }
   }
+
+  if (partsToOpen.empty()) {
+    return;
+  }
+  auto loadStartMs = time::WallClock::fastNowInMilliSec();
+  std::atomic<size_t> counter(partsToOpen.size());
+  folly::Baton<true, std::atomic> baton;
+  for (auto& toOpen : partsToOpen) {
+    bgWorkers_->addTask([&toOpen, &counter, &baton, this]() mutable {
+      auto spaceId = toOpen.spaceId;
+      auto partId = toOpen.partId;
+      auto& raftPeers = toOpen.raftPeers;
+      auto partStartMs = time::WallClock::fastNowInMilliSec();
+      // create part
+      bool isLearner = false;
+      std::vector<HostAddr> addrs;  // raft peers
+      for (auto& [addr, raftPeer] : raftPeers.getPeers()) {
+        if (addr == raftAddr_) {  // self
+          if (raftPeer.status == Peer::Status::kLearner) {
+            isLearner = true;
+          }
+        } else {  // others
+          if (raftPeer.status == Peer::Status::kNormalPeer ||
+              raftPeer.status == Peer::Status::kPromotedPeer) {
+            addrs.emplace_back(addr);
+          }
+        }
+      }
+      auto part = newPart(spaceId, partId, toOpen.engine, isLearner, addrs);
+      LOG(INFO) << "Load part " << spaceId << ", " << partId << " from disk in "
+                << time::WallClock::fastNowInMilliSec() - partStartMs << " ms";
+
+      // add learner peers
+      if (!isLearner) {
+        for (auto& [addr, raftPeer] : raftPeers.getPeers()) {
+          if (addr == raftAddr_) {
+            continue;
+          }
+
+          if (raftPeer.status == Peer::Status::kLearner) {
+            part->addLearner(addr, true);
+          }
+        }
+      }
+
+      // add part to space
+      {
+        folly::RWSpinLock::WriteHolder holder(&lock_);
+        auto iter = spaces_.find(spaceId);
+        CHECK(iter != spaces_.end());
+        // Check if part already exists.
+        // Prevent the same part from existing on different dataPaths.
+        auto ret = iter->second->parts_.emplace(partId, part);
+        if (!ret.second) {
+          LOG(FATAL) << "Part already exists, partId " << partId;
+        }
+      }
+      counter.fetch_sub(1);
+      if (counter.load() == 0) {
+        baton.post();
+      }
+    });
+  }
+  baton.wait();
+  LOG(INFO) << "Load all " << partsToOpen.size() << " parts from disk in "
+            << time::WallClock::fastNowInMilliSec() - loadStartMs << " ms";
 }
 
 void NebulaStore::loadPartFromPartManager() {
@@ -377,6 +476,16 @@ std::unique_ptr<KVEngine> NebulaStore::newEngine(GraphSpaceID spaceId,
   return std::move(pair.second);
 }
 
+const std::string& NebulaStore::walPath(const std::string& dataPath) const {
+  if (!options_.walPaths_.empty()) {
+    auto iter = std::find(options_.dataPaths_.begin(), options_.dataPaths_.end(), dataPath);
+    if (iter != options_.dataPaths_.end()) {
+      return options_.walPaths_[iter - options_.dataPaths_.begin()];
+    }
+  }
+  return options_.walPath_;
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, HostAddr> NebulaStore::partLeader(GraphSpaceID spaceId,
                                                                    PartitionID partId) {
   folly::RWSpinLock::ReadHolder rh(&lock_);
@@ -410,14 +519,14 @@ void NebulaStore::addSpace(GraphSpaceID spaceId) {
         }
       }
       if (!engineExist) {
-        spaces_[spaceId]->engines_.emplace_back(newEngine(spaceId, path, options_.walPath_));
+        spaces_[spaceId]->engines_.emplace_back(newEngine(spaceId, path, walPath(path)));
       }
     }
   } else {
     LOG(INFO) << "Create data space " << spaceId;
     this->spaces_[spaceId] = std::make_unique<SpacePartInfo>();
     for (auto& path : options_.dataPaths_) {
-      this->spaces_[spaceId]->engines_.emplace_back(newEngine(spaceId, path, options_.walPath_));
+      this->spaces_[spaceId]->engines_.emplace_back(newEngine(spaceId, path, walPath(path)));
     }
   }
 }
@@ -562,6 +671,71 @@ void NebulaStore::removeSpace(GraphSpaceID spaceId) {
   LOG(INFO) << "Data space " << spaceId << " has been removed!";
 }
 
+nebula::cpp2::ErrorCode NebulaStore::cloneSpace(GraphSpaceID oldSpaceId, GraphSpaceID newSpaceId) {
+  folly::RWSpinLock::WriteHolder wh(&lock_);
+  auto spaceIt = this->spaces_.find(oldSpaceId);
+  if (spaceIt == this->spaces_.end()) {
+    return nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND;
+  }
+  if (this->spaces_.find(newSpaceId) != this->spaces_.end()) {
+    // A retried clone request, the space is already here
+    LOG(INFO) << "Data space " << newSpaceId << " has existed!";
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  auto spaceInfo = std::make_unique<SpacePartInfo>();
+  for (auto& path : options_.dataPaths_) {
+    auto oldDataRoot = folly::stringPrintf("%s/nebula/%d", path.c_str(), oldSpaceId);
+    KVEngine* oldEngine = nullptr;
+    for (auto& engine : spaceIt->second->engines_) {
+      if (oldDataRoot.compare(engine->getDataRoot()) == 0) {
+        oldEngine = engine.get();
+        break;
+      }
+    }
+    if (oldEngine == nullptr) {
+      continue;
+    }
+
+    // The checkpoint hard-links the sst files into the new space's data dir on the same
+    // filesystem, so the clone costs metadata only and the spaces diverge copy-on-write
+    // as compactions rewrite files on either side
+    auto newDataRoot = folly::stringPrintf("%s/nebula/%d", path.c_str(), newSpaceId);
+    if (!fs::FileUtils::makeDir(newDataRoot)) {
+      LOG(ERROR) << "Failed to create the data dir of the cloned space: " << newDataRoot;
+      return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+    }
+    auto code = oldEngine->createCheckpoint(folly::stringPrintf("%s/data", newDataRoot.c_str()));
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      LOG(ERROR) << "Failed to checkpoint space " << oldSpaceId << " into space " << newSpaceId
+                 << " under " << path;
+      return code;
+    }
+
+    auto newEngine = this->newEngine(newSpaceId, path, walPath(path));
+    // The cloned engine still carries the raft commit state of the old space's parts. Strip
+    // it so each part of the new space bootstraps a fresh raft group over the snapshot data
+    // when the part manager adds it, instead of believing it has committed logs it never saw.
+    for (auto partId : newEngine->allParts()) {
+      code = newEngine->remove(NebulaKeyUtils::systemCommitKey(partId));
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(ERROR) << "Failed to reset the raft state of part " << partId
+                   << " of the cloned space " << newSpaceId;
+        return code;
+      }
+    }
+    spaceInfo->engines_.emplace_back(std::move(newEngine));
+  }
+
+  if (spaceInfo->engines_.empty()) {
+    LOG(ERROR) << "No engine of space " << oldSpaceId << " was cloned";
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+  this->spaces_[newSpaceId] = std::move(spaceInfo);
+  LOG(INFO) << "Space " << oldSpaceId << " has been cloned into space " << newSpaceId;
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 nebula::cpp2::ErrorCode NebulaStore::clearSpace(GraphSpaceID spaceId) {
   folly::RWSpinLock::ReadHolder rh(&lock_);
   auto spaceIt = this->spaces_.find(spaceId);
@@ -573,6 +747,24 @@ nebula::cpp2::ErrorCode NebulaStore::clearSpace(GraphSpaceID spaceId) {
         return ret;
       }
     }
+    // The cleanup above only writes range tombstones. Flush them out of the memtable, then
+    // drop the obsolete sst files and compact the boundaries, so the clear reclaims disk
+    // space at once instead of dragging down reads and compaction for days afterwards
+    for (auto& engine : spaceIt->second->engines_) {
+      auto ret = engine->flush();
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(ERROR) << "flush failed when clearing space " << spaceId;
+        return ret;
+      }
+    }
+    for (auto& part : spaceIt->second->parts_) {
+      auto ret = part.second->cleanupFilesSafely();
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(ERROR) << "partition file clear failed. space: " << spaceId
+                   << ", part: " << part.first;
+        return ret;
+      }
+    }
   } else {
     return nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND;
   }
@@ -662,6 +854,9 @@ std::shared_ptr<Listener> NebulaStore::newListener(GraphSpaceID spaceId,
   if (type == meta::cpp2::ListenerType::ELASTICSEARCH) {
     listener = std::make_shared<ESListener>(
         spaceId, partId, raftAddr_, walPath, ioPool_, bgWorkers_, workers_, options_.schemaMan_);
+  } else if (type == meta::cpp2::ListenerType::CDC) {
+    listener = std::make_shared<CDCListener>(
+        spaceId, partId, raftAddr_, walPath, ioPool_, bgWorkers_, workers_, options_.schemaMan_);
   } else {
     LOG(FATAL) << "Should not reach here";
     return nullptr;
@@ -750,6 +945,17 @@ void NebulaStore::removeSpaceDir(const std::string& dir) {
   }
 }
 
+namespace {
+
+// readahead_size to use for a scan on the given part, 0 keeps the engine default
+size_t hotReadahead(const std::shared_ptr<Part>& part) {
+  return FLAGS_enable_part_read_hinting && part->isHot()
+             ? static_cast<size_t>(FLAGS_hot_part_readahead_bytes)
+             : 0;
+}
+
+}  // namespace
+
 nebula::cpp2::ErrorCode NebulaStore::get(GraphSpaceID spaceId,
                                          PartitionID partId,
                                          const std::string& key,
@@ -765,6 +971,43 @@ nebula::cpp2::ErrorCode NebulaStore::get(GraphSpaceID spaceId,
     return part->isLeader() ? nebula::cpp2::ErrorCode::E_LEADER_LEASE_FAILED
                             : nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
+  if (FLAGS_enable_part_read_hinting) {
+    part->recordRead();
+  }
+  return part->engine()->get(key, value, snapshot);
+}
+
+nebula::cpp2::ErrorCode NebulaStore::exists(GraphSpaceID spaceId,
+                                            PartitionID partId,
+                                            const std::string& key,
+                                            bool* found,
+                                            bool canReadFromFollower) {
+  auto ret = part(spaceId, partId);
+  if (!ok(ret)) {
+    return error(ret);
+  }
+  auto part = nebula::value(ret);
+  if (!checkLeader(part, canReadFromFollower)) {
+    return part->isLeader() ? nebula::cpp2::ErrorCode::E_LEADER_LEASE_FAILED
+                            : nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+  }
+  return part->engine()->exists(key, found);
+}
+
+nebula::cpp2::ErrorCode NebulaStore::boundedStalenessGet(GraphSpaceID spaceId,
+                                                         PartitionID partId,
+                                                         const std::string& key,
+                                                         std::string* value,
+                                                         const void* snapshot) {
+  auto ret = part(spaceId, partId);
+  if (!ok(ret)) {
+    return error(ret);
+  }
+  auto part = nebula::value(ret);
+  if (!checkFollowerRead(part)) {
+    // too stale, ask the caller to read from the leader instead
+    return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+  }
   return part->engine()->get(key, value, snapshot);
 }
 
@@ -803,6 +1046,9 @@ std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> NebulaStore::multiGet(
   if (!checkLeader(part, canReadFromFollower)) {
     return {nebula::cpp2::ErrorCode::E_LEADER_CHANGED, status};
   }
+  if (FLAGS_enable_part_read_hinting) {
+    part->recordRead();
+  }
   status = part->engine()->multiGet(keys, values);
   auto allExist = std::all_of(status.begin(), status.end(), [](const auto& s) { return s.ok(); });
   if (allExist) {
@@ -812,6 +1058,32 @@ std::pair<nebula::cpp2::ErrorCode, std::vector<Status>> NebulaStore::multiGet(
   }
 }
 
+folly::SemiFuture<std::pair<nebula::cpp2::ErrorCode, std::string>> NebulaStore::asyncGet(
+    GraphSpaceID spaceId, PartitionID partId, std::string key, bool canReadFromFollower) {
+  return folly::via(workers_.get(),
+                    [this, spaceId, partId, key = std::move(key), canReadFromFollower]() {
+                      std::string value;
+                      auto ret = get(spaceId, partId, key, &value, canReadFromFollower);
+                      return std::make_pair(ret, std::move(value));
+                    })
+      .semi();
+}
+
+folly::SemiFuture<KVStore::AsyncMultiGetResult> NebulaStore::asyncMultiGet(
+    GraphSpaceID spaceId,
+    PartitionID partId,
+    std::vector<std::string> keys,
+    bool canReadFromFollower) {
+  return folly::via(workers_.get(),
+                    [this, spaceId, partId, keys = std::move(keys), canReadFromFollower]() {
+                      std::vector<std::string> values;
+                      auto ret = multiGet(spaceId, partId, keys, &values, canReadFromFollower);
+                      return AsyncMultiGetResult(
+                          ret.first, std::move(ret.second), std::move(values));
+                    })
+      .semi();
+}
+
 nebula::cpp2::ErrorCode NebulaStore::range(GraphSpaceID spaceId,
                                            PartitionID partId,
                                            const std::string& start,
@@ -826,7 +1098,10 @@ nebula::cpp2::ErrorCode NebulaStore::range(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->range(start, end, iter);
+  if (FLAGS_enable_part_read_hinting) {
+    part->recordRead();
+  }
+  return part->engine()->range(start, end, iter, hotReadahead(part));
 }
 
 nebula::cpp2::ErrorCode NebulaStore::prefix(GraphSpaceID spaceId,
@@ -843,7 +1118,30 @@ nebula::cpp2::ErrorCode NebulaStore::prefix(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->prefix(prefix, iter, snapshot);
+  if (FLAGS_enable_part_read_hinting) {
+    part->recordRead();
+  }
+  return part->engine()->prefix(prefix, iter, snapshot, hotReadahead(part));
+}
+
+nebula::cpp2::ErrorCode NebulaStore::boundedStalenessPrefix(GraphSpaceID spaceId,
+                                                            PartitionID partId,
+                                                            const std::string& prefix,
+                                                            std::unique_ptr<KVIterator>* iter,
+                                                            const void* snapshot) {
+  auto ret = part(spaceId, partId);
+  if (!ok(ret)) {
+    return error(ret);
+  }
+  auto part = nebula::value(ret);
+  if (!checkFollowerRead(part)) {
+    // too stale, ask the caller to read from the leader instead
+    return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+  }
+  if (FLAGS_enable_part_read_hinting) {
+    part->recordRead();
+  }
+  return part->engine()->prefix(prefix, iter, snapshot, hotReadahead(part));
 }
 
 nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
@@ -860,7 +1158,10 @@ nebula::cpp2::ErrorCode NebulaStore::rangeWithPrefix(GraphSpaceID spaceId,
   if (!checkLeader(part, canReadFromFollower)) {
     return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
   }
-  return part->engine()->rangeWithPrefix(start, prefix, iter);
+  if (FLAGS_enable_part_read_hinting) {
+    part->recordRead();
+  }
+  return part->engine()->rangeWithPrefix(start, prefix, iter, hotReadahead(part));
 }
 
 nebula::cpp2::ErrorCode NebulaStore::sync(GraphSpaceID spaceId, PartitionID partId) {
@@ -886,6 +1187,10 @@ void NebulaStore::asyncAppendBatch(GraphSpaceID spaceId,
                                    PartitionID partId,
                                    std::string&& batch,
                                    KVCallback cb) {
+  if (isWriteStalled(spaceId)) {
+    cb(nebula::cpp2::ErrorCode::E_WRITE_STALLED);
+    return;
+  }
   auto ret = part(spaceId, partId);
   if (!ok(ret)) {
     cb(error(ret));
@@ -899,6 +1204,12 @@ void NebulaStore::asyncMultiPut(GraphSpaceID spaceId,
                                 PartitionID partId,
                                 std::vector<KV>&& keyValues,
                                 KVCallback cb) {
+  if (isWriteStalled(spaceId)) {
+    // Fail fast before the write enters raft, so the client backs off while the engine
+    // drains instead of piling logs onto the shared apply threads
+    cb(nebula::cpp2::ErrorCode::E_WRITE_STALLED);
+    return;
+  }
   auto ret = part(spaceId, partId);
   if (!ok(ret)) {
     cb(error(ret));
@@ -1096,6 +1407,20 @@ nebula::cpp2::ErrorCode NebulaStore::flush(GraphSpaceID spaceId) {
 
 ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::CheckpointInfo>> NebulaStore::createCheckpoint(
     GraphSpaceID spaceId, const std::string& name) {
+  return createCheckpointImpl(spaceId, name, nullptr);
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::CheckpointInfo>>
+NebulaStore::createIncrementalCheckpoint(GraphSpaceID spaceId,
+                                         const std::string& name,
+                                         const std::unordered_map<PartitionID, LogID>& sinceLogIds) {
+  return createCheckpointImpl(spaceId, name, &sinceLogIds);
+}
+
+ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::CheckpointInfo>> NebulaStore::createCheckpointImpl(
+    GraphSpaceID spaceId,
+    const std::string& name,
+    const std::unordered_map<PartitionID, LogID>* sinceLogIds) {
   /*
    * The default checkpoint directory structure is :
    *   |--FLAGS_data_path
@@ -1128,11 +1453,13 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::CheckpointInfo>> NebulaStore:
       }
     }
 
-    // create data checkpoint
-    std::string dataPath = folly::sformat("{}/data", path);
-    auto code = engine->createCheckpoint(dataPath);
-    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
-      return code;
+    // create data checkpoint; an incremental checkpoint ships only the wal tail
+    if (sinceLogIds == nullptr) {
+      std::string dataPath = folly::sformat("{}/data", path);
+      auto code = engine->createCheckpoint(dataPath);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return code;
+      }
     }
 
     // create wal checkpoints: make hard link for all parts
@@ -1148,7 +1475,14 @@ ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::CheckpointInfo>> NebulaStore:
 
       auto p = nebula::value(ret);
       auto walPath = folly::sformat("{}/wal/{}", path, partId);
-      if (!p->linkCurrentWAL(walPath.data())) {
+      LogID sinceLogId = 0;
+      if (sinceLogIds != nullptr) {
+        auto logIdIter = sinceLogIds->find(partId);
+        if (logIdIter != sinceLogIds->end()) {
+          sinceLogId = logIdIter->second;
+        }
+      }
+      if (!p->linkCurrentWAL(walPath.data(), sinceLogId)) {
         return nebula::cpp2::ErrorCode::E_FAILED_TO_CHECKPOINT;
       }
 
@@ -1297,6 +1631,13 @@ bool NebulaStore::checkLeader(std::shared_ptr<Part> part, bool canReadFromFollow
   return canReadFromFollower || (part->isLeader() && part->leaseValid());
 }
 
+bool NebulaStore::checkFollowerRead(std::shared_ptr<Part> part) const {
+  if (part->isLeader() && part->leaseValid()) {
+    return true;
+  }
+  return part->committedWithin(FLAGS_follower_read_max_lag_logs);
+}
+
 void NebulaStore::cleanWAL() {
   folly::RWSpinLock::ReadHolder rh(&lock_);
   SCOPE_EXIT {
@@ -1339,6 +1680,154 @@ nebula::cpp2::ErrorCode NebulaStore::backup() {
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+void NebulaStore::reportSecondaryCacheStats() {
+  auto stats = getDBStatistics();
+  if (stats == nullptr) {
+    return;
+  }
+  // the rocksdb tickers are cumulative, report the delta since the last run
+  static uint64_t lastHits = 0;
+  static uint64_t lastMisses = 0;
+  auto hits = stats->getTickerCount(rocksdb::PERSISTENT_CACHE_HIT);
+  auto misses = stats->getTickerCount(rocksdb::PERSISTENT_CACHE_MISS);
+  stats::StatsManager::addValue(kNumSecondaryCacheHits, hits - lastHits);
+  stats::StatsManager::addValue(kNumSecondaryCacheMisses, misses - lastMisses);
+  lastHits = hits;
+  lastMisses = misses;
+}
+
+void NebulaStore::rebalanceCompactionBudget() {
+  auto bulkLimiter = compactionThreadLimiter(true);
+  auto servingLimiter = compactionThreadLimiter(false);
+  if (bulkLimiter == nullptr || servingLimiter == nullptr || bulkLimiter == servingLimiter) {
+    return;
+  }
+  int32_t maxLevel0Files = 0;
+  {
+    folly::RWSpinLock::ReadHolder rh(&lock_);
+    for (const auto& spaceEntry : spaces_) {
+      if (isBulkLoadSpace(spaceEntry.first)) {
+        continue;
+      }
+      for (const auto& engine : spaceEntry.second->engines_) {
+        auto ret = engine->getProperty("rocksdb.num-files-at-level0");
+        if (!ok(ret)) {
+          continue;
+        }
+        auto files = folly::tryTo<int32_t>(nebula::value(ret));
+        if (files.hasValue()) {
+          maxLevel0Files = std::max(maxLevel0Files, files.value());
+        }
+      }
+    }
+  }
+  // While any query serving space has L0 pressure, squeeze the bulk load spaces to one
+  // compaction thread and hand the freed threads to the serving spaces, so their L0->L1
+  // compactions which block foreground reads drain first.
+  static bool squeezed = false;
+  bool pressure = maxLevel0Files >= FLAGS_compaction_l0_pressure_files;
+  if (pressure == squeezed) {
+    return;
+  }
+  squeezed = pressure;
+  int32_t total = FLAGS_num_compaction_threads;
+  int32_t bulk = std::max(1, std::min(FLAGS_num_bulk_load_compaction_threads, total - 1));
+  if (squeezed) {
+    bulkLimiter->SetMaxOutstandingTask(1);
+    servingLimiter->SetMaxOutstandingTask(total - 1);
+    LOG(INFO) << "A query serving space has " << maxLevel0Files
+              << " files at L0, squeeze bulk load compactions to 1 thread";
+  } else {
+    bulkLimiter->SetMaxOutstandingTask(bulk);
+    servingLimiter->SetMaxOutstandingTask(total - bulk);
+    LOG(INFO) << "L0 pressure drained, restore bulk load compactions to " << bulk << " threads";
+  }
+}
+
+void NebulaStore::refreshHotParts() {
+  std::vector<std::pair<std::shared_ptr<Part>, uint64_t>> loads;
+  {
+    folly::RWSpinLock::ReadHolder rh(&lock_);
+    for (const auto& spaceEntry : spaces_) {
+      for (const auto& partEntry : spaceEntry.second->parts_) {
+        loads.emplace_back(partEntry.second, partEntry.second->takeReadCount());
+      }
+    }
+  }
+  uint64_t total = 0;
+  for (const auto& load : loads) {
+    total += load.second;
+  }
+  if (total == 0) {
+    // keep the previous hot set, an idle interval carries no signal
+    return;
+  }
+  std::sort(loads.begin(), loads.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.second > rhs.second;
+  });
+  // The hot set is the smallest group of parts covering part_hot_set_coverage of the
+  // reads of the last interval
+  auto threshold = static_cast<uint64_t>(total * FLAGS_part_hot_set_coverage);
+  uint64_t covered = 0;
+  size_t numHot = 0;
+  for (auto& [part, reads] : loads) {
+    bool hot = covered < threshold && reads > 0;
+    covered += reads;
+    if (hot) {
+      numHot++;
+      if (!part->isHot()) {
+        // A part entering the hot set gets its data ranges suggested to compaction, so
+        // its read amplification drains ahead of cold-part compaction work
+        auto partId = part->partitionId();
+        for (const auto& prefix :
+             {NebulaKeyUtils::tagPrefix(partId), NebulaKeyUtils::edgePrefix(partId)}) {
+          auto end = prefix;
+          // our part prefixes never end in 0xFF, the increment cannot carry
+          end.back()++;
+          part->engine()->suggestCompactRange(prefix, end);
+        }
+      }
+    }
+    part->setHot(hot);
+  }
+  VLOG(1) << "Hot part set refreshed, " << numHot << " of " << loads.size()
+          << " parts cover " << covered << " of " << total << " reads";
+}
+
+void NebulaStore::checkWriteStall() {
+  folly::RWSpinLock::ReadHolder rh(&lock_);
+  for (auto& spaceEntry : spaces_) {
+    bool stalled = false;
+    for (auto& engine : spaceEntry.second->engines_) {
+      auto delayed = engine->getProperty("rocksdb.actual-delayed-write-rate");
+      if (ok(delayed) && folly::tryTo<int64_t>(value(delayed)).value_or(0) > 0) {
+        stalled = true;
+        break;
+      }
+      auto stopped = engine->getProperty("rocksdb.is-write-stopped");
+      if (ok(stopped) && folly::tryTo<int64_t>(value(stopped)).value_or(0) > 0) {
+        stalled = true;
+        break;
+      }
+    }
+    if (spaceEntry.second->writeStalled_.load(std::memory_order_relaxed) != stalled) {
+      LOG(INFO) << "Space " << spaceEntry.first << (stalled ? " entered" : " left")
+                << " rocksdb write stall";
+    }
+    spaceEntry.second->writeStalled_.store(stalled, std::memory_order_relaxed);
+  }
+}
+
+bool NebulaStore::isWriteStalled(GraphSpaceID spaceId) {
+  if (FLAGS_write_stall_check_interval_ms <= 0) {
+    return false;
+  }
+  folly::RWSpinLock::ReadHolder rh(&lock_);
+  auto spaceIt = spaces_.find(spaceId);
+  return spaceIt != spaces_.end() &&
+         spaceIt->second->writeStalled_.load(std::memory_order_relaxed);
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::vector<std::string>> NebulaStore::backupTable(
     GraphSpaceID spaceId,
     const std::string& name,
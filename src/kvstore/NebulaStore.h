@@ -36,6 +36,9 @@ struct SpacePartInfo {
 
   std::unordered_map<PartitionID, std::shared_ptr<Part>> parts_;
   std::vector<std::unique_ptr<KVEngine>> engines_;
+  // Whether any engine of this space currently delays or stops writes, refreshed
+  // periodically by NebulaStore::checkWriteStall()
+  std::atomic<bool> writeStalled_{false};
 };
 
 struct SpaceListenerInfo {
@@ -221,6 +224,23 @@ class NebulaStore : public KVStore, public Handler {
                               bool canReadFromFollower = false,
                               const void* snapshot = nullptr) override;
 
+  /**
+   * @brief Check whether a key exists without retrieving its value, answered from the
+   * engine's bloom filter whenever possible
+   *
+   * @param spaceId
+   * @param partId
+   * @param key
+   * @param found Set to whether the key exists
+   * @param canReadFromFollower
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode exists(GraphSpaceID spaceId,
+                                 PartitionID partId,
+                                 const std::string& key,
+                                 bool* found,
+                                 bool canReadFromFollower = false) override;
+
   /**
    * @brief Read a list of keys
    *
@@ -240,6 +260,25 @@ class NebulaStore : public KVStore, public Handler {
       std::vector<std::string>* values,
       bool canReadFromFollower = false) override;
 
+  /**
+   * @brief Asynchronous get, the read runs on the store's worker pool so the calling thread is
+   * free to issue reads of other partitions and overlap the I/O.
+   */
+  folly::SemiFuture<std::pair<nebula::cpp2::ErrorCode, std::string>> asyncGet(
+      GraphSpaceID spaceId,
+      PartitionID partId,
+      std::string key,
+      bool canReadFromFollower = false) override;
+
+  /**
+   * @brief Asynchronous multiGet, same result convention as multiGet, the read runs on the
+   * store's worker pool.
+   */
+  folly::SemiFuture<AsyncMultiGetResult> asyncMultiGet(GraphSpaceID spaceId,
+                                                       PartitionID partId,
+                                                       std::vector<std::string> keys,
+                                                       bool canReadFromFollower = false) override;
+
   /**
    * @brief Get all results in range [start, end)
    *
@@ -295,6 +334,28 @@ class NebulaStore : public KVStore, public Handler {
                                  bool canReadFromFollower = false,
                                  const void* snapshot = nullptr) override = delete;
 
+  /**
+   * @brief Read a single key from whatever replica is local, leader or not, as long as the
+   * replica lags the leader's advertised commit point by no more than
+   * FLAGS_follower_read_max_lag_logs. Returns E_LEADER_CHANGED when the local replica is too
+   * stale, so the caller can fall back to routing the read to the leader.
+   */
+  nebula::cpp2::ErrorCode boundedStalenessGet(GraphSpaceID spaceId,
+                                              PartitionID partId,
+                                              const std::string& key,
+                                              std::string* value,
+                                              const void* snapshot = nullptr);
+
+  /**
+   * @brief Get all results with 'prefix' str as prefix from whatever replica is local, with the
+   * same staleness bound and fallback convention as boundedStalenessGet.
+   */
+  nebula::cpp2::ErrorCode boundedStalenessPrefix(GraphSpaceID spaceId,
+                                                 PartitionID partId,
+                                                 const std::string& prefix,
+                                                 std::unique_ptr<KVIterator>* iter,
+                                                 const void* snapshot = nullptr);
+
   /**
    * @brief Get all results with 'prefix' str as prefix starting form 'start'
    *
@@ -484,6 +545,24 @@ class NebulaStore : public KVStore, public Handler {
   ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::CheckpointInfo>> createCheckpoint(
       GraphSpaceID spaceId, const std::string& name) override;
 
+  /**
+   * @brief Create an incremental checkpoint: no rocksdb checkpoint is taken, only the wal
+   * files holding logs after the given baseline are hard linked per part. Restoring such a
+   * checkpoint means placing the shipped wal files into the part's wal directory on top of
+   * the last full checkpoint, the logs are replayed on part start.
+   *
+   * @param spaceId
+   * @param name Checkpoint name
+   * @param sinceLogIds The committed log id each part reported at the previous backup; a part
+   * missing from the map gets all of its wal files linked
+   * @return ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::CheckpointInfo>> Return the
+   * checkpoint info if succeed, else return ErrorCode
+   */
+  ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::CheckpointInfo>> createIncrementalCheckpoint(
+      GraphSpaceID spaceId,
+      const std::string& name,
+      const std::unordered_map<PartitionID, LogID>& sinceLogIds);
+
   /**
    * @brief Trigger kv engine's backup, mainly for rocksdb PlainTable mounted on tmpfs/ramfs
    *
@@ -491,6 +570,39 @@ class NebulaStore : public KVStore, public Handler {
    */
   nebula::cpp2::ErrorCode backup();
 
+  /**
+   * @brief Report rocksdb secondary block cache hits and misses to the stats manager, runs
+   * periodically on the store worker when the secondary cache is enabled
+   */
+  void reportSecondaryCacheStats();
+
+  /**
+   * @brief Rebalance the shared compaction thread budget between the query serving and the bulk
+   * load spaces, runs periodically on the store worker when both priority classes are configured
+   */
+  void rebalanceCompactionBudget();
+
+  /**
+   * @brief Drain the per-part read counters and recompute the hot part set, suggesting the
+   * data ranges of newly hot parts for compaction. Runs periodically on the store worker
+   * when enable_part_read_hinting is on
+   */
+  void refreshHotParts();
+
+  /**
+   * @brief Poll rocksdb.actual-delayed-write-rate / rocksdb.is-write-stopped of every space's
+   * engines and cache the stall state, runs periodically on the store worker when
+   * write_stall_check_interval_ms is positive
+   */
+  void checkWriteStall();
+
+  /**
+   * @brief Whether bulk writes to the space should be rejected with E_WRITE_STALLED because
+   * one of its engines is already delaying or stopping writes. Always false when the stall
+   * check is disabled
+   */
+  bool isWriteStalled(GraphSpaceID spaceId);
+
   /**
    * @brief Drop a Checkpoint, only used in rocksdb
    *
@@ -572,6 +684,19 @@ class NebulaStore : public KVStore, public Handler {
    */
   nebula::cpp2::ErrorCode clearSpace(GraphSpaceID spaceId) override;
 
+  /**
+   * @brief Clone the data of one space into another via rocksdb checkpoint hard links, so the
+   * clone costs O(metadata) and the two spaces diverge copy-on-write at the sst level. The per
+   * part raft state (committed log id) is stripped from the cloned engines, the parts of the
+   * new space then bootstrap fresh raft groups on top of the snapshot when the part manager
+   * adds them. The new space must not exist on this host yet.
+   *
+   * @param oldSpaceId space to clone from, must exist on this host
+   * @param newSpaceId space to clone into
+   * @return
+   */
+  nebula::cpp2::ErrorCode cloneSpace(GraphSpaceID oldSpaceId, GraphSpaceID newSpaceId);
+
   /**
    * @brief Remove a partition, called from part manager
    *
@@ -743,6 +868,14 @@ class NebulaStore : public KVStore, public Handler {
   }
 
  private:
+  /**
+   * @brief Shared body of the full and incremental checkpoint, sinceLogIds selects the mode
+   */
+  ErrorOr<nebula::cpp2::ErrorCode, std::vector<cpp2::CheckpointInfo>> createCheckpointImpl(
+      GraphSpaceID spaceId,
+      const std::string& name,
+      const std::unordered_map<PartitionID, LogID>* sinceLogIds);
+
   /**
    * @brief Load partitions by reading system part keys in kv engine
    */
@@ -797,6 +930,15 @@ class NebulaStore : public KVStore, public Handler {
                                       const std::string& dataPath,
                                       const std::string& walPath);
 
+  /**
+   * @brief Wal root for the engine on the given data path: the paired entry of
+   * walPaths_ when dedicated wal devices are configured, the shared walPath_ otherwise
+   *
+   * @param dataPath One entry of options_.dataPaths_
+   * @return const std::string& Wal root, empty means wal lives beside the data
+   */
+  const std::string& walPath(const std::string& dataPath) const;
+
   /**
    * @brief Start a new part
    *
@@ -846,6 +988,16 @@ class NebulaStore : public KVStore, public Handler {
    */
   bool checkLeader(std::shared_ptr<Part> part, bool canReadFromFollower = false) const;
 
+  /**
+   * @brief Check if the partition could serve a bounded-staleness read, either as leader with a
+   * valid lease or as a follower/learner within FLAGS_follower_read_max_lag_logs of the leader's
+   * advertised commit point
+   *
+   * @param part
+   * @return True if the local replica is fresh enough to read from
+   */
+  bool checkFollowerRead(std::shared_ptr<Part> part) const;
+
   /**
    * @brief clean useless wal
    */
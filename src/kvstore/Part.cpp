@@ -5,6 +5,13 @@
 
 #include "kvstore/Part.h"
 
+#include <folly/executors/CPUThreadPoolExecutor.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <folly/futures/Future.h>
+#include <folly/hash/Hash.h>
+#include <rocksdb/sst_file_writer.h>
+
+#include "common/fs/FileUtils.h"
 #include "common/time/ScopedTimer.h"
 #include "common/utils/IndexKeyUtils.h"
 #include "common/utils/MetaKeyUtils.h"
@@ -17,9 +24,38 @@
 
 DEFINE_int32(cluster_id, 0, "A unique id for each cluster");
 
+DEFINE_int32(group_commit_window_us,
+             0,
+             "Microseconds to coalesce concurrent asyncMultiPut batches of one part into a "
+             "single raft log entry. 0 means group commit is disabled.");
+
+DEFINE_int32(raft_apply_concurrency,
+             0,
+             "Number of write batches the committed logs of one part are hash-partitioned into "
+             "and applied in parallel. 0 or 1 keeps the single-batch serial apply.");
+
+DEFINE_bool(snapshot_ingest_sst,
+            false,
+            "Write received raft snapshot rows into sst files and ingest them when the snapshot "
+            "completes, instead of writing every batch through the memtable.");
+
 namespace nebula {
 namespace kvstore {
 
+namespace {
+
+// Shared by all parts, applying the extra shard batches of commitLogs. A dedicated pool
+// instead of the raft handlers, so a part blocked waiting for its shards can never starve
+// the threads those shards need to run on.
+folly::Executor* applyExecutor() {
+  static folly::CPUThreadPoolExecutor executor(
+      std::max(1, FLAGS_raft_apply_concurrency - 1),
+      std::make_shared<folly::NamedThreadFactory>("part-apply"));
+  return &executor;
+}
+
+}  // namespace
+
 Part::Part(GraphSpaceID spaceId,
            PartitionID partId,
            HostAddr localAddr,
@@ -49,6 +85,24 @@ Part::Part(GraphSpaceID spaceId,
       engine_(engine),
       vIdLen_(vIdLen) {}
 
+// One sorted sst file per sender stream: a batch is appended to the first file whose last
+// key precedes it, so interleaved sub-range streams do not force a new file per batch.
+struct Part::SnapshotSstFiles {
+  struct Stream {
+    std::unique_ptr<rocksdb::SstFileWriter> writer;
+    std::string path;
+    std::string lastKey;
+  };
+  std::string dir;
+  std::vector<Stream> streams;
+  int32_t nextFileId{0};
+};
+
+Part::~Part() {
+  cleanupSnapshotSst();
+  LOG(INFO) << idStr_ << "~Part()";
+}
+
 std::pair<LogID, TermID> Part::lastCommittedLogId() {
   std::string val;
   auto res = engine_->get(NebulaKeyUtils::systemCommitKey(partId_), &val);
@@ -81,11 +135,50 @@ void Part::asyncAppendBatch(std::string&& batch, KVCallback cb) {
 }
 
 void Part::asyncMultiPut(const std::vector<KV>& keyValues, KVCallback cb) {
+  if (FLAGS_group_commit_window_us <= 0) {
+    std::string log = encodeMultiValues(OP_MULTI_PUT, keyValues);
+
+    appendAsync(FLAGS_cluster_id, std::move(log))
+        .thenValue(
+            [callback = std::move(cb)](nebula::cpp2::ErrorCode code) mutable { callback(code); });
+    return;
+  }
+
+  bool firstInWindow = false;
+  {
+    std::lock_guard<std::mutex> g(groupCommitLock_);
+    groupCommitKVs_.insert(groupCommitKVs_.end(), keyValues.begin(), keyValues.end());
+    groupCommitCbs_.emplace_back(std::move(cb));
+    firstInWindow = groupCommitCbs_.size() == 1;
+  }
+  // the first batch of a window schedules the flush, later batches just pile up on it
+  if (firstInWindow) {
+    auto self = std::static_pointer_cast<Part>(shared_from_this());
+    folly::futures::sleep(std::chrono::microseconds(FLAGS_group_commit_window_us))
+        .via(executor_.get())
+        .thenValue([self = std::move(self)](auto&&) { self->flushGroupCommit(); });
+  }
+}
+
+void Part::flushGroupCommit() {
+  std::vector<KV> keyValues;
+  std::vector<KVCallback> callbacks;
+  {
+    std::lock_guard<std::mutex> g(groupCommitLock_);
+    keyValues.swap(groupCommitKVs_);
+    callbacks.swap(groupCommitCbs_);
+  }
+  if (callbacks.empty()) {
+    return;
+  }
   std::string log = encodeMultiValues(OP_MULTI_PUT, keyValues);
 
   appendAsync(FLAGS_cluster_id, std::move(log))
-      .thenValue(
-          [callback = std::move(cb)](nebula::cpp2::ErrorCode code) mutable { callback(code); });
+      .thenValue([callbacks = std::move(callbacks)](nebula::cpp2::ErrorCode code) mutable {
+        for (auto& callback : callbacks) {
+          callback(code);
+        }
+      });
 }
 
 void Part::asyncRemove(folly::StringPiece key, KVCallback cb) {
@@ -205,6 +298,10 @@ void Part::registerOnLeaderLost(LeaderChangeCB cb) {
   leaderLostCB_.emplace_back(std::move(cb));
 }
 
+void Part::setApplyKeyHook(ApplyKeyHook hook) {
+  applyKeyHook_ = std::move(hook);
+}
+
 void Part::onDiscoverNewLeader(HostAddr nLeader) {
   VLOG(2) << idStr_ << "Find the new leader " << nLeader;
   if (newLeaderCb_) {
@@ -219,7 +316,97 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
   SCOPED_TIMER([](uint64_t elapsedTime) {
     stats::StatsManager::addValue(kCommitLogLatencyUs, elapsedTime);
   });
-  auto batch = engine_->startBatchWrite();
+  const size_t concurrency =
+      FLAGS_raft_apply_concurrency > 1 ? static_cast<size_t>(FLAGS_raft_apply_concurrency) : 1;
+  std::vector<std::unique_ptr<WriteBatch>> batches;
+  std::vector<size_t> batchSizes(concurrency, 0);
+  batches.reserve(concurrency);
+  for (size_t i = 0; i < concurrency; i++) {
+    batches.emplace_back(engine_->startBatchWrite());
+  }
+  // A key always maps to the same batch, so the operations on any single key stay in log
+  // order even though distinct batches are committed in parallel.
+  auto shardOf = [&](const folly::StringPiece& key) -> size_t {
+    return concurrency == 1 ? 0 : folly::hash::fnv64_buf(key.data(), key.size()) % concurrency;
+  };
+  // Edge keys applied in this round, replayed to the apply-key hook only after the data went
+  // down, so a reader racing with the eviction cannot re-cache the pre-write block.
+  std::vector<std::string> appliedEdgeKeys;
+  auto collectApplyKey = [&](const folly::StringPiece& key) {
+    if (applyKeyHook_ && NebulaKeyUtils::isEdge(vIdLen_, key)) {
+      appliedEdgeKeys.emplace_back(key.str());
+    }
+  };
+  auto fireApplyKeyHook = [&] {
+    for (auto& key : appliedEdgeKeys) {
+      applyKeyHook_(spaceId_, vIdLen_, key);
+    }
+  };
+  auto batchPut = [&](const folly::StringPiece& key, const folly::StringPiece& value) {
+    collectApplyKey(key);
+    auto idx = shardOf(key);
+    batchSizes[idx]++;
+    return batches[idx]->put(key, value);
+  };
+  auto batchRemove = [&](const folly::StringPiece& key) {
+    collectApplyKey(key);
+    auto idx = shardOf(key);
+    batchSizes[idx]++;
+    return batches[idx]->remove(key);
+  };
+  // Commits every non-empty batch, the first one on this thread and the rest on the shared
+  // apply pool, then rearms the moved-from slots for the entries still to come.
+  auto flushBatches = [&](bool waitFlag) -> nebula::cpp2::ErrorCode {
+    std::vector<folly::Future<nebula::cpp2::ErrorCode>> futures;
+    for (size_t i = 1; i < concurrency; i++) {
+      if (batchSizes[i] == 0) {
+        continue;
+      }
+      futures.emplace_back(
+          folly::via(applyExecutor(), [this, b = std::move(batches[i]), waitFlag]() mutable {
+            return engine_->commitBatchWrite(
+                std::move(b), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, waitFlag);
+          }));
+    }
+    auto result = nebula::cpp2::ErrorCode::SUCCEEDED;
+    if (batchSizes[0] != 0) {
+      result = engine_->commitBatchWrite(
+          std::move(batches[0]), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, waitFlag);
+    }
+    for (auto& future : futures) {
+      auto shardCode = std::move(future).get();
+      if (shardCode != nebula::cpp2::ErrorCode::SUCCEEDED &&
+          result == nebula::cpp2::ErrorCode::SUCCEEDED) {
+        result = shardCode;
+      }
+    }
+    for (size_t i = 0; i < concurrency; i++) {
+      if (!batches[i]) {
+        batches[i] = engine_->startBatchWrite();
+      }
+      batchSizes[i] = 0;
+    }
+    return result;
+  };
+  // A range delete can touch keys of every batch, so it acts as a barrier: everything before
+  // it is committed first, then the range delete is committed on its own.
+  auto batchRemoveRange = [&](const folly::StringPiece& start, const folly::StringPiece& end) {
+    if (concurrency == 1) {
+      batchSizes[0]++;
+      return batches[0]->removeRange(start, end);
+    }
+    auto result = flushBatches(wait);
+    if (result != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return result;
+    }
+    auto rangeBatch = engine_->startBatchWrite();
+    result = rangeBatch->removeRange(start, end);
+    if (result != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return result;
+    }
+    return engine_->commitBatchWrite(
+        std::move(rangeBatch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, wait);
+  };
   LogID lastId = kNoCommitLogId;
   TermID lastTerm = kNoCommitLogTerm;
   while (iter->valid()) {
@@ -237,7 +424,7 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
       case OP_PUT: {
         auto pieces = decodeMultiValues(log);
         DCHECK_EQ(2, pieces.size());
-        auto code = batch->put(pieces[0], pieces[1]);
+        auto code = batchPut(pieces[0], pieces[1]);
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           VLOG(3) << idStr_ << "Failed to call WriteBatch::put()";
           return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -251,7 +438,7 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
         for (size_t i = 0; i < kvs.size(); i += 2) {
           VLOG(4) << "OP_MULTI_PUT " << folly::hexlify(kvs[i])
                   << ", val = " << folly::hexlify(kvs[i + 1]);
-          auto code = batch->put(kvs[i], kvs[i + 1]);
+          auto code = batchPut(kvs[i], kvs[i + 1]);
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             VLOG(3) << idStr_ << "Failed to call WriteBatch::put()";
             return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -261,7 +448,7 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
       }
       case OP_REMOVE: {
         auto key = decodeSingleValue(log);
-        auto code = batch->remove(key);
+        auto code = batchRemove(key);
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           VLOG(3) << idStr_ << "Failed to call WriteBatch::remove()";
           return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -271,7 +458,7 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
       case OP_MULTI_REMOVE: {
         auto keys = decodeMultiValues(log);
         for (auto k : keys) {
-          auto code = batch->remove(k);
+          auto code = batchRemove(k);
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             VLOG(3) << idStr_ << "Failed to call WriteBatch::remove()";
             return {code, kNoCommitLogId, kNoCommitLogTerm};
@@ -282,25 +469,34 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
       case OP_REMOVE_RANGE: {
         auto range = decodeMultiValues(log);
         DCHECK_EQ(2, range.size());
-        auto code = batch->removeRange(range[0], range[1]);
+        auto code = batchRemoveRange(range[0], range[1]);
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
           VLOG(3) << idStr_ << "Failed to call WriteBatch::removeRange()";
           return {code, kNoCommitLogId, kNoCommitLogTerm};
         }
         break;
       }
-      case OP_BATCH_WRITE: {
-        auto data = decodeBatchValue(log);
+      case OP_BATCH_WRITE:
+      case OP_BATCH_WRITE_COMPACT: {
+        auto dataRet = decodeBatchValue(log);
+        if (!dataRet.ok()) {
+          // The entry is broken in our own wal and will not get better on retry. Crash loudly
+          // so the replica can be rebuilt from its peers instead of silently applying an
+          // empty batch and diverging forever.
+          LOG(FATAL) << idStr_ << "Failed to decode batch log " << lastId << ": "
+                     << dataRet.status();
+        }
+        auto data = std::move(dataRet).value();
         for (auto& op : data) {
           VLOG(4) << "OP_BATCH_WRITE: " << folly::hexlify(op.second.first)
                   << ", val = " << folly::hexlify(op.second.second);
           auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
           if (op.first == BatchLogType::OP_BATCH_PUT) {
-            code = batch->put(op.second.first, op.second.second);
+            code = batchPut(op.second.first, op.second.second);
           } else if (op.first == BatchLogType::OP_BATCH_REMOVE) {
-            code = batch->remove(op.second.first);
+            code = batchRemove(op.second.first);
           } else if (op.first == BatchLogType::OP_BATCH_REMOVE_RANGE) {
-            code = batch->removeRange(op.second.first, op.second.second);
+            code = batchRemoveRange(op.second.first, op.second.second);
           }
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             VLOG(3) << idStr_ << "Failed to call WriteBatch";
@@ -346,21 +542,46 @@ std::tuple<nebula::cpp2::ErrorCode, LogID, TermID> Part::commitLogs(
     ++(*iter);
   }
 
-  if (lastId >= 0) {
-    auto code = putCommitMsg(batch.get(), lastId, lastTerm);
-    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
-      VLOG(3) << idStr_ << "Put commit id into batch failed";
+  if (concurrency == 1) {
+    if (lastId >= 0) {
+      auto code = putCommitMsg(batches[0].get(), lastId, lastTerm);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        VLOG(3) << idStr_ << "Put commit id into batch failed";
+        return {code, kNoCommitLogId, kNoCommitLogTerm};
+      }
+    }
+
+    auto code = engine_->commitBatchWrite(
+        std::move(batches[0]), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, wait);
+    if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      fireApplyKeyHook();
+      return {code, lastId, lastTerm};
+    } else {
       return {code, kNoCommitLogId, kNoCommitLogTerm};
     }
   }
 
-  auto code = engine_->commitBatchWrite(
-      std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, wait);
-  if (code == nebula::cpp2::ErrorCode::SUCCEEDED) {
-    return {code, lastId, lastTerm};
-  } else {
+  // The data goes down first, the commit index second. A crash in between replays the tail
+  // of the wal from the old commit index, and every operation above is idempotent.
+  auto code = flushBatches(wait);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     return {code, kNoCommitLogId, kNoCommitLogTerm};
   }
+  if (lastId >= 0) {
+    auto commitBatch = engine_->startBatchWrite();
+    code = putCommitMsg(commitBatch.get(), lastId, lastTerm);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      VLOG(3) << idStr_ << "Put commit id into batch failed";
+      return {code, kNoCommitLogId, kNoCommitLogTerm};
+    }
+    code = engine_->commitBatchWrite(
+        std::move(commitBatch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, wait);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return {code, kNoCommitLogId, kNoCommitLogTerm};
+    }
+  }
+  fireApplyKeyHook();
+  return {code, lastId, lastTerm};
 }
 
 std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Part::commitSnapshot(
@@ -371,6 +592,9 @@ std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Part::commitSnapshot(
   SCOPED_TIMER([](uint64_t elapsedTime) {
     stats::StatsManager::addValue(kCommitSnapshotLatencyUs, elapsedTime);
   });
+  if (FLAGS_snapshot_ingest_sst) {
+    return commitSnapshotAsSst(rows, committedLogId, committedLogTerm, finished);
+  }
   auto batch = engine_->startBatchWrite();
   int64_t count = 0;
   int64_t size = 0;
@@ -400,6 +624,116 @@ std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Part::commitSnapshot(
   return {code, count, size};
 }
 
+std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> Part::commitSnapshotAsSst(
+    const std::vector<std::string>& rows,
+    LogID committedLogId,
+    TermID committedLogTerm,
+    bool finished) {
+  int64_t count = 0;
+  int64_t size = 0;
+  if (!snapshotSst_) {
+    snapshotSst_ = std::make_unique<SnapshotSstFiles>();
+    snapshotSst_->dir =
+        folly::stringPrintf("%s/snapshot_ingest/part%d", engine_->getDataRoot(), partId_);
+    if (fs::FileUtils::fileType(snapshotSst_->dir.c_str()) == fs::FileType::NOTEXIST &&
+        !fs::FileUtils::makeDir(snapshotSst_->dir)) {
+      LOG(WARNING) << idStr_ << "Failed to create snapshot sst dir " << snapshotSst_->dir;
+      snapshotSst_.reset();
+      return {nebula::cpp2::ErrorCode::E_UNKNOWN, kNoSnapshotCount, kNoSnapshotSize};
+    }
+  }
+  for (auto& row : rows) {
+    count++;
+    size += row.size();
+    auto kv = decodeKV(row);
+    SnapshotSstFiles::Stream* stream = nullptr;
+    for (auto& s : snapshotSst_->streams) {
+      if (folly::StringPiece(s.lastKey) < kv.first) {
+        stream = &s;
+        break;
+      }
+    }
+    if (stream == nullptr) {
+      auto& s = snapshotSst_->streams.emplace_back();
+      s.path = folly::stringPrintf(
+          "%s/%d.sst", snapshotSst_->dir.c_str(), snapshotSst_->nextFileId++);
+      s.writer =
+          std::make_unique<rocksdb::SstFileWriter>(rocksdb::EnvOptions(), rocksdb::Options());
+      auto status = s.writer->Open(s.path);
+      if (!status.ok()) {
+        LOG(WARNING) << idStr_ << "Failed to open snapshot sst " << s.path << ": "
+                     << status.ToString();
+        cleanupSnapshotSst();
+        return {nebula::cpp2::ErrorCode::E_UNKNOWN, kNoSnapshotCount, kNoSnapshotSize};
+      }
+      stream = &s;
+    }
+    auto status = stream->writer->Put(rocksdb::Slice(kv.first.data(), kv.first.size()),
+                                      rocksdb::Slice(kv.second.data(), kv.second.size()));
+    if (!status.ok()) {
+      LOG(WARNING) << idStr_ << "Failed to write snapshot sst: " << status.ToString();
+      cleanupSnapshotSst();
+      return {nebula::cpp2::ErrorCode::E_UNKNOWN, kNoSnapshotCount, kNoSnapshotSize};
+    }
+    stream->lastKey = kv.first.toString();
+  }
+  if (finished) {
+    std::vector<std::string> files;
+    for (auto& s : snapshotSst_->streams) {
+      auto status = s.writer->Finish();
+      s.writer.reset();
+      if (!status.ok()) {
+        LOG(WARNING) << idStr_ << "Failed to finish snapshot sst " << s.path << ": "
+                     << status.ToString();
+        cleanupSnapshotSst();
+        return {nebula::cpp2::ErrorCode::E_UNKNOWN, kNoSnapshotCount, kNoSnapshotSize};
+      }
+      files.emplace_back(s.path);
+    }
+    // The files of different streams may overlap in key range, and rocksdb requires the
+    // files of one ingestion call to be disjoint, so they go down one by one. The keys of a
+    // snapshot are unique across files, so the ingestion order does not matter.
+    for (auto& file : files) {
+      auto code = engine_->ingest({file}, false);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(WARNING) << idStr_ << "Failed to ingest snapshot sst " << file;
+        cleanupSnapshotSst();
+        return {code, kNoSnapshotCount, kNoSnapshotSize};
+      }
+    }
+    cleanupSnapshotSst();
+    // Like the row mode, persist the commit id with the rocksdb wal on to avoid losing it
+    auto batch = engine_->startBatchWrite();
+    auto code = putCommitMsg(batch.get(), committedLogId, committedLogTerm);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      VLOG(3) << idStr_ << "Put commit id into batch failed";
+      return {code, kNoSnapshotCount, kNoSnapshotSize};
+    }
+    code = engine_->commitBatchWrite(
+        std::move(batch), FLAGS_rocksdb_disable_wal, FLAGS_rocksdb_wal_sync, true);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return {code, kNoSnapshotCount, kNoSnapshotSize};
+    }
+  }
+  return {nebula::cpp2::ErrorCode::SUCCEEDED, count, size};
+}
+
+void Part::cleanupSnapshotSst() {
+  if (!snapshotSst_) {
+    return;
+  }
+  for (auto& s : snapshotSst_->streams) {
+    if (s.writer) {
+      s.writer->Finish();
+      s.writer.reset();
+    }
+    // already gone when the engine moved it during ingestion
+    fs::FileUtils::remove(s.path.c_str());
+  }
+  fs::FileUtils::remove(snapshotSst_->dir.c_str(), true);
+  snapshotSst_.reset();
+}
+
 nebula::cpp2::ErrorCode Part::putCommitMsg(WriteBatch* batch,
                                            LogID committedLogId,
                                            TermID committedLogTerm) {
@@ -492,6 +826,8 @@ nebula::cpp2::ErrorCode Part::cleanup() {
     return metaCleanup();
   }
   LOG(INFO) << idStr_ << "Clean rocksdb part data";
+  // drop the sst files of a snapshot that was being received before the reset
+  cleanupSnapshotSst();
   auto batch = engine_->startBatchWrite();
   // Remove the vertex, edge, index, systemCommitKey, operation data under the part
 
@@ -583,5 +919,56 @@ nebula::cpp2::ErrorCode Part::metaCleanup() {
   return engine_->commitBatchWrite(std::move(batch), false, FLAGS_rocksdb_wal_sync, true);
 }
 
+nebula::cpp2::ErrorCode Part::cleanupFiles() {
+  if (spaceId_ == kDefaultSpaceId && partId_ == kDefaultPartId) {
+    // The meta part is small, leave it to the regular compaction
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  LOG(INFO) << idStr_ << "Delete rocksdb files of the cleared part data";
+  // Ranges must match the ones removed in cleanup()
+  const auto& kvPre = NebulaKeyUtils::kvPrefix(partId_);
+  auto ret = engine_->deleteFilesInRange(NebulaKeyUtils::firstKey(kvPre, 128),
+                                         NebulaKeyUtils::lastKey(kvPre, 128));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+
+  const auto& tagPre = NebulaKeyUtils::tagPrefix(partId_);
+  ret = engine_->deleteFilesInRange(NebulaKeyUtils::firstKey(tagPre, vIdLen_),
+                                    NebulaKeyUtils::lastKey(tagPre, vIdLen_));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+
+  const auto& edgePre = NebulaKeyUtils::edgePrefix(partId_);
+  ret = engine_->deleteFilesInRange(NebulaKeyUtils::firstKey(edgePre, vIdLen_),
+                                    NebulaKeyUtils::lastKey(edgePre, vIdLen_));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+
+  const auto& indexPre = IndexKeyUtils::indexPrefix(partId_);
+  ret = engine_->deleteFilesInRange(NebulaKeyUtils::firstKey(indexPre, sizeof(IndexID)),
+                                    NebulaKeyUtils::lastKey(indexPre, sizeof(IndexID)));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+
+  const auto& operationPre = OperationKeyUtils::operationPrefix(partId_);
+  ret = engine_->deleteFilesInRange(NebulaKeyUtils::firstKey(operationPre, sizeof(int64_t)),
+                                    NebulaKeyUtils::lastKey(operationPre, sizeof(int64_t)));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+
+  const auto& vertexPre = NebulaKeyUtils::vertexPrefix(partId_);
+  ret = engine_->deleteFilesInRange(NebulaKeyUtils::firstKey(vertexPre, vIdLen_),
+                                    NebulaKeyUtils::lastKey(vertexPre, vIdLen_));
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 }  // namespace kvstore
 }  // namespace nebula
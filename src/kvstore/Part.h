@@ -55,9 +55,7 @@ class Part : public raftex::RaftPart {
        std::shared_ptr<DiskManager> diskMan,
        int32_t vIdLen);
 
-  virtual ~Part() {
-    LOG(INFO) << idStr_ << "~Part()";
-  }
+  virtual ~Part();
 
   /**
    * @brief Return the related kv engine
@@ -66,6 +64,32 @@ class Part : public raftex::RaftPart {
     return engine_;
   }
 
+  /**
+   * @brief Bump the read counter of this part, drained periodically by
+   * NebulaStore::refreshHotParts. See FLAGS_enable_part_read_hinting
+   */
+  void recordRead() {
+    readCount_.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Return the reads recorded since the last call and reset the counter
+   */
+  uint64_t takeReadCount() {
+    return readCount_.exchange(0, std::memory_order_relaxed);
+  }
+
+  /**
+   * @brief Whether this part is in the periodically recomputed hot set
+   */
+  bool isHot() const {
+    return hot_.load(std::memory_order_relaxed);
+  }
+
+  void setHot(bool hot) {
+    hot_.store(hot, std::memory_order_relaxed);
+  }
+
   /**
    * @brief Write single key/values to kvstore asynchronously
    *
@@ -206,6 +230,19 @@ class Part : public raftex::RaftPart {
     return cleanup();
   }
 
+  /**
+   * @brief drop the sst files holding the data removed by a previous cleanup, so clearing a
+   * space reclaims disk space at once instead of waiting for compaction to process the
+   * range tombstones. Caller should flush the engine first to move the tombstones out of
+   * the memtable.
+   *
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode cleanupFilesSafely() {
+    std::lock_guard<std::mutex> g(raftLock_);
+    return cleanupFiles();
+  }
+
  private:
   /**
    * Methods inherited from RaftPart
@@ -313,6 +350,14 @@ class Part : public raftex::RaftPart {
    */
   nebula::cpp2::ErrorCode cleanup() override;
 
+  /**
+   * @brief drop the sst files covered by the ranges removed in cleanup(), and compact the
+   * boundary files
+   *
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode cleanupFiles();
+
   /**
    * @brief clean up data in meta part, called in RaftPart::reset
    *
@@ -320,6 +365,30 @@ class Part : public raftex::RaftPart {
    */
   nebula::cpp2::ErrorCode metaCleanup();
 
+  /**
+   * @brief The sst-ingest variant of commitSnapshot (snapshot_ingest_sst): the received rows
+   * are written to sst files in a temp dir and ingested into the engine when the snapshot is
+   * complete, bypassing the memtable and its write amplification. Each concurrent sub-range
+   * stream of the sender ends up appending to its own sorted sst file.
+   */
+  std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> commitSnapshotAsSst(
+      const std::vector<std::string>& rows,
+      LogID committedLogId,
+      TermID committedLogTerm,
+      bool finished);
+
+  /**
+   * @brief Drop the half-built sst files of an aborted snapshot, called when the part is
+   * cleaned up for a new snapshot and on destruction
+   */
+  void cleanupSnapshotSst();
+
+  /**
+   * @brief Append the asyncMultiPut batches coalesced in the current group commit window as one
+   * raft log entry, and invoke their callbacks with the replication result
+   */
+  void flushGroupCommit();
+
  public:
   struct CallbackOptions {
     GraphSpaceID spaceId;
@@ -328,6 +397,7 @@ class Part : public raftex::RaftPart {
   };
 
   using LeaderChangeCB = std::function<void(const CallbackOptions& opt)>;
+  using ApplyKeyHook = std::function<void(GraphSpaceID, int32_t, folly::StringPiece)>;
 
   /**
    * @brief Register callback when raft node is ready to serve as leader
@@ -339,6 +409,13 @@ class Part : public raftex::RaftPart {
    */
   void registerOnLeaderLost(LeaderChangeCB cb);
 
+  /**
+   * @brief Register hook invoked with every edge key this part applies, after the write batch
+   * went down. The storage layer uses it to invalidate its caches at apply time, which covers
+   * follower applies and replayed wal entries that never pass through a processor.
+   */
+  void setApplyKeyHook(ApplyKeyHook hook);
+
  protected:
   GraphSpaceID spaceId_;
   PartitionID partId_;
@@ -346,10 +423,24 @@ class Part : public raftex::RaftPart {
   NewLeaderCallback newLeaderCb_ = nullptr;
   std::vector<LeaderChangeCB> leaderReadyCB_;
   std::vector<LeaderChangeCB> leaderLostCB_;
+  ApplyKeyHook applyKeyHook_ = nullptr;
 
  private:
   KVEngine* engine_ = nullptr;
   int32_t vIdLen_;
+
+  // Read hinting state, see NebulaStore::refreshHotParts
+  std::atomic<uint64_t> readCount_{0};
+  std::atomic<bool> hot_{false};
+
+  // Guards the asyncMultiPut batches waiting for the group commit window to close
+  std::mutex groupCommitLock_;
+  std::vector<KV> groupCommitKVs_;
+  std::vector<KVCallback> groupCommitCbs_;
+
+  // in-flight sst files of a snapshot being received, see commitSnapshotAsSst
+  struct SnapshotSstFiles;
+  std::unique_ptr<SnapshotSstFiles> snapshotSst_;
 };
 
 }  // namespace kvstore
@@ -0,0 +1,91 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_PREFETCHITERATOR_H_
+#define KVSTORE_PREFETCHITERATOR_H_
+
+#include <folly/MPMCQueue.h>
+
+#include <optional>
+#include <thread>
+
+#include "common/base/Base.h"
+#include "kvstore/KVIterator.h"
+
+namespace nebula {
+namespace kvstore {
+
+// Wraps a KVIterator and walks it on a background thread, keeping a bounded ring of decoded
+// key/value pairs ahead of the consumer. A sequential scan over cold data then overlaps the
+// block reads of the next keys with the decode of the current one, instead of stalling the
+// decode loop on every cache miss. Only forward iteration is supported, and the key/value
+// slices are owned copies, so they stay valid until the next call to next().
+class PrefetchIterator : public KVIterator {
+ public:
+  /**
+   * @brief Take over the underlying iterator and start prefetching
+   *
+   * @param iter Iterator to read ahead on, must be positioned at the first key
+   * @param depth Maximum number of key/value pairs decoded ahead of the consumer
+   */
+  PrefetchIterator(std::unique_ptr<KVIterator> iter, size_t depth)
+      : iter_(std::move(iter)), queue_(std::max<size_t>(depth, 1)) {
+    producer_ = std::thread(&PrefetchIterator::produce, this);
+    queue_.blockingRead(current_);
+  }
+
+  ~PrefetchIterator() {
+    stop_.store(true, std::memory_order_release);
+    // Drain until the sentinel so the producer never stays blocked on a full ring, e.g. when
+    // the scan stopped early because it hit its row limit
+    while (current_.has_value()) {
+      queue_.blockingRead(current_);
+    }
+    producer_.join();
+    // Destroy the underlying iterator here rather than on the producer thread, after join
+    // it can not be accessed concurrently anymore
+    iter_.reset();
+  }
+
+  bool valid() const override {
+    return current_.has_value();
+  }
+
+  void next() override {
+    queue_.blockingRead(current_);
+  }
+
+  void prev() override {
+    LOG(FATAL) << "PrefetchIterator only supports forward iteration";
+  }
+
+  folly::StringPiece key() const override {
+    return current_->first;
+  }
+
+  folly::StringPiece val() const override {
+    return current_->second;
+  }
+
+ private:
+  void produce() {
+    for (; iter_->valid() && !stop_.load(std::memory_order_acquire); iter_->next()) {
+      queue_.blockingWrite(
+          std::make_optional(std::make_pair(iter_->key().toString(), iter_->val().toString())));
+    }
+    // The empty optional marks the end of the stream
+    queue_.blockingWrite(std::nullopt);
+  }
+
+  std::unique_ptr<KVIterator> iter_;
+  folly::MPMCQueue<std::optional<std::pair<std::string, std::string>>> queue_;
+  std::optional<std::pair<std::string, std::string>> current_;
+  std::atomic<bool> stop_{false};
+  std::thread producer_;
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+#endif  // KVSTORE_PREFETCHITERATOR_H_
@@ -74,12 +74,18 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
     options.compaction_filter_factory = cfFactory;
   }
 
-  if (readonly) {
+  // column family separation only makes sense for storage data with BlockBasedTable format
+  bool cfSeparation = FLAGS_rocksdb_enable_cf_separation && spaceId_ != kDefaultSpaceId &&
+                      FLAGS_rocksdb_table_format == "BlockBasedTable";
+  if (cfSeparation) {
+    db = openWithColumnFamilies(options, path, vIdLen, readonly);
+  } else if (readonly) {
     status = rocksdb::DB::OpenForReadOnly(options, path, &db);
+    CHECK(status.ok()) << status.ToString();
   } else {
     status = rocksdb::DB::Open(options, path, &db);
+    CHECK(status.ok()) << status.ToString();
   }
-  CHECK(status.ok()) << status.ToString();
   if (!readonly && spaceId_ != kDefaultSpaceId /* only for storage*/) {
     rocksdb::ReadOptions readOptions;
     std::string dataVersionValue = "";
@@ -92,9 +98,17 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
     CHECK(status.ok()) << status.ToString();
   }
   db_.reset(db);
+  if (!cfHandles_.empty() && !readonly) {
+    migrateToColumnFamilies();
+  }
   std::string factoryName = options.table_factory->Name();
   if (factoryName == rocksdb::TableFactory::kBlockBasedTableName()) {
     extractorLen_ = sizeof(PartitionID) + vIdLen;
+    edgeExtractorLen_ = extractorLen_;
+    if (cfSeparation && FLAGS_enable_rocksdb_split_filtering) {
+      // the edge column family extracts a longer prefix, see initColumnFamilyOptions
+      edgeExtractorLen_ += sizeof(EdgeType);
+    }
   } else if (factoryName == rocksdb::TableFactory::kPlainTableName()) {
     // PlainTable only support prefix-based seek, which means if the prefix is not inserted into
     // rocksdb, we can't read them from "prefix" api anymore. For simplicity, we just set the length
@@ -102,6 +116,7 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
     // tagPrefix(partId) or edgePrefix(partId).
     isPlainTable_ = true;
     extractorLen_ = sizeof(PartitionID);
+    edgeExtractorLen_ = extractorLen_;
   }
   partsNum_ = allParts().size();
   LOG(INFO) << "open rocksdb on " << path;
@@ -109,6 +124,102 @@ RocksEngine::RocksEngine(GraphSpaceID spaceId,
   backup();
 }
 
+rocksdb::DB* RocksEngine::openWithColumnFamilies(const rocksdb::Options& options,
+                                                 const std::string& path,
+                                                 int32_t vIdLen,
+                                                 bool readonly) {
+  // The set of existing column families differs between a fresh instance and one created before
+  // separation was enabled, and rocksdb requires opening with exactly the existing set. So list
+  // them first and create the missing ones after open.
+  std::vector<std::string> existing;
+  auto status = rocksdb::DB::ListColumnFamilies(options, path, &existing);
+  if (!status.ok()) {
+    // a fresh instance without a manifest yet
+    existing = {rocksdb::kDefaultColumnFamilyName};
+  }
+  std::vector<rocksdb::ColumnFamilyDescriptor> descriptors;
+  for (const auto& name : existing) {
+    rocksdb::ColumnFamilyOptions cfOpts(options);
+    if (name != rocksdb::kDefaultColumnFamilyName) {
+      status = initColumnFamilyOptions(options, spaceId_, vIdLen, name, &cfOpts);
+      CHECK(status.ok()) << status.ToString();
+    }
+    descriptors.emplace_back(name, cfOpts);
+  }
+
+  rocksdb::DB* db = nullptr;
+  std::vector<rocksdb::ColumnFamilyHandle*> handles;
+  if (readonly) {
+    status =
+        rocksdb::DB::OpenForReadOnly(rocksdb::DBOptions(options), path, descriptors, &handles, &db);
+  } else {
+    status = rocksdb::DB::Open(rocksdb::DBOptions(options), path, descriptors, &handles, &db);
+  }
+  CHECK(status.ok()) << status.ToString();
+
+  std::unordered_map<std::string, rocksdb::ColumnFamilyHandle*> byName;
+  for (size_t i = 0; i < existing.size(); i++) {
+    byName.emplace(existing[i], handles[i]);
+  }
+  static const std::vector<std::string> dataCfNames = {
+      kVertexColumnFamilyName, kEdgeColumnFamilyName, kIndexColumnFamilyName};
+  for (const std::string& name : dataCfNames) {
+    if (byName.count(name) != 0) {
+      continue;
+    }
+    CHECK(!readonly) << "Column family " << name << " not exist in read only instance";
+    rocksdb::ColumnFamilyOptions cfOpts(options);
+    status = initColumnFamilyOptions(options, spaceId_, vIdLen, name, &cfOpts);
+    CHECK(status.ok()) << status.ToString();
+    rocksdb::ColumnFamilyHandle* handle = nullptr;
+    status = db->CreateColumnFamily(cfOpts, name, &handle);
+    CHECK(status.ok()) << status.ToString();
+    byName.emplace(name, handle);
+  }
+
+  cfHandles_.resize(kColumnFamilyNum);
+  cfHandles_[kDefaultCf] = byName[rocksdb::kDefaultColumnFamilyName];
+  cfHandles_[kVertexCf] = byName[kVertexColumnFamilyName];
+  cfHandles_[kEdgeCf] = byName[kEdgeColumnFamilyName];
+  cfHandles_[kIndexCf] = byName[kIndexColumnFamilyName];
+  LOG(INFO) << "open rocksdb with column family separation on " << path;
+  return db;
+}
+
+void RocksEngine::migrateToColumnFamilies() {
+  // The scan only sees what is still in the default column family, so after migration it only
+  // walks the system keys and is cheap enough to run at every open.
+  rocksdb::ReadOptions readOptions;
+  readOptions.total_order_seek = true;
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(readOptions, cfHandles_[kDefaultCf]));
+  rocksdb::WriteOptions writeOptions;
+  writeOptions.disableWAL = FLAGS_rocksdb_disable_wal;
+  rocksdb::WriteBatch batch(FLAGS_rocksdb_batch_size);
+  int64_t moved = 0;
+  for (iter->SeekToFirst(); iter->Valid(); iter->Next()) {
+    auto key = folly::StringPiece(iter->key().data(), iter->key().size());
+    auto idx = columnFamilyIndex(key);
+    if (idx == kDefaultCf) {
+      continue;
+    }
+    batch.Put(cfHandles_[idx], iter->key(), iter->value());
+    batch.Delete(cfHandles_[kDefaultCf], iter->key());
+    moved++;
+    if (batch.Count() >= 1024) {
+      auto status = db_->Write(writeOptions, &batch);
+      CHECK(status.ok()) << status.ToString();
+      batch.Clear();
+    }
+  }
+  if (batch.Count() > 0) {
+    auto status = db_->Write(writeOptions, &batch);
+    CHECK(status.ok()) << status.ToString();
+  }
+  if (moved > 0) {
+    LOG(INFO) << "moved " << moved << " keys into dedicated column families on " << dataPath_;
+  }
+}
+
 void RocksEngine::stop() {
   if (db_) {
     // Because we trigger compaction in WebService, we need to stop all
@@ -118,7 +229,7 @@ void RocksEngine::stop() {
 }
 
 std::unique_ptr<WriteBatch> RocksEngine::startBatchWrite() {
-  return std::make_unique<RocksWriteBatch>();
+  return std::make_unique<RocksWriteBatch>(cfHandles_.empty() ? nullptr : &cfHandles_);
 }
 
 nebula::cpp2::ErrorCode RocksEngine::commitBatchWrite(std::unique_ptr<WriteBatch> batch,
@@ -148,7 +259,7 @@ nebula::cpp2::ErrorCode RocksEngine::get(const std::string& key,
   if (UNLIKELY(snapshot != nullptr)) {
     options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
   }
-  rocksdb::Status status = db_->Get(options, rocksdb::Slice(key), value);
+  rocksdb::Status status = db_->Get(options, cfHandle(key), rocksdb::Slice(key), value);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else if (status.IsNotFound()) {
@@ -160,6 +271,34 @@ nebula::cpp2::ErrorCode RocksEngine::get(const std::string& key,
   }
 }
 
+nebula::cpp2::ErrorCode RocksEngine::exists(const std::string& key, bool* found) {
+  memory::MemoryCheckOffGuard guard;
+  rocksdb::ReadOptions options;
+  std::string value;
+  bool valueFound = false;
+  auto* handle = cfHandle(key);
+  if (!db_->KeyMayExist(options, handle, rocksdb::Slice(key), &value, &valueFound)) {
+    // The bloom filter and memtable rule the key out for sure
+    *found = false;
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  if (valueFound) {
+    *found = true;
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  // KeyMayExist may report false positives, confirm with a real read
+  auto status = db_->Get(options, handle, rocksdb::Slice(key), &value);
+  if (status.ok()) {
+    *found = true;
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  } else if (status.IsNotFound()) {
+    *found = false;
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  VLOG(4) << "Exists check failed: " << key << " " << status.ToString();
+  return nebula::cpp2::ErrorCode::E_UNKNOWN;
+}
+
 std::vector<Status> RocksEngine::multiGet(const std::vector<std::string>& keys,
                                           std::vector<std::string>* values) {
   memory::MemoryCheckOffGuard guard;
@@ -169,7 +308,17 @@ std::vector<Status> RocksEngine::multiGet(const std::vector<std::string>& keys,
     slices.emplace_back(keys[index]);
   }
 
-  auto status = db_->MultiGet(options, slices, values);
+  std::vector<rocksdb::Status> status;
+  if (cfHandles_.empty()) {
+    status = db_->MultiGet(options, slices, values);
+  } else {
+    std::vector<rocksdb::ColumnFamilyHandle*> cfs;
+    cfs.reserve(keys.size());
+    for (const auto& key : keys) {
+      cfs.emplace_back(cfHandle(key));
+    }
+    status = db_->MultiGet(options, cfs, slices, values);
+  }
   std::vector<Status> ret;
   std::transform(status.begin(), status.end(), std::back_inserter(ret), [](const auto& s) {
     if (s.ok()) {
@@ -185,17 +334,21 @@ std::vector<Status> RocksEngine::multiGet(const std::vector<std::string>& keys,
 
 nebula::cpp2::ErrorCode RocksEngine::range(const std::string& start,
                                            const std::string& end,
-                                           std::unique_ptr<KVIterator>* storageIter) {
+                                           std::unique_ptr<KVIterator>* storageIter,
+                                           size_t readaheadSize) {
   memory::MemoryCheckOffGuard guard;
   storageIter->reset(new RocksRangeIter(start, end));
   rocksdb::ReadOptions options;
   options.iterate_upper_bound = dynamic_cast<RocksRangeIter*>(storageIter->get())->upperBound();
+  if (readaheadSize > 0) {
+    options.readahead_size = readaheadSize;
+  }
   if (!isPlainTable_) {
     options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
   } else {
     options.prefix_same_as_start = true;
   }
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cfHandle(start)));
   if (iter) {
     iter->Seek(rocksdb::Slice(start));
     dynamic_cast<RocksRangeIter*>(storageIter->get())->reset(std::move(iter));
@@ -205,38 +358,58 @@ nebula::cpp2::ErrorCode RocksEngine::range(const std::string& start,
 
 nebula::cpp2::ErrorCode RocksEngine::prefix(const std::string& prefix,
                                             std::unique_ptr<KVIterator>* storageIter,
-                                            const void* snapshot) {
+                                            const void* snapshot,
+                                            size_t readaheadSize) {
   memory::MemoryCheckOffGuard guard;
   // In fact, we don't need to check prefix.size() >= extractorLen_, which is caller's duty to make
   // sure the prefix bloom filter exists. But this is quite error-prone, so we do a check here.
-  if (FLAGS_enable_rocksdb_prefix_filtering && prefix.size() >= extractorLen_) {
-    return prefixWithExtractor(prefix, snapshot, storageIter);
+  // The edge column family may extract a longer prefix than the others, a prefix shorter than
+  // its cap was never inserted into its bloom and has to take the total order path.
+  size_t extractorLen =
+      !cfHandles_.empty() && columnFamilyIndex(prefix) == kEdgeCf ? edgeExtractorLen_
+                                                                  : extractorLen_;
+  if (FLAGS_enable_rocksdb_prefix_filtering && prefix.size() >= extractorLen) {
+    return prefixWithExtractor(prefix, snapshot, storageIter, readaheadSize);
   } else {
-    return prefixWithoutExtractor(prefix, snapshot, storageIter);
+    return prefixWithoutExtractor(prefix, snapshot, storageIter, readaheadSize);
   }
 }
 
 nebula::cpp2::ErrorCode RocksEngine::prefixWithExtractor(const std::string& prefix,
                                                          const void* snapshot,
-                                                         std::unique_ptr<KVIterator>* storageIter) {
+                                                         std::unique_ptr<KVIterator>* storageIter,
+                                                         size_t readaheadSize) {
   memory::MemoryCheckOffGuard guard;
-  storageIter->reset(new RocksPrefixIter(prefix));
+  auto* snap = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
+  auto* cf = cfHandle(prefix);
+  // if the caller hands back an iterator of a former lookup against this engine, column family
+  // and snapshot, re-seek it instead of allocating a fresh rocksdb iterator
+  if (storageIter->get() != nullptr) {
+    auto* reusable = dynamic_cast<RocksReusablePrefixIter*>(storageIter->get());
+    if (reusable != nullptr && reusable->matches(db_.get(), cf, snap)) {
+      reusable->reseek(prefix);
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    storageIter->reset();
+  }
   rocksdb::ReadOptions options;
-  options.iterate_upper_bound = dynamic_cast<RocksPrefixIter*>(storageIter->get())->upperBound();
   if (UNLIKELY(snapshot != nullptr)) {
-    options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
+    options.snapshot = snap;
   }
-  options.prefix_same_as_start = true;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
-  if (iter) {
-    iter->Seek(rocksdb::Slice(prefix));
-    dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
+  if (readaheadSize > 0) {
+    options.readahead_size = readaheadSize;
   }
+  options.prefix_same_as_start = true;
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cf));
+  storageIter->reset(new RocksReusablePrefixIter(std::move(iter), prefix, db_.get(), cf, snap));
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
 nebula::cpp2::ErrorCode RocksEngine::prefixWithoutExtractor(
-    const std::string& prefix, const void* snapshot, std::unique_ptr<KVIterator>* storageIter) {
+    const std::string& prefix,
+    const void* snapshot,
+    std::unique_ptr<KVIterator>* storageIter,
+    size_t readaheadSize) {
   memory::MemoryCheckOffGuard guard;
   storageIter->reset(new RocksPrefixIter(prefix));
   rocksdb::ReadOptions options;
@@ -244,9 +417,12 @@ nebula::cpp2::ErrorCode RocksEngine::prefixWithoutExtractor(
   if (snapshot != nullptr) {
     options.snapshot = reinterpret_cast<const rocksdb::Snapshot*>(snapshot);
   }
+  if (readaheadSize > 0) {
+    options.readahead_size = readaheadSize;
+  }
   // prefix_same_as_start is false by default
   options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cfHandle(prefix)));
   if (iter) {
     iter->Seek(rocksdb::Slice(prefix));
     dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
@@ -256,17 +432,21 @@ nebula::cpp2::ErrorCode RocksEngine::prefixWithoutExtractor(
 
 nebula::cpp2::ErrorCode RocksEngine::rangeWithPrefix(const std::string& start,
                                                      const std::string& prefix,
-                                                     std::unique_ptr<KVIterator>* storageIter) {
+                                                     std::unique_ptr<KVIterator>* storageIter,
+                                                     size_t readaheadSize) {
   memory::MemoryCheckOffGuard guard;
   storageIter->reset(new RocksPrefixIter(prefix));
   rocksdb::ReadOptions options;
   options.iterate_upper_bound = dynamic_cast<RocksPrefixIter*>(storageIter->get())->upperBound();
+  if (readaheadSize > 0) {
+    options.readahead_size = readaheadSize;
+  }
   if (!isPlainTable_) {
     options.total_order_seek = FLAGS_enable_rocksdb_prefix_filtering;
   } else {
     options.prefix_same_as_start = true;
   }
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, cfHandle(prefix)));
   if (iter) {
     iter->Seek(rocksdb::Slice(start));
     dynamic_cast<RocksPrefixIter*>(storageIter->get())->reset(std::move(iter));
@@ -278,16 +458,27 @@ nebula::cpp2::ErrorCode RocksEngine::scan(std::unique_ptr<KVIterator>* storageIt
   memory::MemoryCheckOffGuard guard;
   rocksdb::ReadOptions options;
   options.total_order_seek = true;
-  std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
-  iter->SeekToFirst();
-  storageIter->reset(new RocksCommonIter(std::move(iter)));
+  if (cfHandles_.empty()) {
+    std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options));
+    iter->SeekToFirst();
+    storageIter->reset(new RocksCommonIter(std::move(iter)));
+  } else {
+    std::vector<std::unique_ptr<rocksdb::Iterator>> iters;
+    iters.reserve(cfHandles_.size());
+    for (auto* handle : cfHandles_) {
+      std::unique_ptr<rocksdb::Iterator> iter(db_->NewIterator(options, handle));
+      iter->SeekToFirst();
+      iters.emplace_back(std::move(iter));
+    }
+    storageIter->reset(new RocksMultiCFIter(std::move(iters)));
+  }
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
 nebula::cpp2::ErrorCode RocksEngine::put(std::string key, std::string value) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  rocksdb::Status status = db_->Put(options, key, value);
+  rocksdb::Status status = db_->Put(options, cfHandle(key), key, value);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -299,7 +490,7 @@ nebula::cpp2::ErrorCode RocksEngine::put(std::string key, std::string value) {
 nebula::cpp2::ErrorCode RocksEngine::multiPut(std::vector<KV> keyValues) {
   rocksdb::WriteBatch updates(FLAGS_rocksdb_batch_size);
   for (size_t i = 0; i < keyValues.size(); i++) {
-    updates.Put(keyValues[i].first, keyValues[i].second);
+    updates.Put(cfHandle(keyValues[i].first), keyValues[i].first, keyValues[i].second);
   }
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
@@ -315,7 +506,7 @@ nebula::cpp2::ErrorCode RocksEngine::multiPut(std::vector<KV> keyValues) {
 nebula::cpp2::ErrorCode RocksEngine::remove(const std::string& key) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  auto status = db_->Delete(options, key);
+  auto status = db_->Delete(options, cfHandle(key), key);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -327,7 +518,7 @@ nebula::cpp2::ErrorCode RocksEngine::remove(const std::string& key) {
 nebula::cpp2::ErrorCode RocksEngine::multiRemove(std::vector<std::string> keys) {
   rocksdb::WriteBatch deletes(FLAGS_rocksdb_batch_size);
   for (size_t i = 0; i < keys.size(); i++) {
-    deletes.Delete(keys[i]);
+    deletes.Delete(cfHandle(keys[i]), keys[i]);
   }
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
@@ -343,7 +534,7 @@ nebula::cpp2::ErrorCode RocksEngine::multiRemove(std::vector<std::string> keys)
 nebula::cpp2::ErrorCode RocksEngine::removeRange(const std::string& start, const std::string& end) {
   rocksdb::WriteOptions options;
   options.disableWAL = FLAGS_rocksdb_disable_wal;
-  auto status = db_->DeleteRange(options, db_->DefaultColumnFamily(), start, end);
+  auto status = db_->DeleteRange(options, cfHandle(start), start, end);
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -352,6 +543,27 @@ nebula::cpp2::ErrorCode RocksEngine::removeRange(const std::string& start, const
   }
 }
 
+nebula::cpp2::ErrorCode RocksEngine::deleteFilesInRange(const std::string& start,
+                                                        const std::string& end) {
+  rocksdb::Slice sBegin(start);
+  rocksdb::Slice sEnd(end);
+  auto* handle = cfHandle(start);
+  auto status = rocksdb::DeleteFilesInRange(db_.get(), handle, &sBegin, &sEnd);
+  if (!status.ok()) {
+    LOG(WARNING) << "DeleteFilesInRange Failed: " << status.ToString();
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+  // Files straddling the range boundaries survive the call above, compact them away so
+  // the range tombstones and any remaining keys do not linger until a full compaction
+  rocksdb::CompactRangeOptions options;
+  status = db_->CompactRange(options, handle, &sBegin, &sEnd);
+  if (!status.ok()) {
+    LOG(WARNING) << "CompactRange Failed: " << status.ToString();
+    return nebula::cpp2::ErrorCode::E_UNKNOWN;
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 std::string RocksEngine::partKey(PartitionID partId) {
   return NebulaKeyUtils::systemPartKey(partId);
 }
@@ -474,6 +686,11 @@ nebula::cpp2::ErrorCode RocksEngine::ingest(const std::vector<std::string>& file
   if (files.empty()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
+  if (!cfHandles_.empty()) {
+    // an sst file could mix key types, so it can't be routed to a single column family
+    LOG(WARNING) << "Ingest is not supported when column family separation is enabled";
+    return nebula::cpp2::ErrorCode::E_UNSUPPORTED;
+  }
   rocksdb::IngestExternalFileOptions options;
   options.move_files = FLAGS_move_files;
   options.verify_file_checksum = verifyFileChecksum;
@@ -490,7 +707,17 @@ nebula::cpp2::ErrorCode RocksEngine::setOption(const std::string& configKey,
                                                const std::string& configValue) {
   std::unordered_map<std::string, std::string> configOptions = {{configKey, configValue}};
 
-  rocksdb::Status status = db_->SetOptions(configOptions);
+  rocksdb::Status status;
+  if (cfHandles_.empty()) {
+    status = db_->SetOptions(configOptions);
+  } else {
+    for (auto* handle : cfHandles_) {
+      status = db_->SetOptions(handle, configOptions);
+      if (!status.ok()) {
+        break;
+      }
+    }
+  }
   if (status.ok()) {
     LOG(INFO) << "SetOption Succeeded: " << configKey << ":" << configValue;
     return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -516,6 +743,27 @@ nebula::cpp2::ErrorCode RocksEngine::setDBOption(const std::string& configKey,
 
 ErrorOr<nebula::cpp2::ErrorCode, std::string> RocksEngine::getProperty(
     const std::string& property) {
+  if (!cfHandles_.empty()) {
+    // sum numeric properties over all column families, non-numeric ones fall through and are
+    // reported for the default column family only
+    uint64_t sum = 0;
+    bool numeric = true;
+    std::string cfValue;
+    for (auto* handle : cfHandles_) {
+      if (!db_->GetProperty(handle, property, &cfValue)) {
+        return nebula::cpp2::ErrorCode::E_INVALID_PARM;
+      }
+      auto num = folly::tryTo<uint64_t>(cfValue);
+      if (!num.hasValue()) {
+        numeric = false;
+        break;
+      }
+      sum += num.value();
+    }
+    if (numeric) {
+      return folly::to<std::string>(sum);
+    }
+  }
   std::string value;
   if (!db_->GetProperty(property, &value)) {
     return nebula::cpp2::ErrorCode::E_INVALID_PARM;
@@ -528,7 +776,17 @@ nebula::cpp2::ErrorCode RocksEngine::compact() {
   rocksdb::CompactRangeOptions options;
   options.change_level = FLAGS_rocksdb_compact_change_level;
   options.target_level = FLAGS_rocksdb_compact_target_level;
-  rocksdb::Status status = db_->CompactRange(options, nullptr, nullptr);
+  rocksdb::Status status;
+  if (cfHandles_.empty()) {
+    status = db_->CompactRange(options, nullptr, nullptr);
+  } else {
+    for (auto* handle : cfHandles_) {
+      status = db_->CompactRange(options, handle, nullptr, nullptr);
+      if (!status.ok()) {
+        break;
+      }
+    }
+  }
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -537,9 +795,26 @@ nebula::cpp2::ErrorCode RocksEngine::compact() {
   }
 }
 
+nebula::cpp2::ErrorCode RocksEngine::suggestCompactRange(const std::string& begin,
+                                                         const std::string& end) {
+  rocksdb::Slice first(begin);
+  rocksdb::Slice last(end);
+  auto status = db_->SuggestCompactRange(cfHandle(begin), &first, &last);
+  if (status.ok() || status.IsNotSupported()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  LOG(WARNING) << "SuggestCompactRange Failed: " << status.ToString();
+  return nebula::cpp2::ErrorCode::E_UNKNOWN;
+}
+
 nebula::cpp2::ErrorCode RocksEngine::flush() {
   rocksdb::FlushOptions options;
-  rocksdb::Status status = db_->Flush(options);
+  rocksdb::Status status;
+  if (cfHandles_.empty()) {
+    status = db_->Flush(options);
+  } else {
+    status = db_->Flush(options, cfHandles_);
+  }
   if (status.ok()) {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   } else {
@@ -22,6 +22,44 @@
 namespace nebula {
 namespace kvstore {
 
+/**
+ * @brief Index into the column family handle list of RocksEngine when column family separation
+ * is enabled
+ */
+enum NebulaColumnFamilyIndex : size_t {
+  kDefaultCf = 0,
+  kVertexCf = 1,
+  kEdgeCf = 2,
+  kIndexCf = 3,
+  kColumnFamilyNum = 4,
+};
+
+/**
+ * @brief Which column family a key or prefix belongs to. The first byte of every nebula key
+ * encodes its NebulaKeyType, so one byte is enough to route both point lookups and the prefix
+ * scans built by NebulaKeyUtils. Keys of unknown or system types stay in the default column
+ * family.
+ */
+inline size_t columnFamilyIndex(const folly::StringPiece& key) {
+  if (key.empty()) {
+    return kDefaultCf;
+  }
+  auto type = static_cast<NebulaKeyType>(static_cast<uint8_t>(key[0]) & kTypeMask);
+  switch (type) {
+    case NebulaKeyType::kTag_:
+    case NebulaKeyType::kVertex:
+      return kVertexCf;
+    case NebulaKeyType::kEdge:
+    case NebulaKeyType::kPrime:
+    case NebulaKeyType::kDoublePrime:
+      return kEdgeCf;
+    case NebulaKeyType::kIndex:
+      return kIndexCf;
+    default:
+      return kDefaultCf;
+  }
+}
+
 /**
  * @brief Rocksdb range iterator, only scan data in range [start, end)
  */
@@ -138,6 +176,121 @@ class RocksPrefixIter : public KVIterator {
   std::string scratch_;
 };
 
+/**
+ * @brief Prefix iterator which can be handed back to the engine and re-seeked with another
+ * prefix, so one underlying rocksdb::Iterator serves many prefix lookups of a request instead of
+ * being allocated per lookup. It owns a copy of the prefix and intentionally sets no
+ * iterate_upper_bound, the prefix extractor together with the starts_with check in valid()
+ * bounds the iteration instead.
+ */
+class RocksReusablePrefixIter : public KVIterator {
+ public:
+  RocksReusablePrefixIter(std::unique_ptr<rocksdb::Iterator> iter,
+                          std::string prefix,
+                          const rocksdb::DB* db,
+                          const rocksdb::ColumnFamilyHandle* cf,
+                          const rocksdb::Snapshot* snapshot)
+      : iter_(std::move(iter)), prefix_(std::move(prefix)), db_(db), cf_(cf), snapshot_(snapshot) {
+    if (iter_) {
+      iter_->Seek(rocksdb::Slice(prefix_));
+    }
+  }
+
+  ~RocksReusablePrefixIter() = default;
+
+  /**
+   * @brief whether this iterator can be re-seeked for another lookup against the given engine,
+   * column family and snapshot, reuse across any of them would silently read the wrong data
+   */
+  bool matches(const rocksdb::DB* db,
+               const rocksdb::ColumnFamilyHandle* cf,
+               const rocksdb::Snapshot* snapshot) const {
+    return !!iter_ && db_ == db && cf_ == cf && snapshot_ == snapshot;
+  }
+
+  /**
+   * @brief point this iterator at another prefix via Seek, skipping iterator re-creation
+   */
+  void reseek(std::string prefix) {
+    prefix_ = std::move(prefix);
+    iter_->Seek(rocksdb::Slice(prefix_));
+  }
+
+  bool valid() const override {
+    return !!iter_ && iter_->Valid() && (iter_->key().starts_with(rocksdb::Slice(prefix_)));
+  }
+
+  void next() override {
+    iter_->Next();
+  }
+
+  void prev() override {
+    iter_->Prev();
+  }
+
+  folly::StringPiece key() const override {
+    return folly::StringPiece(iter_->key().data(), iter_->key().size());
+  }
+
+  folly::StringPiece val() const override {
+    return folly::StringPiece(iter_->value().data(), iter_->value().size());
+  }
+
+ protected:
+  std::unique_ptr<rocksdb::Iterator> iter_{nullptr};
+  std::string prefix_;
+  // the engine, column family and snapshot this iterator was created against
+  const rocksdb::DB* db_{nullptr};
+  const rocksdb::ColumnFamilyHandle* cf_{nullptr};
+  const rocksdb::Snapshot* snapshot_{nullptr};
+};
+
+/**
+ * @brief Iterator over the data of several column families, used by scan when column family
+ * separation is enabled. Keys are sorted within one column family but not across them.
+ */
+class RocksMultiCFIter : public KVIterator {
+ public:
+  explicit RocksMultiCFIter(std::vector<std::unique_ptr<rocksdb::Iterator>> iters)
+      : iters_(std::move(iters)) {
+    skipExhausted();
+  }
+
+  ~RocksMultiCFIter() = default;
+
+  bool valid() const override {
+    return idx_ < iters_.size() && iters_[idx_]->Valid();
+  }
+
+  void next() override {
+    iters_[idx_]->Next();
+    skipExhausted();
+  }
+
+  void prev() override {
+    // only moves within the current column family
+    iters_[idx_]->Prev();
+  }
+
+  folly::StringPiece key() const override {
+    return folly::StringPiece(iters_[idx_]->key().data(), iters_[idx_]->key().size());
+  }
+
+  folly::StringPiece val() const override {
+    return folly::StringPiece(iters_[idx_]->value().data(), iters_[idx_]->value().size());
+  }
+
+ private:
+  void skipExhausted() {
+    while (idx_ < iters_.size() && !iters_[idx_]->Valid()) {
+      idx_++;
+    }
+  }
+
+  std::vector<std::unique_ptr<rocksdb::Iterator>> iters_;
+  size_t idx_{0};
+};
+
 /**
  * @brief Rocksdb iterator to scan all data
  */
@@ -181,14 +334,24 @@ class RocksCommonIter : public KVIterator {
 class RocksWriteBatch : public WriteBatch {
  private:
   rocksdb::WriteBatch batch_;
+  // column family handles of the engine when column family separation is enabled, nullptr means
+  // everything goes to the default column family
+  const std::vector<rocksdb::ColumnFamilyHandle*>* cfs_{nullptr};
+
+  rocksdb::ColumnFamilyHandle* route(folly::StringPiece key) const {
+    return (*cfs_)[columnFamilyIndex(key)];
+  }
 
  public:
-  RocksWriteBatch() : batch_(FLAGS_rocksdb_batch_size) {}
+  explicit RocksWriteBatch(const std::vector<rocksdb::ColumnFamilyHandle*>* cfs = nullptr)
+      : batch_(FLAGS_rocksdb_batch_size), cfs_(cfs) {}
 
   virtual ~RocksWriteBatch() = default;
 
   nebula::cpp2::ErrorCode put(folly::StringPiece key, folly::StringPiece value) override {
-    if (batch_.Put(toSlice(key), toSlice(value)).ok()) {
+    auto status = cfs_ != nullptr ? batch_.Put(route(key), toSlice(key), toSlice(value))
+                                  : batch_.Put(toSlice(key), toSlice(value));
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -196,16 +359,21 @@ class RocksWriteBatch : public WriteBatch {
   }
 
   nebula::cpp2::ErrorCode remove(folly::StringPiece key) override {
-    if (batch_.Delete(toSlice(key)).ok()) {
+    auto status = cfs_ != nullptr ? batch_.Delete(route(key), toSlice(key))
+                                  : batch_.Delete(toSlice(key));
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
     }
   }
 
-  // Remove all keys in the range [start, end)
+  // Remove all keys in the range [start, end), both bounds belong to one key type so the range
+  // is routed by its start key
   nebula::cpp2::ErrorCode removeRange(folly::StringPiece start, folly::StringPiece end) override {
-    if (batch_.DeleteRange(toSlice(start), toSlice(end)).ok()) {
+    auto status = cfs_ != nullptr ? batch_.DeleteRange(route(start), toSlice(start), toSlice(end))
+                                  : batch_.DeleteRange(toSlice(start), toSlice(end));
+    if (status.ok()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     } else {
       return nebula::cpp2::ErrorCode::E_UNKNOWN;
@@ -244,6 +412,9 @@ class RocksEngine : public KVEngine {
               bool readonly = false);
 
   ~RocksEngine() {
+    for (auto* handle : cfHandles_) {
+      db_->DestroyColumnFamilyHandle(handle);
+    }
     LOG(INFO) << "Release rocksdb on " << dataPath_;
   }
 
@@ -318,6 +489,16 @@ class RocksEngine : public KVEngine {
                               std::string* value,
                               const void* snapshot = nullptr) override;
 
+  /**
+   * @brief Check whether a key exists without retrieving its value, backed by KeyMayExist
+   * so most absent keys are ruled out by the bloom filter alone
+   *
+   * @param key Key to check
+   * @param found Set to whether the key exists
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode exists(const std::string& key, bool* found) override;
+
   /**
    * @brief Read a list of keys
    *
@@ -339,7 +520,8 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode range(const std::string& start,
                                 const std::string& end,
-                                std::unique_ptr<KVIterator>* iter) override;
+                                std::unique_ptr<KVIterator>* iter,
+                                size_t readaheadSize = 0) override;
 
   /**
    * @brief Get all results with 'prefix' str as prefix.
@@ -350,7 +532,8 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode prefix(const std::string& prefix,
                                  std::unique_ptr<KVIterator>* iter,
-                                 const void* snapshot = nullptr) override;
+                                 const void* snapshot = nullptr,
+                                 size_t readaheadSize = 0) override;
 
   /**
    * @brief Get all results with 'prefix' str as prefix starting form 'start'
@@ -362,7 +545,8 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode rangeWithPrefix(const std::string& start,
                                           const std::string& prefix,
-                                          std::unique_ptr<KVIterator>* iter) override;
+                                          std::unique_ptr<KVIterator>* iter,
+                                          size_t readaheadSize = 0) override;
 
   /**
    * @brief Prefix scan with prefix extractor
@@ -373,7 +557,8 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode prefixWithExtractor(const std::string& prefix,
                                               const void* snapshot,
-                                              std::unique_ptr<KVIterator>* storageIter);
+                                              std::unique_ptr<KVIterator>* storageIter,
+                                              size_t readaheadSize);
 
   /**
    * @brief Prefix scan without prefix extractor, use total order seek
@@ -384,7 +569,8 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode prefixWithoutExtractor(const std::string& prefix,
                                                  const void* snapshot,
-                                                 std::unique_ptr<KVIterator>* storageIter);
+                                                 std::unique_ptr<KVIterator>* storageIter,
+                                                 size_t readaheadSize);
 
   /**
    * @brief Scan all data in rocksdb
@@ -439,6 +625,17 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode removeRange(const std::string& start, const std::string& end) override;
 
+  /**
+   * @brief Drop the sst files fully contained in [start, end), then compact the files
+   * overlapping the range boundaries
+   *
+   * @param start Start key, inclusive
+   * @param end End key, exclusive
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode deleteFilesInRange(const std::string& start,
+                                             const std::string& end) override;
+
   /*********************
    * Non-data operation
    ********************/
@@ -531,6 +728,17 @@ class RocksEngine : public KVEngine {
    */
   nebula::cpp2::ErrorCode compact() override;
 
+  /**
+   * @brief Suggest rocksdb to prioritize compacting the given key range, routed to the
+   * column family of the keys
+   *
+   * @param begin Start key of the range, inclusive
+   * @param end End key of the range, exclusive
+   * @return nebula::cpp2::ErrorCode
+   */
+  nebula::cpp2::ErrorCode suggestCompactRange(const std::string& begin,
+                                              const std::string& end) override;
+
   /**
    * @brief Flush data in memtable into sst
    *
@@ -594,15 +802,50 @@ class RocksEngine : public KVEngine {
    */
   void openBackupEngine(GraphSpaceID spaceId);
 
+  /**
+   * @brief Handle of the column family the given key or prefix belongs to, the default column
+   * family when column family separation is disabled
+   */
+  rocksdb::ColumnFamilyHandle* cfHandle(const folly::StringPiece& key) const {
+    if (cfHandles_.empty()) {
+      return db_->DefaultColumnFamily();
+    }
+    return cfHandles_[columnFamilyIndex(key)];
+  }
+
+  /**
+   * @brief Open the rocksdb instance with dedicated data column families, creating the missing
+   * ones, and fill cfHandles_
+   *
+   * @return rocksdb::DB* The opened instance
+   */
+  rocksdb::DB* openWithColumnFamilies(const rocksdb::Options& options,
+                                      const std::string& path,
+                                      int32_t vIdLen,
+                                      bool readonly);
+
+  /**
+   * @brief Move data written before column family separation was enabled from the default
+   * column family into the dedicated ones. A no-op once the instance is migrated, so it also
+   * serves as the upgrade path: open the instance once (storaged or the db_upgrader tool) with
+   * column family separation enabled.
+   */
+  void migrateToColumnFamilies();
+
  private:
   GraphSpaceID spaceId_;
   std::string dataPath_;
   std::string walPath_;
   std::unique_ptr<rocksdb::DB> db_{nullptr};
+  // handles indexed by NebulaColumnFamilyIndex, empty when column family separation is disabled
+  std::vector<rocksdb::ColumnFamilyHandle*> cfHandles_;
   std::string backupPath_;
   std::unique_ptr<rocksdb::BackupEngine> backupDb_{nullptr};
   int32_t partsNum_ = -1;
   size_t extractorLen_;
+  // prefix length the edge column family extracts, longer than extractorLen_ when the
+  // filtering split is enabled, equal otherwise
+  size_t edgeExtractorLen_;
   bool isPlainTable_{false};
 };
 
@@ -10,6 +10,7 @@
 #include <rocksdb/convenience.h>
 #include <rocksdb/db.h>
 #include <rocksdb/filter_policy.h>
+#include <rocksdb/persistent_cache.h>
 #include <rocksdb/rate_limiter.h>
 #include <rocksdb/slice_transform.h>
 #include <rocksdb/utilities/options_util.h>
@@ -78,11 +79,37 @@ DEFINE_string(rocksdb_compression_per_level,
               "e.g. \"no:no:lz4:lz4::zstd\" === "
               "\"no:no:lz4:lz4:lz4:snappy:zstd:snappy\"");
 
+DEFINE_int32(rocksdb_compression_dict_bytes,
+             0,
+             "Max bytes of the per-SST compression dictionary sampled from data blocks, "
+             "0 disables dictionary compression. Repetitive low-cardinality property "
+             "values (country codes, event types...) compress far better against a "
+             "shared dictionary than per block.");
+
+DEFINE_int32(rocksdb_compression_zstd_train_bytes,
+             0,
+             "Bytes of sampled input fed to the zstd dictionary trainer, typically about "
+             "100x rocksdb_compression_dict_bytes. 0 uses rocksdb's untrained sampling. "
+             "Only meaningful when rocksdb_compression_dict_bytes is set and the "
+             "compression algorithm is zstd.");
+
 DEFINE_bool(enable_rocksdb_statistics, false, "Whether or not to enable rocksdb's statistics");
 DEFINE_string(rocksdb_stats_level, "kExceptHistogramOrTimers", "rocksdb statistics level");
 
 DEFINE_int32(num_compaction_threads, 0, "Number of total compaction threads. 0 means unlimited.");
 
+DEFINE_string(rocksdb_bulk_load_space_ids,
+              "",
+              "Comma separated ids of spaces which are bulk loading. Their compactions only get "
+              "num_bulk_load_compaction_threads out of the shared compaction thread budget, so "
+              "that they can not starve L0->L1 compactions of the query serving spaces. "
+              "Requires num_compaction_threads.");
+
+DEFINE_int32(num_bulk_load_compaction_threads,
+             1,
+             "Number of compaction threads reserved for the bulk load spaces out of "
+             "num_compaction_threads, the query serving spaces share the rest.");
+
 DEFINE_int32(rocksdb_rate_limit,
              0,
              "write limit in bytes per sec. The unit is MB. 0 means unlimited.");
@@ -95,6 +122,15 @@ DEFINE_bool(enable_rocksdb_prefix_filtering,
             true,
             "Whether or not to enable rocksdb's prefix bloom filter.");
 
+DEFINE_bool(enable_rocksdb_split_filtering,
+            false,
+            "Give each data column family the bloom configuration its reads want instead of the "
+            "global one: the vertex column family turns on whole key filtering for point lookups, "
+            "the edge column family extends its prefix bloom to partition + vid + edge type so "
+            "seeks by (vid, edge type) skip the data blocks of other edge types. Only takes "
+            "effect with rocksdb_enable_cf_separation, BlockBasedTable format and "
+            "enable_rocksdb_prefix_filtering.");
+
 DEFINE_bool(rocksdb_compact_change_level,
             true,
             "If true, compacted files will be moved to the minimum level capable "
@@ -142,6 +178,57 @@ DEFINE_bool(rocksdb_enable_blob_garbage_collection,
             "Set this to true to make BlobDB actively relocate valid blobs "
             "from the oldest blob files as they are encountered during compaction");
 
+DEFINE_string(rocksdb_secondary_cache_path,
+              "",
+              "Directory on a local NVMe scratch disk used as the secondary block cache, blocks "
+              "evicted from the in-memory block cache spill there. Empty means disabled");
+
+DEFINE_int64(rocksdb_secondary_cache_size,
+             8192,
+             "The secondary block cache size per space in MB, "
+             "only effective when rocksdb_secondary_cache_path is set");
+
+DEFINE_bool(rocksdb_secondary_cache_optimized_for_nvm,
+            true,
+            "Whether the secondary block cache is tuned for NVMe devices");
+
+DEFINE_bool(rocksdb_enable_cf_separation,
+            false,
+            "Whether to store vertex data, edge data and index entries in dedicated column "
+            "families instead of the default one. Only effective for storage spaces with "
+            "BlockBasedTable format. Existing data is moved into the dedicated column families "
+            "when the instance is opened, once enabled the instance must keep the flag on");
+
+DEFINE_string(rocksdb_vertex_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions overrides of the vertex column family, "
+              "applied on top of rocksdb_column_family_options");
+
+DEFINE_string(rocksdb_edge_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions overrides of the edge column family, "
+              "applied on top of rocksdb_column_family_options");
+
+DEFINE_string(rocksdb_index_column_family_options,
+              "{}",
+              "json string of ColumnFamilyOptions overrides of the index column family, "
+              "applied on top of rocksdb_column_family_options");
+
+DEFINE_int64(rocksdb_vertex_cf_block_cache,
+             0,
+             "The block cache size of the vertex column family in MB, "
+             "0 means sharing the default block cache");
+
+DEFINE_int64(rocksdb_edge_cf_block_cache,
+             0,
+             "The block cache size of the edge column family in MB, "
+             "0 means sharing the default block cache");
+
+DEFINE_int64(rocksdb_index_cf_block_cache,
+             0,
+             "The block cache size of the index column family in MB, "
+             "0 means sharing the default block cache");
+
 namespace nebula {
 namespace kvstore {
 
@@ -173,6 +260,19 @@ static rocksdb::Status initRocksdbCompression(rocksdb::Options& baseOpts) {
     }
     baseOpts.bottommost_compression = it->second;
   }
+
+  // Dictionary compression: each SST gets a dictionary trained on sampled data blocks, so
+  // values repeated across rows are stored once per file instead of once per block. The
+  // dictionary also applies to the bottommost level, which holds the bulk of the data.
+  if (FLAGS_rocksdb_compression_dict_bytes > 0) {
+    baseOpts.compression_opts.max_dict_bytes = FLAGS_rocksdb_compression_dict_bytes;
+    baseOpts.compression_opts.zstd_max_train_bytes = FLAGS_rocksdb_compression_zstd_train_bytes;
+    baseOpts.bottommost_compression_opts.max_dict_bytes = FLAGS_rocksdb_compression_dict_bytes;
+    baseOpts.bottommost_compression_opts.zstd_max_train_bytes =
+        FLAGS_rocksdb_compression_zstd_train_bytes;
+    baseOpts.bottommost_compression_opts.enabled = true;
+  }
+
   if (FLAGS_rocksdb_compression_per_level.empty()) {
     return rocksdb::Status::OK();
   }
@@ -219,6 +319,100 @@ static rocksdb::Status initRocksdbKVSeparation(rocksdb::Options& baseOpts) {
   return rocksdb::Status::OK();
 }
 
+static rocksdb::Status initRocksdbSecondaryCache(rocksdb::BlockBasedTableOptions& bbtOpts,
+                                                 GraphSpaceID spaceId) {
+  if (FLAGS_rocksdb_secondary_cache_path.empty() || bbtOpts.no_block_cache) {
+    return rocksdb::Status::OK();
+  }
+  // one cache per space so it can be sized and dropped independently, shared between the column
+  // families of the space
+  static std::mutex cacheLock;
+  static std::unordered_map<GraphSpaceID, std::shared_ptr<rocksdb::PersistentCache>> caches;
+  std::lock_guard<std::mutex> guard(cacheLock);
+  auto& cache = caches[spaceId];
+  if (cache == nullptr) {
+    auto cachePath = folly::stringPrintf(
+        "%s/rocksdb_secondary_cache/%d", FLAGS_rocksdb_secondary_cache_path.c_str(), spaceId);
+    if (fs::FileUtils::fileType(cachePath.c_str()) == fs::FileType::NOTEXIST) {
+      if (!fs::FileUtils::makeDir(cachePath)) {
+        return rocksdb::Status::IOError("makeDir " + cachePath + " failed");
+      }
+    }
+    auto status = rocksdb::NewPersistentCache(rocksdb::Env::Default(),
+                                              cachePath,
+                                              FLAGS_rocksdb_secondary_cache_size * 1024 * 1024,
+                                              nullptr,
+                                              FLAGS_rocksdb_secondary_cache_optimized_for_nvm,
+                                              &cache);
+    if (!status.ok()) {
+      return status;
+    }
+    LOG(INFO) << "open rocksdb secondary cache of space " << spaceId << " on " << cachePath;
+  }
+  bbtOpts.persistent_cache = cache;
+  return rocksdb::Status::OK();
+}
+
+bool isBulkLoadSpace(GraphSpaceID spaceId) {
+  static const std::unordered_set<GraphSpaceID> bulkLoadSpaces = [] {
+    std::unordered_set<GraphSpaceID> spaces;
+    std::vector<std::string> ids;
+    folly::split(",", FLAGS_rocksdb_bulk_load_space_ids, ids, true);
+    for (const auto& id : ids) {
+      auto space = folly::tryTo<GraphSpaceID>(folly::trimWhitespace(id));
+      if (space.hasValue()) {
+        spaces.emplace(space.value());
+      } else {
+        LOG(ERROR) << "Ignore invalid space id \"" << id << "\" in rocksdb_bulk_load_space_ids";
+      }
+    }
+    return spaces;
+  }();
+  return bulkLoadSpaces.count(spaceId) != 0;
+}
+
+// The default block cache shared by all spaces and column families that do not configure a
+// dedicated one, nullptr when rocksdb_block_cache disables caching
+static std::shared_ptr<rocksdb::Cache> sharedBlockCache() {
+  if (FLAGS_rocksdb_block_cache <= 0) {
+    return nullptr;
+  }
+  static std::shared_ptr<rocksdb::Cache> blockCache =
+      rocksdb::NewLRUCache(FLAGS_rocksdb_block_cache * 1024 * 1024, FLAGS_cache_bucket_exp);
+  return blockCache;
+}
+
+std::shared_ptr<rocksdb::RateLimiter> rocksdbRateLimiter() {
+  if (FLAGS_rocksdb_rate_limit <= 0) {
+    return nullptr;
+  }
+  static std::shared_ptr<rocksdb::RateLimiter> rateLimiter{
+      rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_rate_limit * 1024 * 1024)};
+  return rateLimiter;
+}
+
+std::shared_ptr<rocksdb::ConcurrentTaskLimiter> compactionThreadLimiter(bool bulkLoad) {
+  int32_t total = FLAGS_num_compaction_threads;
+  if (total <= 0) {
+    return nullptr;
+  }
+  if (FLAGS_rocksdb_bulk_load_space_ids.empty() || total < 2) {
+    // only one priority class, the whole budget goes to a single shared limiter
+    static std::shared_ptr<rocksdb::ConcurrentTaskLimiter> limiter{
+        rocksdb::NewConcurrentTaskLimiter("compaction", total)};
+    return limiter;
+  }
+  int32_t bulk = std::max(1, std::min(FLAGS_num_bulk_load_compaction_threads, total - 1));
+  if (bulkLoad) {
+    static std::shared_ptr<rocksdb::ConcurrentTaskLimiter> bulkLimiter{
+        rocksdb::NewConcurrentTaskLimiter("compaction-bulk-load", bulk)};
+    return bulkLimiter;
+  }
+  static std::shared_ptr<rocksdb::ConcurrentTaskLimiter> servingLimiter{
+      rocksdb::NewConcurrentTaskLimiter("compaction-serving", total - bulk)};
+  return servingLimiter;
+}
+
 rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
                                    GraphSpaceID spaceId,
                                    int32_t vidLen) {
@@ -281,15 +475,13 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
     baseOpts.use_direct_reads = true;
   }
 
-  if (FLAGS_num_compaction_threads > 0) {
-    static std::shared_ptr<rocksdb::ConcurrentTaskLimiter> compaction_thread_limiter{
-        rocksdb::NewConcurrentTaskLimiter("compaction", FLAGS_num_compaction_threads)};
-    baseOpts.compaction_thread_limiter = compaction_thread_limiter;
+  auto compactionLimiter = compactionThreadLimiter(isBulkLoadSpace(spaceId));
+  if (compactionLimiter != nullptr) {
+    baseOpts.compaction_thread_limiter = std::move(compactionLimiter);
   }
-  if (FLAGS_rocksdb_rate_limit > 0) {
-    static std::shared_ptr<rocksdb::RateLimiter> rate_limiter{
-        rocksdb::NewGenericRateLimiter(FLAGS_rocksdb_rate_limit * 1024 * 1024)};
-    baseOpts.rate_limiter = rate_limiter;
+  auto rateLimiter = rocksdbRateLimiter();
+  if (rateLimiter != nullptr) {
+    baseOpts.rate_limiter = std::move(rateLimiter);
   }
 
   if (FLAGS_rocksdb_table_format == "BlockBasedTable") {
@@ -304,11 +496,10 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
       return s;
     }
 
-    if (FLAGS_rocksdb_block_cache <= 0) {
+    auto blockCache = sharedBlockCache();
+    if (blockCache == nullptr) {
       bbtOpts.no_block_cache = true;
     } else {
-      static std::shared_ptr<rocksdb::Cache> blockCache =
-          rocksdb::NewLRUCache(FLAGS_rocksdb_block_cache * 1024 * 1024, FLAGS_cache_bucket_exp);
       bbtOpts.block_cache = blockCache;
     }
 
@@ -333,6 +524,10 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
       baseOpts.prefix_extractor.reset(rocksdb::NewCappedPrefixTransform(prefixLength));
     }
     bbtOpts.whole_key_filtering = FLAGS_enable_rocksdb_whole_key_filtering;
+    s = initRocksdbSecondaryCache(bbtOpts, spaceId);
+    if (!s.ok()) {
+      return s;
+    }
     baseOpts.table_factory.reset(NewBlockBasedTableFactory(bbtOpts));
     baseOpts.create_if_missing = true;
   } else if (FLAGS_rocksdb_table_format == "PlainTable") {
@@ -361,6 +556,100 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options& baseOpts,
   return s;
 }
 
+rocksdb::Status initColumnFamilyOptions(const rocksdb::Options& baseOpts,
+                                        GraphSpaceID spaceId,
+                                        int32_t vidLen,
+                                        const std::string& cfName,
+                                        rocksdb::ColumnFamilyOptions* cfOpts) {
+  const std::string* optionsFlag = nullptr;
+  int64_t blockCacheMB = 0;
+  if (cfName == kVertexColumnFamilyName) {
+    optionsFlag = &FLAGS_rocksdb_vertex_column_family_options;
+    blockCacheMB = FLAGS_rocksdb_vertex_cf_block_cache;
+  } else if (cfName == kEdgeColumnFamilyName) {
+    optionsFlag = &FLAGS_rocksdb_edge_column_family_options;
+    blockCacheMB = FLAGS_rocksdb_edge_cf_block_cache;
+  } else if (cfName == kIndexColumnFamilyName) {
+    optionsFlag = &FLAGS_rocksdb_index_column_family_options;
+    blockCacheMB = FLAGS_rocksdb_index_cf_block_cache;
+  } else {
+    return rocksdb::Status::InvalidArgument("Unknown column family " + cfName);
+  }
+
+  // the dedicated column family inherits everything from the base options, per-cf overrides
+  // (e.g. compaction style) come from the json flag above
+  std::unordered_map<std::string, std::string> cfOptsMap;
+  if (!loadOptionsMap(cfOptsMap, *optionsFlag)) {
+    return rocksdb::Status::InvalidArgument();
+  }
+  auto s = GetColumnFamilyOptionsFromMap(
+      rocksdb::ColumnFamilyOptions(baseOpts), cfOptsMap, cfOpts, true);
+  if (!s.ok()) {
+    return s;
+  }
+
+  // Vertex reads are point lookups by full key, edge reads are prefix seeks by
+  // (vid, edge type) which whole key blooms can not serve — one global filtering setting
+  // can't fit both, so the split gives each data column family its own.
+  bool splitFiltering = FLAGS_enable_rocksdb_split_filtering &&
+                        FLAGS_enable_rocksdb_prefix_filtering &&
+                        cfName != kIndexColumnFamilyName;
+  if (splitFiltering && cfName == kEdgeColumnFamilyName) {
+    // Every edge key is longer than the cap, so all stored prefixes have the full capped
+    // length and the bloom stays sound. RocksEngine only routes prefix seeks of at least
+    // this length to the prefix bloom, shorter ones fall back to total order seeks.
+    size_t prefixLength = sizeof(PartitionID) + vidLen + sizeof(EdgeType);
+    cfOpts->prefix_extractor.reset(rocksdb::NewCappedPrefixTransform(prefixLength));
+  }
+
+  if (blockCacheMB > 0 || splitFiltering) {
+    // rebuild the table factory with a dedicated block cache and/or filtering settings,
+    // other table options still follow the global flags
+    std::unordered_map<std::string, std::string> bbtOptsMap;
+    if (!loadOptionsMap(bbtOptsMap, FLAGS_rocksdb_block_based_table_options)) {
+      return rocksdb::Status::InvalidArgument();
+    }
+    rocksdb::BlockBasedTableOptions bbtOpts;
+    s = GetBlockBasedTableOptionsFromMap(
+        rocksdb::BlockBasedTableOptions(), bbtOptsMap, &bbtOpts, true);
+    if (!s.ok()) {
+      return s;
+    }
+    if (blockCacheMB > 0) {
+      // one cache per column family name, shared by all spaces like the default block cache
+      static std::mutex cacheLock;
+      static std::unordered_map<std::string, std::shared_ptr<rocksdb::Cache>> cfBlockCaches;
+      {
+        std::lock_guard<std::mutex> guard(cacheLock);
+        auto& cache = cfBlockCaches[cfName];
+        if (cache == nullptr) {
+          cache = rocksdb::NewLRUCache(blockCacheMB * 1024 * 1024, FLAGS_cache_bucket_exp);
+        }
+        bbtOpts.block_cache = cache;
+      }
+    } else {
+      auto blockCache = sharedBlockCache();
+      if (blockCache == nullptr) {
+        bbtOpts.no_block_cache = true;
+      } else {
+        bbtOpts.block_cache = blockCache;
+      }
+    }
+    bbtOpts.filter_policy.reset(rocksdb::NewBloomFilterPolicy(10, false));
+    if (splitFiltering) {
+      bbtOpts.whole_key_filtering = cfName == kVertexColumnFamilyName;
+    } else {
+      bbtOpts.whole_key_filtering = FLAGS_enable_rocksdb_whole_key_filtering;
+    }
+    s = initRocksdbSecondaryCache(bbtOpts, spaceId);
+    if (!s.ok()) {
+      return s;
+    }
+    cfOpts->table_factory.reset(NewBlockBasedTableFactory(bbtOpts));
+  }
+  return rocksdb::Status::OK();
+}
+
 bool loadOptionsMap(std::unordered_map<std::string, std::string>& map, const std::string& gflags) {
   conf::Configuration conf;
   auto status = conf.parseFromString(gflags);
@@ -36,6 +36,8 @@ DECLARE_int64(rocksdb_block_cache);
 
 DECLARE_int32(rocksdb_batch_size);
 
+DECLARE_int32(rocksdb_rate_limit);
+
 DECLARE_int32(rocksdb_row_cache_num);
 
 DECLARE_int32(cache_bucket_exp);
@@ -48,12 +50,15 @@ DECLARE_string(part_man_type);
 DECLARE_string(rocksdb_compression_per_level);
 DECLARE_string(rocksdb_compression);
 DECLARE_string(rocksdb_bottommost_compression);
+DECLARE_int32(rocksdb_compression_dict_bytes);
+DECLARE_int32(rocksdb_compression_zstd_train_bytes);
 
 DECLARE_bool(enable_rocksdb_statistics);
 DECLARE_string(rocksdb_stats_level);
 
 DECLARE_bool(enable_rocksdb_prefix_filtering);
 DECLARE_bool(enable_rocksdb_whole_key_filtering);
+DECLARE_bool(enable_rocksdb_split_filtering);
 
 // rocksdb compact RangeOptions
 DECLARE_bool(rocksdb_compact_change_level);
@@ -67,9 +72,34 @@ DECLARE_int32(rocksdb_backup_interval_secs);
 DECLARE_bool(rocksdb_enable_kv_separation);
 DECLARE_uint64(rocksdb_kv_separation_threshold);
 
+// rocksdb secondary (NVMe) block cache options
+DECLARE_string(rocksdb_secondary_cache_path);
+DECLARE_int64(rocksdb_secondary_cache_size);
+DECLARE_bool(rocksdb_secondary_cache_optimized_for_nvm);
+
+// shared compaction thread budget and its priority classes
+DECLARE_int32(num_compaction_threads);
+DECLARE_string(rocksdb_bulk_load_space_ids);
+DECLARE_int32(num_bulk_load_compaction_threads);
+
+// rocksdb column family separation options
+DECLARE_bool(rocksdb_enable_cf_separation);
+DECLARE_string(rocksdb_vertex_column_family_options);
+DECLARE_string(rocksdb_edge_column_family_options);
+DECLARE_string(rocksdb_index_column_family_options);
+DECLARE_int64(rocksdb_vertex_cf_block_cache);
+DECLARE_int64(rocksdb_edge_cf_block_cache);
+DECLARE_int64(rocksdb_index_cf_block_cache);
+
 namespace nebula {
 namespace kvstore {
 
+// Names of the dedicated data column families when column family separation is enabled. Data
+// written before separation was enabled lives in rocksdb::kDefaultColumnFamilyName.
+constexpr char kVertexColumnFamilyName[] = "vertex";
+constexpr char kEdgeColumnFamilyName[] = "edge";
+constexpr char kIndexColumnFamilyName[] = "index";
+
 /**
  * @brief Build rocksdb options form gflags
  *
@@ -82,6 +112,49 @@ rocksdb::Status initRocksdbOptions(rocksdb::Options &baseOpts,
                                    GraphSpaceID spaceId,
                                    int32_t vidLen = 8);
 
+/**
+ * @brief Build the options of one dedicated data column family, starting from the base options
+ * and overlaying the per-column-family gflags (option overrides, block cache size and the
+ * filtering split)
+ *
+ * @param baseOpts Rocksdb options built by initRocksdbOptions
+ * @param spaceId
+ * @param vidLen Vertex id length of the space, sizes the edge prefix bloom
+ * @param cfName One of the dedicated column family names above
+ * @param cfOpts Column family options to build
+ * @return rocksdb::Status
+ */
+rocksdb::Status initColumnFamilyOptions(const rocksdb::Options &baseOpts,
+                                        GraphSpaceID spaceId,
+                                        int32_t vidLen,
+                                        const std::string &cfName,
+                                        rocksdb::ColumnFamilyOptions *cfOpts);
+
+/**
+ * @brief Whether the space was marked as a bulk load space by FLAGS_rocksdb_bulk_load_space_ids
+ *
+ * @param spaceId
+ */
+bool isBulkLoadSpace(GraphSpaceID spaceId);
+
+/**
+ * @brief Retrieve the shared compaction thread limiter of one priority class. All spaces of the
+ * same class share one limiter, and together the two classes split FLAGS_num_compaction_threads:
+ * the bulk load spaces get FLAGS_num_bulk_load_compaction_threads, the query serving spaces get
+ * the rest. Return nullptr if FLAGS_num_compaction_threads is not set.
+ *
+ * @param bulkLoad Which priority class to retrieve the limiter of
+ */
+std::shared_ptr<rocksdb::ConcurrentTaskLimiter> compactionThreadLimiter(bool bulkLoad);
+
+/**
+ * @brief Retrieve the rate limiter shared by all rocksdb instances to throttle background
+ * flush and compaction io. Exposed so the admin task manager can shrink the budget with
+ * SetBytesPerSecond while foreground latency is above target. Return nullptr if
+ * FLAGS_rocksdb_rate_limit is not set.
+ */
+std::shared_ptr<rocksdb::RateLimiter> rocksdbRateLimiter();
+
 /**
  * @brief Load a gflag into map
  *
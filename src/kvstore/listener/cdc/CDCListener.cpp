@@ -0,0 +1,285 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/listener/cdc/CDCListener.h"
+
+#include "common/utils/NebulaKeyUtils.h"
+
+DECLARE_int32(listener_commit_batch_size);
+
+namespace nebula {
+namespace kvstore {
+
+void CDCListener::init() {
+  auto vRet = schemaMan_->getSpaceVidLen(spaceId_);
+  if (!vRet.ok()) {
+    LOG(FATAL) << "vid length error";
+  }
+  vIdLen_ = vRet.value();
+  if (!queue_->open()) {
+    LOG(FATAL) << "cdc queue open failed";
+  }
+}
+
+void CDCListener::pickEvents(BatchLogType type,
+                             const std::string& key,
+                             const std::string& value,
+                             std::vector<CdcEvent>& events) {
+  if (NebulaKeyUtils::isTag(vIdLen_, key)) {
+    CdcEvent event;
+    event.type = type == BatchLogType::OP_BATCH_PUT ? CdcEvent::Type::kPutVertex
+                                                    : CdcEvent::Type::kRemoveVertex;
+    event.vId = NebulaKeyUtils::getVertexId(vIdLen_, key).toString();
+    event.schemaId = NebulaKeyUtils::getTagId(vIdLen_, key);
+    if (type == BatchLogType::OP_BATCH_PUT) {
+      event.value = value;
+    }
+    events.emplace_back(std::move(event));
+  } else if (NebulaKeyUtils::isEdge(vIdLen_, key)) {
+    auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen_, key);
+    if (edgeType < 0) {
+      // Both directions are written for an edge, capturing the out-edge is enough
+      return;
+    }
+    CdcEvent event;
+    event.type = type == BatchLogType::OP_BATCH_PUT ? CdcEvent::Type::kPutEdge
+                                                    : CdcEvent::Type::kRemoveEdge;
+    event.vId = NebulaKeyUtils::getSrcId(vIdLen_, key).toString();
+    event.dstId = NebulaKeyUtils::getDstId(vIdLen_, key).toString();
+    event.schemaId = edgeType;
+    event.rank = NebulaKeyUtils::getRank(vIdLen_, key);
+    if (type == BatchLogType::OP_BATCH_PUT) {
+      event.value = value;
+    }
+    events.emplace_back(std::move(event));
+  }
+  // Index, system and lock keys are not part of the change stream
+}
+
+bool CDCListener::apply(std::vector<CdcEvent>& events) {
+  auto ret = queue_->appendBatch(events);
+  if (!ret.ok()) {
+    LOG(ERROR) << idStr_ << ret.status();
+    return false;
+  }
+  return true;
+}
+
+bool CDCListener::persist(LogID lastId, TermID lastTerm, LogID lastApplyLogId) {
+  if (!writeAppliedId(lastId, lastTerm, lastApplyLogId)) {
+    LOG(FATAL) << "last apply ids write failed";
+  }
+  return true;
+}
+
+std::pair<LogID, TermID> CDCListener::lastCommittedLogId() {
+  if (access(lastApplyLogFile_->c_str(), 0) != 0) {
+    VLOG(3) << "Invalid or nonexistent file : " << *lastApplyLogFile_;
+    return {0, 0};
+  }
+  int32_t fd = open(lastApplyLogFile_->c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(FATAL) << "Failed to open the file \"" << lastApplyLogFile_->c_str() << "\" (" << errno
+               << "): " << strerror(errno);
+  }
+  LogID logId;
+  CHECK_EQ(pread(fd, reinterpret_cast<char*>(&logId), sizeof(LogID), 0),
+           static_cast<ssize_t>(sizeof(LogID)));
+  TermID termId;
+  CHECK_EQ(pread(fd, reinterpret_cast<char*>(&termId), sizeof(TermID), sizeof(LogID)),
+           static_cast<ssize_t>(sizeof(TermID)));
+  close(fd);
+  return {logId, termId};
+}
+
+LogID CDCListener::lastApplyLogId() {
+  if (access(lastApplyLogFile_->c_str(), 0) != 0) {
+    VLOG(3) << "Invalid or nonexistent file : " << *lastApplyLogFile_;
+    return 0;
+  }
+  int32_t fd = open(lastApplyLogFile_->c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(FATAL) << "Failed to open the file \"" << lastApplyLogFile_->c_str() << "\" (" << errno
+               << "): " << strerror(errno);
+  }
+  LogID logId;
+  auto offset = sizeof(LogID) + sizeof(TermID);
+  CHECK_EQ(pread(fd, reinterpret_cast<char*>(&logId), sizeof(LogID), offset),
+           static_cast<ssize_t>(sizeof(LogID)));
+  close(fd);
+  return logId;
+}
+
+bool CDCListener::writeAppliedId(LogID lastId, TermID lastTerm, LogID lastApplyLogId) {
+  int32_t fd = open(lastApplyLogFile_->c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    VLOG(3) << "Failed to open file \"" << lastApplyLogFile_->c_str() << "\" (errno: " << errno
+            << "): " << strerror(errno);
+    return false;
+  }
+  auto raw = encodeAppliedId(lastId, lastTerm, lastApplyLogId);
+  ssize_t written = write(fd, raw.c_str(), raw.size());
+  if (written != (ssize_t)raw.size()) {
+    VLOG(4) << idStr_ << "bytesWritten:" << written << ", expected:" << raw.size()
+            << ", error:" << strerror(errno);
+    close(fd);
+    return false;
+  }
+  close(fd);
+  return true;
+}
+
+std::string CDCListener::encodeAppliedId(LogID lastId,
+                                         TermID lastTerm,
+                                         LogID lastApplyLogId) const {
+  std::string val;
+  val.reserve(sizeof(LogID) * 2 + sizeof(TermID));
+  val.append(reinterpret_cast<const char*>(&lastId), sizeof(LogID))
+      .append(reinterpret_cast<const char*>(&lastTerm), sizeof(TermID))
+      .append(reinterpret_cast<const char*>(&lastApplyLogId), sizeof(LogID));
+  return val;
+}
+
+void CDCListener::processLogs() {
+  std::unique_ptr<LogIterator> iter;
+  {
+    std::lock_guard<std::mutex> guard(raftLock_);
+    if (lastApplyLogId_ >= committedLogId_) {
+      return;
+    }
+    iter = wal_->iterator(lastApplyLogId_ + 1, committedLogId_);
+  }
+
+  LogID lastApplyId = -1;
+  std::vector<CdcEvent> events;
+  while (iter->valid()) {
+    lastApplyId = iter->logId();
+    auto log = iter->logMsg();
+    if (log.empty()) {
+      // skip the heartbeat
+      ++(*iter);
+      continue;
+    }
+
+    DCHECK_GE(log.size(), sizeof(int64_t) + 1 + sizeof(uint32_t));
+    switch (log[sizeof(int64_t)]) {
+      case OP_PUT: {
+        auto pieces = decodeMultiValues(log);
+        DCHECK_EQ(2, pieces.size());
+        pickEvents(BatchLogType::OP_BATCH_PUT, pieces[0].toString(), pieces[1].toString(), events);
+        break;
+      }
+      case OP_MULTI_PUT: {
+        auto kvs = decodeMultiValues(log);
+        DCHECK_EQ(0, kvs.size() % 2);
+        for (size_t i = 0; i < kvs.size(); i += 2) {
+          pickEvents(BatchLogType::OP_BATCH_PUT, kvs[i].toString(), kvs[i + 1].toString(), events);
+        }
+        break;
+      }
+      case OP_REMOVE: {
+        auto key = decodeSingleValue(log);
+        pickEvents(BatchLogType::OP_BATCH_REMOVE, key.toString(), "", events);
+        break;
+      }
+      case OP_REMOVE_RANGE: {
+        LOG(WARNING) << "CDCListener don't deal with OP_REMOVE_RANGE";
+        break;
+      }
+      case OP_MULTI_REMOVE: {
+        auto keys = decodeMultiValues(log);
+        for (auto key : keys) {
+          pickEvents(BatchLogType::OP_BATCH_REMOVE, key.toString(), "", events);
+        }
+        break;
+      }
+      case OP_BATCH_WRITE:
+      case OP_BATCH_WRITE_COMPACT: {
+        auto batchDataRet = decodeBatchValue(log);
+        if (!batchDataRet.ok()) {
+          // Neither skip the entry nor apply a partial batch, bail out without moving
+          // lastApplyLogId_ so the next round retries from the same log
+          LOG(ERROR) << idStr_ << "Failed to decode batch log: " << batchDataRet.status();
+          return;
+        }
+        auto batchData = std::move(batchDataRet).value();
+        for (auto& op : batchData) {
+          switch (op.first) {
+            case BatchLogType::OP_BATCH_PUT:
+            case BatchLogType::OP_BATCH_REMOVE: {
+              pickEvents(op.first, op.second.first.toString(), op.second.second.toString(), events);
+              break;
+            }
+            case BatchLogType::OP_BATCH_REMOVE_RANGE: {
+              LOG(WARNING) << "CDCListener don't deal with OP_BATCH_REMOVE_RANGE";
+              break;
+            }
+          }
+        }
+        break;
+      }
+      case OP_TRANS_LEADER:
+      case OP_ADD_LEARNER:
+      case OP_ADD_PEER:
+      case OP_REMOVE_PEER: {
+        break;
+      }
+      default: {
+        VLOG(2) << idStr_ << "Unknown operation: " << static_cast<int32_t>(log[0]);
+      }
+    }
+
+    if (static_cast<int32_t>(events.size()) > FLAGS_listener_commit_batch_size) {
+      break;
+    }
+    ++(*iter);
+  }
+
+  // apply to state machine
+  if (lastApplyId != -1 && apply(events)) {
+    std::lock_guard<std::mutex> guard(raftLock_);
+    lastApplyLogId_ = lastApplyId;
+    persist(committedLogId_, term_, lastApplyLogId_);
+    VLOG(2) << idStr_ << "Listener succeeded apply log to " << lastApplyLogId_;
+  }
+}
+
+std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> CDCListener::commitSnapshot(
+    const std::vector<std::string>& rows,
+    LogID committedLogId,
+    TermID committedLogTerm,
+    bool finished) {
+  VLOG(2) << idStr_ << "Listener is committing snapshot.";
+  int64_t count = 0;
+  int64_t size = 0;
+  std::vector<CdcEvent> events;
+  for (const auto& row : rows) {
+    count++;
+    size += row.size();
+    auto kv = decodeKV(row);
+    pickEvents(BatchLogType::OP_BATCH_PUT, kv.first.toString(), kv.second.toString(), events);
+  }
+  if (!apply(events)) {
+    LOG(INFO) << idStr_ << "Failed to apply data while committing snapshot.";
+    return {
+        nebula::cpp2::ErrorCode::E_RAFT_PERSIST_SNAPSHOT_FAILED, kNoSnapshotCount, kNoSnapshotSize};
+  }
+  if (finished) {
+    CHECK(!raftLock_.try_lock());
+    leaderCommitId_ = committedLogId;
+    lastApplyLogId_ = committedLogId;
+    persist(committedLogId, committedLogTerm, lastApplyLogId_);
+    LOG(INFO) << folly::sformat(
+        "Commit snapshot to : committedLogId={},"
+        "committedLogTerm={}, lastApplyLogId_={}",
+        committedLogId,
+        committedLogTerm,
+        lastApplyLogId_);
+  }
+  return {nebula::cpp2::ErrorCode::SUCCEEDED, count, size};
+}
+
+}  // namespace kvstore
+}  // namespace nebula
@@ -0,0 +1,165 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_LISTENER_CDC_CDCLISTENER_H_
+#define KVSTORE_LISTENER_CDC_CDCLISTENER_H_
+
+#include <boost/filesystem.hpp>
+
+#include "kvstore/listener/Listener.h"
+#include "kvstore/listener/cdc/CdcEventQueue.h"
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief A change-data-capture listener. It decodes the wal of a part into typed vertex/edge
+ * change events and appends them to a durable local queue, so a downstream pipeline can pull
+ * the change stream from the queue instead of double-writing at ingest time. The queue is the
+ * state machine of this listener: the applied log id only advances after a batch of events is
+ * durable in the queue, a crash replays the tail from the wal.
+ */
+class CDCListener : public Listener {
+ public:
+  /**
+   * @brief Construct a new CDC Listener, it is a derived class of Listener
+   *
+   * @param spaceId
+   * @param partId
+   * @param localAddr Listener ip/addr
+   * @param walPath Listener's wal path
+   * @param ioPool IOThreadPool for listener
+   * @param workers Background thread for listener
+   * @param handlers Worker thread for listener
+   * @param schemaMan Schema manager
+   */
+  CDCListener(GraphSpaceID spaceId,
+              PartitionID partId,
+              HostAddr localAddr,
+              const std::string& walPath,
+              std::shared_ptr<folly::IOThreadPoolExecutor> ioPool,
+              std::shared_ptr<thread::GenericThreadPool> workers,
+              std::shared_ptr<folly::Executor> handlers,
+              meta::SchemaManager* schemaMan)
+      : Listener(spaceId, partId, std::move(localAddr), walPath, ioPool, workers, handlers),
+        schemaMan_(schemaMan) {
+    CHECK(!!schemaMan);
+    lastApplyLogFile_ = std::make_unique<std::string>(
+        folly::stringPrintf("%s/last_apply_log_%d", walPath.c_str(), partId));
+    auto queueDir = boost::filesystem::path(walPath).parent_path() / "cdc";
+    queue_ = std::make_unique<CdcEventQueue>(spaceId, partId, queueDir.string());
+  }
+
+  /**
+   * @brief Pull up to limit events with seqId >= fromSeqId from the change queue, in sequence
+   * id order. This is the consumer-facing api, the caller tracks its own cursor and re-pulls
+   * from the last seen seqId + 1.
+   */
+  StatusOr<std::vector<CdcEvent>> pull(int64_t fromSeqId, int32_t limit) {
+    return queue_->pull(fromSeqId, limit);
+  }
+
+  /**
+   * @brief Sequence id the next captured event will get, consumers poll again once their
+   * cursor catches up with it
+   */
+  int64_t nextSeqId() const {
+    return queue_->nextSeqId();
+  }
+
+  /**
+   * @brief Drop queue segments fully consumed below seqId, called once the downstream
+   * pipeline acknowledged consumption
+   */
+  void ackConsumed(int64_t seqId) {
+    queue_->dropUntil(seqId);
+  }
+
+ protected:
+  /**
+   * @brief Init work: get vid length, open the event queue
+   */
+  void init() override;
+
+  /**
+   * @brief Append the typed events of one commit round to the queue as a single durable batch
+   *
+   * @param events Events decoded from the wal
+   * @return True if the batch is durable in the queue. False if failed.
+   */
+  bool apply(std::vector<CdcEvent>& events);
+
+  /**
+   * @brief Persist commitLogId commitLogTerm and lastApplyLogId
+   */
+  bool persist(LogID lastId, TermID lastTerm, LogID lastApplyLogId) override;
+
+  /**
+   * @brief Get commit log id and commit log term from persistence storage, called in start()
+   *
+   * @return std::pair<LogID, TermID>
+   */
+  std::pair<LogID, TermID> lastCommittedLogId() override;
+
+  /**
+   * @brief Get last apply id from persistence storage, used in initialization
+   *
+   * @return LogID Last apply log id
+   */
+  LogID lastApplyLogId() override;
+
+  void processLogs() override;
+
+  std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> commitSnapshot(
+      const std::vector<std::string>& data,
+      LogID committedLogId,
+      TermID committedLogTerm,
+      bool finished) override;
+
+ private:
+  /**
+   * @brief Decode one kv from the wal into typed events, non-data keys (indexes, system keys)
+   * are skipped
+   *
+   * @param type Put or remove
+   * @param key Encoded key
+   * @param value Encoded row value, empty on remove
+   * @param events Decoded events are appended here
+   */
+  void pickEvents(BatchLogType type,
+                  const std::string& key,
+                  const std::string& value,
+                  std::vector<CdcEvent>& events);
+
+  /**
+   * @brief Write last commit id, last commit term, last apply id to a file
+   *
+   * @param lastId Last commit id
+   * @param lastTerm Last commit term
+   * @param lastApplyLogId Last apply id
+   * @return Whether persist succeed
+   */
+  bool writeAppliedId(LogID lastId, TermID lastTerm, LogID lastApplyLogId);
+
+  /**
+   * @brief Encode last commit id, last commit term, last apply id to a file
+   *
+   * @param lastId Last commit id
+   * @param lastTerm Last commit term
+   * @param lastApplyLogId Last apply id
+   * @return Encoded string
+   */
+  std::string encodeAppliedId(LogID lastId, TermID lastTerm, LogID lastApplyLogId) const;
+
+ private:
+  meta::SchemaManager* schemaMan_{nullptr};
+  std::unique_ptr<std::string> lastApplyLogFile_{nullptr};
+  std::unique_ptr<CdcEventQueue> queue_;
+  int32_t vIdLen_;
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+#endif
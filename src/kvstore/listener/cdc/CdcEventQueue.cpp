@@ -0,0 +1,374 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "kvstore/listener/cdc/CdcEventQueue.h"
+
+#include <folly/hash/Checksum.h>
+#include <zstd.h>
+
+#include "common/fs/FileUtils.h"
+
+DEFINE_int64(cdc_queue_segment_size,
+             64 * 1024 * 1024,
+             "Rotate a cdc queue segment file once it grows beyond this many bytes");
+DEFINE_bool(cdc_queue_compress,
+            true,
+            "Whether to zstd-compress each batch written to the cdc queue");
+
+namespace nebula {
+namespace kvstore {
+
+// firstSeq + count + codec + rawLen, the fixed part of a record after the length field
+static constexpr size_t kRecordHeadLen =
+    sizeof(int64_t) + sizeof(uint32_t) + sizeof(int8_t) + sizeof(uint32_t);
+static constexpr int32_t kCdcCompressLevel = 3;
+static constexpr int8_t kCodecNone = 0;
+static constexpr int8_t kCodecZstd = 1;
+
+CdcEventQueue::CdcEventQueue(GraphSpaceID spaceId, PartitionID partId, const std::string& dir)
+    : spaceId_(spaceId),
+      partId_(partId),
+      dir_(dir),
+      idStr_(folly::stringPrintf("[Space: %d, Part: %d] ", spaceId, partId)) {}
+
+CdcEventQueue::~CdcEventQueue() {
+  if (fd_ >= 0) {
+    close(fd_);
+  }
+}
+
+std::string CdcEventQueue::segmentFile(int64_t firstSeqId) const {
+  return folly::stringPrintf("%s/cdc.%ld", dir_.c_str(), firstSeqId);
+}
+
+std::vector<int64_t> CdcEventQueue::listSegments() const {
+  std::vector<int64_t> segments;
+  for (const auto& name : fs::FileUtils::listAllFilesInDir(dir_.c_str(), false, "cdc.*")) {
+    try {
+      segments.emplace_back(folly::to<int64_t>(name.substr(4)));
+    } catch (const std::exception& e) {
+      LOG(WARNING) << idStr_ << "Skip unexpected file in cdc queue dir: " << name;
+    }
+  }
+  std::sort(segments.begin(), segments.end());
+  return segments;
+}
+
+bool CdcEventQueue::open() {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (!fs::FileUtils::makeDir(dir_)) {
+    LOG(ERROR) << idStr_ << "Failed to create cdc queue dir " << dir_;
+    return false;
+  }
+  auto segments = listSegments();
+  if (segments.empty()) {
+    curSegStart_ = nextSeqId_;
+  } else {
+    // Only the newest segment can have a torn tail, scan it to recover the next sequence id
+    curSegStart_ = segments.back();
+    nextSeqId_ = curSegStart_;
+    auto file = segmentFile(curSegStart_);
+    int32_t fd = ::open(file.c_str(), O_RDONLY);
+    if (fd < 0) {
+      LOG(ERROR) << idStr_ << "Failed to open cdc segment " << file << " (" << errno
+                 << "): " << strerror(errno);
+      return false;
+    }
+    int64_t offset = 0;
+    while (true) {
+      uint32_t recordLen = 0;
+      auto rd = ::pread(fd, &recordLen, sizeof(recordLen), offset);
+      if (rd != static_cast<ssize_t>(sizeof(recordLen))) {
+        break;
+      }
+      if (recordLen < kRecordHeadLen + sizeof(uint32_t)) {
+        break;
+      }
+      std::string record(recordLen, '\0');
+      rd = ::pread(fd, &record[0], recordLen, offset + sizeof(recordLen));
+      if (rd != static_cast<ssize_t>(recordLen)) {
+        break;
+      }
+      auto payloadLen = recordLen - kRecordHeadLen - sizeof(uint32_t);
+      uint32_t crc = 0;
+      memcpy(&crc, record.data() + recordLen - sizeof(uint32_t), sizeof(uint32_t));
+      auto actual = folly::crc32c(
+          reinterpret_cast<const uint8_t*>(record.data()) + kRecordHeadLen, payloadLen);
+      if (crc != actual) {
+        break;
+      }
+      int64_t firstSeq = 0;
+      uint32_t count = 0;
+      memcpy(&firstSeq, record.data(), sizeof(int64_t));
+      memcpy(&count, record.data() + sizeof(int64_t), sizeof(uint32_t));
+      nextSeqId_ = firstSeq + count;
+      offset += sizeof(recordLen) + recordLen;
+    }
+    close(fd);
+    curSegBytes_ = offset;
+  }
+  fd_ = ::open(segmentFile(curSegStart_).c_str(), O_CREAT | O_WRONLY | O_CLOEXEC, 0644);
+  if (fd_ < 0) {
+    LOG(ERROR) << idStr_ << "Failed to open cdc segment " << segmentFile(curSegStart_) << " ("
+               << errno << "): " << strerror(errno);
+    return false;
+  }
+  // Drop a torn tail left by a crash mid-append so the next record starts on a clean boundary
+  if (ftruncate(fd_, curSegBytes_) < 0) {
+    LOG(ERROR) << idStr_ << "Failed to truncate cdc segment (" << errno
+               << "): " << strerror(errno);
+    return false;
+  }
+  LOG(INFO) << idStr_ << "Cdc queue opened, next seq id " << nextSeqId_;
+  return true;
+}
+
+bool CdcEventQueue::rotateIfNeeded() {
+  if (curSegBytes_ < FLAGS_cdc_queue_segment_size) {
+    return true;
+  }
+  auto file = segmentFile(nextSeqId_);
+  int32_t fd = ::open(file.c_str(), O_CREAT | O_WRONLY | O_TRUNC | O_CLOEXEC, 0644);
+  if (fd < 0) {
+    LOG(ERROR) << idStr_ << "Failed to rotate cdc segment to " << file << " (" << errno
+               << "): " << strerror(errno);
+    return false;
+  }
+  close(fd_);
+  fd_ = fd;
+  curSegStart_ = nextSeqId_;
+  curSegBytes_ = 0;
+  return true;
+}
+
+void CdcEventQueue::encodeEvent(const CdcEvent& event, std::string& buf) {
+  buf.append(1, static_cast<char>(event.type));
+  buf.append(reinterpret_cast<const char*>(&event.schemaId), sizeof(int32_t));
+  buf.append(reinterpret_cast<const char*>(&event.rank), sizeof(EdgeRanking));
+  auto appendStr = [&buf](const std::string& str) {
+    uint32_t len = str.size();
+    buf.append(reinterpret_cast<const char*>(&len), sizeof(uint32_t));
+    buf.append(str);
+  };
+  appendStr(event.vId);
+  appendStr(event.dstId);
+  appendStr(event.value);
+}
+
+bool CdcEventQueue::decodeEvent(folly::StringPiece payload, size_t& offset, CdcEvent& event) {
+  if (offset + 1 + sizeof(int32_t) + sizeof(EdgeRanking) > payload.size()) {
+    return false;
+  }
+  event.type = static_cast<CdcEvent::Type>(payload[offset]);
+  offset += 1;
+  memcpy(&event.schemaId, payload.data() + offset, sizeof(int32_t));
+  offset += sizeof(int32_t);
+  memcpy(&event.rank, payload.data() + offset, sizeof(EdgeRanking));
+  offset += sizeof(EdgeRanking);
+  auto readStr = [payload, &offset](std::string& str) {
+    if (offset + sizeof(uint32_t) > payload.size()) {
+      return false;
+    }
+    uint32_t len = 0;
+    memcpy(&len, payload.data() + offset, sizeof(uint32_t));
+    offset += sizeof(uint32_t);
+    if (offset + len > payload.size()) {
+      return false;
+    }
+    str.assign(payload.data() + offset, len);
+    offset += len;
+    return true;
+  };
+  return readStr(event.vId) && readStr(event.dstId) && readStr(event.value);
+}
+
+StatusOr<int64_t> CdcEventQueue::appendBatch(std::vector<CdcEvent>& events) {
+  std::lock_guard<std::mutex> guard(lock_);
+  if (fd_ < 0) {
+    return Status::Error("Cdc queue is not open");
+  }
+  if (events.empty()) {
+    return nextSeqId_;
+  }
+  if (!rotateIfNeeded()) {
+    return Status::Error("Failed to rotate cdc segment");
+  }
+  auto firstSeq = nextSeqId_;
+  std::string raw;
+  for (auto& event : events) {
+    event.seqId = nextSeqId_++;
+    encodeEvent(event, raw);
+  }
+
+  int8_t codec = kCodecNone;
+  std::string compressed;
+  if (FLAGS_cdc_queue_compress) {
+    compressed.resize(ZSTD_compressBound(raw.size()));
+    auto len =
+        ZSTD_compress(&compressed[0], compressed.size(), raw.data(), raw.size(), kCdcCompressLevel);
+    // Fall back to the raw payload when compression does not pay off
+    if (!ZSTD_isError(len) && len < raw.size()) {
+      compressed.resize(len);
+      codec = kCodecZstd;
+    }
+  }
+  const auto& payload = codec == kCodecZstd ? compressed : raw;
+
+  std::string record;
+  uint32_t recordLen = kRecordHeadLen + payload.size() + sizeof(uint32_t);
+  uint32_t count = events.size();
+  uint32_t rawLen = raw.size();
+  auto crc = folly::crc32c(reinterpret_cast<const uint8_t*>(payload.data()), payload.size());
+  record.reserve(sizeof(uint32_t) + recordLen);
+  record.append(reinterpret_cast<const char*>(&recordLen), sizeof(uint32_t))
+      .append(reinterpret_cast<const char*>(&firstSeq), sizeof(int64_t))
+      .append(reinterpret_cast<const char*>(&count), sizeof(uint32_t))
+      .append(reinterpret_cast<const char*>(&codec), sizeof(int8_t))
+      .append(reinterpret_cast<const char*>(&rawLen), sizeof(uint32_t))
+      .append(payload)
+      .append(reinterpret_cast<const char*>(&crc), sizeof(uint32_t));
+
+  ssize_t written = ::pwrite(fd_, record.data(), record.size(), curSegBytes_);
+  if (written != static_cast<ssize_t>(record.size())) {
+    LOG(ERROR) << idStr_ << "Failed to append cdc batch, bytesWritten:" << written
+               << ", expected:" << record.size() << ", error:" << strerror(errno);
+    // Roll back the torn record so the segment stays scannable, open() would do the same
+    if (ftruncate(fd_, curSegBytes_) < 0) {
+      LOG(ERROR) << idStr_ << "Failed to truncate cdc segment (" << errno
+                 << "): " << strerror(errno);
+    }
+    nextSeqId_ = firstSeq;
+    return Status::Error("Failed to append cdc batch");
+  }
+  if (fsync(fd_) < 0) {
+    LOG(ERROR) << idStr_ << "Failed to fsync cdc segment (" << errno << "): " << strerror(errno);
+    nextSeqId_ = firstSeq;
+    return Status::Error("Failed to fsync cdc segment");
+  }
+  curSegBytes_ += record.size();
+  return firstSeq;
+}
+
+bool CdcEventQueue::readSegment(int64_t segStart,
+                                int64_t fromSeqId,
+                                int32_t limit,
+                                std::vector<CdcEvent>& events) const {
+  auto file = segmentFile(segStart);
+  int32_t fd = ::open(file.c_str(), O_RDONLY);
+  if (fd < 0) {
+    LOG(ERROR) << idStr_ << "Failed to open cdc segment " << file << " (" << errno
+               << "): " << strerror(errno);
+    return false;
+  }
+  SCOPE_EXIT {
+    close(fd);
+  };
+  int64_t offset = 0;
+  while (static_cast<int32_t>(events.size()) < limit) {
+    uint32_t recordLen = 0;
+    auto rd = ::pread(fd, &recordLen, sizeof(recordLen), offset);
+    if (rd == 0) {
+      return true;
+    }
+    if (rd != static_cast<ssize_t>(sizeof(recordLen)) ||
+        recordLen < kRecordHeadLen + sizeof(uint32_t)) {
+      return false;
+    }
+    std::string record(recordLen, '\0');
+    rd = ::pread(fd, &record[0], recordLen, offset + sizeof(recordLen));
+    if (rd != static_cast<ssize_t>(recordLen)) {
+      return false;
+    }
+    offset += sizeof(recordLen) + recordLen;
+
+    int64_t firstSeq = 0;
+    uint32_t count = 0;
+    int8_t codec = 0;
+    uint32_t rawLen = 0;
+    memcpy(&firstSeq, record.data(), sizeof(int64_t));
+    memcpy(&count, record.data() + sizeof(int64_t), sizeof(uint32_t));
+    memcpy(&codec, record.data() + sizeof(int64_t) + sizeof(uint32_t), sizeof(int8_t));
+    memcpy(&rawLen,
+           record.data() + sizeof(int64_t) + sizeof(uint32_t) + sizeof(int8_t),
+           sizeof(uint32_t));
+    if (firstSeq + count <= fromSeqId) {
+      continue;
+    }
+    auto payloadLen = recordLen - kRecordHeadLen - sizeof(uint32_t);
+    uint32_t crc = 0;
+    memcpy(&crc, record.data() + recordLen - sizeof(uint32_t), sizeof(uint32_t));
+    auto actual = folly::crc32c(
+        reinterpret_cast<const uint8_t*>(record.data()) + kRecordHeadLen, payloadLen);
+    if (crc != actual) {
+      LOG(ERROR) << idStr_ << "Checksum mismatch in cdc segment " << file;
+      return false;
+    }
+
+    std::string raw;
+    folly::StringPiece payload(record.data() + kRecordHeadLen, payloadLen);
+    if (codec == kCodecZstd) {
+      raw.resize(rawLen);
+      auto len = ZSTD_decompress(&raw[0], raw.size(), payload.data(), payload.size());
+      if (ZSTD_isError(len) || len != rawLen) {
+        LOG(ERROR) << idStr_ << "Failed to decompress cdc record in " << file;
+        return false;
+      }
+      payload = folly::StringPiece(raw);
+    }
+    size_t pos = 0;
+    for (uint32_t i = 0; i < count; i++) {
+      CdcEvent event;
+      if (!decodeEvent(payload, pos, event)) {
+        LOG(ERROR) << idStr_ << "Malformed cdc record in " << file;
+        return false;
+      }
+      event.seqId = firstSeq + i;
+      if (event.seqId >= fromSeqId && static_cast<int32_t>(events.size()) < limit) {
+        events.emplace_back(std::move(event));
+      }
+    }
+  }
+  return true;
+}
+
+StatusOr<std::vector<CdcEvent>> CdcEventQueue::pull(int64_t fromSeqId, int32_t limit) const {
+  std::lock_guard<std::mutex> guard(lock_);
+  std::vector<CdcEvent> events;
+  if (limit <= 0 || fromSeqId >= nextSeqId_) {
+    return events;
+  }
+  auto segments = listSegments();
+  // Start from the newest segment which could contain fromSeqId, older events may already
+  // have been dropped
+  size_t idx = 0;
+  for (size_t i = 0; i < segments.size(); i++) {
+    if (segments[i] <= fromSeqId) {
+      idx = i;
+    }
+  }
+  for (; idx < segments.size() && static_cast<int32_t>(events.size()) < limit; idx++) {
+    if (!readSegment(segments[idx], fromSeqId, limit, events)) {
+      return Status::Error("Corrupted cdc segment cdc.%ld", segments[idx]);
+    }
+  }
+  return events;
+}
+
+void CdcEventQueue::dropUntil(int64_t seqId) {
+  std::lock_guard<std::mutex> guard(lock_);
+  auto segments = listSegments();
+  for (size_t i = 0; i + 1 < segments.size(); i++) {
+    // Segment i holds events below the start of segment i + 1, the active one is never dropped
+    if (segments[i + 1] <= seqId && segments[i] != curSegStart_) {
+      auto file = segmentFile(segments[i]);
+      if (!fs::FileUtils::remove(file.c_str())) {
+        LOG(WARNING) << idStr_ << "Failed to remove cdc segment " << file;
+      }
+    }
+  }
+}
+
+}  // namespace kvstore
+}  // namespace nebula
@@ -0,0 +1,156 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef KVSTORE_LISTENER_CDC_CDCEVENTQUEUE_H_
+#define KVSTORE_LISTENER_CDC_CDCEVENTQUEUE_H_
+
+#include "common/base/Base.h"
+#include "common/base/StatusOr.h"
+#include "common/thrift/ThriftTypes.h"
+
+DECLARE_int64(cdc_queue_segment_size);
+DECLARE_bool(cdc_queue_compress);
+
+namespace nebula {
+namespace kvstore {
+
+/**
+ * @brief One typed change event captured from the wal of a part. Vertex ids are the raw key
+ * bytes (fixed vIdLen), the consumer decodes them according to the space vid type.
+ */
+struct CdcEvent {
+  enum class Type : int8_t {
+    kPutVertex = 0,
+    kRemoveVertex = 1,
+    kPutEdge = 2,
+    kRemoveEdge = 3,
+  };
+
+  Type type{Type::kPutVertex};
+  // Position in the queue of the part, strictly increasing and gapless
+  int64_t seqId{0};
+  // Vertex id for vertex events, source vertex id for edge events
+  std::string vId;
+  // Destination vertex id, empty for vertex events
+  std::string dstId;
+  // Tag id for vertex events, edge type for edge events
+  int32_t schemaId{0};
+  // Edge rank, 0 for vertex events
+  EdgeRanking rank{0};
+  // Serialized row value, empty for remove events
+  std::string value;
+
+  bool operator==(const CdcEvent& rhs) const {
+    return type == rhs.type && seqId == rhs.seqId && vId == rhs.vId && dstId == rhs.dstId &&
+           schemaId == rhs.schemaId && rank == rhs.rank && value == rhs.value;
+  }
+};
+
+/**
+ * @brief Durable file-backed queue of CdcEvent, one per listener part. Each append writes one
+ * zstd-compressed record protected by a checksum and fsyncs it, so a crash or torn write never
+ * loses or corrupts an acknowledged batch. Consumers pull by sequence id at their own pace, the
+ * queue is the hand-over point between the listener apply thread and the downstream pipeline.
+ *
+ * The queue directory holds segment files named "cdc.<firstSeqIdOfSegment>", rotated when the
+ * active one exceeds cdc_queue_segment_size. A record is laid out as
+ *   recordLen(uint32) | firstSeq(int64) | count(uint32) | codec(int8) | rawLen(uint32) |
+ *   payload | crc32c(uint32, over payload as stored)
+ * where payload is the concatenation of the encoded events, zstd-compressed when codec is 1.
+ */
+class CdcEventQueue {
+ public:
+  CdcEventQueue(GraphSpaceID spaceId, PartitionID partId, const std::string& dir);
+
+  ~CdcEventQueue();
+
+  /**
+   * @brief Recover nextSeqId_ by scanning the newest segment, creating the directory if
+   * needed. A trailing partial record from a crash mid-append is truncated away.
+   *
+   * @return Whether the queue is usable
+   */
+  bool open();
+
+  /**
+   * @brief Append a batch of events as one durable record, assigning their sequence ids
+   *
+   * @param events Events to append, seqId fields are filled in
+   * @return StatusOr<int64_t> First assigned sequence id
+   */
+  StatusOr<int64_t> appendBatch(std::vector<CdcEvent>& events);
+
+  /**
+   * @brief Read up to limit events with seqId >= fromSeqId, in sequence id order
+   *
+   * @param fromSeqId First wanted sequence id, older ids may already be dropped
+   * @param limit Max number of events to return
+   */
+  StatusOr<std::vector<CdcEvent>> pull(int64_t fromSeqId, int32_t limit) const;
+
+  /**
+   * @brief Sequence id the next appended event will get
+   */
+  int64_t nextSeqId() const {
+    std::lock_guard<std::mutex> guard(lock_);
+    return nextSeqId_;
+  }
+
+  /**
+   * @brief Remove whole segments all of whose events are below seqId, the active segment is
+   * always kept. Called once the downstream pipeline acknowledged consumption.
+   */
+  void dropUntil(int64_t seqId);
+
+ private:
+  std::string segmentFile(int64_t firstSeqId) const;
+
+  /**
+   * @brief Sorted first sequence ids of all segments in the directory
+   */
+  std::vector<int64_t> listSegments() const;
+
+  /**
+   * @brief Close the active segment and open a new one starting at nextSeqId_ when the active
+   * one grew beyond cdc_queue_segment_size
+   */
+  bool rotateIfNeeded();
+
+  static void encodeEvent(const CdcEvent& event, std::string& buf);
+
+  /**
+   * @brief Decode one event starting at offset, advancing it. Returns false on malformed data
+   */
+  static bool decodeEvent(folly::StringPiece payload, size_t& offset, CdcEvent& event);
+
+  /**
+   * @brief Read all records of a segment, appending events in [fromSeqId, ...) until limit is
+   * reached. Returns false when the segment tail is corrupted.
+   */
+  bool readSegment(int64_t segStart,
+                   int64_t fromSeqId,
+                   int32_t limit,
+                   std::vector<CdcEvent>& events) const;
+
+ private:
+  GraphSpaceID spaceId_;
+  PartitionID partId_;
+  std::string dir_;
+  std::string idStr_;
+
+  // fd of the active segment, opened for append
+  int32_t fd_{-1};
+  // first sequence id of the active segment
+  int64_t curSegStart_{0};
+  // bytes written to the active segment so far
+  int64_t curSegBytes_{0};
+  int64_t nextSeqId_{1};
+
+  mutable std::mutex lock_;
+};
+
+}  // namespace kvstore
+}  // namespace nebula
+#endif
@@ -5,12 +5,28 @@
 
 #include "kvstore/listener/elasticsearch/ESListener.h"
 
+#include <folly/futures/Future.h>
+
 #include "common/plugin/fulltext/elasticsearch/ESAdapter.h"
+#include "common/time/WallClock.h"
 #include "common/utils/NebulaKeyUtils.h"
 
 DECLARE_uint32(ft_request_retry_times);
 DECLARE_int32(ft_bulk_batch_size);
 DEFINE_int32(listener_commit_batch_size, 1000, "Max batch size when listener commit");
+DEFINE_int32(listener_bulk_flush_docs,
+             0,
+             "Accumulate this many fulltext documents across listener commit rounds before "
+             "flushing them to elasticsearch in one shot. 0 flushes every round");
+DEFINE_int32(listener_bulk_flush_interval_ms,
+             1000,
+             "Flush the accumulated fulltext documents at least this often even if "
+             "listener_bulk_flush_docs is not reached yet, and retry a failed flush at most "
+             "this often");
+DEFINE_int32(listener_bulk_concurrency,
+             1,
+             "Number of bulk requests sent to elasticsearch in parallel per flush, each "
+             "carrying at most ft_bulk_batch_size documents");
 
 namespace nebula {
 namespace kvstore {
@@ -34,14 +50,18 @@ void ESListener::init() {
 }
 
 bool ESListener::apply(const BatchHolder& batch) {
-  nebula::plugin::ESBulk bulk;
-  auto callback = [&bulk](BatchLogType type,
-                          const std::string& index,
-                          const std::string& vid,
-                          const std::string& src,
-                          const std::string& dst,
-                          int64_t rank,
-                          std::map<std::string, std::string> data) {
+  auto callback = [this](BatchLogType type,
+                         const std::string& index,
+                         const std::string& vid,
+                         const std::string& src,
+                         const std::string& dst,
+                         int64_t rank,
+                         std::map<std::string, std::string> data) {
+    if (pendingBulks_.empty() || docsInLastBulk_ >= std::max(FLAGS_ft_bulk_batch_size, 1)) {
+      pendingBulks_.emplace_back();
+      docsInLastBulk_ = 0;
+    }
+    auto& bulk = pendingBulks_.back();
     if (type == BatchLogType::OP_BATCH_PUT) {
       bulk.put(index, vid, src, dst, rank, std::move(data));
     } else if (type == BatchLogType::OP_BATCH_REMOVE) {
@@ -49,23 +69,79 @@ bool ESListener::apply(const BatchHolder& batch) {
     } else {
       LOG(FATAL) << "Unexpect";
     }
+    ++docsInLastBulk_;
+    ++pendingDocs_;
   };
   for (const auto& log : batch.getBatch()) {
     pickTagAndEdgeData(std::get<0>(log), std::get<1>(log), std::get<2>(log), callback);
   }
-  if (!bulk.empty()) {
-    auto esAdapterRes = getESAdapter();
-    if (!esAdapterRes.ok()) {
-      LOG(ERROR) << esAdapterRes.status();
-      return false;
+  if (pendingDocs_ == 0) {
+    return true;
+  }
+  auto nowMs = time::WallClock::fastNowInMilliSec();
+  if (pendingDocs_ < FLAGS_listener_bulk_flush_docs &&
+      nowMs - lastFlushMs_ < FLAGS_listener_bulk_flush_interval_ms) {
+    // Keep accumulating. The documents stay replayable from the wal because the applied log id
+    // is only persisted after a successful flush, so nothing is lost on a crash.
+    return true;
+  }
+  flushPendingBulks();
+  return true;
+}
+
+bool ESListener::flushPendingBulks() {
+  if (pendingBulks_.empty()) {
+    return true;
+  }
+  lastFlushMs_ = time::WallClock::fastNowInMilliSec();
+  auto esAdapterRes = getESAdapter();
+  if (!esAdapterRes.ok()) {
+    LOG(ERROR) << esAdapterRes.status();
+    ++flushFailures_;
+    return false;
+  }
+  auto esAdapter = std::move(esAdapterRes).value();
+  auto concurrency = static_cast<size_t>(std::max(FLAGS_listener_bulk_concurrency, 1));
+  bool succeeded = true;
+  for (size_t i = 0; i < pendingBulks_.size() && succeeded; i += concurrency) {
+    auto end = std::min(pendingBulks_.size(), i + concurrency);
+    if (end - i == 1) {
+      auto status = esAdapter.bulk(pendingBulks_[i]);
+      if (!status.ok()) {
+        LOG(ERROR) << status;
+        succeeded = false;
+      }
+      continue;
+    }
+    std::vector<folly::Future<Status>> futures;
+    futures.reserve(end - i);
+    for (size_t j = i; j < end; j++) {
+      // Each request runs on its own copy of the adapter, the clients are cheap to copy
+      futures.emplace_back(folly::via(
+          executor_.get(), [adapter = esAdapter, this, j]() mutable {
+            return adapter.bulk(pendingBulks_[j]);
+          }));
     }
-    auto esAdapter = std::move(esAdapterRes).value();
-    auto status = esAdapter.bulk(bulk);
-    if (!status.ok()) {
-      LOG(ERROR) << status;
-      return false;
+    auto tries = folly::collectAll(std::move(futures)).get();
+    for (auto& t : tries) {
+      if (t.hasException()) {
+        LOG(ERROR) << t.exception().what();
+        succeeded = false;
+      } else if (!t.value().ok()) {
+        LOG(ERROR) << t.value();
+        succeeded = false;
+      }
     }
   }
+  if (!succeeded) {
+    ++flushFailures_;
+    // Keep the buffer, the documents are idempotent by doc id and the next flush resends them
+    return false;
+  }
+  pendingBulks_.clear();
+  pendingDocs_ = 0;
+  docsInLastBulk_ = 0;
+  flushFailures_ = 0;
   return true;
 }
 
@@ -233,10 +309,22 @@ void ESListener::processLogs() {
   std::unique_ptr<LogIterator> iter;
   {
     std::lock_guard<std::mutex> guard(raftLock_);
-    if (lastApplyLogId_ >= committedLogId_) {
-      return;
+    if (lastApplyLogId_ < committedLogId_ && flushFailures_ == 0) {
+      iter = wal_->iterator(lastApplyLogId_ + 1, committedLogId_);
     }
-    iter = wal_->iterator(lastApplyLogId_ + 1, committedLogId_);
+  }
+  if (iter == nullptr) {
+    // Either nothing new was committed, or the last flush failed. While elasticsearch lags we
+    // don't pull more logs from the wal, we just retry the pending buffer at the flush
+    // interval; the backlog stays in the wal and ingest degrades to the speed ES can absorb.
+    auto nowMs = time::WallClock::fastNowInMilliSec();
+    if (pendingDocs_ > 0 && nowMs - lastFlushMs_ >= FLAGS_listener_bulk_flush_interval_ms &&
+        flushPendingBulks()) {
+      std::lock_guard<std::mutex> guard(raftLock_);
+      persist(committedLogId_, term_, lastApplyLogId_);
+      VLOG(2) << idStr_ << "Listener succeeded apply log to " << lastApplyLogId_;
+    }
+    return;
   }
 
   LogID lastApplyId = -1;
@@ -282,8 +370,16 @@ void ESListener::processLogs() {
         }
         break;
       }
-      case OP_BATCH_WRITE: {
-        auto batchData = decodeBatchValue(log);
+      case OP_BATCH_WRITE:
+      case OP_BATCH_WRITE_COMPACT: {
+        auto batchDataRet = decodeBatchValue(log);
+        if (!batchDataRet.ok()) {
+          // Neither skip the entry nor apply a partial batch, bail out without moving
+          // lastApplyLogId_ so the next round retries from the same log
+          LOG(ERROR) << idStr_ << "Failed to decode batch log: " << batchDataRet.status();
+          return;
+        }
+        auto batchData = std::move(batchDataRet).value();
         for (auto& op : batchData) {
           // OP_BATCH_REMOVE and OP_BATCH_REMOVE_RANGE is ignored
           switch (op.first) {
@@ -324,8 +420,12 @@ void ESListener::processLogs() {
   if (lastApplyId != -1 && apply(batch)) {
     std::lock_guard<std::mutex> guard(raftLock_);
     lastApplyLogId_ = lastApplyId;
-    persist(committedLogId_, term_, lastApplyLogId_);
-    VLOG(2) << idStr_ << "Listener succeeded apply log to " << lastApplyLogId_;
+    // Only advance the persisted applied id once the buffer is fully flushed to elasticsearch,
+    // a restart replays the still-buffered tail from the wal
+    if (pendingDocs_ == 0) {
+      persist(committedLogId_, term_, lastApplyLogId_);
+      VLOG(2) << idStr_ << "Listener succeeded apply log to " << lastApplyLogId_;
+    }
   }
 }
 
@@ -344,7 +444,9 @@ std::tuple<nebula::cpp2::ErrorCode, int64_t, int64_t> ESListener::commitSnapshot
     auto kv = decodeKV(row);
     batch.put(kv.first.toString(), kv.second.toString());
   }
-  if (!apply(batch)) {
+  // Snapshot rows are not in the local wal, so they cannot be buffered across rounds, flush
+  // them right away
+  if (!apply(batch) || !flushPendingBulks()) {
     LOG(INFO) << idStr_ << "Failed to apply data while committing snapshot.";
     return {
         nebula::cpp2::ErrorCode::E_RAFT_PERSIST_SNAPSHOT_FAILED, kNoSnapshotCount, kNoSnapshotSize};
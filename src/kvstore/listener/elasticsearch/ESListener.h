@@ -49,13 +49,24 @@ class ESListener : public Listener {
   void init() override;
 
   /**
-   * @brief Send data by es client
+   * @brief Collect the fulltext documents of the batch into the pending bulk buffer, and flush
+   * the buffer to elasticsearch once it is large or old enough. The buffered documents stay
+   * replayable from the wal until a flush succeeds, see processLogs().
    *
    * @param data Key/value to apply
-   * @return True if succeed. False if failed.
+   * @return True if the documents were buffered (or flushed). False if failed.
    */
   bool apply(const BatchHolder& batch);
 
+  /**
+   * @brief Send all pending bulks to elasticsearch, up to FLAGS_listener_bulk_concurrency
+   * requests in parallel. The buffer is kept on failure so the next flush resends it, the
+   * documents are idempotent by doc id.
+   *
+   * @return Whether all pending bulks were acknowledged
+   */
+  bool flushPendingBulks();
+
   /**
    * @brief Persist commitLogId commitLogTerm and lastApplyLogId
    */
@@ -126,6 +137,14 @@ class ESListener : public Listener {
   std::unique_ptr<std::string> spaceName_{nullptr};
   int32_t vIdLen_;
   bool isIntVid_{false};
+
+  // Documents accumulated across commit rounds, chunked into bulks of at most
+  // FLAGS_ft_bulk_batch_size documents each so a flush can send them in parallel
+  std::vector<nebula::plugin::ESBulk> pendingBulks_;
+  int64_t pendingDocs_{0};
+  int64_t docsInLastBulk_{0};
+  int64_t lastFlushMs_{0};
+  int64_t flushFailures_{0};
 };
 
 }  // namespace kvstore
@@ -0,0 +1,135 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "common/fs/TempDir.h"
+#include "kvstore/listener/cdc/CdcEventQueue.h"
+
+DECLARE_int64(cdc_queue_segment_size);
+
+namespace nebula {
+namespace kvstore {
+
+static std::vector<CdcEvent> mockEvents(int32_t count, int32_t startVid) {
+  std::vector<CdcEvent> events;
+  for (int32_t i = 0; i < count; i++) {
+    CdcEvent event;
+    if (i % 2 == 0) {
+      event.type = CdcEvent::Type::kPutVertex;
+      event.vId = folly::stringPrintf("vertex_%d", startVid + i);
+      event.schemaId = 3;
+      event.value = std::string(100, 'v');
+    } else {
+      event.type = CdcEvent::Type::kPutEdge;
+      event.vId = folly::stringPrintf("vertex_%d", startVid + i);
+      event.dstId = folly::stringPrintf("vertex_%d", startVid + i + 1);
+      event.schemaId = 5;
+      event.rank = i;
+      event.value = std::string(100, 'e');
+    }
+    events.emplace_back(std::move(event));
+  }
+  return events;
+}
+
+TEST(CdcEventQueueTest, AppendPullTest) {
+  fs::TempDir root("/tmp/cdc_event_queue_test.XXXXXX");
+  CdcEventQueue queue(1, 1, folly::stringPrintf("%s/cdc", root.path()));
+  ASSERT_TRUE(queue.open());
+  EXPECT_EQ(1, queue.nextSeqId());
+
+  auto batch1 = mockEvents(10, 0);
+  auto ret = queue.appendBatch(batch1);
+  ASSERT_TRUE(ret.ok());
+  EXPECT_EQ(1, ret.value());
+  auto batch2 = mockEvents(10, 10);
+  ret = queue.appendBatch(batch2);
+  ASSERT_TRUE(ret.ok());
+  EXPECT_EQ(11, ret.value());
+  EXPECT_EQ(21, queue.nextSeqId());
+
+  // pull everything, sequence ids are gapless and events round-trip
+  auto pulled = queue.pull(1, 100);
+  ASSERT_TRUE(pulled.ok());
+  ASSERT_EQ(20, pulled.value().size());
+  for (int32_t i = 0; i < 20; i++) {
+    EXPECT_EQ(i + 1, pulled.value()[i].seqId);
+    const auto& expected = i < 10 ? batch1[i] : batch2[i - 10];
+    EXPECT_EQ(expected, pulled.value()[i]);
+  }
+
+  // pull from the middle of a batch with a limit
+  pulled = queue.pull(15, 3);
+  ASSERT_TRUE(pulled.ok());
+  ASSERT_EQ(3, pulled.value().size());
+  EXPECT_EQ(15, pulled.value()[0].seqId);
+  EXPECT_EQ(17, pulled.value()[2].seqId);
+
+  // nothing beyond the end
+  pulled = queue.pull(21, 100);
+  ASSERT_TRUE(pulled.ok());
+  EXPECT_TRUE(pulled.value().empty());
+}
+
+TEST(CdcEventQueueTest, RecoverTest) {
+  fs::TempDir root("/tmp/cdc_event_queue_test.XXXXXX");
+  auto dir = folly::stringPrintf("%s/cdc", root.path());
+  {
+    CdcEventQueue queue(1, 1, dir);
+    ASSERT_TRUE(queue.open());
+    auto batch = mockEvents(10, 0);
+    ASSERT_TRUE(queue.appendBatch(batch).ok());
+  }
+  // a new queue over the same directory picks up where the old one stopped
+  CdcEventQueue queue(1, 1, dir);
+  ASSERT_TRUE(queue.open());
+  EXPECT_EQ(11, queue.nextSeqId());
+  auto batch = mockEvents(5, 10);
+  auto ret = queue.appendBatch(batch);
+  ASSERT_TRUE(ret.ok());
+  EXPECT_EQ(11, ret.value());
+  auto pulled = queue.pull(1, 100);
+  ASSERT_TRUE(pulled.ok());
+  EXPECT_EQ(15, pulled.value().size());
+}
+
+TEST(CdcEventQueueTest, RotateAndDropTest) {
+  fs::TempDir root("/tmp/cdc_event_queue_test.XXXXXX");
+  FLAGS_cdc_queue_segment_size = 1024;
+  SCOPE_EXIT {
+    FLAGS_cdc_queue_segment_size = 64 * 1024 * 1024;
+  };
+  CdcEventQueue queue(1, 1, folly::stringPrintf("%s/cdc", root.path()));
+  ASSERT_TRUE(queue.open());
+  for (int32_t i = 0; i < 10; i++) {
+    auto batch = mockEvents(10, i * 10);
+    ASSERT_TRUE(queue.appendBatch(batch).ok());
+  }
+  // all events are still reachable across the rotated segments
+  auto pulled = queue.pull(1, 1000);
+  ASSERT_TRUE(pulled.ok());
+  ASSERT_EQ(100, pulled.value().size());
+  EXPECT_EQ(100, pulled.value().back().seqId);
+
+  // acknowledging consumption drops the fully consumed segments
+  queue.dropUntil(51);
+  pulled = queue.pull(51, 1000);
+  ASSERT_TRUE(pulled.ok());
+  ASSERT_EQ(50, pulled.value().size());
+  EXPECT_EQ(51, pulled.value().front().seqId);
+}
+
+}  // namespace kvstore
+}  // namespace nebula
+
+int main(int argc, char** argv) {
+  testing::InitGoogleTest(&argc, argv);
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  return RUN_ALL_TESTS();
+}
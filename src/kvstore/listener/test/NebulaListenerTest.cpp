@@ -168,8 +168,9 @@ class DummyListener : public Listener {
           }
           break;
         }
-        case OP_BATCH_WRITE: {
-          auto batchData = decodeBatchValue(log);
+        case OP_BATCH_WRITE:
+        case OP_BATCH_WRITE_COMPACT: {
+          auto batchData = decodeBatchValue(log).value();
           for (auto& op : batchData) {
             // OP_BATCH_REMOVE and OP_BATCH_REMOVE_RANGE is ignored
             switch (op.first) {
@@ -24,6 +24,11 @@ DEFINE_int32(raft_rpc_timeout_ms, 1000, "rpc timeout for raft client");
 DEFINE_int32(pause_host_time_factor,
              4,
              "The factor of pause host time based on raft heartbeat interval");
+DEFINE_int32(raft_heartbeat_batch_window_ms,
+             0,
+             "heartbeats of all parts destined to the same peer host within this window are "
+             "multiplexed into a single batchHeartbeat rpc, 0 means every part sends its own "
+             "heartbeat rpc");
 
 DECLARE_bool(trace_raft);
 DECLARE_uint32(raft_heartbeat_interval_secs);
@@ -33,6 +38,20 @@ namespace raftex {
 
 using nebula::network::NetworkUtils;
 
+namespace {
+
+// Heartbeats of all parts destined to the same peer host, parked until the batch window closes.
+// The registry is process-wide: Hosts of different parts pointing to the same peer share a batch
+struct HeartbeatBatch {
+  std::vector<cpp2::HeartbeatRequest> reqs;
+  std::vector<folly::Promise<cpp2::HeartbeatResponse>> promises;
+};
+
+std::mutex hbBatchLock;
+std::unordered_map<HostAddr, HeartbeatBatch> hbBatches;
+
+}  // anonymous namespace
+
 Host::Host(const HostAddr& addr, std::shared_ptr<RaftPart> part, bool isLearner)
     : part_(std::move(part)),
       addr_(addr),
@@ -327,7 +346,8 @@ Host::prepareAppendLogRequest() {
     for (size_t cnt = 0; it->valid() && cnt < FLAGS_max_appendlog_batch_size; ++(*it), ++cnt) {
       cpp2::RaftLogEntry entry;
       entry.cluster_ref() = it->logSource();
-      entry.log_str_ref() = it->logMsg().toString();
+      // adopt the log payload without copying, the iterator pins the underlying buffer
+      entry.log_str_ref() = it->logMsgBuf();
       entry.log_term_ref() = it->logTerm();
       logs.emplace_back(std::move(entry));
     }
@@ -485,11 +505,78 @@ folly::Future<cpp2::HeartbeatResponse> Host::sendHeartbeatRequest(
                                << req->get_committed_log_id() << ", last_log_term_sent "
                                << req->get_last_log_term_sent() << ", last_log_id_sent "
                                << req->get_last_log_id_sent();
+  if (FLAGS_raft_heartbeat_batch_window_ms > 0) {
+    return enqueueBatchedHeartbeat(eb, std::move(req));
+  }
   // Get client connection
   auto client = part_->clientMan_->client(addr_, eb, false, FLAGS_raft_rpc_timeout_ms);
   return client->future_heartbeat(*req);
 }
 
+folly::Future<cpp2::HeartbeatResponse> Host::enqueueBatchedHeartbeat(
+    folly::EventBase* eb, std::shared_ptr<cpp2::HeartbeatRequest> req) {
+  folly::Promise<cpp2::HeartbeatResponse> promise;
+  auto future = promise.getFuture();
+  bool firstInWindow = false;
+  {
+    std::lock_guard<std::mutex> g(hbBatchLock);
+    auto& batch = hbBatches[addr_];
+    firstInWindow = batch.reqs.empty();
+    batch.reqs.emplace_back(std::move(*req));
+    batch.promises.emplace_back(std::move(promise));
+  }
+  if (firstInWindow) {
+    auto self = shared_from_this();
+    folly::futures::sleep(std::chrono::milliseconds(FLAGS_raft_heartbeat_batch_window_ms))
+        .via(eb)
+        .thenValue([self, eb](auto&&) { self->flushBatchedHeartbeats(eb); });
+  }
+  return future;
+}
+
+void Host::flushBatchedHeartbeats(folly::EventBase* eb) {
+  HeartbeatBatch batch;
+  {
+    std::lock_guard<std::mutex> g(hbBatchLock);
+    auto it = hbBatches.find(addr_);
+    if (it == hbBatches.end() || it->second.reqs.empty()) {
+      return;
+    }
+    batch = std::move(it->second);
+    it->second = HeartbeatBatch();
+  }
+  VLOG_IF(1, FLAGS_trace_raft) << idStr_ << "Sending batched heartbeat of " << batch.reqs.size()
+                               << " parts";
+  cpp2::BatchHeartbeatRequest batchReq;
+  batchReq.reqs_ref() = std::move(batch.reqs);
+  auto promises = std::make_shared<std::vector<folly::Promise<cpp2::HeartbeatResponse>>>(
+      std::move(batch.promises));
+  auto client = part_->clientMan_->client(addr_, eb, false, FLAGS_raft_rpc_timeout_ms);
+  client->future_batchHeartbeat(batchReq)
+      .via(eb)
+      .then([promises](folly::Try<cpp2::BatchHeartbeatResponse>&& t) {
+        if (t.hasException()) {
+          // Propagate the exception to each part, so every Host can run its own pause logic
+          auto exWrapper = std::move(t).exception();
+          for (auto& p : *promises) {
+            p.setException(exWrapper);
+          }
+          return;
+        }
+        auto& resps = *t.value().resps_ref();
+        for (size_t i = 0; i < promises->size(); i++) {
+          if (i < resps.size()) {
+            (*promises)[i].setValue(std::move(resps[i]));
+          } else {
+            // The peer is supposed to answer every request, treat a short response as rpc failure
+            cpp2::HeartbeatResponse resp;
+            resp.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_RPC_EXCEPTION;
+            (*promises)[i].setValue(std::move(resp));
+          }
+        }
+      });
+}
+
 bool Host::noRequest() const {
   CHECK(!lock_.try_lock());
   static auto emptyTup = std::make_tuple(0, 0, 0);
@@ -197,6 +197,25 @@ class Host final : public std::enable_shared_from_this<Host> {
   folly::Future<cpp2::HeartbeatResponse> sendHeartbeatRequest(
       folly::EventBase* eb, std::shared_ptr<cpp2::HeartbeatRequest> req);
 
+  /**
+   * @brief Park the heartbeat in the process-wide batch of its destination host. The first
+   * heartbeat of a batch window schedules the flush, heartbeats of other parts arriving within
+   * the window piggyback on the same batchHeartbeat rpc
+   *
+   * @param eb The eventbase to send rpc
+   * @param req The rpc request
+   * @return folly::Future<cpp2::HeartbeatResponse> This part's slice of the batched response
+   */
+  folly::Future<cpp2::HeartbeatResponse> enqueueBatchedHeartbeat(
+      folly::EventBase* eb, std::shared_ptr<cpp2::HeartbeatRequest> req);
+
+  /**
+   * @brief Send all heartbeats parked for the destination host in one batchHeartbeat rpc
+   *
+   * @param eb The eventbase to send rpc
+   */
+  void flushBatchedHeartbeats(folly::EventBase* eb);
+
   /**
    * @brief Build the append log request based on the log id
    *
@@ -12,7 +12,13 @@ namespace nebula {
 namespace raftex {
 
 RaftLogIterator::RaftLogIterator(LogID firstLogId, std::vector<cpp2::RaftLogEntry> logEntries)
-    : idx_(0), firstLogId_(firstLogId), logEntries_(std::move(logEntries)) {}
+    : idx_(0), firstLogId_(firstLogId), logEntries_(std::move(logEntries)) {
+  for (auto& entry : logEntries_) {
+    // the log payload may arrive as a chained IOBuf, flatten it so logMsg can return a
+    // contiguous view. In most cases the buffer is contiguous already and this is a no-op
+    (*entry.log_str_ref())->coalesce();
+  }
+}
 
 RaftLogIterator& RaftLogIterator::operator++() {
   ++idx_;
@@ -40,7 +46,8 @@ ClusterID RaftLogIterator::logSource() const {
 
 folly::StringPiece RaftLogIterator::logMsg() const {
   DCHECK(valid());
-  return logEntries_.at(idx_).get_log_str();
+  const auto& buf = logEntries_.at(idx_).get_log_str();
+  return folly::StringPiece(reinterpret_cast<const char*>(buf->data()), buf->length());
 }
 
 }  // namespace raftex
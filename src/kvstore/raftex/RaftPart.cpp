@@ -34,6 +34,10 @@ DEFINE_uint64(raft_snapshot_timeout, 60 * 5, "Max seconds between two snapshot r
 DEFINE_uint32(max_batch_size, 256, "The max number of logs in a batch");
 
 DEFINE_bool(trace_raft, false, "Enable trace one raft request");
+DEFINE_int32(raft_lease_clock_skew_ms,
+             0,
+             "Safety margin subtracted from the leader lease horizon to absorb wall clock "
+             "drift between peers");
 
 DECLARE_int32(wal_ttl);
 DECLARE_int64(wal_file_size);
@@ -294,8 +298,12 @@ class AppendLogsIteratorFactory {
         ranges.emplace_back(std::move(item));
         break;
       }
-      case nebula::kvstore::OP_BATCH_WRITE: {
-        auto data = nebula::kvstore::decodeBatchValue(log);
+      case nebula::kvstore::OP_BATCH_WRITE:
+      case nebula::kvstore::OP_BATCH_WRITE_COMPACT: {
+        auto dataRet = nebula::kvstore::decodeBatchValue(log);
+        // The log was encoded in-process moments ago, a mismatch here is memory corruption
+        CHECK(dataRet.ok()) << "Failed to decode batch log: " << dataRet.status();
+        auto data = std::move(dataRet).value();
         for (auto& op : data) {
           if (op.first == nebula::kvstore::BatchLogType::OP_BATCH_PUT) {
             updateSet.push_back(op.second.first);
@@ -1093,6 +1101,7 @@ void RaftPart::processAppendLogResponses(const AppendLogResponses& resps,
           bgWorkers_->addTask(
               [self = shared_from_this(), term = term_] { self->onLeaderReady(term); });
         }
+        renewLease();
       } else {
         LOG(FATAL) << idStr_ << "Failed to commit logs";
       }
@@ -1384,6 +1393,7 @@ bool RaftPart::handleElectionResponses(const ElectionResponses& resps,
             [self = shared_from_this(), proposedTerm] { self->onElected(proposedTerm); });
         lastMsgAcceptedTime_ = 0;
         lastMsgAcceptedCostMs_ = 0;
+        leaseExpireMs_.store(0, std::memory_order_relaxed);
       }
       commitInThisTerm_ = false;
     }
@@ -1664,6 +1674,9 @@ void RaftPart::processAppendLogRequest(const cpp2::AppendLogRequest& req,
   // Reset the timeout timer
   lastMsgRecvDur_.reset();
 
+  // Remember how far the leader has committed, follower reads check their staleness against it
+  leaderCommittedLogId_.store(req.get_committed_log_id(), std::memory_order_relaxed);
+
   // `lastMatchedLogId` is the last log id of which leader's and follower's log are matched
   // (which means log term of same log id are the same)
   // The relationships are as follows:
@@ -1754,10 +1767,18 @@ void RaftPart::processAppendLogRequest(const cpp2::AppendLogRequest& req,
       numLogs = numLogs - diffIndex;
     }
 
-    // happy path or a difference is found: append remaining logs
-    auto logEntries = std::vector<cpp2::RaftLogEntry>(
-        std::make_move_iterator(req.get_log_str_list().begin() + diffIndex),
-        std::make_move_iterator(req.get_log_str_list().end()));
+    // happy path or a difference is found: append remaining logs. The log payloads are cloned
+    // without copying the bytes, the clones share the buffers of the request
+    std::vector<cpp2::RaftLogEntry> logEntries;
+    logEntries.reserve(numLogs);
+    for (auto it = req.get_log_str_list().begin() + diffIndex; it != req.get_log_str_list().end();
+         ++it) {
+      cpp2::RaftLogEntry entry;
+      entry.cluster_ref() = it->get_cluster();
+      entry.log_str_ref() = it->get_log_str()->clone();
+      entry.log_term_ref() = it->get_log_term();
+      logEntries.emplace_back(std::move(entry));
+    }
     RaftLogIterator logIter(firstId, std::move(logEntries));
     bool hasLogsToAppend = logIter.valid();
     if (hasLogsToAppend) {
@@ -1946,6 +1967,9 @@ void RaftPart::processHeartbeatRequest(const cpp2::HeartbeatRequest& req,
   // Reset the timeout timer
   lastMsgRecvDur_.reset();
 
+  // Remember how far the leader has committed, follower reads check their staleness against it
+  leaderCommittedLogId_.store(req.get_committed_log_id(), std::memory_order_relaxed);
+
   // As for heartbeat, return ok after verifyLeader
   resp.error_code_ref() = nebula::cpp2::ErrorCode::SUCCEEDED;
   return;
@@ -2014,7 +2038,11 @@ void RaftPart::processSendSnapshotRequest(const cpp2::SendSnapshotRequest& req,
   }
   lastTotalCount_ += std::get<1>(ret);
   lastTotalSize_ += std::get<2>(ret);
-  if (lastTotalCount_ != req.get_total_count() || lastTotalSize_ != req.get_total_size()) {
+  // The leader may send the snapshot over several concurrent sub-range streams, so the received
+  // batches are not ordered and the running totals of one request only cover its own stream.
+  // The grand totals are carried by the final batch and verified here once everything arrived.
+  if (req.get_done() &&
+      (lastTotalCount_ != req.get_total_count() || lastTotalSize_ != req.get_total_size())) {
     VLOG(2) << idStr_ << "Bad snapshot, total rows received " << lastTotalCount_
             << ", total rows sended " << req.get_total_count() << ", total size received "
             << lastTotalSize_ << ", total size sended " << req.get_total_size();
@@ -2118,6 +2146,7 @@ void RaftPart::sendHeartbeat() {
             lastMsgAcceptedCostMs_ = nowCostMs;
             lastMsgAcceptedTime_ = nowTime;
           }
+          renewLease();
         }
       });
 }
@@ -2209,10 +2238,10 @@ nebula::cpp2::ErrorCode RaftPart::isCaughtUp(const HostAddr& peer) {
   return nebula::cpp2::ErrorCode::E_RAFT_INVALID_PEER;
 }
 
-bool RaftPart::linkCurrentWAL(const char* newPath) {
+bool RaftPart::linkCurrentWAL(const char* newPath, LogID sinceLogId) {
   CHECK_NOTNULL(newPath);
   std::lock_guard<std::mutex> g(raftLock_);
-  return wal_->linkCurrentWAL(newPath);
+  return wal_->linkCurrentWAL(newPath, sinceLogId);
 }
 
 void RaftPart::checkAndResetPeers(const std::vector<HostAddr>& peers) {
@@ -2252,6 +2281,13 @@ void RaftPart::checkRemoteListeners(const std::set<HostAddr>& expected) {
 }
 
 bool RaftPart::leaseValid() {
+  // Hot path: the lease horizon published by the replication and heartbeat quorum
+  // responses, one atomic load and no raftLock_
+  if (time::WallClock::fastNowInMilliSec() <
+      leaseExpireMs_.load(std::memory_order_relaxed)) {
+    return true;
+  }
+  // Slow path, also covers the single-replica case where no quorum responses arrive
   std::lock_guard<std::mutex> g(raftLock_);
   if (hosts_.empty()) {
     return true;
@@ -2267,5 +2303,15 @@ bool RaftPart::leaseValid() {
          FLAGS_raft_heartbeat_interval_secs * 1000 - lastMsgAcceptedCostMs_;
 }
 
+void RaftPart::renewLease() {
+  if (!commitInThisTerm_) {
+    return;
+  }
+  int64_t expire = static_cast<int64_t>(lastMsgAcceptedTime_) -
+                   static_cast<int64_t>(lastMsgAcceptedCostMs_) +
+                   FLAGS_raft_heartbeat_interval_secs * 1000 - FLAGS_raft_lease_clock_skew_ms;
+  leaseExpireMs_.store(expire, std::memory_order_relaxed);
+}
+
 }  // namespace raftex
 }  // namespace nebula
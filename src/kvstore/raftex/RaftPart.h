@@ -291,9 +291,10 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
    * @brief Hard link the wal files to a new path
    *
    * @param newPath New wal path
+   * @param sinceLogId When not 0, only link the wal files holding logs with id >= sinceLogId
    * @return Whether link succeed
    */
-  bool linkCurrentWAL(const char* newPath);
+  bool linkCurrentWAL(const char* newPath, LogID sinceLogId = 0);
 
   /**
    * @brief Reset my peers if not equals the argument
@@ -356,10 +357,29 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
   void processHeartbeatRequest(const cpp2::HeartbeatRequest& req, cpp2::HeartbeatResponse& resp);
 
   /**
-   * @brief Return whether leader lease is still valid
+   * @brief Return whether leader lease is still valid. On the hot path this is a single
+   * atomic load against the expiry published by renewLease, callers are expected to have
+   * checked isLeader() already.
    */
   bool leaseValid();
 
+  /**
+   * @brief Return whether the local replica is fresh enough to serve a bounded-staleness read,
+   * that is, its committed log id lags the commit point the leader last advertised by no more
+   * than maxLagLogs. The leader itself is always fresh enough. A follower or learner which has
+   * not heard from any leader yet refuses the read since it can not tell how far behind it is.
+   */
+  bool committedWithin(int64_t maxLagLogs) const {
+    if (isLeader()) {
+      return true;
+    }
+    auto leaderCommitted = leaderCommittedLogId_.load(std::memory_order_relaxed);
+    if (leaderCommitted <= 0) {
+      return false;
+    }
+    return leaderCommitted - committedLogId_ <= maxLagLogs;
+  }
+
   /**
    * @brief Return whether we need to clean expired wal
    */
@@ -562,6 +582,13 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
    */
   void cleanupSnapshot();
 
+  /**
+   * @brief Publish the wall clock time until which the quorum-backed lease holds, so
+   * leaseValid can check it without taking raftLock_. Caller must hold raftLock_. The
+   * horizon is shortened by raft_lease_clock_skew_ms to absorb clock drift between peers.
+   */
+  void renewLease();
+
  private:
   // A list of <idx, resp>
   // idx  -- the index of the peer
@@ -835,6 +862,9 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
   // The last id and term when logs has been applied to state machine
   LogID committedLogId_{0};
   TermID committedLogTerm_{0};
+  // The committed log id the leader advertised in the last append log or heartbeat request,
+  // used to bound the staleness of follower reads. Only meaningful on follower and learner
+  std::atomic<LogID> leaderCommittedLogId_{0};
   static constexpr LogID kNoCommitLogId{-1};
   static constexpr TermID kNoCommitLogTerm{-1};
   static constexpr int64_t kNoSnapshotCount{-1};
@@ -848,6 +878,9 @@ class RaftPart : public std::enable_shared_from_this<RaftPart> {
   uint64_t lastMsgAcceptedTime_{0};
   // How long between last message was sent and was accepted by majority peers
   uint64_t lastMsgAcceptedCostMs_{0};
+  // Wall clock time in ms until which the quorum-backed lease holds, published by
+  // renewLease so leaseValid can pass with a single atomic load instead of raftLock_
+  std::atomic<int64_t> leaseExpireMs_{0};
   // Make sure only one election is in progress
   std::atomic_bool inElection_{false};
   // Speed up first election when I don't know who is leader
@@ -174,5 +174,25 @@ void RaftexService::async_eb_heartbeat(
   callback->result(resp);
 }
 
+void RaftexService::async_eb_batchHeartbeat(
+    std::unique_ptr<apache::thrift::HandlerCallback<cpp2::BatchHeartbeatResponse>> callback,
+    const cpp2::BatchHeartbeatRequest& req) {
+  cpp2::BatchHeartbeatResponse batchResp;
+  auto& resps = *batchResp.resps_ref();
+  resps.reserve(req.get_reqs().size());
+  for (const auto& hbReq : req.get_reqs()) {
+    cpp2::HeartbeatResponse resp;
+    auto part = findPart(hbReq.get_space(), hbReq.get_part());
+    if (!part) {
+      // Not found
+      resp.error_code_ref() = nebula::cpp2::ErrorCode::E_RAFT_UNKNOWN_PART;
+    } else {
+      part->processHeartbeatRequest(hbReq, resp);
+    }
+    resps.emplace_back(std::move(resp));
+  }
+  callback->result(batchResp);
+}
+
 }  // namespace raftex
 }  // namespace nebula
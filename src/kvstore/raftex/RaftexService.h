@@ -111,6 +111,17 @@ class RaftexService : public cpp2::RaftexServiceSvIf {
       std::unique_ptr<apache::thrift::HandlerCallback<cpp2::HeartbeatResponse>> callback,
       const cpp2::HeartbeatRequest& req) override;
 
+  /**
+   * @brief Handle multiplexed heartbeats of several partitions in io thread, fanning each one
+   * out to its RaftPart. The i-th response corresponds to the i-th request
+   *
+   * @param callback Thrift callback
+   * @param req
+   */
+  void async_eb_batchHeartbeat(
+      std::unique_ptr<apache::thrift::HandlerCallback<cpp2::BatchHeartbeatResponse>> callback,
+      const cpp2::BatchHeartbeatRequest& req) override;
+
   /**
    * @brief Register the RaftPart to the service
    */
@@ -44,18 +44,28 @@ folly::Future<StatusOr<std::pair<LogID, TermID>>> SnapshotManager::sendSnapshot(
     }
     auto termId = tr.first;
     const auto& localhost = part->address();
+    // The snapshot may be sent over several concurrent sub-range streams, so the callback has to
+    // be safe to invoke from multiple threads, and the promise must be set exactly once
+    auto pro = std::make_shared<folly::Promise<StatusOr<std::pair<LogID, TermID>>>>(std::move(p));
+    auto settled = std::make_shared<std::atomic<bool>>(false);
     accessAllRowsInSnapshot(
         spaceId,
         partId,
-        [&, this, p = std::move(p)](LogID commitLogId,
-                                    TermID commitLogTerm,
-                                    const std::vector<std::string>& data,
-                                    int64_t totalCount,
-                                    int64_t totalSize,
-                                    SnapshotStatus status) mutable -> bool {
+        [&, this, pro, settled](LogID commitLogId,
+                                TermID commitLogTerm,
+                                const std::vector<std::string>& data,
+                                int64_t totalCount,
+                                int64_t totalSize,
+                                SnapshotStatus status) mutable -> bool {
+          if (settled->load()) {
+            // another stream has already failed, stop this one as well
+            return false;
+          }
           if (status == SnapshotStatus::FAILED) {
             VLOG(1) << part->idStr_ << "Snapshot send failed, the leader changed?";
-            p.setValue(Status::Error("Send snapshot failed!"));
+            if (!settled->exchange(true)) {
+              pro->setValue(Status::Error("Send snapshot failed!"));
+            }
             return false;
           }
           int retry = FLAGS_snapshot_send_retry_times;
@@ -80,7 +90,9 @@ folly::Future<StatusOr<std::pair<LogID, TermID>>> SnapshotManager::sendSnapshot(
                 if (status == SnapshotStatus::DONE) {
                   VLOG(1) << part->idStr_ << "Finished, totalCount " << totalCount << ", totalSize "
                           << totalSize;
-                  p.setValue(std::make_pair(commitLogId, commitLogTerm));
+                  if (!settled->exchange(true)) {
+                    pro->setValue(std::make_pair(commitLogId, commitLogTerm));
+                  }
                 }
                 return true;
               } else {
@@ -97,7 +109,9 @@ folly::Future<StatusOr<std::pair<LogID, TermID>>> SnapshotManager::sendSnapshot(
             }
           }
           VLOG(2) << part->idStr_ << "Send snapshot failed!";
-          p.setValue(Status::Error("Send snapshot failed!"));
+          if (!settled->exchange(true)) {
+            pro->setValue(Status::Error("Send snapshot failed!"));
+          }
           return false;
         });
   });
@@ -19,6 +19,8 @@ stats::CounterId kTransferLeaderLatencyUs;
 stats::CounterId kNumStartElect;
 stats::CounterId kNumGrantVotes;
 stats::CounterId kNumSendSnapshot;
+stats::CounterId kNumSecondaryCacheHits;
+stats::CounterId kNumSecondaryCacheMisses;
 
 void initKVStats() {
   kCommitLogLatencyUs = stats::StatsManager::registerHisto(
@@ -36,6 +38,10 @@ void initKVStats() {
   kNumStartElect = stats::StatsManager::registerStats("num_start_elect", "rate, sum");
   kNumGrantVotes = stats::StatsManager::registerStats("num_grant_votes", "rate, sum");
   kNumSendSnapshot = stats::StatsManager::registerStats("num_send_snapshot", "rate, sum");
+  kNumSecondaryCacheHits =
+      stats::StatsManager::registerStats("num_secondary_cache_hits", "rate, sum");
+  kNumSecondaryCacheMisses =
+      stats::StatsManager::registerStats("num_secondary_cache_misses", "rate, sum");
 }
 
 }  // namespace nebula
@@ -22,6 +22,10 @@ extern stats::CounterId kNumStartElect;
 extern stats::CounterId kNumGrantVotes;
 extern stats::CounterId kNumSendSnapshot;
 
+// Rocksdb secondary block cache stats
+extern stats::CounterId kNumSecondaryCacheHits;
+extern stats::CounterId kNumSecondaryCacheMisses;
+
 void initKVStats();
 
 }  // namespace nebula
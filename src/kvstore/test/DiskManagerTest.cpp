@@ -106,6 +106,49 @@ TEST(DiskManagerTest, AvailableTest) {
   EXPECT_FALSE(diskMan.hasEnoughSpace(unknownSpace, unknownPart));
 }
 
+TEST(DiskManagerTest, WalDeviceTest) {
+  GraphSpaceID spaceId = 1;
+  fs::TempDir disk1("/tmp/disk_man_test.XXXXXX");
+  auto path1 = folly::stringPrintf("%s/nebula/%d", disk1.path(), spaceId);
+  boost::filesystem::create_directories(path1);
+  fs::TempDir disk2("/tmp/disk_man_test.XXXXXX");
+  auto path2 = folly::stringPrintf("%s/nebula/%d", disk2.path(), spaceId);
+  boost::filesystem::create_directories(path2);
+  fs::TempDir walDisk1("/tmp/disk_man_test_wal.XXXXXX");
+  fs::TempDir walDisk2("/tmp/disk_man_test_wal.XXXXXX");
+
+  std::vector<std::string> dataPaths = {disk1.path(), disk2.path()};
+  std::vector<std::string> walPaths = {walDisk1.path(), walDisk2.path()};
+  DiskManager diskMan(dataPaths, walPaths);
+  for (PartitionID partId = 1; partId <= 10; partId++) {
+    diskMan.addPartToPath(spaceId, partId, path1);
+  }
+  for (PartitionID partId = 11; partId <= 20; partId++) {
+    diskMan.addPartToPath(spaceId, partId, path2);
+  }
+
+  // a part's wal lives on the device paired with its data disk
+  for (PartitionID partId = 1; partId <= 20; partId++) {
+    auto walPath = diskMan.walPath(spaceId, partId);
+    ASSERT_TRUE(walPath.ok());
+    auto expected =
+        boost::filesystem::canonical(partId <= 10 ? walDisk1.path() : walDisk2.path()).string();
+    EXPECT_EQ(expected, walPath.value());
+  }
+
+  // mock wal device of disk1 full while the data disks still have room
+  diskMan.freeBytes_[0] = FLAGS_minimum_reserved_bytes;
+  diskMan.freeBytes_[1] = FLAGS_minimum_reserved_bytes;
+  diskMan.walFreeBytes_[0] = 0;
+  diskMan.walFreeBytes_[1] = FLAGS_minimum_reserved_bytes;
+  for (PartitionID partId = 1; partId <= 10; partId++) {
+    EXPECT_FALSE(diskMan.hasEnoughSpace(spaceId, partId));
+  }
+  for (PartitionID partId = 11; partId <= 20; partId++) {
+    EXPECT_TRUE(diskMan.hasEnoughSpace(spaceId, partId));
+  }
+}
+
 TEST(DiskManagerTest, WalNoSpaceTest) {
   GraphSpaceID spaceId = 1;
   PartitionID partId = 1;
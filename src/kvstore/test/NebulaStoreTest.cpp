@@ -24,6 +24,7 @@
 DECLARE_uint32(raft_heartbeat_interval_secs);
 DECLARE_bool(auto_remove_invalid_space);
 DECLARE_bool(wal_sync);
+DECLARE_int64(follower_read_max_lag_logs);
 const int32_t kDefaultVidLen = 8;
 using nebula::meta::PartHosts;
 
@@ -550,6 +551,146 @@ TEST(NebulaStoreTest, ThreeCopiesTest) {
   }
 }
 
+TEST(NebulaStoreTest, BoundedStalenessReadTest) {
+  fs::TempDir rootPath("/tmp/bounded_staleness_test.XXXXXX");
+  auto initNebulaStore = [](const std::vector<HostAddr>& peers,
+                            int32_t index,
+                            const std::string& path) -> std::unique_ptr<NebulaStore> {
+    LOG(INFO) << "Start nebula store on " << peers[index];
+    auto sIoThreadPool = std::make_shared<folly::IOThreadPoolExecutor>(4);
+    auto partMan = std::make_unique<MemPartManager>();
+    PartHosts pm;
+    pm.spaceId_ = 0;
+    pm.partId_ = 0;
+    pm.hosts_ = peers;
+    partMan->partsMap_[0][0] = std::move(pm);
+    std::vector<std::string> paths;
+    paths.emplace_back(folly::stringPrintf("%s/disk%d", path.c_str(), index));
+    KVOptions options;
+    options.dataPaths_ = std::move(paths);
+    options.partMan_ = std::move(partMan);
+    HostAddr local = peers[index];
+    return std::make_unique<NebulaStore>(std::move(options), sIoThreadPool, local, getHandlers());
+  };
+  int32_t replicas = 3;
+  std::string ip("127.0.0.1");
+  std::vector<HostAddr> peers;
+  for (int32_t i = 0; i < replicas; i++) {
+    peers.emplace_back(ip, network::NetworkUtils::getAvailablePort());
+  }
+
+  std::vector<std::unique_ptr<NebulaStore>> stores;
+  for (int i = 0; i < replicas; i++) {
+    stores.emplace_back(initNebulaStore(peers, i, rootPath.path()));
+    stores.back()->init();
+  }
+  LOG(INFO) << "Waiting for the leader elected!";
+  while (true) {
+    int32_t leaderCount = 0;
+    for (int i = 0; i < replicas; i++) {
+      nebula::meta::ActiveHostsMan::AllLeaders leaderIds;
+      leaderCount += stores[i]->allLeader(leaderIds);
+    }
+    if (leaderCount == 1) {
+      break;
+    }
+    usleep(100000);
+  }
+
+  auto findStoreIndex = [&](const HostAddr& addr) {
+    for (size_t i = 0; i < peers.size(); i++) {
+      if (peers[i] == addr) {
+        return i;
+      }
+    }
+    LOG(FATAL) << "Should not reach here!";
+    return 0UL;
+  };
+
+  LOG(INFO) << "Put some data through the leader...";
+  std::string prefix = "prefix";
+  std::vector<KV> data;
+  for (auto i = 0; i < 100; i++) {
+    data.emplace_back(prefix + std::string(reinterpret_cast<const char*>(&i), sizeof(int32_t)),
+                      folly::stringPrintf("val_%d", i));
+  }
+  int32_t pivot = 50;
+  std::string pivotKey =
+      prefix + std::string(reinterpret_cast<const char*>(&pivot), sizeof(int32_t));
+  auto res = stores[0]->partLeader(0, 0);
+  CHECK(ok(res));
+  auto leaderIndex = findStoreIndex(value(std::move(res)));
+  {
+    folly::Baton<true, std::atomic> baton;
+    stores[leaderIndex]->asyncMultiPut(
+        0, 0, std::move(data), [&baton](nebula::cpp2::ErrorCode code) {
+          EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED, code);
+          baton.post();
+        });
+    baton.wait();
+  }
+  // Let the followers apply the logs and hear the leader's advertised commit point
+  sleep(FLAGS_raft_heartbeat_interval_secs);
+
+  auto followerIndex = (leaderIndex + 1) % replicas;
+  LOG(INFO) << "Read on the follower within the staleness bound...";
+  {
+    std::string value;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              stores[followerIndex]->boundedStalenessGet(0, 0, pivotKey, &value));
+    EXPECT_EQ("val_50", value);
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              stores[followerIndex]->boundedStalenessPrefix(0, 0, prefix, &iter));
+    int num = 0;
+    while (iter->valid()) {
+      iter->next();
+      num++;
+    }
+    EXPECT_EQ(100, num);
+    // The leader-only read path still refuses the same follower
+    EXPECT_EQ(nebula::cpp2::ErrorCode::E_LEADER_CHANGED,
+              stores[followerIndex]->get(0, 0, pivotKey, &value));
+  }
+
+  LOG(INFO) << "Read on the follower beyond the staleness bound...";
+  // Shrink the bound below zero, so even a fully caught-up follower counts as too stale
+  FLAGS_follower_read_max_lag_logs = -1;
+  {
+    std::string value;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::E_LEADER_CHANGED,
+              stores[followerIndex]->boundedStalenessGet(0, 0, pivotKey, &value));
+    std::unique_ptr<KVIterator> iter;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::E_LEADER_CHANGED,
+              stores[followerIndex]->boundedStalenessPrefix(0, 0, prefix, &iter));
+    // The leader itself is always fresh enough, whatever the bound says
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              stores[leaderIndex]->boundedStalenessGet(0, 0, pivotKey, &value));
+  }
+  FLAGS_follower_read_max_lag_logs = 1000;
+
+  LOG(INFO) << "Transfer the leadership and read on the old leader...";
+  {
+    auto targetAddr = NebulaStore::getRaftAddr(peers[followerIndex]);
+    folly::Baton<true, std::atomic> baton;
+    auto partRet = stores[leaderIndex]->part(0, 0);
+    CHECK(ok(partRet));
+    auto part = value(partRet);
+    part->asyncTransferLeader(targetAddr, [&](nebula::cpp2::ErrorCode) { baton.post(); });
+    baton.wait();
+  }
+  sleep(FLAGS_raft_heartbeat_interval_secs * 2);
+  {
+    // The old leader serves as a follower now, fresh again once it heard from the new leader
+    std::string value;
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              stores[leaderIndex]->boundedStalenessGet(0, 0, pivotKey, &value));
+    EXPECT_EQ("val_50", value);
+    EXPECT_EQ(nebula::cpp2::ErrorCode::SUCCEEDED,
+              stores[followerIndex]->boundedStalenessGet(0, 0, pivotKey, &value));
+  }
+}
+
 TEST(NebulaStoreTest, TransLeaderTest) {
   fs::TempDir rootPath("/tmp/trans_leader_test.XXXXXX");
   auto initNebulaStore = [](const std::vector<HostAddr>& peers,
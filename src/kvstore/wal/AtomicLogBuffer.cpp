@@ -5,13 +5,71 @@
 
 #include "kvstore/wal/AtomicLogBuffer.h"
 
+#include <mutex>
+#include <vector>
+
 DEFINE_int32(max_log_buffer_size,
              16 * 1024 * 1024,
              "Max atomic log buffer size, if the size exceeds it, will trigger gc");
 
+DEFINE_int32(wal_buffer_pool_budget_mb,
+             64,
+             "Max megabytes of recycled log buffer nodes kept in the global free list, "
+             "nodes recycled above the budget are freed normally");
+
 namespace nebula {
 namespace wal {
 
+namespace {
+
+struct NodeFreeList {
+  std::mutex lock;
+  // node and the payload bytes it held when it was recycled
+  std::vector<std::pair<Node*, int64_t>> nodes;
+  std::atomic<int64_t> bytes{0};
+};
+
+NodeFreeList& freeList() {
+  static NodeFreeList list;
+  return list;
+}
+
+}  // namespace
+
+Node* NodePool::alloc() {
+  auto& list = freeList();
+  {
+    std::lock_guard<std::mutex> g(list.lock);
+    if (!list.nodes.empty()) {
+      auto [node, footprint] = list.nodes.back();
+      list.nodes.pop_back();
+      list.bytes.fetch_sub(footprint, std::memory_order_relaxed);
+      return node;
+    }
+  }
+  return new Node();
+}
+
+void NodePool::recycle(Node* node) {
+  auto& list = freeList();
+  // the stale record strings stay with the node until they are overwritten, so they count
+  // against the budget
+  int64_t footprint = sizeof(Node) + node->size_;
+  auto budget = static_cast<int64_t>(FLAGS_wal_buffer_pool_budget_mb) * 1024 * 1024;
+  if (list.bytes.load(std::memory_order_relaxed) + footprint > budget) {
+    delete node;
+    return;
+  }
+  node->reset();
+  std::lock_guard<std::mutex> g(list.lock);
+  list.nodes.emplace_back(node, footprint);
+  list.bytes.fetch_add(footprint, std::memory_order_relaxed);
+}
+
+int64_t NodePool::pooledBytes() {
+  return freeList().bytes.load(std::memory_order_relaxed);
+}
+
 LogIterator& AtomicLogBuffer::Iterator::operator++() {
   currIndex_++;
   currLogId_++;
@@ -60,11 +118,11 @@ AtomicLogBuffer::~AtomicLogBuffer() {
   auto* prev = curr;
   while (curr != nullptr) {
     curr = curr->next_;
-    delete prev;
+    NodePool::recycle(prev);
     prev = curr;
   }
   if (prev != nullptr) {
-    delete prev;
+    NodePool::recycle(prev);
   }
 }
 
@@ -72,7 +130,7 @@ void AtomicLogBuffer::push(LogID logId, Record&& record) {
   auto* head = head_.load(std::memory_order_relaxed);
   auto recSize = record.size();
   if (head == nullptr || head->isFull() || head->markDeleted_.load(std::memory_order_relaxed)) {
-    auto* newNode = new Node();
+    auto* newNode = NodePool::alloc();
     newNode->firstLogId_ = logId;
     newNode->next_ = head;
     newNode->push_back(std::move(record));
@@ -200,7 +258,7 @@ void AtomicLogBuffer::releaseRef() {
         VLOG(5) << "Delete node " << curr->firstLogId_;
         auto* del = curr;
         curr = curr->next_;
-        delete del;
+        NodePool::recycle(del);
         dirtyNodes_.fetch_sub(1, std::memory_order_release);
         CHECK_GE(dirtyNodes_, 0);
       }
@@ -93,6 +93,19 @@ struct Node {
     return firstLogId_ + pos_.load(std::memory_order_relaxed);
   }
 
+  /**
+   * @brief Restore the node to its initial state so it can be handed out again. The stale
+   * record strings are kept, overwriting them on reuse releases their buffers lazily.
+   */
+  void reset() {
+    firstLogId_ = 0;
+    size_ = 0;
+    next_ = nullptr;
+    pos_.store(0, std::memory_order_relaxed);
+    markDeleted_.store(false, std::memory_order_relaxed);
+    prev_.store(nullptr, std::memory_order_relaxed);
+  }
+
   LogID firstLogId_{0};
   // total size for current Node.
   int32_t size_{0};
@@ -110,6 +123,36 @@ struct Node {
   std::atomic<Node*> prev_{nullptr};
 };
 
+/**
+ * @brief A global free list of Nodes shared by the log buffers of all parts. Nodes are
+ * recycled instead of freed, which takes the allocator out of the log hot path. The bytes
+ * held by the free list are bounded by wal_buffer_pool_budget_mb, nodes recycled above the
+ * budget are freed normally. Nodes in use are heap memory like before, so the memory
+ * tracker keeps seeing them.
+ */
+class NodePool final {
+ public:
+  /**
+   * @brief Take a reset node from the pool, or heap-allocate one if the pool is empty
+   */
+  static Node* alloc();
+
+  /**
+   * @brief Give a node back to the pool, or free it if the pool is over budget
+   *
+   * @param node Node to recycle, no reader may hold a reference to it anymore
+   */
+  static void recycle(Node* node);
+
+  /**
+   * @brief Bytes currently held by the free list, for observability
+   */
+  static int64_t pooledBytes();
+
+ private:
+  NodePool() = default;
+};
+
 /**
  * @brief A wait-free log buffer for single writer, multi readers When deleting the extra node, to
  * avoid read the dangling one, we just mark it to be deleted, and delete it when no readers using
@@ -180,6 +223,26 @@ class AtomicLogBuffer : public std::enable_shared_from_this<AtomicLogBuffer> {
       return record()->msg_;
     }
 
+    /**
+     * @brief Return an IOBuf aliasing the record in the buffer without copying. The buffer is
+     * pinned by a reference held in the IOBuf, so the record stays valid until the IOBuf is
+     * destroyed, e.g. when an in-flight rpc adopting it finishes
+     */
+    std::unique_ptr<folly::IOBuf> logMsgBuf() const override {
+      auto msg = logMsg();
+      logBuffer_->addRef();
+      auto* pin = new std::shared_ptr<AtomicLogBuffer>(logBuffer_);
+      return folly::IOBuf::takeOwnership(
+          const_cast<char*>(msg.data()),
+          msg.size(),
+          [](void*, void* userData) {
+            auto* holder = static_cast<std::shared_ptr<AtomicLogBuffer>*>(userData);
+            (*holder)->releaseRef();
+            delete holder;
+          },
+          pin);
+    }
+
    private:
     /**
      * @brief Construct a new wal iterator in range [start, end]
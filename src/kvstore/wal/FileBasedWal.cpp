@@ -16,6 +16,12 @@ DEFINE_int32(wal_ttl, 14400, "Default wal ttl");
 DEFINE_int64(wal_file_size, 16 * 1024 * 1024, "Default wal file size");
 DEFINE_int32(wal_buffer_size, 8 * 1024 * 1024, "Default wal buffer size");
 DEFINE_bool(wal_sync, false, "Whether fsync needs to be called every write");
+DECLARE_int32(wal_group_sync_window_us);
+DEFINE_int32(wal_index_interval,
+             0,
+             "Build one in-memory wal index entry (logId -> file offset) every this many logs, "
+             "so catch-up reads seek close to the target log instead of scanning the wal file. "
+             "0 means the index is disabled.");
 
 namespace nebula {
 namespace wal {
@@ -49,6 +55,9 @@ FileBasedWal::FileBasedWal(const folly::StringPiece dir,
       policy_(std::move(policy)),
       preProcessor_(std::move(preProcessor)),
       diskMan_(diskMan) {
+  if (policy_.sync && FLAGS_wal_group_sync_window_us > 0) {
+    syncCoordinator_ = kvstore::WalSyncCoordinator::instanceForWal(dir_);
+  }
   // Make sure WAL directory exist
   if (FileUtils::fileType(dir_.c_str()) == fs::FileType::NOTEXIST) {
     if (!FileUtils::makeDir(dir_)) {
@@ -221,6 +230,7 @@ void FileBasedWal::scanAllWalFiles() {
     info->setLastId(lastLogId);
 
     // We now get all necessary info
+    buildSparseIndex(info, fd);
     close(fd);
   }
 
@@ -260,6 +270,33 @@ void FileBasedWal::scanAllWalFiles() {
   }
 }
 
+void FileBasedWal::buildSparseIndex(WalFileInfoPtr info, int32_t fd) {
+  if (FLAGS_wal_index_interval <= 0) {
+    return;
+  }
+  size_t pos = 0;
+  LogID id = 0;
+  int32_t len = 0;
+  while (true) {
+    // Read the log Id
+    if (pread(fd, &id, sizeof(LogID), pos) != sizeof(LogID)) {
+      break;
+    }
+
+    // Read the message length
+    if (pread(fd, &len, sizeof(int32_t), pos + sizeof(LogID) + sizeof(TermID)) != sizeof(int32_t)) {
+      break;
+    }
+
+    if ((id - info->firstId()) % FLAGS_wal_index_interval == 0) {
+      info->addIndexEntry(id, pos);
+    }
+
+    // Move to the next log
+    pos += sizeof(LogID) + sizeof(TermID) + sizeof(ClusterID) + 2 * sizeof(int32_t) + len;
+  }
+}
+
 void FileBasedWal::closeCurrFile() {
   if (currFd_ < 0) {
     // Already closed
@@ -365,6 +402,7 @@ void FileBasedWal::rollbackInFile(WalFileInfoPtr info, LogID logId) {
   }
   info->setLastId(id);
   info->setLastTerm(term);
+  info->truncateIndex(id);
   close(fd);
 }
 
@@ -434,6 +472,7 @@ void FileBasedWal::scanLastWal(WalFileInfoPtr info, LogID firstId) {
                  << "): " << strerror(errno);
     }
     info->setSize(pos);
+    info->truncateIndex(info->lastId());
   }
 
   close(fd);
@@ -477,14 +516,29 @@ bool FileBasedWal::appendLogInternal(LogID id,
     prepareNewFile(id);
   }
 
+  if (FLAGS_wal_index_interval > 0 &&
+      (id - currInfo_->firstId()) % FLAGS_wal_index_interval == 0) {
+    currInfo_->addIndexEntry(id, currInfo_->size());
+  }
+
   ssize_t bytesWritten = write(currFd_, strBuf.data(), strBuf.size());
   if (bytesWritten != (ssize_t)strBuf.size()) {
     LOG(FATAL) << idStr_ << "bytesWritten:" << bytesWritten << ", expected:" << strBuf.size()
                << ", error:" << strerror(errno);
   }
 
-  if (policy_.sync && ::fsync(currFd_) == -1) {
-    LOG(WARNING) << "sync wal \"" << currInfo_->path() << "\" failed, error: " << strerror(errno);
+  if (policy_.sync) {
+    if (syncCoordinator_) {
+      // group the fsync with the other parts on this device, the call returns once a
+      // shared fsync covering this write has completed
+      if (!syncCoordinator_->groupSync(currFd_)) {
+        // the leader of the failed window already logged the errno
+        LOG(WARNING) << "group sync wal \"" << currInfo_->path() << "\" failed";
+      }
+    } else if (::fsync(currFd_) == -1) {
+      LOG(WARNING) << "sync wal \"" << currInfo_->path()
+                   << "\" failed, error: " << strerror(errno);
+    }
   }
   currInfo_->setSize(currInfo_->size() + strBuf.size());
   currInfo_->setLastId(id);
@@ -535,7 +589,7 @@ std::unique_ptr<LogIterator> FileBasedWal::iterator(LogID firstLogId, LogID last
   return std::make_unique<WalFileIterator>(shared_from_this(), firstLogId, lastLogId);
 }
 
-bool FileBasedWal::linkCurrentWAL(const char* newPath) {
+bool FileBasedWal::linkCurrentWAL(const char* newPath, LogID sinceLogId) {
   closeCurrFile();
   std::lock_guard<std::mutex> g(walFilesMutex_);
   if (walFiles_.empty()) {
@@ -552,6 +606,10 @@ bool FileBasedWal::linkCurrentWAL(const char* newPath) {
   }
 
   for (const auto& f : walFiles_) {
+    if (sinceLogId != 0 && f.second->lastId() < sinceLogId) {
+      // The whole file predates the incremental baseline
+      continue;
+    }
     // Using the original wal file name.
     auto targetFile = fs::FileUtils::joinPath(newPath, folly::stringPrintf("%019ld.wal", f.first));
 
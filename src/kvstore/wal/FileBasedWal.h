@@ -163,9 +163,10 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
    * @brief Hard link the wal files to a new path
    *
    * @param newPath New wal path
+   * @param sinceLogId When not 0, wal files whose last log is older than sinceLogId are skipped
    * @return Whether link succeed
    */
-  bool linkCurrentWAL(const char* newPath) override;
+  bool linkCurrentWAL(const char* newPath, LogID sinceLogId = 0) override;
 
   /**
    * @brief Iterates through all wal file info in reversed order (from the latest to the earliest).
@@ -218,6 +219,15 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
    */
   void scanLastWal(WalFileInfoPtr info, LogID firstId);
 
+  /**
+   * @brief Build the sparse in-memory index (logId -> file offset) of one wal file, used on
+   * startup, the index of the current file is maintained while appending
+   *
+   * @param info Wal file info holding the index
+   * @param fd An opened fd of the file
+   */
+  void buildSparseIndex(WalFileInfoPtr info, int32_t fd);
+
   /**
    * @brief Close down the current wal file
    */
@@ -285,6 +295,10 @@ class FileBasedWal final : public Wal, public std::enable_shared_from_this<FileB
 
   std::shared_ptr<kvstore::DiskManager> diskMan_;
 
+  // set when wal_sync is on and wal_group_sync_window_us > 0, batches our fsyncs with the
+  // other parts whose wal lives on the same device
+  std::shared_ptr<kvstore::WalSyncCoordinator> syncCoordinator_;
+
   folly::RWSpinLock rollbackLock_;
 };
 
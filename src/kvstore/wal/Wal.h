@@ -71,9 +71,11 @@ class Wal {
    * @brief Hard link the wal files to a new path
    *
    * @param newPath New wal path
+   * @param sinceLogId When not 0, only link the wal files holding logs with id >= sinceLogId,
+   * which is how incremental checkpoints ship the tail of the wal
    * @return Whether link succeed
    */
-  virtual bool linkCurrentWAL(const char* newPath) = 0;
+  virtual bool linkCurrentWAL(const char* newPath, LogID sinceLogId = 0) = 0;
 
   /**
    * @brief Reset the WAL. This method is *NOT* thread safe
@@ -118,6 +118,52 @@ class WalFileInfo final {
     size_ = size;
   }
 
+  /**
+   * @brief Record the file offset of one log into the sparse in-memory index. Entries must be
+   * added in increasing log id order, out of order ids are ignored so re-scanning a file is safe
+   *
+   * @param id Log id
+   * @param offset File offset where the log record starts
+   */
+  void addIndexEntry(LogID id, size_t offset) {
+    std::lock_guard<std::mutex> g(indexMutex_);
+    if (!sparseIndex_.empty() && id <= sparseIndex_.back().first) {
+      return;
+    }
+    sparseIndex_.emplace_back(id, offset);
+  }
+
+  /**
+   * @brief Return the offset of the greatest indexed log not after the given id, so a reader can
+   * seek there and scan the few remaining logs. Return 0 if nothing before the id was indexed
+   *
+   * @param id Log id to locate
+   * @return size_t File offset to start scanning from
+   */
+  size_t seekIndex(LogID id) const {
+    std::lock_guard<std::mutex> g(indexMutex_);
+    auto it = std::upper_bound(
+        sparseIndex_.begin(), sparseIndex_.end(), id, [](LogID lhs, const auto& rhs) {
+          return lhs < rhs.first;
+        });
+    if (it == sparseIndex_.begin()) {
+      return 0;
+    }
+    return (--it)->second;
+  }
+
+  /**
+   * @brief Drop all index entries of logs after the given id, called when the file is rolled back
+   *
+   * @param id The last log id kept in the file
+   */
+  void truncateIndex(LogID id) {
+    std::lock_guard<std::mutex> g(indexMutex_);
+    while (!sparseIndex_.empty() && sparseIndex_.back().first > id) {
+      sparseIndex_.pop_back();
+    }
+  }
+
  private:
   const std::string fullpath_;
   const LogID firstLogId_;
@@ -125,6 +171,10 @@ class WalFileInfo final {
   TermID lastLogTerm_;
   time_t mtime_;
   size_t size_;
+
+  // Sparse index of logId -> file offset, ordered by log id
+  std::vector<std::pair<LogID, size_t>> sparseIndex_;
+  mutable std::mutex indexMutex_;
 };
 
 using WalFileInfoPtr = std::shared_ptr<WalFileInfo>;
@@ -28,7 +28,8 @@ WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startI
   }
 
   // We need to read from the WAL files
-  wal_->accessAllWalInfo([this](WalFileInfoPtr info) {
+  WalFileInfoPtr firstFileInfo;
+  wal_->accessAllWalInfo([this, &firstFileInfo](WalFileInfoPtr info) {
     int fd = open(info->path(), O_RDONLY);
     if (fd < 0) {
       LOG(WARNING) << "Failed to open wal file \"" << info->path() << "\" (" << errno
@@ -41,6 +42,7 @@ WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startI
 
     if (info->firstId() <= currId_) {
       // Go no further
+      firstFileInfo = info;
       return false;
     } else {
       return true;
@@ -62,8 +64,9 @@ WalFileIterator::WalFileIterator(std::shared_ptr<FileBasedWal> wal, LogID startI
   }
 
   if (!idRanges_.empty()) {
-    // Find the correct position in the first WAL file
-    currPos_ = 0;
+    // Find the correct position in the first WAL file. The sparse index takes us close to the
+    // target log, the remaining logs before it are scanned over
+    currPos_ = firstFileInfo != nullptr ? firstFileInfo->seekIndex(currId_) : 0;
     while (true) {
       LogID logId;
       // Read the logID
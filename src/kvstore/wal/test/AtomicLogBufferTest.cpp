@@ -146,6 +146,21 @@ TEST(AtomicLogBufferTest, ResetThenPushExceedLimit) {
   CHECK(logBuffer->seek(logId) != nullptr);
 }
 
+TEST(AtomicLogBufferTest, NodePoolRecycleTest) {
+  auto* node = NodePool::alloc();
+  node->firstLogId_ = 42;
+  node->push_back(Record(0, 0, std::string(8, 'a')));
+  NodePool::recycle(node);
+  CHECK_GT(NodePool::pooledBytes(), 0);
+
+  // The recycled node comes back reset, and a buffer built on recycled nodes reads fine.
+  auto logBuffer = AtomicLogBuffer::instance();
+  for (LogID logId = 0; logId < 1000L; logId++) {
+    logBuffer->push(logId, Record(0, 0, folly::stringPrintf("str_%ld", logId)));
+  }
+  checkIterator(logBuffer, 0, 1000, 1000);
+}
+
 }  // namespace wal
 }  // namespace nebula
 
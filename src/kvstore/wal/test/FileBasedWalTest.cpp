@@ -10,6 +10,7 @@
 #include "kvstore/wal/FileBasedWal.h"
 
 DECLARE_int32(wal_ttl);
+DECLARE_int32(wal_index_interval);
 
 namespace nebula {
 namespace wal {
@@ -72,6 +73,46 @@ TEST(FileBasedWal, AppendLogs) {
   EXPECT_EQ(11, id);
 }
 
+TEST(FileBasedWal, SparseIndexTest) {
+  FLAGS_wal_index_interval = 16;
+  // Force to make each file 1MB, so the logs spread over multiple files
+  FileBasedWalInfo info;
+  FileBasedWalPolicy policy;
+  policy.fileSize = 1024L * 1024L;
+  TempDir walDir("/tmp/testWal.XXXXXX");
+
+  auto wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  for (int i = 1; i <= 1000; i++) {
+    EXPECT_TRUE(
+        wal->appendLog(i /*id*/, 1 /*term*/, 0 /*cluster*/, folly::stringPrintf(kLongMsg, i)));
+  }
+  EXPECT_EQ(1000, wal->lastLogId());
+  // Close the wal
+  wal.reset();
+
+  // Now let's open it to read, the index is rebuilt while scanning the files
+  wal = FileBasedWal::getWal(
+      walDir.path(), info, policy, [](LogID, TermID, ClusterID, folly::StringPiece) {
+        return true;
+      });
+  EXPECT_EQ(1000, wal->lastLogId());
+
+  // A catch-up read starting in the middle of a wal file seeks through the index
+  auto it = wal->iterator(777, 1000);
+  LogID id = 777;
+  while (it->valid()) {
+    EXPECT_EQ(id, it->logId());
+    EXPECT_EQ(folly::stringPrintf(kLongMsg, static_cast<int>(id)), it->logMsg());
+    ++(*it);
+    ++id;
+  }
+  EXPECT_EQ(1001, id);
+  FLAGS_wal_index_interval = 0;
+}
+
 TEST(FileBasedWal, CacheOverflow) {
   // Force to make each file 1MB, each buffer is 1MB, and there are two
   // buffers at most
@@ -218,6 +218,16 @@ class LastUpdateTimeMan final {
 
   static void update(kvstore::BatchHolder* batchHolder, const int64_t timeInMilliSec);
 
+  // space-scoped changes bump the per-space timestamp as well, so clients can tell
+  // which spaces actually changed and skip reloading the rest
+  static void update(std::vector<kvstore::KV>& data,
+                     GraphSpaceID spaceId,
+                     const int64_t timeInMilliSec);
+
+  static void update(kvstore::BatchHolder* batchHolder,
+                     GraphSpaceID spaceId,
+                     const int64_t timeInMilliSec);
+
  protected:
   LastUpdateTimeMan() = default;
 };
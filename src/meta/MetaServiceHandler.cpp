@@ -71,6 +71,12 @@
 #include "meta/processors/zone/MergeZoneProcessor.h"
 #include "meta/processors/zone/RenameZoneProcessor.h"
 
+DEFINE_bool(meta_follower_read,
+            false,
+            "Allow read-only meta processors (space/host/schema gets and lists) to serve "
+            "from a follower's local replica instead of forwarding to the raft leader. "
+            "Responses may lag the leader by the follower's replication delay.");
+
 #define RETURN_FUTURE(processor)   \
   auto f = processor->getFuture(); \
   processor->process(req);         \
@@ -97,7 +103,7 @@ folly::Future<cpp2::ExecResp> MetaServiceHandler::future_alterSpace(
 
 folly::Future<cpp2::ExecResp> MetaServiceHandler::future_createSpaceAs(
     const cpp2::CreateSpaceAsReq& req) {
-  auto* processor = CreateSpaceAsProcessor::instance(kvstore_);
+  auto* processor = CreateSpaceAsProcessor::instance(kvstore_, adminClient_.get());
   RETURN_FUTURE(processor);
 }
 
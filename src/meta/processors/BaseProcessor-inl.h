@@ -34,7 +34,8 @@ template <typename RESP>
 ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<kvstore::KVIterator>>
 BaseProcessor<RESP>::doPrefix(const std::string& key, bool canReadFromFollower) {
   std::unique_ptr<kvstore::KVIterator> iter;
-  auto code = kvstore_->prefix(kDefaultSpaceId, kDefaultPartId, key, &iter, canReadFromFollower);
+  auto code = kvstore_->prefix(
+      kDefaultSpaceId, kDefaultPartId, key, &iter, canReadFromFollower || followerRead_);
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     VLOG(2) << "Prefix Failed";
     return code;
@@ -43,9 +44,11 @@ BaseProcessor<RESP>::doPrefix(const std::string& key, bool canReadFromFollower)
 }
 
 template <typename RESP>
-ErrorOr<nebula::cpp2::ErrorCode, std::string> BaseProcessor<RESP>::doGet(const std::string& key) {
+ErrorOr<nebula::cpp2::ErrorCode, std::string> BaseProcessor<RESP>::doGet(
+    const std::string& key, bool canReadFromFollower) {
   std::string value;
-  auto code = kvstore_->get(kDefaultSpaceId, kDefaultPartId, key, &value);
+  auto code = kvstore_->get(
+      kDefaultSpaceId, kDefaultPartId, key, &value, canReadFromFollower || followerRead_);
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     VLOG(2) << "Get Failed";
     return code;
@@ -55,9 +58,10 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> BaseProcessor<RESP>::doGet(const s
 
 template <typename RESP>
 ErrorOr<nebula::cpp2::ErrorCode, std::vector<std::string>> BaseProcessor<RESP>::doMultiGet(
-    const std::vector<std::string>& keys) {
+    const std::vector<std::string>& keys, bool canReadFromFollower) {
   std::vector<std::string> values;
-  auto ret = kvstore_->multiGet(kDefaultSpaceId, kDefaultPartId, keys, &values);
+  auto ret = kvstore_->multiGet(
+      kDefaultSpaceId, kDefaultPartId, keys, &values, canReadFromFollower || followerRead_);
   auto code = ret.first;
   if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
     VLOG(2) << "MultiGet Failed";
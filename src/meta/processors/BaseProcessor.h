@@ -140,19 +140,22 @@ class BaseProcessor {
    *
    * @tparam RESP
    * @param key
+   * @param canReadFromFollower read from follower's local
    * @return ErrorOr<nebula::cpp2::ErrorCode, std::string>
    */
-  ErrorOr<nebula::cpp2::ErrorCode, std::string> doGet(const std::string& key);
+  ErrorOr<nebula::cpp2::ErrorCode, std::string> doGet(const std::string& key,
+                                                      bool canReadFromFollower = false);
 
   /**
    * @brief Multiple get for given keys.
    *
    * @tparam RESP
    * @param keys
+   * @param canReadFromFollower read from follower's local
    * @return ErrorOr<nebula::cpp2::ErrorCode, std::vector<std::string>>
    */
   ErrorOr<nebula::cpp2::ErrorCode, std::vector<std::string>> doMultiGet(
-      const std::vector<std::string>& keys);
+      const std::vector<std::string>& keys, bool canReadFromFollower = false);
 
   /**
    * @brief Remove given keys from kv store.
@@ -470,6 +473,12 @@ class BaseProcessor {
   RESP resp_;
   folly::Promise<RESP> promise_;
   time::Duration duration_;
+  // When set, every kv read issued by this processor (including the ones hidden in the
+  // helpers above, e.g. spaceExist/getSpaceId) may be served from a follower's local
+  // replica. Read-only processors set it from FLAGS_meta_follower_read; staleness is
+  // bounded by the raft replication lag of the follower. Never set it in a processor
+  // that writes, since its reads feed the mutation.
+  bool followerRead_{false};
 
   static const int32_t maxIndexLimit = 16;
 };
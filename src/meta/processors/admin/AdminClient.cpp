@@ -383,6 +383,52 @@ folly::Future<nebula::cpp2::ErrorCode> AdminClient::clearSpace(GraphSpaceID spac
   return f;
 }
 
+folly::Future<nebula::cpp2::ErrorCode> AdminClient::cloneSpace(GraphSpaceID oldSpaceId,
+                                                               GraphSpaceID newSpaceId,
+                                                               const std::vector<HostAddr>& hosts) {
+  folly::Promise<nebula::cpp2::ErrorCode> promise;
+  auto f = promise.getFuture();
+
+  std::vector<folly::Future<StatusOr<nebula::cpp2::ErrorCode>>> futures;
+  for (auto& host : hosts) {
+    folly::Promise<StatusOr<nebula::cpp2::ErrorCode>> pro;
+    futures.emplace_back(pro.getFuture());
+
+    storage::cpp2::CloneSpaceReq req;
+    req.old_space_id_ref() = oldSpaceId;
+    req.new_space_id_ref() = newSpaceId;
+    getResponseFromHost(
+        Utils::getAdminAddrFromStoreAddr(host),
+        std::move(req),
+        [](auto client, auto request) { return client->future_cloneSpace(request); },
+        [](auto&& resp) -> nebula::cpp2::ErrorCode { return resp.get_code(); },
+        std::move(pro));
+  }
+
+  folly::collectAll(std::move(futures))
+      .via(ioThreadPool_.get())
+      .thenTry([pro = std::move(promise)](auto&& futureRet) mutable {
+        if (futureRet.hasException()) {
+          pro.setValue(nebula::cpp2::ErrorCode::E_RPC_FAILURE);
+        } else {
+          auto vec = std::move(futureRet).value();
+          bool isAllOk = true;
+          for (auto& v : vec) {
+            auto resp = std::move(v).value();
+            if (!resp.ok()) {
+              pro.setValue(nebula::cpp2::ErrorCode::E_RPC_FAILURE);
+              isAllOk = false;
+              break;
+            }
+          }
+          if (isAllOk) {
+            pro.setValue(nebula::cpp2::ErrorCode::SUCCEEDED);
+          }
+        }
+      });
+  return f;
+}
+
 template <typename Request, typename RemoteFunc, typename RespGenerator>
 folly::Future<Status> AdminClient::getResponseFromPart(const HostAddr& host,
                                                        Request req,
@@ -160,6 +160,19 @@ class AdminClient {
   virtual folly::Future<nebula::cpp2::ErrorCode> clearSpace(GraphSpaceID spaceId,
                                                             const std::vector<HostAddr>& hosts);
 
+  /**
+   * @brief Clone the local data of one space into another on all corresponding storage hosts,
+   * via rocksdb checkpoint hard links.
+   *
+   * @param oldSpaceId space to clone from
+   * @param newSpaceId space to clone into
+   * @param hosts storage admin service addresses
+   * @return folly::Future<nebula::cpp2::ErrorCode>
+   */
+  virtual folly::Future<nebula::cpp2::ErrorCode> cloneSpace(GraphSpaceID oldSpaceId,
+                                                            GraphSpaceID newSpaceId,
+                                                            const std::vector<HostAddr>& hosts);
+
   /**
    * @brief Get the all partitions' leader distribution
    *
@@ -220,7 +220,7 @@ void CreateEdgeIndexProcessor::process(const cpp2::CreateEdgeIndexReq& req) {
   LOG(INFO) << "Create Edge Index " << indexName << ", edgeIndex " << edgeIndex;
   resp_.id_ref() = to(edgeIndex, EntryType::INDEX);
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, space, timeInMilliSec);
   auto result = doSyncPut(std::move(data));
   handleErrorCode(result);
   onFinished();
@@ -148,7 +148,7 @@ class BalanceJobExecutor : public MetaJobExecutor {
   nebula::cpp2::ErrorCode updateLastTime() {
     std::vector<kvstore::KV> data;
     auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-    LastUpdateTimeMan::update(data, timeInMilliSec);
+    LastUpdateTimeMan::update(data, spaceInfo_.spaceId_, timeInMilliSec);
 
     folly::Baton<true, std::atomic> baton;
     nebula::cpp2::ErrorCode ret;
@@ -11,6 +11,11 @@
 #include "meta/processors/Common.h"
 
 DEFINE_uint32(task_concurrency, 10, "The tasks number could be invoked simultaneously");
+DEFINE_uint32(balance_moves_per_host,
+              0,
+              "Best-effort bound on how many balance part moves a single host serves at the same "
+              "time as source or target. 0 keeps the historical one-bucket-per-part dispatch, "
+              "which may stack every concurrent move on the same host.");
 
 namespace nebula {
 namespace meta {
@@ -22,13 +27,59 @@ void BalancePlan::dispatchTasks() {
   for (auto& task : tasks_) {
     partTasks[std::make_pair(task.spaceId_, task.partId_)].emplace_back(index++);
   }
-  buckets_.resize(partTasks.size());
-  int32_t bucketIndex = 0;
+  if (FLAGS_balance_moves_per_host == 0) {
+    buckets_.resize(partTasks.size());
+    int32_t bucketIndex = 0;
+    for (auto it = partTasks.begin(); it != partTasks.end(); it++) {
+      for (auto taskIndex : it->second) {
+        buckets_[bucketIndex].emplace_back(taskIndex);
+      }
+      bucketIndex++;
+    }
+    return;
+  }
+
+  // Pack the per-part task chains into buckets so that a host takes part in at
+  // most FLAGS_balance_moves_per_host concurrently running buckets. A chain
+  // exceeding the budget of one of its hosts is appended to a bucket already
+  // touching that host, which serializes it behind the earlier moves. The bound
+  // is best-effort: joining an existing bucket may still add its other hosts to
+  // one more bucket than budgeted.
+  buckets_.clear();
+  std::unordered_map<HostAddr, std::vector<int32_t>> hostBuckets;
   for (auto it = partTasks.begin(); it != partTasks.end(); it++) {
+    std::vector<HostAddr> hosts;
+    for (auto taskIndex : it->second) {
+      hosts.emplace_back(tasks_[taskIndex].src_);
+      hosts.emplace_back(tasks_[taskIndex].dst_);
+    }
+    int32_t target = -1;
+    for (auto& host : hosts) {
+      auto hostIter = hostBuckets.find(host);
+      if (hostIter == hostBuckets.end() ||
+          hostIter->second.size() < FLAGS_balance_moves_per_host) {
+        continue;
+      }
+      for (int32_t bucket : hostIter->second) {
+        if (target < 0 || buckets_[bucket].size() < buckets_[target].size()) {
+          target = bucket;
+        }
+      }
+      break;
+    }
+    if (target < 0) {
+      target = buckets_.size();
+      buckets_.emplace_back();
+    }
     for (auto taskIndex : it->second) {
-      buckets_[bucketIndex].emplace_back(taskIndex);
+      buckets_[target].emplace_back(taskIndex);
+    }
+    for (auto& host : hosts) {
+      auto& inBuckets = hostBuckets[host];
+      if (std::find(inBuckets.begin(), inBuckets.end(), target) == inBuckets.end()) {
+        inBuckets.emplace_back(target);
+      }
     }
-    bucketIndex++;
   }
 }
 
@@ -40,6 +91,20 @@ folly::Future<meta::cpp2::JobStatus> BalancePlan::invoke() {
   std::sort(
       tasks_.begin(), tasks_.end(), [](auto& l, auto& r) { return l.taskIdStr() < r.taskIdStr(); });
   dispatchTasks();
+  {
+    // Log the planned moves per src->dst link before anything runs. Meta knows
+    // part counts but not part sizes, so this is the expected-transfer report
+    // an operator can check (and stop the job) before data starts moving.
+    std::map<std::string, int32_t> linkMoves;
+    for (auto& task : tasks_) {
+      linkMoves[folly::stringPrintf("%s->%s",
+                                    task.src_.toString().c_str(),
+                                    task.dst_.toString().c_str())]++;
+    }
+    for (auto& [link, numParts] : linkMoves) {
+      LOG(INFO) << "Balance plan " << id() << " moves " << numParts << " parts over " << link;
+    }
+  }
   for (size_t i = 0; i < buckets_.size(); i++) {
     for (size_t j = 0; j < buckets_[i].size(); j++) {
       auto taskIndex = buckets_[i][j];
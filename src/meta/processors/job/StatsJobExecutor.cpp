@@ -5,6 +5,7 @@
 
 #include "meta/processors/job/StatsJobExecutor.h"
 
+#include "common/algorithm/HyperLogLog.h"
 #include "common/utils/MetaKeyUtils.h"
 #include "common/utils/Utils.h"
 #include "meta/processors/Common.h"
@@ -109,6 +110,25 @@ void StatsJobExecutor::addStats(cpp2::StatsItem& lhs, const cpp2::StatsItem& rhs
   (*lhs.negative_part_correlativity_ref())
       .insert((*rhs.negative_part_correlativity_ref()).begin(),  // NOLINT
               (*rhs.negative_part_correlativity_ref()).end());
+
+  // Approximate stats reported by hosts with enable_approx_stats on: sketches of
+  // different parts merge by register-wise max, histograms by bucket sum
+  if (rhs.vid_sketch_ref().has_value()) {
+    if (!lhs.vid_sketch_ref().has_value()) {
+      lhs.vid_sketch_ref() = *rhs.vid_sketch_ref();
+    } else {
+      algorithm::HyperLogLog::mergeSerialized(*lhs.vid_sketch_ref(), *rhs.vid_sketch_ref());
+    }
+  }
+  if (rhs.degree_histogram_ref().has_value()) {
+    if (!lhs.degree_histogram_ref().has_value()) {
+      lhs.degree_histogram_ref() = *rhs.degree_histogram_ref();
+    } else {
+      for (auto& [bucket, count] : *rhs.degree_histogram_ref()) {
+        (*lhs.degree_histogram_ref())[bucket] += count;
+      }
+    }
+  }
 }
 
 /**
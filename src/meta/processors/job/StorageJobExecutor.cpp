@@ -23,6 +23,11 @@
 
 DECLARE_int32(heartbeat_interval_secs);
 DECLARE_uint32(expired_time_factor);
+DEFINE_uint32(job_dispatch_batch_size,
+              0,
+              "How many storage hosts an admin job dispatches tasks to at a time, the next batch "
+              "is sent when the previous one finished. 0 dispatches to all hosts at once, which "
+              "keeps the historical behavior but lets a heavy job hit every host simultaneously.");
 
 namespace nebula {
 namespace meta {
@@ -133,6 +138,33 @@ ErrOrHosts StorageJobExecutor::getListenerHost(GraphSpaceID space, cpp2::Listene
   return hosts;
 }
 
+nebula::cpp2::ErrorCode StorageJobExecutor::recovery() {
+  finishedHosts_.clear();
+  staleTaskKeys_.clear();
+  const auto& jobKey = MetaKeyUtils::jobKey(space_, jobId_);
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto retCode = kvstore_->prefix(kDefaultSpaceId, kDefaultPartId, jobKey, &iter);
+  if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    LOG(INFO) << "Load tasks of job " << jobId_
+              << " failed, error: " << apache::thrift::util::enumNameSafe(retCode);
+    return retCode;
+  }
+  for (; iter->valid(); iter->next()) {
+    if (MetaKeyUtils::isJobKey(iter->key())) {
+      continue;
+    }
+    TaskDescription task(iter->key(), iter->val());
+    if (task.getStatus() == cpp2::JobStatus::FINISHED) {
+      finishedHosts_.emplace(task.getHost());
+    } else {
+      staleTaskKeys_.emplace_back(iter->key().str());
+    }
+    // Fresh tasks get ids after the records kept from the previous run
+    taskId_ = std::max<TaskID>(taskId_, task.getTaskId() + 1);
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 folly::Future<nebula::cpp2::ErrorCode> StorageJobExecutor::execute() {
   ErrOrHosts addressesRet;
   isRunning_.store(true);
@@ -160,11 +192,48 @@ folly::Future<nebula::cpp2::ErrorCode> StorageJobExecutor::execute() {
   std::vector<PartitionID> parts;
   auto addresses = nebula::value(addressesRet);
 
+  if (!finishedHosts_.empty()) {
+    // Recovered job: skip the hosts which already finished their task, the
+    // records kept in recovery() are their checkpoint. If every host finished
+    // (e.g. the job failed while saving its own status), redo the whole job
+    // instead, otherwise no task report would ever end it.
+    auto isFinished = [this](auto& item) { return finishedHosts_.count(item.first) != 0; };
+    if (!std::all_of(addresses.begin(), addresses.end(), isFinished)) {
+      auto numHosts = addresses.size();
+      addresses.erase(std::remove_if(addresses.begin(), addresses.end(), isFinished),
+                      addresses.end());
+      LOG(INFO) << "Job " << jobId_ << " resumes on " << addresses.size() << " of " << numHosts
+                << " hosts";
+    }
+  }
+
+  folly::Baton<true, std::atomic> baton;
+  auto rc = nebula::cpp2::ErrorCode::SUCCEEDED;
+  if (!staleTaskKeys_.empty()) {
+    // Drop the unfinished records of the previous run, they are replaced by the
+    // fresh tasks below and would otherwise keep the job from reaching FINISHED.
+    kvstore_->asyncMultiRemove(kDefaultSpaceId,
+                               kDefaultPartId,
+                               std::move(staleTaskKeys_),
+                               [&](nebula::cpp2::ErrorCode code) {
+                                 rc = code;
+                                 baton.post();
+                               });
+    baton.wait();
+    if (rc != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      LOG(INFO) << "Remove stale tasks failed, error: "
+                << apache::thrift::util::enumNameSafe(rc);
+      return rc;
+    }
+    baton.reset();
+  }
+
   // write all tasks first.
+  const TaskID baseTaskId = taskId_;
   std::vector<kvstore::KV> data;
   std::vector<TaskDescription> allTasks;
   for (auto i = 0U; i != addresses.size(); ++i) {
-    TaskDescription task(space_, jobId_, i, addresses[i].first);
+    TaskDescription task(space_, jobId_, baseTaskId + i, addresses[i].first);
     auto taskKey = MetaKeyUtils::taskKey(task.getSpace(), task.getJobId(), task.getTaskId());
     auto taskVal = MetaKeyUtils::taskVal(task.getHost(),
                                          task.getStatus(),
@@ -175,8 +244,6 @@ folly::Future<nebula::cpp2::ErrorCode> StorageJobExecutor::execute() {
     data.emplace_back(std::move(taskKey), std::move(taskVal));
   }
 
-  folly::Baton<true, std::atomic> baton;
-  auto rc = nebula::cpp2::ErrorCode::SUCCEEDED;
   kvstore_->asyncMultiPut(
       kDefaultSpaceId, kDefaultPartId, std::move(data), [&](nebula::cpp2::ErrorCode code) {
         rc = code;
@@ -188,14 +255,25 @@ folly::Future<nebula::cpp2::ErrorCode> StorageJobExecutor::execute() {
     return rc;
   }
 
-  std::vector<folly::SemiFuture<Status>> futures;
-  futures.reserve(addresses.size());
-  for (auto& address : addresses) {
-    // Will convert StorageAddr to AdminAddr in AdminClient
-    futures.emplace_back(executeInternal(std::move(address.first), std::move(address.second)));
+  size_t batchSize = FLAGS_job_dispatch_batch_size == 0
+                         ? addresses.size()
+                         : std::min<size_t>(FLAGS_job_dispatch_batch_size, addresses.size());
+  std::vector<folly::Try<Status>> tries;
+  tries.reserve(addresses.size());
+  for (size_t begin = 0; begin < addresses.size(); begin += batchSize) {
+    auto end = std::min(addresses.size(), begin + batchSize);
+    std::vector<folly::SemiFuture<Status>> futures;
+    futures.reserve(end - begin);
+    for (auto i = begin; i < end; ++i) {
+      // Will convert StorageAddr to AdminAddr in AdminClient
+      futures.emplace_back(
+          executeInternal(std::move(addresses[i].first), std::move(addresses[i].second)));
+    }
+    auto batchTries = folly::collectAll(std::move(futures)).get();
+    for (auto& t : batchTries) {
+      tries.emplace_back(std::move(t));
+    }
   }
-
-  auto tries = folly::collectAll(std::move(futures)).get();
   std::vector<TaskDescription> failedTasks;
   for (size_t i = 0; i < tries.size(); i++) {
     auto getFaildTask = [&](size_t taskId, nebula::cpp2::ErrorCode ec) {
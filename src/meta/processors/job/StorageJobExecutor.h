@@ -88,9 +88,13 @@ class StorageJobExecutor : public JobExecutor {
     return ret;
   }
 
-  nebula::cpp2::ErrorCode recovery() override {
-    return nebula::cpp2::ErrorCode::SUCCEEDED;
-  }
+  /**
+   * @brief Load the task records left by the previous run, so that execute()
+   * only re-dispatches to the hosts which did not finish their task.
+   *
+   * @return
+   */
+  nebula::cpp2::ErrorCode recovery() override;
 
   bool isRunning() override {
     return isRunning_.load();
@@ -116,6 +120,12 @@ class StorageJobExecutor : public JobExecutor {
   AdminClient* adminClient_{nullptr};
   std::vector<std::string> paras_;
   TargetHosts toHost_{TargetHosts::DEFAULT};
+  // Hosts whose task finished in a previous run of this job, filled by recovery().
+  // execute() skips them so a recovered job only redoes the unfinished hosts.
+  std::unordered_set<HostAddr> finishedHosts_;
+  // Task records of the previous run which did not finish; they are removed before
+  // the fresh tasks are written, otherwise the job could never reach FINISHED.
+  std::vector<std::string> staleTaskKeys_;
   volatile bool stopped_{false};
   std::mutex muInterrupt_;
   std::condition_variable condInterrupt_;
@@ -7,6 +7,11 @@
 
 #include "meta/ActiveHostsMan.h"
 
+DEFINE_bool(clone_space_with_data,
+            false,
+            "Whether CREATE SPACE AS also clones the data of the old space on every storage "
+            "host via rocksdb checkpoint hard links");
+
 namespace nebula {
 namespace meta {
 
@@ -103,15 +108,58 @@ void CreateSpaceAsProcessor::process(const cpp2::CreateSpaceAsReq &req) {
 
   resp_.id_ref() = to(nebula::value(newSpaceId), EntryType::SPACE);
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, nebula::value(newSpaceId), timeInMilliSec);
   rc_ = doSyncPut(std::move(data));
   if (rc_ != nebula::cpp2::ErrorCode::SUCCEEDED) {
     LOG(INFO) << "Update last update time error, " << apache::thrift::util::enumNameSafe(rc_);
     return;
   }
+
+  if (FLAGS_clone_space_with_data) {
+    rc_ = cloneSpaceData(nebula::value(oldSpaceId), nebula::value(newSpaceId));
+    if (rc_ != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      LOG(INFO) << "Clone space data from [" << oldSpaceName << "] to [" << newSpaceName
+                << "] failed, " << apache::thrift::util::enumNameSafe(rc_);
+      return;
+    }
+  }
   LOG(INFO) << "Created space " << newSpaceName;
 }
 
+nebula::cpp2::ErrorCode CreateSpaceAsProcessor::cloneSpaceData(GraphSpaceID oldSpaceId,
+                                                               GraphSpaceID newSpaceId) {
+  // Determine which active hosts the old space is distributed on.
+  auto ret = getAllParts(oldSpaceId);
+  if (!nebula::ok(ret)) {
+    return nebula::error(ret);
+  }
+  std::unordered_set<HostAddr> distributedOnHosts;
+  for (auto &partEntry : nebula::value(ret)) {
+    for (auto &host : partEntry.second) {
+      distributedOnHosts.insert(host);
+    }
+  }
+
+  auto activeHostsRet = ActiveHostsMan::getActiveHosts(kvstore_);
+  if (!nebula::ok(activeHostsRet)) {
+    return nebula::error(activeHostsRet);
+  }
+  auto activeHosts = std::move(nebula::value(activeHostsRet));
+  std::vector<HostAddr> hosts;
+  for (auto &host : distributedOnHosts) {
+    if (std::find(activeHosts.begin(), activeHosts.end(), host) != activeHosts.end()) {
+      hosts.push_back(host);
+    }
+  }
+  if (hosts.empty()) {
+    return nebula::cpp2::ErrorCode::E_NO_HOSTS;
+  }
+
+  // Clone the space data on the corresponding hosts. The storage side links the old space's
+  // sst files into the new space via rocksdb checkpoint, so this costs O(metadata).
+  return adminClient_->cloneSpace(oldSpaceId, newSpaceId, hosts).get();
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::vector<kvstore::KV>> CreateSpaceAsProcessor::makeNewSpaceData(
     GraphSpaceID oldSpaceId, GraphSpaceID newSpaceId, const std::string &spaceName) {
   auto oldSpaceKey = MetaKeyUtils::spaceKey(oldSpaceId);
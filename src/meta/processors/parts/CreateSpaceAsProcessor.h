@@ -6,6 +6,7 @@
 #define META_PROCESSORS_PARTS_CREATESPACEASPROCESSOR_H
 
 #include "meta/processors/BaseProcessor.h"
+#include "meta/processors/admin/AdminClient.h"
 
 namespace nebula {
 namespace meta {
@@ -21,16 +22,21 @@ using Hosts = std::vector<HostAddr>;
  *        - edges
  *        - indexes
  *
+ * When FLAGS_clone_space_with_data is on, the data of the old space is also cloned on every
+ * storage host via rocksdb checkpoint hard links, so the copy costs O(metadata) and the two
+ * spaces diverge copy-on-write at the sst level.
  */
 class CreateSpaceAsProcessor : public BaseProcessor<cpp2::ExecResp> {
  public:
-  static CreateSpaceAsProcessor* instance(kvstore::KVStore* kvstore) {
-    return new CreateSpaceAsProcessor(kvstore);
+  static CreateSpaceAsProcessor* instance(kvstore::KVStore* kvstore, AdminClient* adminClient) {
+    return new CreateSpaceAsProcessor(kvstore, adminClient);
   }
 
   void process(const cpp2::CreateSpaceAsReq& req);
 
  protected:
+  nebula::cpp2::ErrorCode cloneSpaceData(GraphSpaceID oldSpaceId, GraphSpaceID newSpaceId);
+
   ErrorOr<nebula::cpp2::ErrorCode, std::vector<kvstore::KV>> makeNewSpaceData(
       GraphSpaceID oldSpaceId, GraphSpaceID newSpaceId, const std::string& spaceName);
 
@@ -49,8 +55,10 @@ class CreateSpaceAsProcessor : public BaseProcessor<cpp2::ExecResp> {
   nebula::cpp2::ErrorCode rc_{nebula::cpp2::ErrorCode::SUCCEEDED};
 
  private:
-  explicit CreateSpaceAsProcessor(kvstore::KVStore* kvstore)
-      : BaseProcessor<cpp2::ExecResp>(kvstore) {}
+  CreateSpaceAsProcessor(kvstore::KVStore* kvstore, AdminClient* adminClient)
+      : BaseProcessor<cpp2::ExecResp>(kvstore), adminClient_(adminClient) {}
+
+  AdminClient* adminClient_{nullptr};
 };
 
 }  // namespace meta
@@ -148,6 +148,7 @@ void DropSpaceProcessor::process(const cpp2::DropSpaceReq& req) {
 
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
   LastUpdateTimeMan::update(batchHolder.get(), timeInMilliSec);
+  batchHolder->remove(MetaKeyUtils::spaceLastUpdateTimeKey(spaceId));
   auto batch = encodeBatchValue(std::move(batchHolder)->getBatch());
   doBatchOperation(std::move(batch));
   LOG(INFO) << "Drop space " << spaceName << ", id " << spaceId;
@@ -5,10 +5,13 @@
 
 #include "meta/processors/parts/GetSpaceProcessor.h"
 
+DECLARE_bool(meta_follower_read);
+
 namespace nebula {
 namespace meta {
 
 void GetSpaceProcessor::process(const cpp2::GetSpaceReq& req) {
+  followerRead_ = FLAGS_meta_follower_read;
   folly::SharedMutex::ReadHolder holder(LockUtils::lock());
   const auto& spaceName = req.get_space_name();
 
@@ -11,6 +11,7 @@
 #include "version/Version.h"
 
 DECLARE_int32(heartbeat_interval_secs);
+DECLARE_bool(meta_follower_read);
 DECLARE_int32(agent_heartbeat_interval_secs);
 DECLARE_uint32(expired_time_factor);
 DEFINE_int32(removed_threshold_sec,
@@ -38,6 +39,7 @@ static cpp2::HostRole toHostRole(cpp2::ListHostType type) {
 }
 
 void ListHostsProcessor::process(const cpp2::ListHostsReq& req) {
+  followerRead_ = FLAGS_meta_follower_read;
   nebula::cpp2::ErrorCode retCode;
   {
     folly::SharedMutex::ReadHolder holder(LockUtils::lock());
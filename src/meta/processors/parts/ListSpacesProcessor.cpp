@@ -5,10 +5,13 @@
 
 #include "meta/processors/parts/ListSpacesProcessor.h"
 
+DECLARE_bool(meta_follower_read);
+
 namespace nebula {
 namespace meta {
 
 void ListSpacesProcessor::process(const cpp2::ListSpacesReq&) {
+  followerRead_ = FLAGS_meta_follower_read;
   folly::SharedMutex::ReadHolder holder(LockUtils::lock());
   const auto& prefix = MetaKeyUtils::spacePrefix();
   auto ret = doPrefix(prefix);
@@ -22,6 +25,7 @@ void ListSpacesProcessor::process(const cpp2::ListSpacesReq&) {
   auto iter = nebula::value(ret).get();
 
   std::vector<cpp2::IdName> spaces;
+  std::unordered_map<GraphSpaceID, int64_t> updateTimes;
   while (iter->valid()) {
     auto spaceId = MetaKeyUtils::spaceId(iter->key());
     auto spaceName = MetaKeyUtils::spaceName(iter->val());
@@ -30,11 +34,20 @@ void ListSpacesProcessor::process(const cpp2::ListSpacesReq&) {
     space.id_ref() = to(spaceId, EntryType::SPACE);
     space.name_ref() = std::move(spaceName);
     spaces.emplace_back(std::move(space));
+    // spaces created before the per-space timestamp existed report 0,
+    // clients treat that as unknown and always reload them
+    int64_t updateTime = 0;
+    auto timeRet = doGet(MetaKeyUtils::spaceLastUpdateTimeKey(spaceId));
+    if (nebula::ok(timeRet)) {
+      updateTime = *reinterpret_cast<const int64_t*>(nebula::value(timeRet).data());
+    }
+    updateTimes.emplace(spaceId, updateTime);
     iter->next();
   }
 
   handleErrorCode(nebula::cpp2::ErrorCode::SUCCEEDED);
   resp_.spaces_ref() = std::move(spaces);
+  resp_.update_times_ref() = std::move(updateTimes);
   onFinished();
 }
 
@@ -86,7 +86,7 @@ void CreateEdgeProcessor::process(const cpp2::CreateEdgeReq& req) {
   LOG(INFO) << "Create Edge " << edgeName << ", edgeType " << edgeType;
   resp_.id_ref() = to(edgeType, EntryType::EDGE);
   auto timeInMilliSec = time::WallClock::fastNowInMilliSec();
-  LastUpdateTimeMan::update(data, timeInMilliSec);
+  LastUpdateTimeMan::update(data, spaceId, timeInMilliSec);
   auto result = doSyncPut(std::move(data));
   handleErrorCode(result);
   onFinished();
@@ -5,10 +5,13 @@
 
 #include "meta/processors/schema/GetEdgeProcessor.h"
 
+DECLARE_bool(meta_follower_read);
+
 namespace nebula {
 namespace meta {
 
 void GetEdgeProcessor::process(const cpp2::GetEdgeReq& req) {
+  followerRead_ = FLAGS_meta_follower_read;
   GraphSpaceID spaceId = req.get_space_id();
   CHECK_SPACE_ID_AND_RETURN(spaceId);
   const auto& edgeName = req.get_edge_name();
@@ -5,10 +5,13 @@
 
 #include "meta/processors/schema/ListTagsProcessor.h"
 
+DECLARE_bool(meta_follower_read);
+
 namespace nebula {
 namespace meta {
 
 void ListTagsProcessor::process(const cpp2::ListTagsReq &req) {
+  followerRead_ = FLAGS_meta_follower_read;
   GraphSpaceID spaceId = req.get_space_id();
   CHECK_SPACE_ID_AND_RETURN(spaceId);
 
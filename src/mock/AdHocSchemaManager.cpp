@@ -251,13 +251,14 @@ StatusOr<nebula::cpp2::PropertyType> AdHocSchemaManager::getSpaceVidType(GraphSp
   return nebula::cpp2::PropertyType::FIXED_STRING;
 }
 
-StatusOr<TagSchemas> AdHocSchemaManager::getAllVerTagSchema(GraphSpaceID space) {
+StatusOr<std::shared_ptr<const meta::TagSchemas>> AdHocSchemaManager::getAllVerTagSchema(
+    GraphSpaceID space) {
   folly::RWSpinLock::ReadHolder rh(tagLock_);
   auto iter = tagSchemasInVector_.find(space);
   if (iter == tagSchemasInVector_.end()) {
     return Status::Error("Space not found");
   }
-  return iter->second;
+  return std::make_shared<const TagSchemas>(iter->second);
 }
 
 StatusOr<TagSchema> AdHocSchemaManager::getAllLatestVerTagSchema(GraphSpaceID space) {
@@ -275,13 +276,14 @@ StatusOr<TagSchema> AdHocSchemaManager::getAllLatestVerTagSchema(GraphSpaceID sp
   return tagsSchema;
 }
 
-StatusOr<EdgeSchemas> AdHocSchemaManager::getAllVerEdgeSchema(GraphSpaceID space) {
+StatusOr<std::shared_ptr<const meta::EdgeSchemas>> AdHocSchemaManager::getAllVerEdgeSchema(
+    GraphSpaceID space) {
   folly::RWSpinLock::ReadHolder rh(edgeLock_);
   auto iter = edgeSchemasInVector_.find(space);
   if (iter == edgeSchemasInVector_.end()) {
     return Status::Error("Space not found");
   }
-  return iter->second;
+  return std::make_shared<const EdgeSchemas>(iter->second);
 }
 
 StatusOr<EdgeSchema> AdHocSchemaManager::getAllLatestVerEdgeSchema(GraphSpaceID space) {
@@ -74,13 +74,15 @@ class AdHocSchemaManager final : public nebula::meta::SchemaManager {
   StatusOr<nebula::cpp2::PropertyType> getSpaceVidType(GraphSpaceID) override;
 
   // Get all versions of all tags
-  StatusOr<TagSchemas> getAllVerTagSchema(GraphSpaceID space) override;
+  StatusOr<std::shared_ptr<const meta::TagSchemas>> getAllVerTagSchema(
+      GraphSpaceID space) override;
 
   // Get latest version of all tags
   StatusOr<TagSchema> getAllLatestVerTagSchema(GraphSpaceID space) override;
 
   // Get all version of all edges
-  StatusOr<EdgeSchemas> getAllVerEdgeSchema(GraphSpaceID space) override;
+  StatusOr<std::shared_ptr<const meta::EdgeSchemas>> getAllVerEdgeSchema(
+      GraphSpaceID space) override;
 
   // Get latest version of all edges
   StatusOr<EdgeSchema> getAllLatestVerEdgeSchema(GraphSpaceID space) override;
@@ -0,0 +1,503 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "parser/FastParser.h"
+
+#include "common/expression/AttributeExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/function/AggFunctionManager.h"
+#include "common/function/FunctionManager.h"
+#include "common/expression/EdgeExpression.h"
+#include "common/expression/LabelAttributeExpression.h"
+#include "common/expression/LabelExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/expression/VertexExpression.h"
+#include "graph/context/QueryContext.h"
+#include "parser/SequentialSentences.h"
+#include "parser/TraverseSentences.h"
+
+namespace nebula {
+
+// static
+Sentence *FastParser::tryParse(const std::string &query, graph::QueryContext *qctx) {
+  if (qctx == nullptr) {
+    return nullptr;
+  }
+  FastParser parser(query, qctx);
+  if (!parser.tokenize()) {
+    return nullptr;
+  }
+  Sentence *sentence = nullptr;
+  if (parser.acceptKeyword("go")) {
+    sentence = parser.parseGo();
+  } else if (parser.acceptKeyword("fetch")) {
+    sentence = parser.parseFetchVertices();
+  }
+  if (sentence == nullptr) {
+    return nullptr;
+  }
+  // A single recognized statement and nothing else: pipes, semicolons and everything
+  // beyond the subset never get this far because tokenize() refuses their characters
+  if (parser.peek().kind != TokenKind::kEnd) {
+    delete sentence;
+    return nullptr;
+  }
+  // The bison parser wraps every top level statement the same way
+  return new SequentialSentences(sentence);
+}
+
+bool FastParser::tokenize() {
+  const char *p = query_.data();
+  const char *end = p + query_.size();
+  while (p < end) {
+    char c = *p;
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+      p++;
+      continue;
+    }
+    if (c == '"' || c == '\'') {
+      const char *start = ++p;
+      while (p < end && *p != c) {
+        if (*p == '\\') {
+          // Escapes follow the flex scanner's rules, leave them to it
+          return false;
+        }
+        p++;
+      }
+      if (p == end) {
+        return false;  // Unterminated string
+      }
+      tokens_.emplace_back(Token{TokenKind::kString, std::string(start, p - start), 0});
+      p++;
+      continue;
+    }
+    if (c >= '0' && c <= '9') {
+      int64_t val = 0;
+      while (p < end && *p >= '0' && *p <= '9') {
+        if (val > (std::numeric_limits<int64_t>::max() - (*p - '0')) / 10) {
+          return false;  // Overflow handling differs per context, bail
+        }
+        val = val * 10 + (*p - '0');
+        p++;
+      }
+      if (p < end && (*p == '.' || *p == 'e' || *p == 'E' || *p == 'x' || *p == 'X')) {
+        return false;  // Floats and hex literals are not in the subset
+      }
+      tokens_.emplace_back(Token{TokenKind::kInt, "", val});
+      continue;
+    }
+    if ((c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_') {
+      const char *start = p;
+      while (p < end && ((*p >= 'a' && *p <= 'z') || (*p >= 'A' && *p <= 'Z') ||
+                         (*p >= '0' && *p <= '9') || *p == '_')) {
+        p++;
+      }
+      tokens_.emplace_back(Token{TokenKind::kLabel, std::string(start, p - start), 0});
+      continue;
+    }
+    if (c == '$') {
+      if (p + 1 < end && p[1] == '$') {
+        tokens_.emplace_back(Token{TokenKind::kDstRef, "", 0});
+        p += 2;
+        continue;
+      }
+      if (p + 1 < end && p[1] == '^') {
+        tokens_.emplace_back(Token{TokenKind::kSrcRef, "", 0});
+        p += 2;
+        continue;
+      }
+      return false;  // $var / $- input refs need the full grammar
+    }
+    switch (c) {
+      case ',':
+        tokens_.emplace_back(Token{TokenKind::kComma, "", 0});
+        break;
+      case '.':
+        tokens_.emplace_back(Token{TokenKind::kDot, "", 0});
+        break;
+      case '*':
+        tokens_.emplace_back(Token{TokenKind::kStar, "", 0});
+        break;
+      case '(':
+        tokens_.emplace_back(Token{TokenKind::kLParen, "", 0});
+        break;
+      case ')':
+        tokens_.emplace_back(Token{TokenKind::kRParen, "", 0});
+        break;
+      default:
+        // Operators, pipes, semicolons, backticks, negative numbers, ... all land here
+        return false;
+    }
+    p++;
+  }
+  tokens_.emplace_back(Token{TokenKind::kEnd, "", 0});
+  return true;
+}
+
+const FastParser::Token &FastParser::peek(size_t ahead) const {
+  size_t idx = pos_ + ahead;
+  if (idx >= tokens_.size()) {
+    return tokens_.back();  // kEnd sentinel
+  }
+  return tokens_[idx];
+}
+
+bool FastParser::isKeyword(const Token &tok, const char *kw) const {
+  if (tok.kind != TokenKind::kLabel) {
+    return false;
+  }
+  const char *t = tok.text.data();
+  size_t n = tok.text.size();
+  for (size_t i = 0; i < n; i++) {
+    if (kw[i] == '\0' || std::tolower(t[i]) != kw[i]) {
+      return false;
+    }
+  }
+  return kw[n] == '\0';
+}
+
+bool FastParser::acceptKeyword(const char *kw) {
+  if (!isKeyword(peek(), kw)) {
+    return false;
+  }
+  advance();
+  return true;
+}
+
+// GO [<m> [TO <n>] STEPS] FROM <vids> OVER <edges>|* [REVERSELY|BIDIRECT]
+//    [YIELD [DISTINCT] <cols>]
+// WHERE / SAMPLE / LIMIT clauses are not in the subset and fall back to bison.
+Sentence *FastParser::parseGo() {
+  StepClause *step = nullptr;
+  if (peek().kind == TokenKind::kInt) {
+    auto m = peek().ival;
+    advance();
+    if (acceptKeyword("to")) {
+      if (peek().kind != TokenKind::kInt) {
+        return nullptr;
+      }
+      auto n = peek().ival;
+      advance();
+      if (!acceptKeyword("steps")) {
+        return nullptr;
+      }
+      step = new StepClause(m, n);
+    } else if (acceptKeyword("steps")) {
+      step = new StepClause(m);
+    } else {
+      return nullptr;
+    }
+  } else {
+    step = new StepClause();
+  }
+  std::unique_ptr<StepClause> stepGuard(step);
+
+  if (!acceptKeyword("from")) {
+    return nullptr;
+  }
+  auto *vids = parseVidList();
+  if (vids == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<FromClause> from(new FromClause(vids));
+
+  auto *over = parseOverClause();
+  if (over == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<OverClause> overGuard(over);
+
+  bool ok = true;
+  auto *yield = parseYieldClause(&ok);
+  if (!ok) {
+    return nullptr;
+  }
+
+  auto *go = new GoSentence(
+      stepGuard.release(), from.release(), overGuard.release(), nullptr, nullptr);
+  go->setYieldClause(yield);
+  return go;
+}
+
+// FETCH PROP ON <tags>|* <vids> [YIELD [DISTINCT] <cols>]
+// Edge fetches contain `->' which the tokenizer refuses, so only vertices get here.
+Sentence *FastParser::parseFetchVertices() {
+  if (!acceptKeyword("prop") || !acceptKeyword("on")) {
+    return nullptr;
+  }
+  std::unique_ptr<NameLabelList> tags;
+  if (peek().kind == TokenKind::kStar) {
+    advance();
+  } else {
+    tags = std::make_unique<NameLabelList>();
+    while (true) {
+      if (peek().kind != TokenKind::kLabel) {
+        return nullptr;
+      }
+      tags->add(new std::string(peek().text));
+      advance();
+      if (peek().kind != TokenKind::kComma) {
+        break;
+      }
+      advance();
+    }
+  }
+  auto *vids = parseVidList();
+  if (vids == nullptr) {
+    return nullptr;
+  }
+  std::unique_ptr<VertexIDList> vidGuard(vids);
+
+  bool ok = true;
+  auto *yield = parseYieldClause(&ok);
+  if (!ok) {
+    return nullptr;
+  }
+  if (tags != nullptr) {
+    return new FetchVerticesSentence(tags.release(), vidGuard.release(), yield);
+  }
+  return new FetchVerticesSentence(vidGuard.release(), yield);
+}
+
+VertexIDList *FastParser::parseVidList() {
+  auto *pool = qctx_->objPool();
+  auto vids = std::make_unique<VertexIDList>();
+  while (true) {
+    if (peek().kind == TokenKind::kString) {
+      vids->add(ConstantExpression::make(pool, peek().text));
+    } else if (peek().kind == TokenKind::kInt) {
+      vids->add(ConstantExpression::make(pool, peek().ival));
+    } else {
+      return nullptr;  // Function vids (uuid, hash) fall back to bison
+    }
+    advance();
+    if (peek().kind != TokenKind::kComma) {
+      break;
+    }
+    advance();
+  }
+  return vids.release();
+}
+
+OverClause *FastParser::parseOverClause() {
+  if (!acceptKeyword("over")) {
+    return nullptr;
+  }
+  bool overAll = false;
+  std::unique_ptr<OverEdges> edges;
+  if (peek().kind == TokenKind::kStar) {
+    overAll = true;
+    advance();
+  } else {
+    edges = std::make_unique<OverEdges>();
+    while (true) {
+      auto &tok = peek();
+      if (tok.kind != TokenKind::kLabel || isKeyword(tok, "reversely") ||
+          isKeyword(tok, "bidirect") || isKeyword(tok, "yield")) {
+        return nullptr;
+      }
+      edges->addEdge(new OverEdge(new std::string(tok.text)));
+      advance();
+      if (peek().kind != TokenKind::kComma) {
+        break;
+      }
+      advance();
+    }
+  }
+  auto direction = storage::cpp2::EdgeDirection::OUT_EDGE;
+  if (acceptKeyword("reversely")) {
+    direction = storage::cpp2::EdgeDirection::IN_EDGE;
+  } else if (acceptKeyword("bidirect")) {
+    direction = storage::cpp2::EdgeDirection::BOTH;
+  }
+  if (overAll) {
+    return new OverClause(true, direction);
+  }
+  return new OverClause(edges.release(), direction);
+}
+
+YieldClause *FastParser::parseYieldClause(bool *ok) {
+  *ok = true;
+  if (!acceptKeyword("yield")) {
+    if (peek().kind != TokenKind::kEnd) {
+      *ok = false;  // Some other clause (WHERE, SAMPLE, ...) we do not recognize
+    }
+    return nullptr;  // Empty yield, same as bison's %empty rule
+  }
+  bool distinct = acceptKeyword("distinct");
+  auto columns = std::make_unique<YieldColumns>();
+  while (true) {
+    auto *column = parseYieldColumn();
+    if (column == nullptr) {
+      *ok = false;
+      return nullptr;
+    }
+    columns->addColumn(column);
+    if (peek().kind != TokenKind::kComma) {
+      break;
+    }
+    advance();
+  }
+  return new YieldClause(columns.release(), distinct);
+}
+
+YieldColumn *FastParser::parseYieldColumn() {
+  auto *expr = parseYieldExpression();
+  if (expr == nullptr) {
+    return nullptr;
+  }
+  std::string alias;
+  if (acceptKeyword("as")) {
+    if (peek().kind != TokenKind::kLabel) {
+      return nullptr;
+    }
+    alias = peek().text;
+    advance();
+  }
+  return new YieldColumn(expr, alias);
+}
+
+Expression *FastParser::parseYieldExpression() {
+  auto *pool = qctx_->objPool();
+  auto &tok = peek();
+  // $^.tag.prop / $$.tag.prop
+  if (tok.kind == TokenKind::kSrcRef || tok.kind == TokenKind::kDstRef) {
+    bool isSrc = tok.kind == TokenKind::kSrcRef;
+    advance();
+    if (peek().kind != TokenKind::kDot || peek(1).kind != TokenKind::kLabel ||
+        peek(2).kind != TokenKind::kDot || peek(3).kind != TokenKind::kLabel) {
+      // A bare `$^' / `$$' is only legal with an alias, where bison builds a vertex
+      // expression named after the ref
+      if (isKeyword(peek(), "as")) {
+        return VertexExpression::make(pool, isSrc ? "$^" : "$$");
+      }
+      return nullptr;
+    }
+    auto tag = peek(1).text;
+    auto prop = peek(3).text;
+    advance();
+    advance();
+    advance();
+    advance();
+    if (isSrc) {
+      return SourcePropertyExpression::make(pool, tag, prop);
+    }
+    return DestPropertyExpression::make(pool, tag, prop);
+  }
+  if (tok.kind == TokenKind::kString) {
+    auto *expr = ConstantExpression::make(pool, tok.text);
+    advance();
+    return expr;
+  }
+  if (tok.kind == TokenKind::kInt) {
+    auto *expr = ConstantExpression::make(pool, tok.ival);
+    advance();
+    return expr;
+  }
+  if (tok.kind != TokenKind::kLabel || isKeyword(tok, "as") || isKeyword(tok, "distinct")) {
+    return nullptr;
+  }
+  // `vertex'/`edge' are reserved words, bison builds dedicated expressions for them and
+  // demands an alias
+  if (isKeyword(tok, "vertex") || isKeyword(tok, "edge")) {
+    if (!isKeyword(peek(1), "as")) {
+      return nullptr;
+    }
+    Expression *expr = isKeyword(tok, "vertex")
+                           ? static_cast<Expression *>(VertexExpression::make(pool))
+                           : static_cast<Expression *>(EdgeExpression::make(pool));
+    advance();
+    return expr;
+  }
+  if (isKeyword(tok, "vertices") || isKeyword(tok, "edges") || isKeyword(tok, "path")) {
+    return nullptr;
+  }
+  auto name = tok.text;
+  advance();
+  // func(args)[.attribute]
+  if (peek().kind == TokenKind::kLParen) {
+    advance();
+    bool ok = true;
+    auto *args = parseArgumentList(&ok);
+    if (!ok || peek().kind != TokenKind::kRParen) {
+      return nullptr;
+    }
+    advance();
+    // Mirror the parse-time checks of the bison grammar: aggregates are rejected in
+    // these yield clauses and unknown functions are a syntax error there
+    if (AggFunctionManager::find(name).ok() || !FunctionManager::find(name, args->numArgs()).ok()) {
+      return nullptr;
+    }
+    // The temporal constructors are keywords in the bison grammar and always come out
+    // with their canonical lowercase name
+    for (const char *kw : {"timestamp", "date", "time", "datetime"}) {
+      if (isKeyword(tok, kw)) {
+        name = kw;
+        break;
+      }
+    }
+    Expression *call = FunctionCallExpression::make(pool, name, args);
+    if (peek().kind == TokenKind::kDot) {
+      if (peek(1).kind != TokenKind::kLabel) {
+        return nullptr;
+      }
+      call = AttributeExpression::make(
+          pool, call, ConstantExpression::make(pool, peek(1).text));
+      advance();
+      advance();
+    }
+    return call;
+  }
+  // label.prop, the way bison parses edge/tag property references in yield
+  if (peek().kind == TokenKind::kDot) {
+    if (peek(1).kind != TokenKind::kLabel) {
+      return nullptr;
+    }
+    auto *expr = LabelAttributeExpression::make(
+        pool, LabelExpression::make(pool, name), ConstantExpression::make(pool, peek(1).text));
+    advance();
+    advance();
+    return expr;
+  }
+  return LabelExpression::make(pool, name);
+}
+
+ArgumentList *FastParser::parseArgumentList(bool *ok) {
+  auto *pool = qctx_->objPool();
+  auto *args = ArgumentList::make(pool);
+  *ok = true;
+  if (peek().kind == TokenKind::kRParen) {
+    return args;  // Empty argument list, e.g. now()
+  }
+  while (true) {
+    auto &tok = peek();
+    Expression *arg = nullptr;
+    if (tok.kind == TokenKind::kSrcRef) {
+      arg = VertexExpression::make(pool, "$^");
+    } else if (tok.kind == TokenKind::kDstRef) {
+      arg = VertexExpression::make(pool, "$$");
+    } else if (isKeyword(tok, "vertex")) {
+      arg = VertexExpression::make(pool);
+    } else if (isKeyword(tok, "edge")) {
+      arg = EdgeExpression::make(pool);
+    } else if (tok.kind == TokenKind::kString) {
+      arg = ConstantExpression::make(pool, tok.text);
+    } else if (tok.kind == TokenKind::kInt) {
+      arg = ConstantExpression::make(pool, tok.ival);
+    } else {
+      *ok = false;  // Nested calls and label args need the full expression grammar
+      return args;
+    }
+    args->addArgument(arg);
+    advance();
+    if (peek().kind != TokenKind::kComma) {
+      break;
+    }
+    advance();
+  }
+  return args;
+}
+
+}  // namespace nebula
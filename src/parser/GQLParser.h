@@ -7,16 +7,18 @@
 
 #include "common/base/Base.h"
 #include "common/base/StatusOr.h"
+#include "parser/FastParser.h"
 #include "parser/GraphParser.hpp"
 #include "parser/GraphScanner.h"
 
 DECLARE_uint32(max_allowed_query_size);
+DECLARE_bool(enable_fast_parser);
 namespace nebula {
 
 class GQLParser {
  public:
   explicit GQLParser(nebula::graph::QueryContext *qctx = nullptr)
-      : parser_(scanner_, error_, &sentences_, qctx) {
+      : qctx_(qctx), parser_(scanner_, error_, &sentences_, qctx) {
     // Callback invoked by GraphScanner
     auto readBuffer = [this](char *buf, int maxSize) -> int {
       // Reach the end
@@ -45,6 +47,13 @@ class GQLParser {
     if (querySize > maxAllowedQuerySize) {
       return Status::SyntaxError("Query is too large (%ld > %ld).", querySize, maxAllowedQuerySize);
     }
+    if (FLAGS_enable_fast_parser) {
+      auto *fast = FastParser::tryParse(query, qctx_);
+      if (fast != nullptr) {
+        usedFastPath_ = true;
+        return std::unique_ptr<Sentence>(fast);
+      }
+    }
     buffer_ = std::move(query);
     pos_ = &buffer_[0];
     end_ = pos_ + buffer_.size();
@@ -72,7 +81,15 @@ class GQLParser {
     return std::unique_ptr<Sentence>(sentences);
   }
 
+  // Whether the last parse() was answered by the fast-path recognizer, so callers can
+  // track the hit rate
+  bool usedFastPath() const {
+    return usedFastPath_;
+  }
+
  private:
+  nebula::graph::QueryContext *qctx_{nullptr};
+  bool usedFastPath_{false};
   std::string buffer_;
   const char *pos_{nullptr};
   const char *end_{nullptr};
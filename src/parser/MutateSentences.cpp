@@ -204,7 +204,11 @@ std::string UpdateVertexSentence::toString() const {
   if (name_ != nullptr) {
     buf += "ON " + *name_ + " ";
   }
-  buf += vid_->toString();
+  if (vidList_ != nullptr) {
+    buf += vidList_->toString();
+  } else {
+    buf += vid_->toString();
+  }
   buf += " SET ";
   buf += updateList_->toString();
   if (whenClause_ != nullptr) {
@@ -417,7 +417,8 @@ class UpdateBaseSentence : public Sentence {
 
 class UpdateVertexSentence final : public UpdateBaseSentence {
  public:
-  UpdateVertexSentence(Expression *vid,
+  // The ON form accepts a list of vids sharing one SET clause, the batch UPSERT syntax
+  UpdateVertexSentence(VertexIDList *vidList,
                        std::string *tagName,
                        UpdateList *updateList,
                        WhenClause *whenClause,
@@ -425,7 +426,7 @@ class UpdateVertexSentence final : public UpdateBaseSentence {
                        bool isInsertable = false)
       : UpdateBaseSentence(updateList, whenClause, yieldClause, tagName, isInsertable) {
     kind_ = Kind::kUpdateVertex;
-    vid_ = vid;
+    vidList_.reset(vidList);
   }
 
   UpdateVertexSentence(Expression *vid,
@@ -448,6 +449,11 @@ class UpdateVertexSentence final : public UpdateBaseSentence {
     return vid_;
   }
 
+  // Non-null only for the ON form, see getVid() for the 1.0-compatible forms
+  const VertexIDList *vidList() const {
+    return vidList_.get();
+  }
+
   const UpdateList *updateList() const {
     return updateList_.get();
   }
@@ -464,6 +470,7 @@ class UpdateVertexSentence final : public UpdateBaseSentence {
 
  private:
   Expression *vid_{nullptr};
+  std::unique_ptr<VertexIDList> vidList_;
 };
 
 class UpdateEdgeSentence final : public UpdateBaseSentence {
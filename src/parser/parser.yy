@@ -203,7 +203,7 @@ using namespace nebula;
 %token KW_UNWIND KW_SKIP KW_OPTIONAL
 %token KW_CASE KW_THEN KW_ELSE KW_END
 %token KW_GROUP KW_ZONE KW_GROUPS KW_ZONES KW_INTO KW_NEW
-%token KW_LISTENER KW_ELASTICSEARCH KW_FULLTEXT KW_HTTPS KW_HTTP
+%token KW_LISTENER KW_ELASTICSEARCH KW_CDC KW_FULLTEXT KW_HTTPS KW_HTTP
 %token KW_AUTO KW_ES_QUERY KW_ANALYZER
 %token KW_TEXT KW_SEARCH KW_CLIENTS KW_SIGN KW_SERVICE KW_TEXT_SEARCH
 %token KW_ANY KW_SINGLE KW_NONE
@@ -544,6 +544,7 @@ unreserved_keyword
     | KW_ZONES              { $$ = new std::string("zones"); }
     | KW_LISTENER           { $$ = new std::string("listener"); }
     | KW_ELASTICSEARCH      { $$ = new std::string("elasticsearch"); }
+    | KW_CDC                { $$ = new std::string("cdc"); }
     | KW_FULLTEXT           { $$ = new std::string("fulltext"); }
     | KW_STATS              { $$ = new std::string("stats"); }
     | KW_STATUS             { $$ = new std::string("status"); }
@@ -3184,11 +3185,11 @@ update_vertex_sentence
         $$ = sentence;
     }
      // ======== End: Compatible with 1.0 =========
-    | KW_UPDATE KW_VERTEX KW_ON name_label vid KW_SET update_list when_clause yield_clause {
+    | KW_UPDATE KW_VERTEX KW_ON name_label vid_list KW_SET update_list when_clause yield_clause {
         auto sentence = new UpdateVertexSentence($5, $4, $7, $8, $9);
         $$ = sentence;
     }
-    | KW_UPSERT KW_VERTEX KW_ON name_label vid KW_SET update_list when_clause yield_clause {
+    | KW_UPSERT KW_VERTEX KW_ON name_label vid_list KW_SET update_list when_clause yield_clause {
         auto sentence = new UpdateVertexSentence($5, $4, $7, $8, $9, true);
         $$ = sentence;
     }
@@ -3856,12 +3857,18 @@ add_listener_sentence
     : KW_ADD KW_LISTENER KW_ELASTICSEARCH host_list {
         $$ = new AddListenerSentence(meta::cpp2::ListenerType::ELASTICSEARCH, $4);
     }
+    | KW_ADD KW_LISTENER KW_CDC host_list {
+        $$ = new AddListenerSentence(meta::cpp2::ListenerType::CDC, $4);
+    }
     ;
 
 remove_listener_sentence
     : KW_REMOVE KW_LISTENER KW_ELASTICSEARCH {
         $$ = new RemoveListenerSentence(meta::cpp2::ListenerType::ELASTICSEARCH);
     }
+    | KW_REMOVE KW_LISTENER KW_CDC {
+        $$ = new RemoveListenerSentence(meta::cpp2::ListenerType::CDC);
+    }
     ;
 
 list_listener_sentence
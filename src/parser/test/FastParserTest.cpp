@@ -0,0 +1,94 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <gtest/gtest.h>
+
+#include "common/base/Base.h"
+#include "graph/context/QueryContext.h"
+#include "parser/FastParser.h"
+#include "parser/GQLParser.h"
+
+namespace nebula {
+
+using graph::QueryContext;
+
+class FastParserTest : public ::testing::Test {
+ public:
+  void SetUp() override {
+    qctx_ = std::make_unique<QueryContext>();
+  }
+  void TearDown() override {
+    qctx_.reset();
+  }
+
+ protected:
+  // The fast path must produce exactly the tree bison produces, compared through the
+  // canonical toString() form
+  void expectSameAsBison(const std::string &query) {
+    std::unique_ptr<Sentence> fast(FastParser::tryParse(query, qctx_.get()));
+    ASSERT_NE(fast, nullptr) << query;
+    GQLParser parser(qctx_.get());
+    auto result = parser.parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+    EXPECT_EQ(fast->toString(), result.value()->toString()) << query;
+  }
+
+  void expectFallback(const std::string &query) {
+    std::unique_ptr<Sentence> fast(FastParser::tryParse(query, qctx_.get()));
+    EXPECT_EQ(fast, nullptr) << query;
+  }
+
+ protected:
+  std::unique_ptr<QueryContext> qctx_;
+};
+
+TEST_F(FastParserTest, Go) {
+  expectSameAsBison("GO FROM \"Tim\" OVER like YIELD dst(edge) AS d");
+  expectSameAsBison("go from \"a\", \"b\" over like, serve yield src(edge), rank(edge)");
+  expectSameAsBison("GO 2 STEPS FROM 100, 101 OVER like REVERSELY YIELD $$.player.name AS name");
+  expectSameAsBison("GO 1 TO 3 STEPS FROM \"a\" OVER * BIDIRECT YIELD DISTINCT id($$) AS dst");
+  expectSameAsBison(
+      "GO FROM \"Tim\" OVER like YIELD $^.player.age, like.likeness, properties(edge).likeness");
+  expectSameAsBison("GO FROM \"Tim\" OVER serve YIELD edge AS e, $$ AS dst");
+}
+
+TEST_F(FastParserTest, FetchProp) {
+  expectSameAsBison("FETCH PROP ON player \"Tim\" YIELD player.name AS name");
+  expectSameAsBison("FETCH PROP ON player, team \"a\", \"b\" YIELD vertex AS v");
+  expectSameAsBison("FETCH PROP ON * 100, 101 YIELD properties(vertex).name");
+  expectSameAsBison("fetch prop on player \"Tim\" yield distinct id(vertex) as vid");
+}
+
+TEST_F(FastParserTest, Fallback) {
+  // Anything outside the recognized subset must give up so bison stays authoritative
+  expectFallback("GO FROM \"a\" OVER like WHERE like.likeness > 0 YIELD dst(edge)");
+  expectFallback("GO FROM \"a\" OVER like YIELD dst(edge) | LIMIT 10");
+  expectFallback("GO FROM \"a\" OVER like YIELD dst(edge); YIELD 1");
+  expectFallback("GO FROM $-.id OVER like YIELD dst(edge)");
+  expectFallback("GO FROM \"a\\\"b\" OVER like YIELD dst(edge)");
+  expectFallback("GO FROM \"a\" OVER like YIELD like.likeness + 1");
+  expectFallback("GO FROM \"a\" OVER like YIELD count(*)");
+  expectFallback("GO FROM \"a\" OVER like YIELD noSuchFunction(edge)");
+  expectFallback("FETCH PROP ON like \"a\"->\"b\" YIELD like.likeness");
+  expectFallback("MATCH (v:player) RETURN v");
+  expectFallback("INSERT VERTEX player(name, age) VALUES \"Tim\":(\"Tim\", 42)");
+  expectFallback("SHOW HOSTS");
+}
+
+TEST_F(FastParserTest, GQLParserIntegration) {
+  FLAGS_enable_fast_parser = true;
+  GQLParser parser(qctx_.get());
+  auto result = parser.parse("GO FROM \"Tim\" OVER like YIELD dst(edge) AS d");
+  ASSERT_TRUE(result.ok()) << result.status();
+  EXPECT_TRUE(parser.usedFastPath());
+
+  GQLParser slowParser(qctx_.get());
+  auto slow = slowParser.parse("SHOW HOSTS");
+  ASSERT_TRUE(slow.ok()) << slow.status();
+  EXPECT_FALSE(slowParser.usedFastPath());
+  FLAGS_enable_fast_parser = false;
+}
+
+}  // namespace nebula
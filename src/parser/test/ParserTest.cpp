@@ -982,6 +982,19 @@ TEST_F(ParserTest, UpdateVertex) {
     auto result = parse(query);
     ASSERT_TRUE(result.ok()) << result.status();
   }
+  {
+    // Batch form: several vids sharing one SET clause
+    std::string query =
+        "UPSERT VERTEX ON person \"12345\", \"23456\", \"34567\" "
+        "SET name=\"Tom\", age = 30";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    std::string query = "UPDATE VERTEX ON person \"12345\", \"23456\" SET age = age + 1";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
 }
 
 TEST_F(ParserTest, InsertEdge) {
@@ -2961,6 +2974,16 @@ TEST_F(ParserTest, FullTextServiceTest) {
     auto result = parse(query);
     ASSERT_TRUE(result.ok()) << result.status();
   }
+  {
+    std::string query = "ADD LISTENER CDC 127.0.0.1:12000";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
+  {
+    std::string query = "REMOVE LISTENER CDC";
+    auto result = parse(query);
+    ASSERT_TRUE(result.ok()) << result.status();
+  }
   {
     std::string query = "SHOW LISTENER";
     auto result = parse(query);
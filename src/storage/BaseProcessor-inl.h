@@ -111,10 +111,14 @@ template <typename RESP>
 void BaseProcessor<RESP>::doPut(GraphSpaceID spaceId,
                                 PartitionID partId,
                                 std::vector<kvstore::KV>&& data) {
-  this->env_->kvstore_->asyncMultiPut(
-      spaceId, partId, std::move(data), [spaceId, partId, this](nebula::cpp2::ErrorCode code) {
-        handleAsync(spaceId, partId, code);
-      });
+  auto cb = [spaceId, partId, this](nebula::cpp2::ErrorCode code) {
+    handleAsync(spaceId, partId, code);
+  };
+  if (this->env_->writeCoalescer_ != nullptr) {
+    this->env_->writeCoalescer_->asyncMultiPut(spaceId, partId, std::move(data), std::move(cb));
+    return;
+  }
+  this->env_->kvstore_->asyncMultiPut(spaceId, partId, std::move(data), std::move(cb));
 }
 
 template <typename RESP>
@@ -143,6 +147,37 @@ StatusOr<std::string> BaseProcessor<RESP>::encodeRowVal(const meta::NebulaSchema
                                                         const std::vector<std::string>& propNames,
                                                         const std::vector<Value>& props,
                                                         WriteResult& wRet) {
+  // Fast path: schemas made of fixed-width scalars only take a compiled template which
+  // memcpys every field at a precomputed offset. Compiled once per schema per request,
+  // any row the template cannot take falls through to the generic writer below, so the
+  // returned errors are always the generic writer's.
+  auto it = rowTemplates_.find(schema);
+  if (it == rowTemplates_.end()) {
+    CompiledRowTemplate entry;
+    entry.tmpl = RowWriterTemplate::make(schema);
+    it = rowTemplates_.emplace(schema, std::move(entry)).first;
+  }
+  auto& entry = it->second;
+  if (entry.tmpl != nullptr) {
+    std::string encoded;
+    if (propNames.empty()) {
+      if (entry.tmpl->encode(props, &encoded) == WriteResult::SUCCEEDED) {
+        wRet = WriteResult::SUCCEEDED;
+        return encoded;
+      }
+    } else {
+      if (propNames != entry.propNames) {
+        entry.propNames = propNames;
+        entry.mappingOk = entry.tmpl->makeFieldMapping(propNames, &entry.mapping);
+      }
+      if (entry.mappingOk &&
+          entry.tmpl->encode(entry.mapping, props, &encoded) == WriteResult::SUCCEEDED) {
+        wRet = WriteResult::SUCCEEDED;
+        return encoded;
+      }
+    }
+  }
+
   RowWriterV2 rowWrite(schema);
   // If req.prop_names is not empty, use the property name in req.prop_names
   // Otherwise, use property name in schema
@@ -12,8 +12,10 @@
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
 #include "codec/RowReaderWrapper.h"
+#include "codec/RowWriterTemplate.h"
 #include "codec/RowWriterV2.h"
 #include "common/base/Base.h"
+#include "common/base/ObjectPool.h"
 #include "common/stats/StatsManager.h"
 #include "common/time/Duration.h"
 #include "common/utils/IndexKeyUtils.h"
@@ -57,6 +59,9 @@ class BaseProcessor {
 
     if (counters_) {
       stats::StatsManager::addValue(counters_->latency_, this->duration_.elapsedInUSec());
+      if (counters_->latencyDist_ != nullptr) {
+        counters_->latencyDist_->record(this->duration_.elapsedInUSec());
+      }
     }
 
     delete this;
@@ -164,6 +169,22 @@ class BaseProcessor {
   std::mutex profileMut_;
   bool profileDetailFlag_{false};
   bool memoryExceeded_{false};
+
+  // Compiled fixed-width encode templates, keyed by schema and living for this request
+  // only, so schema pointers can never dangle. tmpl is nullptr when the schema does not
+  // qualify, mapping caches the propNames -> field index resolution across rows.
+  struct CompiledRowTemplate {
+    std::unique_ptr<RowWriterTemplate> tmpl;
+    std::vector<std::string> propNames;
+    std::vector<size_t> mapping;
+    bool mappingOk{false};
+  };
+  std::unordered_map<const meta::NebulaSchemaProvider*, CompiledRowTemplate> rowTemplates_;
+
+  // Request-scoped arena-backed pool. Per-request objects like plan contexts go in here
+  // instead of being heap-allocated one by one, and are released wholesale when the
+  // processor deletes itself at the end of onFinished/onError.
+  ObjectPool requestPool_;
 };
 
 /// Helper class wrap the passed in Func in a MemoryTracker turned on scope.
@@ -5,6 +5,7 @@
 
 #include "storage/CommonUtils.h"
 
+#include "kvstore/Part.h"
 #include "storage/exec/QueryUtils.h"
 
 DEFINE_bool(ttl_use_ms,
@@ -14,6 +15,74 @@ DEFINE_bool(ttl_use_ms,
 namespace nebula {
 namespace storage {
 
+std::shared_ptr<ActivePlanTracker::PlanEntry> ActivePlanTracker::enter(SessionID sessionId,
+                                                                       ExecutionPlanID planId) {
+  std::lock_guard<std::mutex> lg(lock_);
+  auto& entry = plans_[std::make_pair(sessionId, planId)];
+  if (entry == nullptr) {
+    entry = std::make_shared<PlanEntry>();
+    entry->sessionId_ = sessionId;
+    entry->planId_ = planId;
+    entry->startTimeUs_ = time::WallClock::fastNowInMicroSec();
+  }
+  entry->inflightRequests_.fetch_add(1, std::memory_order_relaxed);
+  return entry;
+}
+
+void ActivePlanTracker::leave(const std::shared_ptr<PlanEntry>& entry) {
+  if (entry->inflightRequests_.fetch_sub(1, std::memory_order_acq_rel) > 1) {
+    return;
+  }
+  std::lock_guard<std::mutex> lg(lock_);
+  auto iter = plans_.find(std::make_pair(entry->sessionId_, entry->planId_));
+  // The map may already hold a fresh entry if another request of the plan arrived after the
+  // counter hit zero, only erase our own
+  if (iter != plans_.end() && iter->second == entry &&
+      entry->inflightRequests_.load(std::memory_order_acquire) == 0) {
+    VLOG(1) << "Plan " << entry->planId_ << " of session " << entry->sessionId_ << " done, scanned "
+            << entry->scannedKeys_.load(std::memory_order_relaxed) << " keys in "
+            << entry->execTimeUs_.load(std::memory_order_relaxed) << " us";
+    plans_.erase(iter);
+  }
+}
+
+bool ActivePlanTracker::kill(SessionID sessionId, ExecutionPlanID planId) {
+  std::lock_guard<std::mutex> lg(lock_);
+  auto iter = plans_.find(std::make_pair(sessionId, planId));
+  if (iter == plans_.end()) {
+    return false;
+  }
+  iter->second->killed_.store(true, std::memory_order_relaxed);
+  return true;
+}
+
+PlanContext::~PlanContext() {
+  for (const auto& [partId, snapshot] : partSnapshots_) {
+    env_->kvstore_->ReleaseSnapshot(spaceId_, partId, snapshot);
+  }
+  if (planEntry_ != nullptr) {
+    planEntry_->execTimeUs_.fetch_add(time::WallClock::fastNowInMicroSec() - createTimeUs_,
+                                      std::memory_order_relaxed);
+    env_->planTracker_->leave(planEntry_);
+  }
+}
+
+const void* PlanContext::snapshot(PartitionID partId) {
+  if (!readSnapshot_) {
+    return nullptr;
+  }
+  std::lock_guard<std::mutex> lg(snapshotLock_);
+  auto it = partSnapshots_.find(partId);
+  if (it != partSnapshots_.end()) {
+    return it->second;
+  }
+  auto* snapshot = env_->kvstore_->GetSnapshot(spaceId_, partId);
+  if (snapshot != nullptr) {
+    partSnapshots_.emplace(partId, snapshot);
+  }
+  return snapshot;
+}
+
 bool CommonUtils::checkDataExpiredForTTL(const meta::NebulaSchemaProvider* schema,
                                          RowReaderWrapper* reader,
                                          const std::string& ttlCol,
@@ -81,5 +150,118 @@ StatusOr<Value> CommonUtils::ttlValue(const meta::NebulaSchemaProvider* schema,
   return reader->getValueByName(std::move(ttlProp).second.second);
 }
 
+std::string CommonUtils::edgeListCacheKey(GraphSpaceID spaceId,
+                                          const VertexID& vId,
+                                          EdgeType edgeType,
+                                          SchemaVer ver) {
+  std::string key;
+  key.reserve(sizeof(GraphSpaceID) + sizeof(EdgeType) + sizeof(SchemaVer) + vId.size());
+  key.append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID))
+      .append(reinterpret_cast<const char*>(&edgeType), sizeof(EdgeType))
+      .append(reinterpret_cast<const char*>(&ver), sizeof(SchemaVer))
+      .append(vId);
+  return key;
+}
+
+void CommonUtils::invalidateEdgeListCache(StorageEnv* env,
+                                          GraphSpaceID spaceId,
+                                          const cpp2::EdgeKey& edgeKey) {
+  if (env->edgeListCache_ == nullptr) {
+    return;
+  }
+  auto edgeType = *edgeKey.edge_type_ref();
+  auto ver = env->schemaMan_->getLatestEdgeSchemaVersion(spaceId, std::abs(edgeType));
+  if (!ver.ok()) {
+    return;
+  }
+  // The stored edge key hangs off src for out-edges and off dst for in-edges, but the request
+  // always carries the stored direction, so src names the vertex the block is cached under.
+  // Blocks of stale schema versions are unreachable by readers and just age out.
+  env->edgeListCache_->evict(
+      edgeListCacheKey(spaceId, edgeKey.src_ref()->getStr(), edgeType, ver.value()));
+}
+
+void CommonUtils::invalidateEdgeListCacheOnApply(StorageEnv* env,
+                                                 GraphSpaceID spaceId,
+                                                 int32_t vIdLen,
+                                                 folly::StringPiece rawKey) {
+  if (env->edgeListCache_ == nullptr) {
+    return;
+  }
+  auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen, rawKey);
+  auto ver = env->schemaMan_->getLatestEdgeSchemaVersion(spaceId, std::abs(edgeType));
+  if (!ver.ok()) {
+    return;
+  }
+  // The stored key pads string vids up to vIdLen with '\0', but the cache key carries the
+  // graph level vid, so strip the padding. Int vids keep their raw 8 bytes.
+  auto src = NebulaKeyUtils::getSrcId(vIdLen, rawKey);
+  auto vidType = env->schemaMan_->getSpaceVidType(spaceId);
+  VertexID vId;
+  if (vidType.ok() && vidType.value() == nebula::cpp2::PropertyType::INT64) {
+    vId = src.str();
+  } else {
+    vId = src.subpiece(0, src.find_first_of('\0')).toString();
+  }
+  env->edgeListCache_->evict(edgeListCacheKey(spaceId, vId, edgeType, ver.value()));
+}
+
+std::string CommonUtils::vertexAbsenceCacheKey(GraphSpaceID spaceId, folly::StringPiece tagKey) {
+  std::string key;
+  key.reserve(sizeof(GraphSpaceID) + tagKey.size());
+  key.append(reinterpret_cast<const char*>(&spaceId), sizeof(GraphSpaceID))
+      .append(tagKey.data(), tagKey.size());
+  return key;
+}
+
+void CommonUtils::invalidateVertexAbsenceCache(StorageEnv* env,
+                                               GraphSpaceID spaceId,
+                                               folly::StringPiece tagKey) {
+  if (env->vertexAbsenceCache_ == nullptr) {
+    return;
+  }
+  env->vertexAbsenceCache_->evict(vertexAbsenceCacheKey(spaceId, tagKey));
+}
+
+nebula::cpp2::ErrorCode CommonUtils::checkScanCursor(StorageEnv* env,
+                                                     GraphSpaceID spaceId,
+                                                     PartitionID partId,
+                                                     const cpp2::ScanCursor& cursor) {
+  if (!cursor.next_cursor_ref().has_value() || cursor.next_cursor_ref()->empty()) {
+    // A fresh scan, nothing to validate
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  if (cursor.part_id_ref().has_value() && *cursor.part_id_ref() != partId) {
+    LOG(ERROR) << "Scan cursor of part " << *cursor.part_id_ref() << " sent to part " << partId;
+    return nebula::cpp2::ErrorCode::E_INVALID_OPERATION;
+  }
+  if (cursor.snapshot_seq_ref().has_value()) {
+    auto partRet = env->kvstore_->part(spaceId, partId);
+    if (!nebula::ok(partRet)) {
+      return nebula::error(partRet);
+    }
+    auto committedLogId = nebula::value(partRet)->lastCommittedLogId().first;
+    if (committedLogId < *cursor.snapshot_seq_ref()) {
+      // This replica lags behind the one that produced the cursor, resuming here would let
+      // the client observe the part rewinding. Have the client re-route and retry.
+      VLOG(1) << "Part " << partId << " committed " << committedLogId
+              << " but the scan cursor was produced at " << *cursor.snapshot_seq_ref();
+      return nebula::cpp2::ErrorCode::E_LEADER_CHANGED;
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+void CommonUtils::fillScanCursor(StorageEnv* env,
+                                 GraphSpaceID spaceId,
+                                 PartitionID partId,
+                                 cpp2::ScanCursor& cursor) {
+  cursor.part_id_ref() = partId;
+  auto partRet = env->kvstore_->part(spaceId, partId);
+  if (nebula::ok(partRet)) {
+    cursor.snapshot_seq_ref() = nebula::value(partRet)->lastCommittedLogId().first;
+  }
+}
+
 }  // namespace storage
 }  // namespace nebula
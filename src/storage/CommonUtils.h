@@ -14,10 +14,13 @@
 #include "common/meta/IndexManager.h"
 #include "common/meta/SchemaManager.h"
 #include "common/stats/StatsManager.h"
+#include "common/time/WallClock.h"
 #include "common/utils/MemoryLockWrapper.h"
 #include "interface/gen-cpp2/storage_types.h"
 #include "kvstore/KVEngine.h"
 #include "kvstore/KVStore.h"
+#include "storage/NumaReaderPool.h"
+#include "storage/WriteCoalescer.h"
 
 namespace nebula {
 namespace storage {
@@ -26,6 +29,9 @@ struct ProcessorCounters {
   stats::CounterId numCalls_;
   stats::CounterId numErrors_;
   stats::CounterId latency_;
+  // HDR distribution of the same latency, sharp below 1ms where the 1000us buckets of
+  // latency_ can't tell a 300us point read from a 900us one
+  stats::HdrHistogram* latencyDist_{nullptr};
 
   virtual ~ProcessorCounters() = default;
 
@@ -36,6 +42,8 @@ struct ProcessorCounters {
           stats::StatsManager::registerStats("num_" + counterName + "_errors", "rate, sum");
       latency_ = stats::StatsManager::registerHisto(
           counterName + "_latency_us", 1000, 0, 20000, "avg, p75, p95, p99");
+      latencyDist_ = stats::StatsManager::registerHdrHisto(
+          counterName + "_latency_us_dist", 32, 60 * 1000 * 1000);
       VLOG(1) << "Succeeded in initializing the ProcessorCounters instance";
     } else {
       VLOG(1) << "ProcessorCounters instance has been initialized";
@@ -52,6 +60,21 @@ enum class IndexState {
 };
 
 using VertexCache = ConcurrentLRUCache<std::pair<VertexID, TagID>, std::string>;
+// Caches the raw edge rows of one (vertex, edgeType) under a given schema version, so that
+// expanding a hot vertex again skips the kvstore prefix scan. An empty block caches the
+// absence of edges. The key is built by CommonUtils::edgeListCacheKey.
+struct EdgeListCacheEntry {
+  std::shared_ptr<std::vector<kvstore::KV>> block;
+  // When the block was inserted, the read side treats entries older than
+  // FLAGS_edge_list_cache_ttl_secs as misses. The TTL is the backstop for invalidation the
+  // apply-key hook cannot see, e.g. range deletes and blocks re-cached from a stale read.
+  int64_t insertedAtSecs{0};
+};
+using EdgeListCache = ConcurrentLRUCache<std::string, EdgeListCacheEntry>;
+// Caches tag keys recently confirmed absent, so the existence probes of application level
+// upserts stop paying a full rocksdb read per miss. Entries are evicted by
+// AddVerticesProcessor before it writes. The key is built by CommonUtils::vertexAbsenceCacheKey.
+using VertexAbsenceCache = ConcurrentLRUCache<std::string, bool>;
 using IndexKey = std::tuple<GraphSpaceID, PartitionID>;
 using IndexGuard = folly::ConcurrentHashMap<IndexKey, IndexState>;
 
@@ -63,6 +86,51 @@ using EdgesMemLock = MemoryLockCore<EMLI>;
 class TransactionManager;
 class InternalStorageClient;
 
+/**
+ * @brief Tracks the plans currently executing on this storaged, keyed by the (sessionId,
+ * planId) the graph layer stamps into RequestCommon. Every PlanContext of a request joins its
+ * plan entry on construction and leaves it on destruction, accumulating resource usage on the
+ * way. The killPlan admin RPC flips the killed flag of an entry, which the scan nodes observe
+ * through isPlanKilled without a round trip to the meta service.
+ */
+class ActivePlanTracker {
+ public:
+  struct PlanEntry {
+    SessionID sessionId_{0};
+    ExecutionPlanID planId_{0};
+    // Wall clock time in us the first request of the plan arrived
+    int64_t startTimeUs_{0};
+    // Requests of the plan currently being processed
+    std::atomic<int32_t> inflightRequests_{0};
+    std::atomic<bool> killed_{false};
+    // Keys visited by the scan nodes, summed across all requests of the plan
+    std::atomic<int64_t> scannedKeys_{0};
+    // Wall time in us spent executing requests of the plan, summed across requests
+    std::atomic<int64_t> execTimeUs_{0};
+  };
+
+  /**
+   * @brief Join the plan entry of (sessionId, planId), creating it on first arrival
+   */
+  std::shared_ptr<PlanEntry> enter(SessionID sessionId, ExecutionPlanID planId);
+
+  /**
+   * @brief Leave the entry, dropping it once the last in-flight request of the plan is done
+   */
+  void leave(const std::shared_ptr<PlanEntry>& entry);
+
+  /**
+   * @brief Mark the plan killed, its scan nodes abort with E_PLAN_IS_KILLED on the next check
+   *
+   * @return Whether the plan is currently executing here
+   */
+  bool kill(SessionID sessionId, ExecutionPlanID planId);
+
+ private:
+  mutable std::mutex lock_;
+  std::map<std::pair<SessionID, ExecutionPlanID>, std::shared_ptr<PlanEntry>> plans_;
+};
+
 // unify TagID, EdgeType
 using SchemaID = TagID;
 static_assert(sizeof(SchemaID) == sizeof(EdgeType), "sizeof(TagID) != sizeof(EdgeType)");
@@ -81,6 +149,19 @@ class StorageEnv {
   std::unique_ptr<EdgesMemLock> edgesML_{nullptr};
   std::unique_ptr<kvstore::KVEngine> adminStore_{nullptr};
   int32_t adminSeqId_{0};
+  std::unique_ptr<EdgeListCache> edgeListCache_{nullptr};
+  // Negative lookup cache in front of the tag read of GetPropProcessor, set when
+  // FLAGS_vertex_absence_cache_capacity > 0
+  std::unique_ptr<VertexAbsenceCache> vertexAbsenceCache_{nullptr};
+  // Merges multi-put requests per part before proposing them to raft, set when
+  // FLAGS_write_coalesce_interval_ms > 0
+  std::unique_ptr<WriteCoalescer> writeCoalescer_{nullptr};
+  // NUMA pinned worker groups the per-part reader tasks are routed to, set when
+  // FLAGS_reader_pool_numa_aware is on and the host has more than one NUMA node
+  std::unique_ptr<NumaReaderPool> numaReaderPool_{nullptr};
+  // Registry of the plans currently executing here, feeding the killPlan admin RPC and the
+  // per-plan resource accounting. Left unset in tests that build a bare StorageEnv.
+  std::unique_ptr<ActivePlanTracker> planTracker_{nullptr};
 
   IndexState getIndexState(GraphSpaceID space, PartitionID part) {
     auto key = std::make_tuple(space, part);
@@ -164,9 +245,53 @@ class PlanContext {
       auto& common = commonRef.value();
       sessionId_ = common.session_id_ref().value_or(0);
       planId_ = common.plan_id_ref().value_or(0);
+      auto timeoutMs = common.timeout_ms_ref().value_or(0);
+      if (timeoutMs > 0) {
+        deadlineUs_ = time::WallClock::fastNowInMicroSec() + timeoutMs * 1000;
+      }
+      maxScannedKeys_ = common.max_scanned_keys_ref().value_or(0);
+      if (sessionId_ != 0 && env_ != nullptr && env_->planTracker_ != nullptr) {
+        createTimeUs_ = time::WallClock::fastNowInMicroSec();
+        planEntry_ = env_->planTracker_->enter(sessionId_, planId_);
+      }
     }
   }
 
+  ~PlanContext();
+
+  /**
+   * @brief Rocksdb snapshot of the given part, pinned at first access and held
+   * until the plan is destroyed, so every read of a part within one request
+   * observes the same view even while writes interleave. Returns nullptr (read
+   * the latest data) unless a read-only processor opted in via readSnapshot_.
+   *
+   * @param partId
+   * @return const void*
+   */
+  const void* snapshot(PartitionID partId);
+
+  /**
+   * @brief Charge keys visited by a scan node to the plan entry of this request, no-op when
+   * the request didn't carry a session id or the tracker is disabled
+   *
+   * @param keys Keys visited since the last charge
+   */
+  void addScanCost(int64_t keys) {
+    scannedKeys_.fetch_add(keys, std::memory_order_relaxed);
+    if (planEntry_ != nullptr) {
+      planEntry_->scannedKeys_.fetch_add(keys, std::memory_order_relaxed);
+    }
+  }
+
+  /**
+   * @brief Whether the request has used up its scan budget. Checked by the scan nodes per
+   * examined key, they stop iterating and flag the response as partial once it returns true.
+   * Always false when the request didn't carry max_scanned_keys.
+   */
+  bool scanBudgetExhausted() const {
+    return maxScannedKeys_ > 0 && scannedKeys_.load(std::memory_order_relaxed) >= maxScannedKeys_;
+  }
+
   StorageEnv* env_;
   GraphSpaceID spaceId_;
   SessionID sessionId_;
@@ -183,8 +308,32 @@ class PlanContext {
   // will be true if query is killed during execution
   bool isKilled_ = false;
 
+  // Local wall clock time in us the request must finish by, computed from the remaining
+  // budget the client sent. 0 means no deadline.
+  int64_t deadlineUs_ = 0;
+
+  // Hard budget of keys this request may examine, from RequestCommon. 0 means unlimited.
+  int64_t maxScannedKeys_ = 0;
+  // Keys examined by this request so far, parts may be scanned on different threads
+  std::atomic<int64_t> scannedKeys_{0};
+
+  // Only set by read-only processors; mutating processors must read the latest data.
+  bool readSnapshot_ = false;
+
+  // Entry of this plan in the ActivePlanTracker, joined on construction when the request
+  // carried a session id, left in the destructor. nullptr when the tracker is disabled.
+  std::shared_ptr<ActivePlanTracker::PlanEntry> planEntry_{nullptr};
+  // Wall clock time in us this context was created, the destructor charges the elapsed
+  // wall time to the plan entry
+  int64_t createTimeUs_ = 0;
+
   // Manage expressions
   ObjectPool objPool_;
+
+ private:
+  // Guards partSnapshots_, parts may be processed on different threads
+  std::mutex snapshotLock_;
+  std::unordered_map<PartitionID, const void*> partSnapshots_;
 };
 
 // RunTimeContext stores information **may changed** during the process. Since
@@ -222,10 +371,34 @@ struct RuntimeContext {
     if (env() == nullptr) {
       return false;
     }
+    // The local kill flag is flipped by the killPlan admin RPC, a relaxed load per row
+    // batch costs nothing next to the meta client check below
+    if (planContext_->planEntry_ != nullptr &&
+        planContext_->planEntry_->killed_.load(std::memory_order_relaxed)) {
+      return true;
+    }
+    // Checked per row batch by the scan nodes, so an abandoned query stops mid-scan once
+    // its deadline passes instead of burning CPU until completion
+    if (planContext_->deadlineUs_ > 0 &&
+        time::WallClock::fastNowInMicroSec() > planContext_->deadlineUs_) {
+      return true;
+    }
     return env()->metaClient_ &&
            env()->metaClient_->checkIsPlanKilled(planContext_->sessionId_, planContext_->planId_);
   }
 
+  const void* snapshot(PartitionID partId) const {
+    return planContext_->snapshot(partId);
+  }
+
+  void addScanCost(int64_t keys) {
+    planContext_->addScanCost(keys);
+  }
+
+  bool scanBudgetExhausted() const {
+    return planContext_->scanBudgetExhausted();
+  }
+
   PlanContext* planContext_;
   TagID tagId_ = 0;
   std::string tagName_ = "";
@@ -275,6 +448,99 @@ class CommonUtils final {
 
   static StatusOr<Value> ttlValue(const meta::NebulaSchemaProvider* schema,
                                   RowReaderWrapper* reader);
+
+  /**
+   * @brief Build the EdgeListCache key of one (vertex, edgeType) block
+   *
+   * @param spaceId Which space the vertex belongs to
+   * @param vId Vertex id the edges start from (or point to for in-edges)
+   * @param edgeType Edge type with direction, same sign as the stored edge key
+   * @param ver Schema version the block was read under, entries of stale versions just age out
+   * @return The cache key
+   */
+  static std::string edgeListCacheKey(GraphSpaceID spaceId,
+                                      const VertexID& vId,
+                                      EdgeType edgeType,
+                                      SchemaVer ver);
+
+  /**
+   * @brief Evict the cached edge block the given edge key falls into, no-op when the cache is
+   * disabled. Called by the edge mutate processors before they write.
+   *
+   * @param env Storage environment holding the cache
+   * @param spaceId Which space the edge belongs to
+   * @param edgeKey Key of the edge being written or removed
+   */
+  static void invalidateEdgeListCache(StorageEnv* env,
+                                      GraphSpaceID spaceId,
+                                      const cpp2::EdgeKey& edgeKey);
+
+  /**
+   * @brief Evict the cached edge block a raw edge key falls into, no-op when the cache is
+   * disabled. Installed as the parts' apply-key hook, so it runs for every applied edge write
+   * including follower applies, replayed wal entries and chain (TOSS) writes.
+   *
+   * @param env Storage environment holding the cache
+   * @param spaceId Which space the edge belongs to
+   * @param vIdLen Vertex id length of the space
+   * @param rawKey Storage key of the applied edge
+   */
+  static void invalidateEdgeListCacheOnApply(StorageEnv* env,
+                                             GraphSpaceID spaceId,
+                                             int32_t vIdLen,
+                                             folly::StringPiece rawKey);
+
+  /**
+   * @brief Build the VertexAbsenceCache key of one tag key
+   *
+   * @param spaceId Which space the key belongs to, the tag key itself only carries the part
+   * @param tagKey Storage key of the (vertex, tag)
+   * @return The cache key
+   */
+  static std::string vertexAbsenceCacheKey(GraphSpaceID spaceId, folly::StringPiece tagKey);
+
+  /**
+   * @brief Evict the absence entry of the given tag key, no-op when the cache is disabled.
+   * Called by AddVerticesProcessor before it writes.
+   *
+   * @param env Storage environment holding the cache
+   * @param spaceId Which space the vertex belongs to
+   * @param tagKey Storage key of the (vertex, tag) being written
+   */
+  static void invalidateVertexAbsenceCache(StorageEnv* env,
+                                           GraphSpaceID spaceId,
+                                           folly::StringPiece tagKey);
+
+  /**
+   * @brief Validate a resumed scan cursor against the replica serving it. Rejects a cursor of
+   * another part with E_INVALID_OPERATION and a cursor produced on a replica that had committed
+   * more than this one with E_LEADER_CHANGED, so the client re-routes instead of observing the
+   * part rewind. A cursor without a next key (fresh scan) always passes.
+   *
+   * @param env Storage environment holding the kvstore
+   * @param spaceId Which space the scan runs in
+   * @param partId Part the request addressed
+   * @param cursor Cursor sent by the client
+   * @return Whether this replica may resume the cursor
+   */
+  static nebula::cpp2::ErrorCode checkScanCursor(StorageEnv* env,
+                                                 GraphSpaceID spaceId,
+                                                 PartitionID partId,
+                                                 const cpp2::ScanCursor& cursor);
+
+  /**
+   * @brief Stamp the part id and the committed log id of the serving replica into an outgoing
+   * scan cursor, making it self-describing so any replica can resume it.
+   *
+   * @param env Storage environment holding the kvstore
+   * @param spaceId Which space the scan runs in
+   * @param partId Part the batch was scanned from
+   * @param cursor Cursor about to be returned to the client
+   */
+  static void fillScanCursor(StorageEnv* env,
+                             GraphSpaceID spaceId,
+                             PartitionID partId,
+                             cpp2::ScanCursor& cursor);
 };
 
 }  // namespace storage
@@ -59,21 +59,60 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
   }
 
  private:
+  // Schema and ttl lookups are memoized per tag/edge for the lifetime of one compaction: a
+  // filter instance is created per compaction run, so the cache cannot go stale while it is
+  // alive, and keys of schemas without a ttl skip the row decode entirely
+  struct SchemaTTL {
+    std::shared_ptr<const meta::NebulaSchemaProvider> schema;
+    std::pair<bool, std::pair<int64_t, std::string>> ttl{false, {0, ""}};
+  };
+
+  const SchemaTTL& tagSchemaTTL(GraphSpaceID spaceId, TagID tagId) const {
+    auto found = tagCache_.find(tagId);
+    if (found != tagCache_.end()) {
+      return found->second;
+    }
+    SchemaTTL entry;
+    entry.schema = schemaMan_->getTagSchema(spaceId, tagId);
+    if (entry.schema != nullptr) {
+      entry.ttl = CommonUtils::ttlProps(entry.schema.get());
+    }
+    return tagCache_.emplace(tagId, std::move(entry)).first->second;
+  }
+
+  const SchemaTTL& edgeSchemaTTL(GraphSpaceID spaceId, EdgeType edgeType) const {
+    auto found = edgeCache_.find(edgeType);
+    if (found != edgeCache_.end()) {
+      return found->second;
+    }
+    SchemaTTL entry;
+    entry.schema = schemaMan_->getEdgeSchema(spaceId, edgeType);
+    if (entry.schema != nullptr) {
+      entry.ttl = CommonUtils::ttlProps(entry.schema.get());
+    }
+    return edgeCache_.emplace(edgeType, std::move(entry)).first->second;
+  }
+
   bool tagValid(GraphSpaceID spaceId,
                 const folly::StringPiece& key,
                 const folly::StringPiece& val) const {
     auto tagId = NebulaKeyUtils::getTagId(vIdLen_, key);
-    auto schema = schemaMan_->getTagSchema(spaceId, tagId);
-    if (!schema) {
+    const auto& entry = tagSchemaTTL(spaceId, tagId);
+    if (!entry.schema) {
       VLOG(3) << "Space " << spaceId << ", Tag " << tagId << " invalid";
       return false;
     }
+    if (!entry.ttl.first) {
+      // no ttl on this tag, nothing to evaluate
+      return true;
+    }
     auto reader = RowReaderWrapper::getTagPropReader(schemaMan_, spaceId, tagId, val);
     if (reader == nullptr) {
       VLOG(3) << "Remove the bad format vertex";
       return false;
     }
-    if (ttlExpired(schema.get(), reader.get())) {
+    if (CommonUtils::checkDataExpiredForTTL(
+            entry.schema.get(), reader.get(), entry.ttl.second.second, entry.ttl.second.first)) {
       VLOG(3) << "Ttl expired";
       return false;
     }
@@ -88,17 +127,22 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
       VLOG(3) << "Invalid reverse edge key";
       return false;
     }
-    auto schema = schemaMan_->getEdgeSchema(spaceId, std::abs(edgeType));
-    if (!schema) {
+    const auto& entry = edgeSchemaTTL(spaceId, std::abs(edgeType));
+    if (!entry.schema) {
       VLOG(3) << "Space " << spaceId << ", EdgeType " << edgeType << " invalid";
       return false;
     }
+    if (!entry.ttl.first) {
+      // no ttl on this edge type, nothing to evaluate
+      return true;
+    }
     auto reader = RowReaderWrapper::getEdgePropReader(schemaMan_, spaceId, std::abs(edgeType), val);
     if (reader == nullptr) {
       VLOG(3) << "Remove the bad format edge!";
       return false;
     }
-    if (ttlExpired(schema.get(), reader.get())) {
+    if (CommonUtils::checkDataExpiredForTTL(
+            entry.schema.get(), reader.get(), entry.ttl.second.second, entry.ttl.second.first)) {
       VLOG(3) << "Ttl expired";
       return false;
     }
@@ -107,30 +151,14 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
 
   bool lockValid(GraphSpaceID spaceId, const folly::StringPiece& key) const {
     auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen_, key);
-    auto schema = schemaMan_->getEdgeSchema(spaceId, std::abs(edgeType));
-    if (!schema) {
+    const auto& entry = edgeSchemaTTL(spaceId, std::abs(edgeType));
+    if (!entry.schema) {
       VLOG(3) << "Space " << spaceId << ", EdgeType " << edgeType << " invalid";
       return false;
     }
     return true;
   }
 
-  // TODO(panda) Optimize the method in the future
-  bool ttlExpired(const meta::NebulaSchemaProvider* schema,
-                  nebula::RowReaderWrapper* reader) const {
-    if (schema == nullptr) {
-      return true;
-    }
-    auto ttl = CommonUtils::ttlProps(schema);
-    // Only support the specified ttl_col mode
-    // Not specifying or non-positive ttl_duration behaves like ttl_duration =
-    // infinity
-    if (!ttl.first) {
-      return false;
-    }
-    return CommonUtils::checkDataExpiredForTTL(schema, reader, ttl.second.second, ttl.second.first);
-  }
-
   bool ttlExpired(const meta::NebulaSchemaProvider* schema, const Value& v) const {
     if (schema == nullptr) {
       return true;
@@ -150,12 +178,13 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
     if (eRet.ok()) {
       if (!val.empty()) {
         auto id = eRet.value()->get_schema_id().get_edge_type();
-        auto schema = schemaMan_->getEdgeSchema(spaceId, id);
-        if (!schema) {
+        const auto& entry = edgeSchemaTTL(spaceId, id);
+        if (!entry.schema) {
           VLOG(3) << "Space " << spaceId << ", EdgeType " << id << " invalid";
           return false;
         }
-        if (ttlExpired(schema.get(), IndexKeyUtils::parseIndexTTL(val))) {
+        if (entry.ttl.first &&
+            ttlExpired(entry.schema.get(), IndexKeyUtils::parseIndexTTL(val))) {
           return false;
         }
       }
@@ -165,12 +194,13 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
     if (tRet.ok()) {
       if (!val.empty()) {
         auto id = tRet.value()->get_schema_id().get_tag_id();
-        auto schema = schemaMan_->getTagSchema(spaceId, id);
-        if (!schema) {
+        const auto& entry = tagSchemaTTL(spaceId, id);
+        if (!entry.schema) {
           VLOG(3) << "Space " << spaceId << ", tagId " << id << " invalid";
           return false;
         }
-        if (ttlExpired(schema.get(), IndexKeyUtils::parseIndexTTL(val))) {
+        if (entry.ttl.first &&
+            ttlExpired(entry.schema.get(), IndexKeyUtils::parseIndexTTL(val))) {
           return false;
         }
       }
@@ -183,6 +213,8 @@ class StorageCompactionFilter final : public kvstore::KVFilter {
   meta::SchemaManager* schemaMan_ = nullptr;
   meta::IndexManager* indexMan_ = nullptr;
   size_t vIdLen_;
+  mutable std::unordered_map<TagID, SchemaTTL> tagCache_;
+  mutable std::unordered_map<EdgeType, SchemaTTL> edgeCache_;
 };
 
 class StorageCompactionFilterFactory final : public kvstore::KVCompactionFilterFactory {
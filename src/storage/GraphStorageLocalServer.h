@@ -17,6 +17,16 @@
 #include "folly/fibers/Semaphore.h"
 #include "interface/gen-cpp2/GraphStorageServiceAsyncClient.h"
 namespace nebula::storage {
+
+class GraphStorageServiceHandler;
+
+/**
+ * @brief In-process replacement for the storage thrift server in the standalone build. Requests
+ *        and responses are moved between the graph and storage layers as live cpp2 objects, so a
+ *        fused query never serializes a DataSet: the storage processors' results land directly
+ *        in the memory the graph executors consume. Callers should pass requests as rvalues to
+ *        stay zero-copy end to end.
+ */
 class GraphStorageLocalServer final : public boost::noncopyable, public nebula::cpp::NonMovable {
  public:
   static std::shared_ptr<GraphStorageLocalServer> getInstance() {
@@ -26,34 +36,37 @@ class GraphStorageLocalServer final : public boost::noncopyable, public nebula::
   void setThreadManager(std::shared_ptr<apache::thrift::concurrency::ThreadManager> threadManager);
   void setInterface(std::shared_ptr<apache::thrift::ServerInterface> handler);
 
+  // whether a storage handler has been registered, callers sharing the storaged process
+  // should fall back to the thrift client when this returns false
+  bool serving() const {
+    return handler_ != nullptr && threadManager_ != nullptr;
+  }
+
  public:
-  folly::Future<cpp2::GetNeighborsResponse> future_getNeighbors(
-      const cpp2::GetNeighborsRequest& request);
-  folly::Future<cpp2::GetDstBySrcResponse> future_getDstBySrc(
-      const cpp2::GetDstBySrcRequest& request);
-  folly::Future<cpp2::ExecResponse> future_addVertices(const cpp2::AddVerticesRequest& request);
-  folly::Future<cpp2::ExecResponse> future_chainAddEdges(const cpp2::AddEdgesRequest& request);
-  folly::Future<cpp2::ExecResponse> future_addEdges(const cpp2::AddEdgesRequest& request);
-  folly::Future<cpp2::GetPropResponse> future_getProps(const cpp2::GetPropRequest& request);
-  folly::Future<cpp2::ExecResponse> future_deleteEdges(const cpp2::DeleteEdgesRequest& request);
-  folly::Future<cpp2::ExecResponse> future_chainDeleteEdges(
-      const cpp2::DeleteEdgesRequest& request);
-  folly::Future<cpp2::ExecResponse> future_deleteVertices(
-      const cpp2::DeleteVerticesRequest& request);
-  folly::Future<cpp2::ExecResponse> future_deleteTags(const cpp2::DeleteTagsRequest& request);
-  folly::Future<cpp2::UpdateResponse> future_updateVertex(const cpp2::UpdateVertexRequest& request);
-  folly::Future<cpp2::UpdateResponse> future_chainUpdateEdge(
-      const cpp2::UpdateEdgeRequest& request);
-  folly::Future<cpp2::UpdateResponse> future_updateEdge(const cpp2::UpdateEdgeRequest& request);
-  folly::Future<cpp2::GetUUIDResp> future_getUUID(const cpp2::GetUUIDReq& request);
-  folly::Future<cpp2::LookupIndexResp> future_lookupIndex(const cpp2::LookupIndexRequest& request);
+  // Requests are taken by value: passing an rvalue moves it all the way into the storage
+  // processor without any deep copy.
+  folly::Future<cpp2::GetNeighborsResponse> future_getNeighbors(cpp2::GetNeighborsRequest request);
+  folly::Future<cpp2::GetDstBySrcResponse> future_getDstBySrc(cpp2::GetDstBySrcRequest request);
+  folly::Future<cpp2::ExecResponse> future_addVertices(cpp2::AddVerticesRequest request);
+  folly::Future<cpp2::ExecResponse> future_chainAddEdges(cpp2::AddEdgesRequest request);
+  folly::Future<cpp2::ExecResponse> future_addEdges(cpp2::AddEdgesRequest request);
+  folly::Future<cpp2::GetPropResponse> future_getProps(cpp2::GetPropRequest request);
+  folly::Future<cpp2::ExecResponse> future_deleteEdges(cpp2::DeleteEdgesRequest request);
+  folly::Future<cpp2::ExecResponse> future_chainDeleteEdges(cpp2::DeleteEdgesRequest request);
+  folly::Future<cpp2::ExecResponse> future_deleteVertices(cpp2::DeleteVerticesRequest request);
+  folly::Future<cpp2::ExecResponse> future_deleteTags(cpp2::DeleteTagsRequest request);
+  folly::Future<cpp2::UpdateResponse> future_updateVertex(cpp2::UpdateVertexRequest request);
+  folly::Future<cpp2::UpdateResponse> future_chainUpdateEdge(cpp2::UpdateEdgeRequest request);
+  folly::Future<cpp2::UpdateResponse> future_updateEdge(cpp2::UpdateEdgeRequest request);
+  folly::Future<cpp2::GetUUIDResp> future_getUUID(cpp2::GetUUIDReq request);
+  folly::Future<cpp2::LookupIndexResp> future_lookupIndex(cpp2::LookupIndexRequest request);
   folly::Future<cpp2::GetNeighborsResponse> future_lookupAndTraverse(
-      const cpp2::LookupAndTraverseRequest& request);
-  folly::Future<cpp2::ScanResponse> future_scanVertex(const cpp2::ScanVertexRequest& request);
-  folly::Future<cpp2::ScanResponse> future_scanEdge(const cpp2::ScanEdgeRequest& request);
-  folly::Future<cpp2::KVGetResponse> future_get(const cpp2::KVGetRequest& request);
-  folly::Future<cpp2::ExecResponse> future_put(const cpp2::KVPutRequest& request);
-  folly::Future<cpp2::ExecResponse> future_remove(const cpp2::KVRemoveRequest& request);
+      cpp2::LookupAndTraverseRequest request);
+  folly::Future<cpp2::ScanResponse> future_scanVertex(cpp2::ScanVertexRequest request);
+  folly::Future<cpp2::ScanResponse> future_scanEdge(cpp2::ScanEdgeRequest request);
+  folly::Future<cpp2::KVGetResponse> future_get(cpp2::KVGetRequest request);
+  folly::Future<cpp2::ExecResponse> future_put(cpp2::KVPutRequest request);
+  folly::Future<cpp2::ExecResponse> future_remove(cpp2::KVRemoveRequest request);
 
  private:
   GraphStorageLocalServer() = default;
@@ -61,6 +74,8 @@ class GraphStorageLocalServer final : public boost::noncopyable, public nebula::
  private:
   std::shared_ptr<apache::thrift::concurrency::ThreadManager> threadManager_;
   std::shared_ptr<apache::thrift::ServerInterface> handler_;
+  // handler_ down-cast once in setInterface so dispatching does not pay a dynamic_cast per call
+  std::shared_ptr<GraphStorageServiceHandler> storageHandler_;
 };
 }  // namespace nebula::storage
 #endif
@@ -19,6 +19,7 @@
 #include "storage/mutate/UpdateVertexProcessor.h"
 #include "storage/query/GetDstBySrcProcessor.h"
 #include "storage/query/GetNeighborsProcessor.h"
+#include "storage/query/GetSubgraphProcessor.h"
 #include "storage/query/GetPropProcessor.h"
 #include "storage/query/ScanEdgeProcessor.h"
 #include "storage/query/ScanVertexProcessor.h"
@@ -76,6 +77,7 @@ GraphStorageServiceHandler::GraphStorageServiceHandler(StorageEnv* env) : env_(e
   kUpdateEdgeCounters.init("update_edge");
   kGetNeighborsCounters.init("get_neighbors");
   kGetDstBySrcCounters.init("get_dst_by_src");
+  kGetSubgraphCounters.init("get_subgraph");
   kGetPropCounters.init("get_prop");
   kLookupCounters.init("lookup");
   kScanVertexCounters.init("scan_vertex");
@@ -149,6 +151,12 @@ folly::Future<cpp2::GetDstBySrcResponse> GraphStorageServiceHandler::future_getD
   RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::GetSubgraphResponse> GraphStorageServiceHandler::future_getSubgraph(
+    const cpp2::GetSubgraphRequest& req) {
+  auto* processor = GetSubgraphProcessor::instance(env_, &kGetSubgraphCounters);
+  RETURN_FUTURE(processor);
+}
+
 folly::Future<cpp2::GetPropResponse> GraphStorageServiceHandler::future_getProps(
     const cpp2::GetPropRequest& req) {
   auto* processor = GetPropProcessor::instance(env_, &kGetPropCounters, readerPool_.get());
@@ -48,6 +48,9 @@ class GraphStorageServiceHandler final : public cpp2::GraphStorageServiceSvIf {
   folly::Future<cpp2::GetDstBySrcResponse> future_getDstBySrc(
       const cpp2::GetDstBySrcRequest& req) override;
 
+  folly::Future<cpp2::GetSubgraphResponse> future_getSubgraph(
+      const cpp2::GetSubgraphRequest& req) override;
+
   folly::Future<cpp2::GetPropResponse> future_getProps(const cpp2::GetPropRequest& req) override;
 
   folly::Future<cpp2::LookupIndexResp> future_lookupIndex(
@@ -0,0 +1,102 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/NumaReaderPool.h"
+
+#include <folly/String.h>
+#include <folly/executors/thread_factory/NamedThreadFactory.h>
+#include <sched.h>
+
+#include <fstream>
+
+namespace nebula {
+namespace storage {
+
+namespace {
+
+// Thread factory pinning every thread it creates to the given cpu set
+class PinnedThreadFactory : public folly::NamedThreadFactory {
+ public:
+  PinnedThreadFactory(const std::string& prefix, const cpu_set_t& cpus)
+      : folly::NamedThreadFactory(prefix), cpus_(cpus) {}
+
+  std::thread newThread(folly::Func&& func) override {
+    return folly::NamedThreadFactory::newThread(
+        [cpus = cpus_, func = std::move(func)]() mutable {
+          if (sched_setaffinity(0, sizeof(cpus), &cpus) != 0) {
+            LOG(WARNING) << "Failed to pin reader thread: " << ::strerror(errno);
+          }
+          func();
+        });
+  }
+
+ private:
+  cpu_set_t cpus_;
+};
+
+// Parses a sysfs cpulist like "0-15,32-47" into a cpu set
+bool parseCpuList(const std::string& cpulist, cpu_set_t* cpus) {
+  CPU_ZERO(cpus);
+  std::vector<folly::StringPiece> ranges;
+  folly::split(',', folly::trimWhitespace(cpulist), ranges, true);
+  for (auto& range : ranges) {
+    auto dash = range.find('-');
+    try {
+      if (dash == folly::StringPiece::npos) {
+        CPU_SET(folly::to<int>(range), cpus);
+      } else {
+        int first = folly::to<int>(range.subpiece(0, dash));
+        int last = folly::to<int>(range.subpiece(dash + 1));
+        for (int cpu = first; cpu <= last; cpu++) {
+          CPU_SET(cpu, cpus);
+        }
+      }
+    } catch (const std::exception& e) {
+      return false;
+    }
+  }
+  return CPU_COUNT(cpus) > 0;
+}
+
+}  // namespace
+
+std::unique_ptr<NumaReaderPool> NumaReaderPool::tryCreate(int32_t numThreads) {
+  std::vector<cpu_set_t> nodes;
+  for (int32_t node = 0;; node++) {
+    auto path = folly::stringPrintf("/sys/devices/system/node/node%d/cpulist", node);
+    std::ifstream ifs(path);
+    if (!ifs) {
+      break;
+    }
+    std::string cpulist;
+    std::getline(ifs, cpulist);
+    cpu_set_t cpus;
+    if (!parseCpuList(cpulist, &cpus)) {
+      LOG(WARNING) << "Could not parse " << path << ": `" << cpulist << "'";
+      return nullptr;
+    }
+    nodes.emplace_back(cpus);
+  }
+  if (nodes.size() < 2) {
+    LOG(INFO) << "Found " << nodes.size()
+              << " NUMA node(s), falling back to the shared reader pool";
+    return nullptr;
+  }
+
+  auto perGroup = std::max<int32_t>(numThreads / static_cast<int32_t>(nodes.size()), 1);
+  std::vector<std::shared_ptr<folly::IOThreadPoolExecutor>> groups;
+  for (size_t node = 0; node < nodes.size(); node++) {
+    auto factory = std::make_shared<PinnedThreadFactory>(
+        folly::stringPrintf("reader-numa%zu", node), nodes[node]);
+    groups.emplace_back(
+        std::make_shared<folly::IOThreadPoolExecutor>(perGroup, std::move(factory)));
+  }
+  LOG(INFO) << "Created " << groups.size() << " pinned reader groups with " << perGroup
+            << " threads each";
+  return std::unique_ptr<NumaReaderPool>(new NumaReaderPool(std::move(groups)));
+}
+
+}  // namespace storage
+}  // namespace nebula
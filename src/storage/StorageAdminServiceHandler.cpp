@@ -8,6 +8,8 @@
 #include "storage/admin/AdminProcessor.h"
 #include "storage/admin/AdminTaskProcessor.h"
 #include "storage/admin/ClearSpaceProcessor.h"
+#include "storage/admin/CloneSpaceProcessor.h"
+#include "storage/admin/KillPlanProcessor.h"
 #include "storage/admin/CreateCheckpointProcessor.h"
 #include "storage/admin/DropCheckpointProcessor.h"
 #include "storage/admin/GetLeaderProcessor.h"
@@ -28,6 +30,12 @@ folly::Future<cpp2::AdminExecResp> StorageAdminServiceHandler::future_transLeade
   RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::AdminExecResp> StorageAdminServiceHandler::future_drainLeaders(
+    const cpp2::DrainLeadersReq& req) {
+  auto* processor = DrainLeadersProcessor::instance(env_);
+  RETURN_FUTURE(processor);
+}
+
 folly::Future<cpp2::AdminExecResp> StorageAdminServiceHandler::future_addPart(
     const cpp2::AddPartReq& req) {
   auto* processor = AddPartProcessor::instance(env_);
@@ -106,5 +114,17 @@ folly::Future<cpp2::ClearSpaceResp> StorageAdminServiceHandler::future_clearSpac
   RETURN_FUTURE(processor);
 }
 
+folly::Future<cpp2::CloneSpaceResp> StorageAdminServiceHandler::future_cloneSpace(
+    const cpp2::CloneSpaceReq& req) {
+  auto* processor = CloneSpaceProcessor::instance(env_);
+  RETURN_FUTURE(processor);
+}
+
+folly::Future<cpp2::KillPlanResp> StorageAdminServiceHandler::future_killPlan(
+    const cpp2::KillPlanReq& req) {
+  auto* processor = KillPlanProcessor::instance(env_);
+  RETURN_FUTURE(processor);
+}
+
 }  // namespace storage
 }  // namespace nebula
@@ -20,6 +20,8 @@ class StorageAdminServiceHandler final : public cpp2::StorageAdminServiceSvIf {
 
   folly::Future<cpp2::AdminExecResp> future_transLeader(const cpp2::TransLeaderReq& req) override;
 
+  folly::Future<cpp2::AdminExecResp> future_drainLeaders(const cpp2::DrainLeadersReq& req) override;
+
   folly::Future<cpp2::AdminExecResp> future_addPart(const cpp2::AddPartReq& req) override;
 
   folly::Future<cpp2::AdminExecResp> future_addLearner(const cpp2::AddLearnerReq& req) override;
@@ -50,6 +52,10 @@ class StorageAdminServiceHandler final : public cpp2::StorageAdminServiceSvIf {
 
   folly::Future<cpp2::ClearSpaceResp> future_clearSpace(const cpp2::ClearSpaceReq& req) override;
 
+  folly::Future<cpp2::CloneSpaceResp> future_cloneSpace(const cpp2::CloneSpaceReq& req) override;
+
+  folly::Future<cpp2::KillPlanResp> future_killPlan(const cpp2::KillPlanReq& req) override;
+
  private:
   StorageEnv* env_{nullptr};
 };
@@ -26,8 +26,20 @@ DEFINE_uint32(rebuild_index_part_rate_limit,
               1024 * 512,
               "max bytes of rebuilding index for each partition in one second");
 
+DEFINE_double(rebuild_index_min_rate_ratio,
+              0.1,
+              "Floor of the adaptive io budget of rebuild index tasks, as a fraction of "
+              "rebuild_index_part_rate_limit. Only takes effect when "
+              "admin_task_read_latency_target_us is set");
+
 DEFINE_uint32(rebuild_index_batch_size, 1024 * 128, "batch size for rebuild index, in bytes");
 
+DEFINE_uint32(scan_prefetch_depth,
+              0,
+              "Number of key/value pairs a sequential scan keeps decoded ahead of the consumer "
+              "on a background thread, overlapping block reads with the decode loop on cold "
+              "data. 0 disables prefetching");
+
 DEFINE_int32(reader_handlers, 32, "Total reader handlers");
 
 DEFINE_uint64(default_mvcc_ver,
@@ -40,11 +52,75 @@ DEFINE_string(reader_handlers_type, "cpu", "Type of reader handlers, options: cp
 
 DEFINE_bool(trace_toss, false, "output verbose log of toss");
 
+DEFINE_bool(toss_same_host_fast_path,
+            false,
+            "commit the remote half of a chain in process when the in-edge part leader "
+            "lives on the same storaged, skipping the internal rpc");
+
 DEFINE_int32(max_edge_returned_per_vertex, INT_MAX, "Max edge number returned searching vertex");
 
+DEFINE_int64(max_edge_scanned_per_vertex,
+             -1,
+             "Max edge number examined per vertex and edge type during GetNeighbors, the scan of "
+             "a super-node stops early once the bound is hit, even when a filter or sampling "
+             "would keep scanning. Negative means unlimited");
+
 DEFINE_bool(query_concurrently,
             false,
             "whether to run query of each part concurrently, only lookup and "
             "go are supported");
 
+DEFINE_int32(query_concurrently_task_size,
+             1024,
+             "max number of vertices one concurrent task of a partition handles, a partition "
+             "with more vertices is split into multiple tasks, 0 means one task per partition");
+
+DEFINE_bool(query_snapshot_read,
+            false,
+            "whether GetNeighbors reads each part through a rocksdb snapshot pinned for the whole "
+            "request, so concurrent writes can not interleave within one scan");
+
 DEFINE_bool(use_vertex_key, false, "whether allow insert or query the vertex key");
+
+DEFINE_int64(edge_list_cache_capacity,
+             0,
+             "Max number of (vertex, edgeType) edge blocks the in-process cache holds, hot-vertex "
+             "expansion reads the cached block instead of scanning the kvstore. 0 means disabled");
+
+DEFINE_int64(edge_list_cache_max_block_size,
+             1024,
+             "An edge block with more edges than this is not inserted into the edge list cache, "
+             "so super-nodes do not wash out the cache");
+
+DEFINE_int32(edge_list_cache_ttl_secs,
+             600,
+             "An edge block older than this is treated as a miss and re-read from the kvstore, "
+             "bounding the staleness of entries no invalidation path reaches. 0 means no ttl");
+
+DEFINE_int64(vertex_absence_cache_capacity,
+             0,
+             "Max number of tag keys the negative lookup cache of GetProp holds, existence "
+             "probes of keys recently confirmed absent skip the rocksdb read. 0 means disabled");
+
+DEFINE_int32(write_coalesce_interval_ms,
+             0,
+             "Window in milliseconds during which multi-put requests to the same part are merged "
+             "into one raft proposal. 0 means disabled");
+
+DEFINE_int64(write_coalesce_max_bytes,
+             4 * 1024 * 1024,
+             "A part whose coalesced writes outgrow this many bytes is flushed ahead of the "
+             "coalesce tick");
+
+DEFINE_bool(in_edge_key_only,
+            false,
+            "Store in-edge entries without the duplicated property value, reverse expansions "
+            "resolve the props against the out-edge row instead. Only safe when every part of "
+            "the space is present on each storaged (single host or full replication), since the "
+            "out-edge row lives in the part of the source vertex. Existing in-edge values keep "
+            "working, the flag only affects newly written edges");
+
+DEFINE_bool(reader_pool_numa_aware,
+            false,
+            "Split the reader handlers into one pinned worker group per NUMA node and route the "
+            "per-part reader tasks of a partition always to the same group");
@@ -20,8 +20,12 @@ DECLARE_int32(waiting_new_leader_interval_in_secs);
 
 DECLARE_uint32(rebuild_index_part_rate_limit);
 
+DECLARE_double(rebuild_index_min_rate_ratio);
+
 DECLARE_uint32(rebuild_index_batch_size);
 
+DECLARE_uint32(scan_prefetch_depth);
+
 DECLARE_int32(reader_handlers);
 
 DECLARE_uint64(default_mvcc_ver);
@@ -30,10 +34,34 @@ DECLARE_string(reader_handlers_type);
 
 DECLARE_bool(trace_toss);
 
+DECLARE_bool(toss_same_host_fast_path);
+
 DECLARE_int32(max_edge_returned_per_vertex);
 
+DECLARE_int64(max_edge_scanned_per_vertex);
+
 DECLARE_bool(query_concurrently);
 
+DECLARE_int32(query_concurrently_task_size);
+
+DECLARE_bool(query_snapshot_read);
+
 DECLARE_bool(use_vertex_key);
 
+DECLARE_int64(edge_list_cache_capacity);
+
+DECLARE_int64(edge_list_cache_max_block_size);
+
+DECLARE_int32(edge_list_cache_ttl_secs);
+
+DECLARE_int64(vertex_absence_cache_capacity);
+
+DECLARE_int32(write_coalesce_interval_ms);
+
+DECLARE_int64(write_coalesce_max_bytes);
+
+DECLARE_bool(in_edge_key_only);
+
+DECLARE_bool(reader_pool_numa_aware);
+
 #endif  // STORAGE_STORAGEFLAGS_H_
@@ -26,6 +26,7 @@
 #include "storage/GraphStorageServiceHandler.h"
 #include "storage/StorageAdminServiceHandler.h"
 #include "storage/StorageFlags.h"
+#include "storage/admin/StorageWarmup.h"
 #include "storage/http/StorageHttpAdminHandler.h"
 #include "storage/http/StorageHttpPropertyHandler.h"
 #include "storage/http/StorageHttpStatsHandler.h"
@@ -67,8 +68,11 @@ StorageServer::StorageServer(HostAddr localHost,
     : localHost_(localHost),
       metaAddrs_(std::move(metaAddrs)),
       dataPaths_(std::move(dataPaths)),
-      walPath_(std::move(walPath)),
-      listenerPath_(std::move(listenerPath)) {}
+      listenerPath_(std::move(listenerPath)) {
+  folly::split(",", walPath, walPaths_, true);
+  CHECK(walPaths_.size() <= 1 || walPaths_.size() == dataPaths_.size())
+      << "wal_path must be empty, a single shared path, or one path per data_path entry";
+}
 
 Status StorageServer::setupMemoryMonitorThread() {
   memoryMonitorThread_ = std::make_unique<thread::GenericWorker>();
@@ -95,7 +99,11 @@ Status StorageServer::setupMemoryMonitorThread() {
 std::unique_ptr<kvstore::KVStore> StorageServer::getStoreInstance() {
   kvstore::KVOptions options;
   options.dataPaths_ = dataPaths_;
-  options.walPath_ = walPath_;
+  if (walPaths_.size() == 1) {
+    options.walPath_ = walPaths_.front();
+  } else if (walPaths_.size() > 1) {
+    options.walPaths_ = walPaths_;
+  }
   options.listenerPath_ = listenerPath_;
   options.partMan_ =
       std::make_unique<kvstore::MetaServerBasedPartManager>(localHost_, metaClient_.get());
@@ -151,8 +159,8 @@ bool StorageServer::initWebService() {
 
 std::unique_ptr<kvstore::KVEngine> StorageServer::getAdminStoreInstance() {
   int32_t vIdLen = NebulaKeyUtils::adminTaskKey(-1, 0, 0, 0).size();
-  std::unique_ptr<kvstore::KVEngine> re(
-      new kvstore::RocksEngine(0, vIdLen, dataPaths_[0], walPath_));
+  std::unique_ptr<kvstore::KVEngine> re(new kvstore::RocksEngine(
+      0, vIdLen, dataPaths_[0], walPaths_.empty() ? "" : walPaths_.front()));
   return re;
 }
 
@@ -264,6 +272,21 @@ bool StorageServer::start() {
     return false;
   }
 
+  if (FLAGS_warmup_on_start) {
+    // Warm the caches while the thrift servers are still down, so the first queries after
+    // a rolling restart don't pay the cold cache penalty
+    auto spacesRet = metaClient_->listSpaces().get();
+    if (spacesRet.ok()) {
+      std::vector<GraphSpaceID> spaceIds;
+      for (auto& spaceIdName : spacesRet.value()) {
+        spaceIds.emplace_back(spaceIdName.first);
+      }
+      StorageWarmup::warmup(dynamic_cast<kvstore::NebulaStore*>(kvstore_.get()), spaceIds);
+    } else {
+      LOG(WARNING) << "List spaces failed, skip the cache warmup: " << spacesRet.status();
+    }
+  }
+
   if (!initWebService()) {
     LOG(ERROR) << "Init webservice failed!";
     return false;
@@ -278,6 +301,35 @@ bool StorageServer::start() {
 
   env_->verticesML_ = std::make_unique<VerticesMemLock>();
   env_->edgesML_ = std::make_unique<EdgesMemLock>();
+  env_->planTracker_ = std::make_unique<ActivePlanTracker>();
+  if (FLAGS_edge_list_cache_capacity > 0) {
+    env_->edgeListCache_ = std::make_unique<EdgeListCache>(FLAGS_edge_list_cache_capacity);
+    // Evict at apply time as well: the processors only cover leader-side writes, the hook also
+    // sees follower applies, replayed wal entries and chain (TOSS) writes, and it runs after
+    // the write batch went down so a racing read cannot re-cache the pre-write block
+    auto* nbStore = dynamic_cast<kvstore::NebulaStore*>(kvstore_.get());
+    if (nbStore != nullptr) {
+      auto hook = [env = env_.get()](GraphSpaceID spaceId, int32_t vIdLen, folly::StringPiece key) {
+        CommonUtils::invalidateEdgeListCacheOnApply(env, spaceId, vIdLen, key);
+      };
+      std::vector<std::pair<GraphSpaceID, PartitionID>> existParts;
+      nbStore->registerOnNewPartAdded(
+          "EdgeListCache",
+          [hook](std::shared_ptr<kvstore::Part>& part) { part->setApplyKeyHook(hook); },
+          existParts);
+    }
+  }
+  if (FLAGS_vertex_absence_cache_capacity > 0) {
+    env_->vertexAbsenceCache_ =
+        std::make_unique<VertexAbsenceCache>(FLAGS_vertex_absence_cache_capacity);
+  }
+  if (FLAGS_write_coalesce_interval_ms > 0) {
+    env_->writeCoalescer_ =
+        std::make_unique<WriteCoalescer>(kvstore_.get(), FLAGS_write_coalesce_interval_ms);
+  }
+  if (FLAGS_reader_pool_numa_aware) {
+    env_->numaReaderPool_ = NumaReaderPool::tryCreate(FLAGS_reader_handlers);
+  }
   env_->adminStore_ = getAdminStoreInstance();
   env_->adminSeqId_ = getAdminStoreSeqId();
   if (env_->adminSeqId_ < 0) {
@@ -376,7 +428,12 @@ std::unique_ptr<apache::thrift::ThriftServer> StorageServer::getStorageServer()
     if (FLAGS_enable_ssl) {
       server->setSSLConfig(nebula::sslContextConfig());
     }
-    server->setInterface(std::move(handler));
+    server->setInterface(handler);
+    // also expose the handler through the in-process server, so callers living in this
+    // process (the standalone build, tests) can reach storage without thrift serialization
+    auto localServer = GraphStorageLocalServer::getInstance();
+    localServer->setThreadManager(workers_);
+    localServer->setInterface(std::move(handler));
     server->setup();
     return server;
   } catch (const std::exception& e) {
@@ -114,7 +114,8 @@ class StorageServer final {
   HostAddr localHost_;
   std::vector<HostAddr> metaAddrs_;
   std::vector<std::string> dataPaths_;
-  std::string walPath_;
+  // either empty, one shared wal root, or one wal device per data path
+  std::vector<std::string> walPaths_;
   std::string listenerPath_;
 
   AdminTaskManager* taskMgr_{nullptr};
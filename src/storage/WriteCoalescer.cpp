@@ -0,0 +1,80 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/WriteCoalescer.h"
+
+#include "storage/StorageFlags.h"
+
+namespace nebula {
+namespace storage {
+
+WriteCoalescer::WriteCoalescer(kvstore::KVStore* kvstore, int32_t intervalMs)
+    : kvstore_(kvstore) {
+  worker_ = std::make_unique<thread::GenericWorker>();
+  CHECK(worker_->start("write-coalescer"));
+  worker_->addRepeatTask(intervalMs, &WriteCoalescer::flushAll, this);
+}
+
+WriteCoalescer::~WriteCoalescer() {
+  worker_->stop();
+  worker_->wait();
+  flushAll();
+}
+
+void WriteCoalescer::asyncMultiPut(GraphSpaceID spaceId,
+                                   PartitionID partId,
+                                   std::vector<kvstore::KV>&& data,
+                                   kvstore::KVCallback cb) {
+  Pending full;
+  {
+    std::lock_guard<std::mutex> lg(lock_);
+    auto& pending = pending_[std::make_pair(spaceId, partId)];
+    for (auto& kv : data) {
+      pending.bytes += kv.first.size() + kv.second.size();
+    }
+    pending.data.insert(pending.data.end(),
+                        std::make_move_iterator(data.begin()),
+                        std::make_move_iterator(data.end()));
+    pending.callbacks.emplace_back(std::move(cb));
+    if (pending.bytes < static_cast<size_t>(FLAGS_write_coalesce_max_bytes)) {
+      return;
+    }
+    // Too big for the next tick, flush this part right away
+    full = std::move(pending);
+    pending_.erase(std::make_pair(spaceId, partId));
+  }
+  flush(spaceId, partId, std::move(full));
+}
+
+void WriteCoalescer::flushAll() {
+  decltype(pending_) pending;
+  {
+    std::lock_guard<std::mutex> lg(lock_);
+    pending = std::move(pending_);
+    pending_.clear();
+  }
+  for (auto& [key, value] : pending) {
+    flush(key.first, key.second, std::move(value));
+  }
+}
+
+void WriteCoalescer::flush(GraphSpaceID spaceId, PartitionID partId, Pending&& pending) {
+  if (pending.data.empty()) {
+    return;
+  }
+  auto callbacks =
+      std::make_shared<std::vector<kvstore::KVCallback>>(std::move(pending.callbacks));
+  kvstore_->asyncMultiPut(spaceId,
+                          partId,
+                          std::move(pending.data),
+                          [callbacks](nebula::cpp2::ErrorCode code) {
+                            for (auto& cb : *callbacks) {
+                              cb(code);
+                            }
+                          });
+}
+
+}  // namespace storage
+}  // namespace nebula
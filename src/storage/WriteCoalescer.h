@@ -0,0 +1,58 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_WRITECOALESCER_H_
+#define STORAGE_WRITECOALESCER_H_
+
+#include "common/base/Base.h"
+#include "common/thread/GenericWorker.h"
+#include "kvstore/KVStore.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Merges multi-put requests to the same part arriving within one tick into a single
+ * raft proposal.
+ *
+ * Many small client sessions doing single-row inserts produce one tiny raft proposal per
+ * request per part. The coalescer buffers the key-values per (space, part) and a timer thread
+ * flushes every buffer each tick through one NebulaStore::asyncMultiPut, fanning the commit
+ * code out to every buffered request's callback. The key-values keep their arrival order, so
+ * the merged proposal applies the same state the individual proposals would have. A part whose
+ * buffer outgrows the byte cap is flushed inline, ahead of the tick.
+ *
+ * Mutations that need an atomic read-modify-write (the index paths going through
+ * asyncAtomicOp) do not pass through here.
+ */
+class WriteCoalescer final {
+ public:
+  WriteCoalescer(kvstore::KVStore* kvstore, int32_t intervalMs);
+  ~WriteCoalescer();
+
+  void asyncMultiPut(GraphSpaceID spaceId,
+                     PartitionID partId,
+                     std::vector<kvstore::KV>&& data,
+                     kvstore::KVCallback cb);
+
+ private:
+  struct Pending {
+    std::vector<kvstore::KV> data;
+    std::vector<kvstore::KVCallback> callbacks;
+    size_t bytes{0};
+  };
+
+  void flushAll();
+  void flush(GraphSpaceID spaceId, PartitionID partId, Pending&& pending);
+
+  kvstore::KVStore* kvstore_{nullptr};
+  std::mutex lock_;
+  std::map<std::pair<GraphSpaceID, PartitionID>, Pending> pending_;
+  std::unique_ptr<thread::GenericWorker> worker_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_WRITECOALESCER_H_
@@ -133,6 +133,93 @@ class TransLeaderProcessor : public BaseProcessor<cpp2::AdminExecResp> {
   explicit TransLeaderProcessor(StorageEnv* env) : BaseProcessor<cpp2::AdminExecResp>(env) {}
 };
 
+/**
+ * @brief Processor class to move every leader off this host, used to drain a node before a
+ * rolling restart so the restart does not trigger a burst of election timeouts.
+ *
+ */
+class DrainLeadersProcessor : public BaseProcessor<cpp2::AdminExecResp> {
+ public:
+  /**
+   * @brief Construct new instance of DrainLeadersProcessor.
+   *
+   * @param env Related environment variables for storage.
+   * @return DrainLeadersProcessor* DrainLeadersProcessor instance.
+   */
+  static DrainLeadersProcessor* instance(StorageEnv* env) {
+    return new DrainLeadersProcessor(env);
+  }
+
+  /**
+   * @brief Entry point for draining leaders.
+   *
+   * @param req Request for draining leaders.
+   */
+  void process(const cpp2::DrainLeadersReq& req) {
+    CHECK_NOTNULL(env_->kvstore_);
+    auto* store = static_cast<kvstore::NebulaStore*>(env_->kvstore_);
+    std::unordered_set<GraphSpaceID> filter(req.get_space_ids().begin(), req.get_space_ids().end());
+    std::unordered_map<GraphSpaceID, std::vector<meta::cpp2::LeaderInfo>> leaderIds;
+    auto count = store->allLeader(leaderIds);
+    LOG(INFO) << "Receive drain leaders, " << count << " leader(s) on " << store->address();
+
+    using PartResult = std::tuple<GraphSpaceID, PartitionID, nebula::cpp2::ErrorCode>;
+    std::vector<folly::Future<PartResult>> results;
+    auto* partManager = env_->kvstore_->partManager();
+    for (auto& entry : leaderIds) {
+      auto spaceId = entry.first;
+      if (!filter.empty() && filter.count(spaceId) == 0) {
+        continue;
+      }
+      for (auto& leaderInfo : entry.second) {
+        auto partId = leaderInfo.get_part_id();
+        auto ret = env_->kvstore_->part(spaceId, partId);
+        if (!ok(ret)) {
+          // The part has been removed since the leader distribution was collected
+          continue;
+        }
+        auto status = partManager->partMeta(spaceId, partId);
+        if (!status.ok() || status.value().hosts_.size() == 1) {
+          // Single replica, there is no peer to move the leader to
+          continue;
+        }
+        auto part = nebula::value(ret);
+        folly::Promise<PartResult> promise;
+        results.emplace_back(promise.getFuture());
+        // An empty target lets the followers race for the leadership, so the drain does not
+        // need to pick the best candidate for each part.
+        part->asyncTransferLeader(
+            HostAddr("", 0),
+            [spaceId, partId, pro = std::move(promise)](nebula::cpp2::ErrorCode code) mutable {
+              pro.setValue(std::make_tuple(spaceId, partId, code));
+            });
+      }
+    }
+
+    folly::collectAll(results)
+        .via(folly::getGlobalIOExecutor().get())
+        .thenValue([this](std::vector<folly::Try<PartResult>>&& tries) {
+          for (auto& t : tries) {
+            auto spaceId = std::get<0>(t.value());
+            auto partId = std::get<1>(t.value());
+            auto code = std::get<2>(t.value());
+            if (code == nebula::cpp2::ErrorCode::SUCCEEDED ||
+                code == nebula::cpp2::ErrorCode::E_LEADER_CHANGED) {
+              // Either we gave up the leadership, or we were not the leader anymore
+              continue;
+            }
+            LOG(INFO) << "Space " << spaceId << " part " << partId
+                      << " failed to drain leader, error: " << static_cast<int32_t>(code);
+            pushResultCode(code, partId);
+          }
+          onFinished();
+        });
+  }
+
+ private:
+  explicit DrainLeadersProcessor(StorageEnv* env) : BaseProcessor<cpp2::AdminExecResp>(env) {}
+};
+
 /**
  * @brief Processor class to handle adding partitions.
  *
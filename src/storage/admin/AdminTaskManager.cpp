@@ -5,19 +5,37 @@
 
 #include "storage/admin/AdminTaskManager.h"
 
+#include <rocksdb/rate_limiter.h>
 #include <thrift/lib/cpp/protocol/TBinaryProtocol.h>
 #include <thrift/lib/cpp/transport/TBufferTransports.h>
 
 #include <tuple>
 
+#include "common/stats/StatsManager.h"
+#include "kvstore/RocksEngineConfig.h"
 #include "storage/admin/AdminTask.h"
 #include "storage/admin/AdminTaskProcessor.h"
 
 DEFINE_uint32(max_concurrent_subtasks, 10, "The sub tasks could be invoked simultaneously");
 
+DEFINE_int32(admin_task_read_latency_target_us,
+             0,
+             "When positive, admin tasks adaptively cut their io budget whenever the p99 "
+             "foreground read latency exceeds this target, and restore it once the latency "
+             "recovers. 0 keeps the static rate limits");
+
+DEFINE_double(compaction_min_rate_ratio,
+              0.3,
+              "Floor of the adaptive io budget of background flush and compaction, as a "
+              "fraction of rocksdb_rate_limit. Only takes effect when "
+              "admin_task_read_latency_target_us is set");
+
 namespace nebula {
 namespace storage {
 
+// How often the adaptive io budget reacts to the foreground latency
+constexpr size_t kIoBudgetCheckIntervalMs = 2 * 1000;
+
 bool AdminTaskManager::init() {
   LOG(INFO) << "max concurrent subtasks: " << FLAGS_max_concurrent_subtasks;
   auto threadFactory = std::make_shared<folly::NamedThreadFactory>("TaskManager");
@@ -35,12 +53,43 @@ bool AdminTaskManager::init() {
 
   shutdown_.store(false, std::memory_order_release);
   bgThread_->addTask(&AdminTaskManager::schedule, this);
+  bgThread_->addRepeatTask(kIoBudgetCheckIntervalMs, &AdminTaskManager::adjustIoBudget, this);
   ifAnyUnreported_ = true;
   handleUnreportedTasks();
   LOG(INFO) << "exit AdminTaskManager::init()";
   return true;
 }
 
+void AdminTaskManager::adjustIoBudget() {
+  if (FLAGS_admin_task_read_latency_target_us <= 0) {
+    ioBudgetRatio_.store(1.0, std::memory_order_relaxed);
+    return;
+  }
+  auto ratio = ioBudgetRatio_.load(std::memory_order_relaxed);
+  auto p99 = stats::StatsManager::readHisto(
+      "get_neighbors_latency_us", stats::StatsManager::TimeRange::FIVE_SECONDS, 0.99);
+  if (p99.ok() && p99.value() > FLAGS_admin_task_read_latency_target_us) {
+    // Foreground reads are hurting, cut the budget hard and recover slowly
+    ratio = std::max(0.01, ratio / 2);
+    LOG(INFO) << "Foreground read p99 " << p99.value() << "us is above the target "
+              << FLAGS_admin_task_read_latency_target_us << "us, admin task io budget cut to "
+              << ratio;
+  } else {
+    // Below target, or no foreground reads at all: restore the budget gradually
+    ratio = std::min(1.0, ratio + 0.1);
+  }
+  ioBudgetRatio_.store(ratio, std::memory_order_relaxed);
+
+  // Flush and compaction of all spaces share one rocksdb rate limiter, resize it in place so
+  // both manual compact tasks and automatic compactions back off together
+  auto rateLimiter = kvstore::rocksdbRateLimiter();
+  if (rateLimiter != nullptr) {
+    auto bytesPerSec = static_cast<int64_t>(static_cast<int64_t>(FLAGS_rocksdb_rate_limit) * 1024 *
+                                            1024 * std::max(FLAGS_compaction_min_rate_ratio, ratio));
+    rateLimiter->SetBytesPerSecond(std::max(bytesPerSec, static_cast<int64_t>(1)));
+  }
+}
+
 void AdminTaskManager::handleUnreportedTasks() {
   using futTuple =
       std::tuple<JobID, TaskID, std::string, folly::Future<StatusOr<nebula::cpp2::ErrorCode>>>;
@@ -71,6 +71,16 @@ class AdminTaskManager {
 
   bool isFinished(JobID jobID, TaskID taskID);
 
+  /**
+   * @brief Fraction of the configured io budget admin tasks should currently use, in (0, 1].
+   * Stays at 1 unless admin_task_read_latency_target_us is positive, in which case it is cut
+   * whenever the foreground read latency runs above the target and restored gradually once
+   * the latency recovers. Each task type clamps the ratio with its own floor flag.
+   */
+  double ioBudgetRatio() const {
+    return ioBudgetRatio_.load(std::memory_order_relaxed);
+  }
+
   void saveTaskStatus(GraphSpaceID spaceId,
                       JobID jobId,
                       TaskID taskId,
@@ -101,6 +111,12 @@ class AdminTaskManager {
 
   void runSubTask(TaskHandle handle);
 
+  /**
+   * @brief Periodically compare the foreground read latency against the target and adjust
+   * ioBudgetRatio_, multiplicative decrease and additive increase. Runs on bgThread_
+   */
+  void adjustIoBudget();
+
  private:
   std::atomic<bool> shutdown_{false};
   std::unique_ptr<ThreadPool> pool_{nullptr};
@@ -112,6 +128,7 @@ class AdminTaskManager {
   std::mutex unreportedMutex_;
   std::condition_variable unreportedCV_;
   bool ifAnyUnreported_{true};
+  std::atomic<double> ioBudgetRatio_{1.0};
 };
 
 }  // namespace storage
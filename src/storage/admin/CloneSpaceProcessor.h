@@ -0,0 +1,53 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_ADMIN_CLONESPACEPROCESSOR_H_
+#define STORAGE_ADMIN_CLONESPACEPROCESSOR_H_
+
+#include "storage/CommonUtils.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Processor class to clone the local data of one space into another.
+ */
+class CloneSpaceProcessor {
+ public:
+  /**
+   * @brief Construct a new instance of CloneSpaceProcessor.
+   *
+   * @param env Related environment variables for storage.
+   * @return CloneSpaceProcessor* CloneSpaceProcessor instance.
+   */
+  static CloneSpaceProcessor* instance(StorageEnv* env) {
+    return new CloneSpaceProcessor(env);
+  }
+
+  /**
+   * @brief Entry point to clone the space.
+   *
+   * @param req Request carrying the source and target space ids.
+   */
+  void process(const cpp2::CloneSpaceReq& req);
+
+  folly::Future<cpp2::CloneSpaceResp> getFuture() {
+    return promise_.getFuture();
+  }
+
+ private:
+  explicit CloneSpaceProcessor(StorageEnv* env) : env_(env) {}
+
+  void onFinished();
+
+  StorageEnv* env_{nullptr};  // Related environment variables for storage.
+  folly::Promise<cpp2::CloneSpaceResp> promise_;
+  cpp2::CloneSpaceResp resp_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_ADMIN_CLONESPACEPROCESSOR_H_
@@ -15,7 +15,19 @@ void CreateCheckpointProcessor::process(const cpp2::CreateCPRequest& req) {
 
   std::vector<nebula::cpp2::CheckpointInfo> ckInfoList;
   for (auto& spaceId : spaceIdList) {
-    auto ckRet = env_->kvstore_->createCheckpoint(spaceId, name);
+    // A space with a wal baseline gets an incremental checkpoint: only the wal
+    // tail since the previous backup is linked instead of a full rocksdb checkpoint
+    const std::unordered_map<PartitionID, LogID>* sinceLogIds = nullptr;
+    if (req.previous_log_ids_ref().has_value()) {
+      auto spaceIter = req.get_previous_log_ids()->find(spaceId);
+      if (spaceIter != req.get_previous_log_ids()->end()) {
+        sinceLogIds = &spaceIter->second;
+      }
+    }
+    auto* store = static_cast<kvstore::NebulaStore*>(env_->kvstore_);
+    auto ckRet = sinceLogIds != nullptr
+                     ? store->createIncrementalCheckpoint(spaceId, name, *sinceLogIds)
+                     : env_->kvstore_->createCheckpoint(spaceId, name);
     if (!ok(ckRet) && error(ckRet) == nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND) {
       LOG(INFO) << folly::sformat("Space {} to create backup is not found", spaceId);
       continue;
@@ -0,0 +1,31 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/admin/KillPlanProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+void KillPlanProcessor::process(const cpp2::KillPlanReq& req) {
+  auto sessionId = req.get_session_id();
+  auto planId = req.get_plan_id();
+  if (env_->planTracker_ == nullptr || !env_->planTracker_->kill(sessionId, planId)) {
+    // The plan either already finished here or never carried its ids in RequestCommon
+    this->resp_.code_ref() = nebula::cpp2::ErrorCode::E_QUERY_NOT_FOUND;
+    onFinished();
+    return;
+  }
+  LOG(INFO) << "Killed plan " << planId << " of session " << sessionId;
+  this->resp_.code_ref() = nebula::cpp2::ErrorCode::SUCCEEDED;
+  onFinished();
+}
+
+void KillPlanProcessor::onFinished() {
+  this->promise_.setValue(std::move(resp_));
+  delete this;
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,53 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_ADMIN_KILLPLANPROCESSOR_H_
+#define STORAGE_ADMIN_KILLPLANPROCESSOR_H_
+
+#include "storage/CommonUtils.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Processor class to abort an in-flight plan execution.
+ */
+class KillPlanProcessor {
+ public:
+  /**
+   * @brief Construct a new instance of KillPlanProcessor.
+   *
+   * @param env Related environment variables for storage.
+   * @return KillPlanProcessor* KillPlanProcessor instance.
+   */
+  static KillPlanProcessor* instance(StorageEnv* env) {
+    return new KillPlanProcessor(env);
+  }
+
+  /**
+   * @brief Entry point to kill the plan.
+   *
+   * @param req Request carrying the (session, plan) id to kill.
+   */
+  void process(const cpp2::KillPlanReq& req);
+
+  folly::Future<cpp2::KillPlanResp> getFuture() {
+    return promise_.getFuture();
+  }
+
+ private:
+  explicit KillPlanProcessor(StorageEnv* env) : env_(env) {}
+
+  void onFinished();
+
+  StorageEnv* env_{nullptr};  // Related environment variables for storage.
+  folly::Promise<cpp2::KillPlanResp> promise_;
+  cpp2::KillPlanResp resp_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_ADMIN_KILLPLANPROCESSOR_H_
@@ -5,9 +5,18 @@
 
 #include "storage/admin/RebuildIndexTask.h"
 
+#include <rocksdb/sst_file_writer.h>
+
+#include "common/fs/FileUtils.h"
 #include "common/utils/OperationKeyUtils.h"
 #include "kvstore/Common.h"
 #include "storage/StorageFlags.h"
+#include "storage/admin/AdminTaskManager.h"
+
+DEFINE_bool(rebuild_index_with_sst,
+            false,
+            "Bulk-build index entries of single-replica parts into sorted sst files and "
+            "ingest them into the local engine, instead of writing them through raft");
 
 namespace nebula {
 namespace storage {
@@ -41,6 +50,12 @@ RebuildIndexTask::RebuildIndexTask(StorageEnv* env, TaskContext&& ctx)
             << " for each subtask by default";
 }
 
+double RebuildIndexTask::rateLimit() const {
+  auto ratio =
+      std::max(FLAGS_rebuild_index_min_rate_ratio, AdminTaskManager::instance()->ioBudgetRatio());
+  return FLAGS_rebuild_index_part_rate_limit * ratio;
+}
+
 ErrorOr<nebula::cpp2::ErrorCode, std::vector<AdminSubTask>> RebuildIndexTask::genSubTasks() {
   space_ = *ctx_.parameters_.space_id_ref();
   auto parts = *ctx_.parameters_.parts_ref();
@@ -234,16 +249,95 @@ nebula::cpp2::ErrorCode RebuildIndexTask::removeLegacyLogs(GraphSpaceID space, P
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+bool RebuildIndexTask::canIngestLocally(GraphSpaceID space, PartitionID part) {
+  if (!FLAGS_rebuild_index_with_sst) {
+    return false;
+  }
+  auto partRet = env_->kvstore_->part(space, part);
+  if (!ok(partRet)) {
+    return false;
+  }
+  return nebula::value(partRet)->peers().size() <= 1;
+}
+
+nebula::cpp2::ErrorCode RebuildIndexTask::writeSst(GraphSpaceID space,
+                                                   PartitionID part,
+                                                   std::vector<kvstore::KV> data,
+                                                   size_t batchSize,
+                                                   kvstore::RateLimiter* rateLimiter) {
+  if (data.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  auto partRet = env_->kvstore_->part(space, part);
+  if (!ok(partRet)) {
+    return error(partRet);
+  }
+  auto* engine = nebula::value(partRet)->engine();
+  // SstFileWriter requires its keys in ascending order
+  std::sort(data.begin(), data.end(), [](const auto& lhs, const auto& rhs) {
+    return lhs.first < rhs.first;
+  });
+  auto dir = folly::stringPrintf("%s/rebuild_index_ingest", engine->getDataRoot());
+  if (fs::FileUtils::fileType(dir.c_str()) == fs::FileType::NOTEXIST &&
+      !fs::FileUtils::makeDir(dir)) {
+    LOG(WARNING) << "Failed to create rebuild index sst dir " << dir;
+    return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+  }
+  auto path = folly::stringPrintf(
+      "%s/part%d_%ld.sst", dir.c_str(), part, static_cast<long>(sstFileSeq_.fetch_add(1)));
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), rocksdb::Options());
+  auto status = writer.Open(path);
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to open rebuild index sst " << path << ": " << status.ToString();
+    return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+  }
+  const std::string* prevKey = nullptr;
+  for (auto& kv : data) {
+    // a multi-column index may yield the same key twice for one row, skip the duplicate
+    if (prevKey != nullptr && *prevKey == kv.first) {
+      continue;
+    }
+    status = writer.Put(rocksdb::Slice(kv.first.data(), kv.first.size()),
+                        rocksdb::Slice(kv.second.data(), kv.second.size()));
+    if (!status.ok()) {
+      LOG(WARNING) << "Failed to write rebuild index sst: " << status.ToString();
+      writer.Finish();
+      unlink(path.c_str());
+      return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+    }
+    prevKey = &kv.first;
+  }
+  status = writer.Finish();
+  if (!status.ok()) {
+    LOG(WARNING) << "Failed to finish rebuild index sst " << path << ": " << status.ToString();
+    unlink(path.c_str());
+    return nebula::cpp2::ErrorCode::E_STORE_FAILURE;
+  }
+  auto rate = rateLimit();
+  rateLimiter->consume(static_cast<double>(batchSize),  // toConsume
+                       rate,                            // rate
+                       rate);                           // burstSize
+  // Batches of one part arrive in scan order but their index keys are not globally
+  // sorted, so files of one part may overlap and each one is ingested on its own.
+  auto code = engine->ingest({path}, false);
+  unlink(path.c_str());
+  return code;
+}
+
 nebula::cpp2::ErrorCode RebuildIndexTask::writeData(GraphSpaceID space,
                                                     PartitionID part,
                                                     std::vector<kvstore::KV> data,
                                                     size_t batchSize,
                                                     kvstore::RateLimiter* rateLimiter) {
+  if (canIngestLocally(space, part)) {
+    return writeSst(space, part, std::move(data), batchSize, rateLimiter);
+  }
   folly::Baton<true, std::atomic> baton;
   auto result = nebula::cpp2::ErrorCode::SUCCEEDED;
-  rateLimiter->consume(static_cast<double>(batchSize),                             // toConsume
-                       static_cast<double>(FLAGS_rebuild_index_part_rate_limit),   // rate
-                       static_cast<double>(FLAGS_rebuild_index_part_rate_limit));  // burstSize
+  auto rate = rateLimit();
+  rateLimiter->consume(static_cast<double>(batchSize),  // toConsume
+                       rate,                            // rate
+                       rate);                           // burstSize
   env_->kvstore_->asyncMultiPut(
       space, part, std::move(data), [&result, &baton](nebula::cpp2::ErrorCode code) {
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -262,9 +356,10 @@ nebula::cpp2::ErrorCode RebuildIndexTask::writeOperation(GraphSpaceID space,
   folly::Baton<true, std::atomic> baton;
   auto result = nebula::cpp2::ErrorCode::SUCCEEDED;
   auto encoded = encodeBatchValue(batchHolder->getBatch());
-  rateLimiter->consume(static_cast<double>(batchHolder->size()),                   // toConsume
-                       static_cast<double>(FLAGS_rebuild_index_part_rate_limit),   // rate
-                       static_cast<double>(FLAGS_rebuild_index_part_rate_limit));  // burstSize
+  auto rate = rateLimit();
+  rateLimiter->consume(static_cast<double>(batchHolder->size()),  // toConsume
+                       rate,                                      // rate
+                       rate);                                     // burstSize
   env_->kvstore_->asyncAppendBatch(
       space, part, std::move(encoded), [&result, &baton](nebula::cpp2::ErrorCode code) {
         if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
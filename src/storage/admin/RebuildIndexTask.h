@@ -60,12 +60,36 @@ class RebuildIndexTask : public AdminTask {
   // Remove the legacy operation log to make sure the index is correct.
   nebula::cpp2::ErrorCode removeLegacyLogs(GraphSpaceID space, PartitionID part);
 
+  /**
+   * @brief Current write rate of each subtask in bytes per second: the configured part rate
+   * limit scaled by the adaptive io budget, clamped by rebuild_index_min_rate_ratio
+   */
+  double rateLimit() const;
+
   nebula::cpp2::ErrorCode writeData(GraphSpaceID space,
                                     PartitionID part,
                                     std::vector<kvstore::KV> data,
                                     size_t batchSize,
                                     kvstore::RateLimiter* rateLimiter);
 
+  /**
+   * @brief Whether the bulk phase of this part may bypass raft and ingest sorted sst
+   * files into the local engine directly. Followers only receive index entries through
+   * raft replication of the rebuild puts, so the sst shortcut is limited to
+   * single-replica parts.
+   */
+  bool canIngestLocally(GraphSpaceID space, PartitionID part);
+
+  /**
+   * @brief Sort one batch of index entries and ingest them as an sst file, sparing the
+   * raft and rocksdb wal entirely.
+   */
+  nebula::cpp2::ErrorCode writeSst(GraphSpaceID space,
+                                   PartitionID part,
+                                   std::vector<kvstore::KV> data,
+                                   size_t batchSize,
+                                   kvstore::RateLimiter* rateLimiter);
+
   nebula::cpp2::ErrorCode writeOperation(GraphSpaceID space,
                                          PartitionID part,
                                          kvstore::BatchHolder* batchHolder,
@@ -76,6 +100,8 @@ class RebuildIndexTask : public AdminTask {
  protected:
   GraphSpaceID space_;
   bool changedSpaceGuard_{false};
+  // Sequence for unique sst file names, subtasks of different parts run concurrently
+  std::atomic<int64_t> sstFileSeq_{0};
 };
 
 }  // namespace storage
@@ -7,10 +7,12 @@
 
 #include <thrift/lib/cpp/util/EnumUtils.h>
 
+#include "common/algorithm/HyperLogLog.h"
 #include "common/base/MurmurHash2.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/Common.h"
 #include "storage/StorageFlags.h"
+#include "storage/stats/ApproxStats.h"
 
 DEFINE_int32(stats_sleep_interval_ms,
              0,
@@ -35,7 +37,7 @@ nebula::cpp2::ErrorCode StatsTask::getSchemas(GraphSpaceID spaceId) {
     return nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND;
   }
 
-  for (auto tag : tags.value()) {
+  for (const auto& tag : *tags.value()) {
     auto tagId = tag.first;
     auto tagNameRet = env_->schemaMan_->toTagName(spaceId, tagId);
     if (!tagNameRet.ok()) {
@@ -45,7 +47,7 @@ nebula::cpp2::ErrorCode StatsTask::getSchemas(GraphSpaceID spaceId) {
     tags_.emplace(tagId, std::move(tagNameRet.value()));
   }
 
-  for (auto edge : edges.value()) {
+  for (const auto& edge : *edges.value()) {
     auto edgeType = edge.first;
     auto edgeNameRet = env_->schemaMan_->toEdgeName(spaceId, std::abs(edgeType));
     if (!edgeNameRet.ok()) {
@@ -154,6 +156,12 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
 
   VertexID lastVertexId = "";
 
+  // The scan below seeds the continuously maintained sketches, the mutate processors
+  // keep them current between stats jobs
+  if (FLAGS_enable_approx_stats) {
+    ApproxStats::instance().resetPart(spaceId, part);
+  }
+
   // Only stats valid vertex data, no multi version
   // For example
   // Vid  tagId
@@ -185,6 +193,9 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
       tagsVertices[tagId] += 1;
       spaceVertices++;
       lastVertexId = vId;
+      if (FLAGS_enable_approx_stats) {
+        ApproxStats::instance().addVertex(spaceId, part, vId);
+      }
     }
 
     tagIter->next();
@@ -218,6 +229,9 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
     if (edgeType > 0) {
       spaceEdges++;
       edgetypeEdges[edgeType] += 1;
+      if (FLAGS_enable_approx_stats) {
+        ApproxStats::instance().addOutEdge(spaceId, part, source);
+      }
 
       uint64_t destinationVid = 0;
       if (isIntId) {
@@ -303,6 +317,12 @@ nebula::cpp2::ErrorCode StatsTask::genSubTask(GraphSpaceID spaceId,
   negativePartCorrelativities[part] = negativeCorrelativity;
   statsItem.negative_part_correlativity_ref() = std::move(negativePartCorrelativities);
 
+  if (FLAGS_enable_approx_stats) {
+    auto snap = ApproxStats::instance().snapshot(spaceId, part);
+    statsItem.vid_sketch_ref() = std::move(snap.vidSketch);
+    statsItem.degree_histogram_ref() = std::move(snap.degreeHistogram);
+  }
+
   statistics_.emplace(part, std::move(statsItem));
   LOG(INFO) << "Stats task finished";
   return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -350,6 +370,24 @@ void StatsTask::finish(nebula::cpp2::ErrorCode rc) {
       (*result.negative_part_correlativity_ref())
           .insert((*item.negative_part_correlativity_ref()).begin(),
                   (*item.negative_part_correlativity_ref()).end());
+
+      if (item.vid_sketch_ref().has_value()) {
+        if (!result.vid_sketch_ref().has_value()) {
+          result.vid_sketch_ref() = *item.vid_sketch_ref();
+        } else {
+          algorithm::HyperLogLog::mergeSerialized(*result.vid_sketch_ref(),
+                                                  *item.vid_sketch_ref());
+        }
+      }
+      if (item.degree_histogram_ref().has_value()) {
+        if (!result.degree_histogram_ref().has_value()) {
+          result.degree_histogram_ref() = *item.degree_histogram_ref();
+        } else {
+          for (auto& [bucket, count] : *item.degree_histogram_ref()) {
+            (*result.degree_histogram_ref())[bucket] += count;
+          }
+        }
+      }
     }
     result.status_ref() = nebula::meta::cpp2::JobStatus::FINISHED;
     ctx_.onFinish_(rc, result);
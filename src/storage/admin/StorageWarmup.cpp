@@ -0,0 +1,62 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/admin/StorageWarmup.h"
+
+#include "common/base/Logging.h"
+#include "common/time/Duration.h"
+
+DEFINE_bool(warmup_on_start,
+            false,
+            "Whether to prime the rocksdb block cache and the OS page cache before the "
+            "storage service starts serving, making rolling restarts latency-neutral");
+DEFINE_int64(warmup_read_limit_mb,
+             4096,
+             "Upper bound of the bytes the startup warmup reads through the engines, "
+             "usually set close to the block cache capacity");
+
+namespace nebula {
+namespace storage {
+
+void StorageWarmup::warmup(kvstore::NebulaStore* store,
+                           const std::vector<GraphSpaceID>& spaceIds) {
+  auto budget = FLAGS_warmup_read_limit_mb << 20;
+  int64_t readBytes = 0;
+  time::Duration timer;
+  for (auto spaceId : spaceIds) {
+    auto errOrSpace = store->space(spaceId);
+    if (!ok(errOrSpace)) {
+      // The space is not served by this host
+      continue;
+    }
+    auto space = nebula::value(errOrSpace);
+    for (auto& engine : space->engines_) {
+      if (readBytes >= budget) {
+        break;
+      }
+      std::unique_ptr<kvstore::KVIterator> iter;
+      auto code = engine->scan(&iter);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        LOG(WARNING) << "Warmup scan of space " << spaceId << " failed, skipped";
+        continue;
+      }
+      // Reading through the engine pulls the blocks into the block cache and the
+      // underlying sst files into the page cache
+      while (iter->valid() && readBytes < budget) {
+        readBytes += iter->key().size() + iter->val().size();
+        iter->next();
+      }
+    }
+    if (readBytes >= budget) {
+      LOG(INFO) << "Warmup read limit reached at space " << spaceId;
+      break;
+    }
+  }
+  LOG(INFO) << "Cache warmup read " << readBytes << " bytes in " << timer.elapsedInMSec()
+            << " ms";
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,40 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_ADMIN_STORAGEWARMUP_H_
+#define STORAGE_ADMIN_STORAGEWARMUP_H_
+
+#include "common/base/Base.h"
+#include "kvstore/NebulaStore.h"
+
+DECLARE_bool(warmup_on_start);
+DECLARE_int64(warmup_read_limit_mb);
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Prime the rocksdb block cache and the OS page cache of the local spaces after a
+ * restart. A freshly restarted storaged serves its first minutes of traffic from disk, so
+ * the warmup runs before the storage service starts answering requests, see
+ * FLAGS_warmup_on_start.
+ */
+class StorageWarmup final {
+ public:
+  StorageWarmup() = delete;
+
+  /**
+   * @brief Sequentially read the data of the given spaces through their engines until
+   * FLAGS_warmup_read_limit_mb bytes have been pulled in. Blocks the calling thread.
+   *
+   * @param store Local kv store
+   * @param spaceIds Spaces to warm up, ids not served by this host are skipped
+   */
+  static void warmup(kvstore::NebulaStore* store, const std::vector<GraphSpaceID>& spaceIds);
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_ADMIN_STORAGEWARMUP_H_
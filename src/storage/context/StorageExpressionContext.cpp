@@ -25,6 +25,39 @@ const Value& StorageExpressionContext::getInnerVar(const std::string& var) const
   return it->second;
 }
 
+const StorageExpressionContext::PropBinding* StorageExpressionContext::findBinding(
+    const std::string& name, const std::string& prop) const {
+  if (bindings_ == nullptr || reader_ == nullptr) {
+    return nullptr;
+  }
+  for (const auto& binding : *bindings_) {
+    // pointer identity hits when the reference comes from the very expression the binding
+    // was built from, the string comparison covers copies like the split-off tag filter
+    if ((binding.prop == &prop || *binding.prop == prop) &&
+        (binding.name == &name || *binding.name == name)) {
+      if (binding.fieldSchema == reader_->getSchema()) {
+        return &binding;
+      }
+      // a row of an older schema version, take the name based path
+      return nullptr;
+    }
+  }
+  return nullptr;
+}
+
+Value StorageExpressionContext::boundValue(const PropBinding& binding) const {
+  auto value = reader_->getValueByField(binding.field);
+  if (value.type() == Value::Type::NULLVALUE) {
+    // a nullable field really holds null, the field descriptor rules out UNKNOWN_PROP
+    return value;
+  }
+  if (binding.field->type() == nebula::cpp2::PropertyType::FIXED_STRING) {
+    const auto& fixedStr = value.getStr();
+    return fixedStr.substr(0, fixedStr.find_first_of('\0'));
+  }
+  return value;
+}
+
 Value StorageExpressionContext::readValue(const std::string& propName) const {
   if (!schema_) {
     return Value::kNullValue;
@@ -39,50 +72,23 @@ Value StorageExpressionContext::readValue(const std::string& propName) const {
 }
 
 // Get the specified property from the tag, such as tag_name.prop_name
-Value StorageExpressionContext::getTagProp(const std::string& tagName,
-                                           const std::string& prop) const {
+const Value& StorageExpressionContext::getTagProp(const std::string& tagName,
+                                                  const std::string& prop) const {
   if (isIndex_) {
-    return getIndexValue(prop, false);
+    propScratch_ = getIndexValue(prop, false);
+    return propScratch_;
   }
   return getSrcProp(tagName, prop);
 }
 
 // Get the specified property from the edge, such as edgename.prop_name
-Value StorageExpressionContext::getEdgeProp(const std::string& edgeName,
-                                            const std::string& prop) const {
+const Value& StorageExpressionContext::getEdgeProp(const std::string& edgeName,
+                                                   const std::string& prop) const {
   if (isIndex_) {
-    return getIndexValue(prop, true);
+    propScratch_ = getIndexValue(prop, true);
+    return propScratch_;
   }
-  if (isEdge_ && reader_ != nullptr) {
-    if (edgeName != name_) {
-      return Value::kEmpty;
-    }
-    if (prop == kSrc) {
-      auto srcId = NebulaKeyUtils::getSrcId(vIdLen_, key_);
-      if (isIntId_) {
-        int64_t val;
-        memcpy(reinterpret_cast<void*>(&val), srcId.begin(), sizeof(int64_t));
-        return val;
-      } else {
-        return srcId.subpiece(0, srcId.find_first_of('\0')).toString();
-      }
-    } else if (prop == kDst) {
-      auto dstId = NebulaKeyUtils::getDstId(vIdLen_, key_);
-      if (isIntId_) {
-        int64_t val;
-        memcpy(reinterpret_cast<void*>(&val), dstId.begin(), sizeof(int64_t));
-        return val;
-      } else {
-        return dstId.subpiece(0, dstId.find_first_of('\0')).toString();
-      }
-    } else if (prop == kRank) {
-      return NebulaKeyUtils::getRank(vIdLen_, key_);
-    } else if (prop == kType) {
-      return NebulaKeyUtils::getEdgeType(vIdLen_, key_);
-    } else {
-      return readValue(prop);
-    }
-  } else {
+  if (!(isEdge_ && reader_ != nullptr)) {
     auto iter = edgeFilters_.find(std::make_pair(edgeName, prop));
     if (iter == edgeFilters_.end()) {
       return Value::kEmpty;
@@ -90,29 +96,13 @@ Value StorageExpressionContext::getEdgeProp(const std::string& edgeName,
     VLOG(1) << "Hit srcProp filter for edge " << edgeName << ", prop " << prop;
     return iter->second;
   }
+  propScratch_ = edgePropValue(edgeName, prop);
+  return propScratch_;
 }
 
-Value StorageExpressionContext::getSrcProp(const std::string& tagName,
-                                           const std::string& prop) const {
-  if (!isEdge_ && reader_ != nullptr) {
-    if (tagName != name_) {
-      return Value::kEmpty;
-    }
-    if (prop == kVid) {
-      auto vId = NebulaKeyUtils::getVertexId(vIdLen_, key_);
-      if (isIntId_) {
-        int64_t val;
-        memcpy(reinterpret_cast<void*>(&val), vId.begin(), sizeof(int64_t));
-        return val;
-      } else {
-        return vId.subpiece(0, vId.find_first_of('\0')).toString();
-      }
-    } else if (prop == kTag) {
-      return NebulaKeyUtils::getTagId(vIdLen_, key_);
-    } else {
-      return readValue(prop);
-    }
-  } else {
+const Value& StorageExpressionContext::getSrcProp(const std::string& tagName,
+                                                  const std::string& prop) const {
+  if (!(!isEdge_ && reader_ != nullptr)) {
     auto iter = tagFilters_.find(std::make_pair(tagName, prop));
     if (iter == tagFilters_.end()) {
       return Value::kEmpty;
@@ -120,6 +110,67 @@ Value StorageExpressionContext::getSrcProp(const std::string& tagName,
     VLOG(1) << "Hit srcProp filter for tag " << tagName << ", prop " << prop;
     return iter->second;
   }
+  propScratch_ = srcPropValue(tagName, prop);
+  return propScratch_;
+}
+
+Value StorageExpressionContext::edgePropValue(const std::string& edgeName,
+                                              const std::string& prop) const {
+  if (edgeName != name_) {
+    return Value::kEmpty;
+  }
+  if (prop == kSrc) {
+    auto srcId = NebulaKeyUtils::getSrcId(vIdLen_, key_);
+    if (isIntId_) {
+      int64_t val;
+      memcpy(reinterpret_cast<void*>(&val), srcId.begin(), sizeof(int64_t));
+      return val;
+    } else {
+      return srcId.subpiece(0, srcId.find_first_of('\0')).toString();
+    }
+  } else if (prop == kDst) {
+    auto dstId = NebulaKeyUtils::getDstId(vIdLen_, key_);
+    if (isIntId_) {
+      int64_t val;
+      memcpy(reinterpret_cast<void*>(&val), dstId.begin(), sizeof(int64_t));
+      return val;
+    } else {
+      return dstId.subpiece(0, dstId.find_first_of('\0')).toString();
+    }
+  } else if (prop == kRank) {
+    return NebulaKeyUtils::getRank(vIdLen_, key_);
+  } else if (prop == kType) {
+    return NebulaKeyUtils::getEdgeType(vIdLen_, key_);
+  } else {
+    if (const auto* binding = findBinding(edgeName, prop)) {
+      return boundValue(*binding);
+    }
+    return readValue(prop);
+  }
+}
+
+Value StorageExpressionContext::srcPropValue(const std::string& tagName,
+                                             const std::string& prop) const {
+  if (tagName != name_) {
+    return Value::kEmpty;
+  }
+  if (prop == kVid) {
+    auto vId = NebulaKeyUtils::getVertexId(vIdLen_, key_);
+    if (isIntId_) {
+      int64_t val;
+      memcpy(reinterpret_cast<void*>(&val), vId.begin(), sizeof(int64_t));
+      return val;
+    } else {
+      return vId.subpiece(0, vId.find_first_of('\0')).toString();
+    }
+  } else if (prop == kTag) {
+    return NebulaKeyUtils::getTagId(vIdLen_, key_);
+  } else {
+    if (const auto* binding = findBinding(tagName, prop)) {
+      return boundValue(*binding);
+    }
+    return readValue(prop);
+  }
 }
 
 Value StorageExpressionContext::getIndexValue(const std::string& prop, bool isEdge) const {
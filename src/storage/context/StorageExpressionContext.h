@@ -31,6 +31,21 @@ namespace storage {
  */
 class StorageExpressionContext final : public ExpressionContext {
  public:
+  /**
+   * @brief A filter prop reference resolved to its field descriptor at context build time.
+   *
+   * name and prop point into the filter expression itself, which outlives the expression
+   * contexts of the request, so evaluation can match them by pointer identity without
+   * hashing. The descriptor only applies to rows encoded with fieldSchema, older rows
+   * take the name based path.
+   */
+  struct PropBinding {
+    const std::string* name;
+    const std::string* prop;
+    const meta::NebulaSchemaProvider::SchemaField* field;
+    const meta::NebulaSchemaProvider* fieldSchema;
+  };
+
   StorageExpressionContext(size_t vIdLen,
                            bool isIntId,
                            const std::string& name = "",
@@ -132,18 +147,19 @@ class StorageExpressionContext final : public ExpressionContext {
    *
    * @param tagName Given tag name.
    * @param prop Given property name.
-   * @return Value
+   * @return const Value& Reference into a scratch slot of the context, valid until the
+   *         next property access.
    */
-  Value getTagProp(const std::string& tagName, const std::string& prop) const override;
+  const Value& getTagProp(const std::string& tagName, const std::string& prop) const override;
 
   /**
    * @brief Get the specified property from the edge, such as edgename.prop_name
    *
    * @param edgeName Given edge name.
    * @param prop Given property name.
-   * @return Value
+   * @return const Value&
    */
-  Value getEdgeProp(const std::string& edgeName, const std::string& prop) const override;
+  const Value& getEdgeProp(const std::string& edgeName, const std::string& prop) const override;
 
   /**
    * @brief Get the specified property of tagName from the source vertex,
@@ -151,9 +167,9 @@ class StorageExpressionContext final : public ExpressionContext {
    *
    * @param tagName Given tag name.
    * @param prop Given property name.
-   * @return Value
+   * @return const Value&
    */
-  Value getSrcProp(const std::string& tagName, const std::string& prop) const override;
+  const Value& getSrcProp(const std::string& tagName, const std::string& prop) const override;
 
   /**
    * @brief Get vid length.
@@ -250,6 +266,13 @@ class StorageExpressionContext final : public ExpressionContext {
     isEdge_ = isEdge;
   }
 
+  /**
+   * @brief Name of the tag or edge the current reader belongs to
+   */
+  const std::string& schemaName() const {
+    return name_;
+  }
+
   /**
    * @brief Set the Tag Prop object
    *
@@ -281,6 +304,14 @@ class StorageExpressionContext final : public ExpressionContext {
     edgeFilters_.clear();
   }
 
+  /**
+   * @brief Attach the prop references the processor pre-bound while building contexts,
+   * the vector has to outlive this context.
+   */
+  void setPropBindings(const std::vector<PropBinding>* bindings) {
+    bindings_ = bindings;
+  }
+
   /**
    * @brief Read value by property name.
    *
@@ -299,6 +330,16 @@ class StorageExpressionContext final : public ExpressionContext {
   Value getIndexValue(const std::string& prop, bool isEdge) const;
 
  private:
+  // By-value workers behind the reference returning getters above
+  Value srcPropValue(const std::string& tagName, const std::string& prop) const;
+  Value edgePropValue(const std::string& edgeName, const std::string& prop) const;
+
+  // The binding of the given reference when the current row is encoded with the schema it
+  // was resolved against, nullptr otherwise
+  const PropBinding* findBinding(const std::string& name, const std::string& prop) const;
+  // Read the field of the current row through a matched binding
+  Value boundValue(const PropBinding& binding) const;
+
   size_t vIdLen_;
   bool isIntId_;
 
@@ -327,6 +368,13 @@ class StorageExpressionContext final : public ExpressionContext {
 
   // Expression value map that stores the value of innerVar
   std::unordered_map<std::string, Value> exprValueMap_;
+
+  // Filter prop references pre-bound to field descriptors, owned by the processor
+  const std::vector<PropBinding>* bindings_{nullptr};
+
+  // Scratch slot backing the references returned by the property getters, reused across
+  // rows so repeated reads of same-shaped values do not reallocate
+  mutable Value propScratch_;
 };
 
 }  // namespace storage
@@ -32,7 +32,7 @@ struct PropStat {
 // `next`, so if you want to get the final result, be sure to call
 // `calculateStat` and then retrieve the result
 template <typename T>
-class AggregateNode : public IterateNode<T> {
+class AggregateNode final : public IterateNode<T> {
  public:
   using RelNode<T>::doExecute;
 
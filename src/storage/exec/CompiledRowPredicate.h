@@ -0,0 +1,336 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_EXEC_COMPILEDROWPREDICATE_H_
+#define STORAGE_EXEC_COMPILEDROWPREDICATE_H_
+
+#include "codec/RowReaderWrapper.h"
+#include "common/base/Base.h"
+#include "common/expression/BinaryExpression.h"
+#include "common/expression/ConstantExpression.h"
+#include "common/expression/LogicalExpression.h"
+#include "common/expression/PropertyExpression.h"
+#include "common/meta/NebulaSchemaProvider.h"
+#include "common/utils/NebulaKeyUtils.h"
+
+namespace nebula {
+namespace storage {
+
+/*
+CompiledRowPredicate is the fast path of a pushed-down filter. When the filter is a
+conjunction of comparisons between fixed-width edge properties (or the edge rank) and numeric
+constants, the terms are compiled once against a concrete schema version into field offsets
+and operands, and each row is then checked directly over its encoded bytes: no Value is
+built and the expression tree is never walked. The caller must only evaluate rows whose
+reader was reset with the very schema the predicate was compiled against, since the offsets
+are meaningless under any other layout. A filter the compiler does not recognize simply
+yields no predicate and the interpreter path is kept.
+
+The semantics match the interpreter: a NULL property never passes, comparisons involving a
+floating field or constant are done in double, everything else in int64.
+*/
+class CompiledRowPredicate {
+ public:
+  /**
+   * @brief Try to compile the filter against one schema version.
+   *
+   * @param exp The pushed-down filter.
+   * @param schema Schema the rows to be checked are encoded with.
+   * @param edgeName Name of the edge the rows belong to, property references to any other
+   * schema reject the compilation.
+   * @return The compiled predicate, or nullptr when the filter is not recognized.
+   */
+  static std::unique_ptr<CompiledRowPredicate> tryCompile(const Expression* exp,
+                                                          const meta::NebulaSchemaProvider* schema,
+                                                          const std::string& edgeName) {
+    if (exp == nullptr || schema == nullptr || edgeName.empty()) {
+      return nullptr;
+    }
+    auto pred = std::make_unique<CompiledRowPredicate>();
+    if (!pred->compile(exp, schema, edgeName)) {
+      return nullptr;
+    }
+    return pred;
+  }
+
+  /**
+   * @brief Check one encoded row, all terms must pass.
+   *
+   * @param reader Reader the row was reset with, only used to reach the encoded bytes.
+   * @param key The edge key, for rank terms.
+   * @param vIdLen Vertex id length of the space, for rank terms.
+   */
+  bool eval(const RowReaderWrapper* reader, folly::StringPiece key, size_t vIdLen) const {
+    auto row = reader->rawData();
+    size_t headerLen = reader->headerLen();
+    size_t base = headerLen + reader->numNullBytes();
+    for (const auto& term : terms_) {
+      if (!evalTerm(term, row, headerLen, base, key, vIdLen)) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+ private:
+  enum class Op : uint8_t {
+    kLT = 0,
+    kLE,
+    kGT,
+    kGE,
+    kEQ,
+    kNE,
+    kIn,
+  };
+
+  struct Term {
+    const meta::NebulaSchemaProvider::SchemaField* field{nullptr};  // nullptr means rank
+    Op op;
+    bool asDouble{false};
+    int64_t iOperand{0};
+    double dOperand{0.0};
+    std::vector<int64_t> iSet;  // sorted, for kIn
+  };
+
+  bool compile(const Expression* exp,
+               const meta::NebulaSchemaProvider* schema,
+               const std::string& edgeName) {
+    switch (exp->kind()) {
+      case Expression::Kind::kLogicalAnd: {
+        const auto* logic = static_cast<const LogicalExpression*>(exp);
+        for (const auto* operand : logic->operands()) {
+          if (!compile(operand, schema, edgeName)) {
+            return false;
+          }
+        }
+        return true;
+      }
+      case Expression::Kind::kRelEQ:
+      case Expression::Kind::kRelNE:
+      case Expression::Kind::kRelLT:
+      case Expression::Kind::kRelLE:
+      case Expression::Kind::kRelGT:
+      case Expression::Kind::kRelGE:
+      case Expression::Kind::kRelIn:
+        return compileRelational(static_cast<const BinaryExpression*>(exp), schema, edgeName);
+      default:
+        return false;
+    }
+  }
+
+  bool compileRelational(const BinaryExpression* rel,
+                         const meta::NebulaSchemaProvider* schema,
+                         const std::string& edgeName) {
+    const auto* lhs = rel->left();
+    const auto* rhs = rel->right();
+    bool flipped = false;
+    if (lhs->kind() == Expression::Kind::kConstant && rel->kind() != Expression::Kind::kRelIn) {
+      std::swap(lhs, rhs);
+      flipped = true;
+    }
+    if (rhs->kind() != Expression::Kind::kConstant) {
+      return false;
+    }
+    const auto& constVal = static_cast<const ConstantExpression*>(rhs)->value();
+
+    Term term;
+    switch (rel->kind()) {
+      case Expression::Kind::kRelEQ:
+        term.op = Op::kEQ;
+        break;
+      case Expression::Kind::kRelNE:
+        term.op = Op::kNE;
+        break;
+      case Expression::Kind::kRelLT:
+        term.op = flipped ? Op::kGT : Op::kLT;
+        break;
+      case Expression::Kind::kRelLE:
+        term.op = flipped ? Op::kGE : Op::kLE;
+        break;
+      case Expression::Kind::kRelGT:
+        term.op = flipped ? Op::kLT : Op::kGT;
+        break;
+      case Expression::Kind::kRelGE:
+        term.op = flipped ? Op::kLE : Op::kGE;
+        break;
+      case Expression::Kind::kRelIn:
+        term.op = Op::kIn;
+        break;
+      default:
+        return false;
+    }
+
+    if (!resolveField(lhs, schema, edgeName, term)) {
+      return false;
+    }
+
+    if (term.op == Op::kIn) {
+      // only integral sets over integral fields, membership is a binary search
+      if (term.asDouble || !constVal.isList()) {
+        return false;
+      }
+      for (const auto& v : constVal.getList().values) {
+        if (!v.isInt()) {
+          return false;
+        }
+        term.iSet.emplace_back(v.getInt());
+      }
+      std::sort(term.iSet.begin(), term.iSet.end());
+    } else if (constVal.isInt()) {
+      term.iOperand = constVal.getInt();
+      term.dOperand = static_cast<double>(constVal.getInt());
+    } else if (constVal.isFloat()) {
+      term.asDouble = true;
+      term.dOperand = constVal.getFloat();
+    } else {
+      return false;
+    }
+    terms_.emplace_back(std::move(term));
+    return true;
+  }
+
+  bool resolveField(const Expression* exp,
+                    const meta::NebulaSchemaProvider* schema,
+                    const std::string& edgeName,
+                    Term& term) {
+    std::string propName;
+    switch (exp->kind()) {
+      case Expression::Kind::kEdgeRank:
+      case Expression::Kind::kEdgeProperty: {
+        const auto* propExp = static_cast<const PropertyExpression*>(exp);
+        if (propExp->sym() != edgeName) {
+          return false;
+        }
+        propName = propExp->prop();
+        break;
+      }
+      default:
+        return false;
+    }
+    if (propName == kRank || exp->kind() == Expression::Kind::kEdgeRank) {
+      // rank lives in the key, field stays nullptr
+      return true;
+    }
+    auto index = schema->getFieldIndex(propName);
+    if (index < 0) {
+      return false;
+    }
+    const auto* field = schema->field(index);
+    switch (field->type()) {
+      case nebula::cpp2::PropertyType::INT8:
+      case nebula::cpp2::PropertyType::INT16:
+      case nebula::cpp2::PropertyType::INT32:
+      case nebula::cpp2::PropertyType::INT64:
+      case nebula::cpp2::PropertyType::TIMESTAMP:
+        break;
+      case nebula::cpp2::PropertyType::FLOAT:
+      case nebula::cpp2::PropertyType::DOUBLE:
+        term.asDouble = true;
+        break;
+      default:
+        return false;
+    }
+    term.field = field;
+    return true;
+  }
+
+  static bool evalTerm(const Term& term,
+                       folly::StringPiece row,
+                       size_t headerLen,
+                       size_t base,
+                       folly::StringPiece key,
+                       size_t vIdLen) {
+    int64_t iVal = 0;
+    double dVal = 0.0;
+    if (term.field == nullptr) {
+      iVal = NebulaKeyUtils::getRank(vIdLen, key);
+      dVal = static_cast<double>(iVal);
+    } else {
+      const auto* field = term.field;
+      if (field->nullable() && checkNullBit(row, headerLen, field->nullFlagPos())) {
+        // NULL never passes, same as the interpreter
+        return false;
+      }
+      size_t offset = base + field->offset();
+      switch (field->type()) {
+        case nebula::cpp2::PropertyType::INT8:
+          iVal = static_cast<int8_t>(row[offset]);
+          break;
+        case nebula::cpp2::PropertyType::INT16: {
+          int16_t val;
+          memcpy(reinterpret_cast<void*>(&val), &row[offset], sizeof(int16_t));
+          iVal = val;
+          break;
+        }
+        case nebula::cpp2::PropertyType::INT32: {
+          int32_t val;
+          memcpy(reinterpret_cast<void*>(&val), &row[offset], sizeof(int32_t));
+          iVal = val;
+          break;
+        }
+        case nebula::cpp2::PropertyType::INT64:
+        case nebula::cpp2::PropertyType::TIMESTAMP:
+          memcpy(reinterpret_cast<void*>(&iVal), &row[offset], sizeof(int64_t));
+          break;
+        case nebula::cpp2::PropertyType::FLOAT: {
+          float val;
+          memcpy(reinterpret_cast<void*>(&val), &row[offset], sizeof(float));
+          dVal = val;
+          break;
+        }
+        case nebula::cpp2::PropertyType::DOUBLE:
+          memcpy(reinterpret_cast<void*>(&dVal), &row[offset], sizeof(double));
+          break;
+        default:
+          return false;
+      }
+      if (term.asDouble && field->type() != nebula::cpp2::PropertyType::FLOAT &&
+          field->type() != nebula::cpp2::PropertyType::DOUBLE) {
+        dVal = static_cast<double>(iVal);
+      }
+    }
+
+    if (term.op == Op::kIn) {
+      return std::binary_search(term.iSet.begin(), term.iSet.end(), iVal);
+    }
+    if (term.asDouble) {
+      return compare(term.op, dVal, term.dOperand);
+    }
+    return compare(term.op, iVal, term.iOperand);
+  }
+
+  template <typename T>
+  static bool compare(Op op, T lhs, T rhs) {
+    switch (op) {
+      case Op::kLT:
+        return lhs < rhs;
+      case Op::kLE:
+        return lhs <= rhs;
+      case Op::kGT:
+        return lhs > rhs;
+      case Op::kGE:
+        return lhs >= rhs;
+      case Op::kEQ:
+        return lhs == rhs;
+      case Op::kNE:
+        return lhs != rhs;
+      default:
+        return false;
+    }
+  }
+
+  static bool checkNullBit(folly::StringPiece row, size_t headerLen, size_t pos) {
+    static const uint8_t bits[] = {0x80, 0x40, 0x20, 0x10, 0x08, 0x04, 0x02, 0x01};
+    return (row[headerLen + (pos >> 3)] & bits[pos & 0x07]) != 0;
+  }
+
+ private:
+  std::vector<Term> terms_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_EXEC_COMPILEDROWPREDICATE_H_
@@ -7,6 +7,7 @@
 #define STORAGE_EXEC_EDGENODE_H_
 
 #include "common/base/Base.h"
+#include "common/time/WallClock.h"
 #include "storage/exec/RelNode.h"
 #include "storage/exec/StorageIterator.h"
 
@@ -50,8 +51,8 @@ class EdgeNode : public IterateNode<T> {
         exp_(exp) {
     UNUSED(expCtx_);
     UNUSED(exp_);
-    auto schemaIter = edgeContext_->schemas_.find(std::abs(edgeType_));
-    CHECK(schemaIter != edgeContext_->schemas_.end());
+    auto schemaIter = edgeContext_->schemas_->find(std::abs(edgeType_));
+    CHECK(schemaIter != edgeContext_->schemas_->end());
     CHECK(!schemaIter->second.empty());
     schemas_ = &(schemaIter->second);
     ttl_ = QueryUtils::getEdgeTTLInfo(edgeContext_, std::abs(edgeType_));
@@ -133,7 +134,8 @@ class FetchEdgeNode final : public EdgeNode<cpp2::EdgeKey> {
                                    *edgeKey.edge_type_ref(),
                                    *edgeKey.ranking_ref(),
                                    (*edgeKey.dst_ref()).getStr());
-    ret = context_->env()->kvstore_->get(context_->spaceId(), partId, key_, &val_);
+    ret = context_->env()->kvstore_->get(
+        context_->spaceId(), partId, key_, &val_, false, context_->snapshot(partId));
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
       return doExecute(key_, val_);
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
@@ -224,9 +226,53 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
 
     VLOG(1) << "partId " << partId << ", vId " << vId << ", edgeType " << edgeType_
             << ", prop size " << props_->size();
+    auto* cache = context_->env()->edgeListCache_.get();
+    if (context_->planContext_->readSnapshot_) {
+      // A snapshot-pinned request must not read blocks cached from other views,
+      // nor publish its own view into the shared cache
+      cache = nullptr;
+    }
+    if (cache != nullptr) {
+      cacheKey_ = CommonUtils::edgeListCacheKey(
+          context_->spaceId(), vId, edgeType_, schemas_->back()->getVersion());
+      auto cached = cache->get(cacheKey_);
+      if (cached.ok()) {
+        auto entry = std::move(cached).value();
+        if (FLAGS_edge_list_cache_ttl_secs <= 0 ||
+            time::WallClock::fastNowInSec() - entry.insertedAtSecs <=
+                FLAGS_edge_list_cache_ttl_secs) {
+          resetWithBlock(std::move(entry.block));
+          return nebula::cpp2::ErrorCode::SUCCEEDED;
+        }
+        // the block outlived the ttl backstop, drop it and fall through to the kvstore scan
+        cache->evict(cacheKey_);
+      }
+    }
     std::unique_ptr<kvstore::KVIterator> iter;
+    if (iter_) {
+      // hand the former kvstore iterator back so the engine can re-seek it for this vertex
+      iter = iter_->releaseKVIter();
+    } else if (reuseIter_) {
+      iter = std::move(reuseIter_);
+    }
     prefix_ = NebulaKeyUtils::edgePrefix(context_->vIdLen(), partId, vId, edgeType_);
-    ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, prefix_, &iter);
+    ret = context_->env()->kvstore_->prefix(
+        context_->spaceId(), partId, prefix_, &iter, false, context_->snapshot(partId));
+    if (cache != nullptr && ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      // materialize the whole scan, so following expansions of this vertex skip the kvstore;
+      // an empty block caches the absence of edges
+      auto block = std::make_shared<std::vector<kvstore::KV>>();
+      while (iter && iter->valid()) {
+        block->emplace_back(iter->key().str(), iter->val().str());
+        iter->next();
+      }
+      if (block->size() <= static_cast<size_t>(FLAGS_edge_list_cache_max_block_size)) {
+        cache->insert(cacheKey_, EdgeListCacheEntry{block, time::WallClock::fastNowInSec()});
+      }
+      reuseIter_ = std::move(iter);
+      resetWithBlock(std::move(block));
+      return ret;
+    }
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED && iter && iter->valid()) {
       if (!skipDecode_) {
         iter_.reset(new SingleEdgeIterator(context_, std::move(iter), edgeType_, schemas_, &ttl_));
@@ -234,14 +280,32 @@ class SingleEdgeNode final : public EdgeNode<VertexID> {
         iter_.reset(new SingleEdgeKeyIterator(std::move(iter), edgeType_));
       }
     } else {
+      // keep the kvstore iterator for the next vertex even when this one has no edge
+      reuseIter_ = std::move(iter);
       iter_.reset();
     }
     return ret;
   }
 
  private:
+  void resetWithBlock(std::shared_ptr<std::vector<kvstore::KV>> block) {
+    if (block->empty()) {
+      iter_.reset();
+      return;
+    }
+    auto blockIter = std::make_unique<CachedEdgeBlockIter>(std::move(block));
+    if (!skipDecode_) {
+      iter_.reset(
+          new SingleEdgeIterator(context_, std::move(blockIter), edgeType_, schemas_, &ttl_));
+    } else {
+      iter_.reset(new SingleEdgeKeyIterator(std::move(blockIter), edgeType_));
+    }
+  }
+
   std::unique_ptr<SingleEdgeIterator> iter_;
+  std::unique_ptr<kvstore::KVIterator> reuseIter_;
   std::string prefix_;
+  std::string cacheKey_;
 };
 
 }  // namespace storage
@@ -9,6 +9,7 @@
 #include "common/base/Base.h"
 #include "common/expression/Expression.h"
 #include "storage/context/StorageExpressionContext.h"
+#include "storage/exec/CompiledRowPredicate.h"
 #include "storage/exec/HashJoinNode.h"
 
 namespace nebula {
@@ -32,7 +33,7 @@ before FilterNode is doExecuted. By that means, it can check the filter of tag +
 edge.
 */
 template <typename T>
-class FilterNode : public IterateNode<T> {
+class FilterNode final : public IterateNode<T> {
  public:
   using RelNode<T>::doExecute;
 
@@ -107,6 +108,23 @@ class FilterNode : public IterateNode<T> {
         return false;
       }
     }
+    // fast path: a recognized conjunction of comparisons over fixed-width fields is checked
+    // directly over the encoded row, compiled once per schema the rows actually show up with
+    auto* reader = this->reader();
+    if (reader != nullptr) {
+      const auto* schema = reader->getSchema();
+      auto iter = compiled_.find(schema);
+      if (iter == compiled_.end()) {
+        iter = compiled_
+                   .emplace(schema,
+                            CompiledRowPredicate::tryCompile(
+                                filterExp_, schema, expCtx_->schemaName()))
+                   .first;
+      }
+      if (iter->second != nullptr) {
+        return iter->second->eval(reader, this->key(), context_->vIdLen());
+      }
+    }
     // result is false when filter out
     auto result = filterExp_->eval(*expCtx_);
     // NULL is always false
@@ -120,6 +138,9 @@ class FilterNode : public IterateNode<T> {
   Expression* filterExp_{nullptr};
   Expression* tagFilterExp_{nullptr};
   FilterMode mode_{FilterMode::TAG_AND_EDGE};
+  // one compiled predicate per schema seen in the rows, nullptr caches "not compilable"
+  std::unordered_map<const meta::NebulaSchemaProvider*, std::unique_ptr<CompiledRowPredicate>>
+      compiled_;
   int32_t callCheck{0};
 };
 
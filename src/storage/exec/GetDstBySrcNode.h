@@ -74,8 +74,8 @@ class GetDstBySrcNode : public QueryNode<VertexID> {
   void setCurrentEdgeInfo(EdgeType type) {
     auto idxIter = edgeContext_->indexMap_.find(type);
     CHECK(idxIter != edgeContext_->indexMap_.end());
-    auto schemaIter = edgeContext_->schemas_.find(std::abs(type));
-    CHECK(schemaIter != edgeContext_->schemas_.end());
+    auto schemaIter = edgeContext_->schemas_->find(std::abs(type));
+    CHECK(schemaIter != edgeContext_->schemas_->end());
     CHECK(!schemaIter->second.empty());
 
     context_->edgeSchema_ = schemaIter->second.back().get();
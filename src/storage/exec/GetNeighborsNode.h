@@ -22,6 +22,7 @@ namespace storage {
 class GetNeighborsNode : public QueryNode<VertexID> {
  public:
   using RelNode::doExecute;
+  using RelNode::execute;
 
   GetNeighborsNode(RuntimeContext* context,
                    IterateNode<VertexID>* hashJoinNode,
@@ -38,6 +39,13 @@ class GetNeighborsNode : public QueryNode<VertexID> {
     name_ = "GetNeighborsNode";
   }
 
+  nebula::cpp2::ErrorCode execute(PartitionID partId, const std::vector<VertexID>& vIds) override {
+    // amortize the response row growth across the whole batch, the per-vertex path below then
+    // only does emplace_back into pre-reserved storage
+    resultDataSet_->rows.reserve(resultDataSet_->rows.size() + vIds.size());
+    return RelNode::execute(partId, vIds);
+  }
+
   nebula::cpp2::ErrorCode doExecute(PartitionID partId, const VertexID& vId) override {
     auto ret = RelNode::doExecute(partId, vId);
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -46,6 +54,7 @@ class GetNeighborsNode : public QueryNode<VertexID> {
     if (context_->isPlanKilled()) {
       return nebula::cpp2::ErrorCode::E_PLAN_IS_KILLED;
     }
+    context_->addScanCost(1);
     if (context_->resultStat_ == ResultStatus::ILLEGAL_DATA) {
       return nebula::cpp2::ErrorCode::E_INVALID_DATA;
     }
@@ -99,6 +108,18 @@ class GetNeighborsNode : public QueryNode<VertexID> {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
+  /**
+   * @brief Iterate the edges of the current vertex straight through the concrete HashJoinNode.
+   *
+   * For the common request shapes (edges with neither filter nor stat), the upstream chain is
+   * only the HashJoinNode itself. Iterating through its final type instantiates
+   * iterateEdgesImpl with de-virtualized, inlinable per-row calls instead of walking a chain
+   * of virtual hops for every edge row. Set by the plan builder when the shape allows it.
+   */
+  void markDirectIteration(HashJoinNode* join) {
+    directJoin_ = join;
+  }
+
  protected:
   GetNeighborsNode() = default;
 
@@ -106,20 +127,31 @@ class GetNeighborsNode : public QueryNode<VertexID> {
     if (edgeContext_->propContexts_.empty()) {
       return nebula::cpp2::ErrorCode::SUCCEEDED;
     }
+    if (directJoin_ != nullptr) {
+      return iterateEdgesImpl(row, directJoin_);
+    }
+    return iterateEdgesImpl(row, upstream_);
+  }
+
+  template <typename Iterator>
+  nebula::cpp2::ErrorCode iterateEdgesImpl(std::vector<Value>& row, Iterator* upstream) {
     int64_t edgeRowCount = 0;
     nebula::List list;
-    for (; upstream_->valid(); upstream_->next(), ++edgeRowCount) {
+    SCOPE_EXIT {
+      context_->addScanCost(edgeRowCount);
+    };
+    for (; upstream->valid(); upstream->next(), ++edgeRowCount) {
       if (context_->isPlanKilled()) {
         return nebula::cpp2::ErrorCode::E_PLAN_IS_KILLED;
       }
       if (edgeRowCount >= limit_) {
         return nebula::cpp2::ErrorCode::SUCCEEDED;
       }
-      auto key = upstream_->key();
+      auto key = upstream->key();
       if (isDuplicatedSelfReflectiveEdge(key)) {
         continue;
       }
-      auto reader = upstream_->reader();
+      auto reader = upstream->reader();
       auto props = context_->props_;
       auto columnIdx = context_->columnIdx_;
 
@@ -162,12 +194,14 @@ class GetNeighborsNode : public QueryNode<VertexID> {
   RuntimeContext* context_;
   IterateNode<VertexID>* hashJoinNode_;
   IterateNode<VertexID>* upstream_;
+  // non-null when the whole upstream chain is just the hash join node, see markDirectIteration
+  HashJoinNode* directJoin_{nullptr};
   EdgeContext* edgeContext_;
   nebula::DataSet* resultDataSet_;
   int64_t limit_;
 };
 
-class GetNeighborsSampleNode : public GetNeighborsNode {
+class GetNeighborsSampleNode final : public GetNeighborsNode {
  public:
   GetNeighborsSampleNode(RuntimeContext* context,
                          IterateNode<VertexID>* hashJoinNode,
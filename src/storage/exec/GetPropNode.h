@@ -9,6 +9,7 @@
 #include "common/base/Base.h"
 #include "storage/exec/EdgeNode.h"
 #include "storage/exec/TagNode.h"
+#include "storage/stats/StorageStats.h"
 
 namespace nebula {
 namespace storage {
@@ -16,6 +17,7 @@ namespace storage {
 class GetTagPropNode : public QueryNode<VertexID> {
  public:
   using RelNode<VertexID>::doExecute;
+  using RelNode<VertexID>::execute;
 
   GetTagPropNode(RuntimeContext* context,
                  std::vector<TagNode*> tagNodes,
@@ -43,7 +45,230 @@ class GetTagPropNode : public QueryNode<VertexID> {
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return ret;
     }
+    return collectVertex(partId, vId);
+  }
+
+  /**
+   * @brief Keys of one prefetched batch together with which of them the absence cache
+   * already ruled out, so the consuming execute sees the very mask the read was issued
+   * under even if the cache changed in between
+   */
+  struct PrefetchedBatch {
+    std::vector<std::string> keys;
+    std::vector<bool> absent;
+    folly::SemiFuture<kvstore::KVStore::AsyncMultiGetResult> result;
+  };
+
+  nebula::cpp2::ErrorCode execute(PartitionID partId,
+                                  const std::vector<VertexID>& inputs) override {
+    if (resultDataSet_->size() >= limit_) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    // fetch all (vertex, tag) keys of the batch in one MultiGet instead of one get per vertex
+    // per tag, then run the per-vertex pipeline from the prefetched values
+    auto keys = buildBatchKeys(partId, inputs);
+    std::vector<std::string> fetchKeys;
+    auto absent = probeAbsenceCache(keys, &fetchKeys);
+    std::vector<std::string> values;
+    auto ret = context_->env()->kvstore_->multiGet(
+        context_->spaceId(), partId, absent.empty() ? keys : fetchKeys, &values);
+    if (absent.empty()) {
+      rememberAbsent(ret.first, keys, ret.second);
+      return processBatch(
+          partId, inputs, keys, ret.first, std::move(ret.second), std::move(values));
+    }
+    if (ret.first != nebula::cpp2::ErrorCode::SUCCEEDED &&
+        ret.first != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+      return ret.first;
+    }
+    std::vector<Status> statuses;
+    std::vector<std::string> fullValues;
+    mergeFetched(keys, absent, std::move(ret.second), std::move(values), &statuses, &fullValues);
+    return processBatch(partId,
+                        inputs,
+                        keys,
+                        nebula::cpp2::ErrorCode::E_PARTIAL_RESULT,
+                        std::move(statuses),
+                        std::move(fullValues));
+  }
+
+  /**
+   * @brief Kick off the batch read asynchronously, the result is consumed by the execute
+   * overload below. Prefetching several partitions before consuming any of them overlaps
+   * their I/O. Keys the absence cache rules out are not read at all.
+   */
+  PrefetchedBatch prefetch(PartitionID partId, const std::vector<VertexID>& inputs) {
+    PrefetchedBatch batch;
+    batch.keys = buildBatchKeys(partId, inputs);
+    std::vector<std::string> fetchKeys;
+    batch.absent = probeAbsenceCache(batch.keys, &fetchKeys);
+    batch.result = context_->env()->kvstore_->asyncMultiGet(
+        context_->spaceId(), partId, batch.absent.empty() ? batch.keys : std::move(fetchKeys));
+    return batch;
+  }
+
+  nebula::cpp2::ErrorCode execute(PartitionID partId,
+                                  const std::vector<VertexID>& inputs,
+                                  PrefetchedBatch&& batch) {
+    if (resultDataSet_->size() >= limit_) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    auto fetched = std::move(batch.result).get();
+    auto code = std::get<0>(fetched);
+    if (batch.absent.empty()) {
+      rememberAbsent(code, batch.keys, std::get<1>(fetched));
+      return processBatch(partId,
+                          inputs,
+                          batch.keys,
+                          code,
+                          std::move(std::get<1>(fetched)),
+                          std::move(std::get<2>(fetched)));
+    }
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+        code != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+      return code;
+    }
+    std::vector<Status> statuses;
+    std::vector<std::string> values;
+    mergeFetched(batch.keys,
+                 batch.absent,
+                 std::move(std::get<1>(fetched)),
+                 std::move(std::get<2>(fetched)),
+                 &statuses,
+                 &values);
+    return processBatch(partId,
+                        inputs,
+                        batch.keys,
+                        nebula::cpp2::ErrorCode::E_PARTIAL_RESULT,
+                        std::move(statuses),
+                        std::move(values));
+  }
+
+ private:
+  std::vector<std::string> buildBatchKeys(PartitionID partId,
+                                          const std::vector<VertexID>& inputs) const {
+    auto vIdLen = context_->vIdLen();
+    std::vector<std::string> keys;
+    keys.reserve(inputs.size() * tagNodes_.size());
+    for (const auto& vId : inputs) {
+      for (auto* tagNode : tagNodes_) {
+        keys.emplace_back(NebulaKeyUtils::tagKey(vIdLen, partId, vId, tagNode->tagId()));
+      }
+    }
+    return keys;
+  }
+
+  // Probe the absence cache for every key of the batch. Returns an empty mask when the
+  // cache is disabled or nothing hits (the caller then reads all keys); otherwise fetchKeys
+  // holds the keys still worth reading and the mask flags the skipped ones
+  std::vector<bool> probeAbsenceCache(const std::vector<std::string>& keys,
+                                      std::vector<std::string>* fetchKeys) const {
+    std::vector<bool> absent;
+    auto* cache = context_->env()->vertexAbsenceCache_.get();
+    if (cache == nullptr) {
+      return absent;
+    }
+    auto spaceId = context_->spaceId();
+    absent.resize(keys.size(), false);
+    size_t hits = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (cache->get(CommonUtils::vertexAbsenceCacheKey(spaceId, keys[i])).ok()) {
+        absent[i] = true;
+        hits++;
+      }
+    }
+    if (hits == 0) {
+      absent.clear();
+      return absent;
+    }
+    stats::StatsManager::addValue(kNumVertexAbsenceCacheHits, hits);
+    fetchKeys->reserve(keys.size() - hits);
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (!absent[i]) {
+        fetchKeys->emplace_back(keys[i]);
+      }
+    }
+    return absent;
+  }
+
+  // Feed keys the store just confirmed absent into the cache, called on the unmasked path
+  void rememberAbsent(nebula::cpp2::ErrorCode code,
+                      const std::vector<std::string>& keys,
+                      const std::vector<Status>& statuses) const {
+    auto* cache = context_->env()->vertexAbsenceCache_.get();
+    if (cache == nullptr || (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+                             code != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT)) {
+      return;
+    }
+    auto spaceId = context_->spaceId();
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (statuses[i].isKeyNotFound()) {
+        cache->insert(CommonUtils::vertexAbsenceCacheKey(spaceId, keys[i]), true);
+      }
+    }
+  }
 
+  // Expand the statuses/values of the fetched subset back to the full batch, fill
+  // KeyNotFound for the skipped keys and remember the freshly confirmed absent ones
+  void mergeFetched(const std::vector<std::string>& keys,
+                    const std::vector<bool>& absent,
+                    std::vector<Status>&& fetchedStatuses,
+                    std::vector<std::string>&& fetchedValues,
+                    std::vector<Status>* statuses,
+                    std::vector<std::string>* values) const {
+    auto* cache = context_->env()->vertexAbsenceCache_.get();
+    auto spaceId = context_->spaceId();
+    statuses->reserve(keys.size());
+    values->reserve(keys.size());
+    size_t fetchedIdx = 0;
+    for (size_t i = 0; i < keys.size(); i++) {
+      if (absent[i]) {
+        statuses->emplace_back(Status::KeyNotFound());
+        values->emplace_back();
+        continue;
+      }
+      if (cache != nullptr && fetchedStatuses[fetchedIdx].isKeyNotFound()) {
+        cache->insert(CommonUtils::vertexAbsenceCacheKey(spaceId, keys[i]), true);
+      }
+      statuses->emplace_back(std::move(fetchedStatuses[fetchedIdx]));
+      values->emplace_back(std::move(fetchedValues[fetchedIdx]));
+      fetchedIdx++;
+    }
+  }
+
+  nebula::cpp2::ErrorCode processBatch(PartitionID partId,
+                                       const std::vector<VertexID>& inputs,
+                                       const std::vector<std::string>& keys,
+                                       nebula::cpp2::ErrorCode code,
+                                       std::vector<Status>&& statuses,
+                                       std::vector<std::string>&& values) {
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+        code != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+      return code;
+    }
+    size_t idx = 0;
+    for (const auto& vId : inputs) {
+      for (auto* tagNode : tagNodes_) {
+        if (statuses[idx].ok()) {
+          tagNode->doExecute(keys[idx], values[idx]);
+        } else {
+          tagNode->clear();
+        }
+        idx++;
+      }
+      auto ret = collectVertex(partId, vId);
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return ret;
+      }
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  nebula::cpp2::ErrorCode collectVertex(PartitionID partId, const VertexID& vId) {
+    if (resultDataSet_->size() >= limit_) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    auto ret = nebula::cpp2::ErrorCode::SUCCEEDED;
     // If none of the tag node valid, will check if vertex exists:
     // 1. if use_vertex_key is true, check it by vertex key
     // 2. if use_vertex_key is false, check it by scanning vertex prefix
@@ -65,7 +290,8 @@ class GetTagPropNode : public QueryNode<VertexID> {
         // check if vId has any valid tag by prefix scan
         std::unique_ptr<kvstore::KVIterator> iter;
         auto tagPrefix = NebulaKeyUtils::tagPrefix(context_->vIdLen(), partId, vId);
-        ret = context_->env()->kvstore_->prefix(context_->spaceId(), partId, tagPrefix, &iter);
+        ret = context_->env()->kvstore_->prefix(
+            context_->spaceId(), partId, tagPrefix, &iter, false, context_->snapshot(partId));
         if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
           return ret;
         } else if (!iter->valid()) {
@@ -73,17 +299,17 @@ class GetTagPropNode : public QueryNode<VertexID> {
         }
 
         bool hasValidTag = false;
+        RowReaderWrapper reader;
         for (; iter->valid(); iter->next()) {
           // check if tag schema exists
           auto key = iter->key();
           auto tagId = NebulaKeyUtils::getTagId(context_->vIdLen(), key);
-          auto schemaIter = tagContext_->schemas_.find(tagId);
-          if (schemaIter == tagContext_->schemas_.end()) {
+          auto schemaIter = tagContext_->schemas_->find(tagId);
+          if (schemaIter == tagContext_->schemas_->end()) {
             continue;
           }
           // check if ttl expired
           auto schemas = &(schemaIter->second);
-          RowReaderWrapper reader;
           reader.reset(*schemas, iter->val());
           if (!reader) {
             continue;
@@ -168,9 +394,10 @@ class GetTagPropNode : public QueryNode<VertexID> {
 class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
  public:
   using RelNode::doExecute;
+  using RelNode::execute;
 
   GetEdgePropNode(RuntimeContext* context,
-                  std::vector<EdgeNode<cpp2::EdgeKey>*> edgeNodes,
+                  std::vector<FetchEdgeNode*> edgeNodes,
                   nebula::DataSet* resultDataSet,
                   Expression* filter,
                   std::size_t limit)
@@ -193,7 +420,98 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return ret;
     }
+    return collectEdge();
+  }
+
+  nebula::cpp2::ErrorCode execute(PartitionID partId,
+                                  const std::vector<cpp2::EdgeKey>& edgeKeys) override {
+    if (resultDataSet_->size() >= limit_) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    // fetch all edge keys of the batch in one MultiGet, then collect the rows from the
+    // prefetched values
+    auto keys = buildBatchKeys(partId, edgeKeys);
+    std::vector<std::string> values;
+    auto ret = context_->env()->kvstore_->multiGet(context_->spaceId(), partId, keys, &values);
+    return processBatch(edgeKeys, keys, ret.first, std::move(ret.second), std::move(values));
+  }
 
+  /**
+   * @brief Kick off the batch read asynchronously, the result is consumed by the execute
+   * overload below. Prefetching several partitions before consuming any of them overlaps
+   * their I/O.
+   */
+  folly::SemiFuture<kvstore::KVStore::AsyncMultiGetResult> prefetch(
+      PartitionID partId, const std::vector<cpp2::EdgeKey>& edgeKeys) {
+    return context_->env()->kvstore_->asyncMultiGet(
+        context_->spaceId(), partId, buildBatchKeys(partId, edgeKeys));
+  }
+
+  nebula::cpp2::ErrorCode execute(PartitionID partId,
+                                  const std::vector<cpp2::EdgeKey>& edgeKeys,
+                                  kvstore::KVStore::AsyncMultiGetResult&& fetched) {
+    if (resultDataSet_->size() >= limit_) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    auto keys = buildBatchKeys(partId, edgeKeys);
+    return processBatch(edgeKeys,
+                        keys,
+                        std::get<0>(fetched),
+                        std::move(std::get<1>(fetched)),
+                        std::move(std::get<2>(fetched)));
+  }
+
+ private:
+  std::vector<std::string> buildBatchKeys(PartitionID partId,
+                                          const std::vector<cpp2::EdgeKey>& edgeKeys) const {
+    auto vIdLen = context_->vIdLen();
+    std::vector<std::string> keys;
+    keys.reserve(edgeKeys.size() * edgeNodes_.size());
+    for (const auto& edgeKey : edgeKeys) {
+      for (size_t i = 0; i < edgeNodes_.size(); i++) {
+        keys.emplace_back(NebulaKeyUtils::edgeKey(vIdLen,
+                                                  partId,
+                                                  (*edgeKey.src_ref()).getStr(),
+                                                  *edgeKey.edge_type_ref(),
+                                                  *edgeKey.ranking_ref(),
+                                                  (*edgeKey.dst_ref()).getStr()));
+      }
+    }
+    return keys;
+  }
+
+  nebula::cpp2::ErrorCode processBatch(const std::vector<cpp2::EdgeKey>& edgeKeys,
+                                       const std::vector<std::string>& keys,
+                                       nebula::cpp2::ErrorCode code,
+                                       std::vector<Status>&& statuses,
+                                       std::vector<std::string>&& values) {
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED &&
+        code != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+      return code;
+    }
+    size_t idx = 0;
+    for (const auto& edgeKey : edgeKeys) {
+      for (auto* edgeNode : edgeNodes_) {
+        if (edgeNode->edgeType() == *edgeKey.edge_type_ref() && statuses[idx].ok()) {
+          edgeNode->doExecute(keys[idx], values[idx]);
+        } else {
+          edgeNode->clear();
+        }
+        idx++;
+      }
+      auto ret = collectEdge();
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return ret;
+      }
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
+  nebula::cpp2::ErrorCode collectEdge() {
+    if (resultDataSet_->size() >= limit_) {
+      return nebula::cpp2::ErrorCode::SUCCEEDED;
+    }
+    auto ret = nebula::cpp2::ErrorCode::SUCCEEDED;
     List row;
     auto vIdLen = context_->vIdLen();
     auto isIntId = context_->isIntId();
@@ -241,7 +559,7 @@ class GetEdgePropNode : public QueryNode<cpp2::EdgeKey> {
 
  private:
   RuntimeContext* context_;
-  std::vector<EdgeNode<cpp2::EdgeKey>*> edgeNodes_;
+  std::vector<FetchEdgeNode*> edgeNodes_;
   nebula::DataSet* resultDataSet_;
   std::unique_ptr<StorageExpressionContext> expCtx_{nullptr};
   Expression* filter_{nullptr};
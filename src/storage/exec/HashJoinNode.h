@@ -20,7 +20,9 @@ namespace storage {
 // output would be the result of tag, it is a List, each cell save a list of
 // property values, if tag not found, it will be a empty value. Also it will
 // return an iterator of edges which can pass ttl check and ready to be read.
-class HashJoinNode : public IterateNode<VertexID> {
+// The class is final so callers holding a concrete HashJoinNode* get de-virtualized,
+// inlinable valid/next/key/reader calls in their per-edge-row loops.
+class HashJoinNode final : public IterateNode<VertexID> {
  public:
   using RelNode::doExecute;
 
@@ -133,8 +135,8 @@ class HashJoinNode : public IterateNode<VertexID> {
     if (type != context_->edgeType_) {
       auto idxIter = edgeContext_->indexMap_.find(type);
       CHECK(idxIter != edgeContext_->indexMap_.end());
-      auto schemaIter = edgeContext_->schemas_.find(std::abs(type));
-      CHECK(schemaIter != edgeContext_->schemas_.end());
+      auto schemaIter = edgeContext_->schemas_->find(std::abs(type));
+      CHECK(schemaIter != edgeContext_->schemas_->end());
       CHECK(!schemaIter->second.empty());
 
       context_->edgeSchema_ = schemaIter->second.back().get();
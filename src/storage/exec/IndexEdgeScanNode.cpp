@@ -29,10 +29,10 @@ IndexEdgeScanNode::IndexEdgeScanNode(RuntimeContext* context,
     auto schemaMgr = env->schemaMan_;
     auto allSchema = schemaMgr->getAllVerEdgeSchema(this->spaceId_);
     auto edgeType = this->index_->get_schema_id().get_edge_type();
-    if (!allSchema.ok() || !allSchema.value().count(edgeType)) {
+    if (!allSchema.ok() || !allSchema.value()->count(edgeType)) {
       return ::nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
     }
-    edge = allSchema.value().at(edgeType);
+    edge = allSchema.value()->at(edgeType);
     return ::nebula::cpp2::ErrorCode::SUCCEEDED;
   });
 }
@@ -94,7 +94,7 @@ nebula::cpp2::ErrorCode IndexEdgeScanNode::getBaseData(folly::StringPiece key,
 Map<std::string, Value> IndexEdgeScanNode::decodeFromBase(const std::string& key,
                                                           const std::string& value) {
   Map<std::string, Value> values;
-  auto reader = RowReaderWrapper::getRowReader(edge_, value);
+  reader_.reset(edge_, value);
   for (auto& col : requiredAndHintColumns_) {
     switch (QueryUtils::toReturnColType(col)) {
       case QueryUtils::ReturnColType::kType: {
@@ -124,7 +124,7 @@ Map<std::string, Value> IndexEdgeScanNode::decodeFromBase(const std::string& key
         if (field == nullptr) {
           values[col] = Value::kNullUnknownProp;
         } else {
-          auto retVal = QueryUtils::readValue(reader.get(), col, field);
+          auto retVal = QueryUtils::readValue(reader_.get(), col, field);
           if (!retVal.ok()) {
             LOG(FATAL) << "Bad value for field" << col;
           }
@@ -39,6 +39,8 @@ class IndexEdgeScanNode : public IndexScanNode {
   using IndexItem = ::nebula::meta::cpp2::IndexItem;
   const EdgeSchemas& getSchema() override;
   EdgeSchemas edge_;
+  // Reused across the rows of one scan, reset per row in decodeFromBase
+  RowReaderWrapper reader_;
 
   // Convenient for testing
   std::function<::nebula::cpp2::ErrorCode(std::shared_ptr<IndexItem>&)> getIndex;
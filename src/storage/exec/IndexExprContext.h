@@ -20,7 +20,7 @@ class IndexExprContext : public ExpressionContext {
     row_ = &row;
   }
 
-  Value getEdgeProp(const std::string &edgeType, const std::string &prop) const override {
+  const Value &getEdgeProp(const std::string &edgeType, const std::string &prop) const override {
     UNUSED(edgeType);
     DCHECK(row_ != nullptr);
     auto iter = colPos_.find(prop);
@@ -29,7 +29,7 @@ class IndexExprContext : public ExpressionContext {
     return (*row_)[iter->second];
   }
 
-  Value getTagProp(const std::string &tag, const std::string &prop) const override {
+  const Value &getTagProp(const std::string &tag, const std::string &prop) const override {
     UNUSED(tag);
     DCHECK(row_ != nullptr);
     auto iter = colPos_.find(prop);
@@ -66,7 +66,7 @@ class IndexExprContext : public ExpressionContext {
     DLOG(FATAL) << "Unimplemented";
     return Status::Error("Unimplemented");
   }
-  Value getSrcProp(const std::string &tag, const std::string &prop) const override {
+  const Value &getSrcProp(const std::string &tag, const std::string &prop) const override {
     UNUSED(tag), UNUSED(prop);
     return fatal(__FILE__, __LINE__);
   }
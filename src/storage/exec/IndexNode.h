@@ -293,6 +293,7 @@ inline IndexNode::Result IndexNode::next() {
   if (context_->isPlanKilled()) {
     return Result(::nebula::cpp2::ErrorCode::E_PLAN_IS_KILLED);
   }
+  context_->addScanCost(1);
   Result ret = doNext();
   afterNext();
   return ret;
@@ -4,6 +4,10 @@
  */
 #include "storage/exec/IndexScanNode.h"
 
+#include "kvstore/PrefetchIterator.h"
+#include "storage/StorageFlags.h"
+#include "storage/stats/StorageStats.h"
+
 namespace nebula {
 namespace storage {
 // Define of Path
@@ -359,6 +363,7 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
       indexId_(node.indexId_),
       index_(node.index_),
       columnHints_(node.columnHints_),
+      extraHintSets_(node.extraHintSets_),
       kvstore_(node.kvstore_),
       indexNullable_(node.indexNullable_),
       requiredColumns_(node.requiredColumns_),
@@ -366,10 +371,18 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
       ttlProps_(node.ttlProps_),
       needAccessBase_(node.needAccessBase_),
       colPosMap_(node.colPosMap_) {
-  if (node.path_->isRange()) {
-    path_ = std::make_unique<RangePath>(*dynamic_cast<RangePath*>(node.path_.get()));
-  } else {
-    path_ = std::make_unique<PrefixPath>(*dynamic_cast<PrefixPath*>(node.path_.get()));
+  auto clone = [](Path* path) -> std::unique_ptr<Path> {
+    if (path->isRange()) {
+      return std::make_unique<RangePath>(*dynamic_cast<RangePath*>(path));
+    }
+    return std::make_unique<PrefixPath>(*dynamic_cast<PrefixPath*>(path));
+  };
+  path_ = clone(node.path_.get());
+  for (auto& extraPath : node.extraPaths_) {
+    extraPaths_.emplace_back(clone(extraPath.get()));
+  }
+  if (!node.orderedPaths_.empty()) {
+    buildOrderedPaths();
   }
 }
 
@@ -395,11 +408,19 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
   // TODO(hs.zhang): The performance is better to judge based on whether the string is truncated
   auto tmp = ctx.requiredColumns;
   for (auto& field : index_->get_fields()) {
-    // TODO(doodle): Both STRING and FIXED_STRING properties in tag/edge will be transformed into
-    // FIXED_STRING in ColumnDef of IndexItem. As for FIXED_STRING in tag/edge property, we don't
-    // need to access base data actually.
+    // Both STRING and FIXED_STRING properties in tag/edge are transformed into FIXED_STRING in
+    // ColumnDef of IndexItem. A STRING property may be truncated to the index field length, so
+    // its full value only lives in the base row; a FIXED_STRING property whose length fits the
+    // index field is stored in the key completely and decodes to the same '\0'-stripped value
+    // as the base row read, so it can be served index-only.
     if (field.get_type().get_type() == ::nebula::cpp2::PropertyType::FIXED_STRING) {
-      continue;
+      auto* schemaField = schema->field(field.get_name());
+      if (schemaField == nullptr ||
+          schemaField->type() != ::nebula::cpp2::PropertyType::FIXED_STRING ||
+          schemaField->size() >
+              static_cast<size_t>(field.get_type().type_length_ref().value_or(0))) {
+        continue;
+      }
     }
     if (field.get_type().get_type() == ::nebula::cpp2::PropertyType::GEOGRAPHY) {
       continue;
@@ -414,58 +435,121 @@ IndexScanNode::IndexScanNode(const IndexScanNode& node)
   tmp.erase(kType);
   needAccessBase_ = !tmp.empty();
   path_ = Path::make(index_.get(), getSchema().back().get(), columnHints_, context_->vIdLen());
+  for (auto& hints : extraHintSets_) {
+    for (auto& hint : hints) {
+      requiredAndHintColumns_.insert(hint.get_column_name());
+    }
+    extraPaths_.emplace_back(
+        Path::make(index_.get(), getSchema().back().get(), hints, context_->vIdLen()));
+  }
+  buildOrderedPaths();
   return ::nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
+void IndexScanNode::buildOrderedPaths() {
+  orderedPaths_.clear();
+  orderedPaths_.push_back(path_.get());
+  for (auto& extraPath : extraPaths_) {
+    orderedPaths_.push_back(extraPath.get());
+  }
+  if (orderedPaths_.size() > 1) {
+    // The keys here still carry the placeholder partId set during `buildKey`. `resetPart` only
+    // replaces the partId prefix, which is the same for every path, so the order by seek key
+    // holds for whatever part is executed.
+    auto seekKey = [](Path* path) -> const std::string& {
+      return path->isRange() ? dynamic_cast<RangePath*>(path)->getStartKey()
+                             : dynamic_cast<PrefixPath*>(path)->getPrefixKey();
+    };
+    std::sort(orderedPaths_.begin(), orderedPaths_.end(), [&seekKey](Path* lhs, Path* rhs) {
+      return seekKey(lhs) < seekKey(rhs);
+    });
+  }
+}
+
+IndexScanNode::~IndexScanNode() {
+  flushIndexStats();
+}
+
+void IndexScanNode::flushIndexStats() {
+  if (rowsMatchedStat_ > 0) {
+    addIndexStatsValue(kNumIndexRowsMatched, indexId_, rowsMatchedStat_);
+    rowsMatchedStat_ = 0;
+  }
+}
+
 nebula::cpp2::ErrorCode IndexScanNode::doExecute(PartitionID partId) {
+  flushIndexStats();
+  addIndexStatsValue(kNumIndexScans, indexId_);
   partId_ = partId;
+  pathIdx_ = 0;
   auto ret = resetIter(partId);
   return ret;
 }
 
 IndexNode::Result IndexScanNode::doNext() {
-  for (; iter_ && iter_->valid(); iter_->next()) {
-    if (!checkTTL()) {
-      continue;
-    }
-    auto q = path_->qualified(iter_->key());
-    if (q == QualifiedStrategy::INCOMPATIBLE) {
-      continue;
-    }
-    bool compatible = q == QualifiedStrategy::COMPATIBLE;
-    if (compatible && !needAccessBase_) {
-      auto key = iter_->key().toString();
-      iter_->next();
-      Row row = decodeFromIndex(key);
-      return Result(std::move(row));
-    }
-    std::pair<std::string, std::string> kv;
-    auto ret = getBaseData(iter_->key(), kv);
-    if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {  // do nothing
-    } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
-      if (LIKELY(!fatalOnBaseNotFound_)) {
-        LOG(WARNING) << "base data not found";
-      } else {
-        LOG(FATAL) << "base data not found";
+  while (true) {
+    auto* path = orderedPaths_[pathIdx_];
+    for (; iter_ && iter_->valid(); iter_->next()) {
+      // Charge every examined index key against the request's scan budget, and end the
+      // scan with whatever qualified so far once the budget runs out. The processor turns
+      // this into a partial-result flag on the response.
+      if (context_->scanBudgetExhausted()) {
+        return Result();
       }
-      continue;
-    } else {
-      return Result(ret);
-    }
-    Map<std::string, Value> rowData = decodeFromBase(kv.first, kv.second);
-    if (!compatible) {
-      q = path_->qualified(rowData);
-      CHECK(q != QualifiedStrategy::UNCERTAIN);
+      context_->addScanCost(1);
+      if (!checkTTL()) {
+        continue;
+      }
+      auto q = path->qualified(iter_->key());
       if (q == QualifiedStrategy::INCOMPATIBLE) {
         continue;
       }
+      bool compatible = q == QualifiedStrategy::COMPATIBLE;
+      if (compatible && !needAccessBase_) {
+        auto key = iter_->key().toString();
+        iter_->next();
+        Row row = decodeFromIndex(key);
+        rowsMatchedStat_++;
+        return Result(std::move(row));
+      }
+      std::pair<std::string, std::string> kv;
+      auto ret = getBaseData(iter_->key(), kv);
+      if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {  // do nothing
+      } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
+        if (LIKELY(!fatalOnBaseNotFound_)) {
+          LOG(WARNING) << "base data not found";
+        } else {
+          LOG(FATAL) << "base data not found";
+        }
+        continue;
+      } else {
+        return Result(ret);
+      }
+      Map<std::string, Value> rowData = decodeFromBase(kv.first, kv.second);
+      if (!compatible) {
+        q = path->qualified(rowData);
+        CHECK(q != QualifiedStrategy::UNCERTAIN);
+        if (q == QualifiedStrategy::INCOMPATIBLE) {
+          continue;
+        }
+      }
+      Row row;
+      for (auto& col : requiredColumns_) {
+        row.emplace_back(std::move(rowData.at(col)));
+      }
+      iter_->next();
+      rowsMatchedStat_++;
+      return Result(std::move(row));
     }
-    Row row;
-    for (auto& col : requiredColumns_) {
-      row.emplace_back(std::move(rowData.at(col)));
+    // The current range is exhausted, seek to the next one if this scan has more ranges
+    if (pathIdx_ + 1 >= orderedPaths_.size()) {
+      break;
+    }
+    pathIdx_++;
+    auto ret = resetIter(partId_);
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      return Result(ret);
     }
-    iter_->next();
-    return Result(std::move(row));
   }
   return Result();
 }
@@ -485,15 +569,20 @@ bool IndexScanNode::checkTTL() {
 }
 
 nebula::cpp2::ErrorCode IndexScanNode::resetIter(PartitionID partId) {
-  path_->resetPart(partId);
+  auto* path = orderedPaths_[pathIdx_];
+  path->resetPart(partId);
   nebula::cpp2::ErrorCode ret = nebula::cpp2::ErrorCode::SUCCEEDED;
-  if (path_->isRange()) {
-    auto rangePath = dynamic_cast<RangePath*>(path_.get());
+  if (path->isRange()) {
+    auto rangePath = dynamic_cast<RangePath*>(path);
     kvstore_->range(spaceId_, partId, rangePath->getStartKey(), rangePath->getEndKey(), &iter_);
   } else {
-    auto prefixPath = dynamic_cast<PrefixPath*>(path_.get());
+    auto prefixPath = dynamic_cast<PrefixPath*>(path);
     ret = kvstore_->prefix(spaceId_, partId, prefixPath->getPrefixKey(), &iter_);
   }
+  if (FLAGS_scan_prefetch_depth > 0 && ret == nebula::cpp2::ErrorCode::SUCCEEDED &&
+      iter_ != nullptr) {
+    iter_ = std::make_unique<kvstore::PrefetchIterator>(std::move(iter_), FLAGS_scan_prefetch_depth);
+  }
   return ret;
 }
 
@@ -559,7 +648,14 @@ void IndexScanNode::decodePropFromIndex(folly::StringPiece key,
 }
 
 std::string IndexScanNode::identify() {
-  return fmt::format("{}(IndexID={}, Path=({}))", name_, indexId_, path_->toString());
+  if (extraHintSets_.empty()) {
+    return fmt::format("{}(IndexID={}, Path=({}))", name_, indexId_, path_->toString());
+  }
+  return fmt::format("{}(IndexID={}, Path=({}), FusedRanges={})",
+                     name_,
+                     indexId_,
+                     path_->toString(),
+                     extraHintSets_.size() + 1);
 }
 
 // End of IndexScan
@@ -67,9 +67,22 @@ class IndexScanNode : public IndexNode {
         columnHints_(columnHints),
         kvstore_(kvstore),
         indexNullable_(hasNullableCol) {}
+  ~IndexScanNode() override;
   ::nebula::cpp2::ErrorCode init(InitContext& ctx) override;
   std::string identify() override;
 
+  /**
+   * @brief fuse one more set of column hints into this scan
+   *
+   * All hint sets of one node must address the same index and generate disjoint ranges(e.g. the
+   * sets expanded from an IN list over an index column). Each set is built into its own Path
+   * during `init`, and `doNext` executes the paths in key order, seeking to the next range once
+   * the current one is exhausted, instead of opening one scan node per set.
+   */
+  void addHintSet(const std::vector<cpp2::IndexColumnHint>& hints) {
+    extraHintSets_.emplace_back(hints);
+  }
+
  protected:
   nebula::cpp2::ErrorCode doExecute(PartitionID partId) final;
   Result doNext() final;
@@ -149,6 +162,23 @@ class IndexScanNode : public IndexNode {
    * @see Path
    */
   std::unique_ptr<Path> path_;
+  /**
+   * @brief extra hint sets fused into this scan and the Path built from each of them
+   * @see addHintSet
+   */
+  std::vector<std::vector<cpp2::IndexColumnHint>> extraHintSets_;
+  std::vector<std::unique_ptr<Path>> extraPaths_;
+  /**
+   * @brief all paths of this scan ordered by their seek key, holds only `path_` when no extra
+   * hint set was fused in. `pathIdx_` is the path being executed on the current part.
+   */
+  std::vector<Path*> orderedPaths_;
+  size_t pathIdx_{0};
+
+  /**
+   * @brief collect `path_` and `extraPaths_` into `orderedPaths_` sorted by seek key
+   */
+  void buildOrderedPaths();
   /**
    * @brief current kvstore iterator.It while be reset `doExecute` and iterated during `doNext`
    */
@@ -173,6 +203,13 @@ class IndexScanNode : public IndexNode {
   bool needAccessBase_{false};
   bool fatalOnBaseNotFound_{false};
   Map<std::string, size_t> colPosMap_;
+  /**
+   * @brief rows returned since the last flush of the index usage counters. Counted locally and
+   * flushed per part to keep StatsManager off the per-row path.
+   */
+  int64_t rowsMatchedStat_{0};
+
+  void flushIndexStats();
 };
 class QualifiedStrategy {
  public:
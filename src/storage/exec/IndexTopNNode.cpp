@@ -3,6 +3,8 @@
  * This source code is licensed under Apache 2.0 License.
  */
 #include "storage/exec/IndexTopNNode.h"
+
+#include "common/datatypes/ValueComparator.h"
 namespace nebula {
 namespace storage {
 IndexTopNNode::IndexTopNNode(const IndexTopNNode& node)
@@ -64,20 +66,37 @@ void IndexTopNNode::topN() {
     finished_ = true;
     return;
   }
-  auto comparator = [this](Row& lhs, Row& rhs) -> bool {
-    for (auto iter = orderBy_.begin(); iter != orderBy_.end(); iter++) {
-      auto prop = iter->get_prop();
-      auto orderType = iter->get_direction();
-      auto lValue = lhs[colPos_[prop]];
-      auto rValue = rhs[colPos_[prop]];
-      if (lValue == rValue) {
+  // Resolve column position and direction once, and bind a typed comparator per column
+  // from the first row that holds a concrete value there. The heap then compares raw
+  // ints/floats/strings instead of running Value's type dispatch per comparison; rows
+  // where either side does not hold the bound type (e.g. nulls) fall back to the
+  // generic ordering.
+  struct Factor {
+    size_t pos;
+    bool ascending;
+    Value::Type type{Value::Type::__EMPTY__};
+    ValueComparator::Fn cmp{&ValueComparator::compareGeneric};
+  };
+  std::vector<Factor> factors;
+  factors.reserve(orderBy_.size());
+  for (auto iter = orderBy_.begin(); iter != orderBy_.end(); iter++) {
+    Factor factor;
+    factor.pos = colPos_[iter->get_prop()];
+    factor.ascending = iter->get_direction() == cpp2::OrderDirection::ASCENDING;
+    factors.emplace_back(factor);
+  }
+
+  auto comparator = [&factors](Row& lhs, Row& rhs) -> bool {
+    for (auto& factor : factors) {
+      const Value& lValue = lhs[factor.pos];
+      const Value& rValue = rhs[factor.pos];
+      int cmp = (lValue.type() == factor.type && rValue.type() == factor.type)
+                    ? factor.cmp(lValue, rValue)
+                    : ValueComparator::compareGeneric(lValue, rValue);
+      if (cmp == 0) {
         continue;
       }
-      if (orderType == cpp2::OrderDirection::ASCENDING) {
-        return lValue < rValue;
-      } else if (orderType == cpp2::OrderDirection::DESCENDING) {
-        return lValue > rValue;
-      }
+      return factor.ascending ? cmp < 0 : cmp > 0;
     }
     return false;
   };
@@ -95,7 +114,17 @@ void IndexTopNNode::topN() {
       return;
     }
     if (result.hasData()) {
-      topNHeap.push(std::move(result).row());
+      auto row = std::move(result).row();
+      for (auto& factor : factors) {
+        if (factor.type == Value::Type::__EMPTY__ && factor.pos < row.size()) {
+          auto type = row[factor.pos].type();
+          if (type != Value::Type::__EMPTY__ && type != Value::Type::NULLVALUE) {
+            factor.type = type;
+            factor.cmp = ValueComparator::forType(type);
+          }
+        }
+      }
+      topNHeap.push(std::move(row));
     } else {
       break;
     }
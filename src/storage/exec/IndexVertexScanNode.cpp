@@ -34,10 +34,10 @@ IndexVertexScanNode::IndexVertexScanNode(RuntimeContext* context,
     auto schemaMgr = env->schemaMan_;
     auto allSchema = schemaMgr->getAllVerTagSchema(this->spaceId_);
     auto tagId = this->index_->get_schema_id().get_tag_id();
-    if (!allSchema.ok() || !allSchema.value().count(tagId)) {
+    if (!allSchema.ok() || !allSchema.value()->count(tagId)) {
       return ::nebula::cpp2::ErrorCode::E_TAG_NOT_FOUND;
     }
-    tag = allSchema.value().at(tagId);
+    tag = allSchema.value()->at(tagId);
     return ::nebula::cpp2::ErrorCode::SUCCEEDED;
   });
 }
@@ -82,7 +82,7 @@ Row IndexVertexScanNode::decodeFromIndex(folly::StringPiece key) {
 Map<std::string, Value> IndexVertexScanNode::decodeFromBase(const std::string& key,
                                                             const std::string& value) {
   Map<std::string, Value> values;
-  auto reader = RowReaderWrapper::getRowReader(tag_, folly::StringPiece(value));
+  reader_.reset(tag_, folly::StringPiece(value));
   for (auto& col : requiredAndHintColumns_) {
     switch (QueryUtils::toReturnColType(col)) {
       case QueryUtils::ReturnColType::kVid: {
@@ -101,7 +101,7 @@ Map<std::string, Value> IndexVertexScanNode::decodeFromBase(const std::string& k
         if (field == nullptr) {
           values[col] = Value::kNullUnknownProp;
         } else {
-          auto retVal = QueryUtils::readValue(reader.get(), col, field);
+          auto retVal = QueryUtils::readValue(reader_.get(), col, field);
           if (!retVal.ok()) {
             LOG(FATAL) << "Bad value for field" << col;
           }
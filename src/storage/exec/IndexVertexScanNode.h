@@ -44,6 +44,8 @@ class IndexVertexScanNode final : public IndexScanNode {
     return tag_;
   }
   TagSchemas tag_;
+  // Reused across the rows of one scan, reset per row in decodeFromBase
+  RowReaderWrapper reader_;
   using IndexItem = ::nebula::meta::cpp2::IndexItem;
   // Convenient for testing
   std::function<::nebula::cpp2::ErrorCode(std::shared_ptr<IndexItem>&)> getIndex;
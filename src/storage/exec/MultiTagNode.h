@@ -20,7 +20,7 @@ namespace storage {
  *
  * @see IterateNode
  */
-class MultiTagNode : public IterateNode<VertexID> {
+class MultiTagNode final : public IterateNode<VertexID> {
  public:
   using RelNode::doExecute;
 
@@ -109,6 +109,31 @@ class QueryUtils final {
     return value;
   }
 
+  /**
+   * @brief Projection-aware read of a prop through its PropContext.
+   *
+   * When the row is encoded with the very schema the prop context was resolved against, the
+   * pre-resolved field descriptor gives the byte offset of the field directly, so the per-row
+   * name lookup is skipped and only the requested field is decoded. Rows of older schema
+   * versions fall back to the name based path.
+   */
+  static StatusOr<nebula::Value> readValue(RowReaderWrapper* reader, const PropContext& ctx) {
+    if (ctx.field_ != nullptr && ctx.fieldSchema_ != nullptr &&
+        ctx.fieldSchema_ == reader->getSchema()) {
+      auto value = reader->getValueByField(ctx.field_);
+      if (value.type() == Value::Type::NULLVALUE) {
+        // a nullable field really holds null, the field descriptor rules out UNKNOWN_PROP
+        return value;
+      }
+      if (ctx.field_->type() == nebula::cpp2::PropertyType::FIXED_STRING) {
+        const auto& fixedStr = value.getStr();
+        return fixedStr.substr(0, fixedStr.find_first_of('\0'));
+      }
+      return value;
+    }
+    return readValue(reader, ctx.name_, ctx.field_);
+  }
+
   /**
    * @brief read prop value, If the RowReader contains this field, read from the rowreader,
    * otherwise read the default value or null value from the latest schema
@@ -136,7 +161,7 @@ class QueryUtils final {
     switch (prop.propInKeyType_) {
       // prop in value
       case PropContext::PropInKeyType::NONE: {
-        return readValue(reader, prop.name_, prop.field_);
+        return readValue(reader, prop);
       }
       case PropContext::PropInKeyType::SRC: {
         auto srcId = NebulaKeyUtils::getSrcId(vIdLen, key);
@@ -168,6 +193,44 @@ class QueryUtils final {
     return Status::Error(folly::stringPrintf("Invalid property %s", prop.name_.c_str()));
   }
 
+  // Same as readEdgeProp() above, but takes the in-key fields pre-decoded by
+  // NebulaKeyUtils::decodeEdgeKeys(), so batched scan paths do not re-derive them per prop
+  static StatusOr<nebula::Value> readEdgeProp(VertexIDSlice srcId,
+                                              EdgeType edgeType,
+                                              EdgeRanking edgeRank,
+                                              VertexIDSlice dstId,
+                                              bool isIntId,
+                                              RowReaderWrapper* reader,
+                                              const PropContext& prop) {
+    switch (prop.propInKeyType_) {
+      // prop in value
+      case PropContext::PropInKeyType::NONE: {
+        return readValue(reader, prop);
+      }
+      case PropContext::PropInKeyType::SRC: {
+        if (isIntId) {
+          return *reinterpret_cast<const int64_t*>(srcId.data());
+        }
+        return srcId.subpiece(0, srcId.find_first_of('\0')).toString();
+      }
+      case PropContext::PropInKeyType::TYPE: {
+        return edgeType;
+      }
+      case PropContext::PropInKeyType::RANK: {
+        return edgeRank;
+      }
+      case PropContext::PropInKeyType::DST: {
+        if (isIntId) {
+          return *reinterpret_cast<const int64_t*>(dstId.data());
+        }
+        return dstId.subpiece(0, dstId.find_first_of('\0')).toString();
+      }
+      default:
+        LOG(FATAL) << "Should not read here";
+    }
+    return Status::Error(folly::stringPrintf("Invalid property %s", prop.name_.c_str()));
+  }
+
   static StatusOr<nebula::Value> readVertexProp(folly::StringPiece key,
                                                 size_t vIdLen,
                                                 bool isIntId,
@@ -176,7 +239,7 @@ class QueryUtils final {
     switch (prop.propInKeyType_) {
       // prop in value
       case PropContext::PropInKeyType::NONE: {
-        return readValue(reader, prop.name_, prop.field_);
+        return readValue(reader, prop);
       }
       case PropContext::PropInKeyType::VID: {
         auto vId = NebulaKeyUtils::getVertexId(vIdLen, key);
@@ -212,7 +275,12 @@ class QueryUtils final {
       NG_RETURN_IF_ERROR(value);
       if (prop.returned_) {
         VLOG(2) << "Collect prop " << prop.name_;
-        list.emplace_back(value.value());
+        if (prop.filtered_ && expCtx != nullptr) {
+          list.emplace_back(value.value());
+        } else {
+          // not needed by the filter context, move it into the result directly
+          list.emplace_back(std::move(value).value());
+        }
       }
       if (prop.filtered_ && expCtx != nullptr) {
         expCtx->setTagProp(tagName, prop.name_, std::move(value).value());
@@ -237,7 +305,12 @@ class QueryUtils final {
       NG_RETURN_IF_ERROR(value);
       if (prop.returned_) {
         VLOG(2) << "Collect prop " << prop.name_;
-        list.emplace_back(value.value());
+        if (prop.filtered_ && expCtx != nullptr) {
+          list.emplace_back(value.value());
+        } else {
+          // not needed by the filter context, move it into the result directly
+          list.emplace_back(std::move(value).value());
+        }
       }
       if (prop.filtered_ && expCtx != nullptr) {
         expCtx->setEdgeProp(edgeName, prop.name_, std::move(value).value());
@@ -62,6 +62,24 @@ class RelNode {
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
+  /**
+   * @brief batch entry: run `execute` over a batch of inputs of one partition
+   *
+   * The default implementation just loops over the per-input `execute`, which keeps the
+   * volcano-style semantics of the DAG untouched. Nodes which can amortize per-input setup cost
+   * (iterator seek, row-reader construction, filter context binding) across a batch should
+   * override this method.
+   */
+  virtual nebula::cpp2::ErrorCode execute(PartitionID partId, const std::vector<T>& inputs) {
+    for (const auto& input : inputs) {
+      auto ret = execute(partId, input);
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return ret;
+      }
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
   virtual nebula::cpp2::ErrorCode execute(PartitionID partId) {
     duration_.resume();
     auto ret = doExecute(partId);
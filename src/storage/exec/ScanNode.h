@@ -7,6 +7,8 @@
 #define STORAGE_EXEC_SCANNODE_H
 
 #include "common/base/Base.h"
+#include "kvstore/PrefetchIterator.h"
+#include "storage/StorageFlags.h"
 #include "storage/exec/GetPropNode.h"
 
 namespace nebula {
@@ -14,6 +16,9 @@ namespace storage {
 
 using Cursor = std::string;
 
+// Number of edge keys an edge scan decodes per batch, see NebulaKeyUtils::decodeEdgeKeys()
+constexpr std::size_t kKeyDecodeBatchSize = 128;
+
 /**
  * @brief Node to scan vertices of one partition
  */
@@ -75,13 +80,18 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
     if (kvRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return kvRet;
     }
+    if (FLAGS_scan_prefetch_depth > 0) {
+      iter = std::make_unique<kvstore::PrefetchIterator>(std::move(iter), FLAGS_scan_prefetch_depth);
+    }
 
     const auto rowLimit = limit_;
     auto vIdLen = context_->vIdLen();
     auto isIntId = context_->isIntId();
     std::string currentVertexId;
+    bool budgetStop = false;
     for (; iter->valid() && static_cast<int64_t>(resultDataSet_->rowSize()) < rowLimit;
          iter->next()) {
+      context_->addScanCost(1);
       auto key = iter->key();
       auto tagId = NebulaKeyUtils::getTagId(vIdLen, key);
       auto tagIdIndex = tagNodesIndex_.find(tagId);
@@ -94,6 +104,12 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
         if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
           return ret;
         }
+        // Stop on the vertex boundary once the request's scan budget is used up, the
+        // cursor below then resumes from the first key of the untouched vertex
+        if (context_->scanBudgetExhausted()) {
+          budgetStop = true;
+          break;
+        }
       }  // collect vertex row
       currentVertexId = vertexId;
       if (static_cast<int64_t>(resultDataSet_->rowSize()) >= rowLimit) {
@@ -102,7 +118,7 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
       auto value = iter->val();
       tagNodes_[tagIdIndex->second]->doExecute(key.toString(), value.toString());
     }  // iterate key
-    if (static_cast<int64_t>(resultDataSet_->rowSize()) < rowLimit) {
+    if (!budgetStop && static_cast<int64_t>(resultDataSet_->rowSize()) < rowLimit) {
       ret = collectOneRow(isIntId, vIdLen, currentVertexId);
       if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
         return ret;
@@ -112,6 +128,7 @@ class ScanVertexPropNode : public QueryNode<Cursor> {
     cpp2::ScanCursor c;
     if (iter->valid()) {
       c.next_cursor_ref() = iter->key().str();
+      CommonUtils::fillScanCursor(context_->env(), context_->spaceId(), partId, c);
     }
     cursors_->emplace(partId, std::move(c));
     return nebula::cpp2::ErrorCode::SUCCEEDED;
@@ -249,38 +266,70 @@ class ScanEdgePropNode : public QueryNode<Cursor> {
     if (kvRet != nebula::cpp2::ErrorCode::SUCCEEDED) {
       return kvRet;
     }
+    if (FLAGS_scan_prefetch_depth > 0) {
+      iter = std::make_unique<kvstore::PrefetchIterator>(std::move(iter), FLAGS_scan_prefetch_depth);
+    }
 
     auto rowLimit = limit_;
     auto vIdLen = context_->vIdLen();
     auto isIntId = context_->isIntId();
-    for (; iter->valid() && static_cast<int64_t>(resultDataSet_->rowSize()) < rowLimit;
-         iter->next()) {
-      auto key = iter->key();
-      if (!NebulaKeyUtils::isEdge(vIdLen, key)) {
-        continue;
-      }
-      auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen, key);
-      auto edgeNodeIndex = edgeNodesIndex_.find(edgeType);
-      if (edgeNodeIndex == edgeNodesIndex_.end()) {
-        continue;
+    // Scan in chunks: gather the matching key/values first, batch decode the in-key edge
+    // fields into columns in one pass, then build the rows from the decoded columns
+    std::vector<std::string> keys;
+    std::vector<std::string> values;
+    std::vector<std::size_t> edgeNodeIdx;
+    std::vector<folly::StringPiece> keySlices;
+    while (iter->valid() && static_cast<int64_t>(resultDataSet_->rowSize()) < rowLimit &&
+           !context_->scanBudgetExhausted()) {
+      const auto remaining = rowLimit - static_cast<int64_t>(resultDataSet_->rowSize());
+      const auto chunkSize =
+          std::min<int64_t>(remaining, static_cast<int64_t>(kKeyDecodeBatchSize));
+      keys.clear();
+      values.clear();
+      edgeNodeIdx.clear();
+      // The scan budget is re-checked per gathered key, so a chunk stops growing as soon
+      // as the budget runs out and the cursor below resumes from the first untouched key
+      for (; iter->valid() && static_cast<int64_t>(keys.size()) < chunkSize &&
+             !context_->scanBudgetExhausted();
+           iter->next()) {
+        context_->addScanCost(1);
+        auto key = iter->key();
+        if (!NebulaKeyUtils::isEdge(vIdLen, key)) {
+          continue;
+        }
+        auto edgeType = NebulaKeyUtils::getEdgeType(vIdLen, key);
+        auto edgeNodeIndex = edgeNodesIndex_.find(edgeType);
+        if (edgeNodeIndex == edgeNodesIndex_.end()) {
+          continue;
+        }
+        keys.emplace_back(key.toString());
+        values.emplace_back(iter->val().toString());
+        edgeNodeIdx.emplace_back(edgeNodeIndex->second);
       }
-      auto value = iter->val();
-      edgeNodes_[edgeNodeIndex->second]->doExecute(key.toString(), value.toString());
-      ret = collectOneRow(isIntId, vIdLen);
-      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
-        return ret;
+      keySlices.assign(keys.begin(), keys.end());
+      NebulaKeyUtils::EdgeKeyColumns columns;
+      NebulaKeyUtils::decodeEdgeKeys(vIdLen, keySlices, &columns);
+      for (std::size_t i = 0; i < keys.size(); ++i) {
+        edgeNodes_[edgeNodeIdx[i]]->doExecute(keys[i], values[i]);
+        ret = collectOneRow(isIntId, columns, i);
+        if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+          return ret;
+        }
       }
     }
 
     cpp2::ScanCursor c;
     if (iter->valid()) {
       c.next_cursor_ref() = iter->key().str();
+      CommonUtils::fillScanCursor(context_->env(), context_->spaceId(), partId, c);
     }
     cursors_->emplace(partId, std::move(c));
     return nebula::cpp2::ErrorCode::SUCCEEDED;
   }
 
-  nebula::cpp2::ErrorCode collectOneRow(bool isIntId, std::size_t vIdLen) {
+  nebula::cpp2::ErrorCode collectOneRow(bool isIntId,
+                                        const NebulaKeyUtils::EdgeKeyColumns& columns,
+                                        std::size_t idx) {
     List row;
     nebula::cpp2::ErrorCode ret = nebula::cpp2::ErrorCode::SUCCEEDED;
     // Usually there is only one edge node, when all of the edgeNodes are invalid (e.g. ttl
@@ -304,13 +353,19 @@ class ScanEdgePropNode : public QueryNode<Cursor> {
             }
             return nebula::cpp2::ErrorCode::SUCCEEDED;
           },
-          [&row, vIdLen, isIntId, edgeNode = edgeNode.get(), this](
-              folly::StringPiece key,
+          [&row, &columns, idx, isIntId, edgeNode = edgeNode.get(), this](
+              folly::StringPiece,
               RowReaderWrapper* reader,
               const std::vector<PropContext>* props) -> nebula::cpp2::ErrorCode {
             for (const auto& prop : *props) {
               if (prop.returned_ || (prop.filtered_ && expCtx_ != nullptr)) {
-                auto value = QueryUtils::readEdgeProp(key, vIdLen, isIntId, reader, prop);
+                auto value = QueryUtils::readEdgeProp(columns.srcs[idx],
+                                                      columns.types[idx],
+                                                      columns.ranks[idx],
+                                                      columns.dsts[idx],
+                                                      isIntId,
+                                                      reader,
+                                                      prop);
                 if (!value.ok()) {
                   return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
                 }
@@ -8,6 +8,7 @@
 
 #include "codec/RowReaderWrapper.h"
 #include "common/base/Base.h"
+#include "common/utils/NebulaKeyUtils.h"
 #include "kvstore/KVIterator.h"
 #include "storage/CommonUtils.h"
 #include "storage/StorageFlags.h"
@@ -59,6 +60,41 @@ class StorageIterator {
   virtual RowReaderWrapper* reader() const = 0;
 };
 
+/**
+ * @brief KVIterator over an edge block handed out by the EdgeListCache, shares ownership of the
+ * block with the cache
+ *
+ */
+class CachedEdgeBlockIter : public kvstore::KVIterator {
+ public:
+  explicit CachedEdgeBlockIter(std::shared_ptr<std::vector<kvstore::KV>> block)
+      : block_(std::move(block)) {}
+
+  bool valid() const override {
+    return idx_ < block_->size();
+  }
+
+  void next() override {
+    idx_++;
+  }
+
+  void prev() override {
+    idx_--;
+  }
+
+  folly::StringPiece key() const override {
+    return (*block_)[idx_].first;
+  }
+
+  folly::StringPiece val() const override {
+    return (*block_)[idx_].second;
+  }
+
+ private:
+  std::shared_ptr<std::vector<kvstore::KV>> block_;
+  size_t idx_{0};
+};
+
 /**
  * @brief Iterator of single specified type
  *
@@ -79,14 +115,18 @@ class SingleEdgeIterator : public StorageIterator {
                      EdgeType edgeType,
                      const std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>* schemas,
                      const std::optional<std::pair<std::string, int64_t>>* ttl)
-      : context_(context), iter_(std::move(iter)), edgeType_(edgeType), schemas_(schemas) {
+      : context_(context),
+        iter_(std::move(iter)),
+        edgeType_(edgeType),
+        schemas_(schemas),
+        scanLimit_(FLAGS_max_edge_scanned_per_vertex) {
     CHECK(!!iter_);
     if (ttl->has_value()) {
       hasTtl_ = true;
       ttlCol_ = ttl->value().first;
       ttlDuration_ = ttl->value().second;
     }
-    while (iter_->valid() && !check()) {
+    while (iter_->valid() && !exceedScanLimit() && !check()) {
       iter_->next();
     }
   }
@@ -101,7 +141,7 @@ class SingleEdgeIterator : public StorageIterator {
   void next() override {
     do {
       iter_->next();
-      if (!iter_->valid()) {
+      if (!iter_->valid() || exceedScanLimit()) {
         reader_.reset();
         break;
       }
@@ -124,15 +164,41 @@ class SingleEdgeIterator : public StorageIterator {
     return edgeType_;
   }
 
+  /**
+   * @brief hand the underlying kvstore iterator back, so the engine can re-seek it for the next
+   * vertex instead of allocating a new one
+   */
+  std::unique_ptr<kvstore::KVIterator> releaseKVIter() {
+    reader_.reset();
+    return std::move(iter_);
+  }
+
  protected:
+  /**
+   * @brief bound the number of edges examined per vertex, a super-node scan stops early once
+   * the bound is hit instead of decoding its remaining edges
+   */
+  bool exceedScanLimit() {
+    return scanLimit_ >= 0 && ++scanned_ > scanLimit_;
+  }
+
   /**
    * @brief return true when the value iter to a valid edge value
    */
   bool check() {
-    reader_.reset(*schemas_, iter_->val());
-    if (!reader_) {
-      context_->resultStat_ = ResultStatus::ILLEGAL_DATA;
-      return false;
+    if (FLAGS_in_edge_key_only && edgeType_ < 0 && iter_->val().empty()) {
+      // a key-only in-edge written under in_edge_key_only, fetch the props from its
+      // co-located out-edge row
+      if (!resolveOutEdge()) {
+        reader_.reset();
+        return false;
+      }
+    } else {
+      reader_.reset(*schemas_, iter_->val());
+      if (!reader_) {
+        context_->resultStat_ = ResultStatus::ILLEGAL_DATA;
+        return false;
+      }
     }
 
     if (hasTtl_ && CommonUtils::checkDataExpiredForTTL(
@@ -144,6 +210,50 @@ class SingleEdgeIterator : public StorageIterator {
     return true;
   }
 
+  /**
+   * @brief Resolve the props of a key-only in-edge against its out-edge row, which lives
+   * in the part of the source vertex. That part has to be held by this storaged (possibly
+   * as a follower), which is the deployment constraint of the in_edge_key_only flag.
+   */
+  bool resolveOutEdge() {
+    auto* env = context_->env();
+    auto spaceId = context_->spaceId();
+    auto vIdLen = context_->vIdLen();
+    auto key = iter_->key();
+    // the in-edge key holds (dst, -type, rank, src), swap the vertices back
+    auto src = NebulaKeyUtils::getDstId(vIdLen, key);
+    auto dst = NebulaKeyUtils::getSrcId(vIdLen, key);
+    auto rank = NebulaKeyUtils::getRank(vIdLen, key);
+    std::string srcVid;
+    if (context_->isIntId()) {
+      srcVid = src.str();
+    } else {
+      // part routing hashes the unpadded vid
+      srcVid = src.subpiece(0, src.find_first_of('\0')).toString();
+    }
+    if (partsNum_ < 0) {
+      auto partsNum = env->metaClient_->partsNum(spaceId);
+      if (!partsNum.ok()) {
+        return false;
+      }
+      partsNum_ = partsNum.value();
+    }
+    auto partId = env->metaClient_->partId(partsNum_, srcVid);
+    auto outKey = NebulaKeyUtils::edgeKey(vIdLen, partId, srcVid, -edgeType_, rank, dst.str());
+    auto code = env->kvstore_->get(spaceId, partId, outKey, &refValue_, true);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      VLOG(1) << "Out-edge row of a key-only in-edge not found locally, space " << spaceId
+              << " part " << partId << ", rc " << static_cast<int32_t>(code);
+      return false;
+    }
+    reader_.reset(*schemas_, refValue_);
+    if (!reader_) {
+      context_->resultStat_ = ResultStatus::ILLEGAL_DATA;
+      return false;
+    }
+    return true;
+  }
+
   RuntimeContext* context_;
   std::unique_ptr<kvstore::KVIterator> iter_;
   EdgeType edgeType_;
@@ -152,12 +262,21 @@ class SingleEdgeIterator : public StorageIterator {
   std::string ttlCol_;
   int64_t ttlDuration_;
 
+  // max number of edges to examine of one vertex, negative means unlimited
+  int64_t scanLimit_ = -1;
+  int64_t scanned_ = 0;
+
+  // number of parts of the space, lazily fetched when the first key-only in-edge is resolved
+  int32_t partsNum_ = -1;
+  // holds the out-edge row a key-only in-edge was resolved to, reader_ points into it
+  std::string refValue_;
+
   RowReaderWrapper reader_;
   EdgeRanking lastRank_ = 0;
   VertexID lastDstId_ = "";
 };
 
-class SingleEdgeKeyIterator : public SingleEdgeIterator {
+class SingleEdgeKeyIterator final : public SingleEdgeIterator {
  public:
   // A simplified iterator that only iterates keys, we can use this iterator when no ttl exists and
   // no property need to be read from value
@@ -179,9 +298,10 @@ class SingleEdgeKeyIterator : public SingleEdgeIterator {
 };
 
 /**
- * @brief Iterator of multiple SingleEdgeIterator, it will iterate over edges of different types
+ * @brief Iterator of multiple SingleEdgeIterator, it will iterate over edges of different types.
+ * Final, so iteration through a concrete MultiEdgeIterator* does not pay virtual dispatch.
  */
-class MultiEdgeIterator : public StorageIterator {
+class MultiEdgeIterator final : public StorageIterator {
  public:
   /**
    * @brief will move to a valid SingleEdgeIterator if there is one
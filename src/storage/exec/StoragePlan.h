@@ -53,6 +53,36 @@ class StoragePlan {
     return nodes_[outputIdx_]->execute(partId, input);
   }
 
+  /**
+   * @brief Batch entry of the plan: run over all inputs of one partition in one shot.
+   *
+   * Compared with calling `go(partId, input)` once per input, this goes through the batch
+   * `execute` of RelNode, so nodes could amortize per-input setup cost across the whole batch.
+   */
+  nebula::cpp2::ErrorCode go(PartitionID partId, const std::vector<T>& inputs) {
+    if (firstLoop_) {
+      auto output = std::make_unique<RelNode<T>>();
+      for (const auto& node : nodes_) {
+        if (!node->isDependent_) {
+          // add dependency of output node
+          output->addDependency(node.get());
+        }
+      }
+      outputIdx_ = addNode(std::move(output));
+      firstLoop_ = false;
+    }
+    CHECK_GE(outputIdx_, 0);
+    CHECK_LT(outputIdx_, nodes_.size());
+    // hand the whole batch to each end node, so their batch `execute` override could see it
+    for (auto* dep : nodes_[outputIdx_]->dependencies_) {
+      auto ret = dep->execute(partId, inputs);
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        return ret;
+      }
+    }
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+
   nebula::cpp2::ErrorCode go(PartitionID partId) {
     // find all end nodes (without dependents), and a dummy output node depends on all those nodes.
     if (firstLoop_) {
@@ -44,8 +44,8 @@ class TagNode final : public IterateNode<VertexID> {
         exp_(exp) {
     UNUSED(expCtx_);
     UNUSED(exp_);
-    auto schemaIter = tagContext_->schemas_.find(tagId_);
-    CHECK(schemaIter != tagContext_->schemas_.end());
+    auto schemaIter = tagContext_->schemas_->find(tagId_);
+    CHECK(schemaIter != tagContext_->schemas_->end());
     CHECK(!schemaIter->second.empty());
     schemas_ = &(schemaIter->second);
     ttl_ = QueryUtils::getTagTTLInfo(tagContext_, tagId_);
@@ -63,7 +63,8 @@ class TagNode final : public IterateNode<VertexID> {
     VLOG(1) << "partId " << partId << ", vId " << vId << ", tagId " << tagId_ << ", prop size "
             << props_->size();
     key_ = NebulaKeyUtils::tagKey(context_->vIdLen(), partId, vId, tagId_);
-    ret = context_->env()->kvstore_->get(context_->spaceId(), partId, key_, &value_);
+    ret = context_->env()->kvstore_->get(
+        context_->spaceId(), partId, key_, &value_, false, context_->snapshot(partId));
     if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
       return doExecute(key_, value_);
     } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
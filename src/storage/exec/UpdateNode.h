@@ -289,8 +289,8 @@ class UpdateTagNode : public UpdateNode<VertexID> {
    * @return E_TAG_NOT_FOUND if tag not found.
    */
   nebula::cpp2::ErrorCode getLatestTagSchemaAndName() {
-    auto schemaIter = tagContext_->schemas_.find(tagId_);
-    if (schemaIter == tagContext_->schemas_.end() || schemaIter->second.empty()) {
+    auto schemaIter = tagContext_->schemas_->find(tagId_);
+    if (schemaIter == tagContext_->schemas_->end() || schemaIter->second.empty()) {
       return nebula::cpp2::ErrorCode::E_TAG_NOT_FOUND;
     }
     schema_ = schemaIter->second.back().get();
@@ -633,8 +633,8 @@ class UpdateEdgeNode : public UpdateNode<cpp2::EdgeKey> {
    * @return E_EDGE_NOT_FOUND if edge not found
    */
   nebula::cpp2::ErrorCode getLatestEdgeSchemaAndName() {
-    auto schemaIter = edgeContext_->schemas_.find(std::abs(edgeType_));
-    if (schemaIter == edgeContext_->schemas_.end() || schemaIter->second.empty()) {
+    auto schemaIter = edgeContext_->schemas_->find(std::abs(edgeType_));
+    if (schemaIter == edgeContext_->schemas_->end() || schemaIter->second.empty()) {
       return nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
     }
     schema_ = schemaIter->second.back().get();
@@ -24,6 +24,49 @@
 
 namespace nebula {
 namespace storage {
+namespace {
+
+// Contexts generated by expanding an IN list over an index column are identical except for the
+// values in their column hints. Two such contexts can share one IndexScanNode which executes
+// both ranges in key order with successive seeks, instead of one scan node (and one kvstore
+// iterator) per IN element unioned through dedup. Fusion requires a prefix column value to
+// differ: then the ranges are disjoint and the fused scan cannot produce duplicate rows. If
+// only the bounds of the trailing range hint differ, the ranges may overlap, so those contexts
+// keep their own scan nodes and go through the dedup path.
+bool fusableHints(const std::vector<cpp2::IndexColumnHint>& lhs,
+                  const std::vector<cpp2::IndexColumnHint>& rhs) {
+  if (lhs.size() != rhs.size()) {
+    return false;
+  }
+  bool prefixDiffers = false;
+  for (size_t i = 0; i < lhs.size(); i++) {
+    auto& l = lhs[i];
+    auto& r = rhs[i];
+    if (l.get_column_name() != r.get_column_name() || l.get_scan_type() != r.get_scan_type() ||
+        l.get_include_begin() != r.get_include_begin() ||
+        l.get_include_end() != r.get_include_end()) {
+      return false;
+    }
+    if (l.get_scan_type() == cpp2::ScanType::PREFIX &&
+        l.get_begin_value() != r.get_begin_value()) {
+      prefixDiffers = true;
+    }
+  }
+  return prefixDiffers;
+}
+
+bool fusableContext(const cpp2::IndexQueryContext& lhs, const cpp2::IndexQueryContext& rhs) {
+  if (lhs.get_index_id() != rhs.get_index_id()) {
+    return false;
+  }
+  if (lhs.filter_ref().value_or("") != rhs.filter_ref().value_or("")) {
+    return false;
+  }
+  return fusableHints(lhs.get_column_hints(), rhs.get_column_hints());
+}
+
+}  // namespace
+
 ProcessorCounters kLookupCounters;
 // print Plan for debug
 inline void printPlan(IndexNode* node, int tab = 0);
@@ -118,12 +161,28 @@ void LookupProcessor::doProcess(const cpp2::LookupIndexRequest& req) {
 ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::buildPlan(
     const cpp2::LookupIndexRequest& req) {
   std::vector<std::unique_ptr<IndexNode>> nodes;
+  std::vector<const cpp2::IndexQueryContext*> nodeCtxs;
+  std::vector<IndexScanNode*> scanNodes;
   for (auto& ctx : req.get_indices().get_contexts()) {
-    auto scan = buildOneContext(ctx);
+    bool fused = false;
+    for (size_t i = 0; i < nodes.size(); i++) {
+      if (fusableContext(*nodeCtxs[i], ctx)) {
+        scanNodes[i]->addHintSet(ctx.get_column_hints());
+        fused = true;
+        break;
+      }
+    }
+    if (fused) {
+      continue;
+    }
+    IndexScanNode* scanNode = nullptr;
+    auto scan = buildOneContext(ctx, scanNode);
     if (!ok(scan)) {
       return error(scan);
     }
     nodes.emplace_back(std::move(value(scan)));
+    nodeCtxs.emplace_back(&ctx);
+    scanNodes.emplace_back(scanNode);
   }
   for (size_t i = 0; i < nodes.size(); i++) {
     auto projection =
@@ -171,7 +230,7 @@ ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::bu
 }
 
 ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::buildOneContext(
-    const cpp2::IndexQueryContext& ctx) {
+    const cpp2::IndexQueryContext& ctx, IndexScanNode*& scanNode) {
   std::unique_ptr<IndexNode> node;
   DLOG(INFO) << ctx.get_column_hints().size();
   DLOG(INFO) << &ctx.get_column_hints();
@@ -207,6 +266,7 @@ ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> LookupProcessor::bu
                                                  context_->env()->kvstore_,
                                                  hasNullableCol);
   }
+  scanNode = static_cast<IndexScanNode*>(node.get());
   if (ctx.filter_ref().is_set() && !ctx.get_filter().empty()) {
     auto expr = Expression::decode(context_->objPool(), *ctx.filter_ref());
     auto filterNode = std::make_unique<IndexSelectionNode>(context_.get(), expr);
@@ -11,6 +11,8 @@
 #include "storage/exec/IndexNode.h"
 namespace nebula {
 namespace storage {
+class IndexScanNode;
+
 extern ProcessorCounters kLookupCounters;
 
 /**
@@ -31,6 +33,9 @@ class LookupProcessor : public BaseProcessor<cpp2::LookupIndexResp> {
       : BaseProcessor<cpp2::LookupIndexResp>(env, counters), executor_(executor) {}
   void doProcess(const cpp2::LookupIndexRequest& req);
   void onProcessFinished() {
+    if (planContext_->scanBudgetExhausted()) {
+      BaseProcessor<cpp2::LookupIndexResp>::result_.scan_budget_exhausted_ref() = true;
+    }
     BaseProcessor<cpp2::LookupIndexResp>::resp_.data_ref() = std::move(resultDataSet_);
     BaseProcessor<cpp2::LookupIndexResp>::resp_.stat_data_ref() = std::move(statsDataSet_);
   }
@@ -41,7 +46,7 @@ class LookupProcessor : public BaseProcessor<cpp2::LookupIndexResp> {
   ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> buildPlan(
       const cpp2::LookupIndexRequest& req);
   ErrorOr<nebula::cpp2::ErrorCode, std::unique_ptr<IndexNode>> buildOneContext(
-      const cpp2::IndexQueryContext& ctx);
+      const cpp2::IndexQueryContext& ctx, IndexScanNode*& scanNode);
   std::vector<std::unique_ptr<IndexNode>> reproducePlan(IndexNode* root, size_t count);
   ErrorOr<nebula::cpp2::ErrorCode, std::vector<std::pair<std::string, cpp2::StatType>>>
   handleStatProps(const std::vector<cpp2::StatProp>& statProps);
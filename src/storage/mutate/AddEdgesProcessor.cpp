@@ -13,6 +13,8 @@
 #include "common/utils/IndexKeyUtils.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "common/utils/OperationKeyUtils.h"
+#include "storage/StorageFlags.h"
+#include "storage/stats/ApproxStats.h"
 #include "storage/stats/StorageStats.h"
 
 namespace nebula {
@@ -65,6 +67,18 @@ void AddEdgesProcessor::process(const cpp2::AddEdgesRequest& req) {
 
   CHECK_NOTNULL(env_->kvstore_);
 
+  if (FLAGS_enable_approx_stats) {
+    for (auto& part : partEdges) {
+      for (auto& edge : part.second) {
+        // only out-edges, the in-edge of a pair lives in the destination's part
+        if (*edge.get_key().edge_type_ref() > 0) {
+          ApproxStats::instance().addOutEdge(
+              spaceId_, part.first, edge.get_key().get_src().getStr());
+        }
+      }
+    }
+  }
+
   if (indexes_.empty()) {
     doProcess(req);
   } else {
@@ -80,13 +94,15 @@ void AddEdgesProcessor::doProcess(const cpp2::AddEdgesRequest& req) {
     const auto& newEdges = part.second;
 
     std::vector<kvstore::KV> data;
-    data.reserve(32);
+    data.reserve(newEdges.size());
     auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
     std::unordered_set<std::string> visited;
-    visited.reserve(newEdges.size());
+    if (ifNotExists_) {
+      visited.reserve(newEdges.size());
+    }
 
     for (auto& newEdge : newEdges) {
-      auto edgeKey = *newEdge.key_ref();
+      const auto& edgeKey = *newEdge.key_ref();
       VLOG(3) << "PartitionID: " << partId << ", VertexID: " << *edgeKey.src_ref()
               << ", EdgeType: " << *edgeKey.edge_type_ref()
               << ", EdgeRanking: " << *edgeKey.ranking_ref()
@@ -101,6 +117,7 @@ void AddEdgesProcessor::doProcess(const cpp2::AddEdgesRequest& req) {
         break;
       }
 
+      CommonUtils::invalidateEdgeListCache(env_, spaceId_, edgeKey);
       auto key = NebulaKeyUtils::edgeKey(spaceVidLen_,
                                          partId,
                                          edgeKey.src_ref()->getStr(),
@@ -130,7 +147,13 @@ void AddEdgesProcessor::doProcess(const cpp2::AddEdgesRequest& req) {
       }
       auto schema = schemaIter->second.get();
 
-      auto props = newEdge.get_props();
+      if (FLAGS_in_edge_key_only && *edgeKey.edge_type_ref() < 0) {
+        // key-only in-edge, readers resolve the props against the out-edge row
+        data.emplace_back(std::move(key), "");
+        continue;
+      }
+
+      const auto& props = newEdge.get_props();
       WriteResult wRet;
       auto retEnc = encodeRowVal(schema, propNames, props, wRet);
       if (!retEnc.ok()) {
@@ -176,7 +199,7 @@ void AddEdgesProcessor::doProcessWithIndex(const cpp2::AddEdgesRequest& req) {
       continue;
     }
     for (const auto& edge : edges) {
-      auto edgeKey = *edge.key_ref();
+      const auto& edgeKey = *edge.key_ref();
       VLOG(3) << "PartitionID: " << partId << ", VertexID: " << *edgeKey.src_ref()
               << ", EdgeType: " << *edgeKey.edge_type_ref()
               << ", EdgeRanking: " << *edgeKey.ranking_ref()
@@ -190,12 +213,19 @@ void AddEdgesProcessor::doProcessWithIndex(const cpp2::AddEdgesRequest& req) {
       }
       auto schema = schemaIter->second.get();
 
+      CommonUtils::invalidateEdgeListCache(env_, spaceId_, edgeKey);
       auto key = NebulaKeyUtils::edgeKey(spaceVidLen_,
                                          partId,
                                          edgeKey.src_ref()->getStr(),
                                          *edgeKey.edge_type_ref(),
                                          *edgeKey.ranking_ref(),
                                          (*edgeKey.dst_ref()).getStr());
+      if (FLAGS_in_edge_key_only && *edgeKey.edge_type_ref() < 0) {
+        // key-only in-edge, readers resolve the props against the out-edge row. In-edges
+        // carry no index of their own, so the atomic index path below is unaffected
+        kvs.emplace_back(std::move(key), "");
+        continue;
+      }
       // collect values
       WriteResult writeResult;
       const auto& props = edge.get_props();
@@ -266,6 +296,8 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
           if (oldReader != nullptr) {
             auto oldIndexKeys = indexKeys(partId, oldReader.get(), key, index, nullptr);
             if (!oldIndexKeys.empty()) {
+              addIndexStatsValue(
+                  kNumIndexKeysMaintained, index->get_index_id(), oldIndexKeys.size());
               ret.writeSet.insert(ret.writeSet.end(), oldIndexKeys.begin(), oldIndexKeys.end());
               // Check the index is building for the specified partition or
               // not.
@@ -291,6 +323,8 @@ kvstore::MergeableAtomicOpResult AddEdgesProcessor::addEdgesWithIndex(
           if (newReader != nullptr) {
             auto newIndexKeys = indexKeys(partId, newReader.get(), key, index, nullptr);
             if (!newIndexKeys.empty()) {
+              addIndexStatsValue(
+                  kNumIndexKeysMaintained, index->get_index_id(), newIndexKeys.size());
               // check if index has ttl field, write it to index value if exists
               auto field = CommonUtils::ttlValue(schema, newReader.get());
               auto indexVal = field.ok() ? IndexKeyUtils::indexVal(std::move(field).value()) : "";
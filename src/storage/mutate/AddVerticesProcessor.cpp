@@ -14,6 +14,7 @@
 #include "common/utils/NebulaKeyUtils.h"
 #include "common/utils/OperationKeyUtils.h"
 #include "storage/StorageFlags.h"
+#include "storage/stats/ApproxStats.h"
 #include "storage/stats/StorageStats.h"
 
 namespace nebula {
@@ -21,6 +22,9 @@ namespace storage {
 
 ProcessorCounters kAddVerticesCounters;
 
+// Shared fallback so tags without explicit prop names don't allocate a vector per row
+static const std::vector<std::string> kEmptyPropNames;
+
 void AddVerticesProcessor::process(const cpp2::AddVerticesRequest& req) {
   spaceId_ = req.get_space_id();
   const auto& partVertices = req.get_parts();
@@ -64,6 +68,13 @@ void AddVerticesProcessor::process(const cpp2::AddVerticesRequest& req) {
   ignoreExistedIndex_ = req.get_ignore_existed_index();
 
   CHECK_NOTNULL(env_->kvstore_);
+  if (FLAGS_enable_approx_stats) {
+    for (auto& part : partVertices) {
+      for (auto& vertex : part.second) {
+        ApproxStats::instance().addVertex(spaceId_, part.first, vertex.get_id().getStr());
+      }
+    }
+  }
   if (indexes_.empty()) {
     doProcess(req);
   } else {
@@ -79,12 +90,14 @@ void AddVerticesProcessor::doProcess(const cpp2::AddVerticesRequest& req) {
     const auto& vertices = part.second;
 
     std::vector<kvstore::KV> data;
-    data.reserve(32);
+    data.reserve(vertices.size());
     auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
     std::unordered_set<std::string> visited;
-    visited.reserve(vertices.size());
+    if (ifNotExists_) {
+      visited.reserve(vertices.size());
+    }
     for (auto& vertex : vertices) {
-      auto vid = vertex.get_id().getStr();
+      const auto& vid = vertex.get_id().getStr();
       const auto& newTags = vertex.get_tags();
 
       if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vid)) {
@@ -109,6 +122,7 @@ void AddVerticesProcessor::doProcess(const cpp2::AddVerticesRequest& req) {
         auto schema = schemaIter->second.get();
 
         auto key = NebulaKeyUtils::tagKey(spaceVidLen_, partId, vid, tagId);
+        CommonUtils::invalidateVertexAbsenceCache(env_, spaceId_, key);
         if (ifNotExists_) {
           if (!visited.emplace(key).second) {
             continue;
@@ -123,12 +137,9 @@ void AddVerticesProcessor::doProcess(const cpp2::AddVerticesRequest& req) {
             break;
           }
         }
-        auto props = newTag.get_props();
+        const auto& props = newTag.get_props();
         auto iter = propNamesMap.find(tagId);
-        std::vector<std::string> propNames;
-        if (iter != propNamesMap.end()) {
-          propNames = iter->second;
-        }
+        const auto& propNames = iter != propNamesMap.end() ? iter->second : kEmptyPropNames;
 
         WriteResult wRet;
         auto retEnc = encodeRowVal(schema, propNames, props, wRet);
@@ -165,7 +176,7 @@ void AddVerticesProcessor::doProcessWithIndex(const cpp2::AddVerticesRequest& re
     auto code = nebula::cpp2::ErrorCode::SUCCEEDED;
     deleteDupVid(const_cast<std::vector<cpp2::NewVertex>&>(vertices));
     for (const auto& vertex : vertices) {
-      auto vid = vertex.get_id().getStr();
+      const auto& vid = vertex.get_id().getStr();
       const auto& newTags = vertex.get_tags();
 
       if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vid)) {
@@ -191,13 +202,11 @@ void AddVerticesProcessor::doProcessWithIndex(const cpp2::AddVerticesRequest& re
         auto schema = schemaIter->second.get();
 
         auto key = NebulaKeyUtils::tagKey(spaceVidLen_, partId, vid, tagId);
+        CommonUtils::invalidateVertexAbsenceCache(env_, spaceId_, key);
         // collect values
         const auto& props = newTag.get_props();
         auto iter = propNamesMap.find(tagId);
-        std::vector<std::string> propNames;
-        if (iter != propNamesMap.end()) {
-          propNames = iter->second;
-        }
+        const auto& propNames = iter != propNamesMap.end() ? iter->second : kEmptyPropNames;
 
         WriteResult writeResult;
         auto encode = encodeRowVal(schema, propNames, props, writeResult);
@@ -231,6 +240,9 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
   kvstore::MergeableAtomicOpResult ret;
   ret.code = nebula::cpp2::ErrorCode::E_RAFT_ATOMIC_OP_FAILED;
   IndexCountWrapper wrapper(env_);
+  // The rebuild state is keyed by part only and the whole batch commits atomically, so one
+  // lookup per atomic op gives the same guarantee as the former lookup per row and index
+  auto indexState = env_->getIndexState(spaceId_, partId);
   auto batchHolder = std::make_unique<kvstore::BatchHolder>();
   for (auto& vertice : vertices) {
     batchHolder->put(std::string(vertice), "");
@@ -272,9 +284,9 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
         if (oldReader != nullptr) {
           auto oldIndexKeys = indexKeys(partId, vId.str(), oldReader.get(), index, schema);
           if (!oldIndexKeys.empty()) {
+            addIndexStatsValue(kNumIndexKeysMaintained, index->get_index_id(), oldIndexKeys.size());
             // Check the index is building for the specified partition or
             // not.
-            auto indexState = env_->getIndexState(spaceId_, partId);
             if (env_->checkRebuilding(indexState)) {
               auto delOpKey = OperationKeyUtils::deleteOperationKey(partId);
               for (auto& idxKey : oldIndexKeys) {
@@ -298,10 +310,10 @@ kvstore::MergeableAtomicOpResult AddVerticesProcessor::addVerticesWithIndex(
         if (newReader != nullptr) {
           auto newIndexKeys = indexKeys(partId, vId.str(), newReader.get(), index, schema);
           if (!newIndexKeys.empty()) {
+            addIndexStatsValue(kNumIndexKeysMaintained, index->get_index_id(), newIndexKeys.size());
             // check if index has ttl field, write it to index value if exists
             auto field = CommonUtils::ttlValue(schema, newReader.get());
             auto indexVal = field.ok() ? IndexKeyUtils::indexVal(std::move(field).value()) : "";
-            auto indexState = env_->getIndexState(spaceId_, partId);
             if (env_->checkRebuilding(indexState)) {
               for (auto& idxKey : newIndexKeys) {
                 auto opKey = OperationKeyUtils::modifyOperationKey(partId, idxKey);
@@ -28,6 +28,13 @@ class AddVerticesProcessor : public BaseProcessor<cpp2::ExecResponse> {
 
   void doProcess(const cpp2::AddVerticesRequest& req);
 
+  // Index entries are built synchronously inside the raft atomic op, so every indexed tag
+  // write amplifies into one read (old value) plus N index writes under the part write lock.
+  // The operation-log machinery (OperationKeyUtils + the rebuild task consumer) already defers
+  // index writes, but only while a rebuild is running and with lookups on that index disabled.
+  // Turning it into a standing async maintenance mode additionally needs a per-part consumer
+  // with a raft-replicated apply point, and LookupProcessor merging the not-yet-applied window
+  // into its results -- consistency work tracked separately.
   void doProcessWithIndex(const cpp2::AddVerticesRequest& req);
 
  private:
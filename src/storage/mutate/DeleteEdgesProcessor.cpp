@@ -65,6 +65,7 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
           code = nebula::cpp2::ErrorCode::E_INVALID_VID;
           break;
         }
+        CommonUtils::invalidateEdgeListCache(env_, spaceId_, edgeKey);
         // todo(doodle): delete lock in toss
         auto edge = NebulaKeyUtils::edgeKey(spaceVidLen_,
                                             partId,
@@ -112,6 +113,7 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
           err = nebula::cpp2::ErrorCode::E_INVALID_VID;
           break;
         }
+        CommonUtils::invalidateEdgeListCache(env_, spaceId_, edgeKey);
         auto l = std::make_tuple(spaceId_,
                                  partId,
                                  edgeKey.src_ref()->getStr(),
@@ -160,17 +162,52 @@ void DeleteEdgesProcessor::process(const cpp2::DeleteEdgesRequest& req) {
 ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
     PartitionID partId, const std::vector<cpp2::EdgeKey>& edges) {
   std::unique_ptr<kvstore::BatchHolder> batchHolder = std::make_unique<kvstore::BatchHolder>();
+  // Edges of unindexed types need no read, a tombstone is enough. Only the indexed ones have
+  // to be fetched to rebuild their index keys, and those are read in one multiGet per part
+  // instead of a get per edge.
+  std::vector<std::string> indexedKeys;
+  std::vector<const cpp2::EdgeKey*> indexedEdges;
   for (auto& edge : edges) {
     auto type = *edge.edge_type_ref();
-    auto srcId = (*edge.src_ref()).getStr();
-    auto rank = *edge.ranking_ref();
-    auto dstId = (*edge.dst_ref()).getStr();
-    auto key = NebulaKeyUtils::edgeKey(spaceVidLen_, partId, srcId, type, rank, dstId);
-    std::string val;
-    auto ret = env_->kvstore_->get(spaceId_, partId, key, &val);
-    auto schema = env_->schemaMan_->getEdgeSchema(spaceId_, std::abs(type));
-
-    if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+    auto key = NebulaKeyUtils::edgeKey(spaceVidLen_,
+                                       partId,
+                                       (*edge.src_ref()).getStr(),
+                                       type,
+                                       *edge.ranking_ref(),
+                                       (*edge.dst_ref()).getStr());
+    auto indexed = std::any_of(indexes_.begin(), indexes_.end(), [type](const auto& index) {
+      return type == index->get_schema_id().get_edge_type();
+    });
+    if (!indexed) {
+      batchHolder->remove(std::move(key));
+      stats::StatsManager::addValue(kNumEdgesDeleted);
+      continue;
+    }
+    indexedKeys.emplace_back(std::move(key));
+    indexedEdges.emplace_back(&edge);
+  }
+
+  std::vector<std::string> vals;
+  if (!indexedKeys.empty()) {
+    auto ret = env_->kvstore_->multiGet(spaceId_, partId, indexedKeys, &vals);
+    if (ret.first != nebula::cpp2::ErrorCode::SUCCEEDED &&
+        ret.first != nebula::cpp2::ErrorCode::E_PARTIAL_RESULT) {
+      VLOG(3) << "Error! ret = " << apache::thrift::util::enumNameSafe(ret.first) << ", spaceId "
+              << spaceId_;
+      return ret.first;
+    }
+    for (size_t i = 0; i < indexedKeys.size(); i++) {
+      if (!ret.second[i].ok()) {
+        // the edge does not exist, nothing to unindex
+        continue;
+      }
+      const auto& edge = *indexedEdges[i];
+      auto type = *edge.edge_type_ref();
+      auto srcId = (*edge.src_ref()).getStr();
+      auto rank = *edge.ranking_ref();
+      auto dstId = (*edge.dst_ref()).getStr();
+      auto schema = env_->schemaMan_->getEdgeSchema(spaceId_, std::abs(type));
+
       /**
        * just get the latest version edge for index.
        */
@@ -180,7 +217,7 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
           auto indexId = index->get_index_id();
 
           if (reader == nullptr) {
-            reader = RowReaderWrapper::getEdgePropReader(env_->schemaMan_, spaceId_, type, val);
+            reader = RowReaderWrapper::getEdgePropReader(env_->schemaMan_, spaceId_, type, vals[i]);
             if (reader == nullptr) {
               LOG(WARNING) << "Bad format row!";
               return nebula::cpp2::ErrorCode::E_INVALID_DATA;
@@ -193,6 +230,7 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
           }
           auto indexKeys = IndexKeyUtils::edgeIndexKeys(
               spaceVidLen_, partId, indexId, srcId, rank, dstId, std::move(valuesRet).value());
+          addIndexStatsValue(kNumIndexKeysMaintained, indexId, indexKeys.size());
 
           auto indexState = env_->getIndexState(spaceId_, partId);
           if (env_->checkRebuilding(indexState)) {
@@ -210,14 +248,8 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteEdgesProcessor::deleteEdges(
           }
         }
       }
-      batchHolder->remove(std::move(key));
+      batchHolder->remove(std::move(indexedKeys[i]));
       stats::StatsManager::addValue(kNumEdgesDeleted);
-    } else if (ret == nebula::cpp2::ErrorCode::E_KEY_NOT_FOUND) {
-      continue;
-    } else {
-      VLOG(3) << "Error! ret = " << apache::thrift::util::enumNameSafe(ret) << ", spaceId "
-              << spaceId_;
-      return ret;
     }
   }
 
@@ -131,6 +131,7 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteTagsProcessor::deleteTags(
           }
           auto indexKeys = IndexKeyUtils::vertexIndexKeys(
               spaceVidLen_, partId, indexId, vId, std::move(valuesRet).value());
+          addIndexStatsValue(kNumIndexKeysMaintained, indexId, indexKeys.size());
 
           // Check the index is building for the specified partition or not
           auto indexState = env_->getIndexState(spaceId_, partId);
@@ -161,6 +161,7 @@ ErrorOr<nebula::cpp2::ErrorCode, std::string> DeleteVerticesProcessor::deleteVer
           }
           auto indexKeys = IndexKeyUtils::vertexIndexKeys(
               spaceVidLen_, partId, indexId, vertex.getStr(), std::move(valuesRet).value());
+          addIndexStatsValue(kNumIndexKeysMaintained, indexId, indexKeys.size());
 
           // Check the index is building for the specified partition or not
           auto indexState = env_->getIndexState(spaceId_, partId);
@@ -79,6 +79,8 @@ void UpdateEdgeProcessor::doProcess(const cpp2::UpdateEdgeRequest& req) {
           << ", src: " << edgeKey_.get_src() << ", edge_type: " << edgeKey_.get_edge_type()
           << ", dst: " << edgeKey_.get_dst() << ", ranking: " << edgeKey_.get_ranking();
 
+  CommonUtils::invalidateEdgeListCache(env_, spaceId_, edgeKey_);
+
   auto plan = buildPlan(&resultDataSet_);
 
   auto ret = plan.go(partId, edgeKey_);
@@ -269,8 +271,8 @@ nebula::cpp2::ErrorCode UpdateEdgeProcessor::buildEdgeContext(const cpp2::Update
   context_->edgeType_ = edgeKey_.get_edge_type();
   context_->edgeName_ = iter->second;
   auto schemaMap = edgeContext_.schemas_;
-  auto iterSchema = schemaMap.find(std::abs(edgeKey_.get_edge_type()));
-  if (iterSchema != schemaMap.end()) {
+  auto iterSchema = schemaMap->find(std::abs(edgeKey_.get_edge_type()));
+  if (iterSchema != schemaMap->end()) {
     auto schemas = iterSchema->second;
     auto schema = schemas.back().get();
     if (!schema) {
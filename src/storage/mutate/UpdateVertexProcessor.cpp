@@ -5,8 +5,14 @@
 
 #include "storage/mutate/UpdateVertexProcessor.h"
 
+#include <folly/synchronization/Baton.h>
+
+#include <algorithm>
+
+#include "codec/RowWriterV2.h"
 #include "common/base/Base.h"
 #include "common/memory/MemoryTracker.h"
+#include "common/utils/MemoryLockWrapper.h"
 #include "common/utils/NebulaKeyUtils.h"
 #include "storage/exec/FilterNode.h"
 #include "storage/exec/TagNode.h"
@@ -30,12 +36,19 @@ void UpdateVertexProcessor::process(const cpp2::UpdateVertexRequest& req) {
 void UpdateVertexProcessor::doProcess(const cpp2::UpdateVertexRequest& req) {
   spaceId_ = req.get_space_id();
   auto partId = req.get_part_id();
-  auto vId = req.get_vertex_id();
   tagId_ = req.get_tag_id();
   updatedProps_ = req.get_updated_props();
   if (req.insertable_ref().has_value()) {
     insertable_ = *req.insertable_ref();
   }
+  // The batch form carries all ids of this part in vertex_ids; a plain request is a
+  // batch of one
+  std::vector<Value> vIds;
+  if (req.vertex_ids_ref().has_value() && !(*req.vertex_ids_ref()).empty()) {
+    vIds = *req.vertex_ids_ref();
+  } else {
+    vIds.emplace_back(req.get_vertex_id());
+  }
 
   auto retCode = getSpaceVidLen(spaceId_);
   if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -44,12 +57,14 @@ void UpdateVertexProcessor::doProcess(const cpp2::UpdateVertexRequest& req) {
     return;
   }
 
-  if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vId.getStr())) {
-    LOG(ERROR) << "Space " << spaceId_ << ", vertex length invalid, "
-               << " space vid len: " << spaceVidLen_ << ",  vid is " << vId;
-    pushResultCode(nebula::cpp2::ErrorCode::E_INVALID_VID, partId);
-    onFinished();
-    return;
+  for (const auto& vId : vIds) {
+    if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vId.getStr())) {
+      LOG(ERROR) << "Space " << spaceId_ << ", vertex length invalid, "
+                 << " space vid len: " << spaceVidLen_ << ",  vid is " << vId;
+      pushResultCode(nebula::cpp2::ErrorCode::E_INVALID_VID, partId);
+      onFinished();
+      return;
+    }
   }
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
@@ -73,9 +88,47 @@ void UpdateVertexProcessor::doProcess(const cpp2::UpdateVertexRequest& req) {
   }
   indexes_ = std::move(iRet).value();
 
-  VLOG(3) << "Update vertex, spaceId: " << spaceId_ << ", partId: " << partId << ", vId: " << vId;
-  auto plan = buildPlan(&resultDataSet_);
-  auto ret = plan.go(partId, vId.getStr());
+  VLOG(3) << "Update vertex, spaceId: " << spaceId_ << ", partId: " << partId
+          << ", batch size: " << vIds.size();
+  // A full-assignment unconditional upsert on an unindexed tag needs neither the old
+  // rows nor the old index entries, so skip the read-modify-write plan entirely and
+  // write the whole batch with one put
+  if (blindPutEligible_) {
+    auto hasTagIndex = std::any_of(indexes_.begin(), indexes_.end(), [this](const auto& index) {
+      return index->get_schema_id().get_tag_id() == tagId_;
+    });
+    if (!hasTagIndex) {
+      auto code = blindPut(partId, vIds);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        handleErrorCode(code, spaceId_, partId);
+      } else {
+        onProcessFinished();
+      }
+      onFinished();
+      return;
+    }
+  }
+
+  // Each vertex runs its own read-modify-write plan (per-vertex atomicity, same as N
+  // separate requests); the batch saves the per-row parse/plan/RPC overhead, not the read
+  auto ret = nebula::cpp2::ErrorCode::SUCCEEDED;
+  for (const auto& vId : vIds) {
+    nebula::DataSet result;
+    auto plan = buildPlan(&result);
+    ret = plan.go(partId, vId.getStr());
+    if (ret == nebula::cpp2::ErrorCode::SUCCEEDED || ret == nebula::cpp2::ErrorCode::E_FILTER_OUT) {
+      profilePlan(plan);
+      if (resultDataSet_.colNames.empty()) {
+        resultDataSet_.colNames = std::move(result.colNames);
+      }
+      for (auto& row : result.rows) {
+        resultDataSet_.rows.emplace_back(std::move(row));
+      }
+    }
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      break;
+    }
+  }
 
   if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
     handleErrorCode(ret, spaceId_, partId);
@@ -83,7 +136,6 @@ void UpdateVertexProcessor::doProcess(const cpp2::UpdateVertexRequest& req) {
       onProcessFinished();
     }
   } else {
-    profilePlan(plan);
     onProcessFinished();
   }
   onFinished();
@@ -252,8 +304,8 @@ nebula::cpp2::ErrorCode UpdateVertexProcessor::buildTagContext(
   context_->tagId_ = tagId_;
   context_->tagName_ = iter->second;
   auto schemaMap = tagContext_.schemas_;
-  auto iterSchema = schemaMap.find(tagId_);
-  if (iterSchema != schemaMap.end()) {
+  auto iterSchema = schemaMap->find(tagId_);
+  if (iterSchema != schemaMap->end()) {
     auto schemas = iterSchema->second;
     auto schema = schemas.back().get();
     if (!schema) {
@@ -270,6 +322,101 @@ nebula::cpp2::ErrorCode UpdateVertexProcessor::buildTagContext(
     expCtx_ = std::make_unique<StorageExpressionContext>(
         spaceVidLen_, isIntId_, context_->tagName_, context_->tagSchema_, false);
   }
+
+  // Blind put applies when the upsert has no condition, returns nothing, assigns every
+  // prop of the latest schema, and no value expression reads the current row. The index
+  // check has to wait until doProcess fetched the tag indexes.
+  blindPutEligible_ = insertable_ && filterExp_ == nullptr && returnPropsExp_.empty();
+  if (blindPutEligible_) {
+    for (const auto& dep : depPropMap_) {
+      if (!dep.second.empty()) {
+        blindPutEligible_ = false;
+        break;
+      }
+    }
+  }
+  if (blindPutEligible_) {
+    const auto* schema = context_->tagSchema_;
+    std::unordered_set<std::string> assigned;
+    for (const auto& prop : updatedProps_) {
+      assigned.emplace(prop.get_name());
+    }
+    if (assigned.size() != schema->getNumFields()) {
+      blindPutEligible_ = false;
+    } else {
+      for (size_t i = 0; i < schema->getNumFields(); i++) {
+        if (assigned.count(schema->getFieldName(i)) == 0) {
+          blindPutEligible_ = false;
+          break;
+        }
+      }
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+nebula::cpp2::ErrorCode UpdateVertexProcessor::blindPut(PartitionID partId,
+                                                        const std::vector<Value>& vIds) {
+  const auto* schema = context_->tagSchema_;
+  auto pool = context_->objPool();
+  std::vector<kvstore::KV> data;
+  data.reserve(vIds.size());
+  for (const auto& vId : vIds) {
+    RowWriterV2 rowWriter(schema);
+    for (const auto& prop : updatedProps_) {
+      auto updateExp = Expression::decode(pool, prop.get_value());
+      if (!updateExp) {
+        VLOG(1) << "Can't decode the prop's value " << prop.get_value();
+        return nebula::cpp2::ErrorCode::E_INVALID_UPDATER;
+      }
+      // The expressions reference no current-row props, see blindPutEligible_
+      auto wRet = rowWriter.setValue(prop.get_name(), updateExp->eval(*expCtx_));
+      if (wRet != WriteResult::SUCCEEDED) {
+        VLOG(1) << "Add field failed, prop " << prop.get_name();
+        return nebula::cpp2::ErrorCode::E_INVALID_FIELD_VALUE;
+      }
+    }
+    if (rowWriter.finish() != WriteResult::SUCCEEDED) {
+      return nebula::cpp2::ErrorCode::E_INVALID_FIELD_VALUE;
+    }
+    data.emplace_back(NebulaKeyUtils::tagKey(spaceVidLen_, partId, vId.getStr(), tagId_),
+                      rowWriter.moveEncodedStr());
+  }
+
+  // Still serialize against concurrent read-modify-write updates of the same vertices,
+  // otherwise their write-back could be based on a row this put is about to replace.
+  // The locks are only held for the put itself, not for a read round-trip.
+  std::vector<VMLI> dummyLock;
+  dummyLock.reserve(vIds.size());
+  for (const auto& vId : vIds) {
+    dummyLock.emplace_back(std::make_tuple(spaceId_, partId, tagId_, vId.getStr()));
+  }
+  nebula::MemoryLockGuard<VMLI> lg(env_->verticesML_.get(), std::move(dummyLock), true);
+  if (!lg) {
+    auto conflict = lg.conflictKey();
+    LOG(ERROR) << "vertex conflict " << std::get<0>(conflict) << ":" << std::get<1>(conflict) << ":"
+               << std::get<2>(conflict) << ":" << std::get<3>(conflict);
+    return nebula::cpp2::ErrorCode::E_DATA_CONFLICT_ERROR;
+  }
+
+  auto ret = nebula::cpp2::ErrorCode::SUCCEEDED;
+  folly::Baton<true, std::atomic> baton;
+  env_->kvstore_->asyncMultiPut(
+      spaceId_, partId, std::move(data), [&ret, &baton](nebula::cpp2::ErrorCode code) {
+        ret = code;
+        baton.post();
+      });
+  baton.wait();
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+
+  // Same response shape as UpdateResNode; without the read we cannot tell insert from
+  // overwrite, and graphd discards this column when there is no yield clause anyway
+  resultDataSet_.colNames.emplace_back("_inserted");
+  for (size_t i = 0; i < vIds.size(); i++) {
+    resultDataSet_.rows.emplace_back(Row({Value(true)}));
+  }
   return nebula::cpp2::ErrorCode::SUCCEEDED;
 }
 
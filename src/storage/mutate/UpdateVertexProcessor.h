@@ -47,6 +47,11 @@ class UpdateVertexProcessor
   // filter expression, update props expression
   nebula::cpp2::ErrorCode buildTagContext(const cpp2::UpdateVertexRequest& req);
 
+  // Encode the rows from the update expressions alone and put them in one batch,
+  // skipping the read-modify-write plan. Only called when blindPutEligible_ is true
+  // and the tag has no index.
+  nebula::cpp2::ErrorCode blindPut(PartitionID partId, const std::vector<Value>& vIds);
+
   void onProcessFinished() override;
 
   std::vector<Expression*> getReturnPropsExp() {
@@ -80,6 +85,10 @@ class UpdateVertexProcessor
 
   // updatedProps_ dependent props in value expression
   std::vector<std::pair<std::string, std::unordered_set<std::string>>> depPropMap_;
+
+  // An unconditional upsert that assigns every schema prop from row-independent
+  // expressions does not need the old row at all, see blindPut()
+  bool blindPutEligible_{false};
 };
 
 }  // namespace storage
@@ -48,6 +48,7 @@ void GetDstBySrcProcessor::doProcess(const cpp2::GetDstBySrcRequest& req) {
   }
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
+  maxHops_ = req.get_max_hops();
 
   // check edgetypes exists
   retCode = checkAndBuildContexts(req);
@@ -161,7 +162,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetDstBySrcProces
     std::deque<Value>* result,
     PartitionID partId,
     const std::vector<Value>& srcIds) {
-  return folly::via(executor_,
+  return folly::via(partExecutor(partId),
                     [this, context, result, partId, input = std::move(srcIds)]() mutable {
                       memory::MemoryCheckGuard guard;
                       if (memoryExceeded_) {
@@ -248,8 +249,8 @@ nebula::cpp2::ErrorCode GetDstBySrcProcessor::buildEdgeContext(
   edgeContext_.offset_ = kDstOffsetInRespDataSet;
   const auto& edgeTypes = req.get_edge_types();
   for (const auto& edgeType : edgeTypes) {
-    auto iter = edgeContext_.schemas_.find(std::abs(edgeType));
-    if (iter == edgeContext_.schemas_.end()) {
+    auto iter = edgeContext_.schemas_->find(std::abs(edgeType));
+    if (iter == edgeContext_.schemas_->end()) {
       VLOG(1) << "Can't find spaceId " << spaceId_ << " edgeType " << edgeType;
       return nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
     }
@@ -274,6 +275,10 @@ void GetDstBySrcProcessor::onProcessFinished() {
   if (profileDetailFlag_) {
     dedupDuration_.reset();
   }
+  if (maxHops_ > 1) {
+    onTwoHopProcessFinished();
+    return;
+  }
   // dedup the dsts before we return
   static const auto kConcurrentThreshold = FLAGS_concurrent_dedup_threshold;
   static const auto kMaxThreads = FLAGS_max_dedup_threads;
@@ -353,5 +358,66 @@ void GetDstBySrcProcessor::onProcessFinished() {
   }
 }
 
+// Chains the remaining hop locally: the deduped first-hop dsts whose part lives on this host
+// are run through a second storage plan, dsts owned by other hosts are handed back in
+// unexpanded_dsts so the client can finish the hop where they live
+void GetDstBySrcProcessor::onTwoHopProcessFinished() {
+  VisitedFilter visited;
+  std::vector<Value> firstHop;
+  firstHop.reserve(flatResult_.size());
+  for (auto& val : flatResult_) {
+    if (visited.insert(val)) {
+      firstHop.emplace_back(std::move(val));
+    }
+  }
+  std::deque<Value>().swap(flatResult_);
+
+  DataSet unexpanded({"_dst"});
+  std::deque<Value> secondHop;
+  contexts_.emplace_back(RuntimeContext(planContext_.get()));
+  auto plan = buildPlan(&contexts_.back(), &secondHop);
+  auto partsNum = env_->metaClient_->partsNum(spaceId_);
+  for (const auto& dst : firstHop) {
+    std::string vId;
+    if (isIntId_) {
+      auto intVid = dst.getInt();
+      vId = std::string(reinterpret_cast<const char*>(&intVid), sizeof(intVid));
+    } else {
+      vId = dst.getStr();
+    }
+    bool expanded = false;
+    if (partsNum.ok()) {
+      auto partId = env_->metaClient_->partId(partsNum.value(), vId);
+      if (nebula::ok(env_->kvstore_->part(spaceId_, partId))) {
+        expanded = plan.go(partId, vId) == nebula::cpp2::ErrorCode::SUCCEEDED;
+      }
+    }
+    if (!expanded) {
+      unexpanded.rows.emplace_back(Row({dst}));
+    }
+  }
+
+  std::vector<Row> deduped;
+  deduped.reserve(firstHop.size() + secondHop.size());
+  for (auto& val : firstHop) {
+    deduped.emplace_back(Row({std::move(val)}));
+  }
+  for (auto& val : secondHop) {
+    if (visited.insert(val)) {
+      deduped.emplace_back(Row({std::move(val)}));
+    }
+  }
+  resultDataSet_.rows = std::move(deduped);
+  resp_.dsts_ref() = std::move(resultDataSet_);
+  if (!unexpanded.rows.empty()) {
+    resp_.unexpanded_dsts_ref() = std::move(unexpanded);
+  }
+
+  if (profileDetailFlag_) {
+    profileDetail("GetDstBySrcProcessorDedup", dedupDuration_.elapsedInUSec());
+    profileDetail("GetDstBySrcProcessorTotal", totalDuration_.elapsedInUSec());
+  }
+}
+
 }  // namespace storage
 }  // namespace nebula
@@ -6,6 +6,8 @@
 #ifndef STORAGE_QUERY_GETDSTBYSRCPROCESSOR_H_
 #define STORAGE_QUERY_GETDSTBYSRCPROCESSOR_H_
 
+#include <robin_hood.h>
+
 #include <deque>
 
 #include "common/base/Base.h"
@@ -44,6 +46,8 @@ class GetDstBySrcProcessor
 
   nebula::cpp2::ErrorCode buildEdgeContext(const cpp2::GetDstBySrcRequest& req);
 
+  void onTwoHopProcessFinished();
+
   void runInSingleThread(const cpp2::GetDstBySrcRequest& req);
 
   void runInMultipleThread(const cpp2::GetDstBySrcRequest& req);
@@ -56,7 +60,33 @@ class GetDstBySrcProcessor
 
   StoragePlan<VertexID> buildPlan(RuntimeContext* context, std::deque<Value>* result);
 
+  // Bitmap prefilter in front of the exact dedup set: a first-seen value usually costs one
+  // bit probe, only hash collisions fall through to the set
+  class VisitedFilter {
+   public:
+    VisitedFilter() : bits_(kNumBits / 64, 0) {}
+
+    // returns true iff `val' has not been seen before
+    bool insert(const Value& val) {
+      auto h = std::hash<Value>()(val);
+      auto& word = bits_[(h & (kNumBits - 1)) >> 6];
+      uint64_t mask = 1UL << (h & 63);
+      if ((word & mask) == 0) {
+        word |= mask;
+        set_.emplace(val);
+        return true;
+      }
+      return set_.emplace(val).second;
+    }
+
+   private:
+    static constexpr size_t kNumBits = 1UL << 20;
+    std::vector<uint64_t> bits_;
+    robin_hood::unordered_flat_set<Value, std::hash<Value>> set_;
+  };
+
  private:
+  int32_t maxHops_{1};
   std::vector<RuntimeContext> contexts_;
   // The process result of each part if run concurrently, then merge into resultDataSet_ at last
   std::vector<std::deque<Value>> partResults_;
@@ -5,7 +5,11 @@
 
 #include "storage/query/GetNeighborsProcessor.h"
 
+#include <chrono>
+
+#include "common/base/SampledCheck.h"
 #include "common/memory/MemoryTracker.h"
+#include "common/stats/TraceBuffer.h"
 #include "storage/StorageFlags.h"
 #include "storage/exec/AggregateNode.h"
 #include "storage/exec/EdgeNode.h"
@@ -30,6 +34,8 @@ void GetNeighborsProcessor::process(const cpp2::GetNeighborsRequest& req) {
 }
 
 void GetNeighborsProcessor::doProcess(const cpp2::GetNeighborsRequest& req) {
+  // one storage request is one sampling unit of the hot-path checks
+  verifyChecks_ = SampledCheck::sampleRequest();
   spaceId_ = req.get_space_id();
   auto retCode = getSpaceVidLen(spaceId_);
   if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -44,6 +50,7 @@ void GetNeighborsProcessor::doProcess(const cpp2::GetNeighborsRequest& req) {
   }
   this->planContext_ = std::make_unique<PlanContext>(
       this->env_, spaceId_, this->spaceVidLen_, this->isIntId_, req.common_ref());
+  this->planContext_->readSnapshot_ = FLAGS_query_snapshot_read;
 
   // build TagContext and EdgeContext
   retCode = checkAndBuildContexts(req);
@@ -78,13 +85,17 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
                                               int64_t limit,
                                               bool random) {
   memory::MemoryCheckGuard guard;
-  contexts_.emplace_back(RuntimeContext(planContext_.get()));
-  expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
-  auto plan = buildPlan(&contexts_.front(), &expCtxs_.front(), &resultDataSet_, limit, random);
+  SampledCheck::Scope verifyScope(verifyChecks_);
+  contexts_.emplace_back(requestPool_.makeAndAdd<RuntimeContext>(planContext_.get()));
+  expCtxs_.emplace_back(requestPool_.makeAndAdd<StorageExpressionContext>(spaceVidLen_, isIntId_));
+  expCtxs_.back()->setPropBindings(&propBindings_);
+  auto plan = buildPlan(contexts_.front(), expCtxs_.front(), &resultDataSet_, limit, random);
   std::unordered_set<PartitionID> failedParts;
   for (const auto& partEntry : req.get_parts()) {
-    contexts_.front().resultStat_ = ResultStatus::NORMAL;
+    contexts_.front()->resultStat_ = ResultStatus::NORMAL;
     auto partId = partEntry.first;
+    std::vector<VertexID> vertexIds;
+    vertexIds.reserve(partEntry.second.size());
     for (const auto& vid : partEntry.second) {
       auto vId = vid.getStr();
 
@@ -95,14 +106,20 @@ void GetNeighborsProcessor::runInSingleThread(const cpp2::GetNeighborsRequest& r
         onFinished();
         return;
       }
-
-      // the first column of each row would be the vertex id
-      auto ret = plan.go(partId, vId);
-      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
-        if (failedParts.find(partId) == failedParts.end()) {
-          failedParts.emplace(partId);
-          handleErrorCode(ret, spaceId_, partId);
-        }
+      vertexIds.emplace_back(std::move(vId));
+    }
+    // Visit the vertices of one part in key order, so the per-vertex prefix seeks walk
+    // the key space monotonically and reuse bloom filters and data blocks instead of
+    // jumping around in request order. Rows are keyed by vertex id, their order does
+    // not matter to the graph layer.
+    std::sort(vertexIds.begin(), vertexIds.end());
+
+    // the first column of each row would be the vertex id
+    auto ret = plan.go(partId, vertexIds);
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      if (failedParts.find(partId) == failedParts.end()) {
+        failedParts.emplace(partId);
+        handleErrorCode(ret, spaceId_, partId);
       }
     }
   }
@@ -117,18 +134,39 @@ void GetNeighborsProcessor::runInMultipleThread(const cpp2::GetNeighborsRequest&
                                                 int64_t limit,
                                                 bool random) {
   memory::MemoryCheckOffGuard offGuard;
-  for (size_t i = 0; i < req.get_parts().size(); i++) {
+  // Split the vertices of a large partition into multiple tasks, so a request which only hits a
+  // few parts could still spread over the whole executor pool. Each task runs its own plan clone
+  // over a slice of the partition and appends to its own DataSet, merged below.
+  auto taskSize = static_cast<size_t>(FLAGS_query_concurrently_task_size);
+  std::vector<std::pair<PartitionID, std::vector<nebula::Value>>> tasks;
+  for (const auto& [partId, vids] : req.get_parts()) {
+    // Sort the part's vertices first so every task gets a contiguous key range and its
+    // prefix seeks walk the key space monotonically, see runInSingleThread
+    auto sortedVids = vids;
+    std::sort(sortedVids.begin(), sortedVids.end());
+    if (taskSize == 0 || sortedVids.size() <= taskSize) {
+      tasks.emplace_back(partId, std::move(sortedVids));
+      continue;
+    }
+    for (size_t offset = 0; offset < sortedVids.size(); offset += taskSize) {
+      auto last = std::min(offset + taskSize, sortedVids.size());
+      tasks.emplace_back(partId,
+                         std::vector<nebula::Value>(sortedVids.begin() + offset,
+                                                    sortedVids.begin() + last));
+    }
+  }
+  for (size_t i = 0; i < tasks.size(); i++) {
     nebula::DataSet result = resultDataSet_;
-    results_.emplace_back(std::move(result));
-    contexts_.emplace_back(RuntimeContext(planContext_.get()));
-    expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
+    results_.emplace_back(requestPool_.makeAndAdd<nebula::DataSet>(std::move(result)));
+    contexts_.emplace_back(requestPool_.makeAndAdd<RuntimeContext>(planContext_.get()));
+    expCtxs_.emplace_back(
+        requestPool_.makeAndAdd<StorageExpressionContext>(spaceVidLen_, isIntId_));
+    expCtxs_.back()->setPropBindings(&propBindings_);
   }
-  size_t i = 0;
   std::vector<folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>>> futures;
-  for (const auto& [partId, vids] : req.get_parts()) {
-    futures.emplace_back(
-        runInExecutor(&contexts_[i], &expCtxs_[i], &results_[i], partId, vids, limit, random));
-    i++;
+  for (size_t i = 0; i < tasks.size(); i++) {
+    futures.emplace_back(runInExecutor(
+        contexts_[i], expCtxs_[i], results_[i], tasks[i].first, tasks[i].second, limit, random));
   }
 
   folly::collectAll(futures)
@@ -143,15 +181,20 @@ void GetNeighborsProcessor::runInMultipleThread(const cpp2::GetNeighborsRequest&
             onError();
             return;
           }
-          sum += results_[j].size();
+          sum += results_[j]->size();
         }
         resultDataSet_.rows.reserve(sum);
+        // a part may be split into several tasks, only report its first failure
+        std::unordered_set<PartitionID> failedParts;
         for (size_t j = 0; j < tries.size(); j++) {
           const auto& [code, partId] = tries[j].value();
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
-            handleErrorCode(code, spaceId_, partId);
+            if (failedParts.find(partId) == failedParts.end()) {
+              failedParts.emplace(partId);
+              handleErrorCode(code, spaceId_, partId);
+            }
           } else {
-            resultDataSet_.append(std::move(results_[j]));
+            resultDataSet_.append(std::move(*results_[j]));
           }
         }
         this->onProcessFinished();
@@ -172,13 +215,16 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
     int64_t limit,
     bool random) {
   return folly::via(
-             executor_,
+             partExecutor(partId),
              [this, context, expCtx, result, partId, input = std::move(vids), limit, random]() {
                memory::MemoryCheckGuard guard;
+               SampledCheck::Scope verifyScope(verifyChecks_);
                if (memoryExceeded_) {
                  return std::make_pair(nebula::cpp2::ErrorCode::E_STORAGE_MEMORY_EXCEEDED, partId);
                }
                auto plan = buildPlan(context, expCtx, result, limit, random);
+               std::vector<VertexID> vertexIds;
+               vertexIds.reserve(input.size());
                for (const auto& vid : input) {
                  auto vId = vid.getStr();
 
@@ -187,12 +233,31 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetNeighborsProce
                              << " space vid len: " << spaceVidLen_ << ",  vid is " << vId;
                    return std::make_pair(nebula::cpp2::ErrorCode::E_INVALID_VID, partId);
                  }
+                 vertexIds.emplace_back(std::move(vId));
+               }
 
-                 // the first column of each row would be the vertex id
-                 auto ret = plan.go(partId, vId);
-                 if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
-                   return std::make_pair(ret, partId);
-                 }
+               auto& traceBuffer = stats::TraceBuffer::instance();
+               int64_t traceStartNs = 0;
+               if (traceBuffer.enabled()) {
+                 traceStartNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch())
+                                    .count();
+               }
+               // the first column of each row would be the vertex id
+               auto ret = plan.go(partId, vertexIds);
+               if (traceBuffer.enabled()) {
+                 auto nowNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                  std::chrono::steady_clock::now().time_since_epoch())
+                                  .count();
+                 traceBuffer.record(planContext_->sessionId_,
+                                    planContext_->planId_,
+                                    "getNeighbors",
+                                    partId,
+                                    traceStartNs,
+                                    nowNs - traceStartNs);
+               }
+               if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+                 return std::make_pair(ret, partId);
                }
                if (UNLIKELY(this->profileDetailFlag_)) {
                  profilePlan(plan);
@@ -247,14 +312,20 @@ StoragePlan<VertexID> GetNeighborsProcessor::buildPlan(RuntimeContext* context,
     plan.addNode(std::move(tag));
   }
   std::vector<SingleEdgeNode*> edges;
+  // in sample mode only the reservoir-sampled edges are decoded afterwards by
+  // GetNeighborsSampleNode, so when neither filter nor stat needs per-edge props, the scan
+  // itself can skip building a RowReader for every edge of a super node
+  bool maySkipDecode = random && filter_ == nullptr && edgeContext_.statCount_ == 0;
   for (const auto& ec : edgeContext_.propContexts_) {
-    auto edge = std::make_unique<SingleEdgeNode>(context, &edgeContext_, ec.first, &ec.second);
+    auto edge = std::make_unique<SingleEdgeNode>(
+        context, &edgeContext_, ec.first, &ec.second, nullptr, nullptr, maySkipDecode);
     edges.emplace_back(edge.get());
     plan.addNode(std::move(edge));
   }
 
   IterateNode<VertexID>* upstream = nullptr;
   IterateNode<VertexID>* join = nullptr;
+  HashJoinNode* hashJoinPtr = nullptr;
   if (!edges.empty()) {
     auto hashJoin =
         std::make_unique<HashJoinNode>(context, tags, edges, &tagContext_, &edgeContext_, expCtx);
@@ -264,6 +335,7 @@ StoragePlan<VertexID> GetNeighborsProcessor::buildPlan(RuntimeContext* context,
     for (auto* edge : edges) {
       hashJoin->addDependency(edge);
     }
+    hashJoinPtr = hashJoin.get();
     join = hashJoin.get();
     upstream = hashJoin.get();
     plan.addNode(std::move(hashJoin));
@@ -303,6 +375,11 @@ StoragePlan<VertexID> GetNeighborsProcessor::buildPlan(RuntimeContext* context,
   } else {
     output =
         std::make_unique<GetNeighborsNode>(context, join, upstream, &edgeContext_, result, limit);
+    if (hashJoinPtr != nullptr && upstream == join) {
+      // neither filter nor aggregate sits between the output node and the join node, so the
+      // per-edge-row loop can run against the concrete HashJoinNode without virtual dispatch
+      output->markDirectIteration(hashJoinPtr);
+    }
   }
   output->addDependency(upstream);
   plan.addNode(std::move(output));
@@ -444,8 +521,8 @@ nebula::cpp2::ErrorCode GetNeighborsProcessor::handleEdgeStatProps(
         }
 
         auto edgeType = edgeRet.value();
-        auto iter = edgeContext_.schemas_.find(std::abs(edgeType));
-        if (iter == edgeContext_.schemas_.end()) {
+        auto iter = edgeContext_.schemas_->find(std::abs(edgeType));
+        if (iter == edgeContext_.schemas_->end()) {
           VLOG(1) << "Can't find spaceId " << spaceId_ << " edgeType " << std::abs(edgeType);
           return nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
         }
@@ -472,6 +549,7 @@ nebula::cpp2::ErrorCode GetNeighborsProcessor::handleEdgeStatProps(
                                   edgeName,
                                   propName,
                                   field,
+                                  field != nullptr ? edgeSchema.get() : nullptr,
                                   false,
                                   false,
                                   &statInfo);
@@ -20,6 +20,13 @@ extern ProcessorCounters kGetNeighborsCounters;
 /**
  * @brief Processor to get neighbors.
  *
+ * Each hop of a multi-hop traversal is a separate round trip through graphd: the dst set of
+ * one GetNeighbors response is deduplicated in graphd and sent back out as the next request.
+ * Chaining hops storage side (forwarding the next-hop frontier between storaged peers via
+ * InternalStorageClient and returning only the final frontier) needs a new request/response
+ * pair carrying the remaining hop plan, frontier aggregation and failure handling across
+ * peers, and graphd-side plan changes -- a protocol change tracked separately, not something
+ * this processor can do within the current GetNeighborsRequest.
  */
 class GetNeighborsProcessor
     : public QueryBaseProcessor<cpp2::GetNeighborsRequest, cpp2::GetNeighborsResponse> {
@@ -83,9 +90,12 @@ class GetNeighborsProcessor
       bool random);
 
  private:
-  std::vector<RuntimeContext> contexts_;
-  std::vector<StorageExpressionContext> expCtxs_;
-  std::vector<nebula::DataSet> results_;
+  // Owned by requestPool_, released wholesale with the processor
+  std::vector<RuntimeContext*> contexts_;
+  std::vector<StorageExpressionContext*> expCtxs_;
+  std::vector<nebula::DataSet*> results_;
+  // whether this request was drawn as a verify request of the sampled hot-path checks
+  bool verifyChecks_{false};
 };
 
 }  // namespace storage
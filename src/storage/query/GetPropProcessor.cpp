@@ -47,6 +47,11 @@ void GetPropProcessor::doProcess(const cpp2::GetPropRequest& req) {
     return;
   }
 
+  if (req.exists_only_ref().value_or(false) && !isEdge_) {
+    runExistsOnly(req);
+    return;
+  }
+
   // todo(doodle): specify by each query
   if (!FLAGS_query_concurrently) {
     runInSingleThread(req);
@@ -61,8 +66,14 @@ void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
   std::unordered_set<PartitionID> failedParts;
   if (!isEdge_) {
     auto plan = buildTagPlan(&contexts_.front(), &resultDataSet_);
+    // the output node is added last by buildTagPlan
+    auto* output = static_cast<GetTagPropNode*>(plan.getNodes().back().get());
+    std::vector<std::pair<PartitionID, std::vector<VertexID>>> partInputs;
+    partInputs.reserve(req.get_parts().size());
     for (const auto& partEntry : req.get_parts()) {
       auto partId = partEntry.first;
+      std::vector<VertexID> vIds;
+      vIds.reserve(partEntry.second.size());
       for (const auto& row : partEntry.second) {
         auto vId = row.values[0].getStr();
 
@@ -73,19 +84,37 @@ void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
           onFinished();
           return;
         }
+        vIds.emplace_back(std::move(vId));
+      }
+      partInputs.emplace_back(partId, std::move(vIds));
+    }
 
-        auto ret = plan.go(partId, vId);
-        if (ret != nebula::cpp2::ErrorCode::SUCCEEDED &&
-            failedParts.find(partId) == failedParts.end()) {
-          failedParts.emplace(partId);
-          handleErrorCode(ret, spaceId_, partId);
-        }
+    // issue the reads of all partitions up front so the I/O overlaps, then collect rows
+    // partition by partition
+    std::vector<GetTagPropNode::PrefetchedBatch> fetches;
+    fetches.reserve(partInputs.size());
+    for (const auto& [partId, vIds] : partInputs) {
+      fetches.emplace_back(output->prefetch(partId, vIds));
+    }
+    for (size_t i = 0; i < partInputs.size(); i++) {
+      const auto& [partId, vIds] = partInputs[i];
+      auto ret = output->execute(partId, vIds, std::move(fetches[i]));
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED &&
+          failedParts.find(partId) == failedParts.end()) {
+        failedParts.emplace(partId);
+        handleErrorCode(ret, spaceId_, partId);
       }
     }
   } else {
     auto plan = buildEdgePlan(&contexts_.front(), &resultDataSet_);
+    // the output node is added last by buildEdgePlan
+    auto* output = static_cast<GetEdgePropNode*>(plan.getNodes().back().get());
+    std::vector<std::pair<PartitionID, std::vector<cpp2::EdgeKey>>> partInputs;
+    partInputs.reserve(req.get_parts().size());
     for (const auto& partEntry : req.get_parts()) {
       auto partId = partEntry.first;
+      std::vector<cpp2::EdgeKey> edgeKeys;
+      edgeKeys.reserve(partEntry.second.size());
       for (const auto& row : partEntry.second) {
         cpp2::EdgeKey edgeKey;
         edgeKey.src_ref() = row.values[0].getStr();
@@ -102,20 +131,97 @@ void GetPropProcessor::runInSingleThread(const cpp2::GetPropRequest& req) {
           onFinished();
           return;
         }
+        edgeKeys.emplace_back(std::move(edgeKey));
+      }
+      partInputs.emplace_back(partId, std::move(edgeKeys));
+    }
 
-        auto ret = plan.go(partId, edgeKey);
-        if (ret != nebula::cpp2::ErrorCode::SUCCEEDED &&
-            failedParts.find(partId) == failedParts.end()) {
-          failedParts.emplace(partId);
-          handleErrorCode(ret, spaceId_, partId);
-        }
+    // issue the reads of all partitions up front so the I/O overlaps, then collect rows
+    // partition by partition
+    std::vector<folly::SemiFuture<kvstore::KVStore::AsyncMultiGetResult>> fetches;
+    fetches.reserve(partInputs.size());
+    for (const auto& [partId, edgeKeys] : partInputs) {
+      fetches.emplace_back(output->prefetch(partId, edgeKeys));
+    }
+    for (size_t i = 0; i < partInputs.size(); i++) {
+      const auto& [partId, edgeKeys] = partInputs[i];
+      auto ret = output->execute(partId, edgeKeys, std::move(fetches[i]).get());
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED &&
+          failedParts.find(partId) == failedParts.end()) {
+        failedParts.emplace(partId);
+        handleErrorCode(ret, spaceId_, partId);
+      }
+    }
+  }
+  onProcessFinished();
+  onFinished();
+}
+
+void GetPropProcessor::runExistsOnly(const cpp2::GetPropRequest& req) {
+  memory::MemoryCheckGuard guard;
+  resultDataSet_.colNames = {"_vid", "_exists"};
+  for (const auto& partEntry : req.get_parts()) {
+    auto partId = partEntry.first;
+    for (const auto& row : partEntry.second) {
+      const auto& vId = row.values[0].getStr();
+      if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vId)) {
+        LOG(INFO) << "Space " << spaceId_ << ", vertex length invalid, "
+                  << " space vid len: " << spaceVidLen_ << ",  vid is " << vId;
+        pushResultCode(nebula::cpp2::ErrorCode::E_INVALID_VID, partId);
+        onFinished();
+        return;
       }
+      bool exists = false;
+      auto ret = vertexExists(partId, vId, &exists);
+      if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        handleErrorCode(ret, spaceId_, partId);
+        break;
+      }
+      List record;
+      if (isIntId_) {
+        record.emplace_back(*reinterpret_cast<const int64_t*>(vId.data()));
+      } else {
+        record.emplace_back(vId);
+      }
+      record.emplace_back(exists);
+      resultDataSet_.rows.emplace_back(std::move(record));
     }
   }
   onProcessFinished();
   onFinished();
 }
 
+nebula::cpp2::ErrorCode GetPropProcessor::vertexExists(PartitionID partId,
+                                                       const VertexID& vId,
+                                                       bool* exists) {
+  auto* kvstore = env_->kvstore_;
+  if (FLAGS_use_vertex_key) {
+    auto vertexKey = NebulaKeyUtils::vertexKey(spaceVidLen_, partId, vId);
+    return kvstore->exists(spaceId_, partId, vertexKey, exists);
+  }
+  // Probe the requested tag keys one by one, most absent ones are ruled out by the bloom
+  // filter without a data block read
+  for (const auto& tc : tagContext_.propContexts_) {
+    auto tagKey = NebulaKeyUtils::tagKey(spaceVidLen_, partId, vId, tc.first);
+    auto ret = kvstore->exists(spaceId_, partId, tagKey, exists);
+    if (ret != nebula::cpp2::ErrorCode::SUCCEEDED || *exists) {
+      return ret;
+    }
+  }
+  if (!tagContext_.propContexts_.empty()) {
+    return nebula::cpp2::ErrorCode::SUCCEEDED;
+  }
+  // No tag was requested, fall back to a prefix seek over the vertex's tags
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto tagPrefix = NebulaKeyUtils::tagPrefix(spaceVidLen_, partId, vId);
+  auto ret = kvstore->prefix(spaceId_, partId, tagPrefix, &iter);
+  if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return ret;
+  }
+  *exists = iter->valid();
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
 void GetPropProcessor::runInMultipleThread(const cpp2::GetPropRequest& req) {
   memory::MemoryCheckOffGuard offGuard;
   for (size_t i = 0; i < req.get_parts().size(); i++) {
@@ -167,7 +273,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
     nebula::DataSet* result,
     PartitionID partId,
     const std::vector<nebula::Row>& rows) {
-  return folly::via(executor_,
+  return folly::via(partExecutor(partId),
                     [this, context, result, partId, input = std::move(rows)]() {
                       memory::MemoryCheckGuard guard;
                       if (memoryExceeded_) {
@@ -176,6 +282,8 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
                       }
                       if (!isEdge_) {
                         auto plan = buildTagPlan(context, result);
+                        std::vector<VertexID> vIds;
+                        vIds.reserve(input.size());
                         for (const auto& row : input) {
                           auto vId = row.values[0].getStr();
 
@@ -184,15 +292,15 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
                                       << " space vid len: " << spaceVidLen_ << ",  vid is " << vId;
                             return std::make_pair(nebula::cpp2::ErrorCode::E_INVALID_VID, partId);
                           }
-
-                          auto ret = plan.go(partId, vId);
-                          if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
-                            return std::make_pair(ret, partId);
-                          }
+                          vIds.emplace_back(std::move(vId));
                         }
-                        return std::make_pair(nebula::cpp2::ErrorCode::SUCCEEDED, partId);
+
+                        auto ret = plan.go(partId, vIds);
+                        return std::make_pair(ret, partId);
                       } else {
                         auto plan = buildEdgePlan(context, result);
+                        std::vector<cpp2::EdgeKey> edgeKeys;
+                        edgeKeys.reserve(input.size());
                         for (const auto& row : input) {
                           cpp2::EdgeKey edgeKey;
                           edgeKey.src_ref() = row.values[0].getStr();
@@ -209,13 +317,11 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> GetPropProcessor:
                                       << ", dstVid: " << *edgeKey.dst_ref();
                             return std::make_pair(nebula::cpp2::ErrorCode::E_INVALID_VID, partId);
                           }
-
-                          auto ret = plan.go(partId, edgeKey);
-                          if (ret != nebula::cpp2::ErrorCode::SUCCEEDED) {
-                            return std::make_pair(ret, partId);
-                          }
+                          edgeKeys.emplace_back(std::move(edgeKey));
                         }
-                        return std::make_pair(nebula::cpp2::ErrorCode::SUCCEEDED, partId);
+
+                        auto ret = plan.go(partId, edgeKeys);
+                        return std::make_pair(ret, partId);
                       }
                     })
       .thenError(folly::tag_t<std::bad_alloc>{}, [this](const std::bad_alloc&) {
@@ -247,7 +353,7 @@ StoragePlan<VertexID> GetPropProcessor::buildTagPlan(RuntimeContext* context,
 StoragePlan<cpp2::EdgeKey> GetPropProcessor::buildEdgePlan(RuntimeContext* context,
                                                            nebula::DataSet* result) {
   StoragePlan<cpp2::EdgeKey> plan;
-  std::vector<EdgeNode<cpp2::EdgeKey>*> edges;
+  std::vector<FetchEdgeNode*> edges;
   for (const auto& ec : edgeContext_.propContexts_) {
     auto edge = std::make_unique<FetchEdgeNode>(context, &edgeContext_, ec.first, &ec.second);
     edges.emplace_back(edge.get());
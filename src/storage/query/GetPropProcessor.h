@@ -75,6 +75,18 @@ class GetPropProcessor : public QueryBaseProcessor<cpp2::GetPropRequest, cpp2::G
   void runInSingleThread(const cpp2::GetPropRequest& req);
   void runInMultipleThread(const cpp2::GetPropRequest& req);
 
+  /**
+   * @brief Existence-only flavor: answer one (_vid, _exists) row per input vertex without
+   * reading or decoding any property, see the exists_only request field
+   */
+  void runExistsOnly(const cpp2::GetPropRequest& req);
+
+  /**
+   * @brief Whether the vertex carries any of the requested tags (or its vertex key when
+   * FLAGS_use_vertex_key is on), probed through the engine bloom filters
+   */
+  nebula::cpp2::ErrorCode vertexExists(PartitionID partId, const VertexID& vId, bool* exists);
+
   folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> runInExecutor(
       RuntimeContext* context,
       nebula::DataSet* result,
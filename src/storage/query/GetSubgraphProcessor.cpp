@@ -0,0 +1,159 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/query/GetSubgraphProcessor.h"
+
+#include "common/utils/NebulaKeyUtils.h"
+#include "storage/StorageFlags.h"
+
+namespace nebula {
+namespace storage {
+
+ProcessorCounters kGetSubgraphCounters;
+
+void GetSubgraphProcessor::process(const cpp2::GetSubgraphRequest& req) {
+  spaceId_ = req.get_space_id();
+  auto retCode = getSpaceVidLen(spaceId_);
+  if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    for (auto& p : req.get_parts()) {
+      pushResultCode(retCode, p.first);
+    }
+    onFinished();
+    return;
+  }
+  auto partsNum = env_->metaClient_->partsNum(spaceId_);
+  if (!partsNum.ok()) {
+    for (auto& p : req.get_parts()) {
+      pushResultCode(nebula::cpp2::ErrorCode::E_SPACE_NOT_FOUND, p.first);
+    }
+    onFinished();
+    return;
+  }
+  partsNum_ = partsNum.value();
+  for (auto edgeType : req.get_edge_types()) {
+    edgeTypes_.emplace(edgeType);
+  }
+  useVidDict_ = req.get_use_vid_dict();
+  if (useVidDict_) {
+    edges_.colNames = {"_src_id", "_type", "_ranking", "_dst_id"};
+  }
+
+  auto steps = req.get_steps();
+  std::vector<std::pair<PartitionID, std::string>> frontier;
+  for (const auto& partEntry : req.get_parts()) {
+    for (const auto& vid : partEntry.second) {
+      const auto& vId = vid.getStr();
+      if (!NebulaKeyUtils::isValidVidLen(spaceVidLen_, vId)) {
+        LOG(INFO) << "Space " << spaceId_ << ", vertex length invalid, "
+                  << " space vid len: " << spaceVidLen_ << ",  vid is " << vId;
+        pushResultCode(nebula::cpp2::ErrorCode::E_INVALID_VID, partEntry.first);
+        onFinished();
+        return;
+      }
+      if (visited_.emplace(vId).second) {
+        frontier.emplace_back(partEntry.first, vId);
+      }
+    }
+  }
+
+  for (int32_t step = 1; step <= steps && !frontier.empty(); ++step) {
+    nextFrontier_.clear();
+    for (const auto& [partId, vid] : frontier) {
+      auto code = expandOneStep(partId, vid, steps - step);
+      if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+        handleErrorCode(code, spaceId_, partId);
+        onFinished();
+        return;
+      }
+    }
+    frontier.swap(nextFrontier_);
+  }
+
+  resp_.edges_ref() = std::move(edges_);
+  if (!boundaryVids_.rows.empty()) {
+    resp_.boundary_vids_ref() = std::move(boundaryVids_);
+  }
+  if (useVidDict_) {
+    resp_.vid_dict_ref() = std::move(vidDict_);
+  }
+  onFinished();
+}
+
+nebula::cpp2::ErrorCode GetSubgraphProcessor::expandOneStep(PartitionID partId,
+                                                            const std::string& vid,
+                                                            int32_t remainingSteps) {
+  auto prefix = NebulaKeyUtils::edgePrefix(spaceVidLen_, partId, vid);
+  std::unique_ptr<kvstore::KVIterator> iter;
+  auto code = env_->kvstore_->prefix(spaceId_, partId, prefix, &iter);
+  if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+    return code;
+  }
+  auto srcValue = useVidDict_ ? Value(internVid(vid)) : toValue(vid);
+  int32_t count = 0;
+  for (; iter->valid(); iter->next()) {
+    auto key = iter->key();
+    if (!NebulaKeyUtils::isEdge(spaceVidLen_, key)) {
+      continue;
+    }
+    auto edgeType = NebulaKeyUtils::getEdgeType(spaceVidLen_, key);
+    if (!edgeTypes_.empty() && edgeTypes_.find(edgeType) == edgeTypes_.end()) {
+      continue;
+    }
+    if (++count > FLAGS_max_edge_returned_per_vertex) {
+      break;
+    }
+    auto dstId = NebulaKeyUtils::getDstId(spaceVidLen_, key);
+    Row edge;
+    edge.emplace_back(srcValue);
+    edge.emplace_back(edgeType);
+    edge.emplace_back(NebulaKeyUtils::getRank(spaceVidLen_, key));
+    edge.emplace_back(useVidDict_ ? Value(internVid(dstId)) : toValue(dstId));
+    edges_.rows.emplace_back(std::move(edge));
+
+    auto dst = dstId.str();
+    if (!visited_.emplace(dst).second || remainingSteps == 0) {
+      continue;
+    }
+    // the storage key holds the vid padded to the space vid length, while the client routes
+    // by the logical vid, so trim the padding before hashing it to a part
+    auto routeVid = isIntId_ ? dst : dst.substr(0, dst.find_first_of('\0'));
+    auto dstPart = env_->metaClient_->partId(partsNum_, routeVid);
+    if (isLocalPart(dstPart)) {
+      nextFrontier_.emplace_back(dstPart, std::move(dst));
+    } else {
+      Row boundary;
+      boundary.emplace_back(toValue(dstId));
+      boundary.emplace_back(remainingSteps);
+      boundaryVids_.rows.emplace_back(std::move(boundary));
+    }
+  }
+  return nebula::cpp2::ErrorCode::SUCCEEDED;
+}
+
+int32_t GetSubgraphProcessor::internVid(folly::StringPiece vid) {
+  auto found = vidIds_.find(vid.str());
+  if (found != vidIds_.end()) {
+    return found->second;
+  }
+  auto id = static_cast<int32_t>(vidDict_.size());
+  vidDict_.emplace_back(toValue(vid));
+  vidIds_.emplace(vid.str(), id);
+  return id;
+}
+
+Value GetSubgraphProcessor::toValue(folly::StringPiece vid) const {
+  if (isIntId_) {
+    return Value(*reinterpret_cast<const int64_t*>(vid.data()));
+  }
+  return Value(vid.subpiece(0, vid.find_first_of('\0')).toString());
+}
+
+bool GetSubgraphProcessor::isLocalPart(PartitionID partId) {
+  auto ret = env_->kvstore_->part(spaceId_, partId);
+  return nebula::ok(ret);
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,67 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_QUERY_GETSUBGRAPHPROCESSOR_H_
+#define STORAGE_QUERY_GETSUBGRAPHPROCESSOR_H_
+
+#include <robin_hood.h>
+
+#include "common/base/Base.h"
+#include "storage/BaseProcessor.h"
+
+namespace nebula {
+namespace storage {
+
+extern ProcessorCounters kGetSubgraphCounters;
+
+// Runs a bounded bfs over the edge keys of the local parts and returns the deduplicated
+// subgraph in one response, instead of the client driving one getNeighbors round trip per
+// step. Every vertex is expanded at most once; edges are returned as (_src, _type, _ranking,
+// _dst) rows without props. Vids reached whose part is not on this host are handed back in
+// boundary_vids together with their remaining steps, so the client can continue the
+// expansion on the host owning them.
+class GetSubgraphProcessor : public BaseProcessor<cpp2::GetSubgraphResponse> {
+ public:
+  static GetSubgraphProcessor* instance(StorageEnv* env,
+                                        const ProcessorCounters* counters = &kGetSubgraphCounters) {
+    return new GetSubgraphProcessor(env, counters);
+  }
+
+  void process(const cpp2::GetSubgraphRequest& req);
+
+ protected:
+  GetSubgraphProcessor(StorageEnv* env, const ProcessorCounters* counters)
+      : BaseProcessor<cpp2::GetSubgraphResponse>(env, counters) {}
+
+ private:
+  nebula::cpp2::ErrorCode expandOneStep(PartitionID partId,
+                                        const std::string& vid,
+                                        int32_t remainingSteps);
+
+  Value toValue(folly::StringPiece vid) const;
+
+  // dense id of `vid' in the response dictionary, interning it on first sight
+  int32_t internVid(folly::StringPiece vid);
+
+  bool isLocalPart(PartitionID partId);
+
+ private:
+  GraphSpaceID spaceId_;
+  int32_t partsNum_{0};
+  // visited vids in their fixed length storage form, also dedups the boundary vids
+  robin_hood::unordered_flat_set<std::string> visited_;
+  std::unordered_set<EdgeType> edgeTypes_;
+  std::vector<std::pair<PartitionID, std::string>> nextFrontier_;
+  DataSet edges_{{"_src", "_type", "_ranking", "_dst"}};
+  DataSet boundaryVids_{{"_vid", "_remaining_steps"}};
+  // vid dictionary of the response, only filled when the request sets use_vid_dict
+  bool useVidDict_{false};
+  std::vector<Value> vidDict_;
+  robin_hood::unordered_flat_map<std::string, int32_t> vidIds_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // STORAGE_QUERY_GETSUBGRAPHPROCESSOR_H_
@@ -21,8 +21,8 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::handleVertexProps(
     std::vector<cpp2::VertexProp>& vertexProps) {
   for (auto& vertexProp : vertexProps) {
     auto tagId = vertexProp.get_tag();
-    auto iter = tagContext_.schemas_.find(tagId);
-    if (iter == tagContext_.schemas_.end()) {
+    auto iter = tagContext_.schemas_->find(tagId);
+    if (iter == tagContext_.schemas_->end()) {
       VLOG(1) << "Can't find spaceId " << spaceId_ << " tagId " << tagId;
       return nebula::cpp2::ErrorCode::E_TAG_NOT_FOUND;
     }
@@ -43,7 +43,7 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::handleVertexProps(
             VLOG(1) << "Can't find prop " << name << " tagId " << tagId;
             return nebula::cpp2::ErrorCode::E_TAG_PROP_NOT_FOUND;
           }
-          addReturnPropContext(ctxs, name.c_str(), field);
+          addReturnPropContext(ctxs, name.c_str(), field, tagSchema.get());
         } else {
           addReturnPropContext(ctxs, name.c_str(), nullptr);
         }
@@ -56,7 +56,7 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::handleVertexProps(
         auto name = tagSchema->getFieldName(i);
         (*vertexProp.props_ref()).emplace_back(name);
         auto field = tagSchema->field(i);
-        addReturnPropContext(ctxs, name, field);
+        addReturnPropContext(ctxs, name, field, tagSchema.get());
       }
     }
     tagContext_.propContexts_.emplace_back(tagId, std::move(ctxs));
@@ -71,8 +71,8 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::handleEdgeProps(
     std::vector<cpp2::EdgeProp>& edgeProps) {
   for (auto& edgeProp : edgeProps) {
     auto edgeType = edgeProp.get_type();
-    auto iter = edgeContext_.schemas_.find(std::abs(edgeType));
-    if (iter == edgeContext_.schemas_.end()) {
+    auto iter = edgeContext_.schemas_->find(std::abs(edgeType));
+    if (iter == edgeContext_.schemas_->end()) {
       VLOG(1) << "Can't find spaceId " << spaceId_ << " edgeType " << edgeType;
       return nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
     }
@@ -93,7 +93,7 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::handleEdgeProps(
             VLOG(1) << "Can't find prop " << name << " edgeType " << edgeType;
             return nebula::cpp2::ErrorCode::E_EDGE_PROP_NOT_FOUND;
           }
-          addReturnPropContext(ctxs, name.c_str(), field);
+          addReturnPropContext(ctxs, name.c_str(), field, edgeSchema.get());
         } else {
           addReturnPropContext(ctxs, name.c_str(), nullptr);
         }
@@ -106,7 +106,7 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::handleEdgeProps(
         auto name = edgeSchema->getFieldName(i);
         (*edgeProp.props_ref()).emplace_back(name);
         auto field = edgeSchema->field(i);
-        addReturnPropContext(ctxs, name, field);
+        addReturnPropContext(ctxs, name, field, edgeSchema.get());
       }
     }
     edgeContext_.propContexts_.emplace_back(edgeType, std::move(ctxs));
@@ -120,10 +120,12 @@ template <typename REQ, typename RESP>
 void QueryBaseProcessor<REQ, RESP>::addReturnPropContext(
     std::vector<PropContext>& ctxs,
     const char* propName,
-    const meta::NebulaSchemaProvider::SchemaField* field) {
+    const meta::NebulaSchemaProvider::SchemaField* field,
+    const meta::NebulaSchemaProvider* fieldSchema) {
   PropContext ctx(propName);
   ctx.returned_ = true;
   ctx.field_ = field;
+  ctx.fieldSchema_ = fieldSchema;
   ctxs.emplace_back(std::move(ctx));
 }
 
@@ -170,8 +172,8 @@ template <typename REQ, typename RESP>
 void QueryBaseProcessor<REQ, RESP>::buildTagTTLInfo() {
   for (const auto& tc : tagContext_.propContexts_) {
     auto tagId = tc.first;
-    auto iter = tagContext_.schemas_.find(tagId);
-    CHECK(iter != tagContext_.schemas_.end());
+    auto iter = tagContext_.schemas_->find(tagId);
+    CHECK(iter != tagContext_.schemas_->end());
     const auto& tagSchema = iter->second.back();
 
     auto ttlInfo = tagSchema->getTTLInfo();
@@ -186,8 +188,8 @@ template <typename REQ, typename RESP>
 void QueryBaseProcessor<REQ, RESP>::buildEdgeTTLInfo() {
   for (const auto& ec : edgeContext_.propContexts_) {
     auto edgeType = ec.first;
-    auto iter = edgeContext_.schemas_.find(std::abs(edgeType));
-    CHECK(iter != edgeContext_.schemas_.end());
+    auto iter = edgeContext_.schemas_->find(std::abs(edgeType));
+    CHECK(iter != edgeContext_.schemas_->end());
     const auto& edgeSchema = iter->second.back();
 
     auto ttlInfo = edgeSchema->getTTLInfo();
@@ -201,7 +203,7 @@ void QueryBaseProcessor<REQ, RESP>::buildEdgeTTLInfo() {
 template <typename REQ, typename RESP>
 std::vector<cpp2::VertexProp> QueryBaseProcessor<REQ, RESP>::buildAllTagProps() {
   std::vector<cpp2::VertexProp> result;
-  for (const auto& entry : tagContext_.schemas_) {
+  for (const auto& entry : *tagContext_.schemas_) {
     cpp2::VertexProp tagProp;
     tagProp.tag_ref() = entry.first;
     const auto& schema = entry.second.back();
@@ -222,7 +224,7 @@ template <typename REQ, typename RESP>
 std::vector<cpp2::EdgeProp> QueryBaseProcessor<REQ, RESP>::buildAllEdgeProps(
     const cpp2::EdgeDirection& direction) {
   std::vector<cpp2::EdgeProp> result;
-  for (const auto& entry : edgeContext_.schemas_) {
+  for (const auto& entry : *edgeContext_.schemas_) {
     cpp2::EdgeProp edgeProp;
     edgeProp.type_ref() = entry.first;
     if (direction == cpp2::EdgeDirection::IN_EDGE) {
@@ -473,8 +475,8 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(
       }
 
       auto tagId = tagRet.value();
-      auto iter = tagContext_.schemas_.find(tagId);
-      if (iter == tagContext_.schemas_.end()) {
+      auto iter = tagContext_.schemas_->find(tagId);
+      if (iter == tagContext_.schemas_->end()) {
         VLOG(1) << "Can't find spaceId " << spaceId_ << " tagId " << tagId;
         return nebula::cpp2::ErrorCode::E_TAG_NOT_FOUND;
       }
@@ -490,6 +492,7 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(
                                     tagName,
                                     propName,
                                     nullptr,
+                                    nullptr,
                                     returned,
                                     filtered);
         }
@@ -510,8 +513,12 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(
                                 tagName,
                                 propName,
                                 field,
+                                tagSchema.get(),
                                 returned,
                                 filtered);
+      if (filtered && field != nullptr) {
+        propBindings_.push_back({&tagName, &propName, field, tagSchema.get()});
+      }
       if (updated) {
         valueProps_.emplace(propName);
       }
@@ -532,8 +539,8 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(
       }
 
       auto edgeType = edgeRet.value();
-      auto iter = edgeContext_.schemas_.find(std::abs(edgeType));
-      if (iter == edgeContext_.schemas_.end()) {
+      auto iter = edgeContext_.schemas_->find(std::abs(edgeType));
+      if (iter == edgeContext_.schemas_->end()) {
         VLOG(1) << "Can't find spaceId " << spaceId_ << " edgeType " << std::abs(edgeType);
         return nebula::cpp2::ErrorCode::E_EDGE_NOT_FOUND;
       }
@@ -549,6 +556,7 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(
                                     edgeName,
                                     propName,
                                     nullptr,
+                                    nullptr,
                                     returned,
                                     filtered);
         }
@@ -581,6 +589,7 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(
                                   edgeName,
                                   propName,
                                   field,
+                                  edgeSchema.get(),
                                   returned,
                                   filtered);
       }
@@ -593,6 +602,7 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(
                                   edgeName,
                                   propName,
                                   field,
+                                  edgeSchema.get(),
                                   returned,
                                   filtered);
       }
@@ -600,6 +610,9 @@ nebula::cpp2::ErrorCode QueryBaseProcessor<REQ, RESP>::checkExp(
         VLOG(1) << "Edge context not find related edge " << edgeName;
         return nebula::cpp2::ErrorCode::E_MUTATE_EDGE_CONFLICT;
       }
+      if (filtered && field != nullptr) {
+        propBindings_.push_back({&edgeName, &propName, field, edgeSchema.get()});
+      }
       if (updated) {
         valueProps_.emplace(propName);
       }
@@ -649,6 +662,7 @@ void QueryBaseProcessor<REQ, RESP>::addPropContextIfNotExists(
     const std::string& entryName,
     const std::string& propName,
     const meta::NebulaSchemaProvider::SchemaField* field,
+    const meta::NebulaSchemaProvider* fieldSchema,
     bool returned,
     bool filtered,
     const std::pair<size_t, cpp2::StatType>* statInfo) {
@@ -659,6 +673,7 @@ void QueryBaseProcessor<REQ, RESP>::addPropContextIfNotExists(
   if (idxIter == indexMap.end()) {
     // if no property of tag/edge has been add to propContexts
     PropContext ctx(propName.c_str(), field, returned, filtered, statInfo);
+    ctx.fieldSchema_ = fieldSchema;
     std::vector<PropContext> ctxs;
     ctxs.emplace_back(std::move(ctx));
     propContexts.emplace_back(entryId, std::move(ctxs));
@@ -673,11 +688,15 @@ void QueryBaseProcessor<REQ, RESP>::addPropContextIfNotExists(
     if (iter == props.end()) {
       // this prop has not been add to propContexts
       PropContext ctx(propName.c_str(), field, returned, filtered, statInfo);
+      ctx.fieldSchema_ = fieldSchema;
       props.emplace_back(std::move(ctx));
     } else {
       // this prop been add to propContexts, just update the flag
       iter->returned_ |= returned;
       iter->filtered_ |= filtered;
+      if (iter->fieldSchema_ == nullptr && iter->field_ == field) {
+        iter->fieldSchema_ = fieldSchema;
+      }
       if (statInfo != nullptr) {
         iter->addStat(statInfo);
       }
@@ -25,6 +25,7 @@
 #include "common/expression/UnaryExpression.h"
 #include "common/expression/VariableExpression.h"
 #include "storage/BaseProcessor.h"
+#include "storage/context/StorageExpressionContext.h"
 
 namespace nebula {
 namespace storage {
@@ -99,6 +100,9 @@ struct PropContext {
   std::string name_;
   // field info, e.g. nullable, default value
   const meta::NebulaSchemaProvider::SchemaField* field_;
+  // the schema which field_ was resolved from, when a row is encoded with this very schema
+  // the field can be decoded by its pre-computed offset without a per-row name lookup
+  const meta::NebulaSchemaProvider* fieldSchema_ = nullptr;
   bool returned_ = false;
   bool filtered_ = false;
   // prop type in edge key, for srcId/dstId/type/rank
@@ -117,9 +121,8 @@ struct TagContext {
   std::unordered_map<TagID, size_t> indexMap_;
   // tagId -> tagName
   std::unordered_map<TagID, std::string> tagNames_;
-  // tagId -> tag schema
-  std::unordered_map<TagID, std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>>
-      schemas_;
+  // tagId -> tag schema, an immutable snapshot shared with the schema cache
+  std::shared_ptr<const meta::TagSchemas> schemas_;
   // tagId -> tag ttl info
   std::unordered_map<TagID, std::pair<std::string, int64_t>> ttlInfo_;
 };
@@ -132,9 +135,9 @@ struct EdgeContext {
   // EdgeType -> edgeName
   std::unordered_map<EdgeType, std::string> edgeNames_;
 
-  // schemas_ and ttlInfo_ will contains only + edges
-  std::unordered_map<EdgeType, std::vector<std::shared_ptr<const meta::NebulaSchemaProvider>>>
-      schemas_;
+  // schemas_ and ttlInfo_ will contains only + edges, an immutable snapshot
+  // shared with the schema cache
+  std::shared_ptr<const meta::EdgeSchemas> schemas_;
   // EdgeType -> edge ttl info
   std::unordered_map<EdgeType, std::pair<std::string, int64_t>> ttlInfo_;
 
@@ -190,7 +193,8 @@ class QueryBaseProcessor : public BaseProcessor<RESP> {
 
   void addReturnPropContext(std::vector<PropContext>& ctxs,
                             const char* propName,
-                            const meta::NebulaSchemaProvider::SchemaField* field);
+                            const meta::NebulaSchemaProvider::SchemaField* field,
+                            const meta::NebulaSchemaProvider* fieldSchema = nullptr);
 
   void addPropContextIfNotExists(std::vector<std::pair<SchemaID, std::vector<PropContext>>>& props,
                                  std::unordered_map<SchemaID, size_t>& indexMap,
@@ -199,6 +203,7 @@ class QueryBaseProcessor : public BaseProcessor<RESP> {
                                  const std::string& entryName,
                                  const std::string& propName,
                                  const meta::NebulaSchemaProvider::SchemaField* field,
+                                 const meta::NebulaSchemaProvider* fieldSchema,
                                  bool returned,
                                  bool filtered,
                                  const std::pair<size_t, cpp2::StatType>* statInfo = nullptr);
@@ -206,6 +211,15 @@ class QueryBaseProcessor : public BaseProcessor<RESP> {
   template <typename IdType>
   void profilePlan(const StoragePlan<IdType>& plan);
 
+  // Executor the per-part task of `partId' should run on: the pinned group owning the part
+  // when the NUMA-aware reader pool is enabled, the shared reader pool otherwise
+  folly::Executor* partExecutor(PartitionID partId) const {
+    if (this->env_->numaReaderPool_ != nullptr) {
+      return this->env_->numaReaderPool_->forPart(partId);
+    }
+    return executor_;
+  }
+
  protected:
   GraphSpaceID spaceId_;
   folly::Executor* executor_{nullptr};
@@ -218,6 +232,10 @@ class QueryBaseProcessor : public BaseProcessor<RESP> {
   // Collect prop in value expression in upsert set clause
   std::unordered_set<std::string> valueProps_;
 
+  // Filter prop references resolved to field descriptors by checkExp, handed to the
+  // expression contexts so row-wise filter evaluation skips the name lookups
+  std::vector<StorageExpressionContext::PropBinding> propBindings_;
+
   nebula::DataSet resultDataSet_;
 };
 
@@ -90,6 +90,9 @@ void ScanEdgeProcessor::buildEdgeColName(const std::vector<cpp2::EdgeProp>& edge
 }
 
 void ScanEdgeProcessor::onProcessFinished() {
+  if (planContext_->scanBudgetExhausted()) {
+    result_.scan_budget_exhausted_ref() = true;
+  }
   resp_.props_ref() = std::move(resultDataSet_);
   resp_.cursors_ref() = std::move(cursors_);
 }
@@ -125,7 +128,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> ScanEdgeProcessor
     PartitionID partId,
     Cursor cursor,
     StorageExpressionContext* expCtx) {
-  return folly::via(executor_,
+  return folly::via(partExecutor(partId),
                     [this, context, result, cursors, partId, input = std::move(cursor), expCtx]() {
                       memory::MemoryCheckGuard guard;
                       if (memoryExceeded_) {
@@ -150,14 +153,18 @@ void ScanEdgeProcessor::runInSingleThread(const cpp2::ScanEdgeRequest& req) {
   memory::MemoryCheckGuard guard;
   contexts_.emplace_back(RuntimeContext(planContext_.get()));
   expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
+  expCtxs_.back().setPropBindings(&propBindings_);
   std::unordered_set<PartitionID> failedParts;
   auto plan = buildPlan(&contexts_.front(), &resultDataSet_, &cursors_, &expCtxs_.front());
   for (const auto& partEntry : req.get_parts()) {
     auto partId = partEntry.first;
     auto cursor = partEntry.second;
 
-    auto ret = plan.go(
-        partId, cursor.next_cursor_ref().has_value() ? cursor.next_cursor_ref().value() : "");
+    auto ret = CommonUtils::checkScanCursor(env_, spaceId_, partId, cursor);
+    if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      ret = plan.go(
+          partId, cursor.next_cursor_ref().has_value() ? cursor.next_cursor_ref().value() : "");
+    }
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED &&
         failedParts.find(partId) == failedParts.end()) {
       failedParts.emplace(partId);
@@ -176,17 +183,24 @@ void ScanEdgeProcessor::runInMultipleThread(const cpp2::ScanEdgeRequest& req) {
     results_.emplace_back(std::move(result));
     contexts_.emplace_back(RuntimeContext(planContext_.get()));
     expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
+    expCtxs_.back().setPropBindings(&propBindings_);
   }
   size_t i = 0;
   std::vector<folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>>> futures;
   for (const auto& [partId, cursor] : req.get_parts()) {
-    futures.emplace_back(
-        runInExecutor(&contexts_[i],
-                      &results_[i],
-                      &cursorsOfPart_[i],
-                      partId,
-                      cursor.next_cursor_ref().has_value() ? cursor.next_cursor_ref().value() : "",
-                      &expCtxs_[i]));
+    auto code = CommonUtils::checkScanCursor(env_, spaceId_, partId, cursor);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      // Keep the futures aligned with results_/cursorsOfPart_ by index
+      futures.emplace_back(folly::makeFuture(std::make_pair(code, partId)));
+    } else {
+      futures.emplace_back(runInExecutor(
+          &contexts_[i],
+          &results_[i],
+          &cursorsOfPart_[i],
+          partId,
+          cursor.next_cursor_ref().has_value() ? cursor.next_cursor_ref().value() : "",
+          &expCtxs_[i]));
+    }
     i++;
   }
 
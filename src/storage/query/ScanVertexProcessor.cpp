@@ -31,6 +31,7 @@ void ScanVertexProcessor::doProcess(const cpp2::ScanVertexRequest& req) {
   // negative limit number means no limit
   limit_ = req.get_limit() < 0 ? std::numeric_limits<int64_t>::max() : req.get_limit();
   enableReadFollower_ = req.get_enable_read_from_follower();
+  returnPropBlocks_ = req.get_return_prop_blocks();
 
   auto retCode = getSpaceVidLen(spaceId_);
   if (retCode != nebula::cpp2::ErrorCode::SUCCEEDED) {
@@ -94,7 +95,14 @@ void ScanVertexProcessor::buildTagColName(const std::vector<cpp2::VertexProp>& t
 }
 
 void ScanVertexProcessor::onProcessFinished() {
-  resp_.props_ref() = std::move(resultDataSet_);
+  if (planContext_->scanBudgetExhausted()) {
+    result_.scan_budget_exhausted_ref() = true;
+  }
+  if (returnPropBlocks_) {
+    resp_.prop_blocks_ref() = std::move(propBlocks_);
+  } else {
+    resp_.props_ref() = std::move(resultDataSet_);
+  }
   resp_.cursors_ref() = std::move(cursors_);
 }
 
@@ -130,7 +138,7 @@ folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>> ScanVertexProcess
     Cursor cursor,
     StorageExpressionContext* expCtx) {
   return folly::via(
-             executor_,
+             partExecutor(partId),
              [this, context, result, cursorsOfPart, partId, input = std::move(cursor), expCtx]() {
                memory::MemoryCheckGuard guard;
                if (memoryExceeded_) {
@@ -154,20 +162,27 @@ void ScanVertexProcessor::runInSingleThread(const cpp2::ScanVertexRequest& req)
   memory::MemoryCheckGuard guard;
   contexts_.emplace_back(RuntimeContext(planContext_.get()));
   expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
+  expCtxs_.back().setPropBindings(&propBindings_);
   std::unordered_set<PartitionID> failedParts;
   auto plan = buildPlan(&contexts_.front(), &resultDataSet_, &cursors_, &expCtxs_.front());
   for (const auto& partEntry : req.get_parts()) {
     auto partId = partEntry.first;
     auto cursor = partEntry.second;
 
-    auto ret = plan.go(
-        partId, cursor.next_cursor_ref().has_value() ? cursor.next_cursor_ref().value() : "");
+    auto ret = CommonUtils::checkScanCursor(env_, spaceId_, partId, cursor);
+    if (ret == nebula::cpp2::ErrorCode::SUCCEEDED) {
+      ret = plan.go(
+          partId, cursor.next_cursor_ref().has_value() ? cursor.next_cursor_ref().value() : "");
+    }
     if (ret != nebula::cpp2::ErrorCode::SUCCEEDED &&
         failedParts.find(partId) == failedParts.end()) {
       failedParts.emplace(partId);
       handleErrorCode(ret, spaceId_, partId);
     }
   }
+  if (returnPropBlocks_) {
+    propBlocks_.emplace_back(std::move(resultDataSet_));
+  }
   onProcessFinished();
   onFinished();
 }
@@ -180,17 +195,24 @@ void ScanVertexProcessor::runInMultipleThread(const cpp2::ScanVertexRequest& req
     results_.emplace_back(std::move(result));
     contexts_.emplace_back(RuntimeContext(planContext_.get()));
     expCtxs_.emplace_back(StorageExpressionContext(spaceVidLen_, isIntId_));
+    expCtxs_.back().setPropBindings(&propBindings_);
   }
   size_t i = 0;
   std::vector<folly::Future<std::pair<nebula::cpp2::ErrorCode, PartitionID>>> futures;
   for (const auto& [partId, cursor] : req.get_parts()) {
-    futures.emplace_back(
-        runInExecutor(&contexts_[i],
-                      &results_[i],
-                      &cursorsOfPart_[i],
-                      partId,
-                      cursor.next_cursor_ref().has_value() ? cursor.next_cursor_ref().value() : "",
-                      &expCtxs_[i]));
+    auto code = CommonUtils::checkScanCursor(env_, spaceId_, partId, cursor);
+    if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
+      // Keep the futures aligned with results_/cursorsOfPart_ by index
+      futures.emplace_back(folly::makeFuture(std::make_pair(code, partId)));
+    } else {
+      futures.emplace_back(runInExecutor(
+          &contexts_[i],
+          &results_[i],
+          &cursorsOfPart_[i],
+          partId,
+          cursor.next_cursor_ref().has_value() ? cursor.next_cursor_ref().value() : "",
+          &expCtxs_[i]));
+    }
     i++;
   }
 
@@ -208,13 +230,21 @@ void ScanVertexProcessor::runInMultipleThread(const cpp2::ScanVertexRequest& req
           }
           sum += results_[j].size();
         }
-        resultDataSet_.rows.reserve(sum);
+        if (!returnPropBlocks_) {
+          resultDataSet_.rows.reserve(sum);
+        }
         for (size_t j = 0; j < tries.size(); j++) {
           const auto& [code, partId] = tries[j].value();
           if (code != nebula::cpp2::ErrorCode::SUCCEEDED) {
             handleErrorCode(code, spaceId_, partId);
           } else {
-            resultDataSet_.append(std::move(results_[j]));
+            if (returnPropBlocks_) {
+              // hand the shard of this partition back as its own response block, the serial
+              // row-by-row merge is skipped entirely
+              propBlocks_.emplace_back(std::move(results_[j]));
+            } else {
+              resultDataSet_.append(std::move(results_[j]));
+            }
             cursors_.merge(std::move(cursorsOfPart_[j]));
           }
         }
@@ -84,8 +84,11 @@ class ScanVertexProcessor : public QueryBaseProcessor<cpp2::ScanVertexRequest, c
   std::vector<std::unordered_map<PartitionID, cpp2::ScanCursor>> cursorsOfPart_;
 
   std::unordered_map<PartitionID, cpp2::ScanCursor> cursors_;
+  // shards handed back as separate response blocks when the request asks for them
+  std::vector<nebula::DataSet> propBlocks_;
   int64_t limit_{-1};
   bool enableReadFollower_{false};
+  bool returnPropBlocks_{false};
 };
 
 }  // namespace storage
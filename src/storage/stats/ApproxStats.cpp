@@ -0,0 +1,74 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "storage/stats/ApproxStats.h"
+
+DEFINE_bool(enable_approx_stats,
+            false,
+            "Maintain per-part NDV sketches and degree histograms inline in the mutate "
+            "processors and report them with the stats job");
+DEFINE_int32(approx_stats_degree_sample_inverse,
+             128,
+             "Track the out-degree of one in N source vertices for the degree histogram, "
+             "chosen by hash so the sample is stable across writes");
+
+namespace nebula {
+namespace storage {
+
+std::shared_ptr<ApproxStats::PartStats> ApproxStats::partStats(GraphSpaceID spaceId,
+                                                               PartitionID partId) {
+  auto key = partKey(spaceId, partId);
+  auto it = parts_.find(key);
+  if (it != parts_.end()) {
+    return it->second;
+  }
+  auto inserted = parts_.insert(key, std::make_shared<PartStats>());
+  return inserted.first->second;
+}
+
+void ApproxStats::addVertex(GraphSpaceID spaceId, PartitionID partId, folly::StringPiece vId) {
+  auto stats = partStats(spaceId, partId);
+  std::lock_guard<std::mutex> guard(stats->lock);
+  stats->vids.add(vId);
+}
+
+void ApproxStats::addOutEdge(GraphSpaceID spaceId, PartitionID partId, folly::StringPiece srcId) {
+  auto stats = partStats(spaceId, partId);
+  std::lock_guard<std::mutex> guard(stats->lock);
+  stats->vids.add(srcId);
+  auto inverse = FLAGS_approx_stats_degree_sample_inverse;
+  if (inverse <= 0) {
+    return;
+  }
+  if (folly::hash::fnv64_buf(srcId.data(), srcId.size()) % inverse != 0) {
+    return;
+  }
+  stats->sampledOutDegree[srcId.str()]++;
+}
+
+void ApproxStats::resetPart(GraphSpaceID spaceId, PartitionID partId) {
+  auto stats = partStats(spaceId, partId);
+  std::lock_guard<std::mutex> guard(stats->lock);
+  stats->vids.clear();
+  stats->sampledOutDegree.clear();
+}
+
+ApproxStats::Snapshot ApproxStats::snapshot(GraphSpaceID spaceId, PartitionID partId) {
+  auto stats = partStats(spaceId, partId);
+  Snapshot snap;
+  std::lock_guard<std::mutex> guard(stats->lock);
+  snap.vidSketch = stats->vids.serialize();
+  auto inverse = std::max(FLAGS_approx_stats_degree_sample_inverse, 1);
+  for (auto& [src, degree] : stats->sampledOutDegree) {
+    // bucket i holds sources with out-degree in [2^i, 2^(i+1)), each sampled source
+    // stands in for `inverse` of them
+    int32_t bucket = 63 - __builtin_clzll(static_cast<uint64_t>(degree));
+    snap.degreeHistogram[bucket] += inverse;
+  }
+  return snap;
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,90 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef STORAGE_STATS_APPROXSTATS_H
+#define STORAGE_STATS_APPROXSTATS_H
+
+#include <folly/concurrency/ConcurrentHashMap.h>
+
+#include <mutex>
+#include <unordered_map>
+
+#include "common/algorithm/HyperLogLog.h"
+#include "common/thrift/ThriftTypes.h"
+
+DECLARE_bool(enable_approx_stats);
+DECLARE_int32(approx_stats_degree_sample_inverse);
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Continuously maintained per-part statistic sketches for the optimizer.
+ *
+ * A full-scan stats job on a big space takes hours and its result is stale the moment it
+ * lands. Instead, the stats job seeds these sketches once during its scan and the mutate
+ * processors keep them current inline: a HyperLogLog over vertex ids estimates the NDV,
+ * and a hash-sampled set of source vertices tracks out-degrees for a log-scale degree
+ * histogram. Out-edges of one vertex live in a single part, so both sketches merge
+ * cleanly across parts (register max for the sketch, bucket sum for the histogram).
+ *
+ * Updates are lost on restart until the next stats job re-seeds them; the estimates are
+ * advisory and never consulted for correctness.
+ */
+class ApproxStats final {
+ public:
+  struct Snapshot {
+    // serialized HyperLogLog of the part's vertex ids
+    std::string vidSketch;
+    // log2 bucket of out-degree -> estimated number of source vertices in that bucket
+    std::unordered_map<int32_t, int64_t> degreeHistogram;
+  };
+
+  static ApproxStats& instance() {
+    static ApproxStats stats;
+    return stats;
+  }
+
+  /**
+   * @brief Count one written vertex, cheap enough to run per vertex when enabled.
+   */
+  void addVertex(GraphSpaceID spaceId, PartitionID partId, folly::StringPiece vId);
+
+  /**
+   * @brief Count one written out-edge of the given source vertex. Only a hash-sampled
+   * 1/approx_stats_degree_sample_inverse of the sources are tracked for the histogram.
+   */
+  void addOutEdge(GraphSpaceID spaceId, PartitionID partId, folly::StringPiece srcId);
+
+  /**
+   * @brief Drop the sketches of one part, called by the stats job before re-seeding.
+   */
+  void resetPart(GraphSpaceID spaceId, PartitionID partId);
+
+  Snapshot snapshot(GraphSpaceID spaceId, PartitionID partId);
+
+ private:
+  ApproxStats() = default;
+
+  struct PartStats {
+    std::mutex lock;
+    algorithm::HyperLogLog vids;
+    // sampled source vertex id -> observed out-degree
+    std::unordered_map<std::string, int64_t> sampledOutDegree;
+  };
+
+  std::shared_ptr<PartStats> partStats(GraphSpaceID spaceId, PartitionID partId);
+
+  static int64_t partKey(GraphSpaceID spaceId, PartitionID partId) {
+    return (static_cast<int64_t>(spaceId) << 32) | static_cast<uint32_t>(partId);
+  }
+
+  folly::ConcurrentHashMap<int64_t, std::shared_ptr<PartStats>> parts_;
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+#endif  // STORAGE_STATS_APPROXSTATS_H
@@ -3,9 +3,15 @@
  * This source code is licensed under Apache 2.0 License.
  */
 
+#include "storage/stats/StorageStats.h"
+
 #include "clients/meta/stats/MetaClientStats.h"
 #include "kvstore/stats/KVStats.h"
 
+DEFINE_bool(enable_index_level_metrics,
+            false,
+            "Whether to export the index usage counters per index, labeled with the index id");
+
 namespace nebula {
 
 stats::CounterId kNumEdgesInserted;
@@ -13,6 +19,10 @@ stats::CounterId kNumVerticesInserted;
 stats::CounterId kNumEdgesDeleted;
 stats::CounterId kNumTagsDeleted;
 stats::CounterId kNumVerticesDeleted;
+stats::CounterId kNumVertexAbsenceCacheHits;
+stats::CounterId kNumIndexScans;
+stats::CounterId kNumIndexRowsMatched;
+stats::CounterId kNumIndexKeysMaintained;
 
 void initStorageStats() {
   kNumEdgesInserted = stats::StatsManager::registerStats("num_edges_inserted", "rate, sum");
@@ -20,6 +30,12 @@ void initStorageStats() {
   kNumEdgesDeleted = stats::StatsManager::registerStats("num_edges_deleted", "rate, sum");
   kNumTagsDeleted = stats::StatsManager::registerStats("num_tags_deleted", "rate, sum");
   kNumVerticesDeleted = stats::StatsManager::registerStats("num_vertices_deleted", "rate, sum");
+  kNumVertexAbsenceCacheHits =
+      stats::StatsManager::registerStats("num_vertex_absence_cache_hits", "rate, sum");
+  kNumIndexScans = stats::StatsManager::registerStats("num_index_scans", "rate, sum");
+  kNumIndexRowsMatched = stats::StatsManager::registerStats("num_index_rows_matched", "rate, sum");
+  kNumIndexKeysMaintained =
+      stats::StatsManager::registerStats("num_index_keys_maintained", "rate, sum");
 
 #ifndef BUILD_STANDALONE
   initMetaClientStats();
@@ -27,4 +43,12 @@ void initStorageStats() {
 #endif
 }
 
+void addIndexStatsValue(const stats::CounterId& id, IndexID indexId, int64_t value) {
+  stats::StatsManager::addValue(id, value);
+  if (FLAGS_enable_index_level_metrics) {
+    stats::StatsManager::addValue(
+        stats::StatsManager::counterWithLabels(id, {{"index", std::to_string(indexId)}}), value);
+  }
+}
+
 }  // namespace nebula
@@ -7,6 +7,9 @@
 #define STORAGE_STATS_STORAGESTATS_H
 
 #include "common/stats/StatsManager.h"
+#include "common/thrift/ThriftTypes.h"
+
+DECLARE_bool(enable_index_level_metrics);
 
 namespace nebula {
 
@@ -16,6 +19,23 @@ extern stats::CounterId kNumEdgesDeleted;
 extern stats::CounterId kNumTagsDeleted;
 extern stats::CounterId kNumVerticesDeleted;
 
+// Index usage counters. They show which indexes earn their write amplification:
+// an index with many maintained keys but no scans is a candidate to drop.
+// Hits of the negative lookup cache of GetProp, each one is a saved rocksdb read of an
+// absent key, see FLAGS_vertex_absence_cache_capacity
+extern stats::CounterId kNumVertexAbsenceCacheHits;
+
+extern stats::CounterId kNumIndexScans;
+extern stats::CounterId kNumIndexRowsMatched;
+extern stats::CounterId kNumIndexKeysMaintained;
+
+/**
+ * @brief Bump an index usage counter, plus its per-index labeled child when
+ * `enable_index_level_metrics` is on
+ *
+ */
+void addIndexStatsValue(const stats::CounterId& id, IndexID indexId, int64_t value = 1);
+
 /**
  * @brief Init storage statistic points for storage/meta client/kv
  *
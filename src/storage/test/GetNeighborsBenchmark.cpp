@@ -70,7 +70,7 @@ void initContext(std::unique_ptr<nebula::storage::PlanContext>& planCtx,
 
   auto edgeName = env->schemaMan_->toEdgeName(spaceId, std::abs(serve));
   edgeContext.edgeNames_.emplace(serve, std::move(edgeName).value());
-  auto iter = edgeContext.schemas_.find(std::abs(serve));
+  auto iter = edgeContext.schemas_->find(std::abs(serve));
   const auto& edgeSchema = iter->second.back();
 
   std::vector<nebula::storage::PropContext> ctxs;
@@ -233,14 +233,14 @@ void prefix(int32_t iters,
     auto totalParts = gCluster->getTotalParts();
 
     auto tagSchemas = env->schemaMan_->getAllVerTagSchema(spaceId).value();
-    auto tagSchemaIter = tagSchemas.find(player);
-    CHECK(tagSchemaIter != tagSchemas.end());
+    auto tagSchemaIter = tagSchemas->find(player);
+    CHECK(tagSchemaIter != tagSchemas->end());
     CHECK(!tagSchemaIter->second.empty());
     auto* tagSchema = &(tagSchemaIter->second);
 
     auto edgeSchemas = env->schemaMan_->getAllVerEdgeSchema(spaceId).value();
-    auto edgeSchemaIter = edgeSchemas.find(std::abs(serve));
-    CHECK(edgeSchemaIter != edgeSchemas.end());
+    auto edgeSchemaIter = edgeSchemas->find(std::abs(serve));
+    CHECK(edgeSchemaIter != edgeSchemas->end());
     CHECK(!edgeSchemaIter->second.empty());
     auto* edgeSchema = &(edgeSchemaIter->second);
 
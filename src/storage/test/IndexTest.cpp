@@ -3419,6 +3419,78 @@ TEST_F(IndexScanTest, Compound) {
   // TODO(hs.zhang): add unittest
 }
 
+TEST_F(IndexScanTest, FusedRanges) {
+  // Simulates "a IN (1,3) AND b>=20": the IN list is expanded into two hint sets which are
+  // fused into one scan node and executed in key order with successive seeks.
+  auto rows = R"(
+    int | int
+    1   | 10
+    1   | 20
+    2   | 30
+    3   | 10
+    3   | 40
+  )"_row;
+  auto schema = R"(
+    a   | int  ||false
+    b   | int  ||false
+  )"_schema;
+  auto indices = R"(
+    TAG(t,1)
+    (i1,2):a,b
+  )"_index(schema);
+  bool hasNullableCol = schema->hasNullableCol();
+  auto kv = encodeTag(rows, 1, schema, indices);
+  auto kvstore = std::make_unique<MockKVStore>();
+  for (auto& iter : kv) {
+    for (auto& item : iter) {
+      kvstore->put(item.first, item.second);
+    }
+  }
+  std::vector<ColumnHint> columnHints{
+      makeColumnHint("a", Value(3)),              // a=3
+      makeBeginColumnHint<true>("b", Value(20))   // b>=20
+  };
+  std::vector<ColumnHint> extraHints{
+      makeColumnHint("a", Value(1)),              // a=1
+      makeBeginColumnHint<true>("b", Value(20))   // b>=20
+  };
+  IndexID indexId = 2;
+  auto context = makeContext(1, 0);
+  auto scanNode = std::make_unique<IndexVertexScanNode>(
+      context.get(), indexId, columnHints, kvstore.get(), hasNullableCol);
+  scanNode->addHintSet(extraHints);
+  IndexScanTestHelper helper;
+  helper.setIndex(scanNode.get(), indices[0]);
+  helper.setTag(scanNode.get(), schema);
+  InitContext initCtx;
+  initCtx.requiredColumns = {kVid, "a", "b"};
+  scanNode->init(initCtx);
+  scanNode->execute(0);
+  std::vector<Row> result;
+  while (true) {
+    auto res = scanNode->next();
+    ASSERT(res.success());
+    if (!res.hasData()) {
+      break;
+    }
+    result.emplace_back(std::move(res).row());
+  }
+  // Ranges are executed sorted by seek key, so a=1 comes back before a=3
+  auto expect = R"(
+    string | int | int
+    1      | 1   | 20
+    4      | 3   | 40
+  )"_row;
+  std::vector<std::string> colOrder = {kVid, "a", "b"};
+  ASSERT_EQ(result.size(), expect.size());
+  for (size_t i = 0; i < result.size(); i++) {
+    ASSERT_EQ(result[i].size(), expect[i].size());
+    for (size_t j = 0; j < expect[i].size(); j++) {
+      ASSERT_EQ(expect[i][j], result[i][initCtx.retColMap[colOrder[j]]]);
+    }
+  }
+}
+
 class IndexTest : public ::testing::Test {
  protected:
   static PlanContext* getPlanContext() {
@@ -193,8 +193,8 @@ TEST_P(ScanEdgePropBench, ProcessEdgeProps) {
     auto edges = env->schemaMan_->getAllVerEdgeSchema(spaceId);
     ASSERT_TRUE(edges.ok());
     auto edgeSchemas = std::move(edges).value();
-    auto edgeIter = edgeSchemas.find(std::abs(edgeType));
-    ASSERT_TRUE(edgeIter != edgeSchemas.end());
+    auto edgeIter = edgeSchemas->find(std::abs(edgeType));
+    ASSERT_TRUE(edgeIter != edgeSchemas->end());
     const auto& schemas = edgeIter->second;
 
     folly::stop_watch<std::chrono::microseconds> watch;
@@ -228,8 +228,8 @@ TEST_P(ScanEdgePropBench, ProcessEdgeProps) {
     auto edges = env->schemaMan_->getAllVerEdgeSchema(spaceId);
     ASSERT_TRUE(edges.ok());
     auto edgeSchemas = std::move(edges).value();
-    auto edgeIter = edgeSchemas.find(std::abs(edgeType));
-    ASSERT_TRUE(edgeIter != edgeSchemas.end());
+    auto edgeIter = edgeSchemas->find(std::abs(edgeType));
+    ASSERT_TRUE(edgeIter != edgeSchemas->end());
     const auto& schemas = edgeIter->second;
 
     auto resetReader = [&schemas, &reader](folly::StringPiece row) -> bool {
@@ -221,6 +221,80 @@ TEST(ScanVertexTest, CursorTest) {
   }
 }
 
+TEST(ScanVertexTest, SelfDescribingCursorTest) {
+  fs::TempDir rootPath("/tmp/ScanVertexTest.XXXXXX");
+  mock::MockCluster cluster;
+  cluster.initStorageKV(rootPath.path());
+  auto* env = cluster.storageEnv_.get();
+  auto totalParts = cluster.getTotalParts();
+  ASSERT_EQ(true, QueryTestUtils::mockVertexData(env, totalParts));
+
+  TagID player = 1;
+  auto tag =
+      std::make_pair(player, std::vector<std::string>{kVid, kTag, "name", "age", "avgScore"});
+
+  cpp2::ScanCursor batchCursor;
+  {
+    LOG(INFO) << "A partial scan returns a cursor describing where it came from";
+    auto req = buildRequest({1}, {""}, {tag}, 1);
+    auto* processor = ScanVertexProcessor::instance(env, nullptr);
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+    const auto& c = resp.get_cursors().at(1);
+    ASSERT_TRUE(c.next_cursor_ref().has_value());
+    ASSERT_TRUE(c.part_id_ref().has_value());
+    EXPECT_EQ(1, *c.part_id_ref());
+    ASSERT_TRUE(c.snapshot_seq_ref().has_value());
+    batchCursor = c;
+  }
+  {
+    LOG(INFO) << "Resuming the cursor on its own part succeeds";
+    auto req = buildRequest({1}, {""}, {tag}, 1);
+    std::unordered_map<PartitionID, cpp2::ScanCursor> parts;
+    parts.emplace(1, batchCursor);
+    req.parts_ref() = std::move(parts);
+    auto* processor = ScanVertexProcessor::instance(env, nullptr);
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+
+    ASSERT_EQ(0, resp.result.failed_parts.size());
+  }
+  {
+    LOG(INFO) << "A cursor of another part is rejected";
+    auto req = buildRequest({1}, {""}, {tag}, 1);
+    auto wrongPart = batchCursor;
+    wrongPart.part_id_ref() = 2;
+    std::unordered_map<PartitionID, cpp2::ScanCursor> parts;
+    parts.emplace(1, wrongPart);
+    req.parts_ref() = std::move(parts);
+    auto* processor = ScanVertexProcessor::instance(env, nullptr);
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+
+    ASSERT_EQ(1, resp.result.failed_parts.size());
+  }
+  {
+    LOG(INFO) << "A cursor ahead of what this replica has committed is rejected";
+    auto req = buildRequest({1}, {""}, {tag}, 1);
+    auto ahead = batchCursor;
+    ahead.snapshot_seq_ref() = std::numeric_limits<int64_t>::max();
+    std::unordered_map<PartitionID, cpp2::ScanCursor> parts;
+    parts.emplace(1, ahead);
+    req.parts_ref() = std::move(parts);
+    auto* processor = ScanVertexProcessor::instance(env, nullptr);
+    auto f = processor->getFuture();
+    processor->process(req);
+    auto resp = std::move(f).get();
+
+    ASSERT_EQ(1, resp.result.failed_parts.size());
+  }
+}
+
 TEST(ScanVertexTest, MultiplePartsTest) {
   fs::TempDir rootPath("/tmp/ScanVertexTest.XXXXXX");
   mock::MockCluster cluster;
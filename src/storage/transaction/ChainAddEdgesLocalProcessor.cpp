@@ -11,6 +11,7 @@
 #include "kvstore/Part.h"
 #include "storage/StorageFlags.h"
 #include "storage/mutate/AddEdgesProcessor.h"
+#include "storage/transaction/ChainAddEdgesRemoteProcessor.h"
 #include "storage/transaction/ConsistUtil.h"
 #include "storage/transaction/TransactionManager.h"
 
@@ -63,7 +64,11 @@ folly::SemiFuture<Code> ChainAddEdgesLocalProcessor::processRemote(Code code) {
   auto reversedRequest = reverseRequest(req_);
   CHECK_EQ(reversedRequest.get_parts().size(), 1);
   auto [pro, fut] = folly::makePromiseContract<Code>();
-  doRpc(std::move(pro), std::move(reversedRequest));
+  if (FLAGS_toss_same_host_fast_path && env_->txnMan_->isLocalLeader(spaceId_, remotePartId_)) {
+    commitLocalRemote(std::move(pro), std::move(reversedRequest));
+  } else {
+    doRpc(std::move(pro), std::move(reversedRequest));
+  }
   return std::move(fut);
 }
 
@@ -173,6 +178,43 @@ void ChainAddEdgesLocalProcessor::doRpc(folly::Promise<Code>&& promise,
   });
 }
 
+void ChainAddEdgesLocalProcessor::commitLocalRemote(folly::Promise<Code>&& promise,
+                                                    cpp2::AddEdgesRequest&& req) {
+  // the in-edge part leader lives on this storaged as well, so the remote half can run
+  // through the remote processor in process, with the same term check and commit path
+  // but without the internal rpc round trip
+  execDesc_ += ", local remote, ";
+  cpp2::ChainAddEdgesRequest chainReq;
+  chainReq.space_id_ref() = req.get_space_id();
+  chainReq.parts_ref() = req.get_parts();
+  chainReq.prop_names_ref() = req.get_prop_names();
+  chainReq.if_not_exists_ref() = req.get_if_not_exists();
+  chainReq.term_ref() = term_;
+  if (edgeVer_) {
+    chainReq.edge_version_ref() = edgeVer_.value();
+  }
+
+  auto* proc = ChainAddEdgesRemoteProcessor::instance(env_);
+  proc->getFuture().thenTry(
+      [this, p = std::move(promise), req = std::move(req)](auto&& t) mutable {
+        if (t.hasException()) {
+          LOG(INFO) << "catch ex: " << t.exception().what();
+          rcRemote_ = Code::E_RPC_FAILURE;
+          p.setValue(rcRemote_);
+          return;
+        }
+        rcRemote_ = extractRpcError(t.value());
+        if (rcRemote_ == Code::E_LEADER_CHANGED) {
+          // the in-edge leader moved between the check and the commit,
+          // fall back to the normal rpc path which follows the new leader
+          doRpc(std::move(p), std::move(req));
+          return;
+        }
+        p.setValue(rcRemote_);
+      });
+  proc->process(chainReq);
+}
+
 void ChainAddEdgesLocalProcessor::callbackOfChainOp(kvstore::BatchHolder& batch,
                                                     std::vector<kvstore::KV>* pData) {
   if (pData != nullptr) {
@@ -52,6 +52,12 @@ class ChainAddEdgesLocalProcessor : public BaseProcessor<cpp2::ExecResponse>,
 
   void doRpc(folly::Promise<Code>&& pro, cpp2::AddEdgesRequest&& req, int retry = 0) noexcept;
 
+  /**
+   * @brief commit the remote half in process when its part leader is this storaged,
+   *        falls back to doRpc() if the leader moved away in between
+   */
+  void commitLocalRemote(folly::Promise<Code>&& pro, cpp2::AddEdgesRequest&& req);
+
   bool lockEdges(const cpp2::AddEdgesRequest& req);
 
   /**
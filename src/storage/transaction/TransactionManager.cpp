@@ -19,6 +19,7 @@ namespace storage {
 
 DEFINE_int32(resume_interval_secs, 10, "Resume interval");
 DEFINE_int32(toss_worker_num, 16, "Resume interval");
+DEFINE_uint32(max_resume_concurrency, 64, "Upper bound of in-flight resumed chain tasks");
 
 TransactionManager::TransactionManager(StorageEnv* env) : env_(env) {
   LOG(INFO) << "TransactionManager ctor()";
@@ -125,6 +126,14 @@ std::pair<TermID, Code> TransactionManager::getTermFromKVStore(GraphSpaceID spac
   return std::make_pair(termId, rc);
 }
 
+bool TransactionManager::isLocalLeader(GraphSpaceID spaceId, PartitionID partId) {
+  auto part = env_->kvstore_->part(spaceId, partId);
+  if (!nebula::ok(part)) {
+    return false;
+  }
+  return nebula::value(part)->isLeader();
+}
+
 bool TransactionManager::checkTermFromCache(GraphSpaceID spaceId,
                                             PartitionID partId,
                                             TermID termId) {
@@ -157,13 +166,41 @@ void TransactionManager::addPrime(GraphSpaceID spaceId,
                                   ResumeType type) {
   VLOG(2) << "addPrime() space=" << spaceId << ", hex=" << folly::hexlify(egKey)
           << ", ResumeType=" << static_cast<int>(type);
-  auto* proc = ChainProcessorFactory::make(env_, spaceId, termId, egKey, type);
+  {
+    std::lock_guard<std::mutex> guard(resumeLock_);
+    resumeQueue_.emplace_back(ResumeItem{spaceId, partId, termId, egKey, type});
+  }
+  drainResumeQueue();
+}
+
+void TransactionManager::drainResumeQueue() {
+  std::vector<ResumeItem> batch;
+  {
+    std::lock_guard<std::mutex> guard(resumeLock_);
+    while (inflightResume_ < resumeWindow_ && !resumeQueue_.empty()) {
+      batch.emplace_back(std::move(resumeQueue_.front()));
+      resumeQueue_.pop_front();
+      inflightResume_++;
+    }
+  }
+  for (auto& item : batch) {
+    runResume(std::move(item));
+  }
+}
+
+void TransactionManager::runResume(ResumeItem&& item) {
+  auto spaceId = item.spaceId;
+  auto partId = item.partId;
+  auto termId = item.termId;
+  auto egKey = std::move(item.edgeKey);
+  auto* proc = ChainProcessorFactory::make(env_, spaceId, termId, egKey, item.type);
   if (proc == nullptr) {
     VLOG(1) << "delPrime() space=" << spaceId << ", hex=" << folly::hexlify(egKey);
     auto lk = getLockCore(spaceId, partId, termId, false);
     if (lk) {
       lk->unlock(egKey);
     }
+    onResumeFinished(Code::SUCCEEDED);
     return;
   }
   auto fut = proc->getFinished();
@@ -175,10 +212,27 @@ void TransactionManager::addPrime(GraphSpaceID spaceId,
         lk->unlock(egKey);
       }
     }
+    onResumeFinished(code);
   });
   addChainTask(proc);
 }
 
+void TransactionManager::onResumeFinished(Code code) {
+  {
+    std::lock_guard<std::mutex> guard(resumeLock_);
+    inflightResume_--;
+    if (code == Code::SUCCEEDED) {
+      if (resumeWindow_ < FLAGS_max_resume_concurrency) {
+        resumeWindow_++;
+      }
+    } else {
+      // back off: a failing peer will not get healthier by being hammered
+      resumeWindow_ = std::max<size_t>(resumeWindow_ / 2, 1);
+    }
+  }
+  drainResumeQueue();
+}
+
 void TransactionManager::onNewPartAdded(std::shared_ptr<kvstore::Part>& part) {
   DLOG(INFO) << folly::sformat("space={}, part={} added", part->spaceId(), part->partitionId());
   auto fnLeaderReady =
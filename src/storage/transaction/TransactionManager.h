@@ -9,6 +9,9 @@
 #include <folly/executors/Async.h>
 #include <storage/transaction/ChainBaseProcessor.h>
 
+#include <deque>
+#include <mutex>
+
 #include "clients/meta/MetaClient.h"
 #include "clients/storage/InternalStorageClient.h"
 #include "common/meta/SchemaManager.h"
@@ -80,7 +83,13 @@ class TransactionManager {
   // to avoid an old leader request overrider a newer leader's
   bool checkTermFromCache(GraphSpaceID spaceId, PartitionID partId, TermID termId);
 
-  // leave a record for (double)prime edge, to let resume processor there is one dangling edge
+  // whether this storaged is currently the leader of the given part,
+  // used to commit the remote half of a chain in process when both leaders are co-located
+  bool isLocalLeader(GraphSpaceID spaceId, PartitionID partId);
+
+  // leave a record for (double)prime edge, to let resume processor there is one dangling edge.
+  // the record is queued and drained with a bounded adaptive window rather than resumed
+  // immediately, so a large backlog after restart cannot flood the cluster
   void addPrime(GraphSpaceID spaceId,
                 PartitionID partId,
                 TermID termId,
@@ -131,6 +140,24 @@ class TransactionManager {
 
   void waitUntil(std::function<bool()>&& cond, folly::Promise<folly::Unit>&& p);
 
+  struct ResumeItem {
+    GraphSpaceID spaceId;
+    PartitionID partId;
+    TermID termId;
+    std::string edgeKey;
+    ResumeType type;
+  };
+
+  // launch queued resume items until the adaptive window is full
+  void drainResumeQueue();
+
+  // build and run the chain processor of one resume item
+  void runResume(ResumeItem&& item);
+
+  // a finished resume adjusts the window: successes widen it up to
+  // max_resume_concurrency, failures halve it, then the queue is drained again
+  void onResumeFinished(Code code);
+
  protected:
   using SpacePart = std::pair<GraphSpaceID, PartitionID>;
 
@@ -155,6 +182,11 @@ class TransactionManager {
   folly::ConcurrentHashMap<SpacePart, TermID> currTerm_;
 
   folly::ConcurrentHashMap<SpacePart, TermID> prevTerms_;
+
+  std::mutex resumeLock_;
+  std::deque<ResumeItem> resumeQueue_;
+  size_t inflightResume_{0};
+  size_t resumeWindow_{1};
 };
 
 }  // namespace storage
@@ -123,7 +123,7 @@ Status UpgraderSpace::buildSchemaAndIndex() {
     LOG(ERROR) << "Space id " << spaceId_ << " no found";
     return tags.status();
   }
-  tagSchemas_ = std::move(tags).value();
+  tagSchemas_ = *tags.value();
 
   for (auto& tag : tagSchemas_) {
     auto tagId = tag.first;
@@ -163,7 +163,7 @@ Status UpgraderSpace::buildSchemaAndIndex() {
     LOG(ERROR) << "Space id " << spaceId_ << " no found";
     return edges.status();
   }
-  edgeSchemas_ = std::move(edges).value();
+  edgeSchemas_ = *edges.value();
 
   for (auto& edge : edgeSchemas_) {
     auto edgetype = edge.first;
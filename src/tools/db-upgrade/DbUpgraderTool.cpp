@@ -60,6 +60,13 @@ required:
        --max_concurrent_spaces<N>
          Maximum number of concurrent spaces allowed.
          Default: 5
+
+       --rocksdb_enable_cf_separation=<true|false>
+         Write the upgraded data into dedicated column families per key type
+         (vertex/edge/index). Opening an already upgraded space once with this
+         flag (here or in storaged) also moves its existing data into the
+         dedicated column families. Once enabled, the flag must stay on.
+         Default: false
 )");
 }
 
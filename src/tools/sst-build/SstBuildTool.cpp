@@ -0,0 +1,265 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <fstream>
+
+#include "clients/meta/MetaClient.h"
+#include "common/base/Base.h"
+#include "common/meta/ServerBasedSchemaManager.h"
+#include "common/network/NetworkUtils.h"
+#include "tools/sst-build/SstGenerator.h"
+
+DEFINE_string(space_name, "", "The space name.");
+DEFINE_string(meta_server, "127.0.0.1:45500", "Meta servers' address.");
+DEFINE_string(tag, "", "Build vertex data for this tag name.");
+DEFINE_string(edge, "", "Build edge data for this edge name.");
+DEFINE_string(props, "", "A list of prop names separated by comma, in input column order.");
+DEFINE_string(input, "", "Path of the input csv file.");
+DEFINE_string(output, "./sst", "Output directory, one sub directory per part is created.");
+DEFINE_bool(with_rank, false, "The edge input carries a rank column after src and dst.");
+
+namespace nebula {
+namespace storage {
+
+class SstBuildTool final {
+ public:
+  Status run() {
+    NG_RETURN_IF_ERROR(init());
+    std::ifstream in(FLAGS_input);
+    if (!in.good()) {
+      return Status::Error("Failed to open input file `%s'", FLAGS_input.c_str());
+    }
+    SstGenerator generator(spaceId_, partNum_, spaceVidLen_, FLAGS_output);
+    std::string line;
+    size_t lineNo = 0, rows = 0;
+    while (std::getline(in, line)) {
+      lineNo++;
+      if (line.empty()) {
+        continue;
+      }
+      std::vector<std::string> columns;
+      folly::split(',', line, columns);
+      auto status = isEdge_ ? addEdge(generator, columns) : addVertex(generator, columns);
+      if (!status.ok()) {
+        return Status::Error("Line %zu: %s", lineNo, status.toString().c_str());
+      }
+      rows++;
+    }
+    NG_RETURN_IF_ERROR(generator.finish());
+    LOG(INFO) << "Wrote " << rows << " rows into " << generator.numFiles() << " SST files under "
+              << FLAGS_output;
+    return Status::OK();
+  }
+
+ private:
+  Status init() {
+    auto addrs = network::NetworkUtils::toHosts(FLAGS_meta_server);
+    NG_RETURN_IF_ERROR(addrs);
+    auto ioExecutor = std::make_shared<folly::IOThreadPoolExecutor>(1);
+    meta::MetaClientOptions options;
+    options.skipConfig_ = true;
+    metaClient_ =
+        std::make_unique<meta::MetaClient>(ioExecutor, std::move(addrs).value(), options);
+    if (!metaClient_->waitForMetadReady(1)) {
+      return Status::Error("Meta is not ready: `%s'.", FLAGS_meta_server.c_str());
+    }
+    schemaMng_ = std::make_unique<meta::ServerBasedSchemaManager>();
+    schemaMng_->init(metaClient_.get());
+
+    if (FLAGS_space_name.empty()) {
+      return Status::Error("--space_name is not given.");
+    }
+    auto space = schemaMng_->toGraphSpaceID(FLAGS_space_name);
+    NG_RETURN_IF_ERROR(space);
+    spaceId_ = space.value();
+    auto spaceVidLen = metaClient_->getSpaceVidLen(spaceId_);
+    NG_RETURN_IF_ERROR(spaceVidLen);
+    spaceVidLen_ = spaceVidLen.value();
+    auto vidType = metaClient_->getSpaceVidType(spaceId_);
+    NG_RETURN_IF_ERROR(vidType);
+    isIntVid_ = vidType.value() == nebula::cpp2::PropertyType::INT64;
+    auto partNum = metaClient_->partsNum(spaceId_);
+    NG_RETURN_IF_ERROR(partNum);
+    partNum_ = partNum.value();
+
+    if (FLAGS_tag.empty() == FLAGS_edge.empty()) {
+      return Status::Error("Exactly one of --tag and --edge must be given.");
+    }
+    isEdge_ = !FLAGS_edge.empty();
+    if (isEdge_) {
+      auto edgeType = schemaMng_->toEdgeType(spaceId_, FLAGS_edge);
+      NG_RETURN_IF_ERROR(edgeType);
+      edgeType_ = edgeType.value();
+      schema_ = schemaMng_->getEdgeSchema(spaceId_, edgeType_);
+    } else {
+      auto tagId = schemaMng_->toTagID(spaceId_, FLAGS_tag);
+      NG_RETURN_IF_ERROR(tagId);
+      tagId_ = tagId.value();
+      schema_ = schemaMng_->getTagSchema(spaceId_, tagId_);
+    }
+    if (schema_ == nullptr) {
+      return Status::Error("No schema found for `%s'.",
+                           (isEdge_ ? FLAGS_edge : FLAGS_tag).c_str());
+    }
+    folly::split(',', FLAGS_props, propNames_, true);
+    for (auto& name : propNames_) {
+      if (schema_->field(name) == nullptr) {
+        return Status::Error("Prop `%s' not found in the schema.", name.c_str());
+      }
+    }
+    return Status::OK();
+  }
+
+  // The number of columns in front of the props: vid, or src and dst plus an optional rank
+  size_t keyColumns() const {
+    return isEdge_ ? (FLAGS_with_rank ? 3 : 2) : 1;
+  }
+
+  StatusOr<VertexID> toVid(const std::string& column) const {
+    if (!isIntVid_) {
+      return column;
+    }
+    auto vid = folly::tryTo<int64_t>(column);
+    if (!vid.hasValue()) {
+      return Status::Error("`%s' is not a valid int vid", column.c_str());
+    }
+    int64_t v = vid.value();
+    return std::string(reinterpret_cast<const char*>(&v), sizeof(int64_t));
+  }
+
+  Status parseProps(const std::vector<std::string>& columns, std::vector<Value>& props) const {
+    if (columns.size() != keyColumns() + propNames_.size()) {
+      return Status::Error("Expected %zu columns, got %zu",
+                           keyColumns() + propNames_.size(),
+                           columns.size());
+    }
+    props.reserve(propNames_.size());
+    for (size_t i = 0; i < propNames_.size(); i++) {
+      const auto& column = columns[keyColumns() + i];
+      switch (schema_->field(propNames_[i])->type()) {
+        case nebula::cpp2::PropertyType::BOOL:
+          props.emplace_back(column == "true" || column == "1");
+          break;
+        case nebula::cpp2::PropertyType::INT8:
+        case nebula::cpp2::PropertyType::INT16:
+        case nebula::cpp2::PropertyType::INT32:
+        case nebula::cpp2::PropertyType::INT64:
+        case nebula::cpp2::PropertyType::TIMESTAMP: {
+          auto v = folly::tryTo<int64_t>(column);
+          if (!v.hasValue()) {
+            return Status::Error("`%s' is not a valid integer", column.c_str());
+          }
+          props.emplace_back(v.value());
+          break;
+        }
+        case nebula::cpp2::PropertyType::FLOAT:
+        case nebula::cpp2::PropertyType::DOUBLE: {
+          auto v = folly::tryTo<double>(column);
+          if (!v.hasValue()) {
+            return Status::Error("`%s' is not a valid double", column.c_str());
+          }
+          props.emplace_back(v.value());
+          break;
+        }
+        case nebula::cpp2::PropertyType::STRING:
+        case nebula::cpp2::PropertyType::FIXED_STRING:
+          props.emplace_back(column);
+          break;
+        default:
+          return Status::Error("Unsupported prop type of `%s', insert through graphd instead",
+                               propNames_[i].c_str());
+      }
+    }
+    return Status::OK();
+  }
+
+  Status addVertex(SstGenerator& generator, const std::vector<std::string>& columns) const {
+    std::vector<Value> props;
+    NG_RETURN_IF_ERROR(parseProps(columns, props));
+    auto vid = toVid(columns[0]);
+    NG_RETURN_IF_ERROR(vid);
+    return generator.addVertex(vid.value(), tagId_, schema_.get(), propNames_, props);
+  }
+
+  Status addEdge(SstGenerator& generator, const std::vector<std::string>& columns) const {
+    std::vector<Value> props;
+    NG_RETURN_IF_ERROR(parseProps(columns, props));
+    auto src = toVid(columns[0]);
+    NG_RETURN_IF_ERROR(src);
+    auto dst = toVid(columns[1]);
+    NG_RETURN_IF_ERROR(dst);
+    EdgeRanking rank = 0;
+    if (FLAGS_with_rank) {
+      auto r = folly::tryTo<EdgeRanking>(columns[2]);
+      if (!r.hasValue()) {
+        return Status::Error("`%s' is not a valid rank", columns[2].c_str());
+      }
+      rank = r.value();
+    }
+    return generator.addEdge(
+        src.value(), dst.value(), edgeType_, rank, schema_.get(), propNames_, props);
+  }
+
+  std::unique_ptr<meta::MetaClient> metaClient_;
+  std::unique_ptr<meta::ServerBasedSchemaManager> schemaMng_;
+  std::shared_ptr<const meta::NebulaSchemaProvider> schema_;
+  std::vector<std::string> propNames_;
+  GraphSpaceID spaceId_{0};
+  size_t spaceVidLen_{0};
+  int32_t partNum_{0};
+  bool isIntVid_{false};
+  bool isEdge_{false};
+  TagID tagId_{0};
+  EdgeType edgeType_{0};
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+void printHelp() {
+  fprintf(stderr,
+          R"(  ./sst_build --space_name=<space name> --tag=<tag name> --props=<p1,p2> --input=<csv>
+
+Builds part-bucketed, sorted SST files for bulk loading. Upload the output directory
+to HDFS and install it on every replica with the DOWNLOAD and INGEST jobs; rebuild
+indexes afterwards.
+
+required:
+       --space_name=<space name>
+       --tag=<tag name> | --edge=<edge name>
+         Exactly one of them; the kind of rows the input file holds.
+       --props=<p1,p2,...>
+         Prop names in input column order, following the key columns.
+       --input=<path>
+         Input csv. Vertex rows are `vid,props...', edge rows `src,dst[,rank],props...'.
+
+optional:
+       --meta_server=<ip:port,...>
+         Default: 127.0.0.1:45500
+       --output=<dir>
+         Default: ./sst
+       --with_rank
+         The edge input carries a rank column after src and dst.
+       --sst_part_buffer_mb=<N>
+         Buffered bytes per part before a flush to a new SST file. Default: 64
+)");
+}
+
+int main(int argc, char* argv[]) {
+  if (argc == 1) {
+    printHelp();
+    return EXIT_FAILURE;
+  }
+  folly::init(&argc, &argv, true);
+  google::SetStderrLogging(google::INFO);
+
+  nebula::storage::SstBuildTool tool;
+  auto status = tool.run();
+  if (!status.ok()) {
+    LOG(ERROR) << status;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
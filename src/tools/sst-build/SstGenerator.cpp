@@ -0,0 +1,154 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "tools/sst-build/SstGenerator.h"
+
+#include <rocksdb/env.h>
+#include <rocksdb/options.h>
+#include <rocksdb/sst_file_writer.h>
+
+#include "codec/RowWriterV2.h"
+#include "common/base/MurmurHash2.h"
+#include "common/fs/FileUtils.h"
+#include "common/utils/NebulaKeyUtils.h"
+
+DEFINE_uint64(sst_part_buffer_mb,
+              64,
+              "Buffered bytes per part before the buffer is flushed to an SST file.");
+
+namespace nebula {
+namespace storage {
+
+SstGenerator::SstGenerator(GraphSpaceID spaceId,
+                           int32_t partNum,
+                           size_t vidLen,
+                           std::string outputDir)
+    : spaceId_(spaceId), partNum_(partNum), vidLen_(vidLen), outputDir_(std::move(outputDir)) {}
+
+PartitionID SstGenerator::partId(const VertexID& id) const {
+  // Keep in sync with MetaClient::partId: an 8 byte id is reinterpreted as int64 for
+  // compatibility with int-vid spaces, everything else is murmur hashed
+  uint64_t vid = 0;
+  if (id.size() == 8) {
+    memcpy(static_cast<void*>(&vid), id.data(), 8);
+  } else {
+    MurmurHash2 hash;
+    vid = hash(id.data());
+  }
+  return vid % partNum_ + 1;
+}
+
+Status SstGenerator::addVertex(const VertexID& vid,
+                               TagID tagId,
+                               const meta::NebulaSchemaProvider* schema,
+                               const std::vector<std::string>& propNames,
+                               const std::vector<Value>& props) {
+  if (!NebulaKeyUtils::isValidVidLen(vidLen_, vid)) {
+    return Status::Error("Vid `%s' longer than the space vid length %zu", vid.c_str(), vidLen_);
+  }
+  auto value = encodeRow(schema, propNames, props);
+  NG_RETURN_IF_ERROR(value);
+  auto part = partId(vid);
+  return add(part, NebulaKeyUtils::tagKey(vidLen_, part, vid, tagId), std::move(value).value());
+}
+
+Status SstGenerator::addEdge(const VertexID& srcId,
+                             const VertexID& dstId,
+                             EdgeType edgeType,
+                             EdgeRanking rank,
+                             const meta::NebulaSchemaProvider* schema,
+                             const std::vector<std::string>& propNames,
+                             const std::vector<Value>& props) {
+  if (!NebulaKeyUtils::isValidVidLen(vidLen_, srcId, dstId)) {
+    return Status::Error("Src `%s' or dst `%s' longer than the space vid length %zu",
+                         srcId.c_str(),
+                         dstId.c_str(),
+                         vidLen_);
+  }
+  auto value = encodeRow(schema, propNames, props);
+  NG_RETURN_IF_ERROR(value);
+  auto srcPart = partId(srcId);
+  NG_RETURN_IF_ERROR(add(srcPart,
+                         NebulaKeyUtils::edgeKey(vidLen_, srcPart, srcId, edgeType, rank, dstId),
+                         value.value()));
+  auto dstPart = partId(dstId);
+  return add(dstPart,
+             NebulaKeyUtils::edgeKey(vidLen_, dstPart, dstId, -edgeType, rank, srcId),
+             std::move(value).value());
+}
+
+Status SstGenerator::add(PartitionID part, std::string key, std::string value) {
+  auto& bytes = bufferedBytes_[part];
+  bytes += key.size() + value.size();
+  buffers_[part].emplace(std::move(key), std::move(value));
+  if (bytes >= FLAGS_sst_part_buffer_mb << 20) {
+    return flushPart(part);
+  }
+  return Status::OK();
+}
+
+Status SstGenerator::flushPart(PartitionID part) {
+  auto& buffer = buffers_[part];
+  if (buffer.empty()) {
+    return Status::OK();
+  }
+  auto dir = folly::stringPrintf("%s/%d", outputDir_.c_str(), part);
+  if (fs::FileUtils::fileType(dir.c_str()) == fs::FileType::NOTEXIST &&
+      !fs::FileUtils::makeDir(dir)) {
+    return Status::Error("Failed to create directory `%s'", dir.c_str());
+  }
+  rocksdb::Options options;
+  options.create_if_missing = true;
+  rocksdb::SstFileWriter writer(rocksdb::EnvOptions(), options);
+  auto file = folly::stringPrintf("%s/%06d.sst", dir.c_str(), fileSeq_[part]++);
+  auto s = writer.Open(file);
+  if (!s.ok()) {
+    return Status::Error("Failed to open `%s': %s", file.c_str(), s.ToString().c_str());
+  }
+  for (auto& [key, value] : buffer) {
+    s = writer.Put(key, value);
+    if (!s.ok()) {
+      return Status::Error("Failed to write `%s': %s", file.c_str(), s.ToString().c_str());
+    }
+  }
+  s = writer.Finish();
+  if (!s.ok()) {
+    return Status::Error("Failed to finish `%s': %s", file.c_str(), s.ToString().c_str());
+  }
+  buffer.clear();
+  bufferedBytes_[part] = 0;
+  numFiles_++;
+  return Status::OK();
+}
+
+Status SstGenerator::finish() {
+  for (auto& [part, buffer] : buffers_) {
+    NG_RETURN_IF_ERROR(flushPart(part));
+  }
+  return Status::OK();
+}
+
+StatusOr<std::string> SstGenerator::encodeRow(const meta::NebulaSchemaProvider* schema,
+                                              const std::vector<std::string>& propNames,
+                                              const std::vector<Value>& props) const {
+  if (propNames.size() != props.size()) {
+    return Status::Error("The number of props does not match the prop names");
+  }
+  RowWriterV2 writer(schema);
+  for (size_t i = 0; i < props.size(); i++) {
+    auto ret = writer.setValue(propNames[i], props[i]);
+    if (ret != WriteResult::SUCCEEDED) {
+      return Status::Error("Failed to write prop `%s'", propNames[i].c_str());
+    }
+  }
+  auto ret = writer.finish();
+  if (ret != WriteResult::SUCCEEDED) {
+    return Status::Error("Failed to finish the row, is some prop without default missing?");
+  }
+  return std::move(writer).moveEncodedStr();
+}
+
+}  // namespace storage
+}  // namespace nebula
@@ -0,0 +1,96 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef TOOLS_SSTBUILD_SSTGENERATOR_H_
+#define TOOLS_SSTBUILD_SSTGENERATOR_H_
+
+#include <map>
+
+#include "common/base/Base.h"
+#include "common/base/Status.h"
+#include "common/base/StatusOr.h"
+#include "common/meta/NebulaSchemaProvider.h"
+
+namespace nebula {
+namespace storage {
+
+/**
+ * @brief Turns vertex/edge rows into part-bucketed, sorted SST files for bulk loading.
+ *
+ * Rows are encoded with RowWriterV2 and NebulaKeyUtils exactly like AddVerticesProcessor /
+ * AddEdgesProcessor would store them, bucketed by the same partition hash the storage client
+ * uses, and buffered sorted per part. A part's buffer is flushed to
+ * `<outputDir>/<partId>/<seq>.sst` whenever it grows past the configured size, which is the
+ * directory layout the DOWNLOAD job expects on HDFS (`<hdfsPath>/<partId>/*.sst`); the files
+ * can therefore be uploaded as-is and installed on every replica with the existing
+ * DOWNLOAD + INGEST admin jobs, bypassing raft batching and the WAL entirely. Consistency
+ * across replicas comes from every replica ingesting the same files, so the generator must
+ * only be used for initial loads or with writes stopped, and indexes are not generated --
+ * rebuild them after the ingest.
+ *
+ * Not thread safe; shard the input by part hash to run several generators in parallel.
+ */
+class SstGenerator final {
+ public:
+  SstGenerator(GraphSpaceID spaceId, int32_t partNum, size_t vidLen, std::string outputDir);
+
+  /**
+   * @brief Buffer one tagged vertex row. `vid` must already be in its stored form, i.e. the
+   * 8-byte binary representation for int-vid spaces.
+   */
+  Status addVertex(const VertexID& vid,
+                   TagID tagId,
+                   const meta::NebulaSchemaProvider* schema,
+                   const std::vector<std::string>& propNames,
+                   const std::vector<Value>& props);
+
+  /**
+   * @brief Buffer one edge. Both the out-key (in the src part) and the in-key (in the dst
+   * part) are written, like the graph layer inserts them.
+   */
+  Status addEdge(const VertexID& srcId,
+                 const VertexID& dstId,
+                 EdgeType edgeType,
+                 EdgeRanking rank,
+                 const meta::NebulaSchemaProvider* schema,
+                 const std::vector<std::string>& propNames,
+                 const std::vector<Value>& props);
+
+  /**
+   * @brief Flush every remaining buffer. Must be called once after the last row.
+   */
+  Status finish();
+
+  /**
+   * @brief Same partition assignment as MetaClient::partId, so the generated files land in
+   * the part the storage client would have routed the row to.
+   */
+  PartitionID partId(const VertexID& id) const;
+
+  size_t numFiles() const {
+    return numFiles_;
+  }
+
+ private:
+  Status add(PartitionID part, std::string key, std::string value);
+  Status flushPart(PartitionID part);
+  StatusOr<std::string> encodeRow(const meta::NebulaSchemaProvider* schema,
+                                  const std::vector<std::string>& propNames,
+                                  const std::vector<Value>& props) const;
+
+  GraphSpaceID spaceId_;
+  int32_t partNum_;
+  size_t vidLen_;
+  std::string outputDir_;
+  // Per-part sorted buffers, SstFileWriter requires its keys in ascending order
+  std::unordered_map<PartitionID, std::map<std::string, std::string>> buffers_;
+  std::unordered_map<PartitionID, size_t> bufferedBytes_;
+  std::unordered_map<PartitionID, int32_t> fileSeq_;
+  size_t numFiles_{0};
+};
+
+}  // namespace storage
+}  // namespace nebula
+#endif  // TOOLS_SSTBUILD_SSTGENERATOR_H_
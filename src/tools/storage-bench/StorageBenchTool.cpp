@@ -0,0 +1,289 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include <folly/TokenBucket.h>
+#include <folly/json.h>
+
+#include <random>
+
+#include "common/base/Base.h"
+#include "common/fs/TempDir.h"
+#include "common/stats/HdrHistogram.h"
+#include "common/time/Duration.h"
+#include "mock/MockCluster.h"
+#include "storage/mutate/AddEdgesProcessor.h"
+#include "storage/query/GetNeighborsProcessor.h"
+#include "storage/query/ScanEdgeProcessor.h"
+
+DEFINE_int64(vertices, 10000, "Number of vertices in the synthetic graph");
+DEFINE_double(alpha, 1.2, "Degree skew of the synthetic graph, larger is more skewed");
+DEFINE_int64(min_degree, 1, "Smallest out degree of a vertex");
+DEFINE_int64(max_degree, 1000, "Largest out degree of a vertex");
+DEFINE_int32(prop_size, 24, "Width of every synthesized string property");
+DEFINE_int32(batch_num, 256, "Edges per AddEdgesRequest during the load phase");
+DEFINE_string(method,
+              "all",
+              "Workloads to drive after loading, a comma separated subset of "
+              "getNeighbors, scanEdge, or all");
+DEFINE_double(qps, 1000, "Target request rate of the getNeighbors workload");
+DEFINE_int32(total_reqs, 10000, "Number of getNeighbors requests to issue");
+DEFINE_int32(threads, 4, "Worker threads driving the getNeighbors workload");
+DEFINE_int64(scan_limit, 10000, "Row limit per ScanEdge request");
+DEFINE_string(data_path, "", "Where to put the kvstore data, a temp dir when empty");
+
+namespace nebula {
+namespace storage {
+
+constexpr EdgeType kServe = 101;
+
+class StorageBench {
+ public:
+  int run() {
+    std::unique_ptr<fs::TempDir> tempDir;
+    std::string dataPath = FLAGS_data_path;
+    if (dataPath.empty()) {
+      tempDir = std::make_unique<fs::TempDir>("/tmp/storage_bench.XXXXXX");
+      dataPath = tempDir->path();
+    }
+    cluster_ = std::make_unique<mock::MockCluster>();
+    cluster_->initStorageKV(dataPath.c_str());
+    env_ = cluster_->storageEnv_.get();
+    totalParts_ = cluster_->getTotalParts();
+    edgeSchema_ = env_->schemaMan_->getEdgeSchema(spaceId_, kServe);
+    CHECK(edgeSchema_ != nullptr);
+
+    folly::dynamic report = folly::dynamic::object();
+    report["graph"] = folly::dynamic::object("vertices", FLAGS_vertices)("edges", loadGraph())(
+        "alpha", FLAGS_alpha)("prop_size", FLAGS_prop_size);
+    report["addEdges"] = addEdgesLat_.toJson();
+
+    bool runAll = FLAGS_method.find("all") != std::string::npos;
+    if (runAll || FLAGS_method.find("getNeighbors") != std::string::npos) {
+      report["getNeighbors"] = runGetNeighbors();
+    }
+    if (runAll || FLAGS_method.find("scanEdge") != std::string::npos) {
+      report["scanEdge"] = runScanEdge();
+    }
+
+    std::cout << folly::toPrettyJson(report) << std::endl;
+    return EXIT_SUCCESS;
+  }
+
+ private:
+  VertexID vid(int64_t i) const {
+    return folly::stringPrintf("bench_v%010ld", i);
+  }
+
+  PartitionID partOf(const VertexID& id) const {
+    return std::hash<std::string>()(id) % totalParts_ + 1;
+  }
+
+  // Skewed pick in [0, FLAGS_vertices): small indices are chosen far more often, following
+  // roughly a power law with exponent FLAGS_alpha
+  int64_t skewedVertex(std::mt19937_64& gen) const {
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    auto idx = static_cast<int64_t>(std::pow(uniform(gen), FLAGS_alpha) * FLAGS_vertices);
+    return std::min(idx, FLAGS_vertices - 1);
+  }
+
+  // One synthetic property per schema field; strings are padded to FLAGS_prop_size
+  std::vector<Value> genProps(std::mt19937_64& gen) const {
+    std::vector<Value> props;
+    auto numFields = edgeSchema_->getNumFields();
+    for (size_t i = 0; i < numFields; i++) {
+      const auto* field = edgeSchema_->field(i);
+      switch (field->type()) {
+        case nebula::cpp2::PropertyType::BOOL:
+          props.emplace_back(true);
+          break;
+        case nebula::cpp2::PropertyType::INT8:
+        case nebula::cpp2::PropertyType::INT16:
+        case nebula::cpp2::PropertyType::INT32:
+        case nebula::cpp2::PropertyType::INT64:
+        case nebula::cpp2::PropertyType::TIMESTAMP:
+          props.emplace_back(static_cast<int64_t>(gen() % 100));
+          break;
+        case nebula::cpp2::PropertyType::FLOAT:
+        case nebula::cpp2::PropertyType::DOUBLE:
+          props.emplace_back(3.14159);
+          break;
+        case nebula::cpp2::PropertyType::STRING:
+        case nebula::cpp2::PropertyType::FIXED_STRING:
+          props.emplace_back(std::string(FLAGS_prop_size, 'x'));
+          break;
+        default:
+          props.emplace_back(Value());
+          break;
+      }
+    }
+    return props;
+  }
+
+  // Writes the power-law graph through AddEdgesProcessor in batches, recording per-batch
+  // latency; returns the number of edges written
+  int64_t loadGraph() {
+    std::mt19937_64 gen(42);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+    int64_t totalEdges = 0;
+    cpp2::AddEdgesRequest req;
+    req.space_id_ref() = spaceId_;
+    req.if_not_exists_ref() = true;
+    int32_t inBatch = 0;
+
+    auto flush = [this, &req, &inBatch]() {
+      if (inBatch == 0) {
+        return;
+      }
+      time::Duration dur;
+      auto* processor = AddEdgesProcessor::instance(env_);
+      auto fut = processor->getFuture();
+      processor->process(req);
+      std::move(fut).get();
+      addEdgesLat_.record(dur.elapsedInUSec());
+      (*req.parts_ref()).clear();
+      inBatch = 0;
+    };
+
+    for (int64_t v = 0; v < FLAGS_vertices; v++) {
+      // Pareto-distributed out degree, clamped into [min_degree, max_degree]
+      auto u = std::max(uniform(gen), 1e-9);
+      auto degree = static_cast<int64_t>(FLAGS_min_degree / std::pow(u, 1.0 / FLAGS_alpha));
+      degree = std::min(degree, FLAGS_max_degree);
+
+      auto src = vid(v);
+      auto partId = partOf(src);
+      for (int64_t r = 0; r < degree; r++) {
+        cpp2::NewEdge newEdge;
+        cpp2::EdgeKey edgeKey;
+        edgeKey.src_ref() = src;
+        edgeKey.edge_type_ref() = kServe;
+        edgeKey.ranking_ref() = r;
+        edgeKey.dst_ref() = vid(skewedVertex(gen));
+        newEdge.key_ref() = std::move(edgeKey);
+        newEdge.props_ref() = genProps(gen);
+        (*req.parts_ref())[partId].emplace_back(std::move(newEdge));
+        totalEdges++;
+        if (++inBatch >= FLAGS_batch_num) {
+          flush();
+        }
+      }
+    }
+    flush();
+    LOG(INFO) << "Loaded " << totalEdges << " edges over " << FLAGS_vertices << " vertices";
+    return totalEdges;
+  }
+
+  cpp2::GetNeighborsRequest buildGetNeighborsRequest(const VertexID& vertex) const {
+    cpp2::GetNeighborsRequest req;
+    req.space_id_ref() = spaceId_;
+    (*req.column_names_ref()).emplace_back(kVid);
+    (*req.parts_ref())[partOf(vertex)].emplace_back(vertex);
+    cpp2::TraverseSpec traverseSpec;
+    (*traverseSpec.edge_types_ref()).emplace_back(kServe);
+    // Empty prop lists mean all properties
+    traverseSpec.vertex_props_ref() = std::vector<cpp2::VertexProp>();
+    traverseSpec.edge_props_ref() = std::vector<cpp2::EdgeProp>();
+    req.traverse_spec_ref() = std::move(traverseSpec);
+    return req;
+  }
+
+  // Drives single-vertex getNeighbors requests at FLAGS_qps with the same degree skew as the
+  // generator, so hot vertices get hit the way they would in production
+  folly::dynamic runGetNeighbors() {
+    folly::TokenBucket bucket(FLAGS_qps, FLAGS_qps);
+    std::atomic<int32_t> remaining{FLAGS_total_reqs};
+    time::Duration wall;
+
+    std::vector<std::thread> threads;
+    for (int32_t t = 0; t < FLAGS_threads; t++) {
+      threads.emplace_back([this, t, &bucket, &remaining]() {
+        std::mt19937_64 gen(1000 + t);
+        while (remaining.fetch_sub(1) > 0) {
+          bucket.consumeWithBorrowAndWait(1);
+          auto req = buildGetNeighborsRequest(vid(skewedVertex(gen)));
+          time::Duration dur;
+          auto* processor = GetNeighborsProcessor::instance(env_);
+          auto fut = processor->getFuture();
+          processor->process(req);
+          std::move(fut).get();
+          getNeighborsLat_.record(dur.elapsedInUSec());
+        }
+      });
+    }
+    for (auto& t : threads) {
+      t.join();
+    }
+
+    auto result = getNeighborsLat_.toJson();
+    result["achieved_qps"] = FLAGS_total_reqs * 1000000.0 / wall.elapsedInUSec();
+    return result;
+  }
+
+  // Full scan of every part, one cursor-chained request sequence per part
+  folly::dynamic runScanEdge() {
+    int64_t totalRows = 0;
+    for (int32_t part = 1; part <= totalParts_; part++) {
+      std::string cursor;
+      bool hasNext = true;
+      while (hasNext) {
+        cpp2::ScanEdgeRequest req;
+        req.space_id_ref() = spaceId_;
+        cpp2::ScanCursor c;
+        if (!cursor.empty()) {
+          c.next_cursor_ref() = cursor;
+        }
+        (*req.parts_ref()).emplace(part, std::move(c));
+        cpp2::EdgeProp edgeProp;
+        edgeProp.type_ref() = kServe;
+        std::vector<cpp2::EdgeProp> returnColumns;
+        returnColumns.emplace_back(std::move(edgeProp));
+        req.return_columns_ref() = std::move(returnColumns);
+        req.limit_ref() = FLAGS_scan_limit;
+
+        time::Duration dur;
+        auto* processor = ScanEdgeProcessor::instance(env_);
+        auto fut = processor->getFuture();
+        processor->process(req);
+        auto resp = std::move(fut).get();
+        scanEdgeLat_.record(dur.elapsedInUSec());
+
+        if (resp.props_ref().has_value()) {
+          totalRows += resp.props_ref()->rows.size();
+        }
+        hasNext = false;
+        auto& cursors = *resp.cursors_ref();
+        auto found = cursors.find(part);
+        if (found != cursors.end() && found->second.next_cursor_ref().has_value() &&
+            !found->second.next_cursor_ref()->empty()) {
+          cursor = *found->second.next_cursor_ref();
+          hasNext = true;
+        }
+      }
+    }
+    auto result = scanEdgeLat_.toJson();
+    result["rows"] = totalRows;
+    return result;
+  }
+
+  std::unique_ptr<mock::MockCluster> cluster_;
+  StorageEnv* env_{nullptr};
+  GraphSpaceID spaceId_{1};
+  int32_t totalParts_{0};
+  std::shared_ptr<const meta::NebulaSchemaProvider> edgeSchema_;
+
+  stats::HdrHistogram addEdgesLat_{32, 60 * 1000 * 1000};
+  stats::HdrHistogram getNeighborsLat_{32, 60 * 1000 * 1000};
+  stats::HdrHistogram scanEdgeLat_{32, 60 * 1000 * 1000};
+};
+
+}  // namespace storage
+}  // namespace nebula
+
+int main(int argc, char* argv[]) {
+  folly::init(&argc, &argv, true);
+  nebula::storage::StorageBench bench;
+  return bench.run();
+}
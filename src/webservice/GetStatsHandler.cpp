@@ -13,6 +13,7 @@
 #include "common/base/Base.h"
 #include "common/stats/StatsManager.h"
 #include "webservice/Common.h"
+#include "webservice/WebService.h"
 
 namespace nebula {
 
@@ -38,6 +39,10 @@ void GetStatsHandler::onRequest(std::unique_ptr<HTTPMessage> headers) noexcept {
     const std::string& stats = headers->getQueryParam("stats");
     folly::split(",", stats, statNames_, true);
   }
+
+  if (headers->hasQueryParam("prefix")) {
+    prefix_ = headers->getQueryParam("prefix");
+  }
 }
 
 void GetStatsHandler::onBody(std::unique_ptr<folly::IOBuf>) noexcept {
@@ -94,8 +99,20 @@ void GetStatsHandler::onError(ProxygenError err) noexcept {
 folly::dynamic GetStatsHandler::getStats() const {
   auto stats = folly::dynamic::array();
   if (statNames_.empty()) {
+    // Serve the pre-aggregated snapshot when the background refresher is running, the scrape
+    // then never touches the counter locks
+    if (FLAGS_ws_stats_snapshot_interval_secs > 0) {
+      auto snapshot = StatsManager::readSnapshot();
+      if (snapshot != nullptr) {
+        return filterByPrefix(*snapshot);
+      }
+    }
     // Read all stats
     StatsManager::readAllValue(stats);
+    StatsManager::readAllHdrValue(stats);
+    if (!prefix_.empty()) {
+      return filterByPrefix(stats);
+    }
   } else {
     for (auto& sn : statNames_) {
       auto status = StatsManager::readValue(sn);
@@ -110,11 +127,32 @@ folly::dynamic GetStatsHandler::getStats() const {
   return stats;
 }
 
+folly::dynamic GetStatsHandler::filterByPrefix(const folly::dynamic& vals) const {
+  if (prefix_.empty()) {
+    return vals;
+  }
+  auto filtered = folly::dynamic::array();
+  for (auto& counter : vals) {
+    for (auto& m : counter.items()) {
+      if (m.first.asString().compare(0, prefix_.size(), prefix_) == 0) {
+        filtered.push_back(counter);
+        break;
+      }
+    }
+  }
+  return filtered;
+}
+
 std::string GetStatsHandler::toStr(folly::dynamic& vals) const {
   std::stringstream ss;
   for (auto& counter : vals) {
     for (auto& m : counter.items()) {
-      ss << m.first.asString() << "=" << m.second.asString() << "\n";
+      // HDR histogram distributions are nested objects, keep them as one-line JSON
+      if (m.second.isObject()) {
+        ss << m.first.asString() << "=" << folly::toJson(m.second) << "\n";
+      } else {
+        ss << m.first.asString() << "=" << m.second.asString() << "\n";
+      }
     }
   }
   return ss.str();
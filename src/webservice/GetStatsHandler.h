@@ -32,6 +32,8 @@ class GetStatsHandler : public proxygen::RequestHandler {
 
  protected:
   virtual folly::dynamic getStats() const;
+  // Keep only the entries whose metric name starts with prefix_, no-op when it is empty
+  folly::dynamic filterByPrefix(const folly::dynamic& vals) const;
   void addOneStat(folly::dynamic& vals, const std::string& statName, int64_t statValue) const;
   void addOneStat(folly::dynamic& vals,
                   const std::string& statName,
@@ -42,6 +44,7 @@ class GetStatsHandler : public proxygen::RequestHandler {
   HttpCode err_{HttpCode::SUCCEEDED};
   bool returnJson_{false};
   std::vector<std::string> statNames_;
+  std::string prefix_;
 };
 
 }  // namespace nebula
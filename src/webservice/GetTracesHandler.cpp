@@ -0,0 +1,81 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#include "webservice/GetTracesHandler.h"
+
+#include <folly/json.h>
+#include <proxygen/httpserver/ResponseBuilder.h>
+#include <proxygen/lib/http/ProxygenErrorEnum.h>
+
+#include "common/stats/TraceBuffer.h"
+
+namespace nebula {
+
+using proxygen::HTTPMessage;
+using proxygen::HTTPMethod;
+using proxygen::ProxygenError;
+using proxygen::ResponseBuilder;
+using proxygen::UpgradeProtocol;
+
+void GetTracesHandler::onRequest(std::unique_ptr<HTTPMessage> headers) noexcept {
+  if (!headers->getMethod() || headers->getMethod().value() != HTTPMethod::GET) {
+    // Unsupported method
+    err_ = HttpCode::E_UNSUPPORTED_METHOD;
+    return;
+  }
+
+  if (headers->hasQueryParam("limit")) {
+    try {
+      limit_ = folly::to<size_t>(headers->getQueryParam("limit"));
+    } catch (const std::exception& e) {
+      err_ = HttpCode::E_ILLEGAL_ARGUMENT;
+    }
+  }
+}
+
+void GetTracesHandler::onBody(std::unique_ptr<folly::IOBuf>) noexcept {
+  // Do nothing, we only support GET
+}
+
+void GetTracesHandler::onEOM() noexcept {
+  switch (err_) {
+    case HttpCode::E_UNSUPPORTED_METHOD:
+      ResponseBuilder(downstream_)
+          .status(WebServiceUtils::to(HttpStatusCode::METHOD_NOT_ALLOWED),
+                  WebServiceUtils::toString(HttpStatusCode::METHOD_NOT_ALLOWED))
+          .sendWithEOM();
+      return;
+    case HttpCode::E_ILLEGAL_ARGUMENT:
+      ResponseBuilder(downstream_)
+          .status(WebServiceUtils::to(HttpStatusCode::BAD_REQUEST),
+                  WebServiceUtils::toString(HttpStatusCode::BAD_REQUEST))
+          .sendWithEOM();
+      return;
+    default:
+      break;
+  }
+
+  auto spans = stats::TraceBuffer::instance().toJson(limit_);
+  ResponseBuilder(downstream_)
+      .status(WebServiceUtils::to(HttpStatusCode::OK),
+              WebServiceUtils::toString(HttpStatusCode::OK))
+      .body(folly::toPrettyJson(spans))
+      .sendWithEOM();
+}
+
+void GetTracesHandler::onUpgrade(UpgradeProtocol) noexcept {
+  // Do nothing
+}
+
+void GetTracesHandler::requestComplete() noexcept {
+  delete this;
+}
+
+void GetTracesHandler::onError(ProxygenError err) noexcept {
+  LOG(ERROR) << "Web service GetTracesHandler got error: " << proxygen::getErrorString(err);
+  delete this;
+}
+
+}  // namespace nebula
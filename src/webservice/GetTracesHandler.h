@@ -0,0 +1,41 @@
+/* Copyright (c) 2022 vesoft inc. All rights reserved.
+ *
+ * This source code is licensed under Apache 2.0 License.
+ */
+
+#ifndef WEBSERVICE_GETTRACESHANDLER_H_
+#define WEBSERVICE_GETTRACESHANDLER_H_
+
+#include <folly/dynamic.h>
+#include <proxygen/httpserver/RequestHandler.h>
+
+#include "common/base/Base.h"
+#include "webservice/Common.h"
+
+namespace nebula {
+
+// Exports the in-memory trace span ring as JSON, newest spans first. Supports an optional
+// `limit' query parameter, empty unless --trace_span_buffer_size is set.
+class GetTracesHandler : public proxygen::RequestHandler {
+ public:
+  GetTracesHandler() = default;
+
+  void onRequest(std::unique_ptr<proxygen::HTTPMessage> headers) noexcept override;
+
+  void onBody(std::unique_ptr<folly::IOBuf> body) noexcept override;
+
+  void onEOM() noexcept override;
+
+  void onUpgrade(proxygen::UpgradeProtocol proto) noexcept override;
+
+  void requestComplete() noexcept override;
+
+  void onError(proxygen::ProxygenError err) noexcept override;
+
+ private:
+  HttpCode err_{HttpCode::SUCCEEDED};
+  size_t limit_{1024};
+};
+
+}  // namespace nebula
+#endif  // WEBSERVICE_GETTRACESHANDLER_H_
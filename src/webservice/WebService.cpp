@@ -9,9 +9,12 @@
 #include <proxygen/httpserver/HTTPServerOptions.h>
 #include <proxygen/httpserver/RequestHandlerFactory.h>
 
+#include "common/stats/StatsManager.h"
+#include "common/thread/GenericWorker.h"
 #include "common/thread/NamedThread.h"
 #include "webservice/GetFlagsHandler.h"
 #include "webservice/GetStatsHandler.h"
+#include "webservice/GetTracesHandler.h"
 #include "webservice/NotFoundHandler.h"
 #include "webservice/Router.h"
 #include "webservice/SetFlagsHandler.h"
@@ -20,6 +23,10 @@
 DEFINE_int32(ws_http_port, 11000, "Port to listen on with HTTP protocol");
 DEFINE_string(ws_ip, "0.0.0.0", "IP/Hostname to bind to");
 DEFINE_int32(ws_threads, 4, "Number of threads for the web service.");
+DEFINE_int32(ws_stats_snapshot_interval_secs,
+             0,
+             "Aggregate all counters into an immutable snapshot this often and serve /stats "
+             "scrapes from it lock-free. 0 reads the counters on every scrape");
 
 #ifdef BUILD_STANDALONE
 DEFINE_int32(ws_storage_http_port, 12000, "Port to listen on Storage with HTTP protocol");
@@ -57,6 +64,10 @@ WebService::WebService(const std::string& name) {
 }
 
 WebService::~WebService() {
+  if (snapshotThread_ != nullptr) {
+    snapshotThread_->stop();
+    snapshotThread_->wait();
+  }
   server_->stop();
   wsThread_->join();
 }
@@ -79,6 +90,10 @@ Status WebService::start(uint16_t httpPort) {
     DCHECK(params.empty());
     return new GetStatsHandler();
   });
+  router().get("/traces").handler([](web::PathParams&& params) {
+    DCHECK(params.empty());
+    return new GetTracesHandler();
+  });
   router().get("/status").handler([](web::PathParams&& params) {
     DCHECK(params.empty());
     return new StatusHandler();
@@ -90,6 +105,15 @@ Status WebService::start(uint16_t httpPort) {
 
   started_ = true;
 
+  if (FLAGS_ws_stats_snapshot_interval_secs > 0) {
+    snapshotThread_ = std::make_shared<thread::GenericWorker>();
+    CHECK(snapshotThread_->start("stats-snapshot"));
+    // Build the first snapshot right away so early scrapes don't fall back to the slow path
+    stats::StatsManager::refreshSnapshot();
+    snapshotThread_->addRepeatTask(FLAGS_ws_stats_snapshot_interval_secs * 1000,
+                                   &stats::StatsManager::refreshSnapshot);
+  }
+
   std::vector<HTTPServer::IPConfig> ips = {
       {SocketAddress(FLAGS_ws_ip, httpPort, true), HTTPServer::Protocol::HTTP},
   };
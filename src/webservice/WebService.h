@@ -11,6 +11,7 @@
 DECLARE_int32(ws_http_port);
 DECLARE_string(ws_ip);
 DECLARE_int32(ws_threads);
+DECLARE_int32(ws_stats_snapshot_interval_secs);
 
 #ifdef BUILD_STANDALONE
 DECLARE_int32(ws_storage_http_port);
@@ -25,6 +26,7 @@ class RequestHandler;
 namespace nebula {
 namespace thread {
 class NamedThread;
+class GenericWorker;
 }  // namespace thread
 
 namespace web {
@@ -57,6 +59,9 @@ class WebService final {
   std::unique_ptr<proxygen::HTTPServer> server_;
   std::unique_ptr<thread::NamedThread> wsThread_;
   std::unique_ptr<web::Router> router_;
+  // Periodically aggregates all counters into the StatsManager snapshot which /stats scrapes
+  // read lock-free, only running when ws_stats_snapshot_interval_secs is positive
+  std::shared_ptr<thread::GenericWorker> snapshotThread_;
 };
 
 }  // namespace nebula
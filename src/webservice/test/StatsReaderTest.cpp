@@ -196,6 +196,40 @@ TEST(StatsReaderTest, GetHistoTest) {
   }
 }
 
+TEST(StatsReaderTest, SnapshotAndPrefixTest) {
+  auto statId = StatsManager::registerStats("snapstat01", "sum");
+  StatsManager::addValue(statId, 42);
+
+  // The snapshot is immutable once published, values added later only show up after a refresh
+  StatsManager::refreshSnapshot();
+  auto snapshot = StatsManager::readSnapshot();
+  ASSERT_NE(nullptr, snapshot);
+  bool found = false;
+  for (auto& counter : *snapshot) {
+    for (auto& m : counter.items()) {
+      if (m.first.asString() == "snapstat01.sum.3600") {
+        EXPECT_EQ(42, m.second.asInt());
+        found = true;
+      }
+    }
+  }
+  EXPECT_TRUE(found);
+
+  // A full scrape served from the snapshot matches a prefix-filtered one plus the rest
+  FLAGS_ws_stats_snapshot_interval_secs = 1;
+  SCOPE_EXIT {
+    FLAGS_ws_stats_snapshot_interval_secs = 0;
+  };
+  std::string resp;
+  ASSERT_TRUE(getUrl("/stats?prefix=snapstat01", resp));
+  std::vector<std::string> lines;
+  folly::split("\n", resp, lines, true);
+  EXPECT_EQ(4, lines.size());
+  for (auto& line : lines) {
+    EXPECT_EQ(0, line.find("snapstat01.sum."));
+  }
+}
+
 }  // namespace nebula
 
 int main(int argc, char** argv) {